@@ -0,0 +1,369 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+#include "checks/se_check.hpp"
+
+//
+// Aabb tree check. Pseudo random sequences of inserts, moves and removes are applied to the tree, and the tree is
+// validated every few steps : parents enclose children, heights are consistent and balanced, every node is either
+// reachable from the root or is in the free list, and every leaf belongs to a live object. Frustum, ray and overlap
+// queries (single and batched) must return every object that a brute force test of the exact boxes finds. The same is
+// checked after the surface area heuristic rebuild and after incremental updates of the rebuilt tree.
+//
+
+constexpr size_t MAX_OBJECTS = 256;
+constexpr size_t NUM_STEPS = 3000;
+constexpr size_t STEPS_PER_VALIDATION = 50;
+constexpr size_t NUM_BATCHED_QUERIES = 40; // more than one batch of se_aabb_tree_query_batched
+constexpr float WORLD_SIZE = 100.0f;
+constexpr float FAT_MARGIN = 0.5f;
+
+struct Object
+{
+    SeAabb      aabb;
+    uint32_t    proxy;
+    bool        isAlive;
+};
+
+Object g_objects[MAX_OBJECTS];
+uint32_t g_seed = 12345;
+
+float random01()
+{
+    g_seed = g_seed * 1664525u + 1013904223u;
+    return float(g_seed >> 8) / float(0xFFFFFF);
+}
+
+SeFloat3 random_position()
+{
+    return { (random01() - 0.5f) * WORLD_SIZE, (random01() - 0.5f) * WORLD_SIZE, (random01() - 0.5f) * WORLD_SIZE };
+}
+
+SeAabb random_aabb(const SeFloat3& center)
+{
+    const SeFloat3 halfSize = { 0.25f + random01() * 3.0f, 0.25f + random01() * 3.0f, 0.25f + random01() * 3.0f };
+    return { center - halfSize, center + halfSize };
+}
+
+//
+// Reference tests. Written independently of the tree, plane test uses the farthest corner of the box along the normal
+//
+
+bool reference_frustum_test(const SeAabbTreeFrustum& frustum, const SeAabb& aabb)
+{
+    for (const SeFloat4& plane : frustum.planes)
+    {
+        const float x = plane.x >= 0.0f ? aabb.max.x : aabb.min.x;
+        const float y = plane.y >= 0.0f ? aabb.max.y : aabb.min.y;
+        const float z = plane.z >= 0.0f ? aabb.max.z : aabb.min.z;
+        if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f) return false;
+    }
+    return true;
+}
+
+bool reference_ray_test(const SeAabbTreeRay& ray, const SeAabb& aabb)
+{
+    float tEnter = 0.0f;
+    float tExit = ray.maxDistance;
+    for (size_t it = 0; it < 3; it++)
+    {
+        const float invDirection = 1.0f / ray.direction.elements[it];
+        const float t0 = (aabb.min.elements[it] - ray.origin.elements[it]) * invDirection;
+        const float t1 = (aabb.max.elements[it] - ray.origin.elements[it]) * invDirection;
+        tEnter = se_max(tEnter, se_min(t0, t1));
+        tExit = se_min(tExit, se_max(t0, t1));
+    }
+    return tEnter <= tExit;
+}
+
+SeAabbTreeFrustum random_frustum()
+{
+    const SeFloat3 position = random_position();
+    const SeFloat3 target = random_position();
+    const SeFloat4x4 view = se_float4x4_look_at(position, target, { 0, 1, 0 });
+    const SeFloat4x4 viewProjection = se_render_perspective(30.0f + random01() * 60.0f, 16.0f / 9.0f, 0.1f, 20.0f + random01() * WORLD_SIZE) * se_float4x4_inverted(view);
+    SeAabbTreeFrustum frustum;
+    se_float4x4_get_frustum_planes(viewProjection, frustum.planes);
+    return frustum;
+}
+
+SeAabbTreeRay random_ray()
+{
+    return
+    {
+        .origin         = random_position(),
+        .direction      = { random01() * 2.0f - 1.0f, random01() * 2.0f - 1.0f, random01() * 2.0f - 1.0f },
+        .maxDistance    = 20.0f + random01() * WORLD_SIZE,
+    };
+}
+
+SeAabb random_overlap_box()
+{
+    const SeFloat3 center = random_position();
+    const float halfSize = 2.0f + random01() * 15.0f;
+    return { center - SeFloat3{ halfSize, halfSize, halfSize }, center + SeFloat3{ halfSize, halfSize, halfSize } };
+}
+
+//
+// Tree structure
+//
+
+void check_tree(const SeAabbTree* tree, bool isBalanced)
+{
+    const size_t numNodes = se_dynamic_array_size(tree->nodes);
+    bool* const isVisited = (bool*)se_alloc(se_allocator_persistent(), sizeof(bool) * numNodes, se_alloc_tag);
+    memset(isVisited, 0, sizeof(bool) * numNodes);
+    size_t numReachable = 0;
+    size_t numLeaves = 0;
+    if (tree->root != SE_AABB_TREE_INVALID)
+    {
+        se_check(tree->nodes[tree->root].parent == SE_AABB_TREE_INVALID);
+        SeDynamicArray<uint32_t> stack = se_dynamic_array_create<uint32_t>(se_allocator_persistent(), 64);
+        se_dynamic_array_push(stack, tree->root);
+        while (se_dynamic_array_size(stack))
+        {
+            const uint32_t index = *se_dynamic_array_last(stack);
+            se_dynamic_array_force_set_size(stack, se_dynamic_array_size(stack) - 1);
+            // Node referenced twice means a cycle or a shared subtree
+            if (!se_check(index < numNodes && !isVisited[index])) continue;
+            isVisited[index] = true;
+            numReachable += 1;
+            const SeAabbTreeNode& node = tree->nodes[index];
+            if (node.children[0] == SE_AABB_TREE_INVALID)
+            {
+                numLeaves += 1;
+                se_check(node.children[1] == SE_AABB_TREE_INVALID);
+                se_check(node.height == 0);
+                if (!se_check(node.userData < MAX_OBJECTS)) continue;
+                const Object& object = g_objects[node.userData];
+                se_check(object.isAlive && object.proxy == index);
+                se_check(se_aabb_contains(node.aabb, object.aabb));
+                continue;
+            }
+            const SeAabbTreeNode& first = tree->nodes[node.children[0]];
+            const SeAabbTreeNode& second = tree->nodes[node.children[1]];
+            se_check(first.parent == index && second.parent == index);
+            se_check(se_aabb_contains(node.aabb, first.aabb) && se_aabb_contains(node.aabb, second.aabb));
+            se_check(node.height == 1 + se_max(first.height, second.height));
+            if (isBalanced) se_check(abs(first.height - second.height) <= 1);
+            se_dynamic_array_push(stack, node.children[0]);
+            se_dynamic_array_push(stack, node.children[1]);
+        }
+        se_dynamic_array_destroy(stack);
+    }
+    //
+    // Every node that isn't in the tree must be in the free list exactly once
+    //
+    size_t numFree = 0;
+    for (uint32_t index = tree->freeList; index != SE_AABB_TREE_INVALID; index = tree->nodes[index].parent)
+    {
+        if (!se_check(index < numNodes && !isVisited[index])) break;
+        isVisited[index] = true;
+        numFree += 1;
+        se_check(tree->nodes[index].height == -1);
+    }
+    se_check(numReachable + numFree == numNodes);
+
+    size_t numAlive = 0;
+    for (const Object& object : g_objects) numAlive += object.isAlive ? 1 : 0;
+    se_check(numLeaves == tree->numProxies && numAlive == tree->numProxies);
+    se_check(numLeaves == 0 || numReachable == numLeaves * 2 - 1);
+    se_check(se_aabb_tree_height(tree) == (tree->root == SE_AABB_TREE_INVALID ? 0 : uint32_t(tree->nodes[tree->root].height)));
+    se_dealloc(se_allocator_persistent(), isVisited, sizeof(bool) * numNodes);
+}
+
+//
+// Queries. Results must contain every live object that passes the reference test with its exact box, every result
+// must be a live proxy and no proxy can be returned twice
+//
+
+template<typename Test>
+void check_query_result(const SeAabbTree* tree, const uint32_t* proxies, size_t numProxies, const Test& test)
+{
+    bool isFound[MAX_OBJECTS] = { };
+    for (size_t it = 0; it < numProxies; it++)
+    {
+        const uint32_t proxy = proxies[it];
+        if (!se_check(proxy < se_dynamic_array_size(tree->nodes) && tree->nodes[proxy].height == 0)) continue;
+        const uint64_t objectIndex = se_aabb_tree_user_data(tree, proxy);
+        if (!se_check(objectIndex < MAX_OBJECTS && g_objects[objectIndex].isAlive && g_objects[objectIndex].proxy == proxy)) continue;
+        se_check(!isFound[objectIndex]);
+        isFound[objectIndex] = true;
+    }
+    for (size_t it = 0; it < MAX_OBJECTS; it++)
+    {
+        const Object& object = g_objects[it];
+        if (object.isAlive && test(object.aabb)) se_check(isFound[it]);
+    }
+}
+
+void check_queries(const SeAabbTree* tree)
+{
+    SeDynamicArray<uint32_t> result = se_dynamic_array_create<uint32_t>(se_allocator_persistent(), 256);
+    SeAabbTreeFrustum frustums[NUM_BATCHED_QUERIES];
+    SeAabbTreeRay rays[NUM_BATCHED_QUERIES];
+    SeAabb boxes[NUM_BATCHED_QUERIES];
+    SeAabbTreeQueryRange ranges[NUM_BATCHED_QUERIES];
+    for (size_t it = 0; it < NUM_BATCHED_QUERIES; it++)
+    {
+        frustums[it] = random_frustum();
+        rays[it] = random_ray();
+        boxes[it] = random_overlap_box();
+    }
+    for (size_t it = 0; it < NUM_BATCHED_QUERIES; it++)
+    {
+        se_dynamic_array_reset(result);
+        se_aabb_tree_query_frustum(tree, frustums[it], result);
+        check_query_result(tree, se_dynamic_array_raw(result), se_dynamic_array_size(result), [&](const SeAabb& aabb) { return reference_frustum_test(frustums[it], aabb); });
+        se_dynamic_array_reset(result);
+        se_aabb_tree_query_ray(tree, rays[it], result);
+        check_query_result(tree, se_dynamic_array_raw(result), se_dynamic_array_size(result), [&](const SeAabb& aabb) { return reference_ray_test(rays[it], aabb); });
+        se_dynamic_array_reset(result);
+        se_aabb_tree_query_overlap(tree, boxes[it], result);
+        check_query_result(tree, se_dynamic_array_raw(result), se_dynamic_array_size(result), [&](const SeAabb& aabb) { return se_aabb_overlaps(boxes[it], aabb); });
+    }
+    //
+    // Batched queries append to the existing content of the result array
+    //
+    auto check_ranges = [&](const auto& test)
+    {
+        for (size_t it = 0; it < NUM_BATCHED_QUERIES; it++)
+        {
+            const SeAabbTreeQueryRange& range = ranges[it];
+            if (!se_check(range.first >= 1 && range.first + range.count <= se_dynamic_array_size(result))) continue;
+            check_query_result(tree, se_dynamic_array_raw(result) + range.first, range.count, [&](const SeAabb& aabb) { return test(it, aabb); });
+        }
+        se_check(result[0] == SE_AABB_TREE_INVALID);
+    };
+    se_dynamic_array_reset(result);
+    se_dynamic_array_push(result, SE_AABB_TREE_INVALID);
+    se_aabb_tree_query_frustums(tree, frustums, NUM_BATCHED_QUERIES, result, ranges);
+    check_ranges([&](size_t query, const SeAabb& aabb) { return reference_frustum_test(frustums[query], aabb); });
+    se_dynamic_array_reset(result);
+    se_dynamic_array_push(result, SE_AABB_TREE_INVALID);
+    se_aabb_tree_query_rays(tree, rays, NUM_BATCHED_QUERIES, result, ranges);
+    check_ranges([&](size_t query, const SeAabb& aabb) { return reference_ray_test(rays[query], aabb); });
+    se_dynamic_array_reset(result);
+    se_dynamic_array_push(result, SE_AABB_TREE_INVALID);
+    se_aabb_tree_query_overlaps(tree, boxes, NUM_BATCHED_QUERIES, result, ranges);
+    check_ranges([&](size_t query, const SeAabb& aabb) { return se_aabb_overlaps(boxes[query], aabb); });
+    se_dynamic_array_destroy(result);
+}
+
+//
+// Updates
+//
+
+void insert_random_object(SeAabbTree* tree)
+{
+    for (size_t it = 0; it < MAX_OBJECTS; it++)
+    {
+        Object& object = g_objects[it];
+        if (object.isAlive) continue;
+        object.aabb = random_aabb(random_position());
+        object.proxy = se_aabb_tree_insert(tree, object.aabb, it);
+        object.isAlive = true;
+        return;
+    }
+}
+
+Object* pick_alive_object()
+{
+    const size_t first = size_t(random01() * float(MAX_OBJECTS - 1));
+    for (size_t it = 0; it < MAX_OBJECTS; it++)
+    {
+        Object& object = g_objects[(first + it) % MAX_OBJECTS];
+        if (object.isAlive) return &object;
+    }
+    return nullptr;
+}
+
+void apply_random_step(SeAabbTree* tree)
+{
+    const float operation = random01();
+    Object* const object = pick_alive_object();
+    if (!object || operation < 0.35f)
+    {
+        insert_random_object(tree);
+    }
+    else if (operation < 0.55f)
+    {
+        se_aabb_tree_remove(tree, object->proxy);
+        object->isAlive = false;
+    }
+    else if (operation < 0.85f)
+    {
+        //
+        // Small move. Proxy is reinserted only when the object leaves its fattened box
+        //
+        const SeFloat3 offset = { (random01() - 0.5f) * FAT_MARGIN, (random01() - 0.5f) * FAT_MARGIN, (random01() - 0.5f) * FAT_MARGIN };
+        object->aabb = { object->aabb.min + offset, object->aabb.max + offset };
+        const bool isInsideFatAabb = se_aabb_contains(se_aabb_tree_fat_aabb(tree, object->proxy), object->aabb);
+        se_check(se_aabb_tree_update(tree, object->proxy, object->aabb) != isInsideFatAabb);
+    }
+    else
+    {
+        // Proxy id stays the same after reinsert
+        object->aabb = random_aabb(random_position());
+        se_check(se_aabb_tree_update(tree, object->proxy, object->aabb));
+        se_check(se_aabb_tree_user_data(tree, object->proxy) == uint64_t(object - g_objects));
+    }
+}
+
+void run_random_steps(SeAabbTree* tree, bool isBalanced)
+{
+    for (size_t stepIt = 0; stepIt < NUM_STEPS; stepIt++)
+    {
+        apply_random_step(tree);
+        if ((stepIt % STEPS_PER_VALIDATION) != 0) continue;
+        check_tree(tree, isBalanced);
+        check_queries(tree);
+    }
+    check_tree(tree, isBalanced);
+    check_queries(tree);
+}
+
+void check_aabb_tree()
+{
+    SeAabbTree tree;
+    se_aabb_tree_construct(&tree, { .allocator = se_allocator_persistent(), .capacity = MAX_OBJECTS, .fatMargin = FAT_MARGIN });
+    //
+    // Empty tree and tree with a single proxy
+    //
+    check_tree(&tree, true);
+    check_queries(&tree);
+    se_aabb_tree_rebuild_sah(&tree);
+    check_tree(&tree, true);
+    insert_random_object(&tree);
+    se_aabb_tree_rebuild_sah(&tree);
+    check_tree(&tree, true);
+    check_queries(&tree);
+    //
+    // Incremental updates keep the tree balanced
+    //
+    run_random_steps(&tree, true);
+    //
+    // Rebuild keeps proxy ids, rebuilt tree isn't balanced by height, but incremental updates must still keep it valid
+    //
+    se_aabb_tree_rebuild_sah(&tree);
+    check_tree(&tree, false);
+    check_queries(&tree);
+    run_random_steps(&tree, false);
+    //
+    // Removing everything returns all nodes to the free list
+    //
+    for (Object& object : g_objects)
+    {
+        if (!object.isAlive) continue;
+        se_aabb_tree_remove(&tree, object.proxy);
+        object.isAlive = false;
+    }
+    se_check(tree.root == SE_AABB_TREE_INVALID && tree.numProxies == 0);
+    check_tree(&tree, true);
+    check_queries(&tree);
+    se_aabb_tree_destroy(&tree);
+}
+
+int main(int argc, char* argv[])
+{
+    return se_check_run("Aabb tree", check_aabb_tree);
+}
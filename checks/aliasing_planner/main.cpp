@@ -0,0 +1,119 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+#include "checks/se_check.hpp"
+
+//
+// Aliasing planner check. Hand made and pseudo random resource sets are planned without a device. Every plan must keep
+// resources aligned and inside compatible blocks, and resources that are alive at the same time must never share memory.
+//
+
+void check_no_overlaps(const SeVkAliasingPlanner* planner)
+{
+    const size_t numResources = se_dynamic_array_size(planner->resources);
+    if (!se_check(se_dynamic_array_size(planner->placements) == numResources)) return;
+    for (size_t it = 0; it < numResources; it++)
+    {
+        const SeVkAliasingResource& resource = planner->resources[it];
+        const SeVkAliasingPlacement& placement = planner->placements[it];
+        if (!se_check(placement.block < se_dynamic_array_size(planner->blocks))) continue;
+        const SeVkAliasingBlock& block = planner->blocks[placement.block];
+        se_check((placement.offset % resource.alignment) == 0);
+        se_check(placement.offset + resource.size <= block.size);
+        se_check(block.memoryTypeBits == resource.memoryTypeBits && block.isLinear == resource.isLinear);
+        for (size_t otherIt = it + 1; otherIt < numResources; otherIt++)
+        {
+            const SeVkAliasingResource& other = planner->resources[otherIt];
+            const SeVkAliasingPlacement& otherPlacement = planner->placements[otherIt];
+            if (placement.block != otherPlacement.block) continue;
+            const bool isOverlappingInTime = resource.firstUse <= other.lastUse && other.firstUse <= resource.lastUse;
+            const bool isOverlappingInMemory =
+                placement.offset < otherPlacement.offset + other.size &&
+                otherPlacement.offset < placement.offset + resource.size;
+            se_check(!(isOverlappingInTime && isOverlappingInMemory));
+        }
+    }
+    //
+    // Planned memory can exceed the required size only by alignment padding : first fit never places a resource
+    // further than the padded sizes of all resources placed before it
+    //
+    size_t paddedSize = 0;
+    for (auto it : planner->resources) paddedSize += se_iterator_value(it).size + se_iterator_value(it).alignment - 1;
+    se_check(se_vk_aliasing_planner_planned_size(planner) <= paddedSize);
+}
+
+void check_aliasing_planner()
+{
+    SeVkAliasingPlanner planner;
+    se_vk_aliasing_planner_construct(&planner, se_allocator_persistent());
+    //
+    // Chain of equally sized resources, each one is used together with the next one only. First and third share memory
+    //
+    {
+        const size_t a = se_vk_aliasing_planner_add_resource(&planner, { 256, 256, 1, false, 0, 1 });
+        const size_t b = se_vk_aliasing_planner_add_resource(&planner, { 256, 256, 1, false, 1, 2 });
+        const size_t c = se_vk_aliasing_planner_add_resource(&planner, { 256, 256, 1, false, 2, 3 });
+        se_vk_aliasing_planner_plan(&planner);
+        check_no_overlaps(&planner);
+        se_check(se_dynamic_array_size(planner.blocks) == 1);
+        se_check(planner.placements[a].offset == planner.placements[c].offset);
+        se_check(planner.placements[a].offset != planner.placements[b].offset);
+        se_check(se_vk_aliasing_planner_required_size(&planner) == 768);
+        se_check(se_vk_aliasing_planner_planned_size(&planner) == 512);
+        //
+        // Extending lifetime of the first resource to the third one separates them
+        //
+        se_vk_aliasing_planner_add_use(&planner, a, 3);
+        se_vk_aliasing_planner_plan(&planner);
+        check_no_overlaps(&planner);
+        se_check(se_vk_aliasing_planner_planned_size(&planner) == 768);
+    }
+    //
+    // Linear and optimal resources and resources with different memory types never share a block
+    //
+    {
+        se_vk_aliasing_planner_reset(&planner);
+        se_vk_aliasing_planner_add_resource(&planner, { 128, 64, 1, false, 0, 0 });
+        se_vk_aliasing_planner_add_resource(&planner, { 128, 64, 1, true, 1, 1 });
+        se_vk_aliasing_planner_add_resource(&planner, { 128, 64, 2, false, 2, 2 });
+        se_vk_aliasing_planner_plan(&planner);
+        check_no_overlaps(&planner);
+        se_check(se_dynamic_array_size(planner.blocks) == 3);
+    }
+    //
+    // Pseudo random resources with different sizes, alignments and lifetimes
+    //
+    {
+        uint32_t seed = 12345;
+        const auto next = [&seed](uint32_t range) -> uint32_t
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return (seed >> 8) % range;
+        };
+        for (size_t iteration = 0; iteration < 64; iteration++)
+        {
+            se_vk_aliasing_planner_reset(&planner);
+            const size_t numResources = 1 + next(48);
+            for (size_t it = 0; it < numResources; it++)
+            {
+                const size_t firstUse = next(16);
+                se_vk_aliasing_planner_add_resource(&planner,
+                {
+                    .size           = 1 + next(1 << 16),
+                    .alignment      = size_t(1) << next(13),
+                    .memoryTypeBits = 1 + next(2),
+                    .isLinear       = next(2) == 0,
+                    .firstUse       = firstUse,
+                    .lastUse        = firstUse + next(4),
+                });
+            }
+            se_vk_aliasing_planner_plan(&planner);
+            check_no_overlaps(&planner);
+        }
+    }
+    se_vk_aliasing_planner_destroy(&planner);
+}
+
+int main(int argc, char* argv[])
+{
+    return se_check_run("Aliasing planner", check_aliasing_planner);
+}
@@ -0,0 +1,296 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+#include "checks/se_check.hpp"
+
+//
+// Barrier planner check. Small pass sequences are planned without a device and every emitted barrier batch is compared
+// with the exact stages, access masks and layouts the sequence requires.
+//
+
+#define check_buffer(name) ((VkBuffer)uintptr_t(name))
+#define check_image(name) ((VkImage)uintptr_t(name))
+
+constexpr VkImageSubresourceRange CHECK_IMAGE_RANGE = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+constexpr SeVkBarrierQueue CHECK_COMPUTE_QUEUE
+{
+    .index              = 1,
+    .supportedStages    = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+    .supportedAccess    = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+};
+
+//
+// Helpers
+//
+
+size_t check_buffer_pass(SeVkBarrierPlanner* planner, SeVkBarrierResourceState* state, VkBuffer buffer, VkPipelineStageFlags stages, VkAccessFlags access)
+{
+    se_vk_barrier_planner_begin_pass(planner);
+    se_vk_barrier_planner_add_buffer_access(planner, state, buffer, stages, access);
+    return se_vk_barrier_planner_end_pass(planner);
+}
+
+size_t check_image_pass(SeVkBarrierPlanner* planner, SeVkBarrierResourceState* state, VkImage image, VkImageLayout* currentLayout, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access)
+{
+    se_vk_barrier_planner_begin_pass(planner);
+    se_vk_barrier_planner_add_image_access(planner, state, image, CHECK_IMAGE_RANGE, currentLayout, layout, stages, access);
+    return se_vk_barrier_planner_end_pass(planner);
+}
+
+void check_batch(const SeVkBarrierPlanner* planner, size_t batchIndex, VkPipelineStageFlags srcStages, VkPipelineStageFlags dstStages, size_t numImageBarriers, size_t numBufferBarriers)
+{
+    if (!se_check(batchIndex < se_dynamic_array_size(planner->batches))) return;
+    const SeVkBarrierBatch& batch = planner->batches[batchIndex];
+    se_check(batch.srcStages == srcStages);
+    se_check(batch.dstStages == dstStages);
+    se_check(batch.numImageBarriers == numImageBarriers);
+    se_check(batch.numBufferBarriers == numBufferBarriers);
+}
+
+void check_no_barriers(const SeVkBarrierPlanner* planner, size_t batchIndex)
+{
+    check_batch(planner, batchIndex, 0, 0, 0, 0);
+}
+
+void check_buffer_barrier(const SeVkBarrierPlanner* planner, size_t batchIndex, size_t barrierIndex, VkBuffer buffer, VkAccessFlags srcAccess, VkAccessFlags dstAccess)
+{
+    const SeVkBarrierBatch& batch = planner->batches[batchIndex];
+    if (!se_check(barrierIndex < batch.numBufferBarriers)) return;
+    const VkBufferMemoryBarrier& barrier = planner->bufferBarriers[batch.firstBufferBarrier + barrierIndex];
+    se_check(barrier.sType == VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER);
+    se_check(barrier.buffer == buffer);
+    se_check(barrier.srcAccessMask == srcAccess);
+    se_check(barrier.dstAccessMask == dstAccess);
+    se_check(barrier.srcQueueFamilyIndex == VK_QUEUE_FAMILY_IGNORED && barrier.dstQueueFamilyIndex == VK_QUEUE_FAMILY_IGNORED);
+    se_check(barrier.offset == 0 && barrier.size == VK_WHOLE_SIZE);
+}
+
+void check_image_barrier(const SeVkBarrierPlanner* planner, size_t batchIndex, size_t barrierIndex, VkImage image, VkAccessFlags srcAccess, VkAccessFlags dstAccess, VkImageLayout oldLayout, VkImageLayout newLayout)
+{
+    const SeVkBarrierBatch& batch = planner->batches[batchIndex];
+    if (!se_check(barrierIndex < batch.numImageBarriers)) return;
+    const VkImageMemoryBarrier& barrier = planner->imageBarriers[batch.firstImageBarrier + barrierIndex];
+    se_check(barrier.sType == VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER);
+    se_check(barrier.image == image);
+    se_check(barrier.srcAccessMask == srcAccess);
+    se_check(barrier.dstAccessMask == dstAccess);
+    se_check(barrier.oldLayout == oldLayout);
+    se_check(barrier.newLayout == newLayout);
+    se_check(barrier.srcQueueFamilyIndex == VK_QUEUE_FAMILY_IGNORED && barrier.dstQueueFamilyIndex == VK_QUEUE_FAMILY_IGNORED);
+    se_check(barrier.subresourceRange.aspectMask == CHECK_IMAGE_RANGE.aspectMask);
+    se_check(barrier.subresourceRange.levelCount == CHECK_IMAGE_RANGE.levelCount && barrier.subresourceRange.layerCount == CHECK_IMAGE_RANGE.layerCount);
+}
+
+//
+// Checks
+//
+
+void check_compute_write_vertex_read()
+{
+    SeVkBarrierPlanner planner;
+    se_vk_barrier_planner_construct(&planner, se_allocator_persistent());
+    SeVkBarrierResourceState state = { };
+    const VkBuffer buffer = check_buffer(1);
+    //
+    // First write doesn't wait for anything. Vertex shader read waits for the compute write and makes it visible
+    //
+    const size_t write = check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+    check_no_barriers(&planner, write);
+    const size_t read = check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    check_batch(&planner, read, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 1);
+    check_buffer_barrier(&planner, read, 0, buffer, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+    //
+    // Write is already visible to the vertex shader, so read after read doesn't need a barrier
+    //
+    const size_t secondRead = check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    check_no_barriers(&planner, secondRead);
+    //
+    // Read from a stage the write isn't visible to waits for the write again
+    //
+    const size_t indirectRead = check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+    check_batch(&planner, indirectRead, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1);
+    check_buffer_barrier(&planner, indirectRead, 0, buffer, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+    se_vk_barrier_planner_destroy(&planner);
+}
+
+void check_read_after_read()
+{
+    SeVkBarrierPlanner planner;
+    se_vk_barrier_planner_construct(&planner, se_allocator_persistent());
+    SeVkBarrierResourceState state = { };
+    const VkBuffer buffer = check_buffer(1);
+    check_no_barriers(&planner, check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT));
+    check_no_barriers(&planner, check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT));
+    check_no_barriers(&planner, check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT));
+    se_check(se_dynamic_array_size(planner.bufferBarriers) == 0);
+    se_vk_barrier_planner_destroy(&planner);
+}
+
+void check_write_after_read()
+{
+    SeVkBarrierPlanner planner;
+    se_vk_barrier_planner_construct(&planner, se_allocator_persistent());
+    SeVkBarrierResourceState state = { };
+    const VkBuffer buffer = check_buffer(1);
+    //
+    // Write after read is an execution dependency only : batch waits for the reading stages, but no buffer barrier is emitted
+    //
+    check_no_barriers(&planner, check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT));
+    const size_t write = check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+    check_batch(&planner, write, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0);
+    se_vk_barrier_planner_destroy(&planner);
+}
+
+void check_write_after_write()
+{
+    SeVkBarrierPlanner planner;
+    se_vk_barrier_planner_construct(&planner, se_allocator_persistent());
+    SeVkBarrierResourceState state = { };
+    const VkBuffer buffer = check_buffer(1);
+    //
+    // Second write waits for the first one
+    //
+    check_no_barriers(&planner, check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT));
+    const size_t transferWrite = check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+    check_batch(&planner, transferWrite, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1);
+    check_buffer_barrier(&planner, transferWrite, 0, buffer, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+    //
+    // Write after write and read waits for both the last write and every read since then
+    //
+    const size_t read = check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    check_batch(&planner, read, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 1);
+    check_buffer_barrier(&planner, read, 0, buffer, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+    const size_t computeWrite = check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+    check_batch(&planner, computeWrite, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1);
+    check_buffer_barrier(&planner, computeWrite, 0, buffer, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+    se_vk_barrier_planner_destroy(&planner);
+}
+
+void check_image_layout_transitions()
+{
+    SeVkBarrierPlanner planner;
+    se_vk_barrier_planner_construct(&planner, se_allocator_persistent());
+    SeVkBarrierResourceState state = { };
+    const VkImage image = check_image(1);
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    //
+    // Initial transition has nothing to wait for, so it starts at the top of the pipe
+    //
+    const size_t render = check_image_pass(&planner, &state, image, &layout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    check_batch(&planner, render, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 1, 0);
+    check_image_barrier(&planner, render, 0, image, 0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    se_check(layout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    //
+    // Sampling transitions the image and makes attachment writes visible to the fragment shader
+    //
+    const size_t sample = check_image_pass(&planner, &state, image, &layout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    check_batch(&planner, sample, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 1, 0);
+    check_image_barrier(&planner, sample, 0, image, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    se_check(layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    //
+    // Sampling again in the same layout is a read after read
+    //
+    check_no_barriers(&planner, check_image_pass(&planner, &state, image, &layout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT));
+    //
+    // Rendering to the image again waits for the reads (no writes since the transition) and transitions it back
+    //
+    const size_t rerender = check_image_pass(&planner, &state, image, &layout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    check_batch(&planner, rerender, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 1, 0);
+    check_image_barrier(&planner, rerender, 0, image, 0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    se_check(layout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    se_vk_barrier_planner_destroy(&planner);
+}
+
+void check_one_batch_per_pass()
+{
+    SeVkBarrierPlanner planner;
+    se_vk_barrier_planner_construct(&planner, se_allocator_persistent());
+    SeVkBarrierResourceState stateA = { };
+    SeVkBarrierResourceState stateB = { };
+    SeVkBarrierResourceState imageState = { };
+    const VkBuffer bufferA = check_buffer(1);
+    const VkBuffer bufferB = check_buffer(2);
+    const VkImage image = check_image(3);
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    //
+    // Producer pass writes two buffers and an image
+    //
+    se_vk_barrier_planner_begin_pass(&planner);
+    se_vk_barrier_planner_add_buffer_access(&planner, &stateA, bufferA, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+    se_vk_barrier_planner_add_buffer_access(&planner, &stateB, bufferB, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+    se_vk_barrier_planner_add_image_access(&planner, &imageState, image, CHECK_IMAGE_RANGE, &layout, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+    const size_t producer = se_vk_barrier_planner_end_pass(&planner);
+    check_batch(&planner, producer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 1, 0);
+    check_image_barrier(&planner, producer, 0, image, 0, VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL);
+    //
+    // Consumer pass reads everything. All barriers are merged into a single batch. Buffer A is accessed twice and
+    // gets a single barrier with merged stages and access masks
+    //
+    se_vk_barrier_planner_begin_pass(&planner);
+    se_vk_barrier_planner_add_buffer_access(&planner, &stateA, bufferA, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    se_vk_barrier_planner_add_buffer_access(&planner, &stateB, bufferB, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+    se_vk_barrier_planner_add_buffer_access(&planner, &stateA, bufferA, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_UNIFORM_READ_BIT);
+    se_vk_barrier_planner_add_image_access(&planner, &imageState, image, CHECK_IMAGE_RANGE, &layout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    const size_t consumer = se_vk_barrier_planner_end_pass(&planner);
+    check_batch
+    (
+        &planner, consumer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+        1, 2
+    );
+    check_buffer_barrier(&planner, consumer, 0, bufferA, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT);
+    check_buffer_barrier(&planner, consumer, 1, bufferB, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+    check_image_barrier(&planner, consumer, 0, image, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    //
+    // Image accessed with different layouts in one pass uses GENERAL layout
+    //
+    se_vk_barrier_planner_begin_pass(&planner);
+    se_vk_barrier_planner_add_image_access(&planner, &imageState, image, CHECK_IMAGE_RANGE, &layout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    se_vk_barrier_planner_add_image_access(&planner, &imageState, image, CHECK_IMAGE_RANGE, &layout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    const size_t feedback = se_vk_barrier_planner_end_pass(&planner);
+    check_batch(&planner, feedback, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 1, 0);
+    check_image_barrier(&planner, feedback, 0, image, 0, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_GENERAL);
+    //
+    // Every pass gets exactly one batch, even if it doesn't need any barriers
+    //
+    check_no_barriers(&planner, check_buffer_pass(&planner, &stateA, bufferA, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT));
+    se_check(producer == 0 && consumer == 1 && feedback == 2);
+    se_check(se_dynamic_array_size(planner.batches) == 4);
+    se_check(se_dynamic_array_size(planner.bufferBarriers) == 2);
+    se_check(se_dynamic_array_size(planner.imageBarriers) == 3);
+    se_vk_barrier_planner_destroy(&planner);
+}
+
+void check_other_queue_write()
+{
+    SeVkBarrierPlanner planner;
+    se_vk_barrier_planner_construct(&planner, se_allocator_persistent());
+    SeVkBarrierResourceState state = { };
+    const VkBuffer buffer = check_buffer(1);
+    //
+    // Write of the main queue is synchronized with a semaphore, so the compute queue read doesn't get a barrier
+    //
+    check_no_barriers(&planner, check_buffer_pass(&planner, &state, buffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT));
+    se_vk_barrier_planner_begin_pass(&planner);
+    se_vk_barrier_planner_set_pass_queue(&planner, CHECK_COMPUTE_QUEUE);
+    se_vk_barrier_planner_add_buffer_access(&planner, &state, buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    check_no_barriers(&planner, se_vk_barrier_planner_end_pass(&planner));
+    se_vk_barrier_planner_destroy(&planner);
+}
+
+void check_barrier_planner()
+{
+    check_compute_write_vertex_read();
+    check_read_after_read();
+    check_write_after_read();
+    check_write_after_write();
+    check_image_layout_transitions();
+    check_one_batch_per_pass();
+    check_other_queue_write();
+}
+
+int main(int argc, char* argv[])
+{
+    return se_check_run("Barrier planner", check_barrier_planner);
+}
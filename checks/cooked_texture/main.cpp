@@ -0,0 +1,167 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+#include "checks/se_check.hpp"
+
+//
+// Cooked texture check. A small texture is cooked with and without generated mips, uncompressed and block compressed.
+// Every cooked file must pass se_cooked_texture_is_valid and have a regular mip chain with mip data in the final format.
+// Then the header of every file is corrupted in different ways (bad magic or version, truncated mip, mip offset inside
+// of the header, wrong mip extent, too many mips and so on) and every corrupted file must be rejected.
+//
+
+constexpr uint32_t IMAGE_WIDTH = 13;
+constexpr uint32_t IMAGE_HEIGHT = 6;
+constexpr size_t IMAGE_SIZE = IMAGE_WIDTH * IMAGE_HEIGHT * 4;
+constexpr uint32_t FULL_CHAIN_NUM_MIPS = 4; // 13x6 -> 6x3 -> 3x1 -> 1x1
+
+struct CookMode
+{
+    SeTextureFormat format;
+    bool            generateMips;
+    uint32_t        expectedNumMips;
+};
+
+const CookMode COOK_MODES[] =
+{
+    { SeTextureFormat::RGBA_8_UNORM,    false,  1                   },
+    { SeTextureFormat::RGBA_8_UNORM,    true,   FULL_CHAIN_NUM_MIPS },
+    { SeTextureFormat::R_8_UNORM,       true,   FULL_CHAIN_NUM_MIPS },
+    { SeTextureFormat::BC1_RGBA_UNORM,  true,   FULL_CHAIN_NUM_MIPS },
+    { SeTextureFormat::BC7_UNORM,       false,  1                   },
+};
+
+using SeCorruptPfn = void (*)(SeCookedTextureHeader& header, size_t& dataSize);
+
+//
+// Corrupts a copy of the file, original file stays valid
+//
+void check_rejected(const SeCookedTexture& texture, const char* name, SeCorruptPfn corrupt)
+{
+    uint8_t* const copy = (uint8_t*)se_alloc(se_allocator_persistent(), texture.dataSize, se_alloc_tag);
+    memcpy(copy, texture.data, texture.dataSize);
+    size_t dataSize = texture.dataSize;
+    corrupt(*(SeCookedTextureHeader*)copy, dataSize);
+    if (!se_check(!se_cooked_texture_is_valid(copy, dataSize)))
+        se_dbg_error("Corrupted cooked texture was accepted : {}", name);
+    se_dealloc(se_allocator_persistent(), copy, texture.dataSize);
+}
+
+void check_cooked(const CookMode& mode, const uint8_t* rgba)
+{
+    const SeCookedTextureInfo info
+    {
+        .format         = mode.format,
+        .rgba           = rgba,
+        .width          = IMAGE_WIDTH,
+        .height         = IMAGE_HEIGHT,
+        .generateMips   = mode.generateMips,
+    };
+    SeCookedTexture texture = se_cooked_texture_cook(info, se_allocator_persistent());
+    if (!se_check(se_cooked_texture_is_valid(texture.data, texture.dataSize)))
+    {
+        se_cooked_texture_free(texture);
+        return;
+    }
+    //
+    // Layout of the valid file
+    //
+    const SeCookedTextureHeader* const header = se_cooked_texture_get_header(texture.data);
+    se_check(header->format == mode.format && header->width == IMAGE_WIDTH && header->height == IMAGE_HEIGHT);
+    se_check(header->depth == 1 && header->numLayers == 1);
+    se_check(header->numMips == mode.expectedNumMips);
+    for (uint32_t it = 1; it < header->numMips; it++)
+    {
+        const SeCookedTextureMip& prev = header->mips[it - 1];
+        const SeCookedTextureMip& mip = header->mips[it];
+        se_check(mip.offset >= prev.offset + prev.size);
+    }
+    const SeCookedTextureMip& last = header->mips[header->numMips - 1];
+    se_check(last.offset + last.size <= texture.dataSize);
+    if (mode.generateMips) se_check(last.width == 1 && last.height == 1);
+    //
+    // Top mip is the source in the target format
+    //
+    const SeCookedTextureMip& top = header->mips[0];
+    const uint8_t* const topData = (const uint8_t*)texture.data + top.offset;
+    if (mode.format == SeTextureFormat::RGBA_8_UNORM)
+    {
+        se_check(top.size == IMAGE_SIZE && memcmp(topData, rgba, IMAGE_SIZE) == 0);
+    }
+    else if (mode.format == SeTextureFormat::R_8_UNORM)
+    {
+        for (size_t it = 0; it < IMAGE_WIDTH * IMAGE_HEIGHT; it++) se_check(topData[it] == rgba[it * 4]);
+    }
+    else
+    {
+        const size_t compressedSize = se_texture_compression_get_size(mode.format, IMAGE_WIDTH, IMAGE_HEIGHT);
+        uint8_t* const compressed = (uint8_t*)se_alloc(se_allocator_persistent(), compressedSize, se_alloc_tag);
+        se_texture_compression_encode(mode.format, rgba, IMAGE_WIDTH, IMAGE_HEIGHT, compressed);
+        se_check(top.size == compressedSize && memcmp(topData, compressed, compressedSize) == 0);
+        se_dealloc(se_allocator_persistent(), compressed, compressedSize);
+    }
+    //
+    // Corrupted variants
+    //
+    check_rejected(texture, "bad magic", [](SeCookedTextureHeader& header, size_t& dataSize) { header.magic ^= 1; });
+    check_rejected(texture, "bad version", [](SeCookedTextureHeader& header, size_t& dataSize) { header.version += 1; });
+    check_rejected(texture, "unsupported format", [](SeCookedTextureHeader& header, size_t& dataSize) { header.format = SeTextureFormat::DEPTH_STENCIL; });
+    check_rejected(texture, "zero width", [](SeCookedTextureHeader& header, size_t& dataSize) { header.width = 0; });
+    check_rejected(texture, "zero layers", [](SeCookedTextureHeader& header, size_t& dataSize) { header.numLayers = 0; });
+    check_rejected(texture, "truncated header", [](SeCookedTextureHeader& header, size_t& dataSize) { dataSize = sizeof(SeCookedTextureHeader) - 1; });
+    check_rejected(texture, "truncated mip", [](SeCookedTextureHeader& header, size_t& dataSize)
+    {
+        const SeCookedTextureMip& last = header.mips[header.numMips - 1];
+        dataSize = last.offset + last.size - 1;
+    });
+    check_rejected(texture, "mip offset into the header", [](SeCookedTextureHeader& header, size_t& dataSize)
+    {
+        header.mips[0].offset = ((sizeof(SeCookedTextureHeader) - 1) / SE_COOKED_TEXTURE_DATA_ALIGNMENT) * SE_COOKED_TEXTURE_DATA_ALIGNMENT;
+    });
+    check_rejected(texture, "unaligned mip offset", [](SeCookedTextureHeader& header, size_t& dataSize) { header.mips[0].offset += 1; });
+    check_rejected(texture, "mip offset past the end", [](SeCookedTextureHeader& header, size_t& dataSize)
+    {
+        // Offset + size overflows, so a naive "offset + size > dataSize" test would accept it
+        header.mips[header.numMips - 1].offset = UINT64_MAX - (SE_COOKED_TEXTURE_DATA_ALIGNMENT - 1);
+    });
+    check_rejected(texture, "wrong mip size", [](SeCookedTextureHeader& header, size_t& dataSize) { header.mips[header.numMips - 1].size -= 1; });
+    check_rejected(texture, "wrong top mip width", [](SeCookedTextureHeader& header, size_t& dataSize) { header.mips[0].width += 1; });
+    check_rejected(texture, "wrong last mip height", [](SeCookedTextureHeader& header, size_t& dataSize) { header.mips[header.numMips - 1].height += 1; });
+    check_rejected(texture, "zero mips", [](SeCookedTextureHeader& header, size_t& dataSize) { header.numMips = 0; });
+    check_rejected(texture, "too many mips", [](SeCookedTextureHeader& header, size_t& dataSize)
+    {
+        //
+        // Extra mip after the full chain is a plausible 1x1 mip at the end of the file, only the length of the chain is wrong
+        //
+        SeCookedTextureMip& extra = header.mips[FULL_CHAIN_NUM_MIPS];
+        extra.width = 1;
+        extra.height = 1;
+        extra.size = se_cooked_texture_get_mip_size(header.format, 1, 1);
+        extra.offset = dataSize - se_cooked_texture_align(extra.size);
+        header.numMips = FULL_CHAIN_NUM_MIPS + 1;
+    });
+    check_rejected(texture, "more mips than the header can hold", [](SeCookedTextureHeader& header, size_t& dataSize) { header.numMips = SE_COOKED_TEXTURE_MAX_MIPS + 1; });
+    se_check(!se_cooked_texture_is_valid(nullptr, texture.dataSize));
+    se_check(se_cooked_texture_is_valid(texture.data, texture.dataSize));
+    se_cooked_texture_free(texture);
+    se_check(texture.data == nullptr);
+}
+
+void check_cooked_texture()
+{
+    uint8_t rgba[IMAGE_SIZE];
+    for (uint32_t y = 0; y < IMAGE_HEIGHT; y++)
+        for (uint32_t x = 0; x < IMAGE_WIDTH; x++)
+        {
+            uint8_t* const texel = &rgba[(y * IMAGE_WIDTH + x) * 4];
+            texel[0] = uint8_t(x * 19);
+            texel[1] = uint8_t(y * 41);
+            texel[2] = uint8_t((x + y) * 13);
+            texel[3] = 255;
+        }
+    for (const CookMode& mode : COOK_MODES) check_cooked(mode, rgba);
+}
+
+int main(int argc, char* argv[])
+{
+    return se_check_run("Cooked texture", check_cooked_texture);
+}
@@ -0,0 +1,143 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+#include "checks/se_check.hpp"
+
+//
+// Frustum culling check. SSE path of se_frustum_cull must produce exactly the same visible indices as the scalar path.
+// Pseudo random instances are culled with a perspective frustum, instance counts aren't always a multiple of four,
+// so the scalar tail of the SSE path is covered. Boxes that touch a plane are visible, boxes that are slightly behind
+// it are not, this is checked on hand placed boxes with exactly representable coordinates.
+//
+
+constexpr size_t MAX_INSTANCES = 1027;
+constexpr uint32_t SENTINEL = 0xDEADBEEF;
+
+// Instance with extra data after the transform, checks that both paths respect the stride
+struct InstanceWithData
+{
+    SeFloat4x4  transform;
+    uint32_t    data[5];
+};
+
+//
+// Culls the first numInstances transforms with both paths. Visible indices must match and neither path may write
+// past numInstances entries of the result array
+//
+size_t check_paths_match(const SeFloat4 planes[6], const SeAabb& aabb, const void* transforms, size_t stride, size_t numInstances, uint32_t* scalarVisible, uint32_t* simdVisible)
+{
+    for (size_t it = 0; it <= numInstances; it++)
+    {
+        scalarVisible[it] = SENTINEL;
+        simdVisible[it] = SENTINEL;
+    }
+    const size_t numScalarVisible = se_frustum_cull_scalar(planes, aabb, transforms, stride, numInstances, scalarVisible);
+    const size_t numSimdVisible = se_frustum_cull(planes, aabb, transforms, stride, numInstances, simdVisible);
+    se_check(scalarVisible[numInstances] == SENTINEL);
+    se_check(simdVisible[numInstances] == SENTINEL);
+    if (!se_check(numScalarVisible == numSimdVisible)) return numScalarVisible;
+    se_check(memcmp(scalarVisible, simdVisible, sizeof(uint32_t) * numScalarVisible) == 0);
+    for (size_t it = 1; it < numScalarVisible; it++) se_check(scalarVisible[it - 1] < scalarVisible[it]);
+    return numScalarVisible;
+}
+
+void check_random_instances(uint32_t* scalarVisible, uint32_t* simdVisible)
+{
+    InstanceWithData* const instances = (InstanceWithData*)se_alloc(se_allocator_persistent(), sizeof(InstanceWithData) * MAX_INSTANCES, se_alloc_tag);
+    uint32_t seed = 0x12345678;
+    auto random01 = [&seed]() -> float
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return float(seed & 0xFFFFFF) / float(0xFFFFFF);
+    };
+    for (size_t it = 0; it < MAX_INSTANCES; it++)
+    {
+        const SeFloat3 position = { (random01() - 0.5f) * 100.0f, (random01() - 0.5f) * 20.0f, (random01() - 0.5f) * 100.0f };
+        const SeFloat3 rotation = { random01() * 360.0f, random01() * 360.0f, random01() * 360.0f };
+        const float scale = 0.5f + random01() * 2.0f;
+        instances[it] =
+        {
+            .transform  = se_float4x4_from_position(position) * se_float4x4_from_rotation(rotation) * se_float4x4_from_scale({ scale, scale, scale }),
+            .data       = { SENTINEL, SENTINEL, SENTINEL, SENTINEL, SENTINEL },
+        };
+    }
+    const SeAabb aabb = { { -1.0f, -0.5f, -2.0f }, { 1.0f, 1.5f, 0.0f } };
+    const size_t instanceCounts[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 63, 64, 65, 1024, 1025, 1026, 1027 };
+    for (size_t cameraIt = 0; cameraIt < 8; cameraIt++)
+    {
+        const float angle = float(cameraIt) * 45.0f;
+        const SeFloat4x4 view = se_float4x4_look_at({ 0, 0, 0 }, { sinf(se_to_radians(angle)), 0, cosf(se_to_radians(angle)) }, { 0, 1, 0 });
+        const SeFloat4x4 viewProjection = se_render_perspective(60.0f, 16.0f / 9.0f, 0.1f, 40.0f) * se_float4x4_inverted(view);
+        SeFloat4 planes[6];
+        se_float4x4_get_frustum_planes(viewProjection, planes);
+        for (size_t numInstances : instanceCounts)
+        {
+            const size_t numVisible = check_paths_match(planes, aabb, instances, sizeof(InstanceWithData), numInstances, scalarVisible, simdVisible);
+            if (numInstances == 0) se_check(numVisible == 0);
+        }
+        // Full set must have both visible and culled instances, otherwise the comparison proves nothing
+        const size_t numVisible = check_paths_match(planes, aabb, instances, sizeof(InstanceWithData), MAX_INSTANCES, scalarVisible, simdVisible);
+        se_check(numVisible > 0 && numVisible < MAX_INSTANCES);
+    }
+    se_dealloc(se_allocator_persistent(), instances, sizeof(InstanceWithData) * MAX_INSTANCES);
+}
+
+void check_boxes_on_planes(uint32_t* scalarVisible, uint32_t* simdVisible)
+{
+    //
+    // Axis aligned frustum -10 <= x, y, z <= 10 and a unit box. Box placed at 11 touches the plane and is visible,
+    // box placed at 11.5 is fully outside. All values are exactly representable, so there is no rounding
+    //
+    const SeFloat4 planes[6] =
+    {
+        {  1.0f,  0.0f,  0.0f, 10.0f },
+        { -1.0f,  0.0f,  0.0f, 10.0f },
+        {  0.0f,  1.0f,  0.0f, 10.0f },
+        {  0.0f, -1.0f,  0.0f, 10.0f },
+        {  0.0f,  0.0f,  1.0f, 10.0f },
+        {  0.0f,  0.0f, -1.0f, 10.0f },
+    };
+    const SeAabb aabb = { { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } };
+    const SeFloat3 positions[] =
+    {
+        { -11.0f, 0.0f, 0.0f },     // touches
+        { -11.5f, 0.0f, 0.0f },     // outside
+        { 0.0f, 11.0f, 0.0f },      // touches
+        { 0.0f, 0.0f, -11.5f },     // outside
+        { 0.0f, 0.0f, 0.0f },       // inside
+        { 11.0f, -11.0f, 11.0f },   // touches three planes at the corner
+        { 10.5f, 11.5f, 0.0f },     // outside of one plane only
+        { 0.0f, 0.0f, 11.0f },      // touches, scalar tail
+        { 0.0f, -11.5f, 0.0f },     // outside, scalar tail
+    };
+    const bool isVisible[] = { true, false, true, false, true, true, false, true, false };
+    constexpr size_t NUM_BOXES = se_array_size(positions);
+    SeMeshInstanceData instances[NUM_BOXES];
+    for (size_t it = 0; it < NUM_BOXES; it++) instances[it] = { se_float4x4_from_position(positions[it]) };
+
+    const size_t numVisible = check_paths_match(planes, aabb, instances, sizeof(SeMeshInstanceData), NUM_BOXES, scalarVisible, simdVisible);
+    size_t expectedIt = 0;
+    for (size_t it = 0; it < NUM_BOXES; it++)
+    {
+        if (!isVisible[it]) continue;
+        se_check(expectedIt < numVisible && simdVisible[expectedIt] == it);
+        expectedIt += 1;
+    }
+    se_check(numVisible == expectedIt);
+}
+
+void check_frustum_culling()
+{
+    uint32_t* const scalarVisible = (uint32_t*)se_alloc(se_allocator_persistent(), sizeof(uint32_t) * (MAX_INSTANCES + 1), se_alloc_tag);
+    uint32_t* const simdVisible = (uint32_t*)se_alloc(se_allocator_persistent(), sizeof(uint32_t) * (MAX_INSTANCES + 1), se_alloc_tag);
+    check_random_instances(scalarVisible, simdVisible);
+    check_boxes_on_planes(scalarVisible, simdVisible);
+    se_dealloc(se_allocator_persistent(), scalarVisible, sizeof(uint32_t) * (MAX_INSTANCES + 1));
+    se_dealloc(se_allocator_persistent(), simdVisible, sizeof(uint32_t) * (MAX_INSTANCES + 1));
+}
+
+int main(int argc, char* argv[])
+{
+    return se_check_run("Frustum culling", check_frustum_culling);
+}
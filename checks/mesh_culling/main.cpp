@@ -0,0 +1,569 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+#include "checks/se_check.hpp"
+
+//
+// Mesh culling check. Compute pass of se_mesh_culling.hpp (mesh_cull.comp) culls pseudo random instances of a mesh with
+// two geometries from two cameras. For every geometry the instance count written to the draw arguments and the set of
+// written mvp matrices are compared with se_frustum_cull_scalar results for the same bounds.
+//
+// Render subsystem needs a window and has no way to read buffers back, so the shader is dispatched on a minimal compute
+// device instead. Cpu device (lavapipe) is preferred, so the check runs on machines without a gpu. Culler's SeMeshCullNode
+// and SeMeshCullFrameData are uploaded as is, which checks their layout against the shader too.
+//
+
+constexpr uint32_t NUM_INSTANCES = 1000;
+constexpr uint32_t NUM_GEOMETRIES = 2;
+constexpr uint32_t NUM_CULL_NODES = 3;
+constexpr uint32_t NUM_VERTICES = 36;
+constexpr size_t NUM_CAMERAS = 2;
+constexpr float PLANE_EPSILON = 0.01f;
+constexpr float MATRIX_EPSILON = 0.001f;
+
+struct CheckDevice
+{
+    VkInstance                          instance;
+    VkPhysicalDevice                    physicalHandle;
+    VkDevice                            logicalHandle;
+    VkQueue                             queue;
+    uint32_t                            queueFamilyIndex;
+    VkPhysicalDeviceMemoryProperties    memoryProperties;
+};
+
+struct CheckBuffer
+{
+    VkBuffer        handle;
+    VkDeviceMemory  memory;
+    void*           mapped;
+    VkDeviceSize    size;
+};
+
+struct CheckPipeline
+{
+    VkShaderModule          module;
+    VkDescriptorSetLayout   setLayout;
+    VkPipelineLayout        layout;
+    VkPipeline              handle;
+    VkDescriptorPool        descriptorPool;
+    VkDescriptorSet         set;
+    uint32_t                workgroupSizeX;
+};
+
+bool check_device_construct(CheckDevice* device)
+{
+    *device = { };
+    if (!se_check(volkInitialize() == VK_SUCCESS)) return false;
+    const VkApplicationInfo applicationInfo =
+    {
+        .sType              = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+        .pNext              = nullptr,
+        .pApplicationName   = "Mesh culling check",
+        .applicationVersion = VK_MAKE_VERSION(0, 1, 0),
+        .pEngineName        = "Sabrina Engine",
+        .engineVersion      = VK_MAKE_VERSION(0, 1, 0),
+        .apiVersion         = VK_API_VERSION_1_2
+    };
+    const VkInstanceCreateInfo instanceCreateInfo =
+    {
+        .sType                      = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+        .pNext                      = nullptr,
+        .flags                      = 0,
+        .pApplicationInfo           = &applicationInfo,
+        .enabledLayerCount          = 0,
+        .ppEnabledLayerNames        = nullptr,
+        .enabledExtensionCount      = 0,
+        .ppEnabledExtensionNames    = nullptr,
+    };
+    if (!se_check(vkCreateInstance(&instanceCreateInfo, nullptr, &device->instance) == VK_SUCCESS)) return false;
+    volkLoadInstance(device->instance);
+    //
+    // Any device with a compute queue works, cpu device is preferred
+    //
+    SeDynamicArray<VkPhysicalDevice> physicalDevices = se_vk_utils_get_available_physical_devices(device->instance, se_allocator_frame());
+    for (auto it : physicalDevices)
+    {
+        const VkPhysicalDevice physicalDevice = se_iterator_value(it);
+        SeDynamicArray<VkQueueFamilyProperties> familyProperties = se_vk_utils_get_physical_device_queue_family_properties(physicalDevice, se_allocator_frame());
+        const uint32_t computeQueue = se_vk_utils_pick_compute_queue(familyProperties);
+        se_dynamic_array_destroy(familyProperties);
+        if (computeQueue == SE_VK_INVALID_QUEUE) continue;
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        if (!device->physicalHandle || properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU)
+        {
+            device->physicalHandle = physicalDevice;
+            device->queueFamilyIndex = computeQueue;
+        }
+        if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU) break;
+    }
+    se_dynamic_array_destroy(physicalDevices);
+    if (!se_check(device->physicalHandle)) return false;
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(device->physicalHandle, &properties);
+    se_dbg_message("Mesh culling check runs on {}", properties.deviceName);
+    vkGetPhysicalDeviceMemoryProperties(device->physicalHandle, &device->memoryProperties);
+
+    const float queuePriority = 1.0f;
+    const VkDeviceQueueCreateInfo queueCreateInfo =
+    {
+        .sType              = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+        .pNext              = nullptr,
+        .flags              = 0,
+        .queueFamilyIndex   = device->queueFamilyIndex,
+        .queueCount         = 1,
+        .pQueuePriorities   = &queuePriority,
+    };
+    const VkDeviceCreateInfo deviceCreateInfo =
+    {
+        .sType                      = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+        .pNext                      = nullptr,
+        .flags                      = 0,
+        .queueCreateInfoCount       = 1,
+        .pQueueCreateInfos          = &queueCreateInfo,
+        .enabledLayerCount          = 0,
+        .ppEnabledLayerNames        = nullptr,
+        .enabledExtensionCount      = 0,
+        .ppEnabledExtensionNames    = nullptr,
+        .pEnabledFeatures           = nullptr,
+    };
+    if (!se_check(vkCreateDevice(device->physicalHandle, &deviceCreateInfo, nullptr, &device->logicalHandle) == VK_SUCCESS)) return false;
+    vkGetDeviceQueue(device->logicalHandle, device->queueFamilyIndex, 0, &device->queue);
+    return true;
+}
+
+void check_device_destroy(CheckDevice* device)
+{
+    if (device->logicalHandle) vkDestroyDevice(device->logicalHandle, nullptr);
+    if (device->instance) vkDestroyInstance(device->instance, nullptr);
+}
+
+//
+// Buffers are host visible and coherent, so inputs are written and results are read through the persistent mapping
+//
+bool check_buffer_construct(CheckBuffer* buffer, const CheckDevice* device, VkDeviceSize size, VkBufferUsageFlags usage)
+{
+    *buffer = { .handle = VK_NULL_HANDLE, .memory = VK_NULL_HANDLE, .mapped = nullptr, .size = size };
+    const VkBufferCreateInfo bufferCreateInfo =
+    {
+        .sType                  = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .pNext                  = nullptr,
+        .flags                  = 0,
+        .size                   = size,
+        .usage                  = usage,
+        .sharingMode            = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount  = 0,
+        .pQueueFamilyIndices    = nullptr,
+    };
+    if (!se_check(vkCreateBuffer(device->logicalHandle, &bufferCreateInfo, nullptr, &buffer->handle) == VK_SUCCESS)) return false;
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device->logicalHandle, buffer->handle, &requirements);
+    uint32_t memoryTypeIndex;
+    VkPhysicalDeviceMemoryProperties memoryProperties = device->memoryProperties;
+    const VkMemoryPropertyFlags memoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    if (!se_check(se_vk_utils_get_memory_type_index(&memoryProperties, requirements.memoryTypeBits, memoryFlags, &memoryTypeIndex))) return false;
+    const VkMemoryAllocateInfo allocateInfo =
+    {
+        .sType              = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext              = nullptr,
+        .allocationSize     = requirements.size,
+        .memoryTypeIndex    = memoryTypeIndex,
+    };
+    if (!se_check(vkAllocateMemory(device->logicalHandle, &allocateInfo, nullptr, &buffer->memory) == VK_SUCCESS)) return false;
+    if (!se_check(vkBindBufferMemory(device->logicalHandle, buffer->handle, buffer->memory, 0) == VK_SUCCESS)) return false;
+    return se_check(vkMapMemory(device->logicalHandle, buffer->memory, 0, VK_WHOLE_SIZE, 0, &buffer->mapped) == VK_SUCCESS);
+}
+
+void check_buffer_destroy(CheckBuffer* buffer, const CheckDevice* device)
+{
+    if (buffer->memory) vkFreeMemory(device->logicalHandle, buffer->memory, nullptr);
+    if (buffer->handle) vkDestroyBuffer(device->logicalHandle, buffer->handle, nullptr);
+}
+
+//
+// Pipeline with the same bindings as se_mesh_culler_cull : frame data uniform buffer and four storage buffers
+//
+bool check_pipeline_construct(CheckPipeline* pipeline, const CheckDevice* device, const CheckBuffer* buffers)
+{
+    *pipeline = { };
+    const SeFileHandle shaderFile = se_fs_file_find_recursive("mesh_cull.comp.spv");
+    if (!se_check(shaderFile)) return false;
+    SeFileContent bytecode = se_fs_file_read(shaderFile, se_allocator_persistent());
+    pipeline->module = se_vk_utils_create_shader_module(device->logicalHandle, (const uint32_t*)bytecode.data, bytecode.dataSize, nullptr);
+    {
+        SsrAllocator ssrPersistentAllocator
+        {
+            .userData   = nullptr,
+            .alloc      = se_vk_ssr_alloc_persistent,
+            .free       = se_vk_ssr_free_persistent,
+        };
+        SsrAllocator ssrFrameAllocator
+        {
+            .userData   = nullptr,
+            .alloc      = se_vk_ssr_alloc_frame,
+            .free       = se_vk_ssr_free_frame,
+        };
+        SsrCreateInfo reflectionCreateInfo
+        {
+            .persistentAllocator    = &ssrPersistentAllocator,
+            .nonPersistentAllocator = &ssrFrameAllocator,
+            .bytecode               = (SsrSpirvWord*)bytecode.data,
+            .bytecodeNumWords       = bytecode.dataSize / 4,
+        };
+        SimpleSpirvReflection reflection;
+        ssr_construct(&reflection, &reflectionCreateInfo);
+        pipeline->workgroupSizeX = reflection.computeWorkGroupSizeX;
+        ssr_destroy(&reflection);
+    }
+    se_fs_file_content_free(bytecode);
+    if (!se_check(pipeline->workgroupSizeX)) return false;
+
+    VkDescriptorSetLayoutBinding bindings[5];
+    for (uint32_t it = 0; it < se_array_size(bindings); it++)
+    {
+        bindings[it] =
+        {
+            .binding            = it,
+            .descriptorType     = it == 0 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount    = 1,
+            .stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT,
+            .pImmutableSamplers = nullptr,
+        };
+    }
+    const VkDescriptorSetLayoutCreateInfo setLayoutCreateInfo =
+    {
+        .sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext          = nullptr,
+        .flags          = 0,
+        .bindingCount   = se_array_size(bindings),
+        .pBindings      = bindings,
+    };
+    if (!se_check(vkCreateDescriptorSetLayout(device->logicalHandle, &setLayoutCreateInfo, nullptr, &pipeline->setLayout) == VK_SUCCESS)) return false;
+    const VkPipelineLayoutCreateInfo layoutCreateInfo =
+    {
+        .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .pNext                  = nullptr,
+        .flags                  = 0,
+        .setLayoutCount         = 1,
+        .pSetLayouts            = &pipeline->setLayout,
+        .pushConstantRangeCount = 0,
+        .pPushConstantRanges    = nullptr,
+    };
+    if (!se_check(vkCreatePipelineLayout(device->logicalHandle, &layoutCreateInfo, nullptr, &pipeline->layout) == VK_SUCCESS)) return false;
+    const VkComputePipelineCreateInfo pipelineCreateInfo =
+    {
+        .sType              = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+        .pNext              = nullptr,
+        .flags              = 0,
+        .stage              =
+        {
+            .sType                  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .pNext                  = nullptr,
+            .flags                  = 0,
+            .stage                  = VK_SHADER_STAGE_COMPUTE_BIT,
+            .module                 = pipeline->module,
+            .pName                  = "main",
+            .pSpecializationInfo    = nullptr,
+        },
+        .layout             = pipeline->layout,
+        .basePipelineHandle = VK_NULL_HANDLE,
+        .basePipelineIndex  = -1,
+    };
+    if (!se_check(vkCreateComputePipelines(device->logicalHandle, VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &pipeline->handle) == VK_SUCCESS)) return false;
+
+    const VkDescriptorPoolSize poolSizes[] =
+    {
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1 },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4 },
+    };
+    const VkDescriptorPoolCreateInfo poolCreateInfo =
+    {
+        .sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .pNext          = nullptr,
+        .flags          = 0,
+        .maxSets        = 1,
+        .poolSizeCount  = se_array_size(poolSizes),
+        .pPoolSizes     = poolSizes,
+    };
+    if (!se_check(vkCreateDescriptorPool(device->logicalHandle, &poolCreateInfo, nullptr, &pipeline->descriptorPool) == VK_SUCCESS)) return false;
+    const VkDescriptorSetAllocateInfo setAllocateInfo =
+    {
+        .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext              = nullptr,
+        .descriptorPool     = pipeline->descriptorPool,
+        .descriptorSetCount = 1,
+        .pSetLayouts        = &pipeline->setLayout,
+    };
+    if (!se_check(vkAllocateDescriptorSets(device->logicalHandle, &setAllocateInfo, &pipeline->set) == VK_SUCCESS)) return false;
+
+    VkDescriptorBufferInfo bufferInfos[5];
+    VkWriteDescriptorSet writes[5];
+    for (uint32_t it = 0; it < se_array_size(writes); it++)
+    {
+        bufferInfos[it] = { buffers[it].handle, 0, VK_WHOLE_SIZE };
+        writes[it] =
+        {
+            .sType              = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .pNext              = nullptr,
+            .dstSet             = pipeline->set,
+            .dstBinding         = it,
+            .dstArrayElement    = 0,
+            .descriptorCount    = 1,
+            .descriptorType     = bindings[it].descriptorType,
+            .pImageInfo         = nullptr,
+            .pBufferInfo        = &bufferInfos[it],
+            .pTexelBufferView   = nullptr,
+        };
+    }
+    vkUpdateDescriptorSets(device->logicalHandle, se_array_size(writes), writes, 0, nullptr);
+    return true;
+}
+
+void check_pipeline_destroy(CheckPipeline* pipeline, const CheckDevice* device)
+{
+    if (pipeline->descriptorPool) vkDestroyDescriptorPool(device->logicalHandle, pipeline->descriptorPool, nullptr);
+    if (pipeline->handle) vkDestroyPipeline(device->logicalHandle, pipeline->handle, nullptr);
+    if (pipeline->layout) vkDestroyPipelineLayout(device->logicalHandle, pipeline->layout, nullptr);
+    if (pipeline->setLayout) vkDestroyDescriptorSetLayout(device->logicalHandle, pipeline->setLayout, nullptr);
+    if (pipeline->module) se_vk_utils_destroy_shader_module(device->logicalHandle, pipeline->module, nullptr);
+}
+
+//
+// Gpu and cpu can round differently for boxes that touch a frustum plane, so such instances aren't generated
+//
+bool is_near_frustum_plane(const SeFloat4 planes[6], const SeAabb& aabb, const SeFloat4x4& trf)
+{
+    const SeAabb aabbWs = se_aabb_transformed(aabb, trf);
+    const SeFloat3 center = (aabbWs.min + aabbWs.max) * 0.5f;
+    const SeFloat3 extents = (aabbWs.max - aabbWs.min) * 0.5f;
+    for (size_t it = 0; it < 6; it++)
+    {
+        const SeFloat3 normal = { planes[it].x, planes[it].y, planes[it].z };
+        const SeFloat3 absNormal = { fabsf(normal.x), fabsf(normal.y), fabsf(normal.z) };
+        const float distance = se_float3_dot(normal, center) + planes[it].w + se_float3_dot(absNormal, extents);
+        if (fabsf(distance) < PLANE_EPSILON * se_float3_len(normal)) return true;
+    }
+    return false;
+}
+
+bool is_matrix_equal(const SeFloat4x4& first, const SeFloat4x4& second)
+{
+    for (size_t row = 0; row < 4; row++)
+        for (size_t column = 0; column < 4; column++)
+            if (fabsf(first.m[row][column] - second.m[row][column]) > MATRIX_EPSILON * se_max(1.0f, fabsf(second.m[row][column])))
+                return false;
+    return true;
+}
+
+void check_mesh_culling()
+{
+    CheckDevice device;
+    CheckBuffer buffers[5] = { };
+    CheckPipeline pipeline = { };
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+    VkFence fence = VK_NULL_HANDLE;
+    CheckBuffer& frameDataBuffer = buffers[0];
+    CheckBuffer& instancesBuffer = buffers[1];
+    CheckBuffer& cullNodesBuffer = buffers[2];
+    CheckBuffer& transformsBuffer = buffers[3];
+    CheckBuffer& drawArgsBuffer = buffers[4];
+    //
+    // Geometry 0 is referenced by two nodes, so both of its cull nodes share one range of transforms
+    //
+    const SeAabb geometryAabbs[NUM_GEOMETRIES] =
+    {
+        { { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } },
+        { { -0.5f, 0.0f, -2.0f }, { 0.5f, 3.0f, 2.0f } },
+    };
+    const uint32_t firstTransforms[NUM_GEOMETRIES] = { 0, 2 * NUM_INSTANCES };
+    SeMeshCullNode cullNodes[NUM_CULL_NODES] =
+    {
+        { .modelTrf = SE_F4X4_IDENTITY, .geometryIndex = 0, .firstTransform = firstTransforms[0] },
+        { .modelTrf = se_float4x4_from_position({ 0.0f, 3.0f, 0.0f }) * se_float4x4_from_scale({ 0.5f, 0.5f, 0.5f }), .geometryIndex = 0, .firstTransform = firstTransforms[0] },
+        { .modelTrf = se_float4x4_from_rotation({ 0.0f, 45.0f, 0.0f }), .geometryIndex = 1, .firstTransform = firstTransforms[1] },
+    };
+    for (SeMeshCullNode& node : cullNodes)
+    {
+        const SeAabb& aabb = geometryAabbs[node.geometryIndex];
+        node.aabbMin = { aabb.min.x, aabb.min.y, aabb.min.z, 1.0f };
+        node.aabbMax = { aabb.max.x, aabb.max.y, aabb.max.z, 1.0f };
+    }
+    SeFloat4x4 viewProjections[NUM_CAMERAS];
+    SeFloat4 frustumPlanes[NUM_CAMERAS][6];
+    {
+        const SeFloat4x4 projection = se_render_perspective(60.0f, 16.0f / 9.0f, 0.1f, 50.0f);
+        const SeFloat4x4 views[NUM_CAMERAS] =
+        {
+            se_float4x4_look_at({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }),
+            se_float4x4_look_at({ 10.0f, 5.0f, -20.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }),
+        };
+        for (size_t it = 0; it < NUM_CAMERAS; it++)
+        {
+            viewProjections[it] = projection * se_float4x4_inverted(views[it]);
+            se_float4x4_get_frustum_planes(viewProjections[it], frustumPlanes[it]);
+        }
+    }
+    //
+    // Pseudo random instances, each one is regenerated until none of its nodes is near a frustum plane of any camera
+    //
+    SeFloat4x4* const instanceTrfs = (SeFloat4x4*)se_alloc(se_allocator_persistent(), sizeof(SeFloat4x4) * NUM_INSTANCES, se_alloc_tag);
+    {
+        uint32_t seed = 12345;
+        const auto next = [&seed](float min, float max) -> float
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return min + (max - min) * float(seed >> 8) / float(1 << 24);
+        };
+        for (uint32_t it = 0; it < NUM_INSTANCES; it++)
+        {
+            bool isNearPlane = true;
+            while (isNearPlane)
+            {
+                const float scale = next(0.5f, 2.0f);
+                instanceTrfs[it] =
+                    se_float4x4_from_position({ next(-40.0f, 40.0f), next(-20.0f, 20.0f), next(-40.0f, 60.0f) }) *
+                    se_float4x4_from_rotation({ next(0.0f, 360.0f), next(0.0f, 360.0f), next(0.0f, 360.0f) }) *
+                    se_float4x4_from_scale({ scale, scale, scale });
+                isNearPlane = false;
+                for (size_t cameraIt = 0; cameraIt < NUM_CAMERAS; cameraIt++)
+                    for (const SeMeshCullNode& node : cullNodes)
+                        isNearPlane |= is_near_frustum_plane(frustumPlanes[cameraIt], geometryAabbs[node.geometryIndex], instanceTrfs[it] * node.modelTrf);
+            }
+        }
+    }
+    SeFloat4x4* const nodeTrfs = (SeFloat4x4*)se_alloc(se_allocator_persistent(), sizeof(SeFloat4x4) * NUM_INSTANCES, se_alloc_tag);
+    SeFloat4x4* const expectedTrfs = (SeFloat4x4*)se_alloc(se_allocator_persistent(), sizeof(SeFloat4x4) * 2 * NUM_INSTANCES, se_alloc_tag);
+    bool* const isExpectedTrfUsed = (bool*)se_alloc(se_allocator_persistent(), sizeof(bool) * 2 * NUM_INSTANCES, se_alloc_tag);
+    uint32_t* const visibleIndices = (uint32_t*)se_alloc(se_allocator_persistent(), sizeof(uint32_t) * NUM_INSTANCES, se_alloc_tag);
+
+    do
+    {
+        if (!check_device_construct(&device)) break;
+        const VkBufferUsageFlags storageUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        if (!check_buffer_construct(&frameDataBuffer, &device, sizeof(SeMeshCullFrameData), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)) break;
+        if (!check_buffer_construct(&instancesBuffer, &device, sizeof(SeFloat4x4) * NUM_INSTANCES, storageUsage)) break;
+        if (!check_buffer_construct(&cullNodesBuffer, &device, sizeof(cullNodes), storageUsage)) break;
+        if (!check_buffer_construct(&transformsBuffer, &device, sizeof(SeFloat4x4) * 3 * NUM_INSTANCES, storageUsage)) break;
+        if (!check_buffer_construct(&drawArgsBuffer, &device, sizeof(SeDrawIndirectArgs) * NUM_GEOMETRIES, storageUsage)) break;
+        if (!check_pipeline_construct(&pipeline, &device, buffers)) break;
+        memcpy(instancesBuffer.mapped, instanceTrfs, instancesBuffer.size);
+        memcpy(cullNodesBuffer.mapped, cullNodes, cullNodesBuffer.size);
+
+        commandPool = se_vk_utils_create_command_pool(device.logicalHandle, device.queueFamilyIndex, nullptr, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+        const VkCommandBuffer commandBuffer = se_vk_utils_create_command_buffer(device.logicalHandle, commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+        const VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, nullptr, 0 };
+        if (!se_check(vkCreateFence(device.logicalHandle, &fenceCreateInfo, nullptr, &fence) == VK_SUCCESS)) break;
+
+        for (size_t cameraIt = 0; cameraIt < NUM_CAMERAS; cameraIt++)
+        {
+            //
+            // Same inputs as se_mesh_culler_cull writes
+            //
+            SeMeshCullFrameData* const frameData = (SeMeshCullFrameData*)frameDataBuffer.mapped;
+            *frameData =
+            {
+                .viewProjection = viewProjections[cameraIt],
+                .frustumPlanes  = { },
+                .numInstances   = NUM_INSTANCES,
+                .numCullNodes   = NUM_CULL_NODES,
+                ._pad           = { },
+            };
+            memcpy(frameData->frustumPlanes, frustumPlanes[cameraIt], sizeof(frameData->frustumPlanes));
+            SeDrawIndirectArgs* const drawArgs = (SeDrawIndirectArgs*)drawArgsBuffer.mapped;
+            for (uint32_t it = 0; it < NUM_GEOMETRIES; it++) drawArgs[it] = { NUM_VERTICES, 0, 0, 0 };
+
+            const VkCommandBufferBeginInfo beginInfo =
+            {
+                .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                .pNext              = nullptr,
+                .flags              = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+                .pInheritanceInfo   = nullptr,
+            };
+            if (!se_check(vkBeginCommandBuffer(commandBuffer, &beginInfo) == VK_SUCCESS)) break;
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline.handle);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline.layout, 0, 1, &pipeline.set, 0, nullptr);
+            vkCmdDispatch(commandBuffer, 1 + ((NUM_INSTANCES - 1) / pipeline.workgroupSizeX), NUM_CULL_NODES, 1);
+            const VkMemoryBarrier barrier =
+            {
+                .sType          = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                .pNext          = nullptr,
+                .srcAccessMask  = VK_ACCESS_SHADER_WRITE_BIT,
+                .dstAccessMask  = VK_ACCESS_HOST_READ_BIT,
+            };
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+            if (!se_check(vkEndCommandBuffer(commandBuffer) == VK_SUCCESS)) break;
+
+            const VkSubmitInfo submitInfo =
+            {
+                .sType                  = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                .pNext                  = nullptr,
+                .waitSemaphoreCount     = 0,
+                .pWaitSemaphores        = nullptr,
+                .pWaitDstStageMask      = nullptr,
+                .commandBufferCount     = 1,
+                .pCommandBuffers        = &commandBuffer,
+                .signalSemaphoreCount   = 0,
+                .pSignalSemaphores      = nullptr,
+            };
+            if (!se_check(vkQueueSubmit(device.queue, 1, &submitInfo, fence) == VK_SUCCESS)) break;
+            if (!se_check(vkWaitForFences(device.logicalHandle, 1, &fence, VK_TRUE, UINT64_MAX) == VK_SUCCESS)) break;
+            se_check(vkResetFences(device.logicalHandle, 1, &fence) == VK_SUCCESS);
+            se_check(vkResetCommandBuffer(commandBuffer, 0) == VK_SUCCESS);
+            //
+            // Instances of every node are culled on the cpu, geometry must draw exactly the visible (node, instance) pairs.
+            // Order of the written transforms depends on the order of workgroups, so they are compared as sets
+            //
+            const SeFloat4x4* const culledTrfs = (const SeFloat4x4*)transformsBuffer.mapped;
+            for (uint32_t geometryIt = 0; geometryIt < NUM_GEOMETRIES; geometryIt++)
+            {
+                uint32_t numExpected = 0;
+                for (const SeMeshCullNode& node : cullNodes)
+                {
+                    if (node.geometryIndex != geometryIt) continue;
+                    for (uint32_t it = 0; it < NUM_INSTANCES; it++) nodeTrfs[it] = instanceTrfs[it] * node.modelTrf;
+                    const size_t numVisible = se_frustum_cull_scalar(frustumPlanes[cameraIt], geometryAabbs[geometryIt], nodeTrfs, sizeof(SeFloat4x4), NUM_INSTANCES, visibleIndices);
+                    for (size_t it = 0; it < numVisible; it++)
+                        expectedTrfs[numExpected++] = se_float4x4_transposed(viewProjections[cameraIt] * nodeTrfs[visibleIndices[it]]);
+                }
+                // Every camera must see some instances of every geometry, otherwise the check is meaningless
+                se_check(numExpected > 0);
+                se_check(drawArgs[geometryIt].numVertices == NUM_VERTICES);
+                if (!se_check(drawArgs[geometryIt].numInstances == numExpected)) continue;
+
+                memset(isExpectedTrfUsed, 0, sizeof(bool) * numExpected);
+                for (uint32_t it = 0; it < numExpected; it++)
+                {
+                    const SeFloat4x4& culledTrf = culledTrfs[firstTransforms[geometryIt] + it];
+                    bool isFound = false;
+                    for (uint32_t expectedIt = 0; expectedIt < numExpected && !isFound; expectedIt++)
+                    {
+                        if (isExpectedTrfUsed[expectedIt] || !is_matrix_equal(culledTrf, expectedTrfs[expectedIt])) continue;
+                        isExpectedTrfUsed[expectedIt] = true;
+                        isFound = true;
+                    }
+                    se_check(isFound);
+                }
+            }
+        }
+    } while (false);
+
+    if (device.logicalHandle) vkDeviceWaitIdle(device.logicalHandle);
+    if (fence) vkDestroyFence(device.logicalHandle, fence, nullptr);
+    if (commandPool) se_vk_utils_destroy_command_pool(commandPool, device.logicalHandle, nullptr);
+    check_pipeline_destroy(&pipeline, &device);
+    for (CheckBuffer& buffer : buffers) check_buffer_destroy(&buffer, &device);
+    check_device_destroy(&device);
+
+    se_dealloc(se_allocator_persistent(), instanceTrfs, sizeof(SeFloat4x4) * NUM_INSTANCES);
+    se_dealloc(se_allocator_persistent(), nodeTrfs, sizeof(SeFloat4x4) * NUM_INSTANCES);
+    se_dealloc(se_allocator_persistent(), expectedTrfs, sizeof(SeFloat4x4) * 2 * NUM_INSTANCES);
+    se_dealloc(se_allocator_persistent(), isExpectedTrfUsed, sizeof(bool) * 2 * NUM_INSTANCES);
+    se_dealloc(se_allocator_persistent(), visibleIndices, sizeof(uint32_t) * NUM_INSTANCES);
+}
+
+int main(int argc, char* argv[])
+{
+    return se_check_run("Mesh culling", check_mesh_culling);
+}
@@ -0,0 +1,193 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+#include "checks/se_check.hpp"
+
+//
+// Queue scheduler check. Frames of a few pass groups are scheduled without a device, then queue of every group,
+// submissions, semaphore waits and timeline values are compared with the expected ones. Every frame starts with
+// timelines that were already used by previous frames, so values aren't just submission indices.
+//
+
+constexpr SeVkScheduledQueue MAIN = SE_VK_SCHEDULED_QUEUE_MAIN;
+constexpr SeVkScheduledQueue ASYNC = SE_VK_SCHEDULED_QUEUE_ASYNC_COMPUTE;
+constexpr size_t NO_WAIT = SE_VK_QUEUE_SCHEDULER_NO_WAIT;
+constexpr uint64_t FIRST_MAIN_VALUE = 10;
+constexpr uint64_t FIRST_ASYNC_VALUE = 4;
+
+struct CheckSubmission
+{
+    SeVkScheduledQueue  queue;
+    size_t              firstGroup;
+    size_t              numGroups;
+    size_t              wait;
+    uint64_t            signalValue;
+    uint64_t            waitValue;
+};
+
+//
+// Schedules the frame, assigns timeline values and compares submissions and the final value of each timeline
+// with the expected ones
+//
+template<size_t NumSubmissions>
+void check_frame(SeVkQueueScheduler* scheduler, const CheckSubmission (&expected)[NumSubmissions], uint64_t mainValue, uint64_t asyncValue)
+{
+    se_vk_queue_scheduler_schedule(scheduler);
+    uint64_t timelineValues[SE_VK_SCHEDULED_QUEUE_COUNT] = { FIRST_MAIN_VALUE, FIRST_ASYNC_VALUE };
+    se_vk_queue_scheduler_assign_timeline_values(scheduler, timelineValues);
+    se_check(timelineValues[MAIN] == mainValue);
+    se_check(timelineValues[ASYNC] == asyncValue);
+    if (!se_check(se_dynamic_array_size(scheduler->submissions) == NumSubmissions)) return;
+    for (size_t it = 0; it < NumSubmissions; it++)
+    {
+        const SeVkQueueSchedulerSubmission& submission = scheduler->submissions[it];
+        const CheckSubmission& expectedSubmission = expected[it];
+        se_check(submission.queue == expectedSubmission.queue);
+        se_check(submission.firstGroup == expectedSubmission.firstGroup);
+        se_check(submission.numGroups == expectedSubmission.numGroups);
+        se_check(submission.wait == expectedSubmission.wait);
+        se_check(submission.signalValue == expectedSubmission.signalValue);
+        se_check(submission.waitValue == expectedSubmission.waitValue);
+        for (size_t groupIt = 0; groupIt < expectedSubmission.numGroups; groupIt++)
+        {
+            const SeVkQueueSchedulerGroup& group = scheduler->groups[expectedSubmission.firstGroup + groupIt];
+            se_check(group.submission == it);
+            se_check(group.queue == expectedSubmission.queue);
+        }
+    }
+    //
+    // Last submission is on the main queue, so it defines the frame timeline value
+    //
+    se_check(scheduler->submissions[NumSubmissions - 1].queue == MAIN);
+    se_check(scheduler->submissions[NumSubmissions - 1].signalValue == mainValue);
+}
+
+void check_queue_scheduler()
+{
+    // Any unique pointers work as resources
+    const int resources[2] = { };
+    const void* const a = &resources[0];
+    const void* const b = &resources[1];
+
+    SeVkQueueScheduler scheduler;
+    se_vk_queue_scheduler_construct(&scheduler, se_allocator_persistent(), true);
+    //
+    // Empty frame is a single main queue submission
+    //
+    {
+        check_frame(&scheduler, { { MAIN, 0, 0, NO_WAIT, 11, 0 } }, 11, FIRST_ASYNC_VALUE);
+    }
+    //
+    // Without async compute requests everything is one main queue submission. First group is always on the main queue
+    //
+    {
+        se_vk_queue_scheduler_reset(&scheduler);
+        se_check(se_vk_queue_scheduler_add_group(&scheduler, true) == MAIN);
+        se_vk_queue_scheduler_add_access(&scheduler, a, true);
+        se_check(se_vk_queue_scheduler_add_group(&scheduler, false) == MAIN);
+        se_vk_queue_scheduler_add_access(&scheduler, a, false);
+        se_check(se_vk_queue_scheduler_add_group(&scheduler, false) == MAIN);
+        se_vk_queue_scheduler_add_access(&scheduler, a, true);
+        check_frame(&scheduler, { { MAIN, 0, 3, NO_WAIT, 11, 0 } }, 11, FIRST_ASYNC_VALUE);
+        // Write after read depends on the read and on the previous write
+        se_check(scheduler.groups[1].dependencies == 0b001);
+        se_check(scheduler.groups[2].dependencies == 0b011);
+    }
+    //
+    // Independent async group waits only for the first group. Main queue group that reads its result waits for its
+    // timeline value, main queue group between them doesn't
+    //
+    {
+        se_vk_queue_scheduler_reset(&scheduler);
+        se_check(se_vk_queue_scheduler_add_group(&scheduler, false) == MAIN);
+        se_vk_queue_scheduler_add_access(&scheduler, b, true);
+        se_check(se_vk_queue_scheduler_add_group(&scheduler, true) == ASYNC);
+        se_vk_queue_scheduler_add_access(&scheduler, a, true);
+        se_check(se_vk_queue_scheduler_add_group(&scheduler, false) == MAIN);
+        se_vk_queue_scheduler_add_access(&scheduler, b, false);
+        se_check(se_vk_queue_scheduler_add_group(&scheduler, false) == MAIN);
+        se_vk_queue_scheduler_add_access(&scheduler, a, false);
+        se_vk_queue_scheduler_add_access(&scheduler, b, false);
+        check_frame
+        (
+            &scheduler,
+            {
+                { MAIN,     0, 1, NO_WAIT,  11, 0 },
+                { ASYNC,    1, 1, 0,        5,  11 },
+                { MAIN,     2, 2, 1,        12, 5 },
+            },
+            12, 5
+        );
+        se_check(scheduler.groups[1].dependencies == 0);
+        se_check(scheduler.groups[3].dependencies == 0b0011);
+    }
+    //
+    // Frame that ends with an async group gets an empty main queue submission that waits for it
+    //
+    {
+        se_vk_queue_scheduler_reset(&scheduler);
+        se_vk_queue_scheduler_add_group(&scheduler, false);
+        se_vk_queue_scheduler_add_access(&scheduler, a, true);
+        se_check(se_vk_queue_scheduler_add_group(&scheduler, true) == ASYNC);
+        se_vk_queue_scheduler_add_access(&scheduler, a, false);
+        check_frame
+        (
+            &scheduler,
+            {
+                { MAIN,     0, 1, NO_WAIT,  11, 0 },
+                { ASYNC,    1, 1, 0,        5,  11 },
+                { MAIN,     2, 0, 1,        12, 5 },
+            },
+            12, 5
+        );
+    }
+    //
+    // Waits for submissions that the queue has already waited for (directly or through a later submission) are skipped.
+    // Explicit dependencies work the same way as resource dependencies
+    //
+    {
+        se_vk_queue_scheduler_reset(&scheduler);
+        se_vk_queue_scheduler_add_group(&scheduler, false);
+        se_vk_queue_scheduler_add_group(&scheduler, true);
+        se_vk_queue_scheduler_add_group(&scheduler, false);
+        se_vk_queue_scheduler_add_dependencies(&scheduler, 0b00010);
+        se_vk_queue_scheduler_add_group(&scheduler, true);
+        se_vk_queue_scheduler_add_group(&scheduler, false);
+        se_vk_queue_scheduler_add_dependencies(&scheduler, 0b01010);
+        check_frame
+        (
+            &scheduler,
+            {
+                { MAIN,     0, 1, NO_WAIT,  11, 0 },
+                { ASYNC,    1, 1, 0,        5,  11 },
+                { MAIN,     2, 1, 1,        12, 5 },
+                { ASYNC,    3, 1, NO_WAIT,  6,  0 },
+                { MAIN,     4, 1, 3,        13, 6 },
+            },
+            13, 6
+        );
+    }
+    se_vk_queue_scheduler_destroy(&scheduler);
+    //
+    // Without async compute (device doesn't support it or it is disabled) async requests fall back to the main queue :
+    // whole frame is a single submission without semaphore waits and async compute timeline isn't used
+    //
+    se_vk_queue_scheduler_construct(&scheduler, se_allocator_persistent(), false);
+    {
+        se_check(se_vk_queue_scheduler_add_group(&scheduler, false) == MAIN);
+        se_vk_queue_scheduler_add_access(&scheduler, a, true);
+        se_check(se_vk_queue_scheduler_add_group(&scheduler, true) == MAIN);
+        se_vk_queue_scheduler_add_access(&scheduler, a, false);
+        se_vk_queue_scheduler_add_access(&scheduler, b, true);
+        se_check(se_vk_queue_scheduler_add_group(&scheduler, true) == MAIN);
+        se_vk_queue_scheduler_add_access(&scheduler, b, false);
+        se_check(se_vk_queue_scheduler_add_group(&scheduler, false) == MAIN);
+        se_vk_queue_scheduler_add_access(&scheduler, b, false);
+        check_frame(&scheduler, { { MAIN, 0, 4, NO_WAIT, 11, 0 } }, 11, FIRST_ASYNC_VALUE);
+    }
+    se_vk_queue_scheduler_destroy(&scheduler);
+}
+
+int main(int argc, char* argv[])
+{
+    return se_check_run("Queue scheduler", check_queue_scheduler);
+}
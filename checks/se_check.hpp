@@ -0,0 +1,60 @@
+#ifndef _SE_CHECK_HPP_
+#define _SE_CHECK_HPP_
+
+#include "engine/se_engine.hpp"
+
+//
+// Headless checks.
+//
+// Every folder in "checks" is a separate executable, which is built and run by msvc_run_checks.bat. Checks are built in
+// release, where se_assert is compiled out, so they use se_check instead : failed condition is printed to the debug output
+// and the executable returns a nonzero exit code. Unlike se_assert, se_check doesn't abort, so one run reports every failed condition.
+//
+// Check executables don't create a window. se_check_run initializes only allocators, strings, debug output and the file system,
+// which is enough for the cpu-side planners of the renderer and for checks that load shaders and create their own device.
+//
+
+using SeCheckPfn = void (*)();
+
+struct SeCheckState
+{
+    size_t numChecks;
+    size_t numFailedChecks;
+} g_checkState;
+
+#define se_check(cond) _se_check_impl(!!(cond), #cond, __FILE__, __LINE__)
+
+inline bool _se_check_impl(bool result, const char* condition, const char* file, size_t line)
+{
+    g_checkState.numChecks += 1;
+    if (!result)
+    {
+        g_checkState.numFailedChecks += 1;
+        se_dbg_error("Check failed. File : {}, line : {}, condition : {}", file, line, condition);
+    }
+    return result;
+}
+
+int se_check_run(const char* name, SeCheckPfn check)
+{
+    _se_allocator_init();
+    _se_string_init();
+    _se_dbg_init();
+    _se_fs_init({ .applicationName = name, .createUserDataFolder = false });
+
+    g_checkState = { };
+    check();
+    if (g_checkState.numFailedChecks)
+        se_dbg_error("{} : {} of {} checks failed", name, g_checkState.numFailedChecks, g_checkState.numChecks);
+    else
+        se_dbg_message("{} : all {} checks passed", name, g_checkState.numChecks);
+    const int exitCode = g_checkState.numFailedChecks ? 1 : 0;
+
+    _se_fs_terminate();
+    _se_dbg_terminate();
+    _se_string_terminate();
+    _se_allocator_terminate();
+    return exitCode;
+}
+
+#endif
@@ -0,0 +1,370 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+#include "checks/se_check.hpp"
+
+//
+// Texture compression check. Synthetic images are encoded and decoded with every supported format and compared with
+// the source by PSNR. Image size isn't a multiple of the block size, so partial edge blocks are covered too.
+// BC7 decoder is also checked with hand made blocks of every mode (the encoder produces only mode 6) and with reserved blocks.
+//
+
+constexpr uint32_t IMAGE_WIDTH = 10;
+constexpr uint32_t IMAGE_HEIGHT = 6;
+constexpr size_t IMAGE_SIZE = IMAGE_WIDTH * IMAGE_HEIGHT * 4;
+
+enum struct ImagePattern
+{
+    FLAT,
+    GRADIENT,
+    ALPHA,
+    TWO_COLORS,
+};
+
+struct CompressionMode
+{
+    SeTextureFormat format;
+    size_t          numChannels;
+    // Minimal PSNR for every pattern in ImagePattern order (alpha is compared only by formats with alpha channel)
+    float           minPsnr[4];
+};
+
+const CompressionMode COMPRESSION_MODES[] =
+{
+    { SeTextureFormat::BC1_RGBA_UNORM,  3, { 42.0f, 30.0f, 42.0f, 60.0f } },
+    { SeTextureFormat::BC3_UNORM,       4, { 42.0f, 30.0f, 42.0f, 60.0f } },
+    { SeTextureFormat::BC4_UNORM,       1, { 60.0f, 34.0f, 60.0f, 60.0f } },
+    { SeTextureFormat::BC5_UNORM,       2, { 60.0f, 34.0f, 60.0f, 60.0f } },
+    { SeTextureFormat::BC7_UNORM,       4, { 50.0f, 42.0f, 52.0f, 48.0f } },
+};
+
+void make_image(ImagePattern pattern, uint8_t* rgba)
+{
+    for (uint32_t y = 0; y < IMAGE_HEIGHT; y++)
+        for (uint32_t x = 0; x < IMAGE_WIDTH; x++)
+        {
+            uint8_t* const texel = rgba + (y * IMAGE_WIDTH + x) * 4;
+            switch (pattern)
+            {
+                case ImagePattern::FLAT:
+                {
+                    const uint8_t color[4] = { 200, 100, 50, 255 };
+                    memcpy(texel, color, 4);
+                } break;
+                case ImagePattern::GRADIENT:
+                {
+                    // Diagonal gradient along a single color line, which block endpoints can represent
+                    const uint32_t step = x + y;
+                    const uint8_t color[4] = { uint8_t(30 + step * 15), uint8_t(220 - step * 14), uint8_t(60 + step * 8), 255 };
+                    memcpy(texel, color, 4);
+                } break;
+                case ImagePattern::ALPHA:
+                {
+                    const uint8_t color[4] = { 90, 160, 220, uint8_t(x < 5 ? 0 : 255) };
+                    memcpy(texel, color, 4);
+                } break;
+                case ImagePattern::TWO_COLORS:
+                {
+                    const bool isFirst = ((x + y) & 1) == 0;
+                    const uint8_t first[4] = { 255, 0, 0, 255 };
+                    const uint8_t second[4] = { 0, 0, 255, 64 };
+                    memcpy(texel, isFirst ? first : second, 4);
+                } break;
+            }
+        }
+}
+
+void check_round_trip()
+{
+    uint8_t source[IMAGE_SIZE];
+    uint8_t decoded[IMAGE_SIZE];
+    uint8_t encoded[IMAGE_SIZE];
+    for (const CompressionMode& mode : COMPRESSION_MODES)
+    {
+        const size_t encodedSize = se_texture_compression_get_size(mode.format, IMAGE_WIDTH, IMAGE_HEIGHT);
+        se_check(encodedSize == 3 * 2 * se_texture_compression_get_block_size(mode.format));
+        for (size_t patternIt = 0; patternIt < se_array_size(mode.minPsnr); patternIt++)
+        {
+            const ImagePattern pattern = ImagePattern(patternIt);
+            make_image(pattern, source);
+            memset(encoded, 0, sizeof(encoded));
+            memset(decoded, 0, sizeof(decoded));
+            se_texture_compression_encode(mode.format, source, IMAGE_WIDTH, IMAGE_HEIGHT, encoded);
+            se_texture_compression_decode(mode.format, encoded, IMAGE_WIDTH, IMAGE_HEIGHT, decoded);
+            //
+            // BC1 alpha is one bit : texels with alpha below 128 are decoded as transparent black, color of the rest is compared
+            //
+            if (mode.format == SeTextureFormat::BC1_RGBA_UNORM && pattern != ImagePattern::FLAT && pattern != ImagePattern::GRADIENT)
+            {
+                for (size_t it = 0; it < IMAGE_WIDTH * IMAGE_HEIGHT; it++)
+                {
+                    const bool isTransparent = source[it * 4 + 3] < 128;
+                    se_check(decoded[it * 4 + 3] == (isTransparent ? 0 : 255));
+                    if (isTransparent) memset(source + it * 4, 0, 4);
+                }
+            }
+            const float psnr = se_texture_compression_psnr(source, decoded, IMAGE_WIDTH, IMAGE_HEIGHT, mode.numChannels);
+            se_check(psnr >= mode.minPsnr[patternIt]);
+        }
+    }
+}
+
+// =======================================================================
+//
+// BC7 blocks of every mode
+//
+// =======================================================================
+
+struct ExpectedTexel
+{
+    size_t  index;
+    uint8_t rgba[4];
+};
+
+//
+// Anchor texels store indices with one bit less. Texel 0 is always an anchor
+//
+void write_bc7_indices(SeTextureCompressionBits& bits, const uint32_t (&indices)[16], size_t numBits, size_t anchor1, size_t anchor2)
+{
+    for (size_t it = 0; it < 16; it++)
+    {
+        const bool isAnchor = it == 0 || it == anchor1 || it == anchor2;
+        se_texture_compression_bits_write(bits, indices[it], numBits - (isAnchor ? 1 : 0));
+    }
+}
+
+template<size_t NumTexels>
+void check_bc7_block(const uint8_t (&block)[16], const ExpectedTexel (&expected)[NumTexels])
+{
+    uint8_t decoded[16 * 4];
+    se_texture_compression_decode(SeTextureFormat::BC7_UNORM, block, 4, 4, decoded);
+    for (const ExpectedTexel& texel : expected)
+    {
+        const uint8_t* const rgba = decoded + texel.index * 4;
+        se_check(rgba[0] == texel.rgba[0] && rgba[1] == texel.rgba[1] && rgba[2] == texel.rgba[2] && rgba[3] == texel.rgba[3]);
+    }
+}
+
+void check_bc7_modes()
+{
+    //
+    // Mode 0 : three subsets (partition 1), 4 bit colors, p-bit per endpoint, 3 bit indices. Anchors are 0, 3 and 8
+    //
+    {
+        uint8_t block[16] = { };
+        SeTextureCompressionBits bits = { block, 0 };
+        se_texture_compression_bits_write(bits, 1 << 0, 1);
+        se_texture_compression_bits_write(bits, 1, 4);
+        const uint32_t endpoints[3][2][3] = { { { 15, 0, 0 }, { 0, 0, 0 } }, { { 0, 15, 0 }, { 0, 0, 0 } }, { { 0, 0, 8 }, { 15, 15, 15 } } };
+        for (size_t channel = 0; channel < 3; channel++)
+            for (size_t subset = 0; subset < 3; subset++)
+                for (size_t endpoint = 0; endpoint < 2; endpoint++)
+                    se_texture_compression_bits_write(bits, endpoints[subset][endpoint][channel], 4);
+        const uint32_t pBits[6] = { 1, 0, 0, 1, 0, 1 };
+        for (uint32_t pBit : pBits) se_texture_compression_bits_write(bits, pBit, 1);
+        write_bc7_indices(bits, { 0, 7, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0 }, 3, 3, 8);
+        se_check(bits.position == 128);
+        check_bc7_block(block,
+        {
+            { 0,  { 255, 8, 8, 255 } },
+            { 1,  { 0, 0, 0, 255 } },
+            { 3,  { 3, 146, 3, 255 } },
+            { 8,  { 0, 0, 132, 255 } },
+            { 12, { 255, 255, 255, 255 } },
+        });
+    }
+    //
+    // Mode 1 : two subsets (partition 13, second subset is the bottom half), 6 bit colors, shared p-bit per subset,
+    // 3 bit indices. Anchors are 0 and 15
+    //
+    {
+        uint8_t block[16] = { };
+        SeTextureCompressionBits bits = { block, 0 };
+        se_texture_compression_bits_write(bits, 1 << 1, 2);
+        se_texture_compression_bits_write(bits, 13, 6);
+        const uint32_t endpoints[2][2][3] = { { { 20, 40, 60 }, { 63, 63, 63 } }, { { 40, 50, 60 }, { 0, 0, 0 } } };
+        for (size_t channel = 0; channel < 3; channel++)
+            for (size_t subset = 0; subset < 2; subset++)
+                for (size_t endpoint = 0; endpoint < 2; endpoint++)
+                    se_texture_compression_bits_write(bits, endpoints[subset][endpoint][channel], 6);
+        se_texture_compression_bits_write(bits, 0, 1);
+        se_texture_compression_bits_write(bits, 1, 1);
+        write_bc7_indices(bits, { 0, 7, 0, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0, 0, 0, 3 }, 3, 15, 15);
+        se_check(bits.position == 128);
+        check_bc7_block(block,
+        {
+            { 0,  { 80, 161, 241, 255 } },
+            { 1,  { 253, 253, 253, 255 } },
+            { 8,  { 163, 203, 243, 255 } },
+            { 9,  { 2, 2, 2, 255 } },
+            { 15, { 95, 118, 141, 255 } },
+        });
+    }
+    //
+    // Mode 2 : three subsets (partition 0), 5 bit colors without p-bits, 2 bit indices. Anchors are 0, 3 and 15
+    //
+    {
+        uint8_t block[16] = { };
+        SeTextureCompressionBits bits = { block, 0 };
+        se_texture_compression_bits_write(bits, 1 << 2, 3);
+        se_texture_compression_bits_write(bits, 0, 6);
+        const uint32_t endpoints[3][2][3] = { { { 31, 0, 0 }, { 0, 0, 0 } }, { { 0, 31, 0 }, { 0, 0, 0 } }, { { 0, 0, 31 }, { 0, 0, 0 } } };
+        for (size_t channel = 0; channel < 3; channel++)
+            for (size_t subset = 0; subset < 3; subset++)
+                for (size_t endpoint = 0; endpoint < 2; endpoint++)
+                    se_texture_compression_bits_write(bits, endpoints[subset][endpoint][channel], 5);
+        write_bc7_indices(bits, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0 }, 2, 3, 15);
+        se_check(bits.position == 128);
+        check_bc7_block(block,
+        {
+            { 0,  { 255, 0, 0, 255 } },
+            { 2,  { 0, 255, 0, 255 } },
+            { 9,  { 0, 0, 0, 255 } },
+            { 12, { 0, 0, 255, 255 } },
+        });
+    }
+    //
+    // Mode 3 : two subsets (partition 0, second subset is the two right columns), 7 bit colors, p-bit per endpoint,
+    // 2 bit indices. Anchors are 0 and 15
+    //
+    {
+        uint8_t block[16] = { };
+        SeTextureCompressionBits bits = { block, 0 };
+        se_texture_compression_bits_write(bits, 1 << 3, 4);
+        se_texture_compression_bits_write(bits, 0, 6);
+        const uint32_t endpoints[2][2][3] = { { { 127, 0, 64 }, { 0, 0, 0 } }, { { 0, 0, 0 }, { 100, 100, 100 } } };
+        for (size_t channel = 0; channel < 3; channel++)
+            for (size_t subset = 0; subset < 2; subset++)
+                for (size_t endpoint = 0; endpoint < 2; endpoint++)
+                    se_texture_compression_bits_write(bits, endpoints[subset][endpoint][channel], 7);
+        const uint32_t pBits[4] = { 1, 0, 1, 0 };
+        for (uint32_t pBit : pBits) se_texture_compression_bits_write(bits, pBit, 1);
+        write_bc7_indices(bits, { 0, 3, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 2, 15, 15);
+        se_check(bits.position == 128);
+        check_bc7_block(block,
+        {
+            { 0,  { 255, 1, 129, 255 } },
+            { 1,  { 0, 0, 0, 255 } },
+            { 2,  { 1, 1, 1, 255 } },
+            { 3,  { 135, 135, 135, 255 } },
+        });
+    }
+    //
+    // Mode 4 : single subset, 5 bit colors and 6 bit alpha, 2 bit and 3 bit indices. Index selection bit is set,
+    // so 3 bit indices are used for color and 2 bit indices for alpha
+    //
+    {
+        uint8_t block[16] = { };
+        SeTextureCompressionBits bits = { block, 0 };
+        se_texture_compression_bits_write(bits, 1 << 4, 5);
+        se_texture_compression_bits_write(bits, 0, 2);
+        se_texture_compression_bits_write(bits, 1, 1);
+        const uint32_t colors[2][3] = { { 31, 0, 0 }, { 0, 0, 31 } };
+        for (size_t channel = 0; channel < 3; channel++)
+            for (size_t endpoint = 0; endpoint < 2; endpoint++)
+                se_texture_compression_bits_write(bits, colors[endpoint][channel], 5);
+        se_texture_compression_bits_write(bits, 63, 6);
+        se_texture_compression_bits_write(bits, 0, 6);
+        write_bc7_indices(bits, { 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 2, 0, 0);
+        write_bc7_indices(bits, { 0, 0, 7, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 3, 0, 0);
+        se_check(bits.position == 128);
+        check_bc7_block(block,
+        {
+            { 0,  { 255, 0, 0, 255 } },
+            { 1,  { 255, 0, 0, 0 } },
+            { 2,  { 0, 0, 255, 255 } },
+            { 3,  { 108, 0, 147, 255 } },
+        });
+    }
+    //
+    // Mode 5 : single subset, 7 bit colors and 8 bit alpha, separate 2 bit color and alpha indices.
+    // Rotation 1 swaps red and alpha after interpolation
+    //
+    {
+        uint8_t block[16] = { };
+        SeTextureCompressionBits bits = { block, 0 };
+        se_texture_compression_bits_write(bits, 1 << 5, 6);
+        se_texture_compression_bits_write(bits, 1, 2);
+        const uint32_t colors[2][3] = { { 64, 0, 127 }, { 0, 127, 0 } };
+        for (size_t channel = 0; channel < 3; channel++)
+            for (size_t endpoint = 0; endpoint < 2; endpoint++)
+                se_texture_compression_bits_write(bits, colors[endpoint][channel], 7);
+        se_texture_compression_bits_write(bits, 10, 8);
+        se_texture_compression_bits_write(bits, 250, 8);
+        write_bc7_indices(bits, { 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 2, 0, 0);
+        write_bc7_indices(bits, { 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 2, 0, 0);
+        se_check(bits.position == 128);
+        check_bc7_block(block,
+        {
+            { 0,  { 10, 0, 255, 129 } },
+            { 1,  { 10, 255, 0, 0 } },
+            { 2,  { 250, 0, 255, 129 } },
+        });
+    }
+    //
+    // Mode 6 : single subset, 7 bit rgba with p-bit per endpoint, 4 bit indices
+    //
+    {
+        uint8_t block[16] = { };
+        SeTextureCompressionBits bits = { block, 0 };
+        se_texture_compression_bits_write(bits, 1 << 6, 7);
+        const uint32_t endpoints[2][4] = { { 10, 20, 30, 127 }, { 100, 0, 50, 64 } };
+        for (size_t channel = 0; channel < 4; channel++)
+            for (size_t endpoint = 0; endpoint < 2; endpoint++)
+                se_texture_compression_bits_write(bits, endpoints[endpoint][channel], 7);
+        se_texture_compression_bits_write(bits, 1, 1);
+        se_texture_compression_bits_write(bits, 0, 1);
+        write_bc7_indices(bits, { 0, 15, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 4, 0, 0);
+        se_check(bits.position == 128);
+        check_bc7_block(block,
+        {
+            { 0,  { 21, 41, 61, 255 } },
+            { 1,  { 200, 0, 100, 128 } },
+            { 2,  { 116, 19, 82, 188 } },
+        });
+    }
+    //
+    // Mode 7 : two subsets (partition 13), 5 bit rgba with p-bit per endpoint, 2 bit indices. Anchors are 0 and 15
+    //
+    {
+        uint8_t block[16] = { };
+        SeTextureCompressionBits bits = { block, 0 };
+        se_texture_compression_bits_write(bits, 1 << 7, 8);
+        se_texture_compression_bits_write(bits, 13, 6);
+        const uint32_t endpoints[2][2][4] = { { { 31, 0, 0, 31 }, { 0, 0, 0, 0 } }, { { 0, 0, 0, 16 }, { 0, 31, 0, 31 } } };
+        for (size_t channel = 0; channel < 4; channel++)
+            for (size_t subset = 0; subset < 2; subset++)
+                for (size_t endpoint = 0; endpoint < 2; endpoint++)
+                    se_texture_compression_bits_write(bits, endpoints[subset][endpoint][channel], 5);
+        const uint32_t pBits[4] = { 1, 0, 0, 1 };
+        for (uint32_t pBit : pBits) se_texture_compression_bits_write(bits, pBit, 1);
+        write_bc7_indices(bits, { 0, 3, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 1 }, 2, 15, 15);
+        se_check(bits.position == 128);
+        check_bc7_block(block,
+        {
+            { 0,  { 255, 4, 4, 255 } },
+            { 1,  { 0, 0, 0, 0 } },
+            { 8,  { 4, 255, 4, 255 } },
+            { 15, { 1, 84, 1, 171 } },
+        });
+    }
+    //
+    // Reserved blocks (no mode bit in the first byte) are decoded as transparent black whatever the rest of the block is
+    //
+    {
+        const uint8_t zeroBlock[16] = { };
+        const uint8_t reservedBlock[16] = { 0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+        check_bc7_block(zeroBlock, { { 0, { 0, 0, 0, 0 } }, { 15, { 0, 0, 0, 0 } } });
+        check_bc7_block(reservedBlock, { { 0, { 0, 0, 0, 0 } }, { 7, { 0, 0, 0, 0 } }, { 15, { 0, 0, 0, 0 } } });
+    }
+}
+
+void check_texture_compression()
+{
+    check_round_trip();
+    check_bc7_modes();
+}
+
+int main(int argc, char* argv[])
+{
+    return se_check_run("Texture compression", check_texture_compression);
+}
@@ -18,7 +18,6 @@ layout(std140, set = 0, binding = 1) readonly buffer Vertices   { Vertex vertice
 layout(std140, set = 0, binding = 2) readonly buffer Colorings  { Coloring colorings[]; };
 
 layout(        set = 1, binding = 0) uniform sampler2D renderAtlas;
-layout(        set = 1, binding = 1) uniform DrawData { uint firstVertexIndex; };
 
 layout (location = 0) in vec2 inUv;
 layout (location = 1) flat in uint inColoringIndex;
@@ -94,6 +94,7 @@ typedef struct SsrTypeInfo
             const char* typeName;
             struct SsrTypeInfo** members;
             const char** memberNames;
+            uint32_t* memberOffsets;    // Values of the Offset decoration, zero if member isn't decorated
             size_t numMembers;
         } structure;
         struct
@@ -224,6 +225,7 @@ void ssr_construct(SimpleSpirvReflection* reflection, const SsrCreateInfo* creat
 void ssr_destroy(SimpleSpirvReflection* reflection);
 
 size_t ssr_get_type_size(const SsrTypeInfo* typeInfo);
+size_t ssr_get_block_size(const SsrTypeInfo* typeInfo); // Struct size with member offsets (end of the last member), for other types same as ssr_get_type_size
 const char* ssr_shader_type_to_str(SsrShaderType shader);
 const char* ssr_type_to_str(SsrType type);
 const char* ssr_uniform_kind_to_str(SsrUniformKind kind);
@@ -354,6 +356,7 @@ typedef struct SsrSpirvStructMember
 {
     SsrSpirvId* id;
     const char* name;
+    uint32_t offset;
 } SsrSpirvStructMember;
 
 typedef struct SsrSpirvStruct
@@ -587,10 +590,12 @@ SsrTypeInfo* __ssr_save_or_get_type_from_reflection(SsrSpirvStruct* structs, siz
                 resultType.info.structure.numMembers = spirvStruct->numMembers;
                 resultType.info.structure.members = (SsrTypeInfo**)__ssr_alloc(sizeof(SsrTypeInfo*) * resultType.info.structure.numMembers, reflection);
                 resultType.info.structure.memberNames = (const char**)__ssr_alloc(sizeof(const char*) * resultType.info.structure.numMembers, reflection);
+                resultType.info.structure.memberOffsets = (uint32_t*)__ssr_alloc(sizeof(uint32_t) * resultType.info.structure.numMembers, reflection);
                 for (size_t memberIt = 0; memberIt < resultType.info.structure.numMembers; memberIt++)
                 {
                     resultType.info.structure.members[memberIt] = __ssr_save_or_get_type_from_reflection(structs, numStructs, ids, spirvStruct->members[memberIt].id, reflection);
                     resultType.info.structure.memberNames[memberIt] = __ssr_save_string(spirvStruct->members[memberIt].name, reflection);
+                    resultType.info.structure.memberOffsets[memberIt] = spirvStruct->members[memberIt].offset;
                 }
             }
         } break;
@@ -830,7 +835,7 @@ void __ssr_process_shader_uniform(SsrSpirvStruct* structs, size_t numStructs, Ss
     uniform->type = __ssr_save_or_get_type_from_reflection(structs, numStructs, ids, uniformIdOpType, reflection);
     uint16_t opType = ssr_opcode(uniformIdOpType->declarationLocation[0]);
     SpvStorageClass storageClass = (SpvStorageClass)opTypePointer[2];
-    if (opType == SpvOpTypeArray)
+    if (opType == SpvOpTypeArray || opType == SpvOpTypeRuntimeArray)
     {
         uniformIdOpType = &ids[uniformIdOpType->declarationLocation[2]]; // go to array entry type id
         opType = ssr_opcode(uniformIdOpType->declarationLocation[0]); // get array entry OpType
@@ -1192,13 +1197,14 @@ void ssr_construct(SimpleSpirvReflection* reflection, const SsrCreateInfo* creat
                 {
                     SsrSpirvStructMember* member = &shaderStruct->members[it];
                     member->id = &ids[instruction[2 + it]];
+                    member->offset = 0;
                 }
             } break;
         }
         instruction += instructionWordCount;
     }
     //
-    // Step 2.4. Save struct member names
+    // Step 2.4. Save struct member names and offsets
     //
     for (instruction = bytecode + 5; instruction < (bytecode + wordCount);)
     {
@@ -1223,6 +1229,26 @@ void ssr_construct(SimpleSpirvReflection* reflection, const SsrCreateInfo* creat
                 ssr_assert(structure);
                 structure->members[memberIndex].name = (const char*)&instruction[3];
             } break;
+            case SpvOpMemberDecorate:
+            {
+                ssr_assert(instructionWordCount >= 4);
+                const SpvDecoration decoration = (SpvDecoration)instruction[3];
+                if (decoration != SpvDecorationOffset) break;
+                ssr_assert(instructionWordCount == 5);
+                const SsrSpirvWord memberIndex = instruction[2];
+                SsrSpirvId* structId = &ids[instruction[1]];
+                SsrSpirvStruct* structure = NULL;
+                for (size_t it = 0; it < numStructs; it++)
+                {
+                    if (structs[it].id == structId)
+                    {
+                        structure = &structs[it];
+                        break;
+                    }
+                }
+                ssr_assert(structure);
+                structure->members[memberIndex].offset = instruction[4];
+            } break;
         }
         instruction += instructionWordCount;
     }
@@ -1378,6 +1404,24 @@ size_t ssr_get_type_size(const SsrTypeInfo* typeInfo)
     return 0;
 }
 
+size_t ssr_get_block_size(const SsrTypeInfo* typeInfo)
+{
+    if (typeInfo->type != SSR_TYPE_STRUCT)
+    {
+        return ssr_get_type_size(typeInfo);
+    }
+    //
+    // Members can be reordered by offsets and padded, so size is the end of the member that ends last
+    //
+    size_t resultSize = 0;
+    for (size_t it = 0; it < typeInfo->info.structure.numMembers; it++)
+    {
+        const size_t memberEnd = typeInfo->info.structure.memberOffsets[it] + ssr_get_block_size(typeInfo->info.structure.members[it]);
+        if (memberEnd > resultSize) resultSize = memberEnd;
+    }
+    return resultSize;
+}
+
 const char* ssr_shader_type_to_str(SsrShaderType shader)
 {
     static const char* types[] =
@@ -12,6 +12,17 @@ constexpr size_t SE_MAX_SPECIALIZATION_CONSTANTS    = 8;
 constexpr size_t SE_MAX_BINDINGS                    = 8;
 constexpr size_t SE_MAX_PASS_DEPENDENCIES           = 64;
 constexpr size_t SE_MAX_PASS_RENDER_TARGETS         = 8;
+constexpr size_t SE_MAX_PASS_INPUT_ATTACHMENTS      = 4;
+constexpr size_t SE_MAX_PUSH_CONSTANTS_SIZE         = 128; // Minimal maxPushConstantsSize guaranteed by vulkan
+
+// Bindless heap layout (see se_render_is_bindless_supported)
+constexpr uint32_t SE_BINDLESS_SET                  = 7;
+constexpr uint32_t SE_BINDLESS_BUFFERS_BINDING      = 0;
+constexpr uint32_t SE_BINDLESS_TEXTURES_BINDING     = 1;
+constexpr uint32_t SE_BINDLESS_SAMPLERS_BINDING     = 2;
+constexpr uint32_t SE_BINDLESS_INVALID_INDEX        = ~uint32_t(0);
+
+constexpr float SE_SAMPLER_LOD_CLAMP_NONE           = 1000.0f;
 
 enum struct SeRenderTargetLoadOp : uint32_t
 {
@@ -28,6 +39,14 @@ enum struct SeTextureFormat : uint32_t
     R_8_SRGB,
     RGBA_8_UNORM,
     RGBA_8_SRGB,
+    BC1_RGBA_UNORM,
+    BC1_RGBA_SRGB,
+    BC3_UNORM,
+    BC3_SRGB,
+    BC4_UNORM,
+    BC5_UNORM,
+    BC7_UNORM,
+    BC7_SRGB,
 };
 
 enum struct SePipelinePolygonMode : uint32_t
@@ -51,6 +70,13 @@ enum struct SePipelineFrontFace : uint32_t
     COUNTER_CLOCKWISE,
 };
 
+enum struct SeTextureLifetime : uint32_t
+{
+    PERSISTENT,             // Contents are kept between passes and frames
+    TRANSIENT,              // Contents are valid only between the first and the last use in a frame, memory is shared with other transient resources
+    TRANSIENT_ATTACHMENT,   // Transient texture that can only be a render target or an input attachment (can take no memory on tiled gpus)
+};
+
 enum struct SeSamplingType : uint32_t
 {
     _1  = 0x00000001,
@@ -62,6 +88,12 @@ enum struct SeSamplingType : uint32_t
     _64 = 0x00000040,
 };
 
+enum struct SeIndexType : uint32_t
+{
+    UINT_16,
+    UINT_32,
+};
+
 enum struct SeStencilOp : uint32_t
 {
     KEEP,
@@ -106,11 +138,22 @@ enum struct SeSamplerMipmapMode : uint32_t
     LINEAR,
 };
 
+//
+// What happens with a pass if its pipeline is not compiled yet (pipelines are compiled on background threads)
+//
+enum struct SePipelineCompilationPolicy : uint32_t
+{
+    WAIT,       // Frame waits for the compilation to finish
+    SKIP_PASS,  // Pass only loads and stores render targets, draw/dispatch commands are skipped
+    FALLBACK,   // Pass uses fallback fragment program (skipped if it isn't provided). Fallback is compiled synchronously if needed
+};
+
 enum struct SeRenderRefType : uint32_t
 {
     PROGRAM,
     BUFFER,
     SAMPLER,
+    PASS,
 };
 
 template<SeRenderRefType type> 
@@ -123,6 +166,7 @@ struct SeRenderRef
 
 using SeProgramRef = SeRenderRef<SeRenderRefType::PROGRAM>;
 using SeSamplerRef = SeRenderRef<SeRenderRefType::SAMPLER>;
+using SePassRef = SeRenderRef<SeRenderRefType::PASS>;
 
 struct SeBufferRef
 {
@@ -206,12 +250,74 @@ struct SeGraphicsPassInfo
     SeSamplingType          samplingType;
     SePassRenderTarget      renderTargets[SE_MAX_PASS_RENDER_TARGETS];
     SePassRenderTarget      depthStencilTarget;
+    SeTextureRef            inputAttachments[SE_MAX_PASS_INPUT_ATTACHMENTS];    // Render targets of the previous passes, read with subpassLoad (see se_render_set_subpass_merging)
+    SePipelineCompilationPolicy compilationPolicy;
+    SeProgramWithConstants  fallbackFragmentProgram;    // Must use the same bindings as fragmentProgram
 };
 
 struct SeComputePassInfo
 {
     SePassDependencies      dependencies;
     SeProgramWithConstants  program;
+    SePipelineCompilationPolicy compilationPolicy;      // FALLBACK is the same as SKIP_PASS for compute passes
+    bool                    isAsyncCompute;             // Run on the async compute queue if possible (see se_render_set_async_compute)
+};
+
+struct SePipelineCompilationStats
+{
+    size_t  numPendingPipelines;
+    size_t  numSkippedPasses;
+    size_t  numFallbackPasses;
+    float   lastFrameStallMs;   // Time main thread was blocked by pipeline compilation during the last frame
+    float   maxFrameStallMs;
+};
+
+struct SeCommandRecordingStats
+{
+    size_t  numThreads;             // Threads used for command recording, including the main thread
+    size_t  numPrimaryBuffers;      // Primary command buffers recorded during the last frame (one per pass, merged passes share one)
+    size_t  numSecondaryBuffers;    // Secondary command buffers recorded during the last frame (large passes are split)
+    size_t  numQueueSubmits;        // vkQueueSubmit calls of the last frame (one per run of passes on the same queue)
+    size_t  numAsyncComputePasses;  // Compute passes that ran on the async compute queue during the last frame
+    size_t  numCrossQueueWaits;     // Semaphore waits between the graphics and async compute queues during the last frame
+    size_t  numMergedPasses;        // Graphics passes recorded as subpasses of the previous pass's render pass during the last frame
+    size_t  numDynamicPasses;       // Graphics passes recorded with dynamic rendering (without render pass and framebuffer objects) during the last frame
+    size_t  numCreatedObjects;      // Command pools and command buffers created during the last frame (zero in steady state)
+    size_t  numReusedBuffers;       // Command buffers recycled from the frame command pools during the last frame
+    size_t  numRecordedCommands;    // Render graph commands recorded during the last frame
+    size_t  numElidedCommands;      // Redundant bind, push constants and bind index buffer commands dropped during the last frame
+    size_t  commandStreamBytes;     // Memory used by the recorded commands of the last frame
+    float   lastFrameRecordingMs;   // Time spent on preparing, recording and submitting pass command buffers
+    float   lastFrameSetupMs;       // Time spent on getting render passes, framebuffers and pipelines of the passes (including waits for pipeline compilation)
+};
+
+struct SeDescriptorSetStats
+{
+    size_t  numBinds;               // Bind commands processed during the last frame
+    size_t  numCacheHits;           // Bind commands that reused a cached descriptor set
+    size_t  numAllocations;         // Descriptor sets allocated during the last frame (zero in steady state for static scenes)
+    size_t  numTemplateWrites;      // New sets written with a descriptor update template
+    size_t  numFallbackWrites;      // New sets written with vkUpdateDescriptorSets (bind command doesn't cover all bindings of the set)
+    size_t  numFreedSets;           // Cached sets freed during the last frame because they weren't used for a while
+    float   lastFrameMs;            // Time spent on getting descriptor sets for bind commands
+};
+
+struct SeTransientMemoryStats
+{
+    size_t  numResources;           // Transient textures and buffers used during the last frame
+    size_t  numLazilyAllocated;     // Transient attachments in lazily allocated memory (not aliased)
+    size_t  requiredBytes;          // Memory aliased resources would take without aliasing
+    size_t  aliasedBytes;           // Memory they take with aliasing
+    size_t  heapBytes;              // Memory allocated by the transient heap (can be bigger than aliasedBytes, heap blocks only grow)
+    size_t  numRebinds;             // Resources that were moved during the last frame (zero in steady state)
+};
+
+struct SeObjectCacheStats
+{
+    size_t  numCachedObjects;       // Render passes, framebuffers and pipelines that are currently cached
+    size_t  numExaminedObjects;     // Cached objects checked for expiration during the last frame
+    size_t  numEvictedObjects;      // Cached objects destroyed during the last frame because they weren't used for a while
+    float   lastFrameEvictionMs;    // Time spent on eviction of unused objects
 };
 
 struct SeRenderProgramComputeWorkGroupSize
@@ -227,6 +333,8 @@ struct SeTextureInfo
     uint32_t        width;
     uint32_t        height;
     SeDataProvider    data;
+    bool            generateMips;   // Full mip chain is generated from the provided data
+    SeTextureLifetime lifetime;     // Transient textures can't have data or mips
 };
 
 struct SeSamplerInfo
@@ -249,6 +357,7 @@ struct SeSamplerInfo
 struct SeMemoryBufferInfo
 {
     SeDataProvider data;
+    bool isTransient;   // Data must be se_data_provider_from_memory(nullptr, size)
 };
 
 struct SeMemoryBufferWriteInfo
@@ -291,12 +400,50 @@ struct SeCommandBindInfo
     SeBinding   bindings[SE_MAX_BINDINGS];
 };
 
+struct SeCommandPushConstantsInfo
+{
+    SeDataProvider data;
+};
+
 struct SeCommandDrawInfo
 {
     uint32_t numVertices;
     uint32_t numInstances;
 };
 
+struct SeCommandBindIndexBufferInfo
+{
+    SeBufferRef buffer;
+    size_t      offset;
+    SeIndexType type;
+};
+
+struct SeCommandDrawIndexedInfo
+{
+    uint32_t    numIndices;
+    uint32_t    numInstances;
+    uint32_t    firstIndex;
+    int32_t     vertexOffset;
+};
+
+// Arguments buffer is an array of SeDrawIndirectArgs (or SeDrawIndexedIndirectArgs for indexed draws)
+struct SeCommandDrawIndirectInfo
+{
+    SeBufferRef argsBuffer;
+    size_t      argsOffset;
+    uint32_t    numDraws;
+};
+
+// Number of draws is read from uint32_t at countOffset of countBuffer and clamped to maxDraws
+struct SeCommandDrawIndirectCountInfo
+{
+    SeBufferRef argsBuffer;
+    size_t      argsOffset;
+    SeBufferRef countBuffer;
+    size_t      countOffset;
+    uint32_t    maxDraws;
+};
+
 struct SeCommandDispatchInfo
 {
     uint32_t groupCountX;
@@ -304,6 +451,40 @@ struct SeCommandDispatchInfo
     uint32_t groupCountZ;
 };
 
+// Arguments buffer contains a single SeDispatchIndirectArgs
+struct SeCommandDispatchIndirectInfo
+{
+    SeBufferRef argsBuffer;
+    size_t      argsOffset;
+};
+
+//
+// Layouts of indirect arguments written to the buffers (by the cpu or by compute shaders)
+//
+struct SeDrawIndirectArgs
+{
+    uint32_t    numVertices;
+    uint32_t    numInstances;
+    uint32_t    firstVertex;
+    uint32_t    firstInstance;
+};
+
+struct SeDrawIndexedIndirectArgs
+{
+    uint32_t    numIndices;
+    uint32_t    numInstances;
+    uint32_t    firstIndex;
+    int32_t     vertexOffset;
+    uint32_t    firstInstance;
+};
+
+struct SeDispatchIndirectArgs
+{
+    uint32_t    groupCountX;
+    uint32_t    groupCountY;
+    uint32_t    groupCountZ;
+};
+
 struct SeComputeWorkgroupSize
 {
     uint32_t x;
@@ -325,6 +506,82 @@ SePassDependencies      se_render_begin_graphics_pass         (const SeGraphicsP
 SePassDependencies      se_render_begin_compute_pass          (const SeComputePassInfo& info);
 void                    se_render_end_pass                    ();
 
+// Pipelines for the expected passes are compiled in background. Textures used as render targets must already exist
+void                    se_render_prewarm_graphics_pipelines  (const SeGraphicsPassInfo* infos, size_t numInfos);
+void                    se_render_prewarm_compute_pipelines   (const SeComputePassInfo* infos, size_t numInfos);
+SePipelineCompilationStats se_render_pipeline_compilation_stats();
+
+// Render passes, framebuffers and pipelines are created on demand and destroyed when they aren't used for a while.
+// Eviction checks only the objects that expire, so its cost doesn't depend on the number of cached objects
+SeObjectCacheStats      se_render_object_cache_stats          ();
+
+// Passes are recorded on multiple threads. Number of threads is clamped to [1, number of logical cores]
+void                    se_render_set_num_recording_threads   (size_t numThreads);
+SeCommandRecordingStats se_render_command_recording_stats     ();
+
+// Descriptor sets are cached by their contents, so binding the same resources again doesn't allocate or write anything.
+// Caching can be disabled to measure its effect, every bind command allocates and writes a new set in this case
+void                    se_render_set_descriptor_set_caching  (bool isEnabled);
+SeDescriptorSetStats    se_render_descriptor_set_stats        ();
+
+// Consecutive graphics passes that render to the same attachments are merged into a single render pass (one subpass per pass),
+// so attachments aren't stored and loaded again between them. Passes are merged if they are consecutive, their attachments
+// have the same extent, attachments used by the previous merged passes are loaded (not cleared) and textures bound to the
+// passes aren't attachments of the merged passes. Render targets of the previous passes can be read as input attachments
+// (SeGraphicsPassInfo::inputAttachments, input_attachment_index is the index in that array). Input attachments must also
+// be bound with se_render_bind (sampler isn't needed), they are read from tile memory if passes are merged.
+// Render target stores are dropped if the next pass that uses the texture in the same frame doesn't load it.
+// Merging is enabled by default, it can be disabled to measure its effect
+void                    se_render_set_subpass_merging         (bool isEnabled);
+
+// Dynamic rendering (requires VK_KHR_dynamic_rendering support). Passes that aren't merged with other passes and don't read
+// input attachments are recorded without render pass and framebuffer objects, pipelines are created against attachment formats.
+// This removes render pass and framebuffer lookups (hashing of their infos every frame) for such passes. Merged passes
+// keep using render passes, because dynamic rendering has no subpasses. Dynamic rendering is enabled by default if it's
+// supported, it can be disabled to compare both paths (see SeCommandRecordingStats::lastFrameSetupMs)
+bool                    se_render_is_dynamic_rendering_supported();
+void                    se_render_set_dynamic_rendering       (bool isEnabled);
+
+// Async compute (requires a queue family with compute and without graphics support). Compute passes with
+// SeComputePassInfo::isAsyncCompute run on the async compute queue and can overlap graphics passes that don't depend on them.
+// Dependencies are found from the resources passes access (and SePassDependencies), every dependency between queues is a
+// semaphore wait. Passes stay on the graphics queue if they access transient resources or the swap chain texture, the first
+// pass of the frame is always on the graphics queue. Resources are shared between queues without ownership transfers.
+// @NOTE : bindless heap accesses are invisible to the render graph, so they don't create dependencies between queues.
+// Async compute is enabled by default if it's supported. If it isn't supported or is disabled, all passes run on the graphics queue
+bool                    se_render_is_async_compute_supported  ();
+void                    se_render_set_async_compute           (bool isEnabled);
+
+// Transient textures (SeTextureLifetime::TRANSIENT and TRANSIENT_ATTACHMENT) and transient buffers share memory with other
+// transient resources that aren't used by the same passes. Memory is placed every frame based on the passes that use
+// the resources, so a sequence of render targets that are used by a few consecutive passes takes roughly as much memory
+// as the biggest group of them that is alive at the same time. Contents are undefined at the first use in a frame
+// (first pass must clear or fully overwrite the resource) and are dropped after the last use. Transient resources can't
+// be written with se_render_write, used by compiled passes or accessed with bindless indices
+SeTransientMemoryStats  se_render_transient_memory_stats      ();
+
+// Bindless mode (requires descriptor indexing support). Storage buffers, sampled textures and samplers get stable indices
+// in a global descriptor heap when they are created. Programs access the heap by declaring set SE_BINDLESS_SET with
+// unsized arrays of storage buffers, textures and samplers at SE_BINDLESS_*_BINDING bindings and indexing them with
+// integers from instance data, so draws don't need bind commands for these resources.
+// @NOTE : heap accesses are invisible to the render graph. Uploaded textures are moved to shader read layout automatically,
+//         but resources written by the gpu (render targets, compute outputs) must also be bound with se_render_bind
+//         in the pass that reads them, so the graph can place barriers
+bool                    se_render_is_bindless_supported       ();
+uint32_t                se_render_bindless_index              (SeBufferRef buffer);
+uint32_t                se_render_bindless_index              (SeTextureRef texture);
+uint32_t                se_render_bindless_index              (SeSamplerRef sampler);
+
+// Compiled passes resolve render pass, framebuffers and pipelines once and reuse them every frame.
+// Update rebuilds only objects affected by the changed fields, so it must be called if render target or program
+// referenced by the pass is recreated. dependencies field of the pass info is ignored, dependencies are provided to
+// se_render_begin_pass instead
+SePassRef               se_render_graphics_pass               (const SeGraphicsPassInfo& info);
+SePassRef               se_render_compute_pass                (const SeComputePassInfo& info);
+void                    se_render_update_pass                 (SePassRef pass, const SeGraphicsPassInfo& info);
+void                    se_render_update_pass                 (SePassRef pass, const SeComputePassInfo& info);
+SePassDependencies      se_render_begin_pass                  (SePassRef pass, SePassDependencies dependencies);
+
 SeProgramRef            se_render_program                     (const SeProgramInfo& info);
 SeTextureRef            se_render_texture                     (const SeTextureInfo& info);
 SeTextureRef            se_render_swap_chain_texture          ();
@@ -332,9 +589,29 @@ SeBufferRef             se_render_memory_buffer               (const SeMemoryBuf
 SeBufferRef             se_render_scratch_memory_buffer       (const SeMemoryBufferInfo& info);
 SeSamplerRef            se_render_sampler                     (const SeSamplerInfo& info);
 
+// Buffer bindings use dynamic offsets (up to the device limits on dynamic buffers per pipeline), so binding the same buffer
+// with the same size at a different offset reuses the cached descriptor set. Scratch buffers of the frame share a single
+// vulkan buffer, so this also applies to different scratch buffers of the same size
 void                    se_render_bind                        (const SeCommandBindInfo& info);
+// Data is copied to the command, so it can be a temporary. Size must be a multiple of 4 and must not exceed SE_MAX_PUSH_CONSTANTS_SIZE
+// or the biggest push constants block of pass programs (stages with smaller blocks get only the bytes their block covers).
+// Programs declare push constants with a single layout(push_constant) block. Push constants persist until the next push in the pass
+void                    se_render_push_constants              (const SeCommandPushConstantsInfo& info);
 void                    se_render_draw                        (const SeCommandDrawInfo& info);
 void                    se_render_dispatch                    (const SeCommandDispatchInfo& info);
+
+// Index buffer stays bound until the next bind in the pass. Indices are read by the vertex input stage, so vertex
+// shaders get them as gl_VertexIndex (plus vertexOffset) and pull vertex data by it as usual
+void                    se_render_bind_index_buffer           (const SeCommandBindIndexBufferInfo& info);
+void                    se_render_draw_indexed                (const SeCommandDrawIndexedInfo& info);
+// Indirect commands read their arguments when the gpu executes them, so arguments can be written by the preceding passes
+// (bind argument buffers as storage buffers there, the graph places barriers). More than one draw per command and non-zero
+// firstInstance need multiDrawIndirect and drawIndirectFirstInstance features, which are enabled when available
+void                    se_render_draw_indirect               (const SeCommandDrawIndirectInfo& info);
+void                    se_render_draw_indexed_indirect       (const SeCommandDrawIndirectInfo& info);
+bool                    se_render_is_draw_indirect_count_supported();
+void                    se_render_draw_indexed_indirect_count (const SeCommandDrawIndirectCountInfo& info);
+void                    se_render_dispatch_indirect           (const SeCommandDispatchIndirectInfo& info);
 void                    se_render_write                       (const SeMemoryBufferWriteInfo& info);
 
 SeFloat4x4              se_render_perspective                 (float fovDeg, float aspect, float nearPlane, float farPlane);
@@ -346,6 +623,7 @@ void                    se_render_destroy                     (SeProgramRef ref)
 void                    se_render_destroy                     (SeSamplerRef ref);
 void                    se_render_destroy                     (SeBufferRef ref);
 void                    se_render_destroy                     (SeTextureRef ref);
+void                    se_render_destroy                     (SePassRef ref);
 
 void _se_render_init(const SeSettings& settings);
 void _se_render_terminate();
@@ -1,5 +1,8 @@
 
 #include "vulkan/se_vulkan_base.hpp"
+#include "vulkan/se_vulkan_barrier_planner.hpp"
+#include "vulkan/se_vulkan_bindless_heap.hpp"
+#include "vulkan/se_vulkan_descriptor_set.hpp"
 #include "vulkan/se_vulkan_device.hpp"
 #include "vulkan/se_vulkan_frame_manager.hpp"
 #include "vulkan/se_vulkan_framebuffer.hpp"
@@ -7,11 +10,21 @@
 #include "vulkan/se_vulkan_memory_buffer.hpp"
 #include "vulkan/se_vulkan_memory.hpp"
 #include "vulkan/se_vulkan_pipeline.hpp"
+#include "vulkan/se_vulkan_pipeline_cache.hpp"
+#include "vulkan/se_vulkan_pipeline_compiler.hpp"
 #include "vulkan/se_vulkan_program.hpp"
 #include "vulkan/se_vulkan_render_pass.hpp"
 #include "vulkan/se_vulkan_sampler.hpp"
 #include "vulkan/se_vulkan_texture.hpp"
+#include "vulkan/se_vulkan_transfer_manager.hpp"
 #include "vulkan/se_vulkan_command_buffer.hpp"
+#include "vulkan/se_vulkan_command_recorder.hpp"
+#include "vulkan/se_vulkan_compiled_pass.hpp"
+#include "vulkan/se_vulkan_aliasing_planner.hpp"
+#include "vulkan/se_vulkan_transient_heap.hpp"
+#include "vulkan/se_vulkan_object_cache.hpp"
+#include "vulkan/se_vulkan_queue_scheduler.hpp"
+#include "vulkan/se_vulkan_command_stream.hpp"
 #include "vulkan/se_vulkan_utils.hpp"
 #include "engine/se_engine.hpp"
 
@@ -27,16 +40,6 @@ typename SeVkRefToResource<Ref>::Res* se_vk_unref(Ref ref)
     return result;
 }
 
-template<typename Ref>
-typename SeVkRefToResource<Ref>::Res* se_vk_unref_graveyard(Ref ref)
-{
-    auto& pool = se_vk_memory_manager_get_pool<typename SeVkRefToResource<Ref>::Res>(&g_vulkanDevice->memoryManager);
-    auto* const result = se_object_pool_access(pool, ref.index, ref.generation);
-    se_assert_msg(result, "Ref is either invalid or expired");
-    se_assert_msg(result->object.flags & SeVkObject::Flags::IN_GRAVEYARD, "Trying to unref not deleted object");
-    return result;
-}
-
 template<typename Ref>
 SeObjectPoolEntryRef<typename SeVkRefToResource<Ref>::Res> se_vk_to_pool_ref(Ref ref)
 {
@@ -50,43 +53,14 @@ SeObjectPoolEntryRef<typename SeVkRefToResource<Ref>::Res> se_vk_to_pool_ref(Ref
 
 void _se_render_write(SeVkMemoryBuffer* buffer, void* sourcePtr, size_t sourceSize, size_t offset)
 {
+    se_assert_msg(!(buffer->flags & SE_VK_MEMORY_BUFFER_ALIASED), "Transient buffers can't be written from the cpu");
     if (buffer->memory.mappedMemory)
     {
-        memcpy(buffer->memory.mappedMemory, sourcePtr, sourceSize);
+        memcpy(((char*)buffer->memory.mappedMemory) + offset, sourcePtr, sourceSize);
     }
     else
     {
-        SeObjectPool<SeVkCommandBuffer>& cmdPool = se_vk_memory_manager_get_pool<SeVkCommandBuffer>(&g_vulkanDevice->memoryManager);
-        SeVkCommandBuffer* const cmd = se_object_pool_take(cmdPool);
-        SeVkCommandBufferInfo cmdInfo =
-        {
-            .device = g_vulkanDevice,
-            .usage  = SE_VK_COMMAND_BUFFER_USAGE_TRANSFER,
-        };
-        SeVkMemoryBuffer* const stagingBuffer = se_vk_memory_manager_get_staging_buffer(&g_vulkanDevice->memoryManager);
-        const size_t stagingBufferSize = stagingBuffer->memory.size;
-        void* const stagingMemory = stagingBuffer->memory.mappedMemory;
-        se_assert(stagingMemory);
-        const size_t numCopies = (sourceSize / stagingBufferSize) + (sourceSize % stagingBufferSize ? 1 : 0);
-        for (size_t it = 0; it < numCopies; it++)
-        {
-            const size_t dataLeft = sourceSize - (it * stagingBufferSize);
-            const size_t copySize = se_min(dataLeft, stagingBufferSize);
-            memcpy(stagingMemory, ((char*)sourcePtr) + it * stagingBufferSize, copySize);
-            se_vk_command_buffer_construct(cmd, &cmdInfo);
-            const VkBufferCopy copy
-            {
-                .srcOffset  = 0,
-                .dstOffset  = offset + it * stagingBufferSize,
-                .size       = copySize,
-            };
-            vkCmdCopyBuffer(cmd->handle, stagingBuffer->handle, buffer->handle, 1, &copy);
-            SeVkCommandBufferSubmitInfo submit = { };
-            se_vk_command_buffer_submit(cmd, &submit);
-            vkWaitForFences(se_vk_device_get_logical_handle(g_vulkanDevice), 1, &cmd->fence, VK_TRUE, UINT64_MAX);    
-            se_vk_command_buffer_destroy(cmd);
-        }
-        se_object_pool_release(cmdPool, cmd);
+        se_vk_transfer_manager_upload_buffer(&g_vulkanDevice->transferManager, buffer, sourcePtr, sourceSize, offset);
     }
 }
 
@@ -122,6 +96,210 @@ inline void se_render_end_pass()
     se_vk_graph_end_pass(&g_vulkanDevice->graph);
 }
 
+void se_render_prewarm_graphics_pipelines(const SeGraphicsPassInfo* infos, size_t numInfos)
+{
+    for (size_t it = 0; it < numInfos; it++) se_vk_graph_prewarm_graphics_pipeline(&g_vulkanDevice->graph, infos[it]);
+}
+
+void se_render_prewarm_compute_pipelines(const SeComputePassInfo* infos, size_t numInfos)
+{
+    for (size_t it = 0; it < numInfos; it++) se_vk_graph_prewarm_compute_pipeline(&g_vulkanDevice->graph, infos[it]);
+}
+
+SePipelineCompilationStats se_render_pipeline_compilation_stats()
+{
+    SeVkPipelineCompiler* const compiler = &g_vulkanDevice->pipelineCompiler;
+    const double counterFrequency = double(_se_get_perf_frequency());
+    return
+    {
+        .numPendingPipelines    = size_t(se_platform_atomic_64_bit_load(&compiler->numPendingJobs, SE_RELAXED)),
+        .numSkippedPasses       = compiler->numSkippedPasses,
+        .numFallbackPasses      = compiler->numFallbackPasses,
+        .lastFrameStallMs       = float(double(compiler->lastFrameStallTicks) / counterFrequency * 1000.0),
+        .maxFrameStallMs        = float(double(compiler->maxFrameStallTicks) / counterFrequency * 1000.0),
+    };
+}
+
+void se_render_set_num_recording_threads(size_t numThreads)
+{
+    se_vk_command_recorder_set_num_lanes(&g_vulkanDevice->commandRecorder, numThreads);
+}
+
+SeObjectCacheStats se_render_object_cache_stats()
+{
+    const SeVkGraph* const graph = &g_vulkanDevice->graph;
+    return
+    {
+        .numCachedObjects       = se_vk_object_cache_size(graph->renderPassInfoToRenderPass) +
+                                  se_vk_object_cache_size(graph->framebufferInfoToFramebuffer) +
+                                  se_vk_object_cache_size(graph->graphicsPipelineInfoToGraphicsPipeline) +
+                                  se_vk_object_cache_size(graph->computePipelineInfoToComputePipeline),
+        .numExaminedObjects     = graph->lastFrameObjectCacheStats.numExamined,
+        .numEvictedObjects      = graph->lastFrameObjectCacheStats.numEvicted,
+        .lastFrameEvictionMs    = float(double(graph->lastFrameObjectCacheTicks) / double(_se_get_perf_frequency()) * 1000.0),
+    };
+}
+
+SeCommandRecordingStats se_render_command_recording_stats()
+{
+    const SeVkCommandRecorder* const recorder = &g_vulkanDevice->commandRecorder;
+    return
+    {
+        .numThreads             = se_vk_command_recorder_get_num_lanes(recorder),
+        .numPrimaryBuffers      = recorder->lastFrameNumPrimaryBuffers,
+        .numSecondaryBuffers    = recorder->lastFrameNumSecondaryBuffers,
+        .numQueueSubmits        = recorder->lastFrameNumQueueSubmits,
+        .numAsyncComputePasses  = recorder->lastFrameNumAsyncComputePasses,
+        .numCrossQueueWaits     = recorder->lastFrameNumCrossQueueWaits,
+        .numMergedPasses        = recorder->lastFrameNumMergedPasses,
+        .numDynamicPasses       = recorder->lastFrameNumDynamicRenderings,
+        .numCreatedObjects      = recorder->lastFrameNumCreatedCommandObjects,
+        .numReusedBuffers       = recorder->lastFrameNumReusedCommandBuffers,
+        .numRecordedCommands    = recorder->lastFrameNumRecordedCommands,
+        .numElidedCommands      = recorder->lastFrameNumElidedCommands,
+        .commandStreamBytes     = recorder->lastFrameCommandStreamSize,
+        .lastFrameRecordingMs   = float(double(recorder->lastFrameRecordingTicks) / double(_se_get_perf_frequency()) * 1000.0),
+        .lastFrameSetupMs       = float(double(recorder->lastFrameSetupTicks) / double(_se_get_perf_frequency()) * 1000.0),
+    };
+}
+
+void se_render_set_descriptor_set_caching(bool isEnabled)
+{
+    g_vulkanDevice->graph.isDescriptorSetCachingEnabled = isEnabled;
+}
+
+void se_render_set_subpass_merging(bool isEnabled)
+{
+    g_vulkanDevice->graph.isSubpassMergingEnabled = isEnabled;
+}
+
+bool se_render_is_dynamic_rendering_supported()
+{
+    return se_vk_device_is_dynamic_rendering_supported(g_vulkanDevice);
+}
+
+void se_render_set_dynamic_rendering(bool isEnabled)
+{
+    se_assert_msg(!isEnabled || se_render_is_dynamic_rendering_supported(), "Dynamic rendering isn't supported");
+    g_vulkanDevice->graph.isDynamicRenderingEnabled = isEnabled && se_render_is_dynamic_rendering_supported();
+}
+
+bool se_render_is_async_compute_supported()
+{
+    return se_vk_device_is_async_compute_supported(g_vulkanDevice);
+}
+
+void se_render_set_async_compute(bool isEnabled)
+{
+    se_assert_msg(!isEnabled || se_render_is_async_compute_supported(), "Async compute isn't supported");
+    g_vulkanDevice->graph.isAsyncComputeEnabled = isEnabled && se_render_is_async_compute_supported();
+}
+
+SeDescriptorSetStats se_render_descriptor_set_stats()
+{
+    const SeVkGraph* const graph = &g_vulkanDevice->graph;
+    const SeVkDescriptorSetCacheStats& stats = graph->lastFrameDescriptorSetStats;
+    return
+    {
+        .numBinds               = stats.numRequests,
+        .numCacheHits           = stats.numHits,
+        .numAllocations         = stats.numAllocations,
+        .numTemplateWrites      = stats.numTemplateWrites,
+        .numFallbackWrites      = stats.numFallbackWrites,
+        .numFreedSets           = stats.numFreedSets,
+        .lastFrameMs            = float(double(graph->lastFrameDescriptorSetTicks) / double(_se_get_perf_frequency()) * 1000.0),
+    };
+}
+
+SeTransientMemoryStats se_render_transient_memory_stats()
+{
+    const SeVkTransientHeapStats& stats = g_vulkanDevice->graph.transientHeap.lastFrameStats;
+    return
+    {
+        .numResources           = stats.numResources,
+        .numLazilyAllocated     = stats.numLazilyAllocated,
+        .requiredBytes          = stats.requiredBytes,
+        .aliasedBytes           = stats.plannedBytes,
+        .heapBytes              = stats.heapBytes,
+        .numRebinds             = stats.numRebinds,
+    };
+}
+
+bool se_render_is_bindless_supported()
+{
+    return se_vk_bindless_heap_is_valid(&g_vulkanDevice->bindlessHeap);
+}
+
+uint32_t se_render_bindless_index(SeBufferRef buffer)
+{
+    se_assert_msg(!buffer.isScratch, "Scratch buffers are not in the bindless heap");
+    const uint32_t index = se_vk_unref(buffer)->bindlessIndex;
+    se_assert_msg(index != SE_BINDLESS_INVALID_INDEX, "Buffer is not in the bindless heap (bindless mode is not supported, heap is full or buffer is transient)");
+    return index;
+}
+
+uint32_t se_render_bindless_index(SeTextureRef texture)
+{
+    se_assert_msg(!texture.isSwapChain, "Swap chain textures are not in the bindless heap");
+    const uint32_t index = se_vk_unref(texture)->bindlessIndex;
+    se_assert_msg(index != SE_BINDLESS_INVALID_INDEX, "Texture is not in the bindless heap (bindless mode is not supported, heap is full or texture is transient)");
+    return index;
+}
+
+uint32_t se_render_bindless_index(SeSamplerRef sampler)
+{
+    const uint32_t index = se_vk_unref(sampler)->bindlessIndex;
+    se_assert_msg(index != SE_BINDLESS_INVALID_INDEX, "Sampler is not in the bindless heap (bindless mode is not supported or heap is full)");
+    return index;
+}
+
+SePassRef se_render_graphics_pass(const SeGraphicsPassInfo& info)
+{
+    SeObjectPool<SeVkCompiledPass>& pool = se_vk_memory_manager_get_pool<SeVkCompiledPass>(&g_vulkanDevice->memoryManager);
+    const SeVkCompiledPassInfo vkInfo
+    {
+        .device     = g_vulkanDevice,
+        .graphics   = &info,
+        .compute    = nullptr,
+    };
+    SeVkCompiledPass* const result = se_object_pool_take(pool);
+    se_vk_compiled_pass_construct(result, &vkInfo);
+
+    const auto ref = se_object_pool_to_ref(pool, result);
+    return { ref.index, ref.generation };
+}
+
+SePassRef se_render_compute_pass(const SeComputePassInfo& info)
+{
+    SeObjectPool<SeVkCompiledPass>& pool = se_vk_memory_manager_get_pool<SeVkCompiledPass>(&g_vulkanDevice->memoryManager);
+    const SeVkCompiledPassInfo vkInfo
+    {
+        .device     = g_vulkanDevice,
+        .graphics   = nullptr,
+        .compute    = &info,
+    };
+    SeVkCompiledPass* const result = se_object_pool_take(pool);
+    se_vk_compiled_pass_construct(result, &vkInfo);
+
+    const auto ref = se_object_pool_to_ref(pool, result);
+    return { ref.index, ref.generation };
+}
+
+inline void se_render_update_pass(SePassRef pass, const SeGraphicsPassInfo& info)
+{
+    se_vk_compiled_pass_update_graphics(se_vk_unref(pass), info);
+}
+
+inline void se_render_update_pass(SePassRef pass, const SeComputePassInfo& info)
+{
+    se_vk_compiled_pass_update_compute(se_vk_unref(pass), info);
+}
+
+inline SePassDependencies se_render_begin_pass(SePassRef pass, SePassDependencies dependencies)
+{
+    return se_vk_graph_begin_compiled_pass(&g_vulkanDevice->graph, se_vk_unref(pass), dependencies);
+}
+
 SeProgramRef se_render_program(const SeProgramInfo& info)
 {
     se_assert(se_data_provider_is_valid(info.data));
@@ -146,18 +324,29 @@ SeTextureRef se_render_texture(const SeTextureInfo& info)
     SeObjectPool<SeVkTexture>& pool = se_vk_memory_manager_get_pool<SeVkTexture>(&g_vulkanDevice->memoryManager);
     SeVkTexture* const result = se_object_pool_take(pool);
 
+    se_assert_msg(!info.generateMips || se_data_provider_is_valid(info.data), "Mips can be generated only for textures with data");
+    se_assert_msg(!info.generateMips || info.format != SeTextureFormat::DEPTH_STENCIL, "Mips can't be generated for depth stencil textures");
+    se_assert_msg(!info.generateMips || !se_texture_compression_is_compressed(info.format), "Mips can't be generated for block compressed textures");
+    const bool isTransient = info.lifetime != SeTextureLifetime::PERSISTENT;
+    se_assert_msg(!isTransient || !se_data_provider_is_valid(info.data), "Transient textures can't have data");
+    se_assert_msg(!isTransient || !se_texture_compression_is_compressed(info.format), "Transient textures can't be block compressed");
     VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT;
     if (se_data_provider_is_valid(info.data)) usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
     if (info.format == SeTextureFormat::DEPTH_STENCIL) usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-    else usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    // @NOTE : textures with mips are rendered to through a view of the first mip (see SeVkTexture::attachmentView)
+    else if (!se_texture_compression_is_compressed(info.format)) usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+    // @NOTE : transient attachments can't have any usage except attachment ones
+    if (info.lifetime == SeTextureLifetime::TRANSIENT_ATTACHMENT) usage = (usage & ~VK_IMAGE_USAGE_SAMPLED_BIT) | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
     SeVkTextureInfo vkInfo
     {
-        .device     = g_vulkanDevice,
-        .format     = info.format == SeTextureFormat::DEPTH_STENCIL ? se_vk_device_get_depth_stencil_format(g_vulkanDevice) : se_vk_utils_to_vk_texture_format(info.format),
-        .extent     = { info.width, info.height, 1 },
-        .usage      = usage,
-        .sampling   = VK_SAMPLE_COUNT_1_BIT, // @TODO : support multisampling
-        .data       = info.data,
+        .device         = g_vulkanDevice,
+        .format         = info.format == SeTextureFormat::DEPTH_STENCIL ? se_vk_device_get_depth_stencil_format(g_vulkanDevice) : se_vk_utils_to_vk_texture_format(info.format),
+        .extent         = { info.width, info.height, 1 },
+        .usage          = usage,
+        .sampling       = VK_SAMPLE_COUNT_1_BIT, // @TODO : support multisampling
+        .generateMips   = info.generateMips,
+        .isTransient    = isTransient,
+        .data           = info.data,
     };
     se_vk_texture_construct(result, &vkInfo);
 
@@ -174,18 +363,22 @@ SeBufferRef se_render_memory_buffer(const SeMemoryBufferInfo& info)
 {
     se_assert(se_data_provider_is_valid(info.data));
     const auto [sourcePtr, sourceSize] = se_data_provider_get(info.data);
+    se_assert_msg(!info.isTransient || !sourcePtr, "Transient buffers can't have initial data");
 
     SeObjectPool<SeVkMemoryBuffer>& memoryBufferPool = se_vk_memory_manager_get_pool<SeVkMemoryBuffer>(&g_vulkanDevice->memoryManager);
     SeVkMemoryBuffer* const result = se_object_pool_take(memoryBufferPool);
     SeVkMemoryBufferInfo vkInfo
     {
-        .device     = g_vulkanDevice,
-        .size       = sourceSize,
-        .usage      =   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
-                        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | 
-                        VK_BUFFER_USAGE_TRANSFER_DST_BIT   | 
-                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT   ,
-        .visibility = VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+        .device         = g_vulkanDevice,
+        .size           = sourceSize,
+        .usage          =   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT  |
+                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT  | 
+                            VK_BUFFER_USAGE_INDEX_BUFFER_BIT    |
+                            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                            VK_BUFFER_USAGE_TRANSFER_DST_BIT    | 
+                            VK_BUFFER_USAGE_TRANSFER_SRC_BIT    ,
+        .visibility     = VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+        .isTransient    = info.isTransient,
     };
     se_vk_memory_buffer_construct(result, &vkInfo);
     
@@ -242,6 +435,11 @@ inline void se_render_bind(const SeCommandBindInfo& info)
     se_vk_graph_command_bind(&g_vulkanDevice->graph, info);
 }
 
+inline void se_render_push_constants(const SeCommandPushConstantsInfo& info)
+{
+    se_vk_graph_command_push_constants(&g_vulkanDevice->graph, info);
+}
+
 inline void se_render_draw(const SeCommandDrawInfo& info)
 {
     se_vk_graph_command_draw(&g_vulkanDevice->graph, info);
@@ -252,6 +450,41 @@ inline void se_render_dispatch(const SeCommandDispatchInfo& info)
     se_vk_graph_command_dispatch(&g_vulkanDevice->graph, info);
 }
 
+inline void se_render_bind_index_buffer(const SeCommandBindIndexBufferInfo& info)
+{
+    se_vk_graph_command_bind_index_buffer(&g_vulkanDevice->graph, info);
+}
+
+inline void se_render_draw_indexed(const SeCommandDrawIndexedInfo& info)
+{
+    se_vk_graph_command_draw_indexed(&g_vulkanDevice->graph, info);
+}
+
+inline void se_render_draw_indirect(const SeCommandDrawIndirectInfo& info)
+{
+    se_vk_graph_command_draw_indirect(&g_vulkanDevice->graph, info, false);
+}
+
+inline void se_render_draw_indexed_indirect(const SeCommandDrawIndirectInfo& info)
+{
+    se_vk_graph_command_draw_indirect(&g_vulkanDevice->graph, info, true);
+}
+
+inline bool se_render_is_draw_indirect_count_supported()
+{
+    return se_vk_device_is_draw_indirect_count_supported(g_vulkanDevice);
+}
+
+inline void se_render_draw_indexed_indirect_count(const SeCommandDrawIndirectCountInfo& info)
+{
+    se_vk_graph_command_draw_indexed_indirect_count(&g_vulkanDevice->graph, info);
+}
+
+inline void se_render_dispatch_indirect(const SeCommandDispatchIndirectInfo& info)
+{
+    se_vk_graph_command_dispatch_indirect(&g_vulkanDevice->graph, info);
+}
+
 inline void se_render_write(const SeMemoryBufferWriteInfo& info)
 {
     se_assert(se_data_provider_is_valid(info.data));
@@ -346,6 +579,11 @@ inline void se_render_destroy(SeTextureRef ref)
     se_vk_device_submit_to_graveyard(g_vulkanDevice, ref);
 }
 
+inline void se_render_destroy(SePassRef ref)
+{
+    se_vk_device_submit_to_graveyard(g_vulkanDevice, ref);
+}
+
 inline void _se_render_init(const SeSettings& settings)
 {
     se_vk_check(volkInitialize());
@@ -368,6 +606,9 @@ inline void _se_render_update()
 #define SSR_IMPL
 #include "engine/libs/ssr/simple_spirv_reflection.h"
 
+#include "vulkan/se_vulkan_barrier_planner.cpp"
+#include "vulkan/se_vulkan_bindless_heap.cpp"
+#include "vulkan/se_vulkan_descriptor_set.cpp"
 #include "vulkan/se_vulkan_device.cpp"
 #include "vulkan/se_vulkan_frame_manager.cpp"
 #include "vulkan/se_vulkan_framebuffer.cpp"
@@ -375,9 +616,18 @@ inline void _se_render_update()
 #include "vulkan/se_vulkan_memory_buffer.cpp"
 #include "vulkan/se_vulkan_memory.cpp"
 #include "vulkan/se_vulkan_pipeline.cpp"
+#include "vulkan/se_vulkan_pipeline_cache.cpp"
+#include "vulkan/se_vulkan_pipeline_compiler.cpp"
 #include "vulkan/se_vulkan_program.cpp"
 #include "vulkan/se_vulkan_render_pass.cpp"
 #include "vulkan/se_vulkan_sampler.cpp"
 #include "vulkan/se_vulkan_texture.cpp"
+#include "vulkan/se_vulkan_transfer_manager.cpp"
 #include "vulkan/se_vulkan_command_buffer.cpp"
+#include "vulkan/se_vulkan_command_recorder.cpp"
+#include "vulkan/se_vulkan_compiled_pass.cpp"
+#include "vulkan/se_vulkan_aliasing_planner.cpp"
+#include "vulkan/se_vulkan_transient_heap.cpp"
+#include "vulkan/se_vulkan_queue_scheduler.cpp"
+#include "vulkan/se_vulkan_command_stream.cpp"
 #include "vulkan/se_vulkan_utils.cpp"
@@ -0,0 +1,151 @@
+
+#include "se_vulkan_aliasing_planner.hpp"
+
+void se_vk_aliasing_planner_construct(SeVkAliasingPlanner* planner, SeAllocatorBindings allocator)
+{
+    *planner =
+    {
+        .resources  = se_dynamic_array_create<SeVkAliasingResource>(allocator),
+        .placements = se_dynamic_array_create<SeVkAliasingPlacement>(allocator),
+        .blocks     = se_dynamic_array_create<SeVkAliasingBlock>(allocator),
+        .order      = se_dynamic_array_create<size_t>(allocator),
+        .conflicts  = se_dynamic_array_create<size_t>(allocator),
+    };
+}
+
+void se_vk_aliasing_planner_destroy(SeVkAliasingPlanner* planner)
+{
+    se_dynamic_array_destroy(planner->resources);
+    se_dynamic_array_destroy(planner->placements);
+    se_dynamic_array_destroy(planner->blocks);
+    se_dynamic_array_destroy(planner->order);
+    se_dynamic_array_destroy(planner->conflicts);
+}
+
+void se_vk_aliasing_planner_reset(SeVkAliasingPlanner* planner)
+{
+    se_dynamic_array_reset(planner->resources);
+    se_dynamic_array_reset(planner->placements);
+    se_dynamic_array_reset(planner->blocks);
+}
+
+size_t se_vk_aliasing_planner_add_resource(SeVkAliasingPlanner* planner, const SeVkAliasingResource& resource)
+{
+    se_assert(resource.size && resource.alignment);
+    se_assert_msg((resource.alignment & (resource.alignment - 1)) == 0, "Alignment must be a power of two");
+    se_assert(resource.firstUse <= resource.lastUse);
+    se_dynamic_array_push(planner->resources, resource);
+    return se_dynamic_array_size(planner->resources) - 1;
+}
+
+void se_vk_aliasing_planner_add_use(SeVkAliasingPlanner* planner, size_t resource, size_t use)
+{
+    SeVkAliasingResource& value = planner->resources[resource];
+    value.firstUse = se_min(value.firstUse, use);
+    value.lastUse = se_max(value.lastUse, use);
+}
+
+inline size_t se_vk_aliasing_planner_align(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+inline bool se_vk_aliasing_planner_is_overlapping_in_time(const SeVkAliasingResource& first, const SeVkAliasingResource& second)
+{
+    return first.firstUse <= second.lastUse && second.firstUse <= first.lastUse;
+}
+
+void se_vk_aliasing_planner_plan(SeVkAliasingPlanner* planner)
+{
+    const size_t numResources = se_dynamic_array_size(planner->resources);
+    se_dynamic_array_reset(planner->blocks);
+    se_dynamic_array_reset(planner->placements);
+    se_dynamic_array_reset(planner->order);
+    for (size_t it = 0; it < numResources; it++)
+    {
+        se_dynamic_array_push(planner->placements, { 0, 0 });
+    }
+    //
+    // Largest resources go first. Insertion sort keeps the order stable, so the same frame always gets the same plan
+    // (otherwise resources would be recreated every frame). Number of transient resources is small, so this is fine
+    //
+    for (size_t it = 0; it < numResources; it++)
+    {
+        const size_t size = planner->resources[it].size;
+        se_dynamic_array_push(planner->order, it);
+        for (size_t orderIt = it; orderIt > 0 && planner->resources[planner->order[orderIt - 1]].size < size; orderIt--)
+        {
+            const size_t tmp = planner->order[orderIt - 1];
+            planner->order[orderIt - 1] = planner->order[orderIt];
+            planner->order[orderIt] = tmp;
+        }
+    }
+    for (size_t orderIt = 0; orderIt < numResources; orderIt++)
+    {
+        const size_t resourceIndex = planner->order[orderIt];
+        const SeVkAliasingResource& resource = planner->resources[resourceIndex];
+        //
+        // Find block
+        //
+        size_t block = se_dynamic_array_size(planner->blocks);
+        for (size_t it = 0; it < se_dynamic_array_size(planner->blocks); it++)
+        {
+            const SeVkAliasingBlock& candidate = planner->blocks[it];
+            if (candidate.memoryTypeBits == resource.memoryTypeBits && candidate.isLinear == resource.isLinear)
+            {
+                block = it;
+                break;
+            }
+        }
+        if (block == se_dynamic_array_size(planner->blocks))
+        {
+            se_dynamic_array_push(planner->blocks, { 0, 1, resource.memoryTypeBits, resource.isLinear });
+        }
+        //
+        // Collect already placed resources of the block that are alive at the same time, sorted by offset
+        //
+        se_dynamic_array_reset(planner->conflicts);
+        for (size_t placedIt = 0; placedIt < orderIt; placedIt++)
+        {
+            const size_t placed = planner->order[placedIt];
+            if (planner->placements[placed].block != block) continue;
+            if (!se_vk_aliasing_planner_is_overlapping_in_time(resource, planner->resources[placed])) continue;
+            const size_t offset = planner->placements[placed].offset;
+            se_dynamic_array_push(planner->conflicts, placed);
+            for (size_t it = se_dynamic_array_size(planner->conflicts) - 1; it > 0 && planner->placements[planner->conflicts[it - 1]].offset > offset; it--)
+            {
+                const size_t tmp = planner->conflicts[it - 1];
+                planner->conflicts[it - 1] = planner->conflicts[it];
+                planner->conflicts[it] = tmp;
+            }
+        }
+        //
+        // First fit : lowest aligned offset in a gap between conflicting resources (or after all of them)
+        //
+        size_t offset = 0;
+        for (auto it : planner->conflicts)
+        {
+            const size_t conflict = se_iterator_value(it);
+            const size_t conflictOffset = planner->placements[conflict].offset;
+            if (offset + resource.size <= conflictOffset) break;
+            offset = se_max(offset, se_vk_aliasing_planner_align(conflictOffset + planner->resources[conflict].size, resource.alignment));
+        }
+        planner->placements[resourceIndex] = { block, offset };
+        planner->blocks[block].size = se_max(planner->blocks[block].size, offset + resource.size);
+        planner->blocks[block].alignment = se_max(planner->blocks[block].alignment, resource.alignment);
+    }
+}
+
+size_t se_vk_aliasing_planner_required_size(const SeVkAliasingPlanner* planner)
+{
+    size_t result = 0;
+    for (auto it : planner->resources) result += se_iterator_value(it).size;
+    return result;
+}
+
+size_t se_vk_aliasing_planner_planned_size(const SeVkAliasingPlanner* planner)
+{
+    size_t result = 0;
+    for (auto it : planner->blocks) result += se_iterator_value(it).size;
+    return result;
+}
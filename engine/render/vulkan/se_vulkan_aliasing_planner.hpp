@@ -0,0 +1,69 @@
+#ifndef _SE_VULKAN_ALIASING_PLANNER_H_
+#define _SE_VULKAN_ALIASING_PLANNER_H_
+
+#include "se_vulkan_base.hpp"
+
+//
+// Aliasing planner places transient resources of a frame in shared memory blocks.
+//
+// Every resource has memory requirements and a lifetime (first and last use, inclusive, in any monotonic units - render
+// graph uses pass group indices). Resources with overlapping lifetimes never overlap in memory, resources with disjoint
+// lifetimes can share it. Placement is a greedy interval coloring : resources are processed from the largest to the smallest
+// and each one takes the lowest aligned offset that doesn't intersect already placed resources with overlapping lifetimes
+// (first fit). For the usual render graph frames (chains of render targets that are used by a few consecutive passes)
+// this gives blocks close to the peak of simultaneously alive memory.
+//
+// There is a block for every combination of memory type bits and linearity. Linear (buffers) and optimal (images) resources
+// are never placed in the same block, so bufferImageGranularity doesn't have to be respected.
+//
+// Planner doesn't use any vulkan objects, so it can be used (and checked) without a device.
+//
+
+struct SeVkAliasingResource
+{
+    size_t      size;
+    size_t      alignment;
+    uint32_t    memoryTypeBits;
+    bool        isLinear;
+    size_t      firstUse;
+    size_t      lastUse;
+};
+
+struct SeVkAliasingPlacement
+{
+    size_t block;
+    size_t offset;
+};
+
+struct SeVkAliasingBlock
+{
+    size_t      size;
+    size_t      alignment;      // Largest alignment of the block resources
+    uint32_t    memoryTypeBits;
+    bool        isLinear;
+};
+
+struct SeVkAliasingPlanner
+{
+    SeDynamicArray<SeVkAliasingResource>    resources;
+    SeDynamicArray<SeVkAliasingPlacement>   placements;     // One per resource, valid after se_vk_aliasing_planner_plan
+    SeDynamicArray<SeVkAliasingBlock>       blocks;
+    SeDynamicArray<size_t>                  order;          // Resources sorted by size (largest first)
+    SeDynamicArray<size_t>                  conflicts;      // Placed resources that overlap with the current one in time, sorted by offset
+};
+
+void    se_vk_aliasing_planner_construct(SeVkAliasingPlanner* planner, SeAllocatorBindings allocator);
+void    se_vk_aliasing_planner_destroy(SeVkAliasingPlanner* planner);
+
+void    se_vk_aliasing_planner_reset(SeVkAliasingPlanner* planner);
+// Returns index of the resource
+size_t  se_vk_aliasing_planner_add_resource(SeVkAliasingPlanner* planner, const SeVkAliasingResource& resource);
+// Extends lifetime of the resource to the use
+void    se_vk_aliasing_planner_add_use(SeVkAliasingPlanner* planner, size_t resource, size_t use);
+void    se_vk_aliasing_planner_plan(SeVkAliasingPlanner* planner);
+
+// Sum of sizes of all resources (memory they would take without aliasing) and sum of sizes of all planned blocks
+size_t  se_vk_aliasing_planner_required_size(const SeVkAliasingPlanner* planner);
+size_t  se_vk_aliasing_planner_planned_size(const SeVkAliasingPlanner* planner);
+
+#endif
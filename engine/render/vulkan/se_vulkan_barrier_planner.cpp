@@ -0,0 +1,227 @@
+
+#include "se_vulkan_barrier_planner.hpp"
+
+void se_vk_barrier_planner_construct(SeVkBarrierPlanner* planner, SeAllocatorBindings allocator)
+{
+    *planner =
+    {
+        .passAccesses       = se_dynamic_array_create<SeVkBarrierAccess>(allocator),
+        .passAccessIndices  = se_hash_table_create<SeVkBarrierResourceState*, size_t>(allocator),
+        .imageBarriers      = se_dynamic_array_create<VkImageMemoryBarrier>(allocator),
+        .bufferBarriers     = se_dynamic_array_create<VkBufferMemoryBarrier>(allocator),
+        .batches            = se_dynamic_array_create<SeVkBarrierBatch>(allocator),
+        .passQueue          = SE_VK_BARRIER_QUEUE_MAIN,
+        .isInPass           = false,
+    };
+}
+
+void se_vk_barrier_planner_destroy(SeVkBarrierPlanner* planner)
+{
+    se_dynamic_array_destroy(planner->passAccesses);
+    se_hash_table_destroy(planner->passAccessIndices);
+    se_dynamic_array_destroy(planner->imageBarriers);
+    se_dynamic_array_destroy(planner->bufferBarriers);
+    se_dynamic_array_destroy(planner->batches);
+}
+
+void se_vk_barrier_planner_begin_pass(SeVkBarrierPlanner* planner)
+{
+    se_assert(!planner->isInPass);
+    planner->isInPass = true;
+    planner->passQueue = SE_VK_BARRIER_QUEUE_MAIN;
+    se_dynamic_array_reset(planner->passAccesses);
+    se_hash_table_reset(planner->passAccessIndices);
+}
+
+void se_vk_barrier_planner_set_pass_queue(SeVkBarrierPlanner* planner, const SeVkBarrierQueue& queue)
+{
+    se_assert(planner->isInPass);
+    planner->passQueue = queue;
+}
+
+bool se_vk_barrier_planner_is_write(const SeVkBarrierAccess& access)
+{
+    const bool isTransition = access.currentLayout && (*access.currentLayout != access.layout);
+    return isTransition || (access.access & SE_VK_BARRIER_PLANNER_WRITE_ACCESS);
+}
+
+SeVkBarrierAccess* se_vk_barrier_planner_find_access(SeVkBarrierPlanner* planner, SeVkBarrierResourceState* state)
+{
+    const size_t* const index = se_hash_table_get(planner->passAccessIndices, state);
+    return index ? &planner->passAccesses[*index] : nullptr;
+}
+
+void se_vk_barrier_planner_push_access(SeVkBarrierPlanner* planner, const SeVkBarrierAccess& access)
+{
+    se_hash_table_set(planner->passAccessIndices, access.state, se_dynamic_array_size(planner->passAccesses));
+    se_dynamic_array_push(planner->passAccesses, access);
+}
+
+void se_vk_barrier_planner_add_image_access(SeVkBarrierPlanner* planner, SeVkBarrierResourceState* state, VkImage image, const VkImageSubresourceRange& range, VkImageLayout* currentLayout, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access)
+{
+    se_assert(planner->isInPass);
+    se_assert(state && image && currentLayout);
+    if (SeVkBarrierAccess* const existing = se_vk_barrier_planner_find_access(planner, state))
+    {
+        // @NOTE : image can be accessed with a single layout during the pass, so different layouts are merged to GENERAL
+        existing->stages |= stages;
+        existing->access |= access;
+        if (existing->layout != layout) existing->layout = VK_IMAGE_LAYOUT_GENERAL;
+        return;
+    }
+    se_vk_barrier_planner_push_access(planner,
+    {
+        .state          = state,
+        .stages         = stages,
+        .access         = access,
+        .image          = image,
+        .range          = range,
+        .currentLayout  = currentLayout,
+        .layout         = layout,
+        .buffer         = VK_NULL_HANDLE,
+    });
+}
+
+void se_vk_barrier_planner_add_buffer_access(SeVkBarrierPlanner* planner, SeVkBarrierResourceState* state, VkBuffer buffer, VkPipelineStageFlags stages, VkAccessFlags access)
+{
+    se_assert(planner->isInPass);
+    se_assert(state && buffer);
+    if (SeVkBarrierAccess* const existing = se_vk_barrier_planner_find_access(planner, state))
+    {
+        existing->stages |= stages;
+        existing->access |= access;
+        return;
+    }
+    se_vk_barrier_planner_push_access(planner,
+    {
+        .state          = state,
+        .stages         = stages,
+        .access         = access,
+        .image          = VK_NULL_HANDLE,
+        .range          = { },
+        .currentLayout  = nullptr,
+        .layout         = VK_IMAGE_LAYOUT_UNDEFINED,
+        .buffer         = buffer,
+    });
+}
+
+size_t se_vk_barrier_planner_end_pass(SeVkBarrierPlanner* planner)
+{
+    se_assert(planner->isInPass);
+    planner->isInPass = false;
+    const SeVkBarrierQueue& queue = planner->passQueue;
+    SeVkBarrierBatch batch
+    {
+        .srcStages          = 0,
+        .dstStages          = 0,
+        .firstImageBarrier  = se_dynamic_array_size(planner->imageBarriers),
+        .numImageBarriers   = 0,
+        .firstBufferBarrier = se_dynamic_array_size(planner->bufferBarriers),
+        .numBufferBarriers  = 0,
+    };
+    for (auto it : planner->passAccesses)
+    {
+        const SeVkBarrierAccess& access = se_iterator_value(it);
+        SeVkBarrierResourceState* const state = access.state;
+        const bool isWrite = access.access & SE_VK_BARRIER_PLANNER_WRITE_ACCESS;
+        const bool isTransition = access.currentLayout && (*access.currentLayout != access.layout);
+        VkPipelineStageFlags srcStages = 0;
+        VkAccessFlags srcAccess = 0;
+        bool isBarrierNeeded = false;
+        if (isWrite || isTransition)
+        {
+            //
+            // Write after write, write after read and layout transitions wait for all previous accesses. Accesses of the
+            // other queue are covered by the semaphore wait, so their stages are dropped
+            //
+            srcStages = (state->writeStages | state->readStages) & queue.supportedStages;
+            srcAccess = state->writeAccess & queue.supportedAccess;
+            isBarrierNeeded = isTransition || srcStages;
+            if (isWrite)
+            {
+                *state = { access.stages, VkAccessFlags(access.access & SE_VK_BARRIER_PLANNER_WRITE_ACCESS), 0, 0, 0, queue.index };
+            }
+            else
+            {
+                // @NOTE : layout transition is a write, which is visible only to the stages of this pass
+                *state = { access.stages, 0, access.stages, access.stages, access.access, queue.index };
+            }
+        }
+        else
+        {
+            //
+            // Read after write waits only if the last write isn't visible to the reading stages yet. Write of the other
+            // queue is made visible by the semaphore wait
+            //
+            const bool isVisible = ((access.stages & ~state->visibleStages) == 0) && ((access.access & ~state->visibleAccess) == 0);
+            if (state->writeStages && !isVisible && state->writeQueue == queue.index)
+            {
+                srcStages = state->writeStages;
+                srcAccess = state->writeAccess;
+                isBarrierNeeded = true;
+                state->visibleStages |= access.stages;
+                state->visibleAccess |= access.access;
+            }
+            state->readStages |= access.stages;
+        }
+        if (!isBarrierNeeded) continue;
+        batch.srcStages |= srcStages ? srcStages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        batch.dstStages |= access.stages;
+        if (access.image)
+        {
+            se_dynamic_array_push(planner->imageBarriers,
+            {
+                .sType                  = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .pNext                  = nullptr,
+                .srcAccessMask          = srcAccess,
+                .dstAccessMask          = access.access,
+                .oldLayout              = *access.currentLayout,
+                .newLayout              = access.layout,
+                .srcQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
+                .image                  = access.image,
+                .subresourceRange       = access.range,
+            });
+            *access.currentLayout = access.layout;
+            batch.numImageBarriers += 1;
+        }
+        else if (srcAccess)
+        {
+            // @NOTE : write after read is covered by the batch stage masks, buffer barrier is needed only to make writes visible
+            se_dynamic_array_push(planner->bufferBarriers,
+            {
+                .sType                  = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+                .pNext                  = nullptr,
+                .srcAccessMask          = srcAccess,
+                .dstAccessMask          = access.access,
+                .srcQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
+                .buffer                 = access.buffer,
+                .offset                 = 0,
+                .size                   = VK_WHOLE_SIZE,
+            });
+            batch.numBufferBarriers += 1;
+        }
+    }
+    se_dynamic_array_push(planner->batches, batch);
+    return se_dynamic_array_size(planner->batches) - 1;
+}
+
+void se_vk_barrier_planner_record(const SeVkBarrierPlanner* planner, size_t batchIndex, VkCommandBuffer commandBuffer)
+{
+    const SeVkBarrierBatch& batch = planner->batches[batchIndex];
+    if (!batch.dstStages) return;
+    vkCmdPipelineBarrier
+    (
+        commandBuffer,
+        batch.srcStages,
+        batch.dstStages,
+        0,
+        0,
+        nullptr,
+        uint32_t(batch.numBufferBarriers),
+        se_dynamic_array_raw(planner->bufferBarriers) + batch.firstBufferBarrier,
+        uint32_t(batch.numImageBarriers),
+        se_dynamic_array_raw(planner->imageBarriers) + batch.firstImageBarrier
+    );
+}
@@ -0,0 +1,97 @@
+#ifndef _SE_VULKAN_BARRIER_PLANNER_H_
+#define _SE_VULKAN_BARRIER_PLANNER_H_
+
+#include "se_vulkan_base.hpp"
+
+//
+// Barrier planner generates pipeline barriers for a sequence of passes.
+//
+// Every pass reports all of its resource accesses (images and buffers, with stages and access masks) between
+// se_vk_barrier_planner_begin_pass and se_vk_barrier_planner_end_pass. Accesses of the same resource within a pass
+// are merged, then compared with the resource state left by the previous passes :
+// - read after write waits only for the last write and only if the write isn't already visible to the reading stages
+// - write after read is an execution dependency only (no access masks)
+// - write after write and layout transitions wait for all previous accesses
+// All barriers of a pass are merged into a single batch, which is recorded with one vkCmdPipelineBarrier call.
+//
+// Passes can run on different queues (see se_vulkan_queue_scheduler.hpp). Caller synchronizes every hazard between passes of
+// different queues with semaphores, so the planner only keeps barriers valid on the queue of the pass : stages and accesses
+// that the queue doesn't support are dropped (they were executed on the other queue) and visibility of a write is tracked only
+// for the queue that made the write. Layout transitions are planned as usual, resources shared between queues must use
+// concurrent sharing mode.
+//
+// Planner doesn't use any vulkan objects except handles copied to barrier structures, so it can be used (and checked)
+// without a device. Resource state is stored by the caller and persists between frames.
+//
+
+#define SE_VK_BARRIER_PLANNER_WRITE_ACCESS (VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT)
+
+struct SeVkBarrierResourceState
+{
+    VkPipelineStageFlags    writeStages;    // Stages of the last write (or layout transition)
+    VkAccessFlags           writeAccess;
+    VkPipelineStageFlags    readStages;     // Stages that accessed resource after the last write
+    VkPipelineStageFlags    visibleStages;  // Stages and accesses the last write is already visible to
+    VkAccessFlags           visibleAccess;
+    uint32_t                writeQueue;     // Queue of the last write, visible stages are tracked only for this queue
+};
+
+struct SeVkBarrierAccess
+{
+    SeVkBarrierResourceState*   state;
+    VkPipelineStageFlags        stages;
+    VkAccessFlags               access;
+    VkImage                     image;          // Either image or buffer is set
+    VkImageSubresourceRange     range;
+    VkImageLayout*              currentLayout;  // Images only. Updated when pass ends
+    VkImageLayout               layout;
+    VkBuffer                    buffer;
+};
+
+struct SeVkBarrierQueue
+{
+    uint32_t                index;
+    VkPipelineStageFlags    supportedStages;
+    VkAccessFlags           supportedAccess;
+};
+
+constexpr SeVkBarrierQueue SE_VK_BARRIER_QUEUE_MAIN = { 0, ~VkPipelineStageFlags(0), ~VkAccessFlags(0) };
+
+struct SeVkBarrierBatch
+{
+    VkPipelineStageFlags    srcStages;
+    VkPipelineStageFlags    dstStages;
+    size_t                  firstImageBarrier;
+    size_t                  numImageBarriers;
+    size_t                  firstBufferBarrier;
+    size_t                  numBufferBarriers;
+};
+
+struct SeVkBarrierPlanner
+{
+    SeDynamicArray<SeVkBarrierAccess>               passAccesses;
+    SeHashTable<SeVkBarrierResourceState*, size_t>  passAccessIndices; // Resource state -> index in passAccesses
+    SeDynamicArray<VkImageMemoryBarrier>            imageBarriers;
+    SeDynamicArray<VkBufferMemoryBarrier>           bufferBarriers;
+    SeDynamicArray<SeVkBarrierBatch>                batches;
+    SeVkBarrierQueue                                passQueue;
+    bool                                            isInPass;
+};
+
+void    se_vk_barrier_planner_construct(SeVkBarrierPlanner* planner, SeAllocatorBindings allocator);
+void    se_vk_barrier_planner_destroy(SeVkBarrierPlanner* planner);
+
+void    se_vk_barrier_planner_begin_pass(SeVkBarrierPlanner* planner);
+// Queue of the pass is set separately, because it can depend on the pass accesses. Must be called before se_vk_barrier_planner_end_pass
+void    se_vk_barrier_planner_set_pass_queue(SeVkBarrierPlanner* planner, const SeVkBarrierQueue& queue);
+void    se_vk_barrier_planner_add_image_access(SeVkBarrierPlanner* planner, SeVkBarrierResourceState* state, VkImage image, const VkImageSubresourceRange& range, VkImageLayout* currentLayout, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access);
+void    se_vk_barrier_planner_add_buffer_access(SeVkBarrierPlanner* planner, SeVkBarrierResourceState* state, VkBuffer buffer, VkPipelineStageFlags stages, VkAccessFlags access);
+// Returns index of the barrier batch of this pass
+size_t  se_vk_barrier_planner_end_pass(SeVkBarrierPlanner* planner);
+// Write access or layout transition
+bool    se_vk_barrier_planner_is_write(const SeVkBarrierAccess& access);
+
+// Doesn't modify planner, so batches can be recorded from multiple threads
+void    se_vk_barrier_planner_record(const SeVkBarrierPlanner* planner, size_t batch, VkCommandBuffer commandBuffer);
+
+#endif
@@ -49,6 +49,7 @@ struct SeVkObject
         MEMORY_BUFFER,
         SAMPLER,
         COMMAND_BUFFER,
+        COMPILED_PASS,
     };
     struct Flags
     {
@@ -71,6 +72,7 @@ struct SeVkProgram;
 struct SeVkRenderPass;
 struct SeVkSampler;
 struct SeVkTexture;
+struct SeVkCompiledPass;
 
 #define se_vk_check(cmd) do { VkResult __result = cmd; se_assert_msg(__result == VK_SUCCESS, "Vulkan check failed. Error code is : {}", int(__result)); } while(0)
 
@@ -100,10 +102,10 @@ template<> struct SeVkRefToResource<SeProgramRef> { using Res = SeVkProgram; };
 template<> struct SeVkRefToResource<SeSamplerRef> { using Res = SeVkSampler; };
 template<> struct SeVkRefToResource<SeBufferRef> { using Res = SeVkMemoryBuffer; };
 template<> struct SeVkRefToResource<SeTextureRef> { using Res = SeVkTexture; };
+template<> struct SeVkRefToResource<SePassRef> { using Res = SeVkCompiledPass; };
 
 // Defined in se_vulkan.cpp
 template<typename Ref> typename SeVkRefToResource<Ref>::Res* se_vk_unref(Ref ref);
-template<typename Ref> typename SeVkRefToResource<Ref>::Res* se_vk_unref_graveyard(Ref ref);
 template<typename Ref> SeObjectPoolEntryRef<typename SeVkRefToResource<Ref>::Res> se_vk_to_pool_ref(Ref ref);
 
 struct SeVkConfig
@@ -111,13 +113,25 @@ struct SeVkConfig
     static constexpr const size_t NUM_FRAMES_IN_FLIGHT = 2;
     static constexpr const size_t COMMAND_BUFFERS_ARRAY_INITIAL_CAPACITY = 128;
     static constexpr const size_t SCRATCH_BUFFERS_ARRAY_INITIAL_CAPACITY = 128;
-    static constexpr const size_t COMMAND_BUFFER_EXECUTE_AFTER_MAX = 64;
-    static constexpr const size_t COMMAND_BUFFER_WAIT_SEMAPHORES_MAX = 64;
+    static constexpr const size_t COMMAND_BUFFER_SUBMIT_MAX = 128;
+    static constexpr const size_t COMMAND_BUFFER_WAIT_SEMAPHORES_MAX = 8;
+    static constexpr const size_t COMMAND_BUFFER_SIGNAL_SEMAPHORES_MAX = 4;
     static constexpr const size_t MAX_UNIQUE_COMMAND_QUEUES = 4;
     static constexpr const size_t MAX_SWAP_CHAIN_IMAGES = 16;
+    static constexpr const size_t MAX_DEVICE_EXTENSIONS = 8;
     static constexpr const size_t FRAMEBUFFER_MAX_TEXTURES = 8;
-    static constexpr const size_t GRAPH_MAX_POOLS_IN_ARRAY = 64;
     static constexpr const size_t RENDER_PIPELINE_MAX_DESCRIPTOR_SETS = 8;
+    static constexpr const size_t TRANSFER_RING_BUFFER_SIZE = se_megabytes(32);
+    static constexpr const size_t PIPELINE_CACHE_SAVE_PERIOD_FRAMES = 600;
+    static constexpr const size_t PIPELINE_COMPILER_MAX_THREADS = 4;
+    static constexpr const size_t PIPELINE_COMPILER_QUEUE_CAPACITY = 256;
+    static constexpr const size_t COMMAND_RECORDER_MAX_THREADS = 8;
+    static constexpr const size_t GRAPH_SECONDARY_BUFFER_MIN_COMMANDS = 256;
+    static constexpr const size_t DESCRIPTOR_SET_CACHE_LIFETIME = 8;
+    static constexpr const size_t TRANSIENT_HEAP_BLOCK_LIFETIME = 8;
+    static constexpr const uint32_t BINDLESS_MAX_BUFFERS = 16384;
+    static constexpr const uint32_t BINDLESS_MAX_TEXTURES = 16384;
+    static constexpr const uint32_t BINDLESS_MAX_SAMPLERS = 256;
 };
 
 #endif
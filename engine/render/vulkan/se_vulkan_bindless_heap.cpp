@@ -0,0 +1,236 @@
+
+#include "se_vulkan_bindless_heap.hpp"
+#include "se_vulkan_device.hpp"
+#include "se_vulkan_memory.hpp"
+#include "se_vulkan_memory_buffer.hpp"
+#include "se_vulkan_sampler.hpp"
+#include "se_vulkan_texture.hpp"
+#include "se_vulkan_utils.hpp"
+
+static_assert(SE_BINDLESS_SET == SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS - 1, "Bindless heap must be the last descriptor set");
+
+const VkDescriptorType SE_VK_BINDLESS_DESCRIPTOR_TYPES[SE_VK_BINDLESS_TYPE_COUNT] =
+{
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_SAMPLER,
+};
+
+const uint32_t SE_VK_BINDLESS_BINDINGS[SE_VK_BINDLESS_TYPE_COUNT] =
+{
+    SE_BINDLESS_BUFFERS_BINDING,
+    SE_BINDLESS_TEXTURES_BINDING,
+    SE_BINDLESS_SAMPLERS_BINDING,
+};
+
+void se_vk_bindless_heap_construct(SeVkBindlessHeap* heap, SeVkDevice* device)
+{
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(device);
+    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&device->memoryManager);
+    *heap =
+    {
+        .device         = device,
+        .layout         = VK_NULL_HANDLE,
+        .emptyLayout    = VK_NULL_HANDLE,
+        .pool           = VK_NULL_HANDLE,
+        .set            = VK_NULL_HANDLE,
+        .capacities     = { SeVkConfig::BINDLESS_MAX_BUFFERS, SeVkConfig::BINDLESS_MAX_TEXTURES, SeVkConfig::BINDLESS_MAX_SAMPLERS },
+        .numUsedIndices = { },
+        .freeIndices    = { },
+    };
+    if (!se_vk_device_is_bindless_supported(device)) return;
+    for (size_t it = 0; it < SE_VK_BINDLESS_TYPE_COUNT; it++)
+    {
+        se_dynamic_array_construct(heap->freeIndices[it], se_allocator_persistent());
+    }
+    //
+    // Layouts
+    //
+    VkDescriptorSetLayoutBinding bindings[SE_VK_BINDLESS_TYPE_COUNT];
+    VkDescriptorBindingFlags bindingFlags[SE_VK_BINDLESS_TYPE_COUNT];
+    VkDescriptorPoolSize poolSizes[SE_VK_BINDLESS_TYPE_COUNT];
+    for (size_t it = 0; it < SE_VK_BINDLESS_TYPE_COUNT; it++)
+    {
+        bindings[it] =
+        {
+            .binding            = SE_VK_BINDLESS_BINDINGS[it],
+            .descriptorType     = SE_VK_BINDLESS_DESCRIPTOR_TYPES[it],
+            .descriptorCount    = heap->capacities[it],
+            .stageFlags         = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT,
+            .pImmutableSamplers = nullptr,
+        };
+        // @NOTE : heap is written while frames in flight use it, but never at the indices they can access
+        bindingFlags[it] =
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT       |
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT     |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+        poolSizes[it] =
+        {
+            .type               = SE_VK_BINDLESS_DESCRIPTOR_TYPES[it],
+            .descriptorCount    = heap->capacities[it],
+        };
+    }
+    const VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCreateInfo
+    {
+        .sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+        .pNext          = nullptr,
+        .bindingCount   = SE_VK_BINDLESS_TYPE_COUNT,
+        .pBindingFlags  = bindingFlags,
+    };
+    const VkDescriptorSetLayoutCreateInfo layoutCreateInfo
+    {
+        .sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext          = &bindingFlagsCreateInfo,
+        .flags          = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+        .bindingCount   = SE_VK_BINDLESS_TYPE_COUNT,
+        .pBindings      = bindings,
+    };
+    se_vk_check(vkCreateDescriptorSetLayout(logicalHandle, &layoutCreateInfo, callbacks, &heap->layout));
+    const VkDescriptorSetLayoutCreateInfo emptyLayoutCreateInfo
+    {
+        .sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext          = nullptr,
+        .flags          = 0,
+        .bindingCount   = 0,
+        .pBindings      = nullptr,
+    };
+    se_vk_check(vkCreateDescriptorSetLayout(logicalHandle, &emptyLayoutCreateInfo, callbacks, &heap->emptyLayout));
+    //
+    // Pool and set
+    //
+    const VkDescriptorPoolCreateInfo poolCreateInfo
+    {
+        .sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .pNext          = nullptr,
+        .flags          = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+        .maxSets        = 1,
+        .poolSizeCount  = SE_VK_BINDLESS_TYPE_COUNT,
+        .pPoolSizes     = poolSizes,
+    };
+    se_vk_check(vkCreateDescriptorPool(logicalHandle, &poolCreateInfo, callbacks, &heap->pool));
+    const VkDescriptorSetAllocateInfo allocateInfo
+    {
+        .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext              = nullptr,
+        .descriptorPool     = heap->pool,
+        .descriptorSetCount = 1,
+        .pSetLayouts        = &heap->layout,
+    };
+    se_vk_check(vkAllocateDescriptorSets(logicalHandle, &allocateInfo, &heap->set));
+}
+
+void se_vk_bindless_heap_destroy(SeVkBindlessHeap* heap)
+{
+    if (!se_vk_bindless_heap_is_valid(heap)) return;
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(heap->device);
+    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&heap->device->memoryManager);
+    vkDestroyDescriptorPool(logicalHandle, heap->pool, callbacks);
+    vkDestroyDescriptorSetLayout(logicalHandle, heap->layout, callbacks);
+    vkDestroyDescriptorSetLayout(logicalHandle, heap->emptyLayout, callbacks);
+    for (size_t it = 0; it < SE_VK_BINDLESS_TYPE_COUNT; it++)
+    {
+        se_dynamic_array_destroy(heap->freeIndices[it]);
+    }
+}
+
+//
+// @NOTE :  full heap isn't an assert, because it would be compiled out in release and index past the capacity would be
+//          written to the descriptor array. Resource just stays out of the heap (same as transient ones), so only
+//          se_render_bindless_index calls for it fail
+//
+uint32_t se_vk_bindless_heap_take_index(SeVkBindlessHeap* heap, SeVkBindlessType type)
+{
+    SeDynamicArray<uint32_t>& freeIndices = heap->freeIndices[type];
+    const size_t numFreeIndices = se_dynamic_array_size(freeIndices);
+    if (numFreeIndices)
+    {
+        const uint32_t index = *se_dynamic_array_last(freeIndices);
+        se_dynamic_array_remove_idx(freeIndices, numFreeIndices - 1);
+        return index;
+    }
+    if (heap->numUsedIndices[type] >= heap->capacities[type])
+    {
+        se_dbg_error("Bindless heap is full, resource won't be added to it. Increase SeVkConfig::BINDLESS_MAX_* value");
+        return SE_BINDLESS_INVALID_INDEX;
+    }
+    return heap->numUsedIndices[type]++;
+}
+
+void se_vk_bindless_heap_write(SeVkBindlessHeap* heap, SeVkBindlessType type, uint32_t index, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo)
+{
+    const VkWriteDescriptorSet write
+    {
+        .sType              = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .pNext              = nullptr,
+        .dstSet             = heap->set,
+        .dstBinding         = SE_VK_BINDLESS_BINDINGS[type],
+        .dstArrayElement    = index,
+        .descriptorCount    = 1,
+        .descriptorType     = SE_VK_BINDLESS_DESCRIPTOR_TYPES[type],
+        .pImageInfo         = imageInfo,
+        .pBufferInfo        = bufferInfo,
+        .pTexelBufferView   = nullptr,
+    };
+    vkUpdateDescriptorSets(se_vk_device_get_logical_handle(heap->device), 1, &write, 0, nullptr);
+}
+
+uint32_t se_vk_bindless_heap_add_buffer(SeVkBindlessHeap* heap, const SeVkMemoryBuffer* buffer)
+{
+    if (!se_vk_bindless_heap_is_valid(heap)) return SE_BINDLESS_INVALID_INDEX;
+    const uint32_t index = se_vk_bindless_heap_take_index(heap, SE_VK_BINDLESS_BUFFER);
+    if (index == SE_BINDLESS_INVALID_INDEX) return index;
+    const VkDescriptorBufferInfo bufferInfo
+    {
+        .buffer = buffer->handle,
+        .offset = 0,
+        .range  = VK_WHOLE_SIZE,
+    };
+    se_vk_bindless_heap_write(heap, SE_VK_BINDLESS_BUFFER, index, nullptr, &bufferInfo);
+    return index;
+}
+
+uint32_t se_vk_bindless_heap_add_texture(SeVkBindlessHeap* heap, const SeVkTexture* texture)
+{
+    if (!se_vk_bindless_heap_is_valid(heap)) return SE_BINDLESS_INVALID_INDEX;
+    const uint32_t index = se_vk_bindless_heap_take_index(heap, SE_VK_BINDLESS_TEXTURE);
+    if (index == SE_BINDLESS_INVALID_INDEX) return index;
+    const VkDescriptorImageInfo imageInfo
+    {
+        .sampler        = VK_NULL_HANDLE,
+        .imageView      = texture->view,
+        .imageLayout    = se_vk_bindless_heap_get_image_layout(texture->format),
+    };
+    se_vk_bindless_heap_write(heap, SE_VK_BINDLESS_TEXTURE, index, &imageInfo, nullptr);
+    return index;
+}
+
+uint32_t se_vk_bindless_heap_add_sampler(SeVkBindlessHeap* heap, const SeVkSampler* sampler)
+{
+    if (!se_vk_bindless_heap_is_valid(heap)) return SE_BINDLESS_INVALID_INDEX;
+    const uint32_t index = se_vk_bindless_heap_take_index(heap, SE_VK_BINDLESS_SAMPLER);
+    if (index == SE_BINDLESS_INVALID_INDEX) return index;
+    const VkDescriptorImageInfo imageInfo
+    {
+        .sampler        = sampler->handle,
+        .imageView      = VK_NULL_HANDLE,
+        .imageLayout    = VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+    se_vk_bindless_heap_write(heap, SE_VK_BINDLESS_SAMPLER, index, &imageInfo, nullptr);
+    return index;
+}
+
+//
+// Descriptor at the released index is left as is. It isn't accessed by anyone (heap bindings are partially bound)
+// until the index is handed out again and overwritten
+//
+void se_vk_bindless_heap_remove(SeVkBindlessHeap* heap, SeVkBindlessType type, uint32_t index)
+{
+    if (index == SE_BINDLESS_INVALID_INDEX) return;
+    se_assert(se_vk_bindless_heap_is_valid(heap) && index < heap->numUsedIndices[type]);
+    se_dynamic_array_push(heap->freeIndices[type], index);
+}
+
+VkImageLayout se_vk_bindless_heap_get_image_layout(VkFormat format)
+{
+    return se_vk_utils_is_depth_stencil_format(format) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+}
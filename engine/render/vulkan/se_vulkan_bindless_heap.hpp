@@ -0,0 +1,56 @@
+#ifndef _SE_VULKAN_BINDLESS_HEAP_H_
+#define _SE_VULKAN_BINDLESS_HEAP_H_
+
+#include "se_vulkan_base.hpp"
+
+//
+// Global descriptor heap used by the bindless mode.
+//
+// Heap is a single update-after-bind descriptor set with three partially bound arrays : storage buffers, sampled images
+// and samplers (see SE_BINDLESS_* constants in se_render.hpp). Resources get their index when they are constructed and
+// release it when they are destroyed. Resources are destroyed only after gpu stopped using them (see graveyard in
+// se_vulkan_device.hpp), so a released index can be handed out again right away. Descriptors are written once, at
+// construction time, so draws and dispatches never update the heap.
+//
+// Pipelines that declare set SE_BINDLESS_SET get heap layout at that index (gaps between regular sets and the heap
+// are filled with an empty layout) and the graph binds heap set right after the pipeline.
+//
+// Image descriptors are written with SHADER_READ_ONLY_OPTIMAL layout (DEPTH_STENCIL_READ_ONLY_OPTIMAL for depth formats).
+// Uploaded textures are moved to that layout by the transfer manager.
+//
+
+enum SeVkBindlessType
+{
+    SE_VK_BINDLESS_BUFFER,
+    SE_VK_BINDLESS_TEXTURE,
+    SE_VK_BINDLESS_SAMPLER,
+    SE_VK_BINDLESS_TYPE_COUNT,
+};
+
+struct SeVkBindlessHeap
+{
+    SeVkDevice*                 device;
+    VkDescriptorSetLayout       layout;
+    VkDescriptorSetLayout       emptyLayout;    // Fills set indices between regular sets and the heap in pipeline layouts
+    VkDescriptorPool            pool;
+    VkDescriptorSet             set;
+    uint32_t                    capacities[SE_VK_BINDLESS_TYPE_COUNT];
+    uint32_t                    numUsedIndices[SE_VK_BINDLESS_TYPE_COUNT];  // Indices that were ever handed out
+    SeDynamicArray<uint32_t>    freeIndices[SE_VK_BINDLESS_TYPE_COUNT];
+};
+
+#define se_vk_bindless_heap_is_valid(heap) ((heap)->set != VK_NULL_HANDLE)
+
+// Heap is constructed only if device supports bindless mode (SE_VK_GPU_HAS_BINDLESS), otherwise it stays zeroed
+void            se_vk_bindless_heap_construct(SeVkBindlessHeap* heap, SeVkDevice* device);
+void            se_vk_bindless_heap_destroy(SeVkBindlessHeap* heap);
+
+// Return SE_BINDLESS_INVALID_INDEX if heap is not valid or is full
+uint32_t        se_vk_bindless_heap_add_buffer(SeVkBindlessHeap* heap, const SeVkMemoryBuffer* buffer);
+uint32_t        se_vk_bindless_heap_add_texture(SeVkBindlessHeap* heap, const SeVkTexture* texture);
+uint32_t        se_vk_bindless_heap_add_sampler(SeVkBindlessHeap* heap, const SeVkSampler* sampler);
+void            se_vk_bindless_heap_remove(SeVkBindlessHeap* heap, SeVkBindlessType type, uint32_t index);
+
+VkImageLayout   se_vk_bindless_heap_get_image_layout(VkFormat format);
+
+#endif
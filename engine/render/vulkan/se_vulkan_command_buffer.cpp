@@ -5,27 +5,29 @@
 
 size_t g_commandBufferIndex = 0;
 
+SeVkFlags se_vk_command_buffer_usage_to_queue_flags(SeVkCommandBufferUsageFlags usage)
+{
+    return
+        (usage & SE_VK_COMMAND_BUFFER_USAGE_GRAPHICS ? SE_VK_CMD_QUEUE_GRAPHICS : 0) |
+        (usage & SE_VK_COMMAND_BUFFER_USAGE_TRANSFER ? SE_VK_CMD_QUEUE_TRANSFER : 0) |
+        (usage & SE_VK_COMMAND_BUFFER_USAGE_COMPUTE  ? SE_VK_CMD_QUEUE_COMPUTE  : 0) ;
+}
+
 void se_vk_command_buffer_construct(SeVkCommandBuffer* buffer, SeVkCommandBufferInfo* info)
 {
-    SeVkMemoryManager* const memoryManager = &info->device->memoryManager;
-    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(memoryManager);
     const VkDevice logicalHandle = se_vk_device_get_logical_handle(info->device);
     
     se_assert(info->usage);
-    const SeVkCommandQueueFlags queueFlags =
-        (info->usage & SE_VK_COMMAND_BUFFER_USAGE_GRAPHICS ? SE_VK_CMD_QUEUE_GRAPHICS : 0) |
-        (info->usage & SE_VK_COMMAND_BUFFER_USAGE_TRANSFER ? SE_VK_CMD_QUEUE_TRANSFER : 0) |
-        (info->usage & SE_VK_COMMAND_BUFFER_USAGE_COMPUTE  ? SE_VK_CMD_QUEUE_COMPUTE  : 0) ;
+    const SeVkCommandQueueFlags queueFlags = se_vk_command_buffer_usage_to_queue_flags(info->usage);
     se_assert(queueFlags);
+    const bool isSecondary = info->inheritance != nullptr;
     *buffer =
     {
         .object         = { SeVkObject::Type::COMMAND_BUFFER, 0, g_commandBufferIndex++ },
         .device         = info->device,
-        .pool           = se_vk_device_get_command_pool(info->device, queueFlags),
+        .pool           = info->pool ? info->pool : se_vk_device_get_command_pool(info->device, queueFlags),
         .queue          = se_vk_device_get_command_queue(info->device, queueFlags),
         .handle         = VK_NULL_HANDLE,
-        .semaphore      = VK_NULL_HANDLE,
-        .fence          = VK_NULL_HANDLE,
     };
     //
     // @TODO :  handle unsupported queueFlags combinations somehow
@@ -37,74 +39,96 @@ void se_vk_command_buffer_construct(SeVkCommandBuffer* buffer, SeVkCommandBuffer
         .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
         .pNext              = nullptr,
         .commandPool        = buffer->pool,
-        .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .level              = isSecondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY,
         .commandBufferCount = 1,
     };
     se_vk_check(vkAllocateCommandBuffers(logicalHandle, &allocateInfo, &buffer->handle));
-    const VkSemaphoreCreateInfo semaphoreCreateInfo =
-    {
-        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = 0,
-    };
-    se_vk_check(vkCreateSemaphore(logicalHandle, &semaphoreCreateInfo, callbacks, &buffer->semaphore));
-    const VkFenceCreateInfo fenceCreateInfo =
-    {
-        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = 0,
-    };
-    se_vk_check(vkCreateFence(logicalHandle, &fenceCreateInfo, callbacks, &buffer->fence));
+    //
+    // @NOTE : command buffers don't own any synchronization primitives. Primary buffers are synchronized
+    //         by their submission (see se_vk_command_buffer_submit), secondary buffers are never submitted directly
+    //
+    se_vk_command_buffer_begin(buffer, info->inheritance);
+}
+
+void se_vk_command_buffer_begin(SeVkCommandBuffer* buffer, const VkCommandBufferInheritanceInfo* inheritance)
+{
     const VkCommandBufferBeginInfo beginInfo =
     {
         .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
         .pNext              = nullptr,
-        .flags              = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
-        .pInheritanceInfo   = nullptr,
+        .flags              = inheritance
+                                ? VkCommandBufferUsageFlags(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT)
+                                : VkCommandBufferUsageFlags(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT),
+        .pInheritanceInfo   = inheritance,
     };
     se_vk_check(vkBeginCommandBuffer(buffer->handle, &beginInfo));
 }
 
 void se_vk_command_buffer_destroy(SeVkCommandBuffer* buffer)
 {
-    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&buffer->device->memoryManager);
     const VkDevice logicalHandle = se_vk_device_get_logical_handle(buffer->device);
-    vkDestroySemaphore(logicalHandle, buffer->semaphore, callbacks);
-    vkDestroyFence(logicalHandle, buffer->fence, callbacks);
     vkFreeCommandBuffers(logicalHandle, buffer->pool, 1, &buffer->handle);
 }
 
-void se_vk_command_buffer_submit(SeVkCommandBuffer* buffer, SeVkCommandBufferSubmitInfo* info)
+void se_vk_command_buffer_submit(const SeVkCommandBufferSubmitInfo* info)
 {
-    se_vk_check(vkEndCommandBuffer(buffer->handle));
-    uint32_t waitSemaphoreCount = 0;
-    VkSemaphore waitSemaphores[SeVkConfig::COMMAND_BUFFER_EXECUTE_AFTER_MAX + SeVkConfig::COMMAND_BUFFER_WAIT_SEMAPHORES_MAX];
-    VkPipelineStageFlags waitStages[SeVkConfig::COMMAND_BUFFER_EXECUTE_AFTER_MAX + SeVkConfig::COMMAND_BUFFER_WAIT_SEMAPHORES_MAX];
-    for (size_t it = 0; it < SeVkConfig::COMMAND_BUFFER_EXECUTE_AFTER_MAX; it++)
+    se_assert(info->numCommandBuffers);
+    const VkQueue queue = info->commandBuffers[0]->queue;
+    VkCommandBuffer handles[SeVkConfig::COMMAND_BUFFER_SUBMIT_MAX];
+    se_assert(info->numCommandBuffers <= SeVkConfig::COMMAND_BUFFER_SUBMIT_MAX);
+    for (size_t it = 0; it < info->numCommandBuffers; it++)
     {
-        if (!info->executeAfter[it]) break;
-        waitSemaphores[waitSemaphoreCount] = info->executeAfter[it]->semaphore;
-        waitStages[waitSemaphoreCount] = { VK_PIPELINE_STAGE_ALL_COMMANDS_BIT }; // TODO : optimize this
-        waitSemaphoreCount += 1;
+        SeVkCommandBuffer* const buffer = info->commandBuffers[it];
+        se_assert_msg(buffer->queue == queue, "All command buffers of a single submit must use the same queue");
+        se_vk_check(vkEndCommandBuffer(buffer->handle));
+        handles[it] = buffer->handle;
     }
+    uint32_t waitSemaphoreCount = 0;
+    VkSemaphore waitSemaphores[SeVkConfig::COMMAND_BUFFER_WAIT_SEMAPHORES_MAX];
+    uint64_t waitValues[SeVkConfig::COMMAND_BUFFER_WAIT_SEMAPHORES_MAX];
+    VkPipelineStageFlags waitStages[SeVkConfig::COMMAND_BUFFER_WAIT_SEMAPHORES_MAX];
     for (size_t it = 0; it < SeVkConfig::COMMAND_BUFFER_WAIT_SEMAPHORES_MAX; it++)
     {
-        if (!info->waitSemaphores[it]) break;
-        waitSemaphores[waitSemaphoreCount] = info->waitSemaphores[it];
-        waitStages[waitSemaphoreCount] = { VK_PIPELINE_STAGE_ALL_COMMANDS_BIT }; // TODO : optimize this
+        const SeVkSemaphoreSubmit& wait = info->wait[it];
+        if (!wait.semaphore) break;
+        se_assert(wait.stages);
+        waitSemaphores[waitSemaphoreCount] = wait.semaphore;
+        waitValues[waitSemaphoreCount] = wait.value;
+        waitStages[waitSemaphoreCount] = wait.stages;
         waitSemaphoreCount += 1;
     }
+    uint32_t signalSemaphoreCount = 0;
+    VkSemaphore signalSemaphores[SeVkConfig::COMMAND_BUFFER_SIGNAL_SEMAPHORES_MAX];
+    uint64_t signalValues[SeVkConfig::COMMAND_BUFFER_SIGNAL_SEMAPHORES_MAX];
+    for (size_t it = 0; it < SeVkConfig::COMMAND_BUFFER_SIGNAL_SEMAPHORES_MAX; it++)
+    {
+        const SeVkSemaphoreSubmit& signal = info->signal[it];
+        if (!signal.semaphore) break;
+        signalSemaphores[signalSemaphoreCount] = signal.semaphore;
+        signalValues[signalSemaphoreCount] = signal.value;
+        signalSemaphoreCount += 1;
+    }
+    // @NOTE : values of binary semaphores are ignored, so the same structure is used for any combination of semaphore types
+    const VkTimelineSemaphoreSubmitInfo timelineInfo =
+    {
+        .sType                      = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        .pNext                      = nullptr,
+        .waitSemaphoreValueCount    = waitSemaphoreCount,
+        .pWaitSemaphoreValues       = waitValues,
+        .signalSemaphoreValueCount  = signalSemaphoreCount,
+        .pSignalSemaphoreValues     = signalValues,
+    };
     const VkSubmitInfo submitInfo =
     {
         .sType                  = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        .pNext                  = nullptr,
+        .pNext                  = &timelineInfo,
         .waitSemaphoreCount     = waitSemaphoreCount,
         .pWaitSemaphores        = waitSemaphores,
         .pWaitDstStageMask      = waitStages,
-        .commandBufferCount     = 1,
-        .pCommandBuffers        = &buffer->handle,
-        .signalSemaphoreCount   = 1,
-        .pSignalSemaphores      = &buffer->semaphore,
+        .commandBufferCount     = uint32_t(info->numCommandBuffers),
+        .pCommandBuffers        = handles,
+        .signalSemaphoreCount   = signalSemaphoreCount,
+        .pSignalSemaphores      = signalSemaphores,
     };
-    se_vk_check(vkQueueSubmit(buffer->queue, 1, &submitInfo, buffer->fence));
+    se_vk_check(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE));
 }
@@ -18,25 +18,45 @@ struct SeVkCommandBuffer
     VkCommandPool   pool;
     VkQueue         queue;
     VkCommandBuffer handle;
-    VkSemaphore     semaphore;
-    VkFence         fence;
 };
 
 struct SeVkCommandBufferInfo
 {
     SeVkDevice* device;
     SeVkCommandBufferUsageFlags usage;
+    VkCommandPool pool;                                 // Optional, device command pool is used if not set. Must not be set for frame manager command buffers
+    const VkCommandBufferInheritanceInfo* inheritance;  // Optional, secondary command buffer is created if set
 };
 
+struct SeVkSemaphoreSubmit
+{
+    VkSemaphore             semaphore;
+    uint64_t                value;  // Ignored for binary semaphores
+    VkPipelineStageFlags    stages; // Ignored for signal operations
+};
+
+//
+// All command buffers are submitted with a single vkQueueSubmit call, so they must be created for the same queue.
+// Order of execution inside a queue is handled by pipeline barriers, semaphores are used only for cross queue,
+// swap chain and cpu synchronization. Wait and signal arrays end at the first null semaphore.
+//
 struct SeVkCommandBufferSubmitInfo
 {
-    SeVkCommandBuffer* executeAfter[SeVkConfig::COMMAND_BUFFER_EXECUTE_AFTER_MAX];
-    VkSemaphore waitSemaphores[SeVkConfig::COMMAND_BUFFER_WAIT_SEMAPHORES_MAX];
+    SeVkCommandBuffer* const*   commandBuffers;
+    size_t                      numCommandBuffers;
+    SeVkSemaphoreSubmit         wait[SeVkConfig::COMMAND_BUFFER_WAIT_SEMAPHORES_MAX];
+    SeVkSemaphoreSubmit         signal[SeVkConfig::COMMAND_BUFFER_SIGNAL_SEMAPHORES_MAX];
 };
 
+// Returns SeVkCommandQueueFlags (declared in se_vulkan_device.hpp)
+SeVkFlags se_vk_command_buffer_usage_to_queue_flags(SeVkCommandBufferUsageFlags usage);
+
 void se_vk_command_buffer_construct(SeVkCommandBuffer* buffer, SeVkCommandBufferInfo* info);
 void se_vk_command_buffer_destroy(SeVkCommandBuffer* buffer);
-void se_vk_command_buffer_submit(SeVkCommandBuffer* buffer, SeVkCommandBufferSubmitInfo* info);
+// Begins recording of a buffer that was reset together with it's pool
+void se_vk_command_buffer_begin(SeVkCommandBuffer* buffer, const VkCommandBufferInheritanceInfo* inheritance);
+// Ends and submits command buffers
+void se_vk_command_buffer_submit(const SeVkCommandBufferSubmitInfo* info);
 
 template<>
 void se_vk_destroy<SeVkCommandBuffer>(SeVkCommandBuffer* res)
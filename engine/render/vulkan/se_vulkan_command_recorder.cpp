@@ -0,0 +1,107 @@
+
+#include "se_vulkan_command_recorder.hpp"
+#include "se_vulkan_device.hpp"
+#include "se_vulkan_utils.hpp"
+
+void se_vk_command_recorder_run_lane(SeVkCommandRecorder* recorder, size_t lane)
+{
+    for (size_t it = 0; it < recorder->numJobs; it++)
+    {
+        const SeVkCommandRecorderJob& job = recorder->jobs[it];
+        if (job.lane == lane) job.pfn(job.userData);
+    }
+}
+
+void se_vk_command_recorder_thread(void* userData)
+{
+    SeVkCommandRecorderWorker* const worker = (SeVkCommandRecorderWorker*)userData;
+    SeVkCommandRecorder* const recorder = worker->recorder;
+    while (true)
+    {
+        se_platform_semaphore_wait(worker->semaphore);
+        if (se_platform_atomic_32_bit_load(&recorder->shouldStop, SE_ACQUIRE)) break;
+        se_vk_command_recorder_run_lane(recorder, worker->lane);
+        se_platform_atomic_32_bit_increment(&recorder->numFinishedWorkers);
+    }
+}
+
+void se_vk_command_recorder_construct(SeVkCommandRecorder* recorder, const SeVkCommandRecorderInfo* info)
+{
+    SeVkDevice* const device = info->device;
+    // @NOTE : one core is left for the main thread
+    const size_t numCores = se_platform_get_num_logical_cores();
+    const size_t numWorkers = se_min(numCores > 1 ? numCores - 1 : 0, SeVkConfig::COMMAND_RECORDER_MAX_THREADS - 1);
+    *recorder =
+    {
+        .device                            = device,
+        .workers                           = { },
+        .numWorkers                        = numWorkers,
+        .numActiveLanes                    = numWorkers + 1,
+        .jobs                              = nullptr,
+        .numJobs                           = 0,
+        .numFinishedWorkers                = 0,
+        .shouldStop                        = 0,
+        .lastFrameRecordingTicks           = 0,
+        .lastFrameNumPrimaryBuffers        = 0,
+        .lastFrameNumSecondaryBuffers      = 0,
+        .lastFrameNumQueueSubmits          = 0,
+        .lastFrameNumAsyncComputePasses    = 0,
+        .lastFrameNumCrossQueueWaits       = 0,
+        .lastFrameNumMergedPasses          = 0,
+        .lastFrameNumDynamicRenderings     = 0,
+        .lastFrameSetupTicks               = 0,
+        .lastFrameNumCreatedCommandObjects = 0,
+        .lastFrameNumReusedCommandBuffers  = 0,
+        .lastFrameNumRecordedCommands      = 0,
+        .lastFrameNumElidedCommands        = 0,
+        .lastFrameCommandStreamSize        = 0,
+    };
+    for (size_t it = 0; it < numWorkers; it++)
+    {
+        SeVkCommandRecorderWorker* const worker = &recorder->workers[it];
+        worker->recorder = recorder;
+        worker->semaphore = se_platform_semaphore_create(1);
+        worker->lane = it + 1;
+        se_platform_thread_construct(&worker->thread, se_vk_command_recorder_thread, worker);
+    }
+}
+
+void se_vk_command_recorder_destroy(SeVkCommandRecorder* recorder)
+{
+    se_platform_atomic_32_bit_store(&recorder->shouldStop, 1, SE_RELEASE);
+    for (size_t it = 0; it < recorder->numWorkers; it++)
+    {
+        se_platform_semaphore_signal(recorder->workers[it].semaphore, 1);
+        se_platform_thread_join(&recorder->workers[it].thread);
+        se_platform_semaphore_destroy(recorder->workers[it].semaphore);
+    }
+}
+
+void se_vk_command_recorder_set_num_lanes(SeVkCommandRecorder* recorder, size_t numLanes)
+{
+    recorder->numActiveLanes = se_max(se_min(numLanes, recorder->numWorkers + 1), size_t(1));
+}
+
+inline size_t se_vk_command_recorder_get_num_lanes(const SeVkCommandRecorder* recorder)
+{
+    return recorder->numActiveLanes;
+}
+
+void se_vk_command_recorder_execute(SeVkCommandRecorder* recorder, const SeVkCommandRecorderJob* jobs, size_t numJobs)
+{
+    recorder->jobs = jobs;
+    recorder->numJobs = numJobs;
+    const uint32_t numActiveWorkers = uint32_t(recorder->numActiveLanes - 1);
+    se_platform_atomic_32_bit_store(&recorder->numFinishedWorkers, 0, SE_RELEASE);
+    for (size_t it = 0; it < numActiveWorkers; it++)
+    {
+        se_platform_semaphore_signal(recorder->workers[it].semaphore, 1);
+    }
+    se_vk_command_recorder_run_lane(recorder, 0);
+    while (se_platform_atomic_32_bit_load(&recorder->numFinishedWorkers, SE_ACQUIRE) != numActiveWorkers)
+    {
+        se_platform_thread_yield();
+    }
+    recorder->jobs = nullptr;
+    recorder->numJobs = 0;
+}
@@ -0,0 +1,77 @@
+#ifndef _SE_VULKAN_COMMAND_RECORDER_H_
+#define _SE_VULKAN_COMMAND_RECORDER_H_
+
+#include "se_vulkan_base.hpp"
+#include "se_vulkan_command_buffer.hpp"
+
+//
+// Command recorder runs command buffer recording jobs on worker threads.
+//
+// Work is split into lanes. Lane 0 is the main thread, other lanes are worker threads. Each lane has its own
+// command pools, because VkCommandPool must be externally synchronized. Command buffers that are recorded by a job
+// must be allocated from the pools of the job's lane (lane argument of se_vk_frame_manager_get_cmd).
+// Jobs are assigned to lanes by the caller, so the result doesn't depend on thread timings.
+//
+// Recording jobs can't use frame allocator, memory manager allocation callbacks or any other non thread safe
+// engine systems. Lane pools are created without allocation callbacks for the same reason.
+//
+
+using SeVkCommandRecorderJobPfn = void (*)(void* userData);
+
+struct SeVkCommandRecorderJob
+{
+    SeVkCommandRecorderJobPfn   pfn;
+    void*                       userData;
+    size_t                      lane;
+};
+
+struct SeVkCommandRecorder;
+
+struct SeVkCommandRecorderWorker
+{
+    SeVkCommandRecorder*    recorder;
+    SePlatformThread        thread;
+    SePlatformSemaphore     semaphore;
+    size_t                  lane;
+};
+
+struct SeVkCommandRecorder
+{
+    SeVkDevice*                 device;
+    SeVkCommandRecorderWorker   workers[SeVkConfig::COMMAND_RECORDER_MAX_THREADS - 1];
+    size_t                      numWorkers;
+    size_t                      numActiveLanes; // Main thread + active workers
+    const SeVkCommandRecorderJob* jobs;
+    size_t                      numJobs;
+    uint32_t                    numFinishedWorkers; // Atomic
+    uint32_t                    shouldStop;         // Atomic
+    uint64_t                    lastFrameRecordingTicks;
+    size_t                      lastFrameNumPrimaryBuffers;
+    size_t                      lastFrameNumSecondaryBuffers;
+    size_t                      lastFrameNumQueueSubmits;
+    size_t                      lastFrameNumAsyncComputePasses;
+    size_t                      lastFrameNumCrossQueueWaits;        // Semaphore waits between the graphics and async compute queues
+    size_t                      lastFrameNumMergedPasses;
+    size_t                      lastFrameNumDynamicRenderings;      // Groups recorded with dynamic rendering
+    uint64_t                    lastFrameSetupTicks;                // Render pass, framebuffer and pipeline lookups of the graph
+    size_t                      lastFrameNumCreatedCommandObjects;
+    size_t                      lastFrameNumReusedCommandBuffers;
+    size_t                      lastFrameNumRecordedCommands;       // Commands of the graph command stream
+    size_t                      lastFrameNumElidedCommands;         // Redundant commands that weren't added to the stream
+    size_t                      lastFrameCommandStreamSize;
+};
+
+struct SeVkCommandRecorderInfo
+{
+    SeVkDevice* device;
+};
+
+void            se_vk_command_recorder_construct(SeVkCommandRecorder* recorder, const SeVkCommandRecorderInfo* info);
+void            se_vk_command_recorder_destroy(SeVkCommandRecorder* recorder);
+void            se_vk_command_recorder_set_num_lanes(SeVkCommandRecorder* recorder, size_t numLanes);
+size_t          se_vk_command_recorder_get_num_lanes(const SeVkCommandRecorder* recorder);
+
+// Runs all jobs and returns when all of them are finished. Main thread executes lane 0 jobs
+void            se_vk_command_recorder_execute(SeVkCommandRecorder* recorder, const SeVkCommandRecorderJob* jobs, size_t numJobs);
+
+#endif
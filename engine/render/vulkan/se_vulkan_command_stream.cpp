@@ -0,0 +1,183 @@
+
+#include "se_vulkan_command_stream.hpp"
+
+constexpr size_t se_vk_command_stream_align(size_t value)
+{
+    return (value + SE_VK_COMMAND_STREAM_ALIGNMENT - 1) & ~(SE_VK_COMMAND_STREAM_ALIGNMENT - 1);
+}
+
+//
+// Adds zeroed command of the given size to the end of the stream. Returned pointer is valid until the next command is added
+//
+void* _se_vk_command_stream_add(SeVkCommandStream* stream, SeVkGraphCommandType type, size_t payloadSize)
+{
+    const size_t size = se_vk_command_stream_align(payloadSize);
+    se_assert(size <= UINT16_MAX);
+    const size_t offset = se_dynamic_array_size(stream->data);
+    const size_t capacity = se_dynamic_array_capacity(stream->data);
+    if (offset + size > capacity) se_dynamic_array_reserve(stream->data, se_max(capacity * 2, offset + size));
+    se_dynamic_array_force_set_size(stream->data, offset + size);
+    uint8_t* const memory = se_dynamic_array_raw(stream->data) + offset;
+    memset(memory, 0, size);
+    *(SeVkGraphCommand*)memory = { type, uint16_t(size) };
+    stream->pass.end = offset + size;
+    stream->pass.numCommands += 1;
+    stream->numCommands += 1;
+    return memory;
+}
+
+void se_vk_command_stream_construct(SeVkCommandStream* stream, SeAllocatorBindings allocator, size_t capacity)
+{
+    *stream =
+    {
+        .data               = se_dynamic_array_create<uint8_t>(allocator, se_max(capacity, SE_VK_COMMAND_STREAM_ALIGNMENT)),
+        .pass               = { },
+        .boundSets          = { },
+        .pushConstants      = SE_VK_COMMAND_STREAM_NO_COMMAND,
+        .indexBuffer        = SE_VK_COMMAND_STREAM_NO_COMMAND,
+        .numCommands        = 0,
+        .numElidedCommands  = 0,
+    };
+    se_vk_command_stream_begin_pass(stream);
+}
+
+void se_vk_command_stream_destroy(SeVkCommandStream* stream)
+{
+    se_dynamic_array_destroy(stream->data);
+}
+
+void se_vk_command_stream_reset(SeVkCommandStream* stream)
+{
+    se_dynamic_array_reset(stream->data);
+    stream->numCommands = 0;
+    stream->numElidedCommands = 0;
+    se_vk_command_stream_begin_pass(stream);
+}
+
+void se_vk_command_stream_begin_pass(SeVkCommandStream* stream)
+{
+    const size_t offset = se_dynamic_array_size(stream->data);
+    stream->pass =
+    {
+        .begin          = offset,
+        .end            = offset,
+        .numCommands    = 0,
+        .numBinds       = 0,
+    };
+    for (size_t it = 0; it < SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS; it++) stream->boundSets[it] = SE_VK_COMMAND_STREAM_NO_COMMAND;
+    stream->pushConstants = SE_VK_COMMAND_STREAM_NO_COMMAND;
+    stream->indexBuffer = SE_VK_COMMAND_STREAM_NO_COMMAND;
+}
+
+SeVkCommandStreamRange se_vk_command_stream_end_pass(SeVkCommandStream* stream)
+{
+    const SeVkCommandStreamRange result = stream->pass;
+    se_vk_command_stream_begin_pass(stream);
+    return result;
+}
+
+void se_vk_command_stream_bind(SeVkCommandStream* stream, uint32_t set, const SeBinding* bindings, uint32_t numBindings)
+{
+    se_assert(set < SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS);
+    se_assert(numBindings <= SE_MAX_BINDINGS);
+    //
+    // Only the active union member is copied, so bindings can be compared byte by byte
+    //
+    SeBinding normalized[SE_MAX_BINDINGS];
+    memset(normalized, 0, sizeof(SeBinding) * numBindings);
+    for (uint32_t it = 0; it < numBindings; it++)
+    {
+        normalized[it].binding = bindings[it].binding;
+        normalized[it].type = bindings[it].type;
+        if (bindings[it].type == SeBinding::TEXTURE)    normalized[it].texture = bindings[it].texture;
+        else                                            normalized[it].buffer = bindings[it].buffer;
+    }
+    const size_t bindingsSize = sizeof(SeBinding) * numBindings;
+    if (stream->boundSets[set] != SE_VK_COMMAND_STREAM_NO_COMMAND)
+    {
+        const SeVkGraphCommandBind* const bound = (const SeVkGraphCommandBind*)se_vk_command_stream_at(stream, stream->boundSets[set]);
+        if (bound->numBindings == numBindings && memcmp(se_vk_graph_command_bindings(bound), normalized, bindingsSize) == 0)
+        {
+            stream->numElidedCommands += 1;
+            return;
+        }
+    }
+    stream->boundSets[set] = se_dynamic_array_size(stream->data);
+    SeVkGraphCommandBind* const command = (SeVkGraphCommandBind*)_se_vk_command_stream_add(stream, SE_VK_GRAPH_COMMAND_TYPE_BIND, sizeof(SeVkGraphCommandBind) + bindingsSize);
+    command->set = uint16_t(set);
+    command->numBindings = uint16_t(numBindings);
+    memcpy((void*)se_vk_graph_command_bindings(command), normalized, bindingsSize);
+    stream->pass.numBinds += 1;
+}
+
+void se_vk_command_stream_push_constants(SeVkCommandStream* stream, const void* data, uint32_t size)
+{
+    if (stream->pushConstants != SE_VK_COMMAND_STREAM_NO_COMMAND)
+    {
+        const SeVkGraphCommandPushConstants* const pushed = (const SeVkGraphCommandPushConstants*)se_vk_command_stream_at(stream, stream->pushConstants);
+        if (pushed->size == size && memcmp(se_vk_graph_command_push_constants_data(pushed), data, size) == 0)
+        {
+            stream->numElidedCommands += 1;
+            return;
+        }
+    }
+    stream->pushConstants = se_dynamic_array_size(stream->data);
+    SeVkGraphCommandPushConstants* const command = (SeVkGraphCommandPushConstants*)_se_vk_command_stream_add(stream, SE_VK_GRAPH_COMMAND_TYPE_PUSH_CONSTANTS, sizeof(SeVkGraphCommandPushConstants) + size);
+    command->size = size;
+    memcpy((void*)se_vk_graph_command_push_constants_data(command), data, size);
+}
+
+void se_vk_command_stream_draw(SeVkCommandStream* stream, const SeCommandDrawInfo& info)
+{
+    SeVkGraphCommandDraw* const command = (SeVkGraphCommandDraw*)_se_vk_command_stream_add(stream, SE_VK_GRAPH_COMMAND_TYPE_DRAW, sizeof(SeVkGraphCommandDraw));
+    command->info = info;
+}
+
+void se_vk_command_stream_dispatch(SeVkCommandStream* stream, const SeCommandDispatchInfo& info)
+{
+    SeVkGraphCommandDispatch* const command = (SeVkGraphCommandDispatch*)_se_vk_command_stream_add(stream, SE_VK_GRAPH_COMMAND_TYPE_DISPATCH, sizeof(SeVkGraphCommandDispatch));
+    command->info = info;
+}
+
+void se_vk_command_stream_bind_index_buffer(SeVkCommandStream* stream, SeVkGraphBufferRange indices, VkIndexType type)
+{
+    if (stream->indexBuffer != SE_VK_COMMAND_STREAM_NO_COMMAND)
+    {
+        const SeVkGraphCommandBindIndexBuffer* const bound = (const SeVkGraphCommandBindIndexBuffer*)se_vk_command_stream_at(stream, stream->indexBuffer);
+        if (bound->type == type && bound->indices.buffer == indices.buffer && bound->indices.offset == indices.offset)
+        {
+            stream->numElidedCommands += 1;
+            return;
+        }
+    }
+    stream->indexBuffer = se_dynamic_array_size(stream->data);
+    SeVkGraphCommandBindIndexBuffer* const command = (SeVkGraphCommandBindIndexBuffer*)_se_vk_command_stream_add(stream, SE_VK_GRAPH_COMMAND_TYPE_BIND_INDEX_BUFFER, sizeof(SeVkGraphCommandBindIndexBuffer));
+    command->type = type;
+    command->indices = indices;
+}
+
+void se_vk_command_stream_draw_indexed(SeVkCommandStream* stream, const SeCommandDrawIndexedInfo& info)
+{
+    SeVkGraphCommandDrawIndexed* const command = (SeVkGraphCommandDrawIndexed*)_se_vk_command_stream_add(stream, SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED, sizeof(SeVkGraphCommandDrawIndexed));
+    command->info = info;
+}
+
+void se_vk_command_stream_draw_indirect(SeVkCommandStream* stream, SeVkGraphCommandType type, SeVkGraphBufferRange args, SeVkGraphBufferRange count, uint32_t numDraws)
+{
+    se_assert
+    (
+        type == SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDIRECT ||
+        type == SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT ||
+        type == SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT_COUNT
+    );
+    SeVkGraphCommandDrawIndirect* const command = (SeVkGraphCommandDrawIndirect*)_se_vk_command_stream_add(stream, type, sizeof(SeVkGraphCommandDrawIndirect));
+    command->numDraws = numDraws;
+    command->args = args;
+    command->count = count;
+}
+
+void se_vk_command_stream_dispatch_indirect(SeVkCommandStream* stream, SeVkGraphBufferRange args)
+{
+    SeVkGraphCommandDispatchIndirect* const command = (SeVkGraphCommandDispatchIndirect*)_se_vk_command_stream_add(stream, SE_VK_GRAPH_COMMAND_TYPE_DISPATCH_INDIRECT, sizeof(SeVkGraphCommandDispatchIndirect));
+    command->args = args;
+}
@@ -0,0 +1,192 @@
+#ifndef _SE_VULKAN_COMMAND_STREAM_H_
+#define _SE_VULKAN_COMMAND_STREAM_H_
+
+#include "se_vulkan_base.hpp"
+
+//
+// Command stream stores render graph commands of a frame in a single linear buffer. Every command starts with
+// SeVkGraphCommand (type and size of the whole command) and its payload follows it. Commands have variable size : bind
+// commands store only the used bindings and push constants store only the pushed bytes, so draw takes 16 bytes and bind of
+// a single binding takes 40 bytes (SeCommandBindInfo alone takes 264). Commands are aligned to SE_VK_COMMAND_STREAM_ALIGNMENT
+// and are read in place, next command starts right after the previous one.
+//
+// Encoder elides commands that don't change the pass state : bind of the same bindings to the set that already has them,
+// push of the same constants and bind of the same index buffer. Every pass has its own pipeline, so this state is reset
+// at the beginning of every pass. Elided commands aren't recorded at all, so barrier planning, descriptor set lookups
+// and recording skip them too.
+//
+// Stream doesn't use any vulkan objects (buffers in commands are just pointers), so it can be used without a device.
+//
+
+struct SeVkMemoryBuffer;
+
+constexpr size_t SE_VK_COMMAND_STREAM_ALIGNMENT = 8;
+constexpr size_t SE_VK_COMMAND_STREAM_NO_COMMAND = SIZE_MAX;
+
+enum SeVkGraphCommandType : uint16_t
+{
+    SE_VK_GRAPH_COMMAND_TYPE_DRAW,
+    SE_VK_GRAPH_COMMAND_TYPE_DISPATCH,
+    SE_VK_GRAPH_COMMAND_TYPE_BIND,
+    SE_VK_GRAPH_COMMAND_TYPE_PUSH_CONSTANTS,
+    SE_VK_GRAPH_COMMAND_TYPE_BIND_INDEX_BUFFER,
+    SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED,
+    SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDIRECT,
+    SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT,
+    SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT_COUNT,
+    SE_VK_GRAPH_COMMAND_TYPE_DISPATCH_INDIRECT,
+};
+
+// Header of every command in the stream
+struct SeVkGraphCommand
+{
+    SeVkGraphCommandType    type;
+    uint16_t                size;   // Size of the whole command, multiple of SE_VK_COMMAND_STREAM_ALIGNMENT
+};
+
+//
+// Buffers referenced by index buffer and indirect commands are resolved when the command is added (scratch buffers
+// become ranges of the frame scratch buffer), so barrier planning and recording don't need buffer refs
+//
+struct SeVkGraphBufferRange
+{
+    SeVkMemoryBuffer*   buffer;
+    VkDeviceSize        offset;
+};
+
+struct SeVkGraphCommandDraw
+{
+    SeVkGraphCommand        header;
+    SeCommandDrawInfo       info;
+};
+
+struct SeVkGraphCommandDispatch
+{
+    SeVkGraphCommand        header;
+    SeCommandDispatchInfo   info;
+};
+
+// Followed by numBindings bindings (see se_vk_graph_command_bindings)
+struct SeVkGraphCommandBind
+{
+    SeVkGraphCommand        header;
+    uint16_t                set;
+    uint16_t                numBindings;
+};
+
+// Followed by size bytes of data (see se_vk_graph_command_push_constants_data)
+struct SeVkGraphCommandPushConstants
+{
+    SeVkGraphCommand        header;
+    uint32_t                size;
+};
+
+struct SeVkGraphCommandBindIndexBuffer
+{
+    SeVkGraphCommand        header;
+    VkIndexType             type;
+    SeVkGraphBufferRange    indices;
+};
+
+struct SeVkGraphCommandDrawIndexed
+{
+    SeVkGraphCommand        header;
+    SeCommandDrawIndexedInfo info;
+};
+
+// Used by SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDIRECT, SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT and SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT_COUNT
+struct SeVkGraphCommandDrawIndirect
+{
+    SeVkGraphCommand        header;
+    uint32_t                numDraws;   // Maximum number of draws for SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT_COUNT
+    SeVkGraphBufferRange    args;
+    SeVkGraphBufferRange    count;      // Only for SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT_COUNT
+};
+
+struct SeVkGraphCommandDispatchIndirect
+{
+    SeVkGraphCommand        header;
+    SeVkGraphBufferRange    args;
+};
+
+// Commands of a single pass
+struct SeVkCommandStreamRange
+{
+    size_t begin;           // Offset of the first command
+    size_t end;             // Offset after the last command
+    size_t numCommands;
+    size_t numBinds;        // Bind commands among them
+};
+
+struct SeVkCommandStream
+{
+    SeDynamicArray<uint8_t> data;
+    SeVkCommandStreamRange  pass;                                                       // Commands of the current pass
+    size_t                  boundSets[SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS]; // Offsets of the last bind commands of the current pass
+    size_t                  pushConstants;                                              // Offset of the last push constants command of the current pass
+    size_t                  indexBuffer;                                                // Offset of the last bind index buffer command of the current pass
+    size_t                  numCommands;
+    size_t                  numElidedCommands;
+};
+
+void    se_vk_command_stream_construct(SeVkCommandStream* stream, SeAllocatorBindings allocator, size_t capacity);
+void    se_vk_command_stream_destroy(SeVkCommandStream* stream);
+
+// Removes all commands, memory is kept for the next frame
+void    se_vk_command_stream_reset(SeVkCommandStream* stream);
+void    se_vk_command_stream_begin_pass(SeVkCommandStream* stream);
+SeVkCommandStreamRange se_vk_command_stream_end_pass(SeVkCommandStream* stream);
+
+void    se_vk_command_stream_bind(SeVkCommandStream* stream, uint32_t set, const SeBinding* bindings, uint32_t numBindings);
+void    se_vk_command_stream_push_constants(SeVkCommandStream* stream, const void* data, uint32_t size);
+void    se_vk_command_stream_draw(SeVkCommandStream* stream, const SeCommandDrawInfo& info);
+void    se_vk_command_stream_dispatch(SeVkCommandStream* stream, const SeCommandDispatchInfo& info);
+void    se_vk_command_stream_bind_index_buffer(SeVkCommandStream* stream, SeVkGraphBufferRange indices, VkIndexType type);
+void    se_vk_command_stream_draw_indexed(SeVkCommandStream* stream, const SeCommandDrawIndexedInfo& info);
+void    se_vk_command_stream_draw_indirect(SeVkCommandStream* stream, SeVkGraphCommandType type, SeVkGraphBufferRange args, SeVkGraphBufferRange count, uint32_t numDraws);
+void    se_vk_command_stream_dispatch_indirect(SeVkCommandStream* stream, SeVkGraphBufferRange args);
+
+inline size_t se_vk_command_stream_size(const SeVkCommandStream* stream)
+{
+    return se_dynamic_array_size(stream->data);
+}
+
+// @NOTE : pointers are valid until the next command is added, stream memory can move when it grows
+inline const SeVkGraphCommand* se_vk_command_stream_at(const SeVkCommandStream* stream, size_t offset)
+{
+    se_assert(offset < se_dynamic_array_size(stream->data));
+    return (const SeVkGraphCommand*)(se_dynamic_array_raw(stream->data) + offset);
+}
+
+inline const SeVkGraphCommand* se_vk_graph_command_next(const SeVkGraphCommand* command)
+{
+    return (const SeVkGraphCommand*)((const uint8_t*)command + command->size);
+}
+
+inline const SeBinding* se_vk_graph_command_bindings(const SeVkGraphCommandBind* command)
+{
+    static_assert((sizeof(SeVkGraphCommandBind) % alignof(SeBinding)) == 0);
+    return (const SeBinding*)(command + 1);
+}
+
+inline const void* se_vk_graph_command_push_constants_data(const SeVkGraphCommandPushConstants* command)
+{
+    return command + 1;
+}
+
+//
+// Calls fn for every command of the range
+//
+template<typename Fn>
+void se_vk_command_stream_for_each(const SeVkCommandStream* stream, const SeVkCommandStreamRange& range, const Fn& fn)
+{
+    if (!range.numCommands) return;
+    const SeVkGraphCommand* command = se_vk_command_stream_at(stream, range.begin);
+    for (size_t it = 0; it < range.numCommands; it++)
+    {
+        fn(command);
+        command = se_vk_graph_command_next(command);
+    }
+}
+
+#endif
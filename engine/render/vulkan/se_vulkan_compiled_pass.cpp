@@ -0,0 +1,282 @@
+
+#include "se_vulkan_compiled_pass.hpp"
+#include "se_vulkan_device.hpp"
+#include "se_vulkan_frame_manager.hpp"
+#include "se_vulkan_pipeline_compiler.hpp"
+
+size_t g_compiledPassIndex = 0;
+
+bool se_vk_compiled_pass_is_swap_chain_pass(const SeVkCompiledPass* pass)
+{
+    if (pass->type != SeVkCompiledPass::GRAPHICS) return false;
+    for (size_t it = 0; it < pass->renderPassInfo.numColorAttachments; it++)
+        if (pass->graphicsPassInfo.renderTargets[it].texture.isSwapChain) return true;
+    return false;
+}
+
+SeVkPipeline* se_vk_compiled_pass_create_pipeline(SeVkCompiledPass* pass, const SeProgramWithConstants& program, bool isAsync)
+{
+    SeVkDevice* const device = pass->device;
+    SeVkPipelineCompiler* const compiler = &device->pipelineCompiler;
+    SeObjectPool<SeVkPipeline>& pipelinePool = se_vk_memory_manager_get_pool<SeVkPipeline>(&device->memoryManager);
+    SeVkPipeline* const pipeline = se_object_pool_take(pipelinePool);
+    const uint64_t compileBegin = _se_get_perf_counter();
+    if (pass->type == SeVkCompiledPass::GRAPHICS)
+    {
+        SeVkGraphicsPipelineInfo info = se_vk_graph_get_graphics_pipeline_info(&device->graph, pass->graphicsPassInfo, program, pass->renderPass);
+        se_vk_pipeline_graphics_construct(pipeline, &info);
+        if (isAsync)    se_vk_pipeline_compiler_submit_graphics(compiler, pipeline, &info);
+        else            se_vk_pipeline_graphics_compile(pipeline, &info);
+    }
+    else
+    {
+        SeVkComputePipelineInfo info
+        {
+            .device     = device,
+            .program    = se_vk_graph_program_with_constants(program),
+        };
+        se_vk_pipeline_compute_construct(pipeline, &info);
+        if (isAsync)    se_vk_pipeline_compiler_submit_compute(compiler, pipeline, &info);
+        else            se_vk_pipeline_compute_compile(pipeline, &info);
+    }
+    if (!isAsync) se_vk_pipeline_compiler_add_stall(compiler, compileBegin, _se_get_perf_counter());
+    return pipeline;
+}
+
+void se_vk_compiled_pass_build_render_pass(SeVkCompiledPass* pass)
+{
+    SeObjectPool<SeVkRenderPass>& renderPassPool = se_vk_memory_manager_get_pool<SeVkRenderPass>(&pass->device->memoryManager);
+    se_assert_msg(!pass->graphicsPassInfo.inputAttachments[0], "Input attachments aren't supported by compiled passes");
+    pass->renderPassInfo = se_vk_graph_get_render_pass_info(&pass->device->graph, pass->graphicsPassInfo);
+    pass->renderPass = se_object_pool_take(renderPassPool);
+    se_vk_render_pass_construct(pass->renderPass, &pass->renderPassInfo);
+}
+
+void se_vk_compiled_pass_build_framebuffers(SeVkCompiledPass* pass)
+{
+    SeVkDevice* const device = pass->device;
+    SeObjectPool<SeVkRenderPass>& renderPassPool = se_vk_memory_manager_get_pool<SeVkRenderPass>(&device->memoryManager);
+    SeObjectPool<SeVkFramebuffer>& framebufferPool = se_vk_memory_manager_get_pool<SeVkFramebuffer>(&device->memoryManager);
+    const SeVkRenderPassInfo& renderPassInfo = pass->renderPassInfo;
+    const bool isSwapChainPass = se_vk_compiled_pass_is_swap_chain_pass(pass);
+    pass->numFramebuffers = isSwapChainPass ? device->swapChain.numTextures : 1;
+    pass->swapChain = isSwapChainPass ? se_vk_device_get_swap_chain_handle(device) : VK_NULL_HANDLE;
+    for (size_t framebufferIt = 0; framebufferIt < pass->numFramebuffers; framebufferIt++)
+    {
+        SeVkFramebufferInfo info
+        {
+            .device         = device,
+            .pass           = se_object_pool_to_ref(renderPassPool, pass->renderPass),
+            .textures       = { },
+            .numTextures    = renderPassInfo.numColorAttachments + (renderPassInfo.hasDepthStencilAttachment ? 1 : 0),
+            .textureIds     = { },
+        };
+        for (size_t textureIt = 0; textureIt < renderPassInfo.numColorAttachments; textureIt++)
+        {
+            const SeTextureRef textureRef = pass->graphicsPassInfo.renderTargets[textureIt].texture;
+            if (textureRef.isSwapChain)
+                info.textures[textureIt] = se_vk_device_get_swap_chain_texture(device, framebufferIt);
+            else
+                info.textures[textureIt] = se_vk_to_pool_ref(textureRef);
+        }
+        if (renderPassInfo.hasDepthStencilAttachment)
+            info.textures[info.numTextures - 1] = se_vk_to_pool_ref(pass->graphicsPassInfo.depthStencilTarget.texture);
+        for (size_t textureIt = 0; textureIt < info.numTextures; textureIt++)
+        {
+            const SeVkTexture* const texture = *info.textures[textureIt];
+            se_assert_msg(!(texture->flags & SE_VK_TEXTURE_TRANSIENT), "Transient textures can't be render targets of compiled passes");
+            info.textureIds[textureIt] = texture->object.uniqueIndex;
+        }
+        pass->framebuffers[framebufferIt] = se_object_pool_take(framebufferPool);
+        se_vk_framebuffer_construct(pass->framebuffers[framebufferIt], &info);
+    }
+}
+
+void se_vk_compiled_pass_build_pipelines(SeVkCompiledPass* pass)
+{
+    if (pass->type == SeVkCompiledPass::GRAPHICS)
+    {
+        const SeGraphicsPassInfo& info = pass->graphicsPassInfo;
+        const bool isAsync = info.compilationPolicy != SePipelineCompilationPolicy::WAIT;
+        pass->pipeline = se_vk_compiled_pass_create_pipeline(pass, info.fragmentProgram, isAsync);
+        pass->fallbackPipeline = info.fallbackFragmentProgram.program
+            ? se_vk_compiled_pass_create_pipeline(pass, info.fallbackFragmentProgram, isAsync)
+            : nullptr;
+    }
+    else
+    {
+        const SeComputePassInfo& info = pass->computePassInfo;
+        pass->pipeline = se_vk_compiled_pass_create_pipeline(pass, info.program, info.compilationPolicy != SePipelineCompilationPolicy::WAIT);
+        pass->fallbackPipeline = nullptr;
+    }
+}
+
+void se_vk_compiled_pass_retire_render_pass(SeVkCompiledPass* pass)
+{
+    se_vk_device_submit_object_to_graveyard(pass->device, &pass->renderPass->object);
+    pass->renderPass = nullptr;
+}
+
+void se_vk_compiled_pass_retire_framebuffers(SeVkCompiledPass* pass)
+{
+    for (size_t it = 0; it < pass->numFramebuffers; it++)
+        se_vk_device_submit_object_to_graveyard(pass->device, &pass->framebuffers[it]->object);
+    pass->numFramebuffers = 0;
+    pass->swapChain = VK_NULL_HANDLE;
+}
+
+void se_vk_compiled_pass_retire_pipelines(SeVkCompiledPass* pass)
+{
+    se_vk_device_submit_object_to_graveyard(pass->device, &pass->pipeline->object);
+    if (pass->fallbackPipeline) se_vk_device_submit_object_to_graveyard(pass->device, &pass->fallbackPipeline->object);
+    pass->pipeline = nullptr;
+    pass->fallbackPipeline = nullptr;
+}
+
+void se_vk_compiled_pass_construct(SeVkCompiledPass* pass, const SeVkCompiledPassInfo* info)
+{
+    se_assert((info->graphics != nullptr) != (info->compute != nullptr));
+    *pass =
+    {
+        .object           = { SeVkObject::Type::COMPILED_PASS, 0, g_compiledPassIndex++ },
+        .device           = info->device,
+        .type             = info->graphics ? SeVkCompiledPass::GRAPHICS : SeVkCompiledPass::COMPUTE,
+        .graphicsPassInfo = { },
+        .renderPassInfo   = { },
+        .renderPass       = nullptr,
+        .framebuffers     = { },
+        .numFramebuffers  = 0,
+        .swapChain        = VK_NULL_HANDLE,
+        .pipeline         = nullptr,
+        .fallbackPipeline = nullptr,
+    };
+    if (pass->type == SeVkCompiledPass::GRAPHICS)
+    {
+        pass->graphicsPassInfo = *info->graphics;
+        se_vk_compiled_pass_build_render_pass(pass);
+        se_vk_compiled_pass_build_framebuffers(pass);
+    }
+    else
+    {
+        pass->computePassInfo = *info->compute;
+    }
+    se_vk_compiled_pass_build_pipelines(pass);
+}
+
+void se_vk_compiled_pass_destroy(SeVkCompiledPass* pass)
+{
+    SeVkMemoryManager* const memoryManager = &pass->device->memoryManager;
+    SeObjectPool<SeVkPipeline>& pipelinePool = se_vk_memory_manager_get_pool<SeVkPipeline>(memoryManager);
+    se_vk_pipeline_destroy(pass->pipeline);
+    se_object_pool_release(pipelinePool, pass->pipeline);
+    if (pass->fallbackPipeline)
+    {
+        se_vk_pipeline_destroy(pass->fallbackPipeline);
+        se_object_pool_release(pipelinePool, pass->fallbackPipeline);
+    }
+    SeObjectPool<SeVkFramebuffer>& framebufferPool = se_vk_memory_manager_get_pool<SeVkFramebuffer>(memoryManager);
+    for (size_t it = 0; it < pass->numFramebuffers; it++)
+    {
+        se_vk_framebuffer_destroy(pass->framebuffers[it]);
+        se_object_pool_release(framebufferPool, pass->framebuffers[it]);
+    }
+    if (pass->renderPass)
+    {
+        se_vk_render_pass_destroy(pass->renderPass);
+        se_object_pool_release(se_vk_memory_manager_get_pool<SeVkRenderPass>(memoryManager), pass->renderPass);
+    }
+}
+
+void se_vk_compiled_pass_update_graphics(SeVkCompiledPass* pass, const SeGraphicsPassInfo& info)
+{
+    se_assert(pass->type == SeVkCompiledPass::GRAPHICS);
+
+    const SeGraphicsPassInfo prevInfo = pass->graphicsPassInfo;
+    pass->graphicsPassInfo = info;
+
+    const SeVkRenderPassInfo renderPassInfo = se_vk_graph_get_render_pass_info(&pass->device->graph, info);
+    const bool isRenderPassChanged = !se_compare(renderPassInfo, pass->renderPassInfo);
+    const bool areTargetsChanged =
+        !se_compare(prevInfo.renderTargets, info.renderTargets) ||
+        !se_compare(prevInfo.depthStencilTarget, info.depthStencilTarget);
+    const bool arePipelinesChanged =
+        !se_compare(prevInfo.vertexProgram, info.vertexProgram) ||
+        !se_compare(prevInfo.fragmentProgram, info.fragmentProgram) ||
+        !se_compare(prevInfo.fallbackFragmentProgram, info.fallbackFragmentProgram) ||
+        !se_compare(prevInfo.frontStencilOpState, info.frontStencilOpState) ||
+        !se_compare(prevInfo.backStencilOpState, info.backStencilOpState) ||
+        !se_compare(prevInfo.depthState, info.depthState) ||
+        prevInfo.polygonMode != info.polygonMode ||
+        prevInfo.cullMode != info.cullMode ||
+        prevInfo.frontFace != info.frontFace ||
+        prevInfo.samplingType != info.samplingType ||
+        prevInfo.compilationPolicy != info.compilationPolicy;
+
+    if (isRenderPassChanged)
+    {
+        se_vk_compiled_pass_retire_pipelines(pass);
+        se_vk_compiled_pass_retire_framebuffers(pass);
+        se_vk_compiled_pass_retire_render_pass(pass);
+        se_vk_compiled_pass_build_render_pass(pass);
+        se_vk_compiled_pass_build_framebuffers(pass);
+        se_vk_compiled_pass_build_pipelines(pass);
+        return;
+    }
+    if (areTargetsChanged)
+    {
+        se_vk_compiled_pass_retire_framebuffers(pass);
+        se_vk_compiled_pass_build_framebuffers(pass);
+    }
+    if (arePipelinesChanged)
+    {
+        se_vk_compiled_pass_retire_pipelines(pass);
+        se_vk_compiled_pass_build_pipelines(pass);
+    }
+}
+
+void se_vk_compiled_pass_update_compute(SeVkCompiledPass* pass, const SeComputePassInfo& info)
+{
+    se_assert(pass->type == SeVkCompiledPass::COMPUTE);
+
+    const SeComputePassInfo prevInfo = pass->computePassInfo;
+    pass->computePassInfo = info;
+    if (!se_compare(prevInfo.program, info.program) || prevInfo.compilationPolicy != info.compilationPolicy)
+    {
+        se_vk_compiled_pass_retire_pipelines(pass);
+        se_vk_compiled_pass_build_pipelines(pass);
+    }
+}
+
+void se_vk_compiled_pass_revalidate(SeVkCompiledPass* pass)
+{
+    if (!pass->swapChain) return;
+    SeVkDevice* const device = pass->device;
+    const bool isSwapChainChanged =
+        pass->swapChain != se_vk_device_get_swap_chain_handle(device) ||
+        pass->numFramebuffers != device->swapChain.numTextures ||
+        !se_compare(pass->framebuffers[0]->extent, se_vk_device_get_swap_chain_extent(device));
+    if (!isSwapChainChanged) return;
+    //
+    // Swap chain was recreated. Render pass must be rebuilt only if swap chain format was changed
+    //
+    const SeVkRenderPassInfo renderPassInfo = se_vk_graph_get_render_pass_info(&device->graph, pass->graphicsPassInfo);
+    if (!se_compare(renderPassInfo, pass->renderPassInfo))
+    {
+        se_vk_compiled_pass_retire_pipelines(pass);
+        se_vk_compiled_pass_retire_framebuffers(pass);
+        se_vk_compiled_pass_retire_render_pass(pass);
+        se_vk_compiled_pass_build_render_pass(pass);
+        se_vk_compiled_pass_build_framebuffers(pass);
+        se_vk_compiled_pass_build_pipelines(pass);
+    }
+    else
+    {
+        se_vk_compiled_pass_retire_framebuffers(pass);
+        se_vk_compiled_pass_build_framebuffers(pass);
+    }
+}
+
+inline SeVkFramebuffer* se_vk_compiled_pass_get_framebuffer(SeVkCompiledPass* pass, uint32_t swapChainTextureIndex)
+{
+    return pass->framebuffers[pass->swapChain ? swapChainTextureIndex : 0];
+}
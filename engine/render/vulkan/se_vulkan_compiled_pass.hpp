@@ -0,0 +1,61 @@
+#ifndef _SE_VULKAN_COMPILED_PASS_H_
+#define _SE_VULKAN_COMPILED_PASS_H_
+
+#include "se_vulkan_base.hpp"
+#include "se_vulkan_render_pass.hpp"
+#include "se_vulkan_framebuffer.hpp"
+#include "se_vulkan_pipeline.hpp"
+#include "se_vulkan_graph.hpp"
+
+//
+// Compiled pass is a persistent pass description with already resolved vulkan objects.
+//
+// Regular passes build render pass, framebuffer and pipeline infos every frame and look them up in the graph caches.
+// Compiled pass does this once (at creation) and owns the resulting objects, so beginning compiled pass costs
+// just a copy of the pass info. Objects are rebuilt only when something actually changes :
+// - se_vk_compiled_pass_update compares new pass info with the current one and rebuilds only affected objects
+// - swap chain recreation is detected in se_vk_compiled_pass_revalidate (called on every begin)
+// Replaced objects are submitted to the device graveyard, because they still can be used by frames in flight.
+//
+
+struct SeVkCompiledPass
+{
+    SeVkObject                      object;
+    SeVkDevice*                     device;
+    enum { GRAPHICS, COMPUTE }      type;
+    union
+    {
+        SeGraphicsPassInfo          graphicsPassInfo;
+        SeComputePassInfo           computePassInfo;
+    };
+    SeVkRenderPassInfo              renderPassInfo;
+    SeVkRenderPass*                 renderPass;
+    SeVkFramebuffer*                framebuffers[SeVkConfig::MAX_SWAP_CHAIN_IMAGES]; // One per swap chain image if pass renders to swap chain
+    size_t                          numFramebuffers;
+    VkSwapchainKHR                  swapChain;      // Swap chain framebuffers were created for (or VK_NULL_HANDLE)
+    SeVkPipeline*                   pipeline;
+    SeVkPipeline*                   fallbackPipeline;
+};
+
+struct SeVkCompiledPassInfo
+{
+    SeVkDevice*                 device;
+    const SeGraphicsPassInfo*   graphics;   // Either graphics or compute info must be set
+    const SeComputePassInfo*    compute;
+};
+
+void                se_vk_compiled_pass_construct(SeVkCompiledPass* pass, const SeVkCompiledPassInfo* info);
+void                se_vk_compiled_pass_destroy(SeVkCompiledPass* pass);
+void                se_vk_compiled_pass_update_graphics(SeVkCompiledPass* pass, const SeGraphicsPassInfo& info);
+void                se_vk_compiled_pass_update_compute(SeVkCompiledPass* pass, const SeComputePassInfo& info);
+void                se_vk_compiled_pass_revalidate(SeVkCompiledPass* pass);
+
+SeVkFramebuffer*    se_vk_compiled_pass_get_framebuffer(SeVkCompiledPass* pass, uint32_t swapChainTextureIndex);
+
+template<>
+void se_vk_destroy<SeVkCompiledPass>(SeVkCompiledPass* res)
+{
+    se_vk_compiled_pass_destroy(res);
+}
+
+#endif
@@ -0,0 +1,188 @@
+
+#include "se_vulkan_descriptor_set.hpp"
+#include "se_vulkan_device.hpp"
+#include "se_vulkan_memory.hpp"
+
+static_assert(SeVkConfig::DESCRIPTOR_SET_CACHE_LIFETIME >= SeVkConfig::NUM_FRAMES_IN_FLIGHT, "Cached descriptor sets can't be freed while frames in flight use them");
+static_assert(sizeof(SeVkDescriptorSetKey) == sizeof(uint32_t) * 2 + sizeof(SeVkDescriptorBindingKey) * SE_MAX_BINDINGS, "Descriptor set key must not have padding");
+
+inline bool se_vk_descriptor_set_is_dynamic_type(VkDescriptorType type)
+{
+    return type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC || type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+}
+
+void se_vk_descriptor_set_cache_construct(SeVkDescriptorSetCache* cache, SeVkDevice* device)
+{
+    const SeAllocatorBindings persistentAllocator = se_allocator_persistent();
+    *cache =
+    {
+        .device             = device,
+        .sets               = { },
+        .uncachedSets       = { },
+        .pools              = { },
+        .lastEvictionFrame  = 0,
+    };
+    se_hash_table_construct(cache->sets, persistentAllocator);
+    se_dynamic_array_construct(cache->uncachedSets, persistentAllocator);
+    se_dynamic_array_construct(cache->pools, persistentAllocator);
+}
+
+void se_vk_descriptor_set_cache_destroy(SeVkDescriptorSetCache* cache)
+{
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(cache->device);
+    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&cache->device->memoryManager);
+    // @NOTE : destroying the pool frees all of its sets
+    for (auto it : cache->pools) vkDestroyDescriptorPool(logicalHandle, se_iterator_value(it).handle, callbacks);
+    se_hash_table_destroy(cache->sets);
+    se_dynamic_array_destroy(cache->uncachedSets);
+    se_dynamic_array_destroy(cache->pools);
+}
+
+void se_vk_descriptor_set_cache_free(SeVkDescriptorSetCache* cache, const SeVkDescriptorSetCacheEntry& entry)
+{
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(cache->device);
+    SeVkDescriptorSetCachePool& pool = cache->pools[entry.pool];
+    se_vk_check(vkFreeDescriptorSets(logicalHandle, pool.handle, 1, &entry.handle));
+    se_assert(pool.numAllocatedSets);
+    pool.numAllocatedSets -= 1;
+}
+
+//
+// Frees sets that weren't used for DESCRIPTOR_SET_CACHE_LIFETIME frames. Frames older than NUM_FRAMES_IN_FLIGHT
+// are already finished by gpu (see se_vk_frame_manager_advance), so these sets can't be in use
+//
+void se_vk_descriptor_set_cache_evict(SeVkDescriptorSetCache* cache, size_t currentFrame, SeVkDescriptorSetCacheStats* stats)
+{
+    for (auto kv : cache->sets)
+    {
+        const SeVkDescriptorSetCacheEntry& entry = se_iterator_value(kv);
+        if ((currentFrame - entry.lastFrame) <= SeVkConfig::DESCRIPTOR_SET_CACHE_LIFETIME) continue;
+        se_vk_descriptor_set_cache_free(cache, entry);
+        se_iterator_remove(kv);
+        stats->numFreedSets += 1;
+    }
+    for (auto it : cache->uncachedSets)
+    {
+        const SeVkDescriptorSetCacheEntry& entry = se_iterator_value(it);
+        if ((currentFrame - entry.lastFrame) <= SeVkConfig::DESCRIPTOR_SET_CACHE_LIFETIME) continue;
+        se_vk_descriptor_set_cache_free(cache, entry);
+        se_iterator_remove(it);
+        stats->numFreedSets += 1;
+    }
+    cache->lastEvictionFrame = currentFrame;
+}
+
+SeVkDescriptorSetCacheEntry se_vk_descriptor_set_cache_allocate(SeVkDescriptorSetCache* cache, const SeVkDescriptorSetLayout* layout, uint32_t set, size_t currentFrame)
+{
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(cache->device);
+    VkDescriptorSetAllocateInfo allocateInfo
+    {
+        .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext              = nullptr,
+        .descriptorPool     = VK_NULL_HANDLE,
+        .descriptorSetCount = 1,
+        .pSetLayouts        = &layout->handle,
+    };
+    SeVkDescriptorSetCacheEntry entry
+    {
+        .handle     = VK_NULL_HANDLE,
+        .pool       = 0,
+        .lastFrame  = currentFrame,
+    };
+    const size_t numPools = se_dynamic_array_size(cache->pools);
+    for (size_t it = 0; it < numPools; it++)
+    {
+        SeVkDescriptorSetCachePool& pool = cache->pools[it];
+        if (pool.set != set || pool.numAllocatedSets == layout->poolCreateInfo.maxSets) continue;
+        allocateInfo.descriptorPool = pool.handle;
+        // @NOTE : no se_vk_check here, because allocation can fail if pool is fragmented
+        if (vkAllocateDescriptorSets(logicalHandle, &allocateInfo, &entry.handle) != VK_SUCCESS) continue;
+        pool.numAllocatedSets += 1;
+        entry.pool = it;
+        return entry;
+    }
+    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&cache->device->memoryManager);
+    SeVkDescriptorSetCachePool newPool
+    {
+        .handle             = VK_NULL_HANDLE,
+        .set                = set,
+        .numAllocatedSets   = 1,
+    };
+    se_vk_check(vkCreateDescriptorPool(logicalHandle, &layout->poolCreateInfo, callbacks, &newPool.handle));
+    allocateInfo.descriptorPool = newPool.handle;
+    se_vk_check(vkAllocateDescriptorSets(logicalHandle, &allocateInfo, &entry.handle));
+    se_dynamic_array_push(cache->pools, newPool);
+    entry.pool = numPools;
+    return entry;
+}
+
+void se_vk_descriptor_set_cache_write(SeVkDescriptorSetCache* cache, const SeVkDescriptorSetLayout* layout, const SeVkDescriptorSetWrite* write, VkDescriptorSet descriptorSet, SeVkDescriptorSetCacheStats* stats)
+{
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(cache->device);
+    const SeVkDescriptorSetKey& key = write->key;
+    //
+    // Update template writes all bindings of the layout, so it can be used only if bind command covers all of them
+    //
+    SeVkGeneralBitmask writtenBindings = 0;
+    for (uint32_t it = 0; it < key.numBindings; it++) writtenBindings |= SeVkGeneralBitmask(1) << key.bindings[it].binding;
+    const SeVkGeneralBitmask allBindings = SeVkGeneralBitmask((uint64_t(1) << layout->numBindings) - 1);
+    if (writtenBindings == allBindings && key.numBindings == layout->numBindings)
+    {
+        SeVkDescriptorInfo templateData[SE_MAX_BINDINGS];
+        for (uint32_t it = 0; it < key.numBindings; it++) templateData[key.bindings[it].binding] = write->infos[it];
+        vkUpdateDescriptorSetWithTemplate(logicalHandle, descriptorSet, layout->updateTemplate, templateData);
+        stats->numTemplateWrites += 1;
+        return;
+    }
+    VkWriteDescriptorSet writes[SE_MAX_BINDINGS];
+    for (uint32_t it = 0; it < key.numBindings; it++)
+    {
+        const VkDescriptorType descriptorType = layout->bindingInfos[key.bindings[it].binding].descriptorType;
+        const bool isImage =
+            descriptorType == VK_DESCRIPTOR_TYPE_SAMPLER ||
+            descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER ||
+            descriptorType == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE ||
+            descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE ||
+            descriptorType == VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+        writes[it] =
+        {
+            .sType              = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .pNext              = nullptr,
+            .dstSet             = descriptorSet,
+            .dstBinding         = key.bindings[it].binding,
+            .dstArrayElement    = 0,
+            .descriptorCount    = 1,
+            .descriptorType     = descriptorType,
+            .pImageInfo         = isImage ? &write->infos[it].image : nullptr,
+            .pBufferInfo        = isImage ? nullptr : &write->infos[it].buffer,
+            .pTexelBufferView   = nullptr,
+        };
+    }
+    vkUpdateDescriptorSets(logicalHandle, key.numBindings, writes, 0, nullptr);
+    stats->numFallbackWrites += 1;
+}
+
+VkDescriptorSet se_vk_descriptor_set_cache_get(SeVkDescriptorSetCache* cache, const SeVkDescriptorSetLayout* layout, const SeVkDescriptorSetWrite* write, size_t currentFrame, bool isCachingEnabled, SeVkDescriptorSetCacheStats* stats)
+{
+    se_assert(write->key.numBindings && write->key.numBindings <= SE_MAX_BINDINGS);
+    if ((currentFrame - cache->lastEvictionFrame) >= SeVkConfig::DESCRIPTOR_SET_CACHE_LIFETIME)
+    {
+        se_vk_descriptor_set_cache_evict(cache, currentFrame, stats);
+    }
+    stats->numRequests += 1;
+    if (isCachingEnabled)
+    {
+        if (SeVkDescriptorSetCacheEntry* const entry = se_hash_table_get(cache->sets, write->key))
+        {
+            entry->lastFrame = currentFrame;
+            stats->numHits += 1;
+            return entry->handle;
+        }
+    }
+    const SeVkDescriptorSetCacheEntry entry = se_vk_descriptor_set_cache_allocate(cache, layout, write->key.set, currentFrame);
+    se_vk_descriptor_set_cache_write(cache, layout, write, entry.handle, stats);
+    stats->numAllocations += 1;
+    if (isCachingEnabled)   se_hash_table_set(cache->sets, write->key, entry);
+    else                    se_dynamic_array_push(cache->uncachedSets, entry);
+    return entry.handle;
+}
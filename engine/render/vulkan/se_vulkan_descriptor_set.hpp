@@ -0,0 +1,110 @@
+#ifndef _SE_VULKAN_DESCRIPTOR_SET_H_
+#define _SE_VULKAN_DESCRIPTOR_SET_H_
+
+#include "se_vulkan_base.hpp"
+
+struct SeVkDescriptorSetBindingInfo
+{
+    VkDescriptorType descriptorType;
+};
+
+struct SeVkDescriptorSetLayout
+{
+    SeVkDescriptorSetBindingInfo    bindingInfos[SE_VK_GENERAL_BITMASK_WIDTH];
+    VkDescriptorPoolSize            poolSizes[SE_VK_GENERAL_BITMASK_WIDTH];
+    size_t                          numPoolSizes;
+    size_t                          numBindings;
+    VkDescriptorPoolCreateInfo      poolCreateInfo;
+    VkDescriptorSetLayout           handle;
+    VkDescriptorUpdateTemplate      updateTemplate; // Writes one descriptor to each binding, data is an array of SeVkDescriptorInfo indexed by binding
+};
+
+//
+// Descriptor set cache of a single pipeline.
+//
+// Descriptor sets are looked up by their contents : set index and every written descriptor. Resources are identified
+// by SeVkObject::uniqueIndex, which is never reused, so a set can't be returned for a destroyed resource or for
+// a new resource that happened to get the same vulkan handles. Image descriptors also include the image layout and
+// buffer descriptors include range. Offset is a part of the key only for non-dynamic buffer bindings, dynamic offsets
+// are provided when the set is bound, so such bindings hit the cache regardless of where they land in the buffer.
+//
+// Cached sets are never written again. Sets that weren't used for SeVkConfig::DESCRIPTOR_SET_CACHE_LIFETIME frames are
+// freed, which is also how sets referencing destroyed resources go away. Cache is owned by the pipeline, so all
+// of its sets are destroyed together with the pipeline (pipelines are destroyed only when gpu doesn't use them anymore).
+//
+// New sets are written with the layout's update template if bind command writes all bindings of the layout,
+// otherwise vkUpdateDescriptorSets is used.
+//
+
+union SeVkDescriptorInfo
+{
+    VkDescriptorImageInfo   image;
+    VkDescriptorBufferInfo  buffer;
+};
+
+struct SeVkDescriptorBindingKey
+{
+    uint32_t        binding;
+    VkImageLayout   imageLayout;
+    uint64_t        resources[2];   // Unique indices of texture and sampler, or of buffer
+    VkDeviceSize    offset;
+    VkDeviceSize    range;
+};
+
+// @NOTE : key is hashed and compared as raw memory, so it must not have any padding
+struct SeVkDescriptorSetKey
+{
+    uint32_t                    set;
+    uint32_t                    numBindings;
+    SeVkDescriptorBindingKey    bindings[SE_MAX_BINDINGS]; // In bind command order
+};
+
+struct SeVkDescriptorSetWrite
+{
+    SeVkDescriptorSetKey        key;
+    SeVkDescriptorInfo          infos[SE_MAX_BINDINGS];
+};
+
+struct SeVkDescriptorSetCacheEntry
+{
+    VkDescriptorSet handle;
+    size_t          pool;       // Index in SeVkDescriptorSetCache::pools
+    size_t          lastFrame;
+};
+
+struct SeVkDescriptorSetCachePool
+{
+    VkDescriptorPool    handle;
+    uint32_t            set;
+    uint32_t            numAllocatedSets;
+};
+
+struct SeVkDescriptorSetCacheStats
+{
+    size_t numRequests;
+    size_t numHits;
+    size_t numAllocations;
+    size_t numTemplateWrites;
+    size_t numFallbackWrites;
+    size_t numFreedSets;
+};
+
+struct SeVkDescriptorSetCache
+{
+    SeVkDevice*                                                     device;
+    SeHashTable<SeVkDescriptorSetKey, SeVkDescriptorSetCacheEntry>  sets;
+    SeDynamicArray<SeVkDescriptorSetCacheEntry>                     uncachedSets;   // Sets allocated while caching is disabled, freed after lifetime too
+    SeDynamicArray<SeVkDescriptorSetCachePool>                      pools;
+    size_t                                                          lastEvictionFrame;
+};
+
+bool            se_vk_descriptor_set_is_dynamic_type(VkDescriptorType type);
+
+void            se_vk_descriptor_set_cache_construct(SeVkDescriptorSetCache* cache, SeVkDevice* device);
+void            se_vk_descriptor_set_cache_destroy(SeVkDescriptorSetCache* cache);
+
+// Returns cached set with the given contents or allocates and writes a new one. If caching is disabled every call
+// allocates and writes a new set (used to measure the cache)
+VkDescriptorSet se_vk_descriptor_set_cache_get(SeVkDescriptorSetCache* cache, const SeVkDescriptorSetLayout* layout, const SeVkDescriptorSetWrite* write, size_t currentFrame, bool isCachingEnabled, SeVkDescriptorSetCacheStats* stats);
+
+#endif
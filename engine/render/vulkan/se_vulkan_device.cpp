@@ -9,6 +9,9 @@ size_t g_deviceIndex = 0;
 void se_vk_gpu_fill_required_physical_deivce_features(VkPhysicalDeviceFeatures* features)
 {
     features->samplerAnisotropy = VK_TRUE;
+    features->textureCompressionBC = VK_TRUE;
+    features->multiDrawIndirect = VK_TRUE;
+    features->drawIndirectFirstInstance = VK_TRUE;
 }
 
 float se_vk_gpu_get_device_rating(VkPhysicalDevice device, VkSurfaceKHR surface, const SeAllocatorBindings& bindings, VkPhysicalDeviceFeatures* featuresToEnable)
@@ -46,6 +49,25 @@ float se_vk_gpu_get_device_rating(VkPhysicalDevice device, VkSurfaceKHR surface,
         return SE_VK_INVALID_DEVICE_RATING;
     }
     //
+    // Check timeline semaphore support (frame submissions and uploads are synchronized with timeline semaphores)
+    //
+    VkPhysicalDeviceVulkan12Features features_12
+    {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+        .pNext = nullptr,
+    };
+    VkPhysicalDeviceFeatures2 features2
+    {
+        .sType      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .pNext      = &features_12,
+        .features   = { },
+    };
+    vkGetPhysicalDeviceFeatures2(device, &features2);
+    if (!features_12.timelineSemaphore)
+    {
+        return SE_VK_INVALID_DEVICE_RATING;
+    }
+    //
     // Get device feature rating
     //
     VkPhysicalDeviceFeatures requiredFeatures = { };
@@ -114,6 +136,103 @@ VkPhysicalDevice se_vk_gpu_pick_physical_device(VkInstance instance, VkSurfaceKH
     return device;
 }
 
+//
+// Bindless heap is optional. It needs descriptor indexing features, enough bound sets to put the heap at SE_BINDLESS_SET
+// and update-after-bind limits that fit SeVkConfig::BINDLESS_MAX_* arrays
+//
+bool se_vk_gpu_is_bindless_supported(VkPhysicalDevice device)
+{
+    VkPhysicalDeviceVulkan12Features features_12
+    {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+        .pNext = nullptr,
+    };
+    VkPhysicalDeviceFeatures2 features2
+    {
+        .sType      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .pNext      = &features_12,
+        .features   = { },
+    };
+    vkGetPhysicalDeviceFeatures2(device, &features2);
+    const bool hasFeatures =
+        features_12.descriptorIndexing                              &&
+        features_12.runtimeDescriptorArray                          &&
+        features_12.descriptorBindingPartiallyBound                 &&
+        features_12.descriptorBindingUpdateUnusedWhilePending       &&
+        features_12.descriptorBindingStorageBufferUpdateAfterBind   &&
+        features_12.descriptorBindingSampledImageUpdateAfterBind    &&
+        features_12.shaderStorageBufferArrayNonUniformIndexing      &&
+        features_12.shaderSampledImageArrayNonUniformIndexing;
+    if (!hasFeatures)
+    {
+        return false;
+    }
+    VkPhysicalDeviceVulkan12Properties properties_12
+    {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES,
+        .pNext = nullptr,
+    };
+    VkPhysicalDeviceProperties2 properties2
+    {
+        .sType      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+        .pNext      = &properties_12,
+        .properties = { },
+    };
+    vkGetPhysicalDeviceProperties2(device, &properties2);
+    const uint32_t numHeapResources = SeVkConfig::BINDLESS_MAX_BUFFERS + SeVkConfig::BINDLESS_MAX_TEXTURES + SeVkConfig::BINDLESS_MAX_SAMPLERS;
+    return
+        properties2.properties.limits.maxBoundDescriptorSets                >  SE_BINDLESS_SET                      &&
+        properties_12.maxDescriptorSetUpdateAfterBindStorageBuffers         >= SeVkConfig::BINDLESS_MAX_BUFFERS     &&
+        properties_12.maxDescriptorSetUpdateAfterBindSampledImages          >= SeVkConfig::BINDLESS_MAX_TEXTURES    &&
+        properties_12.maxDescriptorSetUpdateAfterBindSamplers               >= SeVkConfig::BINDLESS_MAX_SAMPLERS    &&
+        properties_12.maxPerStageDescriptorUpdateAfterBindStorageBuffers    >= SeVkConfig::BINDLESS_MAX_BUFFERS     &&
+        properties_12.maxPerStageDescriptorUpdateAfterBindSampledImages     >= SeVkConfig::BINDLESS_MAX_TEXTURES    &&
+        properties_12.maxPerStageDescriptorUpdateAfterBindSamplers          >= SeVkConfig::BINDLESS_MAX_SAMPLERS    &&
+        properties_12.maxPerStageUpdateAfterBindResources                   >= numHeapResources;
+}
+
+bool se_vk_gpu_is_draw_indirect_count_supported(VkPhysicalDevice device)
+{
+    VkPhysicalDeviceVulkan12Features features_12
+    {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+        .pNext = nullptr,
+    };
+    VkPhysicalDeviceFeatures2 features2
+    {
+        .sType      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .pNext      = &features_12,
+        .features   = { },
+    };
+    vkGetPhysicalDeviceFeatures2(device, &features2);
+    return features_12.drawIndirectCount;
+}
+
+//
+// Dynamic rendering is core only in vulkan 1.3, so the extension is used
+//
+bool se_vk_gpu_is_dynamic_rendering_supported(VkPhysicalDevice device)
+{
+    const char* extensions[] = { VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME };
+    if (!se_vk_utils_does_physical_device_supports_required_extensions(device, extensions, se_array_size(extensions), se_allocator_frame()))
+    {
+        return false;
+    }
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures
+    {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR,
+        .pNext = nullptr,
+    };
+    VkPhysicalDeviceFeatures2 features2
+    {
+        .sType      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .pNext      = &dynamicRenderingFeatures,
+        .features   = { },
+    };
+    vkGetPhysicalDeviceFeatures2(device, &features2);
+    return dynamicRenderingFeatures.dynamicRendering;
+}
+
 void se_vk_device_swap_chain_create(SeVkDevice* device, uint32_t width, uint32_t height)
 {
     const SeAllocatorBindings frameAllocator = se_allocator_frame();
@@ -402,21 +521,63 @@ SeVkDevice* se_vk_device_create(const SeSettings& settings, void* nativeWindowHa
         const char** const requiredValidationLayers = se_vk_utils_get_required_validation_layers(&numValidationLayers);
         size_t numDeviceExtensions;
         const char** const requiredDeviceExtensions = se_vk_utils_get_required_device_extensions(&numDeviceExtensions);
+        const bool isBindlessSupported = se_vk_gpu_is_bindless_supported(device->gpu.physicalHandle);
+        if (isBindlessSupported) device->gpu.flags |= SE_VK_GPU_HAS_BINDLESS;
+        const bool isDrawIndirectCountSupported = se_vk_gpu_is_draw_indirect_count_supported(device->gpu.physicalHandle);
+        if (isDrawIndirectCountSupported) device->gpu.flags |= SE_VK_GPU_HAS_DRAW_INDIRECT_COUNT;
+        const bool isDynamicRenderingSupported = se_vk_gpu_is_dynamic_rendering_supported(device->gpu.physicalHandle);
+        if (isDynamicRenderingSupported) device->gpu.flags |= SE_VK_GPU_HAS_DYNAMIC_RENDERING;
+        const char* deviceExtensions[SeVkConfig::MAX_DEVICE_EXTENSIONS];
+        se_assert(numDeviceExtensions < SeVkConfig::MAX_DEVICE_EXTENSIONS);
+        memcpy(deviceExtensions, requiredDeviceExtensions, numDeviceExtensions * sizeof(const char*));
+        if (isDynamicRenderingSupported) deviceExtensions[numDeviceExtensions++] = VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME;
+        VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures
+        {
+            .sType              = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR,
+            .pNext              = nullptr,
+            .dynamicRendering   = VK_TRUE,
+        };
+        const VkPhysicalDeviceVulkan12Features features_12
+        {
+            .sType                                          = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+            .pNext                                          = isDynamicRenderingSupported ? &dynamicRenderingFeatures : nullptr,
+            .drawIndirectCount                              = isDrawIndirectCountSupported,
+            .descriptorIndexing                             = isBindlessSupported,
+            .shaderSampledImageArrayNonUniformIndexing      = isBindlessSupported,
+            .shaderStorageBufferArrayNonUniformIndexing     = isBindlessSupported,
+            .descriptorBindingSampledImageUpdateAfterBind   = isBindlessSupported,
+            .descriptorBindingStorageBufferUpdateAfterBind  = isBindlessSupported,
+            .descriptorBindingUpdateUnusedWhilePending      = isBindlessSupported,
+            .descriptorBindingPartiallyBound                = isBindlessSupported,
+            .runtimeDescriptorArray                         = isBindlessSupported,
+            .timelineSemaphore                              = VK_TRUE,
+        };
         const VkDeviceCreateInfo logicalDeviceCreateInfo =
         {
             .sType                      = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-            .pNext                      = nullptr,
+            .pNext                      = &features_12,
             .flags                      = 0,
             .queueCreateInfoCount       = (uint32_t)se_dynamic_array_size(queueCreateInfos),
             .pQueueCreateInfos          = se_dynamic_array_raw(queueCreateInfos),
             .enabledLayerCount          = (uint32_t)numValidationLayers,
             .ppEnabledLayerNames        = requiredValidationLayers,
             .enabledExtensionCount      = (uint32_t)numDeviceExtensions,
-            .ppEnabledExtensionNames    = requiredDeviceExtensions,
+            .ppEnabledExtensionNames    = deviceExtensions,
             .pEnabledFeatures           = &featuresToEnable
         };
         se_vk_check(vkCreateDevice(device->gpu.physicalHandle, &logicalDeviceCreateInfo, callbacks, &device->gpu.logicalHandle));
         //
+        // @NOTE :  bundled volk version doesn't know about VK_KHR_dynamic_rendering, so functions are loaded manually
+        //
+        device->gpu.cmdBeginRendering = nullptr;
+        device->gpu.cmdEndRendering = nullptr;
+        if (isDynamicRenderingSupported)
+        {
+            device->gpu.cmdBeginRendering = (PFN_vkCmdBeginRenderingKHR)vkGetDeviceProcAddr(device->gpu.logicalHandle, "vkCmdBeginRenderingKHR");
+            device->gpu.cmdEndRendering = (PFN_vkCmdEndRenderingKHR)vkGetDeviceProcAddr(device->gpu.logicalHandle, "vkCmdEndRenderingKHR");
+            se_assert(device->gpu.cmdBeginRendering && device->gpu.cmdEndRendering);
+        }
+        //
         // Create queues
         //
         for (auto it : queueCreateInfos)
@@ -431,6 +592,11 @@ SeVkDevice* se_vk_device_create(const SeSettings& settings, void* nativeWindowHa
             const VkCommandPoolCreateInfo poolCreateInfo = se_vk_utils_command_pool_create_info(queue->queueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
             se_vk_check(vkCreateCommandPool(device->gpu.logicalHandle, &poolCreateInfo, callbacks, &queue->commandPoolHandle));
         }
+        //
+        // @NOTE :  compute passes are recorded on the graphics queue when async compute isn't used, so graphics family must support compute
+        //
+        se_assert(familyProperties[queuesFamilyIndices[0]].queueFlags & VK_QUEUE_COMPUTE_BIT);
+        if (queuesFamilyIndices[3] != queuesFamilyIndices[0]) device->gpu.flags |= SE_VK_GPU_HAS_ASYNC_COMPUTE;
         se_dynamic_array_destroy(familyProperties);
         se_dynamic_array_destroy(queueCreateInfos);
         //
@@ -462,6 +628,10 @@ SeVkDevice* se_vk_device_create(const SeSettings& settings, void* nativeWindowHa
     }
     se_vk_memory_manager_set_device(&device->memoryManager, device);
     //
+    // Bindless heap (must be constructed before any resource)
+    //
+    se_vk_bindless_heap_construct(&device->bindlessHeap, device);
+    //
     // Swap chain
     //
     se_vk_device_swap_chain_create(device, se_win_get_width(), se_win_get_height());
@@ -476,6 +646,47 @@ SeVkDevice* se_vk_device_create(const SeSettings& settings, void* nativeWindowHa
         se_vk_frame_manager_construct(&device->frameManager, &frameManagerCreateInfo);
     }
     //
+    // Transfer manager
+    //
+    {
+        const SeVkTransferManagerInfo transferManagerInfo =
+        {
+            .device = device,
+        };
+        se_vk_transfer_manager_construct(&device->transferManager, &transferManagerInfo);
+    }
+    //
+    // Pipeline cache
+    //
+    {
+        const SeVkPipelineCacheInfo pipelineCacheInfo =
+        {
+            .device         = device,
+            .isPersistent   = settings.createUserDataFolder,
+        };
+        se_vk_pipeline_cache_construct(&device->pipelineCache, &pipelineCacheInfo);
+    }
+    //
+    // Pipeline compiler
+    //
+    {
+        const SeVkPipelineCompilerInfo pipelineCompilerInfo =
+        {
+            .device = device,
+        };
+        se_vk_pipeline_compiler_construct(&device->pipelineCompiler, &pipelineCompilerInfo);
+    }
+    //
+    // Command recorder
+    //
+    {
+        const SeVkCommandRecorderInfo commandRecorderInfo =
+        {
+            .device = device,
+        };
+        se_vk_command_recorder_construct(&device->commandRecorder, &commandRecorderInfo);
+    }
+    //
     // Graph
     //
     {
@@ -488,10 +699,10 @@ SeVkDevice* se_vk_device_create(const SeSettings& settings, void* nativeWindowHa
     //
     // Graveyard
     //
-    se_dynamic_array_construct(device->graveyard.programs, se_allocator_persistent());
-    se_dynamic_array_construct(device->graveyard.samplers, se_allocator_persistent());
-    se_dynamic_array_construct(device->graveyard.buffers, se_allocator_persistent());
-    se_dynamic_array_construct(device->graveyard.textures, se_allocator_persistent());
+    se_dynamic_array_construct(device->graveyard.objects, se_allocator_persistent());
+    se_dynamic_array_construct(device->graveyard.buckets, se_allocator_persistent());
+    device->graveyard.firstObject = 0;
+    device->graveyard.firstBucket = 0;
     return device;
 }
 
@@ -500,8 +711,13 @@ void se_vk_device_destroy(SeVkDevice* device)
     const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&device->memoryManager);
     vkDeviceWaitIdle(device->gpu.logicalHandle);
     //
-    // Destroy all resources
+    // Pipeline compiler (must be destroyed before pipelines)
+    //
+    se_vk_pipeline_compiler_destroy(&device->pipelineCompiler);
     //
+    // Destroy all resources (compiled passes go first, because they release objects they own)
+    //
+    for (auto it : se_vk_memory_manager_get_pool<SeVkCompiledPass>(&device->memoryManager))  se_vk_destroy(&se_iterator_value(it));
     for (auto it : se_vk_memory_manager_get_pool<SeVkSampler>(&device->memoryManager))       se_vk_destroy(&se_iterator_value(it));
     for (auto it : se_vk_memory_manager_get_pool<SeVkMemoryBuffer>(&device->memoryManager))  se_vk_destroy(&se_iterator_value(it));
     for (auto it : se_vk_memory_manager_get_pool<SeVkFramebuffer>(&device->memoryManager))   se_vk_destroy(&se_iterator_value(it));
@@ -511,12 +727,14 @@ void se_vk_device_destroy(SeVkDevice* device)
     for (auto it : se_vk_memory_manager_get_pool<SeVkProgram>(&device->memoryManager))       se_vk_destroy(&se_iterator_value(it));
     for (auto it : se_vk_memory_manager_get_pool<SeVkCommandBuffer>(&device->memoryManager)) se_vk_destroy(&se_iterator_value(it));
     //
+    // Command recorder
+    //
+    se_vk_command_recorder_destroy(&device->commandRecorder);
+    //
     // Graveyard
     //
-    se_dynamic_array_destroy(device->graveyard.programs);
-    se_dynamic_array_destroy(device->graveyard.samplers);
-    se_dynamic_array_destroy(device->graveyard.buffers);
-    se_dynamic_array_destroy(device->graveyard.textures);
+    se_dynamic_array_destroy(device->graveyard.objects);
+    se_dynamic_array_destroy(device->graveyard.buckets);
     //
     // Graph
     //
@@ -526,10 +744,22 @@ void se_vk_device_destroy(SeVkDevice* device)
     //
     se_vk_frame_manager_destroy(&device->frameManager);
     //
+    // Transfer manager
+    //
+    se_vk_transfer_manager_destroy(&device->transferManager);
+    //
+    // Pipeline cache
+    //
+    se_vk_pipeline_cache_destroy(&device->pipelineCache);
+    //
     // Swap Chain
     //
     se_vk_device_swap_chain_destroy(device);
     //
+    // Bindless heap (resources release their indices on destruction, so heap goes after all of them)
+    //
+    se_vk_bindless_heap_destroy(&device->bindlessHeap);
+    //
     // Gpu
     //
     for (size_t it = 0; it < SeVkConfig::MAX_UNIQUE_COMMAND_QUEUES; it++)
@@ -564,7 +794,10 @@ inline void se_vk_device_begin_frame(SeVkDevice* device, VkExtent2D extent)
         se_vk_device_swap_chain_destroy(device);
         se_vk_device_swap_chain_create(device, extent.width, extent.height);
     }
+    se_vk_device_seal_graveyard(device);
     se_vk_frame_manager_advance(&device->frameManager);
+    se_vk_transfer_manager_update(&device->transferManager);
+    se_vk_pipeline_cache_update(&device->pipelineCache, device->frameManager.frameNumber);
     se_vk_graph_begin_frame(&device->graph);
 }
 
@@ -576,47 +809,117 @@ inline void se_vk_device_end_frame(SeVkDevice* device)
 template<typename Ref>
 void se_vk_device_submit_to_graveyard(SeVkDevice* device, Ref ref)
 {
-    const size_t frameNumber = device->frameManager.frameNumber;
-    if      constexpr (std::is_same_v<Ref, SeProgramRef>) se_dynamic_array_push(device->graveyard.programs, { ref, frameNumber });
-    else if constexpr (std::is_same_v<Ref, SeSamplerRef>) se_dynamic_array_push(device->graveyard.samplers, { ref, frameNumber });
-    else if constexpr (std::is_same_v<Ref, SeBufferRef>)  se_dynamic_array_push(device->graveyard.buffers,  { ref, frameNumber });
-    else if constexpr (std::is_same_v<Ref, SeTextureRef>) se_dynamic_array_push(device->graveyard.textures, { ref, frameNumber });
-    else static_assert(!"what");
-    se_vk_unref(ref)->object.flags |= SeVkObject::Flags::IN_GRAVEYARD;
+    se_vk_device_submit_object_to_graveyard(device, &se_vk_unref(ref)->object);
 }
 
-template<typename Ref>
-void se_vk_device_update_graveyard_collection(SeVkDevice* device, SeDynamicArray<SeVkGraveyard::Entry<Ref>>& collection)
+// @NOTE : background compile jobs can still reference shader modules of the graveyard programs
+//         and pipelines (and their render passes) owned by compiled passes
+inline bool se_vk_device_is_compiler_dependency(const SeVkObject* object)
+{
+    return
+        object->type != SeVkObject::Type::TEXTURE       &&
+        object->type != SeVkObject::Type::MEMORY_BUFFER &&
+        object->type != SeVkObject::Type::SAMPLER;
+}
+
+void se_vk_device_submit_object_to_graveyard(SeVkDevice* device, SeVkObject* object)
 {
-    using VulkanResourceT = SeVkRefToResource<Ref>::Res;
-    SeObjectPool<VulkanResourceT>& objectPool = se_vk_memory_manager_get_pool<VulkanResourceT>(&device->memoryManager);
-    const SeVkFrameManager* const frameManager = &device->frameManager;
-    const VkDevice logicalHandle = device->gpu.logicalHandle;
-    for (auto it : collection)
-    {
-        const auto& value = se_iterator_value(it);
-        const SeVkFrame* const frame = ((frameManager->frameNumber - value.frameIndex) < SeVkConfig::NUM_FRAMES_IN_FLIGHT)
-            ? se_vk_frame_manager_get_frame(frameManager, value.frameIndex)
-            : nullptr;
-        const VkFence fence = (*se_dynamic_array_last(frame->commandBuffers))->fence;
-        const bool isFinished = !frame || vkGetFenceStatus(logicalHandle, fence) == VK_SUCCESS;
-        if (isFinished)
+    SeVkGraveyard* const graveyard = &device->graveyard;
+    const size_t frameNumber = device->frameManager.frameNumber;
+    const bool hasOpenBucket = graveyard->firstBucket < se_dynamic_array_size(graveyard->buckets) && !se_dynamic_array_last(graveyard->buckets)->isSealed;
+    if (!hasOpenBucket)
+    {
+        se_dynamic_array_push(graveyard->buckets,
         {
-            auto* const object = se_vk_unref_graveyard(value.ref);
-            se_vk_destroy(object);
-            se_object_pool_release(objectPool, object);
-            se_iterator_remove(it);
-            se_dbg_message("Destroyed texture");
-        }
+            .frameNumber                = frameNumber,
+            .timelineValue              = 0,
+            .isSealed                   = false,
+            .hasCompilerDependencies    = false,
+            .numObjects                 = 0,
+        });
+    }
+    SeVkGraveyardBucket* const bucket = se_dynamic_array_last(graveyard->buckets);
+    se_assert(bucket->frameNumber == frameNumber);
+    bucket->hasCompilerDependencies |= se_vk_device_is_compiler_dependency(object);
+    bucket->numObjects += 1;
+    se_dynamic_array_push(graveyard->objects, object);
+    object->flags |= SeVkObject::Flags::IN_GRAVEYARD;
+}
+
+void se_vk_device_seal_graveyard(SeVkDevice* device)
+{
+    SeVkGraveyard* const graveyard = &device->graveyard;
+    if (graveyard->firstBucket == se_dynamic_array_size(graveyard->buckets)) return;
+    SeVkGraveyardBucket* const bucket = se_dynamic_array_last(graveyard->buckets);
+    if (bucket->isSealed) return;
+    // @NOTE : all submissions of the current frame are already done, so the last used value covers all of them
+    bucket->timelineValue = device->frameManager.timelineValue;
+    bucket->isSealed = true;
+}
+
+template<typename T>
+void se_vk_device_release_graveyard_object(SeVkMemoryManager* memoryManager, SeVkObject* object)
+{
+    T* const resource = (T*)object;
+    se_vk_destroy(resource);
+    se_object_pool_release(se_vk_memory_manager_get_pool<T>(memoryManager), resource);
+}
+
+void se_vk_device_destroy_graveyard_object(SeVkDevice* device, SeVkObject* object)
+{
+    SeVkMemoryManager* const memoryManager = &device->memoryManager;
+    switch (object->type)
+    {
+        case SeVkObject::Type::PROGRAM:             se_vk_device_release_graveyard_object<SeVkProgram>(memoryManager, object); break;
+        case SeVkObject::Type::TEXTURE:             se_vk_device_release_graveyard_object<SeVkTexture>(memoryManager, object); break;
+        case SeVkObject::Type::PASS:                se_vk_device_release_graveyard_object<SeVkRenderPass>(memoryManager, object); break;
+        case SeVkObject::Type::FRAMEBUFFER:         se_vk_device_release_graveyard_object<SeVkFramebuffer>(memoryManager, object); break;
+        case SeVkObject::Type::GRAPHICS_PIPELINE:
+        case SeVkObject::Type::COMPUTE_PIPELINE:    se_vk_device_release_graveyard_object<SeVkPipeline>(memoryManager, object); break;
+        case SeVkObject::Type::MEMORY_BUFFER:       se_vk_device_release_graveyard_object<SeVkMemoryBuffer>(memoryManager, object); break;
+        case SeVkObject::Type::SAMPLER:             se_vk_device_release_graveyard_object<SeVkSampler>(memoryManager, object); break;
+        case SeVkObject::Type::COMPILED_PASS:       se_vk_device_release_graveyard_object<SeVkCompiledPass>(memoryManager, object); break;
+        default: { se_assert(!"Unsupported graveyard object type"); }
     }
 }
 
 void se_vk_device_update_graveyard(SeVkDevice* device)
 {
-    se_vk_device_update_graveyard_collection(device, device->graveyard.programs);
-    se_vk_device_update_graveyard_collection(device, device->graveyard.samplers);
-    se_vk_device_update_graveyard_collection(device, device->graveyard.buffers);
-    se_vk_device_update_graveyard_collection(device, device->graveyard.textures);
+    SeVkGraveyard* const graveyard = &device->graveyard;
+    if (graveyard->firstBucket == se_dynamic_array_size(graveyard->buckets)) return;
+    if (!graveyard->buckets[graveyard->firstBucket].isSealed) return;
+
+    const bool isCompilerBusy = se_vk_pipeline_compiler_is_busy(&device->pipelineCompiler);
+    const uint64_t completedValue = se_vk_utils_get_timeline_value(se_vk_device_get_logical_handle(device), device->frameManager.timelineSemaphore);
+    // @NOTE : buckets are accessed by index, because destroyed objects can submit other objects to the graveyard
+    while (graveyard->firstBucket < se_dynamic_array_size(graveyard->buckets))
+    {
+        const SeVkGraveyardBucket bucket = graveyard->buckets[graveyard->firstBucket];
+        if (!bucket.isSealed || bucket.timelineValue > completedValue) break;
+        if (isCompilerBusy && bucket.hasCompilerDependencies) break;
+        for (size_t it = 0; it < bucket.numObjects; it++)
+        {
+            se_vk_device_destroy_graveyard_object(device, graveyard->objects[graveyard->firstObject + it]);
+        }
+        graveyard->firstObject += bucket.numObjects;
+        graveyard->firstBucket += 1;
+    }
+    //
+    // Destroyed part is removed once it's bigger than the pending one, so every object is moved at most once on average
+    //
+    const size_t numPendingObjects = se_dynamic_array_size(graveyard->objects) - graveyard->firstObject;
+    if (graveyard->firstObject >= numPendingObjects)
+    {
+        const size_t numPendingBuckets = se_dynamic_array_size(graveyard->buckets) - graveyard->firstBucket;
+        SeVkObject** const objects = se_dynamic_array_raw(graveyard->objects);
+        SeVkGraveyardBucket* const buckets = se_dynamic_array_raw(graveyard->buckets);
+        memmove(objects, objects + graveyard->firstObject, numPendingObjects * sizeof(SeVkObject*));
+        memmove(buckets, buckets + graveyard->firstBucket, numPendingBuckets * sizeof(SeVkGraveyardBucket));
+        se_dynamic_array_force_set_size(graveyard->objects, numPendingObjects);
+        se_dynamic_array_force_set_size(graveyard->buckets, numPendingBuckets);
+        graveyard->firstObject = 0;
+        graveyard->firstBucket = 0;
+    }
 }
 
 inline VkSampleCountFlags se_vk_device_get_supported_sampling_types(SeVkDevice* device)
@@ -666,7 +969,7 @@ void se_vk_device_fill_sharing_mode(SeVkDevice* device, SeVkCommandQueueFlags fl
     uint32_t numUniqueQueues = 0;
     for (uint32_t it = 0; it < SeVkConfig::MAX_UNIQUE_COMMAND_QUEUES; it++)
     {
-        if (!(flags & it)) continue;
+        if (!(flags & (1 << it))) continue;
         bool isFound = false;
         for (uint32_t uniqueIt = 0; uniqueIt < numUniqueQueues; uniqueIt++)
         {
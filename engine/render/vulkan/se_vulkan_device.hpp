@@ -4,10 +4,20 @@
 #include "se_vulkan_base.hpp"
 #include "se_vulkan_memory.hpp"
 #include "se_vulkan_frame_manager.hpp"
+#include "se_vulkan_transfer_manager.hpp"
+#include "se_vulkan_pipeline_cache.hpp"
+#include "se_vulkan_pipeline_compiler.hpp"
+#include "se_vulkan_command_recorder.hpp"
 #include "se_vulkan_graph.hpp"
+#include "se_vulkan_compiled_pass.hpp"
+#include "se_vulkan_bindless_heap.hpp"
 
 #define se_vk_device_get_logical_handle(device)                     ((device)->gpu.logicalHandle)
 #define se_vk_device_is_stencil_supported(device)                   ((device)->gpu.flags & SE_VK_GPU_HAS_STENCIL)
+#define se_vk_device_is_bindless_supported(device)                  ((device)->gpu.flags & SE_VK_GPU_HAS_BINDLESS)
+#define se_vk_device_is_draw_indirect_count_supported(device)       ((device)->gpu.flags & SE_VK_GPU_HAS_DRAW_INDIRECT_COUNT)
+#define se_vk_device_is_dynamic_rendering_supported(device)         ((device)->gpu.flags & SE_VK_GPU_HAS_DYNAMIC_RENDERING)
+#define se_vk_device_is_async_compute_supported(device)             ((device)->gpu.flags & SE_VK_GPU_HAS_ASYNC_COMPUTE)
 #define se_vk_device_get_command_pool(device, flags)                (se_vk_gpu_get_command_queue(&(device)->gpu, flags)->commandPoolHandle)
 #define se_vk_device_get_command_queue(device, flags)               (se_vk_gpu_get_command_queue(&(device)->gpu, flags)->handle)
 #define se_vk_device_get_command_queue_family_index(device, flags)  (se_vk_gpu_get_command_queue(&(device)->gpu, flags)->queueFamilyIndex)
@@ -31,7 +41,11 @@ using SeVkCommandQueueFlags = SeVkFlags;
 
 enum SeVkGpuFlagBits
 {
-    SE_VK_GPU_HAS_STENCIL = 0x00000001,
+    SE_VK_GPU_HAS_STENCIL               = 0x00000001,
+    SE_VK_GPU_HAS_BINDLESS              = 0x00000002, // Descriptor indexing features required by the bindless heap are enabled
+    SE_VK_GPU_HAS_DRAW_INDIRECT_COUNT   = 0x00000004, // vkCmdDrawIndexedIndirectCount can be used
+    SE_VK_GPU_HAS_DYNAMIC_RENDERING     = 0x00000008, // VK_KHR_dynamic_rendering is enabled, cmdBeginRendering and cmdEndRendering are loaded
+    SE_VK_GPU_HAS_ASYNC_COMPUTE         = 0x00000010, // Compute queue is from a family without graphics support, so it can run in parallel with the graphics queue
 };
 using SeVkGpuFlags = SeVkFlags;
 
@@ -61,6 +75,8 @@ struct SeVkGpu
     VkDevice                            logicalHandle;
     VkFormat                            depthStencilFormat;
     SeVkGpuFlags                        flags;
+    PFN_vkCmdBeginRenderingKHR          cmdBeginRendering;  // Null if dynamic rendering isn't supported
+    PFN_vkCmdEndRenderingKHR            cmdEndRendering;    // Null if dynamic rendering isn't supported
 };
 
 struct SeVkSwapChainImage
@@ -79,18 +95,30 @@ struct SeVkSwapChain
     size_t                          numTextures;
 };
 
+//
+// Destroyed objects wait in the graveyard until gpu finishes all submissions that could use them.
+//
+// Objects are grouped in buckets by the frame they were destroyed in. Object destroyed in a frame can be used only by the
+// submissions of this and previous frames, so when the next frame begins the bucket is sealed with the last timeline value
+// used so far. Values of sealed buckets never decrease, so update queries the frame timeline once and destroys buckets
+// from the front until it reaches a value that isn't completed yet. Cost of the update depends on the number of objects
+// that are actually destroyed, not on the number of pending ones.
+//
+struct SeVkGraveyardBucket
+{
+    size_t      frameNumber;
+    uint64_t    timelineValue;              // Valid only if bucket is sealed
+    bool        isSealed;
+    bool        hasCompilerDependencies;    // Bucket contains programs, compiled passes or their objects
+    size_t      numObjects;
+};
+
 struct SeVkGraveyard
 {
-    template<typename Ref>
-    struct Entry
-    {
-        Ref ref;
-        size_t frameIndex;
-    };
-    SeDynamicArray<Entry<SeProgramRef>>   programs;
-    SeDynamicArray<Entry<SeSamplerRef>>   samplers;
-    SeDynamicArray<Entry<SeBufferRef>>    buffers;
-    SeDynamicArray<Entry<SeTextureRef>>   textures;
+    SeDynamicArray<SeVkObject*>             objects;        // Ordered by bucket, objects before firstObject are already destroyed
+    SeDynamicArray<SeVkGraveyardBucket>     buckets;        // Buckets before firstBucket are already destroyed
+    size_t                                  firstObject;
+    size_t                                  firstBucket;
 };
 
 struct SeVkDevice
@@ -104,8 +132,13 @@ struct SeVkDevice
     SeVkSwapChain                   swapChain;
     SeVkDeviceFlags                 flags;
     SeVkFrameManager                frameManager;
+    SeVkTransferManager             transferManager;
+    SeVkPipelineCache               pipelineCache;
+    SeVkPipelineCompiler            pipelineCompiler;
+    SeVkCommandRecorder             commandRecorder;
     SeVkGraph                       graph;
     SeVkGraveyard                   graveyard;
+    SeVkBindlessHeap                bindlessHeap;
 };
 
 SeVkDevice*                         se_vk_device_create(const SeSettings& settings, void* nativeWindowHandle);
@@ -114,7 +147,9 @@ void                                se_vk_device_begin_frame(SeVkDevice* device,
 void                                se_vk_device_end_frame(SeVkDevice* device);
 
 template<typename Ref> void         se_vk_device_submit_to_graveyard(SeVkDevice* device, Ref ref);
-template<typename Ref> void         se_vk_device_update_graveyard_collection(SeVkDevice* device, SeDynamicArray<SeVkGraveyard::Entry<Ref>>& collection);
+void                                se_vk_device_submit_object_to_graveyard(SeVkDevice* device, SeVkObject* object);
+// Seals the bucket of the current frame, called before frame manager advances to the next frame
+void                                se_vk_device_seal_graveyard(SeVkDevice* device);
 void                                se_vk_device_update_graveyard(SeVkDevice* device);
 
 SeVkFlags                           se_vk_device_get_supported_sampling_types(SeVkDevice* device);
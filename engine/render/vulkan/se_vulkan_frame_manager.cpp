@@ -2,6 +2,7 @@
 #include "se_vulkan_frame_manager.hpp"
 #include "se_vulkan_device.hpp"
 #include "se_vulkan_command_buffer.hpp"
+#include "se_vulkan_utils.hpp"
 
 void se_vk_frame_manager_construct(SeVkFrameManager* manager, const SeVkFrameManagerCreateInfo* createInfo)
 {
@@ -19,11 +20,16 @@ void se_vk_frame_manager_construct(SeVkFrameManager* manager, const SeVkFrameMan
 
     *manager = 
     {
-        .device                 = device,
-        .frames                 = { },
-        .imageToFrame           = { },
-        .frameNumber            = 0,
-        .scratchBufferAlignment = scratchBufferAlignment,
+        .device                         = device,
+        .frames                         = { },
+        .timelineSemaphore              = se_vk_utils_create_timeline_semaphore(logicalHandle, 0, callbacks),
+        .timelineValue                  = 0,
+        .asyncComputeTimelineSemaphore  = se_vk_utils_create_timeline_semaphore(logicalHandle, 0, callbacks),
+        .asyncComputeTimelineValue      = 0,
+        .imagePresentSemaphores         = { },
+        .imageTimelineValues            = { },
+        .frameNumber                    = 0,
+        .scratchBufferAlignment         = scratchBufferAlignment,
     };
     for (size_t it = 0; it < SeVkConfig::NUM_FRAMES_IN_FLIGHT; it++)
     {
@@ -31,7 +37,11 @@ void se_vk_frame_manager_construct(SeVkFrameManager* manager, const SeVkFrameMan
         *frame =
         {
             .imageAvailableSemaphore    = VK_NULL_HANDLE,
+            .timelineValue              = 0,
+            .commandPools               = { },
             .commandBuffers             = { },
+            .numCreatedCommandObjects   = 0,
+            .numReusedCommandBuffers    = 0,
             .scratchBuffer              = se_object_pool_take(memoryBufferPool),
             .scratchBufferViews         = { },
             .scratchBufferTop           = 0,
@@ -50,18 +60,27 @@ void se_vk_frame_manager_construct(SeVkFrameManager* manager, const SeVkFrameMan
         {
             .device     = device,
             .size       = se_megabytes(8),
-            .usage      = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
-                          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | 
-                          VK_BUFFER_USAGE_TRANSFER_DST_BIT   | 
-                          VK_BUFFER_USAGE_TRANSFER_SRC_BIT   ,
+            .usage      = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT  |
+                          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT  | 
+                          VK_BUFFER_USAGE_INDEX_BUFFER_BIT    |
+                          VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                          VK_BUFFER_USAGE_TRANSFER_DST_BIT    | 
+                          VK_BUFFER_USAGE_TRANSFER_SRC_BIT    ,
             .visibility = VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+            .isTransient = false,
         };
         se_vk_memory_buffer_construct(frame->scratchBuffer, &bufferInfo);
         se_dynamic_array_construct(frame->scratchBufferViews, se_allocator_persistent(), SeVkConfig::SCRATCH_BUFFERS_ARRAY_INITIAL_CAPACITY);
     }
     for (size_t it = 0; it < SeVkConfig::MAX_SWAP_CHAIN_IMAGES; it++)
     {
-        manager->imageToFrame[it] = SE_VK_FRAME_MANAGER_INVALID_FRAME;
+        const VkSemaphoreCreateInfo semaphoreCreateInfo
+        {
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+        };
+        se_vk_check(vkCreateSemaphore(logicalHandle, &semaphoreCreateInfo, callbacks, &manager->imagePresentSemaphores[it]));
     }
 }
 
@@ -74,8 +93,26 @@ void se_vk_frame_manager_destroy(SeVkFrameManager* manager)
         SeVkFrame* const frame = &manager->frames[it];
         vkDestroySemaphore(logicalHandle, frame->imageAvailableSemaphore, callbacks);
         se_dynamic_array_destroy(frame->commandBuffers);
+        // @NOTE : command buffer objects are destroyed together with the rest of the objects in memory manager pools
+        for (size_t lane = 0; lane < SeVkConfig::COMMAND_RECORDER_MAX_THREADS; lane++)
+        {
+            for (size_t queueIt = 0; queueIt < SeVkConfig::MAX_UNIQUE_COMMAND_QUEUES; queueIt++)
+            {
+                SeVkFrameCommandPool* const pool = &frame->commandPools[lane][queueIt];
+                if (!pool->handle) continue;
+                vkDestroyCommandPool(logicalHandle, pool->handle, nullptr);
+                se_dynamic_array_destroy(pool->primaryBuffers);
+                se_dynamic_array_destroy(pool->secondaryBuffers);
+            }
+        }
         se_dynamic_array_destroy(frame->scratchBufferViews);
     }
+    for (size_t it = 0; it < SeVkConfig::MAX_SWAP_CHAIN_IMAGES; it++)
+    {
+        vkDestroySemaphore(logicalHandle, manager->imagePresentSemaphores[it], callbacks);
+    }
+    vkDestroySemaphore(logicalHandle, manager->timelineSemaphore, callbacks);
+    vkDestroySemaphore(logicalHandle, manager->asyncComputeTimelineSemaphore, callbacks);
 }
 
 void se_vk_frame_manager_advance(SeVkFrameManager* manager)
@@ -85,28 +122,27 @@ void se_vk_frame_manager_advance(SeVkFrameManager* manager)
     SeVkFrame* const frame = se_vk_frame_manager_get_active_frame(manager);
 
     //
-    // Wait and reset command buffers
+    // Wait and reset command pools. Command buffers stay allocated and are reused by the next get_cmd calls
     //
-    if (SeVkCommandBuffer** const lastCommandBufferFromThisFrame = se_dynamic_array_last(frame->commandBuffers))
+    if (frame->timelineValue)
+    {
+        se_vk_utils_wait_timeline(logicalHandle, manager->timelineSemaphore, frame->timelineValue);
+        frame->timelineValue = 0;
+    }
+    for (size_t lane = 0; lane < SeVkConfig::COMMAND_RECORDER_MAX_THREADS; lane++)
     {
-        se_vk_check(vkWaitForFences(
-            logicalHandle,
-            1,
-            &(*lastCommandBufferFromThisFrame)->fence,
-            VK_TRUE,
-            UINT64_MAX
-        ));
-
-        auto& commandBufferPool = se_vk_memory_manager_get_pool<SeVkCommandBuffer>(&manager->device->memoryManager);
-        for (auto it : frame->commandBuffers)
+        for (size_t queueIt = 0; queueIt < SeVkConfig::MAX_UNIQUE_COMMAND_QUEUES; queueIt++)
         {
-            SeVkCommandBuffer* const value = se_iterator_value(it);
-            se_vk_command_buffer_destroy(value);
-            se_object_pool_release(commandBufferPool, value);
+            SeVkFrameCommandPool* const pool = &frame->commandPools[lane][queueIt];
+            if (!pool->handle || (!pool->numUsedPrimaryBuffers && !pool->numUsedSecondaryBuffers)) continue;
+            se_vk_check(vkResetCommandPool(logicalHandle, pool->handle, 0));
+            pool->numUsedPrimaryBuffers = 0;
+            pool->numUsedSecondaryBuffers = 0;
         }
-
-        se_dynamic_array_reset(frame->commandBuffers);
     }
+    se_dynamic_array_reset(frame->commandBuffers);
+    frame->numCreatedCommandObjects = 0;
+    frame->numReusedCommandBuffers = 0;
 
     //
     // Reset scratch buffer
@@ -115,15 +151,74 @@ void se_vk_frame_manager_advance(SeVkFrameManager* manager)
     frame->scratchBufferTop = 0;
 }
 
-SeVkCommandBuffer* se_vk_frame_manager_get_cmd(SeVkFrameManager* manager, SeVkCommandBufferInfo* info)
+SeVkCommandBuffer* se_vk_frame_manager_get_cmd(SeVkFrameManager* manager, const SeVkCommandBufferInfo* info, size_t lane)
 {
-    auto& commandBufferPool = se_vk_memory_manager_get_pool<SeVkCommandBuffer>(&manager->device->memoryManager);
-    SeVkCommandBuffer* const cmd = se_object_pool_take(commandBufferPool);
-    se_dynamic_array_push(se_vk_frame_manager_get_active_frame(manager)->commandBuffers, cmd);
-    se_vk_command_buffer_construct(cmd, info);
+    se_assert(lane < SeVkConfig::COMMAND_RECORDER_MAX_THREADS);
+    se_assert_msg(!info->pool, "Frame manager command buffers are allocated from frame command pools");
+    SeVkDevice* const device = manager->device;
+    SeVkFrame* const frame = se_vk_frame_manager_get_active_frame(manager);
+    const SeVkCommandQueue* const queue = se_vk_gpu_get_command_queue(&device->gpu, se_vk_command_buffer_usage_to_queue_flags(info->usage));
+    SeVkFrameCommandPool* const pool = &frame->commandPools[lane][queue - device->gpu.commandQueues];
+    if (!pool->handle)
+    {
+        // @NOTE : pools are created without allocation callbacks, because worker lanes record commands in parallel
+        const VkCommandPoolCreateInfo poolCreateInfo = se_vk_utils_command_pool_create_info(queue->queueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+        se_vk_check(vkCreateCommandPool(se_vk_device_get_logical_handle(device), &poolCreateInfo, nullptr, &pool->handle));
+        se_dynamic_array_construct(pool->primaryBuffers, se_allocator_persistent(), SeVkConfig::COMMAND_BUFFERS_ARRAY_INITIAL_CAPACITY);
+        se_dynamic_array_construct(pool->secondaryBuffers, se_allocator_persistent(), SeVkConfig::COMMAND_BUFFERS_ARRAY_INITIAL_CAPACITY);
+        frame->numCreatedCommandObjects += 1;
+    }
+    const bool isSecondary = info->inheritance != nullptr;
+    SeDynamicArray<SeVkCommandBuffer*>& buffers = isSecondary ? pool->secondaryBuffers : pool->primaryBuffers;
+    size_t& numUsedBuffers = isSecondary ? pool->numUsedSecondaryBuffers : pool->numUsedPrimaryBuffers;
+    SeVkCommandBuffer* cmd;
+    if (numUsedBuffers < se_dynamic_array_size(buffers))
+    {
+        cmd = buffers[numUsedBuffers];
+        se_vk_command_buffer_begin(cmd, info->inheritance);
+        frame->numReusedCommandBuffers += 1;
+    }
+    else
+    {
+        auto& commandBufferPool = se_vk_memory_manager_get_pool<SeVkCommandBuffer>(&device->memoryManager);
+        SeVkCommandBufferInfo poolInfo = *info;
+        poolInfo.pool = pool->handle;
+        cmd = se_object_pool_take(commandBufferPool);
+        se_vk_command_buffer_construct(cmd, &poolInfo);
+        se_dynamic_array_push(buffers, cmd);
+        frame->numCreatedCommandObjects += 1;
+    }
+    numUsedBuffers += 1;
+    if (!isSecondary)
+    {
+        se_dynamic_array_push(frame->commandBuffers, cmd);
+    }
     return cmd;
 }
 
+void se_vk_frame_manager_submit_timeline_values(SeVkFrameManager* manager, uint64_t timelineValue, uint64_t asyncComputeTimelineValue)
+{
+    se_assert(timelineValue > manager->timelineValue && asyncComputeTimelineValue >= manager->asyncComputeTimelineValue);
+    SeVkFrame* const frame = se_vk_frame_manager_get_active_frame(manager);
+    manager->timelineValue = timelineValue;
+    manager->asyncComputeTimelineValue = asyncComputeTimelineValue;
+    frame->timelineValue = timelineValue;
+}
+
+bool se_vk_frame_manager_is_frame_finished(const SeVkFrameManager* manager, size_t frameNumber)
+{
+    // @NOTE : frames that are older than NUM_FRAMES_IN_FLIGHT were already waited in se_vk_frame_manager_advance
+    if ((manager->frameNumber - frameNumber) >= SeVkConfig::NUM_FRAMES_IN_FLIGHT) return true;
+    //
+    // Frame is finished if all of it's submissions (and all submissions before them) are finished.
+    // Active frame which isn't submitted yet is never finished
+    //
+    const SeVkFrame* const frame = se_vk_frame_manager_get_frame(manager, frameNumber);
+    if (!frame->timelineValue) return false;
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(manager->device);
+    return se_vk_utils_get_timeline_value(logicalHandle, manager->timelineSemaphore) >= frame->timelineValue;
+}
+
 uint32_t se_vk_frame_manager_alloc_scratch_buffer(SeVkFrameManager* manager, SeDataProvider data)
 {
     se_assert(se_data_provider_is_valid(data));
@@ -4,12 +4,23 @@
 #include "se_vulkan_base.hpp"
 #include "se_vulkan_memory_buffer.hpp"
 
-#define SE_VK_FRAME_MANAGER_INVALID_FRAME 0xDEAD
-
 #define se_vk_frame_manager_get_active_frame(manager) (&(manager)->frames[(manager)->frameNumber % SeVkConfig::NUM_FRAMES_IN_FLIGHT])
 #define se_vk_frame_manager_get_active_frame_index(manager) ((manager)->frameNumber % SeVkConfig::NUM_FRAMES_IN_FLIGHT)
 #define se_vk_frame_manager_get_frame(manager, index) (&(manager)->frames[(index) % SeVkConfig::NUM_FRAMES_IN_FLIGHT])
 
+//
+// Command pool of a single command recorder lane and queue. Pools are reset in bulk when frame is reused and
+// command buffers allocated from them are recycled, so steady state frames don't create any vulkan objects
+//
+struct SeVkFrameCommandPool
+{
+    VkCommandPool                       handle;             // Created on first use
+    SeDynamicArray<SeVkCommandBuffer*>  primaryBuffers;     // All buffers allocated from this pool
+    SeDynamicArray<SeVkCommandBuffer*>  secondaryBuffers;
+    size_t                              numUsedPrimaryBuffers;
+    size_t                              numUsedSecondaryBuffers;
+};
+
 struct SeVkFrame
 {
     struct ScratchBufferView
@@ -19,17 +30,35 @@ struct SeVkFrame
     };
 
     VkSemaphore                         imageAvailableSemaphore;
-    SeDynamicArray<SeVkCommandBuffer*>    commandBuffers;
+    uint64_t                            timelineValue;  // Value of the frame timeline signaled by the last submission of this frame, 0 if nothing is submitted
+    SeVkFrameCommandPool                commandPools[SeVkConfig::COMMAND_RECORDER_MAX_THREADS][SeVkConfig::MAX_UNIQUE_COMMAND_QUEUES];
+    SeDynamicArray<SeVkCommandBuffer*>    commandBuffers; // Primary command buffers in submission order
+    size_t                              numCreatedCommandObjects;   // Command pools and command buffers created during this frame
+    size_t                              numReusedCommandBuffers;
     SeVkMemoryBuffer*                   scratchBuffer;
     SeDynamicArray<ScratchBufferView>     scratchBufferViews;
     size_t                              scratchBufferTop;
 };
 
+//
+// Frames are synchronized with the cpu by a single timeline semaphore. Every frame submission signals the next
+// timeline value, so waiting for a frame (or checking if it is finished) is a single value comparison.
+// Swap chain images have their own binary semaphores for presentation (present can't wait on timeline semaphores),
+// which are reused only after the image is acquired again.
+// Async compute submissions signal their own timeline (a timeline must be signaled in increasing order, which isn't
+// guaranteed for two queues). Last frame submission is on the graphics queue and waits for all async work of the frame,
+// so frame timeline alone tells if the frame is finished.
+//
 struct SeVkFrameManager
 {
     SeVkDevice* device;
     SeVkFrame   frames[SeVkConfig::NUM_FRAMES_IN_FLIGHT];
-    size_t      imageToFrame[SeVkConfig::MAX_SWAP_CHAIN_IMAGES];
+    VkSemaphore timelineSemaphore;
+    uint64_t    timelineValue;  // Last value used for submission
+    VkSemaphore asyncComputeTimelineSemaphore;
+    uint64_t    asyncComputeTimelineValue;
+    VkSemaphore imagePresentSemaphores[SeVkConfig::MAX_SWAP_CHAIN_IMAGES];
+    uint64_t    imageTimelineValues[SeVkConfig::MAX_SWAP_CHAIN_IMAGES]; // Timeline value of the last frame that rendered to the image
     size_t      frameNumber;
     size_t      scratchBufferAlignment;
 };
@@ -45,7 +74,11 @@ void se_vk_frame_manager_construct(SeVkFrameManager* manager, const SeVkFrameMan
 void se_vk_frame_manager_destroy(SeVkFrameManager* manager);
 void se_vk_frame_manager_advance(SeVkFrameManager* manager);
 
-SeVkCommandBuffer* se_vk_frame_manager_get_cmd(SeVkFrameManager* manager, SeVkCommandBufferInfo* info);
+// Command buffer is allocated from the pool of the command recorder lane, which will record it
+SeVkCommandBuffer* se_vk_frame_manager_get_cmd(SeVkFrameManager* manager, const SeVkCommandBufferInfo* info, size_t lane);
+// Stores the last timeline values signaled by the submissions of the active frame (values are assigned by the queue scheduler)
+void se_vk_frame_manager_submit_timeline_values(SeVkFrameManager* manager, uint64_t timelineValue, uint64_t asyncComputeTimelineValue);
+bool se_vk_frame_manager_is_frame_finished(const SeVkFrameManager* manager, size_t frameNumber);
 uint32_t se_vk_frame_manager_alloc_scratch_buffer(SeVkFrameManager* manager, SeDataProvider data);
 
 #endif
@@ -32,7 +32,7 @@ void se_vk_framebuffer_construct(SeVkFramebuffer* framebuffer, SeVkFramebufferIn
     VkImageView attachmentViews[SeVkConfig::FRAMEBUFFER_MAX_TEXTURES];
     for (uint32_t it = 0; it < info->numTextures; it++)
     {
-        attachmentViews[it] = info->textures[it]->view;
+        attachmentViews[it] = info->textures[it]->attachmentView;
         framebuffer->textures[it] = info->textures[it];
     }
 
@@ -11,6 +11,7 @@ struct SeVkFramebufferInfo
     SeObjectPoolEntryRef<SeVkRenderPass>  pass;
     SeObjectPoolEntryRef<SeVkTexture>     textures[SeVkConfig::FRAMEBUFFER_MAX_TEXTURES];
     uint32_t                            numTextures;
+    uint64_t                            textureIds[SeVkConfig::FRAMEBUFFER_MAX_TEXTURES];  // SeVkObject::uniqueIndex of textures. Transient textures get new views (and ids) when they are moved in memory
 };
 
 struct SeVkFramebuffer
@@ -39,6 +40,7 @@ void se_hash_value_builder_absorb<SeVkFramebufferInfo>(SeHashValueBuilder& build
     se_hash_value_builder_absorb(builder, value.pass);
     se_hash_value_builder_absorb(builder, value.numTextures);
     for (size_t it = 0; it < value.numTextures; it++) se_hash_value_builder_absorb(builder, value.textures[it]);
+    for (size_t it = 0; it < value.numTextures; it++) se_hash_value_builder_absorb(builder, value.textureIds[it]);
 }
 
 template<>
@@ -3,10 +3,24 @@
 #include "se_vulkan_device.hpp"
 #include "se_vulkan_frame_manager.hpp"
 #include "se_vulkan_utils.hpp"
+#include "se_vulkan_compiled_pass.hpp"
 
 constexpr size_t SE_VK_GRAPH_MAX_SETS_IN_DESCRIPTOR_POOL = 64;
 constexpr size_t SE_VK_GRAPH_OBJECT_LIFETIME             = 20;
 constexpr size_t CONTAINERS_INITIAL_CAPACITY             = 32;
+constexpr size_t SE_VK_GRAPH_COMMAND_STREAM_CAPACITY     = 64 * 1024; // Initial size in bytes, stream keeps its memory between frames
+
+// Async compute queue is from a family without graphics support, so its barriers can use only these stages and accesses
+constexpr SeVkBarrierQueue SE_VK_GRAPH_ASYNC_COMPUTE_BARRIER_QUEUE
+{
+    .index              = SE_VK_SCHEDULED_QUEUE_ASYNC_COMPUTE,
+    .supportedStages    = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+    .supportedAccess    = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+};
+
+static_assert(sizeof(SeDrawIndirectArgs) == sizeof(VkDrawIndirectCommand), "SeDrawIndirectArgs must match VkDrawIndirectCommand");
+static_assert(sizeof(SeDrawIndexedIndirectArgs) == sizeof(VkDrawIndexedIndirectCommand), "SeDrawIndexedIndirectArgs must match VkDrawIndexedIndirectCommand");
+static_assert(sizeof(SeDispatchIndirectArgs) == sizeof(VkDispatchIndirectCommand), "SeDispatchIndirectArgs must match VkDispatchIndirectCommand");
 
 uint32_t se_vk_graph_get_num_bindings(const SeCommandBindInfo& info)
 {
@@ -34,37 +48,1105 @@ VkStencilOpState se_vk_graph_pipeline_stencil_op_state(const SeStencilOpState* s
     };
 }
 
+SeVkProgramWithConstants se_vk_graph_program_with_constants(const SeProgramWithConstants& seProgram)
+{
+    SeVkProgramWithConstants program
+    {
+        .program                    = se_vk_unref(seProgram.program),
+        .constants                  = { },
+        .numSpecializationConstants = seProgram.numSpecializationConstants,
+    };
+    memcpy(program.constants, seProgram.specializationConstants, sizeof(SeSpecializationConstant) * seProgram.numSpecializationConstants);
+    return program;
+}
+
+VkFormat se_vk_graph_get_texture_format(SeVkGraph* graph, SeTextureRef texture)
+{
+    return texture.isSwapChain ? se_vk_device_get_swap_chain_format(graph->device) : se_vk_unref(texture)->format;
+}
+
+VkExtent3D se_vk_graph_get_texture_extent(SeVkGraph* graph, SeTextureRef texture)
+{
+    // @NOTE : all swap chain textures have the same extent
+    const SeVkTexture* const vkTexture = texture.isSwapChain ? *se_vk_device_get_swap_chain_texture(graph->device, 0) : se_vk_unref(texture);
+    return vkTexture->extent;
+}
+
+SeVkRenderPassAttachment se_vk_graph_get_color_attachment(SeVkGraph* graph, const SePassRenderTarget& target)
+{
+    const VkFormat format = se_vk_graph_get_texture_format(graph, target.texture);
+    const bool isDefaultClearValue = se_compare(target.clearColor, SeColorUnpacked{});
+    // @TODO : support clear values for INT and UINT textures
+    //         https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkClearColorValue.html
+    se_assert_msg(isDefaultClearValue || (se_vk_utils_get_format_info(format).sampledType == SeVkFormatInfo::Type::FLOAT), "Clear values are only supported for floating point textures");
+    se_assert_msg(target.clearColor.r >= 0.0f && target.clearColor.r <= 1.0f, "Clear values must be in range [0.0, 1.0]");
+    se_assert_msg(target.clearColor.g >= 0.0f && target.clearColor.g <= 1.0f, "Clear values must be in range [0.0, 1.0]");
+    se_assert_msg(target.clearColor.b >= 0.0f && target.clearColor.b <= 1.0f, "Clear values must be in range [0.0, 1.0]");
+    se_assert_msg(target.clearColor.a >= 0.0f && target.clearColor.a <= 1.0f, "Clear values must be in range [0.0, 1.0]");
+    return
+    {
+        .format     = format,
+        .loadOp     = se_vk_utils_to_vk_load_op(target.loadOp),
+        .storeOp    = VK_ATTACHMENT_STORE_OP_STORE,
+        .sampling   = VK_SAMPLE_COUNT_1_BIT, // @TODO : support multisampling (and resolve and stuff)
+        .clearValue = { .color = { .float32 = { target.clearColor.r, target.clearColor.g, target.clearColor.b, target.clearColor.a } } },
+    };
+}
+
+bool se_vk_graph_is_input_attachment(const SeGraphicsPassInfo& info, SeTextureRef texture)
+{
+    for (size_t it = 0; it < SE_MAX_PASS_INPUT_ATTACHMENTS; it++)
+    {
+        if (!info.inputAttachments[it]) break;
+        if (se_compare(info.inputAttachments[it], texture)) return true;
+    }
+    return false;
+}
+
+//
+// Adds the pass to the group as a new subpass. Returns false (and doesn't modify the group) if the pass isn't compatible
+// with the previous subpasses :
+// - attachments must have the same extent
+// - render targets and input attachments must be in the render pass attachment order, because shader outputs and subpass
+//   inputs are mapped to the referenced attachments in this order (see se_vk_render_pass_validate_fragment_program_setup)
+// - attachments used by the previous subpasses can't be cleared again
+// - depth stencil target must be the same as the one of the previous subpasses
+// First pass of the group is always added. Textures bound to the passes are checked by the caller
+//
+bool se_vk_graph_add_subpass(SeVkGraph* graph, SeVkGraphPassGroup* group, const SeGraphicsPassInfo& info)
+{
+    SeVkRenderPassInfo& renderPassInfo = group->renderPassInfo;
+    const uint32_t subpassIndex = renderPassInfo.numSubpasses;
+    const uint32_t numExistingColors = renderPassInfo.numColorAttachments;
+    if (subpassIndex == SE_VK_GENERAL_BITMASK_WIDTH) return false;
+
+    SeTextureRef newTextures[SeVkConfig::FRAMEBUFFER_MAX_TEXTURES];
+    SeVkRenderPassAttachment newAttachments[SeVkConfig::FRAMEBUFFER_MAX_TEXTURES];
+    uint32_t numNewTextures = 0;
+    VkExtent3D extent = group->extent;
+    bool hasExtent = numExistingColors || renderPassInfo.hasDepthStencilAttachment;
+    const auto isSameExtent = [&](SeTextureRef texture) -> bool
+    {
+        const VkExtent3D textureExtent = se_vk_graph_get_texture_extent(graph, texture);
+        if (!hasExtent)
+        {
+            extent = textureExtent;
+            hasExtent = true;
+        }
+        return textureExtent.width == extent.width && textureExtent.height == extent.height;
+    };
+    const auto findAttachment = [&](SeTextureRef texture) -> uint32_t
+    {
+        for (uint32_t it = 0; it < numExistingColors; it++) if (se_compare(group->colorAttachments[it], texture)) return it;
+        for (uint32_t it = 0; it < numNewTextures; it++) if (se_compare(newTextures[it], texture)) return numExistingColors + it;
+        return UINT32_MAX;
+    };
+    const bool hasNewDepthStencil = info.depthStencilTarget && !renderPassInfo.hasDepthStencilAttachment;
+    const uint32_t numDepthStencilAttachments = (renderPassInfo.hasDepthStencilAttachment || hasNewDepthStencil) ? 1 : 0;
+    SeVkRenderPassSubpass subpass
+    {
+        .colorRefs      = 0,
+        .inputRefs      = 0,
+        .resolveRefs    = { },
+        .numResolveRefs = 0,
+        .depthRead      = bool(info.depthStencilTarget),
+        .depthWrite     = bool(info.depthStencilTarget),
+    };
+    //
+    // Render targets
+    //
+    int64_t lastRef = -1;
+    for (uint32_t it = 0; it < SE_MAX_PASS_RENDER_TARGETS; it++)
+    {
+        const SePassRenderTarget& target = info.renderTargets[it];
+        if (!target) break;
+        uint32_t ref = findAttachment(target.texture);
+        if (ref == UINT32_MAX)
+        {
+            if (numExistingColors + numNewTextures + numDepthStencilAttachments == SeVkConfig::FRAMEBUFFER_MAX_TEXTURES) return false;
+            if (!isSameExtent(target.texture)) return false;
+            ref = numExistingColors + numNewTextures;
+            newTextures[numNewTextures] = target.texture;
+            newAttachments[numNewTextures++] = se_vk_graph_get_color_attachment(graph, target);
+        }
+        else if (target.loadOp == SeRenderTargetLoadOp::CLEAR)
+        {
+            return false;
+        }
+        if (int64_t(ref) <= lastRef) return false;
+        lastRef = ref;
+        subpass.colorRefs |= 1 << ref;
+    }
+    //
+    // Input attachments. Attachments that aren't used by the previous subpasses are loaded
+    //
+    lastRef = -1;
+    for (uint32_t it = 0; it < SE_MAX_PASS_INPUT_ATTACHMENTS; it++)
+    {
+        const SeTextureRef texture = info.inputAttachments[it];
+        if (!texture) break;
+        uint32_t ref = findAttachment(texture);
+        if (ref == UINT32_MAX)
+        {
+            if (numExistingColors + numNewTextures + numDepthStencilAttachments == SeVkConfig::FRAMEBUFFER_MAX_TEXTURES) return false;
+            if (!isSameExtent(texture)) return false;
+            ref = numExistingColors + numNewTextures;
+            newTextures[numNewTextures] = texture;
+            newAttachments[numNewTextures++] =
+            {
+                .format     = se_vk_graph_get_texture_format(graph, texture),
+                .loadOp     = VK_ATTACHMENT_LOAD_OP_LOAD,
+                .storeOp    = VK_ATTACHMENT_STORE_OP_STORE,
+                .sampling   = VK_SAMPLE_COUNT_1_BIT,
+                .clearValue = { },
+            };
+        }
+        se_assert(!(subpass.colorRefs & (1 << ref)));
+        if (int64_t(ref) <= lastRef) return false;
+        lastRef = ref;
+        subpass.inputRefs |= 1 << ref;
+    }
+    //
+    // Depth stencil target
+    //
+    if (info.depthStencilTarget)
+    {
+        if (hasNewDepthStencil)
+        {
+            if (!isSameExtent(info.depthStencilTarget.texture)) return false;
+        }
+        else
+        {
+            if (!se_compare(group->depthStencilAttachment, info.depthStencilTarget.texture)) return false;
+            if (info.depthStencilTarget.loadOp == SeRenderTargetLoadOp::CLEAR) return false;
+        }
+    }
+    //
+    // Pass is compatible, update the group
+    //
+    for (uint32_t it = 0; it < numNewTextures; it++)
+    {
+        group->colorAttachments[renderPassInfo.numColorAttachments] = newTextures[it];
+        renderPassInfo.colorAttachments[renderPassInfo.numColorAttachments++] = newAttachments[it];
+    }
+    if (hasNewDepthStencil)
+    {
+        const SeVkTexture* const depthStencilTexture = se_vk_unref(info.depthStencilTarget.texture);
+        group->depthStencilAttachment = info.depthStencilTarget.texture;
+        renderPassInfo.hasDepthStencilAttachment = true;
+        renderPassInfo.depthStencilAttachment =
+        {
+            .format     = depthStencilTexture->format,
+            .loadOp     = se_vk_utils_to_vk_load_op(info.depthStencilTarget.loadOp),
+            .storeOp    = VK_ATTACHMENT_STORE_OP_STORE,
+            .sampling   = VK_SAMPLE_COUNT_1_BIT,  // @TODO : support multisampling (and resolve and stuff)
+            .clearValue = { .depthStencil = { .depth = 0, .stencil = 0 } },
+        };
+    }
+    renderPassInfo.subpasses[subpassIndex] = subpass;
+    renderPassInfo.numSubpasses += 1;
+    group->extent = extent;
+    return true;
+}
+
+SeVkRenderPassInfo se_vk_graph_get_render_pass_info(SeVkGraph* graph, const SeGraphicsPassInfo& info)
+{
+    const SeVkTexture* const depthStencilTexture = info.depthStencilTarget ? se_vk_unref(info.depthStencilTarget.texture) : nullptr;
+    se_assert_msg
+    (
+        (info.depthState.isTestEnabled | info.depthState.isWriteEnabled) == (depthStencilTexture != nullptr),
+        "Pipeline must have depth stensil target if depth test or depth write are enabled. If both options are disabled depth texture must be null"
+    );
+    SeVkGraphPassGroup group
+    {
+        .firstPass              = 0,
+        .numPasses              = 1,
+        .renderPassInfo         = { .device = graph->device },
+        .colorAttachments       = { },
+        .depthStencilAttachment = { },
+        .extent                 = { },
+    };
+    const bool isAdded = se_vk_graph_add_subpass(graph, &group, info);
+    se_assert_msg(isAdded, "Pass attachments must have the same extent and their number can't exceed SeVkConfig::FRAMEBUFFER_MAX_TEXTURES");
+    return group.renderPassInfo;
+}
+
+SeVkGraphicsPipelineInfo se_vk_graph_get_graphics_pipeline_info(SeVkGraph* graph, const SeGraphicsPassInfo& seInfo, const SeProgramWithConstants& fragmentProgram, SeVkRenderPass* pass)
+{
+    return
+    {
+        .device                 = graph->device,
+        .pass                   = pass,
+        .vertexProgram          = se_vk_graph_program_with_constants(seInfo.vertexProgram),
+        .fragmentProgram        = se_vk_graph_program_with_constants(fragmentProgram),
+        .subpassIndex           = 0,
+        .isStencilTestEnabled   = seInfo.frontStencilOpState.isEnabled || seInfo.backStencilOpState.isEnabled,
+        .frontStencilOpState    = seInfo.frontStencilOpState.isEnabled ? se_vk_graph_pipeline_stencil_op_state(&seInfo.frontStencilOpState) : VkStencilOpState{0},
+        .backStencilOpState     = seInfo.backStencilOpState.isEnabled ? se_vk_graph_pipeline_stencil_op_state(&seInfo.backStencilOpState) : VkStencilOpState{0},
+        .isDepthTestEnabled     = seInfo.depthState.isTestEnabled,
+        .isDepthWriteEnabled    = seInfo.depthState.isWriteEnabled,
+        .polygonMode            = se_vk_utils_to_vk_polygon_mode(seInfo.polygonMode),
+        .cullMode               = se_vk_utils_to_vk_cull_mode(seInfo.cullMode),
+        .frontFace              = se_vk_utils_to_vk_front_face(seInfo.frontFace),
+        .sampling               = se_vk_utils_to_vk_sample_count(seInfo.samplingType),
+        .renderingFormats       = { },
+    };
+}
+
+SeVkRenderPass* se_vk_graph_get_render_pass(SeVkGraph* graph, SeVkRenderPassInfo& info)
+{
+    const size_t currentFrame = graph->device->frameManager.frameNumber;
+    SeVkRenderPass* pass = se_vk_object_cache_get(graph->renderPassInfoToRenderPass, info, currentFrame);
+    if (!pass)
+    {
+        SeObjectPool<SeVkRenderPass>& renderPassPool = se_vk_memory_manager_get_pool<SeVkRenderPass>(&graph->device->memoryManager);
+        pass = se_vk_object_cache_add(graph->renderPassInfoToRenderPass, info, se_object_pool_take(renderPassPool), currentFrame);
+        se_vk_render_pass_construct(pass, &info);
+    }
+    return pass;
+}
+
+//
+// Pipelines don't depend on load and store ops and clear values (render passes that differ only in these are compatible),
+// so they are created against the render pass with normalized ops. This way passes that differ only in clears and dropped
+// stores share pipelines and prewarmed pipelines are used by all of them
+//
+SeVkRenderPass* se_vk_graph_get_compatible_render_pass(SeVkGraph* graph, const SeVkRenderPassInfo& info)
+{
+    SeVkRenderPassInfo compatibleInfo = info;
+    for (uint32_t it = 0; it < compatibleInfo.numColorAttachments; it++)
+    {
+        compatibleInfo.colorAttachments[it].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+        compatibleInfo.colorAttachments[it].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        compatibleInfo.colorAttachments[it].clearValue = { };
+    }
+    if (compatibleInfo.hasDepthStencilAttachment)
+    {
+        compatibleInfo.depthStencilAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+        compatibleInfo.depthStencilAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        compatibleInfo.depthStencilAttachment.clearValue = { };
+    }
+    return se_vk_graph_get_render_pass(graph, compatibleInfo);
+}
+
+//
+// Groups of a single graphics pass without input attachments are recorded with dynamic rendering when it's enabled, so they
+// don't need render pass and framebuffer objects (and their per-frame lookups). Merged groups and passes that read input
+// attachments need subpasses, compiled passes have prebuilt render passes and framebuffers, so these always use render passes
+//
+bool se_vk_graph_is_dynamic_rendering_group(const SeVkGraph* graph, const SeVkGraphPassGroup& group)
+{
+    const SeVkGraphPass* const firstPass = &graph->passes[group.firstPass];
+    return
+        graph->isDynamicRenderingEnabled            &&
+        firstPass->type == SeVkGraphPass::GRAPHICS  &&
+        !firstPass->compiledPass                    &&
+        group.numPasses == 1                        &&
+        group.renderPassInfo.subpasses[0].inputRefs == 0;
+}
+
+SeVkPipelineRenderingFormats se_vk_graph_get_rendering_formats(SeVkGraph* graph, const SeVkRenderPassInfo& info)
+{
+    const VkFormat depthStencilFormat = se_vk_device_get_depth_stencil_format(graph->device);
+    const bool hasStencil = info.hasDepthStencilAttachment && se_vk_device_is_stencil_supported(graph->device);
+    SeVkPipelineRenderingFormats formats
+    {
+        .colorFormats       = { },
+        .numColorFormats    = info.numColorAttachments,
+        .depthFormat        = info.hasDepthStencilAttachment ? depthStencilFormat : VK_FORMAT_UNDEFINED,
+        .stencilFormat      = hasStencil ? depthStencilFormat : VK_FORMAT_UNDEFINED,
+    };
+    se_assert(info.numColorAttachments <= SeVkConfig::FRAMEBUFFER_MAX_TEXTURES);
+    for (uint32_t it = 0; it < info.numColorAttachments; it++)
+    {
+        formats.colorFormats[it] = info.colorAttachments[it].format;
+    }
+    return formats;
+}
+
+VkRenderingAttachmentInfoKHR se_vk_graph_get_rendering_attachment_info(const SeVkTexture* texture, VkImageLayout layout, const SeVkRenderPassAttachment& attachment)
+{
+    return
+    {
+        .sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+        .pNext              = nullptr,
+        .imageView          = texture->attachmentView,
+        .imageLayout        = layout,
+        .resolveMode        = VK_RESOLVE_MODE_NONE,
+        .resolveImageView   = VK_NULL_HANDLE,
+        .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .loadOp             = attachment.loadOp,
+        .storeOp            = attachment.storeOp,
+        .clearValue         = attachment.clearValue,
+    };
+}
+
+//
+// Attachments are taken directly from the group textures. Image views are read every frame, so textures recreated by
+// the transient heap don't need any special handling (unlike cached framebuffers)
+//
+SeVkGraphDynamicRendering se_vk_graph_get_dynamic_rendering(SeVkGraph* graph, const SeVkGraphPassGroup& group, uint32_t swapChainTextureIndex)
+{
+    const SeVkRenderPassInfo& info = group.renderPassInfo;
+    SeVkGraphDynamicRendering result
+    {
+        .colorAttachments       = { },
+        .colorTextures          = { },
+        .numColorAttachments    = info.numColorAttachments,
+        .depthStencilAttachment = { },
+        .depthStencilTexture    = nullptr,
+        .formats                = se_vk_graph_get_rendering_formats(graph, info),
+        .extent                 = { group.extent.width, group.extent.height },
+    };
+    for (uint32_t it = 0; it < info.numColorAttachments; it++)
+    {
+        const SeTextureRef textureRef = group.colorAttachments[it];
+        SeVkTexture* const texture = textureRef.isSwapChain
+            ? *se_vk_device_get_swap_chain_texture(graph->device, swapChainTextureIndex)
+            : se_vk_unref(textureRef);
+        result.colorTextures[it] = texture;
+        result.colorAttachments[it] = se_vk_graph_get_rendering_attachment_info(texture, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, info.colorAttachments[it]);
+    }
+    if (info.hasDepthStencilAttachment)
+    {
+        // @NOTE : same layout as the depth attachment of the render pass (see se_vk_render_pass_construct)
+        const VkImageLayout layout = se_vk_device_is_stencil_supported(graph->device)
+            ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+            : VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
+        result.depthStencilTexture = se_vk_unref(group.depthStencilAttachment);
+        result.depthStencilAttachment = se_vk_graph_get_rendering_attachment_info(result.depthStencilTexture, layout, info.depthStencilAttachment);
+    }
+    return result;
+}
+
+//
+// Returns existing pipeline or creates a new one. New pipeline is either compiled right away (this time is
+// counted as a main thread stall) or submitted to the background compiler. Existing pipeline can still be compiling.
+//
+template<typename Info>
+SeVkPipeline* se_vk_graph_get_pipeline(SeVkGraph* graph, SeVkObjectCache<Info, SeVkPipeline>& cache, Info& info, bool isAsync)
+{
+    const size_t currentFrame = graph->device->frameManager.frameNumber;
+    SeVkPipelineCompiler* const compiler = &graph->device->pipelineCompiler;
+    if (SeVkPipeline* const cached = se_vk_object_cache_get(cache, info, currentFrame))
+    {
+        return cached;
+    }
+    SeObjectPool<SeVkPipeline>& pipelinePool = se_vk_memory_manager_get_pool<SeVkPipeline>(&graph->device->memoryManager);
+    SeVkPipeline* const pipeline = se_vk_object_cache_add(cache, info, se_object_pool_take(pipelinePool), currentFrame);
+    if constexpr (std::is_same_v<Info, SeVkGraphicsPipelineInfo>)
+    {
+        se_vk_pipeline_graphics_construct(pipeline, &info);
+        if (isAsync)
+        {
+            se_vk_pipeline_compiler_submit_graphics(compiler, pipeline, &info);
+        }
+        else
+        {
+            const uint64_t compileBegin = _se_get_perf_counter();
+            se_vk_pipeline_graphics_compile(pipeline, &info);
+            se_vk_pipeline_compiler_add_stall(compiler, compileBegin, _se_get_perf_counter());
+        }
+    }
+    else
+    {
+        se_vk_pipeline_compute_construct(pipeline, &info);
+        if (isAsync)
+        {
+            se_vk_pipeline_compiler_submit_compute(compiler, pipeline, &info);
+        }
+        else
+        {
+            const uint64_t compileBegin = _se_get_perf_counter();
+            se_vk_pipeline_compute_compile(pipeline, &info);
+            se_vk_pipeline_compiler_add_stall(compiler, compileBegin, _se_get_perf_counter());
+        }
+    }
+    return pipeline;
+}
+
 template <typename Key, typename Value>
-void se_vk_graph_free_old_resources(SeHashTable<Key, SeVkGraphWithFrame<Value>>& table, size_t currentFrame, SeVkMemoryManager* memoryManager)
+void se_vk_graph_free_old_resources(SeVkObjectCache<Key, Value>& cache, size_t currentFrame, SeVkMemoryManager* memoryManager, SeVkObjectCacheStats* stats)
 {
-    SeDynamicArray<Key> toRemove = se_dynamic_array_create<Key>(se_allocator_frame());
     SeObjectPool<Value>& pool = se_vk_memory_manager_get_pool<Value>(memoryManager);
-    for (auto kv : table)
+    se_vk_object_cache_evict(cache, currentFrame, SE_VK_GRAPH_OBJECT_LIFETIME, [&pool](Value* object)
     {
-        if (!se_hash_table_get(table, se_iterator_key(kv)))
+        se_vk_destroy(object);
+        se_object_pool_release<Value>(pool, object);
+    }, stats);
+}
+
+//
+// Reports all resource accesses of the pass to the barrier planner.
+// @NOTE : shaders aren't checked for actual writes, so storage buffers and images are considered written by compute
+//         passes and only read by graphics passes (vertex pulling, instance data, etc.)
+// Passes of the same group (render pass) are reported as a single barrier planner pass. Attachments are reported only by the
+// first pass of the group (framebuffer and dynamicRendering are null for others), input attachments are accessed as attachments too
+//
+void se_vk_graph_add_pass_accesses(SeVkGraph* graph, SeVkBarrierPlanner* planner, const SeVkGraphPass* pass, SeVkFramebuffer* framebuffer, const SeVkRenderPass* renderPass, const SeVkGraphDynamicRendering* dynamicRendering, const SeVkPipeline* pipeline)
+{
+    const SeVkFrame* const frame = se_vk_frame_manager_get_active_frame(&graph->device->frameManager);
+    const bool isCompute = pass->type == SeVkGraphPass::COMPUTE;
+    const auto addAttachmentAccess = [planner](SeVkTexture* texture, VkImageLayout layout, bool isInput)
+    {
+        const bool isDepth = se_vk_utils_is_depth_stencil_format(texture->format);
+        const VkPipelineStageFlags stages = isDepth
+            ? VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT
+            : VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | (isInput ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT : 0);
+        const VkAccessFlags access = isDepth
+            ? (layout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+                ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT
+                : VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT)
+            : VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | (isInput ? VK_ACCESS_INPUT_ATTACHMENT_READ_BIT : 0);
+        se_vk_barrier_planner_add_image_access(planner, &texture->barrierState, texture->image, texture->fullSubresourceRange, &texture->currentLayout, layout, stages, access);
+    };
+    //
+    // Render pass attachments
+    //
+    if (!isCompute && framebuffer)
+    {
+        SeVkGeneralBitmask inputRefs = 0;
+        for (uint32_t subpassIt = 0; subpassIt < renderPass->info.numSubpasses; subpassIt++)
         {
-            se_dbg_message("Probably hash table key contains pointer to value that was changed after se_hash_table_set. Key: {}", se_iterator_key(kv));
-            se_dbg_message("Table size: {}. Table members:", table.size);
-            for (auto it : table)
+            inputRefs |= renderPass->info.subpasses[subpassIt].inputRefs;
+        }
+        for (size_t texIt = 0; texIt < framebuffer->numTextures; texIt++)
+        {
+            SeVkTexture* const texture = *framebuffer->textures[texIt];
+            const bool isInput = !se_vk_utils_is_depth_stencil_format(texture->format) && (inputRefs & (SeVkGeneralBitmask(1) << texIt));
+            addAttachmentAccess(texture, renderPass->attachmentLayoutInfos[texIt].initialLayout, isInput);
+        }
+    }
+    //
+    // Dynamic rendering attachments
+    //
+    if (!isCompute && dynamicRendering)
+    {
+        for (uint32_t texIt = 0; texIt < dynamicRendering->numColorAttachments; texIt++)
+        {
+            addAttachmentAccess(dynamicRendering->colorTextures[texIt], dynamicRendering->colorAttachments[texIt].imageLayout, false);
+        }
+        if (dynamicRendering->depthStencilTexture)
+        {
+            addAttachmentAccess(dynamicRendering->depthStencilTexture, dynamicRendering->depthStencilAttachment.imageLayout, false);
+        }
+    }
+    //
+    // Bindings. Commands aren't recorded if pipeline isn't available, so bindings are skipped too
+    //
+    if (!pipeline) return;
+    const VkPipelineStageFlags shaderStages = isCompute
+        ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+        : VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    const VkAccessFlags storageAccess = isCompute
+        ? VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+        : VK_ACCESS_SHADER_READ_BIT;
+    se_vk_command_stream_for_each(&graph->commandStream, pass->commands, [&](const SeVkGraphCommand* command)
+    {
+        if (command->type == SE_VK_GRAPH_COMMAND_TYPE_BIND_INDEX_BUFFER)
+        {
+            SeVkMemoryBuffer* const buffer = ((const SeVkGraphCommandBindIndexBuffer*)command)->indices.buffer;
+            se_vk_barrier_planner_add_buffer_access(planner, &buffer->barrierState, buffer->handle, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT);
+            return;
+        }
+        if (command->type == SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDIRECT || command->type == SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT || command->type == SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT_COUNT)
+        {
+            const SeVkGraphCommandDrawIndirect* const draw = (const SeVkGraphCommandDrawIndirect*)command;
+            SeVkMemoryBuffer* const argsBuffer = draw->args.buffer;
+            se_vk_barrier_planner_add_buffer_access(planner, &argsBuffer->barrierState, argsBuffer->handle, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+            if (SeVkMemoryBuffer* const countBuffer = draw->count.buffer)
             {
-                se_dbg_message("[index: {}, key: {}, value: {}]", it.iterator->index, se_iterator_key(it), se_iterator_value(it));
+                se_vk_barrier_planner_add_buffer_access(planner, &countBuffer->barrierState, countBuffer->handle, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
             }
-            se_assert(false);
+            return;
         }
-        if ((currentFrame - se_iterator_value(kv).frame) > SE_VK_GRAPH_OBJECT_LIFETIME)
+        if (command->type == SE_VK_GRAPH_COMMAND_TYPE_DISPATCH_INDIRECT)
         {
-            se_dynamic_array_push(toRemove, se_iterator_key(kv));
+            SeVkMemoryBuffer* const argsBuffer = ((const SeVkGraphCommandDispatchIndirect*)command)->args.buffer;
+            se_vk_barrier_planner_add_buffer_access(planner, &argsBuffer->barrierState, argsBuffer->handle, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+            return;
         }
+        if (command->type != SE_VK_GRAPH_COMMAND_TYPE_BIND) return;
+        const SeVkGraphCommandBind* const bind = (const SeVkGraphCommandBind*)command;
+        const SeBinding* const bindings = se_vk_graph_command_bindings(bind);
+        for (size_t bindingIt = 0; bindingIt < bind->numBindings; bindingIt++)
+        {
+            const SeBinding& binding = bindings[bindingIt];
+            const VkDescriptorType descriptorType = pipeline->descriptorSetLayouts[bind->set].bindingInfos[binding.binding].descriptorType;
+            if (descriptorType == VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT)
+            {
+                se_assert_msg(!isCompute && se_vk_graph_is_input_attachment(pass->graphicsPassInfo, binding.texture.texture), "Texture bound to the input attachment binding must be in SeGraphicsPassInfo::inputAttachments");
+                continue;
+            }
+            if (binding.type == SeBinding::TEXTURE)
+            {
+                SeVkTexture* const texture = se_vk_unref(binding.texture.texture);
+                const bool isStorage = descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+                // @TODO : use more precise layout pick logic (different layouts for depth- or stencil-only formats) :
+                // https://vulkan.lunarg.com/doc/view/1.2.198.1/windows/1.2-extensions/vkspec.html#descriptorsets-combinedimagesample
+                const VkImageLayout layout = isStorage
+                    ? VK_IMAGE_LAYOUT_GENERAL
+                    : (se_vk_utils_is_depth_stencil_format(texture->format) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+                const VkAccessFlags access = isStorage ? storageAccess : VK_ACCESS_SHADER_READ_BIT;
+                se_vk_barrier_planner_add_image_access(planner, &texture->barrierState, texture->image, texture->fullSubresourceRange, &texture->currentLayout, layout, shaderStages, access);
+            }
+            else
+            {
+                SeVkMemoryBuffer* const buffer = binding.buffer.buffer.isScratch ? frame->scratchBuffer : se_vk_unref(binding.buffer.buffer);
+                const bool isUniform = descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+                const VkAccessFlags access = isUniform ? VK_ACCESS_UNIFORM_READ_BIT : storageAccess;
+                se_vk_barrier_planner_add_buffer_access(planner, &buffer->barrierState, buffer->handle, shaderStages, access);
+            }
+        }
+    });
+}
+
+//
+// Returns descriptor set for the bind command from the pipeline's descriptor set cache. Image descriptors use
+// texture->currentLayout, so this must be called after barriers of the pass are planned.
+// Dynamic buffer descriptors are written with zero offset, actual offsets are returned with the set
+//
+SeVkGraphDescriptorSet se_vk_graph_get_descriptor_set(SeVkGraph* graph, SeVkPipeline* pipeline, const SeVkGraphCommandBind* bind)
+{
+    SeVkFrameManager* const frameManager = &graph->device->frameManager;
+    const SeVkFrame* const frame = se_vk_frame_manager_get_active_frame(frameManager);
+    const size_t currentFrame = frameManager->frameNumber;
+    const SeVkDescriptorSetLayout* const layout = &pipeline->descriptorSetLayouts[bind->set];
+    const uint32_t numBindings = bind->numBindings;
+    const SeBinding* const bindings = se_vk_graph_command_bindings(bind);
+    uint32_t dynamicOffsets[SE_VK_GENERAL_BITMASK_WIDTH] = { }; // Indexed by binding
+    SeVkDescriptorSetWrite write = { };
+    write.key.set = bind->set;
+    write.key.numBindings = numBindings;
+    for (uint32_t bindingIt = 0; bindingIt < numBindings; bindingIt++)
+    {
+        const SeBinding* const binding = &bindings[bindingIt];
+        SeVkDescriptorBindingKey* const key = &write.key.bindings[bindingIt];
+        key->binding = binding->binding;
+        if (binding->type == SeBinding::TEXTURE)
+        {
+            //
+            // @NOTE : input attachments are read in the layout set by the render pass (render targets and depth can't
+            //         be input attachments of the same subpass) and don't need a sampler
+            //
+            const bool isInputAttachment = layout->bindingInfos[binding->binding].descriptorType == VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+            SeVkTexture* const texture = se_vk_unref(binding->texture.texture);
+            SeVkSampler* const sampler = binding->texture.sampler ? se_vk_unref(binding->texture.sampler) : nullptr;
+            se_assert_msg(sampler || isInputAttachment, "Texture binding must have a sampler");
+            const bool isStorage = layout->bindingInfos[binding->binding].descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            se_assert_msg(isInputAttachment || (texture->usage & (isStorage ? VK_IMAGE_USAGE_STORAGE_BIT : VK_IMAGE_USAGE_SAMPLED_BIT)), "Texture can't be bound to the shader binding (transient attachments can only be render targets and input attachments)");
+            const VkImageLayout imageLayout = isInputAttachment ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : texture->currentLayout;
+            key->imageLayout = imageLayout;
+            key->resources[0] = texture->object.uniqueIndex;
+            key->resources[1] = sampler ? sampler->object.uniqueIndex : 0;
+            write.infos[bindingIt].image =
+            {
+                .sampler        = sampler ? sampler->handle : VK_NULL_HANDLE,
+                .imageView      = isInputAttachment ? texture->attachmentView : texture->view,
+                .imageLayout    = imageLayout,
+            };
+        }
+        else
+        {
+            const auto& bufferBinding = binding->buffer;
+            const SeBufferRef bufferRef = binding->buffer.buffer;
+            const bool isScratch = bufferBinding.buffer.isScratch;
+
+            const SeVkMemoryBuffer* const buffer = isScratch
+                ? frame->scratchBuffer
+                : se_vk_unref(bufferRef);
+
+            se_assert_msg(!isScratch || bufferBinding.buffer.generation == currentFrame, "Scratch buffers are meant to be created every frame");
+            se_assert_msg(!isScratch || bufferBinding.offset < frame->scratchBufferViews[bufferRef.index].size, "Scratch buffer binding offset is too big");
+            se_assert_msg(!isScratch || bufferBinding.size <= (frame->scratchBufferViews[bufferRef.index].size - bufferBinding.offset), "Scratch buffer binding size is too big");
+            se_assert_msg(isScratch || bufferBinding.offset < buffer->memory.size, "Buffer binding offset is too big");
+            se_assert_msg(isScratch || bufferBinding.size <= (buffer->memory.size - bufferBinding.offset), "Buffer binding size is too big");
+
+            const size_t offset = isScratch
+                    ? frame->scratchBufferViews[bufferRef.index].offset + bufferBinding.offset
+                    : bufferBinding.offset;
+            //
+            // @NOTE : VK_WHOLE_SIZE range is computed from the descriptor offset only, so dynamic bindings need the exact range
+            //
+            const bool isDynamic = se_vk_descriptor_set_is_dynamic_type(layout->bindingInfos[binding->binding].descriptorType);
+            const size_t range = bufferBinding.size
+                    ? bufferBinding.size
+                    : (isScratch ? frame->scratchBufferViews[bufferRef.index].size - bufferBinding.offset : (isDynamic ? buffer->memory.size - offset : VK_WHOLE_SIZE));
+            const size_t descriptorOffset = isDynamic ? 0 : offset;
+            if (isDynamic) dynamicOffsets[binding->binding] = se_vk_safe_cast<uint32_t>(offset);
+            key->resources[0] = buffer->object.uniqueIndex;
+            key->offset = descriptorOffset;
+            key->range = range;
+            write.infos[bindingIt].buffer =
+            {
+                .buffer = buffer->handle,
+                .offset = descriptorOffset,
+                .range  = range,
+            };
+        }
+    }
+    SeVkGraphDescriptorSet result
+    {
+        .handle             = se_vk_descriptor_set_cache_get(&pipeline->descriptorSetCache, layout, &write, currentFrame, graph->isDescriptorSetCachingEnabled, &graph->descriptorSetStats),
+        .dynamicOffsets     = { },
+        .numDynamicOffsets  = 0,
+    };
+    // @NOTE : dynamic bindings that aren't written by the bind command still need an offset
+    for (size_t it = 0; it < layout->numBindings; it++)
+    {
+        if (!se_vk_descriptor_set_is_dynamic_type(layout->bindingInfos[it].descriptorType)) continue;
+        se_assert(result.numDynamicOffsets < SE_MAX_BINDINGS);
+        result.dynamicOffsets[result.numDynamicOffsets++] = dynamicOffsets[it];
+    }
+    return result;
+}
+
+//
+// Calls fn for every texture bound to the pass, except input attachments of graphics passes
+//
+template<typename Fn>
+void se_vk_graph_for_each_bound_texture(const SeVkGraph* graph, const SeVkGraphPass* pass, const Fn& fn)
+{
+    const bool isGraphics = pass->type == SeVkGraphPass::GRAPHICS;
+    se_vk_command_stream_for_each(&graph->commandStream, pass->commands, [&](const SeVkGraphCommand* command)
+    {
+        if (command->type != SE_VK_GRAPH_COMMAND_TYPE_BIND) return;
+        const SeVkGraphCommandBind* const bind = (const SeVkGraphCommandBind*)command;
+        const SeBinding* const bindings = se_vk_graph_command_bindings(bind);
+        for (uint32_t bindingIt = 0; bindingIt < bind->numBindings; bindingIt++)
+        {
+            const SeBinding& binding = bindings[bindingIt];
+            if (binding.type != SeBinding::TEXTURE) continue;
+            if (isGraphics && se_vk_graph_is_input_attachment(pass->graphicsPassInfo, binding.texture.texture)) continue;
+            fn(binding.texture.texture);
+        }
+    });
+}
+
+//
+// Tries to add the graphics pass to the group of the previous passes (see se_vk_graph_add_subpass). Barriers of the textures
+// bound to the merged passes are recorded before the render pass begins, so these textures can't be attachments of the same
+// render pass. boundTextures contains textures bound to the passes of the group
+//
+bool se_vk_graph_try_merge_pass(SeVkGraph* graph, SeVkGraphPassGroup* group, const SeVkGraphPass* pass, SeHashTable<SeTextureRef, bool>& boundTextures)
+{
+    const SeGraphicsPassInfo& info = pass->graphicsPassInfo;
+    bool isBoundTextureAttachment = false;
+    se_vk_graph_for_each_bound_texture(graph, pass, [&](SeTextureRef texture)
+    {
+        for (uint32_t it = 0; it < group->renderPassInfo.numColorAttachments; it++)
+            if (se_compare(group->colorAttachments[it], texture)) isBoundTextureAttachment = true;
+        if (group->renderPassInfo.hasDepthStencilAttachment && se_compare(group->depthStencilAttachment, texture))
+            isBoundTextureAttachment = true;
+    });
+    if (isBoundTextureAttachment) return false;
+    for (size_t it = 0; it < SE_MAX_PASS_RENDER_TARGETS; it++)
+    {
+        if (!info.renderTargets[it]) break;
+        if (se_hash_table_get(boundTextures, info.renderTargets[it].texture)) return false;
+    }
+    for (size_t it = 0; it < SE_MAX_PASS_INPUT_ATTACHMENTS; it++)
+    {
+        if (!info.inputAttachments[it]) break;
+        if (se_hash_table_get(boundTextures, info.inputAttachments[it])) return false;
+    }
+    if (info.depthStencilTarget && se_hash_table_get(boundTextures, info.depthStencilTarget.texture)) return false;
+    if (!se_vk_graph_add_subpass(graph, group, info)) return false;
+    se_vk_graph_for_each_bound_texture(graph, pass, [&](SeTextureRef texture) { se_hash_table_set(boundTextures, texture, true); });
+    return true;
+}
+
+//
+// Drops redundant attachment stores. Attachment contents aren't needed after the render pass if the next pass that uses
+// the texture in this frame overwrites it without reading (render target with CLEAR or DONT_CARE load op). Textures that
+// aren't used again in this frame are stored, because they can be read by the next frames (except transient textures)
+//
+void se_vk_graph_drop_redundant_stores(SeVkGraph* graph, SeDynamicArray<SeVkGraphPassGroup>& groups)
+{
+    // Texture -> true if the next pass that uses the texture reads it
+    SeHashTable<SeTextureRef, bool> nextUses = se_hash_table_create<SeTextureRef, bool>(se_allocator_frame());
+    for (size_t groupIt = se_dynamic_array_size(groups); groupIt-- > 0;)
+    {
+        SeVkGraphPassGroup& group = groups[groupIt];
+        const SeVkGraphPass* const firstPass = &graph->passes[group.firstPass];
+        if (firstPass->type == SeVkGraphPass::GRAPHICS && !firstPass->compiledPass)
+        {
+            SeVkRenderPassInfo& renderPassInfo = group.renderPassInfo;
+            const auto isStoreRedundant = [&nextUses](SeTextureRef texture) -> bool
+            {
+                const bool* const isRead = se_hash_table_get(nextUses, texture);
+                if (isRead) return !*isRead;
+                return !texture.isSwapChain && (se_vk_unref(texture)->flags & SE_VK_TEXTURE_TRANSIENT);
+            };
+            for (uint32_t it = 0; it < renderPassInfo.numColorAttachments; it++)
+            {
+                if (isStoreRedundant(group.colorAttachments[it])) renderPassInfo.colorAttachments[it].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            }
+            if (renderPassInfo.hasDepthStencilAttachment && isStoreRedundant(group.depthStencilAttachment))
+            {
+                renderPassInfo.depthStencilAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            }
+        }
+        for (size_t passIt = group.firstPass + group.numPasses; passIt-- > group.firstPass;)
+        {
+            const SeVkGraphPass* const pass = &graph->passes[passIt];
+            if (pass->type == SeVkGraphPass::GRAPHICS)
+            {
+                const SeGraphicsPassInfo& info = pass->graphicsPassInfo;
+                for (size_t it = 0; it < SE_MAX_PASS_RENDER_TARGETS; it++)
+                {
+                    const SePassRenderTarget& target = info.renderTargets[it];
+                    if (!target) break;
+                    // @NOTE : swap chain textures are always stored
+                    se_hash_table_set(nextUses, target.texture, target.texture.isSwapChain || target.loadOp == SeRenderTargetLoadOp::LOAD);
+                }
+                if (info.depthStencilTarget)
+                {
+                    se_hash_table_set(nextUses, info.depthStencilTarget.texture, info.depthStencilTarget.loadOp == SeRenderTargetLoadOp::LOAD);
+                }
+                for (size_t it = 0; it < SE_MAX_PASS_INPUT_ATTACHMENTS; it++)
+                {
+                    if (!info.inputAttachments[it]) break;
+                    se_hash_table_set(nextUses, info.inputAttachments[it], true);
+                }
+            }
+            se_vk_graph_for_each_bound_texture(graph, pass, [&](SeTextureRef texture) { se_hash_table_set(nextUses, texture, true); });
+        }
+    }
+    se_hash_table_destroy(nextUses);
+}
+
+//
+// Reports uses of the transient resources to the transient heap (see se_vulkan_transient_heap.hpp). Lifetimes are
+// measured in pass groups : passes of a group are recorded in a single render pass, so their resources can't share memory
+//
+void se_vk_graph_add_transient_uses(SeVkGraph* graph, const SeDynamicArray<SeVkGraphPassGroup>& groups)
+{
+    SeVkTransientHeap* const heap = &graph->transientHeap;
+    const auto addTextureUse = [heap](SeTextureRef texture, size_t use)
+    {
+        if (!texture.isSwapChain) se_vk_transient_heap_add_use(heap, se_vk_unref(texture), use);
+    };
+    for (size_t groupIt = 0; groupIt < se_dynamic_array_size(groups); groupIt++)
+    {
+        const SeVkGraphPassGroup& group = groups[groupIt];
+        for (size_t passIt = group.firstPass; passIt < group.firstPass + group.numPasses; passIt++)
+        {
+            const SeVkGraphPass* const pass = &graph->passes[passIt];
+            if (pass->type == SeVkGraphPass::GRAPHICS && !pass->compiledPass)
+            {
+                const SeGraphicsPassInfo& info = pass->graphicsPassInfo;
+                for (size_t it = 0; it < SE_MAX_PASS_RENDER_TARGETS; it++)
+                {
+                    if (!info.renderTargets[it]) break;
+                    addTextureUse(info.renderTargets[it].texture, groupIt);
+                }
+                if (info.depthStencilTarget) addTextureUse(info.depthStencilTarget.texture, groupIt);
+                for (size_t it = 0; it < SE_MAX_PASS_INPUT_ATTACHMENTS; it++)
+                {
+                    if (!info.inputAttachments[it]) break;
+                    addTextureUse(info.inputAttachments[it], groupIt);
+                }
+            }
+            se_vk_graph_for_each_bound_texture(graph, pass, [&](SeTextureRef texture) { addTextureUse(texture, groupIt); });
+            se_vk_command_stream_for_each(&graph->commandStream, pass->commands, [&](const SeVkGraphCommand* command)
+            {
+                switch (command->type)
+                {
+                    case SE_VK_GRAPH_COMMAND_TYPE_BIND:
+                    {
+                        const SeVkGraphCommandBind* const bind = (const SeVkGraphCommandBind*)command;
+                        const SeBinding* const bindings = se_vk_graph_command_bindings(bind);
+                        for (uint32_t bindingIt = 0; bindingIt < bind->numBindings; bindingIt++)
+                        {
+                            const SeBinding& binding = bindings[bindingIt];
+                            if (binding.type != SeBinding::BUFFER || binding.buffer.buffer.isScratch) continue;
+                            se_vk_transient_heap_add_use(heap, se_vk_unref(binding.buffer.buffer), groupIt);
+                        }
+                    } break;
+                    case SE_VK_GRAPH_COMMAND_TYPE_BIND_INDEX_BUFFER:
+                    {
+                        se_vk_transient_heap_add_use(heap, ((const SeVkGraphCommandBindIndexBuffer*)command)->indices.buffer, groupIt);
+                    } break;
+                    case SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDIRECT:
+                    case SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT:
+                    case SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT_COUNT:
+                    {
+                        const SeVkGraphCommandDrawIndirect* const draw = (const SeVkGraphCommandDrawIndirect*)command;
+                        se_vk_transient_heap_add_use(heap, draw->args.buffer, groupIt);
+                        if (draw->count.buffer) se_vk_transient_heap_add_use(heap, draw->count.buffer, groupIt);
+                    } break;
+                    case SE_VK_GRAPH_COMMAND_TYPE_DISPATCH_INDIRECT:
+                    {
+                        se_vk_transient_heap_add_use(heap, ((const SeVkGraphCommandDispatchIndirect*)command)->args.buffer, groupIt);
+                    } break;
+                    default: break;
+                }
+            });
+        }
+    }
+}
+
+//
+// Recording jobs. These are executed by the command recorder (possibly on worker threads), so they must not touch
+// anything except the command buffers they record
+//
+
+void se_vk_graph_record_viewport_and_scissor(VkCommandBuffer handle, const SeVkGraphPassRecording* recording)
+{
+    const VkExtent2D extent = recording->dynamicRendering ? recording->dynamicRendering->extent : recording->framebuffer->extent;
+    const VkViewport viewport
+    {
+        .x          = 0.0f,
+        .y          = 0.0f,
+        .width      = (float)extent.width,
+        .height     = (float)extent.height,
+        .minDepth   = 0.0f,
+        .maxDepth   = 1.0f,
+    };
+    const VkRect2D scissor
+    {
+        .offset = { 0, 0 },
+        .extent = extent,
+    };
+    vkCmdSetViewport(handle, 0, 1, &viewport);
+    vkCmdSetScissor(handle, 0, 1, &scissor);
+}
+
+//
+// Begins the render pass (or dynamic rendering) for the first pass of the group and the next subpass for others. Compute passes
+// don't need anything
+//
+void se_vk_graph_record_subpass_begin(VkCommandBuffer handle, const SeVkGraphPassRecording* recording, VkSubpassContents contents)
+{
+    if (recording->pass->type != SeVkGraphPass::GRAPHICS) return;
+    const SeVkFramebuffer* const framebuffer = recording->framebuffer;
+    const SeVkRenderPass* const renderPass = recording->renderPass;
+    if (const SeVkGraphDynamicRendering* const dynamicRendering = recording->dynamicRendering)
+    {
+        const VkRenderingInfoKHR renderingInfo
+        {
+            .sType                  = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR,
+            .pNext                  = nullptr,
+            .flags                  = contents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS ? VkRenderingFlagsKHR(VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR) : 0,
+            .renderArea             = { { 0, 0 }, dynamicRendering->extent },
+            .layerCount             = 1,
+            .viewMask               = 0,
+            .colorAttachmentCount   = dynamicRendering->numColorAttachments,
+            .pColorAttachments      = dynamicRendering->colorAttachments,
+            .pDepthAttachment       = dynamicRendering->formats.depthFormat != VK_FORMAT_UNDEFINED ? &dynamicRendering->depthStencilAttachment : nullptr,
+            .pStencilAttachment     = dynamicRendering->formats.stencilFormat != VK_FORMAT_UNDEFINED ? &dynamicRendering->depthStencilAttachment : nullptr,
+        };
+        // @NOTE : function pointers never change after device creation, so it's safe to read them here
+        recording->commandBuffer->device->gpu.cmdBeginRendering(handle, &renderingInfo);
+    }
+    else if (recording->subpass == 0)
+    {
+        const VkRenderPassBeginInfo beginInfo
+        {
+            .sType              = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+            .pNext              = nullptr,
+            .renderPass         = renderPass->handle,
+            .framebuffer        = framebuffer->handle,
+            .renderArea         = { { 0, 0 }, framebuffer->extent },
+            .clearValueCount    = se_vk_render_pass_num_attachments(renderPass),
+            .pClearValues       = renderPass->clearValues,
+        };
+        vkCmdBeginRenderPass(handle, &beginInfo, contents);
+    }
+    else
+    {
+        vkCmdNextSubpass(handle, contents);
+    }
+    if (contents == VK_SUBPASS_CONTENTS_INLINE)
+    {
+        se_vk_graph_record_viewport_and_scissor(handle, recording);
+    }
+}
+
+void se_vk_graph_record_bind_pipeline(VkCommandBuffer handle, const SeVkPipeline* pipeline)
+{
+    vkCmdBindPipeline(handle, pipeline->bindPoint, pipeline->handle);
+    if (pipeline->usesBindlessSet)
+    {
+        // @NOTE : heap set handle never changes after device creation, so it's safe to read it here
+        const VkDescriptorSet heapSet = pipeline->device->bindlessHeap.set;
+        vkCmdBindDescriptorSets(handle, pipeline->bindPoint, pipeline->layout, SE_BINDLESS_SET, 1, &heapSet, 0, nullptr);
+    }
+}
+
+//
+// Decodes commands of the pass from the command stream. Descriptor sets are stored per bind command, firstBind is the index
+// of the first bind command of the range in the pass
+//
+void se_vk_graph_record_pass_commands(VkCommandBuffer handle, const SeVkGraphPassRecording* recording, size_t firstCommand, size_t numCommands, size_t firstBind)
+{
+    if (!numCommands) return;
+    const SeVkPipeline* const pipeline = recording->pipeline;
+    const SeVkGraphDescriptorSet* descriptorSet = se_dynamic_array_raw(recording->descriptorSets) + firstBind;
+    const SeVkGraphCommand* command = se_vk_command_stream_at(recording->commandStream, firstCommand);
+    for (size_t cmdIt = 0; cmdIt < numCommands; cmdIt++, command = se_vk_graph_command_next(command))
+    {
+        switch (command->type)
+        {
+            case SE_VK_GRAPH_COMMAND_TYPE_DRAW:
+            {
+                const SeCommandDrawInfo* const draw = &((const SeVkGraphCommandDraw*)command)->info;
+                vkCmdDraw(handle, draw->numVertices, draw->numInstances, 0, 0);
+            } break;
+            case SE_VK_GRAPH_COMMAND_TYPE_DISPATCH:
+            {
+                const SeCommandDispatchInfo* const dispatch = &((const SeVkGraphCommandDispatch*)command)->info;
+                vkCmdDispatch(handle, dispatch->groupCountX, dispatch->groupCountY, dispatch->groupCountZ);
+            } break;
+            case SE_VK_GRAPH_COMMAND_TYPE_BIND:
+            {
+                const uint32_t set = ((const SeVkGraphCommandBind*)command)->set;
+                vkCmdBindDescriptorSets(handle, pipeline->bindPoint, pipeline->layout, set, 1, &descriptorSet->handle, descriptorSet->numDynamicOffsets, descriptorSet->dynamicOffsets);
+                descriptorSet += 1;
+            } break;
+            case SE_VK_GRAPH_COMMAND_TYPE_PUSH_CONSTANTS:
+            {
+                const SeVkGraphCommandPushConstants* const pushConstants = (const SeVkGraphCommandPushConstants*)command;
+                se_vk_pipeline_push_constants(pipeline, handle, se_vk_graph_command_push_constants_data(pushConstants), pushConstants->size);
+            } break;
+            case SE_VK_GRAPH_COMMAND_TYPE_BIND_INDEX_BUFFER:
+            {
+                const SeVkGraphCommandBindIndexBuffer* const indexBuffer = (const SeVkGraphCommandBindIndexBuffer*)command;
+                vkCmdBindIndexBuffer(handle, indexBuffer->indices.buffer->handle, indexBuffer->indices.offset, indexBuffer->type);
+            } break;
+            case SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED:
+            {
+                const SeCommandDrawIndexedInfo* const draw = &((const SeVkGraphCommandDrawIndexed*)command)->info;
+                vkCmdDrawIndexed(handle, draw->numIndices, draw->numInstances, draw->firstIndex, draw->vertexOffset, 0);
+            } break;
+            case SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDIRECT:
+            {
+                const SeVkGraphCommandDrawIndirect* const draw = (const SeVkGraphCommandDrawIndirect*)command;
+                vkCmdDrawIndirect(handle, draw->args.buffer->handle, draw->args.offset, draw->numDraws, sizeof(SeDrawIndirectArgs));
+            } break;
+            case SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT:
+            {
+                const SeVkGraphCommandDrawIndirect* const draw = (const SeVkGraphCommandDrawIndirect*)command;
+                vkCmdDrawIndexedIndirect(handle, draw->args.buffer->handle, draw->args.offset, draw->numDraws, sizeof(SeDrawIndexedIndirectArgs));
+            } break;
+            case SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT_COUNT:
+            {
+                const SeVkGraphCommandDrawIndirect* const draw = (const SeVkGraphCommandDrawIndirect*)command;
+                vkCmdDrawIndexedIndirectCount(handle, draw->args.buffer->handle, draw->args.offset, draw->count.buffer->handle, draw->count.offset, draw->numDraws, sizeof(SeDrawIndexedIndirectArgs));
+            } break;
+            case SE_VK_GRAPH_COMMAND_TYPE_DISPATCH_INDIRECT:
+            {
+                const SeVkGraphBufferRange* const args = &((const SeVkGraphCommandDispatchIndirect*)command)->args;
+                vkCmdDispatchIndirect(handle, args->buffer->handle, args->offset);
+            } break;
+            default: { se_assert(!"Unknown SeVkGraphCommand"); }
+        };
+    }
+}
+
+//
+// Render pass changes layouts of the attachment views only, so the first mip of a texture with mips ends up in the final
+// layout of the render pass and the other mips stay in the initial one. Other mips are moved to the final layout too,
+// so the whole texture is in texture->currentLayout after the render pass
+//
+void se_vk_graph_record_attachment_mips_layouts(VkCommandBuffer handle, const SeVkRenderPass* renderPass, const SeVkFramebuffer* framebuffer)
+{
+    VkImageMemoryBarrier barriers[SeVkConfig::FRAMEBUFFER_MAX_TEXTURES];
+    uint32_t numBarriers = 0;
+    for (size_t texIt = 0; texIt < framebuffer->numTextures; texIt++)
+    {
+        const SeVkTexture* const texture = *framebuffer->textures[texIt];
+        const SeVkRenderPassAttachmentLayoutInfo& layoutInfo = renderPass->attachmentLayoutInfos[texIt];
+        if (texture->numMips == 1 || layoutInfo.initialLayout == layoutInfo.finalLayout) continue;
+        barriers[numBarriers++] =
+        {
+            .sType                  = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext                  = nullptr,
+            .srcAccessMask          = 0,
+            .dstAccessMask          = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+            .oldLayout              = layoutInfo.initialLayout,
+            .newLayout              = layoutInfo.finalLayout,
+            .srcQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
+            .image                  = texture->image,
+            .subresourceRange       = { texture->fullSubresourceRange.aspectMask, 1, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS },
+        };
     }
-    for (auto it : toRemove)
+    if (!numBarriers) return;
+    // @NOTE : other mips aren't accessed by the render pass, barriers planned for the next passes wait for this one
+    vkCmdPipelineBarrier(handle, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, numBarriers, barriers);
+}
+
+//
+// Records the whole group of passes (render pass with all its subpasses) into the primary command buffer. Split passes
+// execute their secondary command buffers, so groups with split passes are recorded on the main thread after all jobs are done
+//
+void se_vk_graph_record_primary_job(void* userData)
+{
+    const SeVkGraphPassRecording* const first = (const SeVkGraphPassRecording*)userData;
+    const VkCommandBuffer handle = first->commandBuffer->handle;
+    se_vk_barrier_planner_record(first->barrierPlanner, first->barrierBatch, handle);
+    for (uint32_t subpassIt = 0; subpassIt < first->numSubpasses; subpassIt++)
     {
-        SeVkGraphWithFrame<Value>* value = se_hash_table_get(table, se_iterator_value(it));
-        se_assert(value);
-        se_vk_destroy(value->object);
-        se_object_pool_release<Value>(pool, value->object);
-        se_hash_table_remove(table, se_iterator_value(it));
+        const SeVkGraphPassRecording* const recording = first + subpassIt;
+        if (recording->numSecondaries)
+        {
+            VkCommandBuffer secondaryHandles[SeVkConfig::COMMAND_RECORDER_MAX_THREADS];
+            for (size_t secondaryIt = 0; secondaryIt < recording->numSecondaries; secondaryIt++)
+            {
+                secondaryHandles[secondaryIt] = recording->secondaries[secondaryIt].commandBuffer->handle;
+            }
+            se_vk_graph_record_subpass_begin(handle, recording, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+            vkCmdExecuteCommands(handle, uint32_t(recording->numSecondaries), secondaryHandles);
+            continue;
+        }
+        se_vk_graph_record_subpass_begin(handle, recording, VK_SUBPASS_CONTENTS_INLINE);
+        if (const SeVkPipeline* const pipeline = recording->pipeline)
+        {
+            se_vk_graph_record_bind_pipeline(handle, pipeline);
+            se_vk_graph_record_pass_commands(handle, recording, recording->pass->commands.begin, recording->pass->commands.numCommands, 0);
+        }
+    }
+    if (first->pass->type == SeVkGraphPass::GRAPHICS)
+    {
+        if (first->dynamicRendering)
+            first->commandBuffer->device->gpu.cmdEndRendering(handle);
+        else
+        {
+            vkCmdEndRenderPass(handle);
+            se_vk_graph_record_attachment_mips_layouts(handle, first->renderPass, first->framebuffer);
+        }
     }
-    se_dynamic_array_destroy(toRemove);
+}
+
+void se_vk_graph_record_secondary_job(void* userData)
+{
+    const SeVkGraphSecondaryRecording* const secondary = (const SeVkGraphSecondaryRecording*)userData;
+    const SeVkGraphPassRecording* const recording = secondary->passRecording;
+    const SeVkPipeline* const pipeline = recording->pipeline;
+    const VkCommandBuffer handle = secondary->commandBuffer->handle;
+    //
+    // Dynamic state and bindings aren't inherited from the primary command buffer (or other secondaries)
+    //
+    se_vk_graph_record_viewport_and_scissor(handle, recording);
+    se_vk_graph_record_bind_pipeline(handle, pipeline);
+    for (uint32_t setIt = 0; setIt < SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS; setIt++)
+    {
+        const SeVkGraphDescriptorSet* const descriptorSet = &secondary->boundSets[setIt];
+        if (descriptorSet->handle == VK_NULL_HANDLE) continue;
+        vkCmdBindDescriptorSets(handle, pipeline->bindPoint, pipeline->layout, setIt, 1, &descriptorSet->handle, descriptorSet->numDynamicOffsets, descriptorSet->dynamicOffsets);
+    }
+    if (const SeVkGraphCommandPushConstants* const pushConstants = secondary->pushConstants)
+    {
+        se_vk_pipeline_push_constants(pipeline, handle, se_vk_graph_command_push_constants_data(pushConstants), pushConstants->size);
+    }
+    if (const SeVkGraphCommandBindIndexBuffer* const indexBuffer = secondary->indexBuffer)
+    {
+        vkCmdBindIndexBuffer(handle, indexBuffer->indices.buffer->handle, indexBuffer->indices.offset, indexBuffer->type);
+    }
+    se_vk_graph_record_pass_commands(handle, recording, secondary->firstCommand, secondary->numCommands, secondary->firstBind);
+    se_vk_check(vkEndCommandBuffer(handle));
 }
 
 void se_vk_graph_construct(SeVkGraph* graph, const SeVkGraphInfo* info)
@@ -77,66 +1159,70 @@ void se_vk_graph_construct(SeVkGraph* graph, const SeVkGraphInfo* info)
         .device                     = info->device,
         .context                    = SE_VK_GRAPH_CONTEXT_TYPE_BETWEEN_FRAMES,
         .passes                     = { }, // @NOTE : constructed at begin frame
+        .commandStream              = { },
         .renderPassInfoToRenderPass             = { },
         .framebufferInfoToFramebuffer           = { },
         .graphicsPipelineInfoToGraphicsPipeline = { },
         .computePipelineInfoToComputePipeline   = { },
-        .pipelineToDescriptorPools              = { },
+        .isSubpassMergingEnabled                = true,
+        .isDynamicRenderingEnabled              = bool(se_vk_device_is_dynamic_rendering_supported(info->device)),
+        .isAsyncComputeEnabled                  = bool(se_vk_device_is_async_compute_supported(info->device)),
+        .isDescriptorSetCachingEnabled          = true,
+        .descriptorSetStats                     = { },
+        .lastFrameDescriptorSetStats            = { },
+        .lastFrameDescriptorSetTicks            = 0,
+        .lastFrameObjectCacheStats              = { },
+        .lastFrameObjectCacheTicks              = 0,
+        .transientHeap                          = { },
     };
 
-    se_hash_table_construct(graph->renderPassInfoToRenderPass, persistentAllocator, CONTAINERS_INITIAL_CAPACITY);
-    se_hash_table_construct(graph->framebufferInfoToFramebuffer, persistentAllocator, CONTAINERS_INITIAL_CAPACITY);
-    se_hash_table_construct(graph->graphicsPipelineInfoToGraphicsPipeline, persistentAllocator, CONTAINERS_INITIAL_CAPACITY);
-    se_hash_table_construct(graph->computePipelineInfoToComputePipeline, persistentAllocator, CONTAINERS_INITIAL_CAPACITY);
-    se_hash_table_construct(graph->pipelineToDescriptorPools, persistentAllocator, CONTAINERS_INITIAL_CAPACITY);
+    const SeVkTransientHeapInfo transientHeapInfo { .device = info->device };
+    se_vk_transient_heap_construct(&graph->transientHeap, &transientHeapInfo);
+    se_vk_command_stream_construct(&graph->commandStream, persistentAllocator, SE_VK_GRAPH_COMMAND_STREAM_CAPACITY);
+
+    se_vk_object_cache_construct(graph->renderPassInfoToRenderPass, persistentAllocator, CONTAINERS_INITIAL_CAPACITY);
+    se_vk_object_cache_construct(graph->framebufferInfoToFramebuffer, persistentAllocator, CONTAINERS_INITIAL_CAPACITY);
+    se_vk_object_cache_construct(graph->graphicsPipelineInfoToGraphicsPipeline, persistentAllocator, CONTAINERS_INITIAL_CAPACITY);
+    se_vk_object_cache_construct(graph->computePipelineInfoToComputePipeline, persistentAllocator, CONTAINERS_INITIAL_CAPACITY);
 }
 
 void se_vk_graph_destroy(SeVkGraph* graph)
 {
-    const VkDevice logicalHandle = se_vk_device_get_logical_handle(graph->device);
-    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&graph->device->memoryManager);
-
     se_dynamic_array_destroy(graph->passes);
+    se_vk_command_stream_destroy(&graph->commandStream);
 
-    se_hash_table_destroy(graph->renderPassInfoToRenderPass);
-    se_hash_table_destroy(graph->framebufferInfoToFramebuffer);
-    se_hash_table_destroy(graph->graphicsPipelineInfoToGraphicsPipeline);
-    se_hash_table_destroy(graph->computePipelineInfoToComputePipeline);
+    se_vk_object_cache_destroy(graph->renderPassInfoToRenderPass);
+    se_vk_object_cache_destroy(graph->framebufferInfoToFramebuffer);
+    se_vk_object_cache_destroy(graph->graphicsPipelineInfoToGraphicsPipeline);
+    se_vk_object_cache_destroy(graph->computePipelineInfoToComputePipeline);
 
-    for (auto kv : graph->pipelineToDescriptorPools)
-    {
-        auto& pools = se_iterator_value(kv); 
-        for (size_t it = 0; it < pools.numPools; it++)
-            vkDestroyDescriptorPool(logicalHandle, pools.pools[it].handle, callbacks);
-    };
-    se_hash_table_destroy(graph->pipelineToDescriptorPools);
+    se_vk_transient_heap_destroy(&graph->transientHeap);
 }
 
 void se_vk_graph_begin_frame(SeVkGraph* graph)
 {
     se_assert(graph->context == SE_VK_GRAPH_CONTEXT_TYPE_BETWEEN_FRAMES);
 
-    const VkDevice logicalHandle = se_vk_device_get_logical_handle(graph->device);
     SeVkMemoryManager* const memoryManager = &graph->device->memoryManager;
-    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(memoryManager);
     SeVkFrameManager* const frameManager = &graph->device->frameManager;
     const size_t currentFrame = frameManager->frameNumber;
-    const size_t frameIndex = se_vk_frame_manager_get_active_frame_index(frameManager);
+    graph->descriptorSetStats = { };
 
-    for (auto kv : graph->pipelineToDescriptorPools)
-    {
-        auto& pools = se_iterator_value(kv);
-        if ((currentFrame - pools.lastFrame) <= SE_VK_GRAPH_OBJECT_LIFETIME) continue;
-        for (size_t it = 0; it < pools.numPools; it++)
-            vkDestroyDescriptorPool(logicalHandle, pools.pools[it].handle, callbacks);
-        se_iterator_remove(kv);
-    }
-    se_vk_graph_free_old_resources(graph->graphicsPipelineInfoToGraphicsPipeline, currentFrame, memoryManager);
-    se_vk_graph_free_old_resources(graph->computePipelineInfoToComputePipeline, currentFrame, memoryManager);
-    se_vk_graph_free_old_resources(graph->framebufferInfoToFramebuffer, currentFrame, memoryManager);
-    se_vk_graph_free_old_resources(graph->renderPassInfoToRenderPass, currentFrame, memoryManager);
+    // @NOTE : pending compile jobs reference pipelines and render passes, so those are kept alive until compiler is idle
+    const uint64_t evictionBeginTicks = _se_get_perf_counter();
+    SeVkObjectCacheStats* const cacheStats = &graph->lastFrameObjectCacheStats;
+    *cacheStats = { };
+    const bool isCompilerBusy = se_vk_pipeline_compiler_is_busy(&graph->device->pipelineCompiler);
+    if (!isCompilerBusy) se_vk_graph_free_old_resources(graph->graphicsPipelineInfoToGraphicsPipeline, currentFrame, memoryManager, cacheStats);
+    if (!isCompilerBusy) se_vk_graph_free_old_resources(graph->computePipelineInfoToComputePipeline, currentFrame, memoryManager, cacheStats);
+    se_vk_graph_free_old_resources(graph->framebufferInfoToFramebuffer, currentFrame, memoryManager, cacheStats);
+    if (!isCompilerBusy) se_vk_graph_free_old_resources(graph->renderPassInfoToRenderPass, currentFrame, memoryManager, cacheStats);
+    graph->lastFrameObjectCacheTicks = _se_get_perf_counter() - evictionBeginTicks;
+
+    se_vk_transient_heap_begin_frame(&graph->transientHeap);
 
     se_dynamic_array_construct(graph->passes, se_allocator_frame(), CONTAINERS_INITIAL_CAPACITY);
+    se_vk_command_stream_reset(&graph->commandStream);
 
     graph->context = SE_VK_GRAPH_CONTEXT_TYPE_IN_FRAME;
 }
@@ -151,13 +1237,11 @@ void se_vk_graph_end_frame(SeVkGraph* graph)
 
     SeObjectPool<SeVkRenderPass>&     renderPassPool      = se_vk_memory_manager_get_pool<SeVkRenderPass>(memoryManager);
     SeObjectPool<SeVkFramebuffer>&    framebufferPool     = se_vk_memory_manager_get_pool<SeVkFramebuffer>(memoryManager);
-    SeObjectPool<SeVkPipeline>&       pipelinePool        = se_vk_memory_manager_get_pool<SeVkPipeline>(memoryManager);
+    SeVkPipelineCompiler* const       pipelineCompiler    = &graph->device->pipelineCompiler;
     
-    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(memoryManager);
     SeVkFrameManager* const frameManager = &graph->device->frameManager;
     SeVkFrame* const frame = se_vk_frame_manager_get_active_frame(frameManager);
     const size_t currentFrame = frameManager->frameNumber;
-    const size_t frameIndex = se_vk_frame_manager_get_active_frame_index(frameManager);
 
     //
     // Acquire next image and wait for last frame that used this image
@@ -172,60 +1256,132 @@ void se_vk_graph_end_frame(SeVkGraph* graph)
         VK_NULL_HANDLE,
         &swapChainTextureIndex
     ));
-    if (frameManager->imageToFrame[swapChainTextureIndex] != SE_VK_FRAME_MANAGER_INVALID_FRAME)
+    const uint64_t imageTimelineValue = frameManager->imageTimelineValues[swapChainTextureIndex];
+    if (imageTimelineValue)
     {
-        const SeVkFrame* const prevImageFrame = &frameManager->frames[frameManager->imageToFrame[swapChainTextureIndex]];
-        const SeVkCommandBuffer* const* const lastBuffer = se_dynamic_array_last(prevImageFrame->commandBuffers);
-        if (lastBuffer)
-        {
-            const VkFence fence = (*lastBuffer)->fence;
-            vkWaitForFences(logicalHandle, 1, &fence, VK_TRUE, UINT64_MAX);
-        }
+        se_vk_utils_wait_timeline(logicalHandle, frameManager->timelineSemaphore, imageTimelineValue);
     }
-    frameManager->imageToFrame[swapChainTextureIndex] = frameIndex;
+    //
+    // @NOTE : frame submission waits for the acquired image at the color attachment output stage, so the first
+    //         barrier of the swap chain image must wait for this stage to form a dependency chain with the semaphore
+    //
+    SeVkTexture* const swapChainTexture = *se_vk_device_get_swap_chain_texture(graph->device, swapChainTextureIndex);
+    swapChainTexture->barrierState = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, 0, 0, 0 };
 
     //
-    // Render passes
+    // Pass groups. Consecutive graphics passes are merged into subpasses of a single render pass when possible (see
+    // se_vk_graph_try_merge_pass), every other pass is a group of its own. Compiled passes have prebuilt render passes
+    // and framebuffers, so they are never merged
     //
 
     const size_t numPasses = se_dynamic_array_size(graph->passes);
-    SeDynamicArray<SeVkRenderPass*> frameRenderPasses = se_dynamic_array_create<SeVkRenderPass*>(frameAllocator, numPasses);
-    for (size_t it = 0; it < numPasses; it++)
+    SeDynamicArray<SeVkGraphPassGroup> groups = se_dynamic_array_create<SeVkGraphPassGroup>(frameAllocator, numPasses);
     {
-        const bool isCompute = graph->passes[it].type == SeVkGraphPass::COMPUTE;
-        if (isCompute)
+        const auto isMergeable = [graph](size_t passIndex) -> bool
         {
-            se_dynamic_array_push(frameRenderPasses, nullptr);
-        }
-        else
+            const SeVkGraphPass* const pass = &graph->passes[passIndex];
+            return pass->type == SeVkGraphPass::GRAPHICS && !pass->compiledPass;
+        };
+        SeHashTable<SeTextureRef, bool> boundTextures = se_hash_table_create<SeTextureRef, bool>(frameAllocator);
+        for (size_t it = 0; it < numPasses; it++)
         {
-            SeVkRenderPassInfo& info = graph->passes[it].renderPassInfo;
-            SeVkGraphWithFrame<SeVkRenderPass>* pass = se_hash_table_get(graph->renderPassInfoToRenderPass, info);
-            if (!pass)
+            const SeVkGraphPass* const pass = &graph->passes[it];
+            const size_t numGroups = se_dynamic_array_size(groups);
+            if (graph->isSubpassMergingEnabled && numGroups && isMergeable(it) && isMergeable(groups[numGroups - 1].firstPass))
             {
-                pass = se_hash_table_set(graph->renderPassInfoToRenderPass, info, { se_object_pool_take(renderPassPool), currentFrame });
-                se_vk_render_pass_construct(pass->object, &info);
+                SeVkGraphPassGroup& lastGroup = groups[numGroups - 1];
+                if (se_vk_graph_try_merge_pass(graph, &lastGroup, pass, boundTextures))
+                {
+                    lastGroup.numPasses += 1;
+                    continue;
+                }
             }
-            else
+            SeVkGraphPassGroup& group = se_dynamic_array_push(groups,
             {
-                pass->frame = currentFrame;
+                .firstPass              = it,
+                .numPasses              = 1,
+                .renderPassInfo         = { .device = graph->device },
+                .colorAttachments       = { },
+                .depthStencilAttachment = { },
+                .extent                 = { },
+            });
+            se_hash_table_reset(boundTextures);
+            if (isMergeable(it))
+            {
+                const bool isAdded = se_vk_graph_add_subpass(graph, &group, pass->graphicsPassInfo);
+                se_assert(isAdded);
+                se_vk_graph_for_each_bound_texture(graph, pass, [&](SeTextureRef texture) { se_hash_table_set(boundTextures, texture, true); });
             }
-            se_dynamic_array_push(frameRenderPasses, pass->object);
+        }
+        se_hash_table_destroy(boundTextures);
+    }
+    se_vk_graph_drop_redundant_stores(graph, groups);
+    const size_t numGroups = se_dynamic_array_size(groups);
+
+    //
+    // Transient resources. Must be placed before framebuffers are created, because placement can recreate images
+    //
+
+    se_vk_graph_add_transient_uses(graph, groups);
+    se_vk_transient_heap_place(&graph->transientHeap);
+
+    //
+    // Render passes. Pipelines are created against compatible render passes (see se_vk_graph_get_compatible_render_pass).
+    // Groups recorded with dynamic rendering don't have render passes and framebuffers (see se_vk_graph_is_dynamic_rendering_group)
+    //
+
+    const uint64_t setupBeginTicks = _se_get_perf_counter();
+    size_t numDynamicRenderingGroups = 0;
+    SeDynamicArray<SeVkRenderPass*> frameRenderPasses = se_dynamic_array_create<SeVkRenderPass*>(frameAllocator, numGroups);
+    SeDynamicArray<SeVkRenderPass*> compatibleRenderPasses = se_dynamic_array_create<SeVkRenderPass*>(frameAllocator, numGroups);
+    for (size_t it = 0; it < numGroups; it++)
+    {
+        SeVkGraphPassGroup& group = groups[it];
+        const SeVkGraphPass* const firstPass = &graph->passes[group.firstPass];
+        if (firstPass->type == SeVkGraphPass::COMPUTE)
+        {
+            se_dynamic_array_push(frameRenderPasses, nullptr);
+            se_dynamic_array_push(compatibleRenderPasses, nullptr);
+        }
+        else if (SeVkCompiledPass* const compiledPass = firstPass->compiledPass)
+        {
+            se_dynamic_array_push(frameRenderPasses, compiledPass->renderPass);
+            se_dynamic_array_push(compatibleRenderPasses, compiledPass->renderPass);
+        }
+        else if (se_vk_graph_is_dynamic_rendering_group(graph, group))
+        {
+            se_dynamic_array_push(frameRenderPasses, nullptr);
+            se_dynamic_array_push(compatibleRenderPasses, nullptr);
+            numDynamicRenderingGroups += 1;
+        }
+        else
+        {
+            se_dynamic_array_push(frameRenderPasses, se_vk_graph_get_render_pass(graph, group.renderPassInfo));
+            se_dynamic_array_push(compatibleRenderPasses, se_vk_graph_get_compatible_render_pass(graph, group.renderPassInfo));
         }
     }
 
     //
-    // Framebuffers
+    // Framebuffers (or dynamic rendering attachments). Dynamic rendering array has an entry for every group, so recordings
+    // can point to its elements
     //
 
-    SeDynamicArray<SeVkFramebuffer*> frameFramebuffers = se_dynamic_array_create<SeVkFramebuffer*>(frameAllocator, numPasses);
-    for (size_t it = 0; it < numPasses; it++)
+    SeDynamicArray<SeVkFramebuffer*> frameFramebuffers = se_dynamic_array_create<SeVkFramebuffer*>(frameAllocator, numGroups);
+    SeDynamicArray<SeVkGraphDynamicRendering> frameDynamicRenderings = se_dynamic_array_create<SeVkGraphDynamicRendering>(frameAllocator, numGroups);
+    for (size_t it = 0; it < numGroups; it++)
     {
-        const SeVkGraphPass* pass = &graph->passes[it];
-        if (pass->type == SeVkGraphPass::COMPUTE)
+        const SeVkGraphPassGroup& group = groups[it];
+        const SeVkGraphPass* const firstPass = &graph->passes[group.firstPass];
+        const bool isDynamicRendering = se_vk_graph_is_dynamic_rendering_group(graph, group);
+        se_dynamic_array_push(frameDynamicRenderings, isDynamicRendering ? se_vk_graph_get_dynamic_rendering(graph, group, swapChainTextureIndex) : SeVkGraphDynamicRendering{ });
+        if (firstPass->type == SeVkGraphPass::COMPUTE || isDynamicRendering)
         {
             se_dynamic_array_push(frameFramebuffers, nullptr);
         }
+        else if (firstPass->compiledPass)
+        {
+            se_dynamic_array_push(frameFramebuffers, se_vk_compiled_pass_get_framebuffer(firstPass->compiledPass, swapChainTextureIndex));
+        }
         else
         {
             SeVkFramebufferInfo info
@@ -233,532 +1389,538 @@ void se_vk_graph_end_frame(SeVkGraph* graph)
                 .device         = graph->device,
                 .pass           = se_object_pool_to_ref(renderPassPool, frameRenderPasses[it]),
                 .textures       = { },
-                .numTextures    = pass->renderPassInfo.numColorAttachments + (pass->renderPassInfo.hasDepthStencilAttachment ? 1 : 0),
+                .numTextures    = group.renderPassInfo.numColorAttachments + (group.renderPassInfo.hasDepthStencilAttachment ? 1 : 0),
+                .textureIds     = { },
             };
-            for (size_t textureIt = 0; textureIt < pass->renderPassInfo.numColorAttachments; textureIt++)
+            for (size_t textureIt = 0; textureIt < group.renderPassInfo.numColorAttachments; textureIt++)
             {
-                const SeTextureRef textureRef = pass->graphicsPassInfo.renderTargets[textureIt].texture;
+                const SeTextureRef textureRef = group.colorAttachments[textureIt];
                 if (textureRef.isSwapChain)
                     info.textures[textureIt] = se_vk_device_get_swap_chain_texture(graph->device, swapChainTextureIndex);
                 else
                     info.textures[textureIt] = se_vk_to_pool_ref(textureRef);
             }
-            if (pass->renderPassInfo.hasDepthStencilAttachment)
-                info.textures[info.numTextures - 1] = se_vk_to_pool_ref(pass->graphicsPassInfo.depthStencilTarget.texture);
+            if (group.renderPassInfo.hasDepthStencilAttachment)
+                info.textures[info.numTextures - 1] = se_vk_to_pool_ref(group.depthStencilAttachment);
+            for (size_t textureIt = 0; textureIt < info.numTextures; textureIt++)
+                info.textureIds[textureIt] = (*info.textures[textureIt])->object.uniqueIndex;
 
-            SeVkGraphWithFrame<SeVkFramebuffer>* framebuffer = se_hash_table_get(graph->framebufferInfoToFramebuffer, info);
+            SeVkFramebuffer* framebuffer = se_vk_object_cache_get(graph->framebufferInfoToFramebuffer, info, currentFrame);
             if (!framebuffer)
             {
-                SeVkFramebuffer* _framebuffer = se_object_pool_take(framebufferPool);
-                se_vk_framebuffer_construct(_framebuffer, &info);
-                framebuffer = se_hash_table_set(graph->framebufferInfoToFramebuffer, info, { _framebuffer, currentFrame });
+                framebuffer = se_vk_object_cache_add(graph->framebufferInfoToFramebuffer, info, se_object_pool_take(framebufferPool), currentFrame);
+                se_vk_framebuffer_construct(framebuffer, &info);
             }
-            else
-            {
-                framebuffer->frame = currentFrame;
-            }
-            se_dynamic_array_push(frameFramebuffers, framebuffer->object);
+            se_dynamic_array_push(frameFramebuffers, framebuffer);
         }
     }
 
     //
-    // Pipelines
+    // Pipelines (one per pass, pass index in its group is the subpass index)
     //
 
     SeDynamicArray<SeVkPipeline*> framePipelines = se_dynamic_array_create<SeVkPipeline*>(frameAllocator, numPasses);
-    for (size_t it = 0; it < numPasses; it++)
+    for (size_t groupIt = 0; groupIt < numGroups; groupIt++)
     {
-        SeVkPipeline* pipeline = nullptr;
-        const bool isCompute = graph->passes[it].type == SeVkGraphPass::COMPUTE;
-        if (isCompute)
+        const SeVkGraphPassGroup& group = groups[groupIt];
+        SeVkRenderPass* const compatibleRenderPass = compatibleRenderPasses[groupIt];
+        const SeVkGraphDynamicRendering* const dynamicRendering = se_vk_graph_is_dynamic_rendering_group(graph, group) ? &frameDynamicRenderings[groupIt] : nullptr;
+        for (size_t it = group.firstPass; it < group.firstPass + group.numPasses; it++)
         {
-            se_assert(!frameRenderPasses[it]);
-            const SeComputePassInfo& seInfo = graph->passes[it].computePassInfo;
-            SeVkProgramWithConstants program
-            {
-                .program                    = se_vk_unref(seInfo.program.program),
-                .constants                  = { },
-                .numSpecializationConstants = seInfo.program.numSpecializationConstants,
-            };
-            memcpy(program.constants, seInfo.program.specializationConstants, sizeof(SeSpecializationConstant) * seInfo.program.numSpecializationConstants);
-            SeVkComputePipelineInfo vkInfo
-            {
-                .device = graph->device,
-                .program = program,
-            };
-            SeVkGraphWithFrame<SeVkPipeline>* pipelineTimed = se_hash_table_get(graph->computePipelineInfoToComputePipeline, vkInfo);
-            if (!pipelineTimed)
+            const uint32_t subpassIndex = uint32_t(it - group.firstPass);
+            SeVkPipeline* pipeline = nullptr;
+            SeVkPipeline* compiledFallbackPipeline = nullptr;
+            SePipelineCompilationPolicy policy = SePipelineCompilationPolicy::WAIT;
+            bool hasFallback = false;
+            const bool isCompute = graph->passes[it].type == SeVkGraphPass::COMPUTE;
+            if (SeVkCompiledPass* const compiledPass = graph->passes[it].compiledPass)
             {
-                pipelineTimed = se_hash_table_set(graph->computePipelineInfoToComputePipeline, vkInfo, { se_object_pool_take(pipelinePool), currentFrame });
-                se_vk_pipeline_compute_construct(pipelineTimed->object, &vkInfo);
+                pipeline = compiledPass->pipeline;
+                compiledFallbackPipeline = compiledPass->fallbackPipeline;
+                policy = isCompute ? graph->passes[it].computePassInfo.compilationPolicy : graph->passes[it].graphicsPassInfo.compilationPolicy;
+                hasFallback = compiledFallbackPipeline != nullptr;
             }
-            else
+            else if (isCompute)
             {
-                pipelineTimed->frame = currentFrame;
+                se_assert(!compatibleRenderPass);
+                const SeComputePassInfo& seInfo = graph->passes[it].computePassInfo;
+                policy = seInfo.compilationPolicy;
+                SeVkComputePipelineInfo vkInfo
+                {
+                    .device = graph->device,
+                    .program = se_vk_graph_program_with_constants(seInfo.program),
+                };
+                pipeline = se_vk_graph_get_pipeline(graph, graph->computePipelineInfoToComputePipeline, vkInfo, policy != SePipelineCompilationPolicy::WAIT);
             }
-            pipeline = pipelineTimed->object;
-        }
-        else
-        {
-            se_assert(frameRenderPasses[it]);
-            const SeGraphicsPassInfo& seInfo = graph->passes[it].graphicsPassInfo;
-            SeVkProgramWithConstants vertexProgram
-            {
-                .program                    = se_vk_unref(seInfo.vertexProgram.program),
-                .constants                  = { },
-                .numSpecializationConstants = seInfo.vertexProgram.numSpecializationConstants,
-            };
-            memcpy(vertexProgram.constants, seInfo.vertexProgram.specializationConstants, sizeof(SeSpecializationConstant) * seInfo.vertexProgram.numSpecializationConstants);
-            SeVkProgramWithConstants fragmentProgram
-            {
-                .program                    = se_vk_unref(seInfo.fragmentProgram.program),
-                .constants                  = { },
-                .numSpecializationConstants = seInfo.fragmentProgram.numSpecializationConstants,
-            };
-            memcpy(fragmentProgram.constants, seInfo.fragmentProgram.specializationConstants, sizeof(SeSpecializationConstant) * seInfo.fragmentProgram.numSpecializationConstants);
-            SeVkGraphicsPipelineInfo vkInfo
-            {
-                .device                 = graph->device,
-                .pass                   = frameRenderPasses[it],
-                .vertexProgram          = vertexProgram,
-                .fragmentProgram        = fragmentProgram,
-                .subpassIndex           = 0,
-                .isStencilTestEnabled   = seInfo.frontStencilOpState.isEnabled || seInfo.backStencilOpState.isEnabled,
-                .frontStencilOpState    = seInfo.frontStencilOpState.isEnabled ? se_vk_graph_pipeline_stencil_op_state(&seInfo.frontStencilOpState) : VkStencilOpState{0},
-                .backStencilOpState     = seInfo.backStencilOpState.isEnabled ? se_vk_graph_pipeline_stencil_op_state(&seInfo.backStencilOpState) : VkStencilOpState{0},
-                .isDepthTestEnabled     = seInfo.depthState.isTestEnabled,
-                .isDepthWriteEnabled    = seInfo.depthState.isWriteEnabled,
-                .polygonMode            = se_vk_utils_to_vk_polygon_mode(seInfo.polygonMode),
-                .cullMode               = se_vk_utils_to_vk_cull_mode(seInfo.cullMode),
-                .frontFace              = se_vk_utils_to_vk_front_face(seInfo.frontFace),
-                .sampling               = se_vk_utils_to_vk_sample_count(seInfo.samplingType),
-            };
-            SeVkGraphWithFrame<SeVkPipeline>* pipelineTimed = se_hash_table_get(graph->graphicsPipelineInfoToGraphicsPipeline, vkInfo);
-            if (!pipelineTimed)
+            else
             {
-                pipelineTimed = se_hash_table_set(graph->graphicsPipelineInfoToGraphicsPipeline, vkInfo, { se_object_pool_take(pipelinePool), currentFrame });
-                se_vk_pipeline_graphics_construct(pipelineTimed->object, &vkInfo);
+                se_assert(compatibleRenderPass || dynamicRendering);
+                const SeGraphicsPassInfo& seInfo = graph->passes[it].graphicsPassInfo;
+                policy = seInfo.compilationPolicy;
+                hasFallback = seInfo.fallbackFragmentProgram.program;
+                SeVkGraphicsPipelineInfo vkInfo = se_vk_graph_get_graphics_pipeline_info(graph, seInfo, seInfo.fragmentProgram, compatibleRenderPass);
+                vkInfo.subpassIndex = subpassIndex;
+                if (dynamicRendering) vkInfo.renderingFormats = dynamicRendering->formats;
+                pipeline = se_vk_graph_get_pipeline(graph, graph->graphicsPipelineInfoToGraphicsPipeline, vkInfo, policy != SePipelineCompilationPolicy::WAIT);
             }
-            else
+            se_assert(pipeline);
+            if (!se_vk_pipeline_is_compiled(pipeline))
             {
-                pipelineTimed->frame = currentFrame;
+                if (policy == SePipelineCompilationPolicy::WAIT)
+                {
+                    se_vk_pipeline_compiler_wait(pipelineCompiler, pipeline);
+                }
+                else if (policy == SePipelineCompilationPolicy::FALLBACK && compiledFallbackPipeline)
+                {
+                    pipeline = compiledFallbackPipeline;
+                    se_vk_pipeline_compiler_wait(pipelineCompiler, pipeline);
+                    pipelineCompiler->numFallbackPasses += 1;
+                }
+                else if (policy == SePipelineCompilationPolicy::FALLBACK && hasFallback)
+                {
+                    const SeGraphicsPassInfo& seInfo = graph->passes[it].graphicsPassInfo;
+                    SeVkGraphicsPipelineInfo vkInfo = se_vk_graph_get_graphics_pipeline_info(graph, seInfo, seInfo.fallbackFragmentProgram, compatibleRenderPass);
+                    vkInfo.subpassIndex = subpassIndex;
+                    if (dynamicRendering) vkInfo.renderingFormats = dynamicRendering->formats;
+                    pipeline = se_vk_graph_get_pipeline(graph, graph->graphicsPipelineInfoToGraphicsPipeline, vkInfo, false);
+                    se_vk_pipeline_compiler_wait(pipelineCompiler, pipeline);
+                    pipelineCompiler->numFallbackPasses += 1;
+                }
+                else
+                {
+                    // @NOTE : pass is still recorded (render targets are loaded/cleared and stored), but without any commands
+                    pipeline = nullptr;
+                    pipelineCompiler->numSkippedPasses += 1;
+                }
             }
-            pipeline = pipelineTimed->object;
+            se_dynamic_array_push(framePipelines, pipeline);
         }
-        se_assert(pipeline);
-        se_dynamic_array_push(framePipelines, pipeline);
     }
 
     //
-    // Reset descriptor pools
+    // Record command buffers
+    //
+    // Recording is done in three steps :
+    // 1. Preparation (main thread, pass order). Command buffer allocation, barrier planning and descriptor set
+    //    allocation and writes are done here, because they use non thread safe systems or depend on the pass order.
+    //    Passes of the same group share a command buffer and a barrier batch
+    // 2. Recording (command recorder lanes). Group is recorded on lane (group index % number of lanes). Large graphics
+    //    passes are split into secondary command buffers which are recorded on different lanes
+    // 3. Submission (main thread, pass order). Groups with split passes are recorded here (they execute secondary
+    //    command buffers), then the whole frame is submitted at once (see "Submit frame" below)
+    // Lanes are assigned deterministically, so recorded commands and submission order don't depend on thread timings
     //
 
-    for (auto kv : graph->pipelineToDescriptorPools)
+    SeVkCommandRecorder* const commandRecorder = &graph->device->commandRecorder;
+    const uint64_t recordingBeginTicks = _se_get_perf_counter();
+    const uint64_t setupTicks = recordingBeginTicks - setupBeginTicks;
+    const size_t numLanes = se_vk_command_recorder_get_num_lanes(commandRecorder);
+    se_assert(numPasses <= SE_MAX_PASS_DEPENDENCIES);
+    uint64_t uploadTimelineValue = 0;
+    uint64_t descriptorSetTicks = 0;
+    SeVkBarrierPlanner barrierPlanner;
+    se_vk_barrier_planner_construct(&barrierPlanner, frameAllocator);
+    SeDynamicArray<SeVkGraphPassRecording> recordings = se_dynamic_array_create<SeVkGraphPassRecording>(frameAllocator, numPasses);
+    SeDynamicArray<SeVkGraphSecondaryRecording> secondaries = se_dynamic_array_create<SeVkGraphSecondaryRecording>(frameAllocator, numPasses);
+    SeDynamicArray<size_t> passNumChunks = se_dynamic_array_create<size_t>(frameAllocator, numPasses);
+    //
+    // Queue scheduling (see se_vulkan_queue_scheduler.hpp). Groups report barrier states of their resources, so dependencies
+    // between groups match the planned barriers. Transient resources and the swap chain image can't be used on the async compute
+    // queue : aliased memory is synchronized only within the main queue and swap chain images are exclusive to the graphics family
+    //
+    SeVkQueueScheduler scheduler;
+    se_vk_queue_scheduler_construct(&scheduler, frameAllocator, graph->isAsyncComputeEnabled);
+    SeHashTable<SeVkBarrierResourceState*, bool> mainQueueStates = se_hash_table_create<SeVkBarrierResourceState*, bool>(frameAllocator);
+    SeDynamicArray<uint64_t> passGroupBits = se_dynamic_array_create<uint64_t>(frameAllocator, numPasses);
+    if (graph->isAsyncComputeEnabled)
     {
-        const auto& info = se_iterator_key(kv);
-        auto& pools = se_iterator_value(kv);
-        if (info.frame == frameIndex)
+        se_hash_table_set(mainQueueStates, &swapChainTexture->barrierState, true);
+        for (auto it : graph->transientHeap.resources)
         {
-            for (size_t it = 0; it < pools.numPools; it++)
-            {
-                pools.pools[it].isLastAllocationSuccessful = true;
-                vkResetDescriptorPool(logicalHandle, pools.pools[it].handle, 0);
-            }
+            SeVkObject* const object = se_iterator_value(it).object;
+            SeVkBarrierResourceState* const state = object->type == SeVkObject::Type::TEXTURE
+                ? &((SeVkTexture*)object)->barrierState
+                : &((SeVkMemoryBuffer*)object)->barrierState;
+            se_hash_table_set(mainQueueStates, state, true);
         }
     }
-
-    //
-    // Record command buffers
-    //
-
-    SePassDependencies queuePresentDependencies = 0;    
-    se_assert(numPasses <= SE_MAX_PASS_DEPENDENCIES);
-    for (size_t it = 0; it < numPasses; it++)
+    for (size_t groupIt = 0; groupIt < numGroups; groupIt++)
+    {
+        for (size_t it = 0; it < groups[groupIt].numPasses; it++) se_dynamic_array_push(passGroupBits, uint64_t(1) << groupIt);
+    }
+    size_t numAsyncComputePasses = 0;
+    for (size_t groupIt = 0; groupIt < numGroups; groupIt++)
     {
-        queuePresentDependencies |= 1ull << it;
-        SeVkGraphPass* const graphPass = &graph->passes[it];
-        SeVkPipeline* const pipeline = framePipelines[it];
-        SeVkFramebuffer* const framebuffer = frameFramebuffers[it];
-        SeVkRenderPass* const renderPass = frameRenderPasses[it];
+        const SeVkGraphPassGroup& group = groups[groupIt];
+        SeVkFramebuffer* const framebuffer = frameFramebuffers[groupIt];
+        SeVkRenderPass* const renderPass = frameRenderPasses[groupIt];
+        const SeVkGraphDynamicRendering* const dynamicRendering = se_vk_graph_is_dynamic_rendering_group(graph, group) ? &frameDynamicRenderings[groupIt] : nullptr;
+        const SeVkGraphPass* const firstPass = &graph->passes[group.firstPass];
         //
-        // Get or allocate descriptor pool
+        // Split passes are recorded into secondary command buffers, so primary buffer of the group with a split pass
+        // is recorded on the main thread after all jobs are done
         //
-        SeVkGraphDescriptorPoolArray* descriptorPools = nullptr;
+        bool hasSplitPasses = false;
+        se_dynamic_array_reset(passNumChunks);
+        for (size_t it = group.firstPass; it < group.firstPass + group.numPasses; it++)
         {
-            SeVkGraphPipelineWithFrame pipelineWithFrame
-            {
-                .pipeline = pipeline,
-                .frame = frameIndex,
-            };
-            descriptorPools = se_hash_table_get(graph->pipelineToDescriptorPools, pipelineWithFrame);
-            if (!descriptorPools)
-            {
-                descriptorPools = se_hash_table_set(graph->pipelineToDescriptorPools, pipelineWithFrame, { });
-            }
+            const size_t numCommands = graph->passes[it].commands.numCommands;
+            const size_t numChunks = (graph->passes[it].type == SeVkGraphPass::GRAPHICS && framePipelines[it] && numLanes > 1)
+                ? se_min(numLanes, numCommands / SeVkConfig::GRAPH_SECONDARY_BUFFER_MIN_COMMANDS)
+                : 0;
+            hasSplitPasses |= numChunks > 1;
+            se_dynamic_array_push(passNumChunks, numChunks);
         }
-        descriptorPools->lastFrame = currentFrame;
+        const size_t lane = hasSplitPasses ? 0 : groupIt % numLanes;
         //
-        // Create command buffer
+        // Plan barriers for the whole group (all of them are recorded before the render pass begins). Descriptor sets are
+        // written after this, because image descriptors use the planned layouts
         //
-        SeVkCommandBufferInfo cmdInfo
+        se_vk_barrier_planner_begin_pass(&barrierPlanner);
+        for (size_t it = group.firstPass; it < group.firstPass + group.numPasses; it++)
         {
-            .device = graph->device,
-            .usage  = graphPass->type == SeVkGraphPass::COMPUTE
-                        ? SE_VK_COMMAND_BUFFER_USAGE_COMPUTE
-                        : (SE_VK_COMMAND_BUFFER_USAGE_GRAPHICS | SE_VK_COMMAND_BUFFER_USAGE_TRANSFER),
-        };
-        SeVkCommandBuffer* commandBuffer = se_vk_frame_manager_get_cmd(frameManager, &cmdInfo);
+            const bool isFirst = it == group.firstPass;
+            se_vk_graph_add_pass_accesses(graph, &barrierPlanner, &graph->passes[it], isFirst ? framebuffer : nullptr, renderPass, isFirst ? dynamicRendering : nullptr, framePipelines[it]);
+        }
         //
-        // Get list of all texture layout transitions necessary for this pass
+        // Pick the queue. Scheduler keeps every group on the graphics queue if async compute isn't enabled
         //
-        SeHashTable<SeVkTexture*, VkImageLayout> transitions;
-        se_hash_table_construct(transitions, se_allocator_frame(), SeVkConfig::FRAMEBUFFER_MAX_TEXTURES + SE_MAX_BINDINGS);
-        if (graphPass->type == SeVkGraphPass::GRAPHICS)
+        bool isAsyncCompute = firstPass->type == SeVkGraphPass::COMPUTE && firstPass->computePassInfo.isAsyncCompute;
+        for (auto it : barrierPlanner.passAccesses)
         {
-            for (size_t texIt = 0; texIt < framebuffer->numTextures; texIt++)
-            {
-                SeVkTexture* texture = *framebuffer->textures[texIt];
-                se_hash_table_set(transitions, texture, renderPass->attachmentLayoutInfos[texIt].initialLayout);
-            }
+            if (se_hash_table_get(mainQueueStates, se_iterator_value(it).state)) isAsyncCompute = false;
         }
-        for (auto cmdIt : graphPass->commands)
+        const SeVkScheduledQueue queue = se_vk_queue_scheduler_add_group(&scheduler, isAsyncCompute);
+        for (auto it : barrierPlanner.passAccesses)
         {
-            const SeVkGraphCommand& command = se_iterator_value(cmdIt);
-            if (command.type == SE_VK_GRAPH_COMMAND_TYPE_BIND)
-            {
-                const uint32_t numBindings = se_vk_graph_get_num_bindings(command.info.bind);
-                for (size_t bindingIt = 0; bindingIt < numBindings; bindingIt++)
-                {
-                    const SeBinding& binding = command.info.bind.bindings[bindingIt];
-                    if (binding.type == SeBinding::TEXTURE)
-                    {
-                        SeVkTexture* const texture = se_vk_unref(binding.texture.texture);
-                        const bool isDepth = se_vk_utils_is_depth_stencil_format(texture->format);
-                        VkImageLayout* const layout = se_hash_table_get(transitions, texture);
-                        if (!layout)
-                        {
-                            // @TODO : use more precise layout pick logic (different layouts for depth- or stencil-only formats) :
-                            // https://vulkan.lunarg.com/doc/view/1.2.198.1/windows/1.2-extensions/vkspec.html#descriptorsets-combinedimagesample
-                            const VkImageLayout newLayout = se_vk_utils_is_depth_stencil_format(texture->format)
-                                ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
-                                : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                            se_hash_table_set(transitions, texture, newLayout);
-                        }
-                        else if ((*layout != VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL) && (*layout != VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL))
-                        {
-                            *layout = VK_IMAGE_LAYOUT_GENERAL; // Is this correct ?
-                        }
-                    }
-                }
-            }
+            const SeVkBarrierAccess& access = se_iterator_value(it);
+            se_vk_queue_scheduler_add_access(&scheduler, access.state, se_vk_barrier_planner_is_write(access));
         }
-        //
-        // Transition image layouts
-        //
-        VkImageMemoryBarrier imageBarriers[SeVkConfig::FRAMEBUFFER_MAX_TEXTURES + SE_MAX_BINDINGS];
-        uint32_t numImageBarriers = 0;
-        VkPipelineStageFlags srcPipelineStageFlags = 0;
-        VkPipelineStageFlags dstPipelineStageFlags = 0;
-        for (auto transitionIt : transitions)
+        for (size_t it = group.firstPass; it < group.firstPass + group.numPasses; it++)
         {
-            SeVkTexture* texture = se_iterator_key(transitionIt);
-            VkImageLayout layout = se_iterator_value(transitionIt);
-            if (texture->currentLayout != layout)
+            const SeVkGraphPass* const pass = &graph->passes[it];
+            const SePassDependencies dependencies = pass->type == SeVkGraphPass::COMPUTE ? pass->computePassInfo.dependencies : pass->graphicsPassInfo.dependencies;
+            uint64_t groupDependencies = 0;
+            for (size_t depIt = 0; depIt < group.firstPass; depIt++)
             {
-                imageBarriers[numImageBarriers++] =
-                {
-                    .sType                  = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-                    .pNext                  = nullptr,
-                    .srcAccessMask          = se_vk_utils_image_layout_to_access_flags(texture->currentLayout),
-                    .dstAccessMask          = se_vk_utils_image_layout_to_access_flags(layout),
-                    .oldLayout              = texture->currentLayout,
-                    .newLayout              = layout,
-                    .srcQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
-                    .dstQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
-                    .image                  = texture->image,
-                    .subresourceRange       = texture->fullSubresourceRange,
-                };
-                srcPipelineStageFlags |= se_vk_utils_image_layout_to_pipeline_stage_flags(texture->currentLayout);
-                dstPipelineStageFlags |= se_vk_utils_image_layout_to_pipeline_stage_flags(layout);
-                texture->currentLayout = layout;
+                if (dependencies & (SePassDependencies(1) << depIt)) groupDependencies |= passGroupBits[depIt];
             }
+            se_vk_queue_scheduler_add_dependencies(&scheduler, groupDependencies);
         }
-        if (numImageBarriers)
-        {
-            vkCmdPipelineBarrier
-            (
-                commandBuffer->handle,
-                srcPipelineStageFlags,
-                dstPipelineStageFlags,
-                0,
-                0,
-                nullptr,
-                0,
-                nullptr,
-                numImageBarriers,
-                imageBarriers
-            );
+        if (queue == SE_VK_SCHEDULED_QUEUE_ASYNC_COMPUTE)
+        {
+            se_vk_barrier_planner_set_pass_queue(&barrierPlanner, SE_VK_GRAPH_ASYNC_COMPUTE_BARRIER_QUEUE);
+            numAsyncComputePasses += group.numPasses;
         }
+        const size_t barrierBatch = se_vk_barrier_planner_end_pass(&barrierPlanner);
         //
-        // Begin pass
+        // Create command buffer
         //
-        if (graphPass->type == SeVkGraphPass::GRAPHICS)
+        const SeVkCommandBufferUsageFlags usage = queue == SE_VK_SCHEDULED_QUEUE_ASYNC_COMPUTE
+            ? SE_VK_COMMAND_BUFFER_USAGE_COMPUTE
+            : (SE_VK_COMMAND_BUFFER_USAGE_GRAPHICS | SE_VK_COMMAND_BUFFER_USAGE_TRANSFER);
+        SeVkCommandBufferInfo cmdInfo
         {
-            const VkViewport viewport
-            {
-                .x          = 0.0f,
-                .y          = 0.0f,
-                .width      = (float)framebuffer->extent.width,
-                .height     = (float)framebuffer->extent.height,
-                .minDepth   = 0.0f,
-                .maxDepth   = 1.0f,
-            };
-            const VkRect2D scissor
-            {
-                .offset = { 0, 0 },
-                .extent = framebuffer->extent,
-            };
-            vkCmdSetViewport(commandBuffer->handle, 0, 1, &viewport);
-            vkCmdSetScissor(commandBuffer->handle, 0, 1, &scissor);
-            const VkRenderPassBeginInfo beginInfo
-            {
-                .sType              = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-                .pNext              = nullptr,
-                .renderPass         = renderPass->handle,
-                .framebuffer        = framebuffer->handle,
-                .renderArea         = { { 0, 0 }, framebuffer->extent },
-                .clearValueCount    = se_vk_render_pass_num_attachments(renderPass),
-                .pClearValues       = renderPass->clearValues,
-            };
-            vkCmdBeginRenderPass(commandBuffer->handle, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
-        }
-        vkCmdBindPipeline(commandBuffer->handle, pipeline->bindPoint, pipeline->handle);
+            .device         = graph->device,
+            .usage          = usage,
+            .pool           = VK_NULL_HANDLE,
+            .inheritance    = nullptr,
+        };
+        SeVkCommandBuffer* const commandBuffer = se_vk_frame_manager_get_cmd(frameManager, &cmdInfo, lane);
         //
-        // Record commands
+        // First command buffer of the frame waits for all pending uploads (first group is always on the graphics queue)
         //
-        for (auto cmdIt : graphPass->commands)
+        if (groupIt == 0)
+        {
+            uploadTimelineValue = se_vk_transfer_manager_acquire(&graph->device->transferManager, commandBuffer);
+        }
+        for (size_t it = group.firstPass; it < group.firstPass + group.numPasses; it++)
         {
-            SeVkGraphCommand& command = se_iterator_value(cmdIt);
-            switch (command.type)
+            const SeVkGraphPass* const graphPass = &graph->passes[it];
+            SeVkPipeline* const pipeline = framePipelines[it];
+            const size_t numCommands = graphPass->commands.numCommands;
+            const size_t numChunks = passNumChunks[it - group.firstPass];
+            const bool isSplit = numChunks > 1;
+            const uint32_t subpass = uint32_t(it - group.firstPass);
+            SeVkGraphPassRecording& recording = se_dynamic_array_push(recordings,
             {
-                case SE_VK_GRAPH_COMMAND_TYPE_DRAW:
-                {
-                    const SeCommandDrawInfo* const draw = &command.info.draw;
-                    vkCmdDraw(commandBuffer->handle, draw->numVertices, draw->numInstances, 0, 0);
-                } break;
-                case SE_VK_GRAPH_COMMAND_TYPE_DISPATCH:
-                {
-                    const SeCommandDispatchInfo* const dispatch = &command.info.dispatch;
-                    vkCmdDispatch(commandBuffer->handle, dispatch->groupCountX, dispatch->groupCountY, dispatch->groupCountZ);
-                } break;
-                case SE_VK_GRAPH_COMMAND_TYPE_BIND:
+                .pass                   = graphPass,
+                .commandStream          = &graph->commandStream,
+                .commandBuffer          = commandBuffer,
+                .renderPass             = renderPass,
+                .framebuffer            = framebuffer,
+                .dynamicRendering       = dynamicRendering,
+                .pipeline               = pipeline,
+                .barrierPlanner         = &barrierPlanner,
+                .barrierBatch           = barrierBatch,
+                .descriptorSets         = se_dynamic_array_create<SeVkGraphDescriptorSet>(frameAllocator, se_max(graphPass->commands.numBinds, size_t(1))),
+                .lane                   = lane,
+                .subpass                = subpass,
+                .numSubpasses           = subpass == 0 ? uint32_t(group.numPasses) : 0,
+                .firstSecondary         = se_dynamic_array_size(secondaries),
+                .numSecondaries         = 0,
+                .secondaries            = nullptr,
+            });
+            //
+            // Get descriptor sets (see se_vulkan_descriptor_set.hpp). Split passes also get secondary command buffers here, each of them
+            // remembers state set by the preceding commands (descriptor sets, push constants and index buffer), so it can be recorded independently
+            //
+            const size_t chunkSize = isSplit ? (numCommands + numChunks - 1) / numChunks : numCommands;
+            SeVkGraphDescriptorSet boundSets[SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS] = { };
+            const SeVkGraphCommandPushConstants* pushConstants = nullptr;
+            const SeVkGraphCommandBindIndexBuffer* indexBuffer = nullptr;
+            size_t commandOffset = graphPass->commands.begin;
+            for (size_t cmdIt = 0; cmdIt < numCommands; cmdIt++)
+            {
+                if (isSplit && (cmdIt % chunkSize) == 0)
                 {
-                    const SeCommandBindInfo* const bindCommandInfo = &command.info.bind;
-                    const uint32_t numBindings = se_vk_graph_get_num_bindings(*bindCommandInfo);
-                    se_assert(numBindings);
-                    se_assert(pipeline->numDescriptorSetLayouts > bindCommandInfo->set);
-                    //
-                    // Allocate descriptor set
-                    //
-                    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+                    // @NOTE : secondary buffers of the dynamic rendering group inherit attachment formats instead of the render pass
+                    const VkCommandBufferInheritanceRenderingInfoKHR inheritanceRenderingInfo
                     {
-                        SeVkGraphDescriptorPool* pool = nullptr;
-                        for (size_t poolIt = 0; poolIt < descriptorPools->numPools; poolIt++)
-                        {
-                            if (descriptorPools->pools[poolIt].isLastAllocationSuccessful)
-                            {
-                                pool = &descriptorPools->pools[poolIt];
-                                break;
-                            }
-                        }
-                        if (pool)
-                        {
-                            VkDescriptorSetAllocateInfo allocateInfo
-                            {
-                                .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-                                .pNext              = nullptr,
-                                .descriptorPool     = pool->handle,
-                                .descriptorSetCount = 1,
-                                .pSetLayouts        = &pipeline->descriptorSetLayouts[bindCommandInfo->set].handle,
-                            };
-                            // @NOTE : no se_vk_check here, because it is fine if this vkAllocateDescriptorSets call fails
-                            vkAllocateDescriptorSets(logicalHandle, &allocateInfo, &descriptorSet);
-                        }
-                        if (descriptorSet == VK_NULL_HANDLE)
-                        {
-                            if (pool) pool->isLastAllocationSuccessful = false;
-                            se_assert(descriptorPools->numPools < SeVkConfig::GRAPH_MAX_POOLS_IN_ARRAY);
-                            SeVkGraphDescriptorPool newPool
-                            {
-                                .handle = VK_NULL_HANDLE,
-                                .isLastAllocationSuccessful = true,
-                            };
-                            se_vk_check(vkCreateDescriptorPool(logicalHandle, &pipeline->descriptorSetLayouts[bindCommandInfo->set].poolCreateInfo, callbacks, &newPool.handle));
-                            descriptorPools->pools[descriptorPools->numPools++] = newPool;
-                            VkDescriptorSetAllocateInfo allocateInfo
-                            {
-                                .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-                                .pNext              = nullptr,
-                                .descriptorPool     = newPool.handle,
-                                .descriptorSetCount = 1,
-                                .pSetLayouts        = &pipeline->descriptorSetLayouts[bindCommandInfo->set].handle,
-                            };
-                            se_vk_check(vkAllocateDescriptorSets(logicalHandle, &allocateInfo, &descriptorSet));
-                            se_assert(descriptorSet != VK_NULL_HANDLE);
-                        }
-                    }
-                    //
-                    // Write and bind descriptor set
-                    //
-                    VkDescriptorImageInfo imageInfos[SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS] = {};
-                    VkDescriptorBufferInfo bufferInfos[SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS] = {};
-                    VkWriteDescriptorSet writes[SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS] = {};
-                    for (uint32_t bindingIt = 0; bindingIt < numBindings; bindingIt++)
+                        .sType                      = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR,
+                        .pNext                      = nullptr,
+                        .flags                      = 0,
+                        .viewMask                   = 0,
+                        .colorAttachmentCount       = dynamicRendering ? dynamicRendering->formats.numColorFormats : 0,
+                        .pColorAttachmentFormats    = dynamicRendering ? dynamicRendering->formats.colorFormats : nullptr,
+                        .depthAttachmentFormat      = dynamicRendering ? dynamicRendering->formats.depthFormat : VK_FORMAT_UNDEFINED,
+                        .stencilAttachmentFormat    = dynamicRendering ? dynamicRendering->formats.stencilFormat : VK_FORMAT_UNDEFINED,
+                        .rasterizationSamples       = VK_SAMPLE_COUNT_1_BIT,
+                    };
+                    const VkCommandBufferInheritanceInfo inheritanceInfo
                     {
-                        const SeBinding* const binding = &bindCommandInfo->bindings[bindingIt];
-                        VkWriteDescriptorSet write
-                        {
-                            .sType              = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                            .pNext              = nullptr,
-                            .dstSet             = descriptorSet,
-                            .dstBinding         = binding->binding,
-                            .dstArrayElement    = 0,
-                            .descriptorCount    = 1,
-                            .descriptorType     = pipeline->descriptorSetLayouts[bindCommandInfo->set].bindingInfos[binding->binding].descriptorType,
-                            .pImageInfo         = nullptr,
-                            .pBufferInfo        = nullptr,
-                            .pTexelBufferView   = nullptr,
-                        };
-                        if (binding->type == SeBinding::TEXTURE)
-                        {
-                            SeVkTexture* const texture = se_vk_unref(binding->texture.texture);
-                            SeVkSampler* const sampler = se_vk_unref(binding->texture.sampler);
-                            VkDescriptorImageInfo* const imageInfo = &imageInfos[bindingIt];
-                            *imageInfo =
-                            {
-                                .sampler        = sampler->handle,
-                                .imageView      = texture->view,
-                                .imageLayout    = texture->currentLayout,
-                            };
-                            write.pImageInfo = imageInfo;
-                        }
-                        else
-                        {
-                            const auto& bufferBinding = binding->buffer;
-                            const SeBufferRef bufferRef = binding->buffer.buffer;
-                            const bool isScratch = bufferBinding.buffer.isScratch;
-
-                            const SeVkMemoryBuffer* const buffer = isScratch
-                                ? frame->scratchBuffer
-                                : se_vk_unref(bufferRef);
-                            VkDescriptorBufferInfo* const bufferInfo = &bufferInfos[bindingIt];
-
-                            se_assert_msg(!isScratch || bufferBinding.buffer.generation == currentFrame, "Scratch buffers are meant to be created every frame");
-                            se_assert_msg(!isScratch || bufferBinding.offset < frame->scratchBufferViews[bufferRef.index].size, "Scratch buffer binding offset is too big");
-                            se_assert_msg(!isScratch || bufferBinding.size <= (frame->scratchBufferViews[bufferRef.index].size - bufferBinding.offset), "Scratch buffer binding size is too big");
-                            se_assert_msg(isScratch || bufferBinding.offset < buffer->memory.size, "Buffer binding offset is too big");
-                            se_assert_msg(isScratch || bufferBinding.size <= (buffer->memory.size - bufferBinding.offset), "Buffer binding size is too big");
-
-                            const size_t offset = isScratch
-                                    ? frame->scratchBufferViews[bufferRef.index].offset + bufferBinding.offset
-                                    : bufferBinding.offset;
-                            const size_t range = bufferBinding.size
-                                    ? bufferBinding.size
-                                    : (isScratch ? frame->scratchBufferViews[bufferRef.index].size - bufferBinding.offset : VK_WHOLE_SIZE);
-                            *bufferInfo =
-                            {
-                                .buffer = buffer->handle,
-                                .offset = offset,
-                                .range  = range,
-                            };
-                            write.pBufferInfo = bufferInfo;
-                        }
-                        writes[bindingIt] = write;
-                    }
-                    vkUpdateDescriptorSets(logicalHandle, numBindings, writes, 0, nullptr);
-                    vkCmdBindDescriptorSets(commandBuffer->handle, pipeline->bindPoint, pipeline->layout, bindCommandInfo->set, 1, &descriptorSet, 0, nullptr);
-                } break;
-                default: { se_assert(!"Unknown SeVkGraphCommand"); }
-            };
+                        .sType                  = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+                        .pNext                  = dynamicRendering ? &inheritanceRenderingInfo : nullptr,
+                        .renderPass             = dynamicRendering ? VK_NULL_HANDLE : renderPass->handle,
+                        .subpass                = subpass,
+                        .framebuffer            = dynamicRendering ? VK_NULL_HANDLE : framebuffer->handle,
+                        .occlusionQueryEnable   = VK_FALSE,
+                        .queryFlags             = 0,
+                        .pipelineStatistics     = 0,
+                    };
+                    const size_t secondaryLane = (it + recording.numSecondaries) % numLanes;
+                    SeVkCommandBufferInfo secondaryCmdInfo
+                    {
+                        .device         = graph->device,
+                        .usage          = usage,
+                        .pool           = VK_NULL_HANDLE,
+                        .inheritance    = &inheritanceInfo,
+                    };
+                    SeVkGraphSecondaryRecording& secondary = se_dynamic_array_push(secondaries,
+                    {
+                        .passRecording  = nullptr,
+                        .commandBuffer  = se_vk_frame_manager_get_cmd(frameManager, &secondaryCmdInfo, secondaryLane),
+                        .firstCommand   = commandOffset,
+                        .numCommands    = se_min(chunkSize, numCommands - cmdIt),
+                        .firstBind      = se_dynamic_array_size(recording.descriptorSets),
+                        .boundSets      = { },
+                        .pushConstants  = pushConstants,
+                        .indexBuffer    = indexBuffer,
+                        .lane           = secondaryLane,
+                    });
+                    memcpy(secondary.boundSets, boundSets, sizeof(boundSets));
+                    recording.numSecondaries += 1;
+                }
+                const SeVkGraphCommand* const command = se_vk_command_stream_at(&graph->commandStream, commandOffset);
+                commandOffset += command->size;
+                if (pipeline && command->type == SE_VK_GRAPH_COMMAND_TYPE_PUSH_CONSTANTS)
+                {
+                    se_assert_msg(pipeline->pushConstantStages, "Push constants command is used, but pass programs don't declare push constants");
+                    pushConstants = (const SeVkGraphCommandPushConstants*)command;
+                }
+                if (command->type == SE_VK_GRAPH_COMMAND_TYPE_BIND_INDEX_BUFFER)
+                {
+                    indexBuffer = (const SeVkGraphCommandBindIndexBuffer*)command;
+                }
+                const bool isIndexedDraw =
+                    command->type == SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED ||
+                    command->type == SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT ||
+                    command->type == SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT_COUNT;
+                se_assert_msg(!isIndexedDraw || indexBuffer, "Indexed draw is used, but index buffer isn't bound in the pass");
+                if (command->type != SE_VK_GRAPH_COMMAND_TYPE_BIND) continue;
+                SeVkGraphDescriptorSet descriptorSet = { };
+                if (pipeline)
+                {
+                    const SeVkGraphCommandBind* const bind = (const SeVkGraphCommandBind*)command;
+                    se_assert(bind->numBindings);
+                    se_assert_msg(bind->set != SE_BINDLESS_SET, "Bindless heap set is bound automatically");
+                    se_assert(pipeline->numDescriptorSetLayouts > bind->set);
+                    const uint64_t descriptorSetBeginTicks = _se_get_perf_counter();
+                    descriptorSet = se_vk_graph_get_descriptor_set(graph, pipeline, bind);
+                    descriptorSetTicks += _se_get_perf_counter() - descriptorSetBeginTicks;
+                    boundSets[bind->set] = descriptorSet;
+                }
+                se_dynamic_array_push(recording.descriptorSets, descriptorSet);
+            }
+            se_assert(commandOffset == graphPass->commands.end);
         }
         //
-        // End render pass and submit command buffer
+        // Attachments end up in the final layouts of the render pass (input attachments are shader read only after the
+        // last subpass that reads them). Barrier planner tracks layouts only up to the beginning of the render pass
         //
-        if (graphPass->type == SeVkGraphPass::GRAPHICS)
+        if (framebuffer)
         {
-            vkCmdEndRenderPass(commandBuffer->handle);
+            for (size_t texIt = 0; texIt < framebuffer->numTextures; texIt++)
+            {
+                SeVkTexture* const texture = *framebuffer->textures[texIt];
+                texture->currentLayout = renderPass->attachmentLayoutInfos[texIt].finalLayout;
+            }
         }
-        SeVkCommandBufferSubmitInfo submitInfo = { };
-        size_t depCounter = 0;
-        const SePassDependencies deps = graphPass->type == SeVkGraphPass::GRAPHICS ? graphPass->graphicsPassInfo.dependencies : graphPass->computePassInfo.dependencies;
-        if (deps)
+    }
+
+    //
+    // Record groups on the command recorder lanes
+    //
+
+    SeDynamicArray<SeVkCommandRecorderJob> recordingJobs = se_dynamic_array_create<SeVkCommandRecorderJob>(frameAllocator, numGroups + se_dynamic_array_size(secondaries));
+    SeDynamicArray<const SeVkGraphPassRecording*> mainThreadRecordings = se_dynamic_array_create<const SeVkGraphPassRecording*>(frameAllocator, numGroups);
+    for (size_t groupIt = 0; groupIt < numGroups; groupIt++)
+    {
+        const SeVkGraphPassGroup& group = groups[groupIt];
+        const SeVkGraphPassRecording* const first = &recordings[group.firstPass];
+        bool hasSplitPasses = false;
+        for (size_t it = group.firstPass; it < group.firstPass + group.numPasses; it++)
         {
-            for (size_t depIt = 0; depIt < SE_MAX_PASS_DEPENDENCIES; depIt++)
+            SeVkGraphPassRecording* const recording = &recordings[it];
+            recording->secondaries = se_dynamic_array_raw(secondaries) + recording->firstSecondary;
+            hasSplitPasses |= recording->numSecondaries > 0;
+            for (size_t secondaryIt = 0; secondaryIt < recording->numSecondaries; secondaryIt++)
             {
-                if (deps & (1ull << depIt))
-                {
-                    se_assert(depIt < it);
-                    submitInfo.executeAfter[depCounter++] = frame->commandBuffers[depIt];
-                    queuePresentDependencies &= ~(1ull << depIt);
-                }
+                SeVkGraphSecondaryRecording* const secondary = &secondaries[recording->firstSecondary + secondaryIt];
+                secondary->passRecording = recording;
+                se_dynamic_array_push(recordingJobs, { se_vk_graph_record_secondary_job, (void*)secondary, secondary->lane });
             }
         }
-        se_vk_command_buffer_submit(commandBuffer, &submitInfo);
+        if (hasSplitPasses)
+            se_dynamic_array_push(mainThreadRecordings, first);
+        else
+            se_dynamic_array_push(recordingJobs, { se_vk_graph_record_primary_job, (void*)first, first->lane });
     }
+    se_vk_command_recorder_execute(commandRecorder, se_dynamic_array_raw(recordingJobs), se_dynamic_array_size(recordingJobs));
 
     //
-    // Present swap chain image
+    // Record groups with split passes (secondary command buffers are ready at this point)
+    //
+
+    for (auto it : mainThreadRecordings)
+    {
+        se_vk_graph_record_primary_job((void*)se_iterator_value(it));
+    }
+
+    //
+    // Transition swap chain image layout
     //
 
     {
-        //
-        // Transition swap chain image layout
-        //
         SeVkCommandBufferInfo cmdInfo
         {
             .device = graph->device,
-            .usage  = SE_VK_COMMAND_BUFFER_USAGE_TRANSFER,
-        };
-        SeVkCommandBuffer* const transitionCmd = se_vk_frame_manager_get_cmd(frameManager, &cmdInfo);
-        SeVkTexture* const swapChainTexture = *se_vk_device_get_swap_chain_texture(graph->device, swapChainTextureIndex);
-        const VkImageMemoryBarrier swapChainImageBarrier
-        {
-            .sType                  = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-            .pNext                  = nullptr,
-            .srcAccessMask          = se_vk_utils_image_layout_to_access_flags(swapChainTexture->currentLayout),
-            .dstAccessMask          = se_vk_utils_image_layout_to_access_flags(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR),
-            .oldLayout              = swapChainTexture->currentLayout,
-            .newLayout              = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-            .srcQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
-            .dstQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
-            .image                  = swapChainTexture->image,
-            .subresourceRange       = swapChainTexture->fullSubresourceRange,
+            .usage  = SE_VK_COMMAND_BUFFER_USAGE_GRAPHICS,
         };
-        vkCmdPipelineBarrier
+        SeVkCommandBuffer* const transitionCmd = se_vk_frame_manager_get_cmd(frameManager, &cmdInfo, 0);
+        se_vk_barrier_planner_begin_pass(&barrierPlanner);
+        se_vk_barrier_planner_add_image_access
         (
-            transitionCmd->handle,
-            se_vk_utils_image_layout_to_pipeline_stage_flags(swapChainTexture->currentLayout),
+            &barrierPlanner,
+            &swapChainTexture->barrierState,
+            swapChainTexture->image,
+            swapChainTexture->fullSubresourceRange,
+            &swapChainTexture->currentLayout,
+            VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
             se_vk_utils_image_layout_to_pipeline_stage_flags(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR),
-            0,
-            0,
-            nullptr,
-            0,
-            nullptr,
-            1,
-            &swapChainImageBarrier
+            se_vk_utils_image_layout_to_access_flags(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR)
         );
-        swapChainTexture->currentLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-        SeVkCommandBufferSubmitInfo submitInfo = { };
-        size_t depCounter = 0;
-        for (size_t depIt = 0; depIt < SE_MAX_PASS_DEPENDENCIES; depIt++)
+        se_vk_barrier_planner_record(&barrierPlanner, se_vk_barrier_planner_end_pass(&barrierPlanner), transitionCmd->handle);
+    }
+
+    //
+    // Submit frame
+    //
+    // Submissions are planned by the queue scheduler : consecutive command buffers of the same queue go to a single
+    // vkQueueSubmit, so without async compute the whole frame is one submission. Ordering inside a queue is handled by the
+    // planned barriers. Each submission signals the next value of its queue timeline (values are assigned by the scheduler,
+    // timelines are described in se_vulkan_frame_manager.hpp) and waits for the other queue only if it depends on it.
+    // Last submission is always on the graphics queue (swap chain transition), it waits for all async compute work of
+    // the frame and signals the present semaphore.
+    //
+
+    {
+        SeVkTransferManager* const transferManager = &graph->device->transferManager;
+        const VkQueue queues[] =
+        {
+            se_vk_device_get_command_queue(graph->device, SE_VK_CMD_QUEUE_GRAPHICS),
+            se_vk_device_get_command_queue(graph->device, SE_VK_CMD_QUEUE_COMPUTE),
+        };
+        const VkSemaphore timelineSemaphores[] = { frameManager->timelineSemaphore, frameManager->asyncComputeTimelineSemaphore };
+        const VkSemaphore presentSemaphore = frameManager->imagePresentSemaphores[swapChainTextureIndex];
+        SeVkCommandBuffer* const* const commandBuffers = se_dynamic_array_raw(frame->commandBuffers);
+        // @NOTE : one command buffer per group and the swap chain transition
+        se_assert(se_dynamic_array_size(frame->commandBuffers) == numGroups + 1);
+        se_vk_queue_scheduler_schedule(&scheduler);
+        uint64_t timelineValues[SE_VK_SCHEDULED_QUEUE_COUNT] = { frameManager->timelineValue, frameManager->asyncComputeTimelineValue };
+        se_vk_queue_scheduler_assign_timeline_values(&scheduler, timelineValues);
+        const size_t numSubmits = se_dynamic_array_size(scheduler.submissions);
+        size_t numCrossQueueWaits = 0;
+        for (size_t submitIt = 0; submitIt < numSubmits; submitIt++)
         {
-            if (queuePresentDependencies & (1ull << depIt))
+            const SeVkQueueSchedulerSubmission& submission = scheduler.submissions[submitIt];
+            const bool isLast = submitIt == numSubmits - 1;
+            const bool isGraphics = submission.queue == SE_VK_SCHEDULED_QUEUE_MAIN;
+            SeVkCommandBufferSubmitInfo submitInfo
+            {
+                .commandBuffers     = commandBuffers + submission.firstGroup,
+                .numCommandBuffers  = submission.numGroups + (isLast ? 1 : 0),
+                .wait               = { },
+                .signal             = { },
+            };
+            for (size_t it = 0; it < submitInfo.numCommandBuffers; it++)
+            {
+                se_assert(submitInfo.commandBuffers[it]->queue == queues[submission.queue]);
+            }
+            size_t numWaits = 0;
+            if (uploadTimelineValue)
+            {
+                // @NOTE : pending uploads are acquired by the first command buffer of the frame
+                se_assert(submitIt == 0);
+                submitInfo.wait[numWaits++] = { transferManager->timelineSemaphore, uploadTimelineValue, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT };
+                uploadTimelineValue = 0;
+            }
+            if (submission.wait != SE_VK_QUEUE_SCHEDULER_NO_WAIT)
+            {
+                const SeVkScheduledQueue waitQueue = scheduler.submissions[submission.wait].queue;
+                submitInfo.wait[numWaits++] = { timelineSemaphores[waitQueue], submission.waitValue, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT };
+                numCrossQueueWaits += 1;
+            }
+            if (isGraphics && submitIt == 0)
+            {
+                submitInfo.wait[numWaits++] = { frame->imageAvailableSemaphore, 0, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+            }
+            submitInfo.signal[0] = { timelineSemaphores[submission.queue], submission.signalValue, 0 };
+            if (isLast)
             {
-                submitInfo.executeAfter[depCounter++] = frame->commandBuffers[depIt];
+                se_assert(isGraphics);
+                submitInfo.signal[1] = { presentSemaphore, 0, 0 };
             }
+            se_vk_command_buffer_submit(&submitInfo);
         }
-        submitInfo.waitSemaphores[0] = { frame->imageAvailableSemaphore };
-        se_vk_command_buffer_submit(transitionCmd, &submitInfo);
+        se_vk_frame_manager_submit_timeline_values(frameManager, timelineValues[SE_VK_SCHEDULED_QUEUE_MAIN], timelineValues[SE_VK_SCHEDULED_QUEUE_ASYNC_COMPUTE]);
+        frameManager->imageTimelineValues[swapChainTextureIndex] = frame->timelineValue;
+        commandRecorder->lastFrameRecordingTicks = _se_get_perf_counter() - recordingBeginTicks;
+        commandRecorder->lastFrameNumPrimaryBuffers = numGroups;
+        commandRecorder->lastFrameNumMergedPasses = numPasses - numGroups;
+        commandRecorder->lastFrameNumDynamicRenderings = numDynamicRenderingGroups;
+        commandRecorder->lastFrameSetupTicks = setupTicks;
+        commandRecorder->lastFrameNumSecondaryBuffers = se_dynamic_array_size(secondaries);
+        commandRecorder->lastFrameNumQueueSubmits = numSubmits;
+        commandRecorder->lastFrameNumAsyncComputePasses = numAsyncComputePasses;
+        commandRecorder->lastFrameNumCrossQueueWaits = numCrossQueueWaits;
+        commandRecorder->lastFrameNumCreatedCommandObjects = frame->numCreatedCommandObjects;
+        commandRecorder->lastFrameNumReusedCommandBuffers = frame->numReusedCommandBuffers;
+        commandRecorder->lastFrameNumRecordedCommands = graph->commandStream.numCommands;
+        commandRecorder->lastFrameNumElidedCommands = graph->commandStream.numElidedCommands;
+        commandRecorder->lastFrameCommandStreamSize = se_vk_command_stream_size(&graph->commandStream);
+        graph->lastFrameDescriptorSetStats = graph->descriptorSetStats;
+        graph->lastFrameDescriptorSetTicks = descriptorSetTicks;
         //
         // Present
         //
@@ -769,7 +1931,7 @@ void se_vk_graph_end_frame(SeVkGraph* graph)
             .sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
             .pNext              = nullptr,
             .waitSemaphoreCount = 1,
-            .pWaitSemaphores    = &transitionCmd->semaphore,
+            .pWaitSemaphores    = &presentSemaphore,
             .swapchainCount     = se_array_size(swapChains),
             .pSwapchains        = swapChains,
             .pImageIndices      = imageIndices,
@@ -778,11 +1940,26 @@ void se_vk_graph_end_frame(SeVkGraph* graph)
         se_vk_check(vkQueuePresentKHR(se_vk_device_get_command_queue(graph->device, SE_VK_CMD_QUEUE_PRESENT), &presentInfo));
     }
 
+    for (auto it : recordings) se_dynamic_array_destroy(se_iterator_value(it).descriptorSets);
+    se_dynamic_array_destroy(passGroupBits);
+    se_hash_table_destroy(mainQueueStates);
+    se_vk_queue_scheduler_destroy(&scheduler);
+    se_dynamic_array_destroy(mainThreadRecordings);
+    se_dynamic_array_destroy(recordingJobs);
+    se_dynamic_array_destroy(passNumChunks);
+    se_dynamic_array_destroy(secondaries);
+    se_dynamic_array_destroy(recordings);
+    se_vk_barrier_planner_destroy(&barrierPlanner);
     se_dynamic_array_destroy(framePipelines);
+    se_dynamic_array_destroy(frameDynamicRenderings);
     se_dynamic_array_destroy(frameFramebuffers);
+    se_dynamic_array_destroy(compatibleRenderPasses);
     se_dynamic_array_destroy(frameRenderPasses);
+    se_dynamic_array_destroy(groups);
     se_dynamic_array_destroy(graph->passes);
 
+    se_vk_pipeline_compiler_end_frame(pipelineCompiler);
+
     graph->context = SE_VK_GRAPH_CONTEXT_TYPE_BETWEEN_FRAMES;
 }
 
@@ -795,81 +1972,24 @@ SePassDependencies se_vk_graph_begin_graphics_pass(SeVkGraph* graph, const SeGra
         .type               = SeVkGraphPass::GRAPHICS,
         .graphicsPassInfo   = info,
         .renderPassInfo     = { },
-        .commands           = se_dynamic_array_create<SeVkGraphCommand>(se_allocator_frame(), 64),
-    };
-    const SeVkTexture* const depthStencilTexture = info.depthStencilTarget ? se_vk_unref(info.depthStencilTarget.texture) : nullptr;
-    se_assert_msg
-    (
-        (info.depthState.isTestEnabled | info.depthState.isWriteEnabled) == (depthStencilTexture != nullptr),
-        "Pipeline must have depth stensil target if depth test or depth write are enabled. If both options are disabled depth texture must be null"
-    );
-    const VkAttachmentLoadOp depthStencilLoadOp = info.depthStencilTarget ? se_vk_utils_to_vk_load_op(info.depthStencilTarget.loadOp) : (VkAttachmentLoadOp)0;
-    const uint32_t numColorAttachments = [info]() -> uint32_t
-    {
-        uint32_t result = 0;
-        for (; result < SE_MAX_PASS_RENDER_TARGETS; result++) if (!info.renderTargets[result]) break;
-        return result;
-    }();
-
-    //
-    // Render pass info
-    //
-
-    SeVkRenderPassInfo renderPassInfo =
-    {
-        .device                     = graph->device,
-        .subpasses                  = { },
-        .numSubpasses               = 1,
-        .colorAttachments           = { },
-        .numColorAttachments        = numColorAttachments,
-        .depthStencilAttachment     = depthStencilTexture 
-            ? SeVkRenderPassAttachment
-            {
-                .format     = depthStencilTexture->format,
-                .loadOp     = depthStencilLoadOp,
-                .storeOp    = VK_ATTACHMENT_STORE_OP_STORE,
-                .sampling   = VK_SAMPLE_COUNT_1_BIT,  // @TODO : support multisampling (and resolve and stuff)
-                .clearValue = { .depthStencil = { .depth = 0, .stencil = 0 } },
-            }
-            : SeVkRenderPassAttachment{ },
-        .hasDepthStencilAttachment  = depthStencilTexture != nullptr,
+        .commands           = { },
+        .compiledPass       = nullptr,
     };
-    renderPassInfo.subpasses[0] =
+    for (size_t it = 0; it < SE_MAX_PASS_INPUT_ATTACHMENTS; it++)
     {
-        .colorRefs   = 0,
-        .inputRefs   = 0,
-        .resolveRefs = { },
-        .depthRead   = depthStencilTexture != nullptr,
-        .depthWrite  = depthStencilTexture != nullptr,
-    };
-    for (uint32_t it = 0; it < numColorAttachments; it++)
-    {
-        renderPassInfo.subpasses[0].colorRefs |= 1 << it;
-        const SePassRenderTarget& target = info.renderTargets[it];
-        const VkFormat format = target.texture.isSwapChain ? se_vk_device_get_swap_chain_format(graph->device) : se_vk_unref(target.texture)->format;
-        const bool isDefaultClearValue = se_compare(target.clearColor, SeColorUnpacked{});
-        // @TODO : support clear values for INT and UINT textures
-        //         https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkClearColorValue.html
-        se_assert_msg(isDefaultClearValue || (se_vk_utils_get_format_info(format).sampledType == SeVkFormatInfo::Type::FLOAT), "Clear values are only supported for floating point textures");
-        se_assert_msg(target.clearColor.r >= 0.0f && target.clearColor.r <= 1.0f, "Clear values must be in range [0.0, 1.0]");
-        se_assert_msg(target.clearColor.g >= 0.0f && target.clearColor.g <= 1.0f, "Clear values must be in range [0.0, 1.0]");
-        se_assert_msg(target.clearColor.b >= 0.0f && target.clearColor.b <= 1.0f, "Clear values must be in range [0.0, 1.0]");
-        se_assert_msg(target.clearColor.a >= 0.0f && target.clearColor.a <= 1.0f, "Clear values must be in range [0.0, 1.0]");
-        renderPassInfo.colorAttachments[it] =
-        {
-            .format     = format,
-            .loadOp     = se_vk_utils_to_vk_load_op(target.loadOp),
-            .storeOp    = VK_ATTACHMENT_STORE_OP_STORE,
-            .sampling   = VK_SAMPLE_COUNT_1_BIT, // @TODO : support multisampling (and resolve and stuff)
-            .clearValue = { .color = { .float32 = { target.clearColor.r, target.clearColor.g, target.clearColor.b, target.clearColor.a } } },
-        };
+        const SeTextureRef texture = info.inputAttachments[it];
+        if (!texture) break;
+        se_assert_msg(!texture.isSwapChain, "Swap chain texture can't be an input attachment");
+        se_assert_msg(!se_vk_utils_is_depth_stencil_format(se_vk_unref(texture)->format), "Depth stencil texture can't be an input attachment");
+        for (size_t targetIt = 0; targetIt < SE_MAX_PASS_RENDER_TARGETS; targetIt++)
+        {
+            if (!info.renderTargets[targetIt]) break;
+            se_assert_msg(!se_compare(info.renderTargets[targetIt].texture, texture), "Render target of the pass can't be its input attachment");
+        }
     }
-    pass.renderPassInfo = renderPassInfo;
+    pass.renderPassInfo = se_vk_graph_get_render_pass_info(graph, info);
     se_dynamic_array_push(graph->passes, pass);
-
-    //
-    // Pipeline info
-    //
+    se_vk_command_stream_begin_pass(&graph->commandStream);
 
     graph->context = SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS;
     return 1ull << (se_dynamic_array_size(graph->passes) - 1);
@@ -884,8 +2004,39 @@ SePassDependencies se_vk_graph_begin_compute_pass(SeVkGraph* graph, const SeComp
         .type               = SeVkGraphPass::COMPUTE,
         .computePassInfo    = info,
         .renderPassInfo     = { },
-        .commands           = se_dynamic_array_create<SeVkGraphCommand>(se_allocator_frame(), 64),
+        .commands           = { },
+        .compiledPass       = nullptr,
+    });
+    se_vk_command_stream_begin_pass(&graph->commandStream);
+
+    graph->context = SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS;
+    return 1ull << (se_dynamic_array_size(graph->passes) - 1);
+}
+
+SePassDependencies se_vk_graph_begin_compiled_pass(SeVkGraph* graph, SeVkCompiledPass* compiledPass, SePassDependencies dependencies)
+{
+    se_assert(graph->context == SE_VK_GRAPH_CONTEXT_TYPE_IN_FRAME);
+
+    se_vk_compiled_pass_revalidate(compiledPass);
+    SeVkGraphPass& pass = se_dynamic_array_push(graph->passes,
+    {
+        .type               = compiledPass->type == SeVkCompiledPass::GRAPHICS ? SeVkGraphPass::GRAPHICS : SeVkGraphPass::COMPUTE,
+        .graphicsPassInfo   = { },
+        .renderPassInfo     = compiledPass->renderPassInfo,
+        .commands           = { },
+        .compiledPass       = compiledPass,
     });
+    if (compiledPass->type == SeVkCompiledPass::GRAPHICS)
+    {
+        pass.graphicsPassInfo = compiledPass->graphicsPassInfo;
+        pass.graphicsPassInfo.dependencies = dependencies;
+    }
+    else
+    {
+        pass.computePassInfo = compiledPass->computePassInfo;
+        pass.computePassInfo.dependencies = dependencies;
+    }
+    se_vk_command_stream_begin_pass(&graph->commandStream);
 
     graph->context = SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS;
     return 1ull << (se_dynamic_array_size(graph->passes) - 1);
@@ -895,6 +2046,8 @@ void se_vk_graph_end_pass(SeVkGraph* graph)
 {
     se_assert(graph->context == SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS);
 
+    se_dynamic_array_last(graph->passes)->commands = se_vk_command_stream_end_pass(&graph->commandStream);
+
     graph->context = SE_VK_GRAPH_CONTEXT_TYPE_IN_FRAME;
 }
 
@@ -902,34 +2055,150 @@ void se_vk_graph_command_bind(SeVkGraph* graph, const SeCommandBindInfo& info)
 {
     se_assert(graph->context == SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS);
 
-    SeVkGraphPass* const pass = &graph->passes[se_dynamic_array_size(graph->passes) - 1];
-    se_dynamic_array_push(pass->commands,
-    {
-        .type = SE_VK_GRAPH_COMMAND_TYPE_BIND,
-        .info = { .bind = info },
-    });
+    const uint32_t numBindings = se_vk_graph_get_num_bindings(info);
+    se_assert_msg(numBindings, "Bind command must have at least one binding");
+    se_assert_msg(info.set != SE_BINDLESS_SET, "Bindless heap set is bound automatically");
+    se_vk_command_stream_bind(&graph->commandStream, info.set, info.bindings, numBindings);
+}
+
+void se_vk_graph_command_push_constants(SeVkGraph* graph, const SeCommandPushConstantsInfo& info)
+{
+    se_assert(graph->context == SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS);
+    se_assert(se_data_provider_is_valid(info.data));
+    const auto [sourcePtr, sourceSize] = se_data_provider_get(info.data);
+    se_assert_msg(sourceSize && sourceSize <= SE_MAX_PUSH_CONSTANTS_SIZE, "Push constants size must be in (0, SE_MAX_PUSH_CONSTANTS_SIZE] range");
+    se_assert_msg((sourceSize % 4) == 0, "Push constants size must be a multiple of 4");
+
+    se_vk_command_stream_push_constants(&graph->commandStream, sourcePtr, (uint32_t)sourceSize);
 }
 
 void se_vk_graph_command_draw(SeVkGraph* graph, const SeCommandDrawInfo& info)
 {
     se_assert(graph->context == SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS);
 
-    SeVkGraphPass* const pass = &graph->passes[se_dynamic_array_size(graph->passes) - 1];
-    se_dynamic_array_push(pass->commands,
-    {
-        .type = SE_VK_GRAPH_COMMAND_TYPE_DRAW,
-        .info = { .draw = info },
-    });
+    se_vk_command_stream_draw(&graph->commandStream, info);
 }
 
 void se_vk_graph_command_dispatch(SeVkGraph* graph, const SeCommandDispatchInfo& info)
 {
     se_assert(graph->context == SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS);
 
+    se_vk_command_stream_dispatch(&graph->commandStream, info);
+}
+
+//
+// Returns buffer and offset for the buffer referenced by a command. Scratch buffers are ranges of the frame scratch buffer
+//
+SeVkGraphBufferRange se_vk_graph_get_buffer_range(SeVkGraph* graph, SeBufferRef ref, size_t offset)
+{
+    if (!ref.isScratch)
+    {
+        SeVkMemoryBuffer* const buffer = se_vk_unref(ref);
+        se_assert_msg(offset < buffer->memory.size, "Buffer offset is too big");
+        return { buffer, offset };
+    }
+    SeVkFrameManager* const frameManager = &graph->device->frameManager;
+    SeVkFrame* const frame = se_vk_frame_manager_get_active_frame(frameManager);
+    se_assert_msg(ref.generation == frameManager->frameNumber, "Scratch buffers are meant to be created every frame");
+    se_assert_msg(offset < frame->scratchBufferViews[ref.index].size, "Scratch buffer offset is too big");
+    return { frame->scratchBuffer, frame->scratchBufferViews[ref.index].offset + offset };
+}
+
+void se_vk_graph_command_bind_index_buffer(SeVkGraph* graph, const SeCommandBindIndexBufferInfo& info)
+{
+    se_assert(graph->context == SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS);
+
+    SeVkGraphPass* const pass = &graph->passes[se_dynamic_array_size(graph->passes) - 1];
+    se_assert_msg(pass->type == SeVkGraphPass::GRAPHICS, "Index buffers can be bound only in graphics passes");
+    const VkIndexType type = info.type == SeIndexType::UINT_16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+    se_assert_msg((info.offset % (type == VK_INDEX_TYPE_UINT16 ? 2 : 4)) == 0, "Index buffer offset must be a multiple of the index size");
+    se_vk_command_stream_bind_index_buffer(&graph->commandStream, se_vk_graph_get_buffer_range(graph, info.buffer, info.offset), type);
+}
+
+void se_vk_graph_command_draw_indexed(SeVkGraph* graph, const SeCommandDrawIndexedInfo& info)
+{
+    se_assert(graph->context == SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS);
+
+    SeVkGraphPass* const pass = &graph->passes[se_dynamic_array_size(graph->passes) - 1];
+    se_assert(pass->type == SeVkGraphPass::GRAPHICS);
+    se_vk_command_stream_draw_indexed(&graph->commandStream, info);
+}
+
+void se_vk_graph_command_draw_indirect(SeVkGraph* graph, const SeCommandDrawIndirectInfo& info, bool isIndexed)
+{
+    se_assert(graph->context == SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS);
+
+    SeVkGraphPass* const pass = &graph->passes[se_dynamic_array_size(graph->passes) - 1];
+    se_assert(pass->type == SeVkGraphPass::GRAPHICS);
+    se_assert_msg((info.argsOffset % 4) == 0, "Indirect arguments offset must be a multiple of 4");
+    se_assert_msg(info.numDraws <= 1 || se_vk_device_get_physical_device_features(graph->device)->multiDrawIndirect, "Multi draw indirect isn't supported by the device");
+    se_vk_command_stream_draw_indirect
+    (
+        &graph->commandStream,
+        isIndexed ? SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT : SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDIRECT,
+        se_vk_graph_get_buffer_range(graph, info.argsBuffer, info.argsOffset),
+        { },
+        info.numDraws
+    );
+}
+
+void se_vk_graph_command_draw_indexed_indirect_count(SeVkGraph* graph, const SeCommandDrawIndirectCountInfo& info)
+{
+    se_assert(graph->context == SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS);
+    se_assert_msg(se_vk_device_is_draw_indirect_count_supported(graph->device), "Draw indirect count isn't supported by the device");
+
+    SeVkGraphPass* const pass = &graph->passes[se_dynamic_array_size(graph->passes) - 1];
+    se_assert(pass->type == SeVkGraphPass::GRAPHICS);
+    se_assert_msg((info.argsOffset % 4) == 0 && (info.countOffset % 4) == 0, "Indirect arguments and count offsets must be multiples of 4");
+    se_vk_command_stream_draw_indirect
+    (
+        &graph->commandStream,
+        SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED_INDIRECT_COUNT,
+        se_vk_graph_get_buffer_range(graph, info.argsBuffer, info.argsOffset),
+        se_vk_graph_get_buffer_range(graph, info.countBuffer, info.countOffset),
+        info.maxDraws
+    );
+}
+
+void se_vk_graph_command_dispatch_indirect(SeVkGraph* graph, const SeCommandDispatchIndirectInfo& info)
+{
+    se_assert(graph->context == SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS);
+
     SeVkGraphPass* const pass = &graph->passes[se_dynamic_array_size(graph->passes) - 1];
-    se_dynamic_array_push(pass->commands,
+    se_assert(pass->type == SeVkGraphPass::COMPUTE);
+    se_assert_msg((info.argsOffset % 4) == 0, "Indirect arguments offset must be a multiple of 4");
+    se_vk_command_stream_dispatch_indirect(&graph->commandStream, se_vk_graph_get_buffer_range(graph, info.argsBuffer, info.argsOffset));
+}
+
+void se_vk_graph_prewarm_graphics_pipeline(SeVkGraph* graph, const SeGraphicsPassInfo& info)
+{
+    se_assert(graph->context != SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS);
+
+    // @NOTE : pass is prewarmed as a separate render pass (or dynamic rendering pass, see se_vk_graph_is_dynamic_rendering_group),
+    //         pipelines of passes merged into subpasses are created at the end of the frame
+    const SeVkRenderPassInfo renderPassInfo = se_vk_graph_get_render_pass_info(graph, info);
+    const bool isDynamicRendering = graph->isDynamicRenderingEnabled && renderPassInfo.subpasses[0].inputRefs == 0;
+    SeVkRenderPass* const renderPass = isDynamicRendering ? nullptr : se_vk_graph_get_compatible_render_pass(graph, renderPassInfo);
+    const SeVkPipelineRenderingFormats renderingFormats = isDynamicRendering ? se_vk_graph_get_rendering_formats(graph, renderPassInfo) : SeVkPipelineRenderingFormats{ };
+    SeVkGraphicsPipelineInfo pipelineInfo = se_vk_graph_get_graphics_pipeline_info(graph, info, info.fragmentProgram, renderPass);
+    pipelineInfo.renderingFormats = renderingFormats;
+    se_vk_graph_get_pipeline(graph, graph->graphicsPipelineInfoToGraphicsPipeline, pipelineInfo, true);
+    if (info.fallbackFragmentProgram.program)
     {
-        .type = SE_VK_GRAPH_COMMAND_TYPE_DISPATCH,
-        .info = { .dispatch = info },
-    });
+        SeVkGraphicsPipelineInfo fallbackPipelineInfo = se_vk_graph_get_graphics_pipeline_info(graph, info, info.fallbackFragmentProgram, renderPass);
+        fallbackPipelineInfo.renderingFormats = renderingFormats;
+        se_vk_graph_get_pipeline(graph, graph->graphicsPipelineInfoToGraphicsPipeline, fallbackPipelineInfo, true);
+    }
+}
+
+void se_vk_graph_prewarm_compute_pipeline(SeVkGraph* graph, const SeComputePassInfo& info)
+{
+    se_assert(graph->context != SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS);
+
+    SeVkComputePipelineInfo pipelineInfo
+    {
+        .device = graph->device,
+        .program = se_vk_graph_program_with_constants(info.program),
+    };
+    se_vk_graph_get_pipeline(graph, graph->computePipelineInfoToComputePipeline, pipelineInfo, true);
 }
@@ -10,6 +10,11 @@
 #include "se_vulkan_memory_buffer.hpp"
 #include "se_vulkan_sampler.hpp"
 #include "se_vulkan_command_buffer.hpp"
+#include "se_vulkan_barrier_planner.hpp"
+#include "se_vulkan_queue_scheduler.hpp"
+#include "se_vulkan_command_stream.hpp"
+#include "se_vulkan_transient_heap.hpp"
+#include "se_vulkan_object_cache.hpp"
 
 enum SeVkGraphContextType
 {
@@ -18,26 +23,6 @@ enum SeVkGraphContextType
     SE_VK_GRAPH_CONTEXT_TYPE_IN_PASS,
 };
 
-enum SeVkGraphCommandType
-{
-    SE_VK_GRAPH_COMMAND_TYPE_DRAW,
-    SE_VK_GRAPH_COMMAND_TYPE_DISPATCH,
-    SE_VK_GRAPH_COMMAND_TYPE_BIND,
-};
-
-union SeVkGraphCommandInfo
-{
-    SeCommandDrawInfo draw;
-    SeCommandDispatchInfo dispatch;
-    SeCommandBindInfo bind;
-};
-
-struct SeVkGraphCommand
-{
-    SeVkGraphCommandType type;
-    SeVkGraphCommandInfo info;
-};
-
 struct SeVkGraphPass
 {
     enum { GRAPHICS, COMPUTE } type;
@@ -47,33 +32,84 @@ struct SeVkGraphPass
         SeComputePassInfo computePassInfo;
     };
     SeVkRenderPassInfo renderPassInfo;
-    SeDynamicArray<SeVkGraphCommand> commands;
+    SeVkCommandStreamRange commands;    // Commands of the pass in SeVkGraph::commandStream
+    SeVkCompiledPass* compiledPass; // Optional. If set, render pass, framebuffer and pipelines are taken from it
+};
+
+//
+// Run of consecutive graph passes recorded as a single render pass, one subpass per graph pass (see se_vk_graph_try_merge_pass).
+// Compute and compiled passes always form groups of their own
+//
+struct SeVkGraphPassGroup
+{
+    size_t                  firstPass;
+    size_t                  numPasses;
+    SeVkRenderPassInfo      renderPassInfo;                                             // Not used by compute and compiled passes
+    SeTextureRef            colorAttachments[SeVkConfig::FRAMEBUFFER_MAX_TEXTURES];     // Textures of renderPassInfo.colorAttachments
+    SeTextureRef            depthStencilAttachment;
+    VkExtent3D              extent;
 };
 
-struct SeVkGraphPipelineWithFrame
+//
+// Attachments of a group recorded with dynamic rendering (VK_KHR_dynamic_rendering) instead of a render pass and a framebuffer.
+// Dynamic rendering has no subpasses, so only groups of a single pass without input attachments are recorded this way (see
+// se_vk_graph_is_dynamic_rendering_group). Attachment layouts don't change during rendering
+//
+struct SeVkGraphDynamicRendering
 {
-    SeVkPipeline* pipeline;
-    size_t frame;
+    VkRenderingAttachmentInfoKHR    colorAttachments[SeVkConfig::FRAMEBUFFER_MAX_TEXTURES];
+    SeVkTexture*                    colorTextures[SeVkConfig::FRAMEBUFFER_MAX_TEXTURES];
+    uint32_t                        numColorAttachments;
+    VkRenderingAttachmentInfoKHR    depthStencilAttachment;
+    SeVkTexture*                    depthStencilTexture;        // Null if group has no depth stencil attachment
+    SeVkPipelineRenderingFormats    formats;
+    VkExtent2D                      extent;
 };
 
-struct SeVkGraphDescriptorPool
+struct SeVkGraphDescriptorSet
 {
-    VkDescriptorPool handle;
-    bool isLastAllocationSuccessful;
+    VkDescriptorSet handle;
+    uint32_t        dynamicOffsets[SE_MAX_BINDINGS];    // In binding order, as vkCmdBindDescriptorSets expects them
+    uint32_t        numDynamicOffsets;
 };
 
-struct SeVkGraphDescriptorPoolArray
+//
+// Per-frame recording data. Everything that isn't thread safe (command buffer allocation, barrier planning,
+// descriptor set lookups, allocations and writes) is prepared on the main thread, so recording jobs only issue vkCmd* calls
+//
+struct SeVkGraphSecondaryRecording;
+
+struct SeVkGraphPassRecording
 {
-    SeVkGraphDescriptorPool pools[SeVkConfig::GRAPH_MAX_POOLS_IN_ARRAY];
-    size_t numPools;
-    size_t lastFrame;
+    const SeVkGraphPass*                    pass;
+    const SeVkCommandStream*                commandStream;
+    SeVkCommandBuffer*                      commandBuffer;              // Shared by all passes of the group
+    SeVkRenderPass*                         renderPass;                 // Null if group uses dynamic rendering
+    SeVkFramebuffer*                        framebuffer;                // Null if group uses dynamic rendering
+    const SeVkGraphDynamicRendering*        dynamicRendering;           // Null if group uses render pass
+    SeVkPipeline*                           pipeline;
+    const SeVkBarrierPlanner*               barrierPlanner;
+    size_t                                  barrierBatch;               // Barriers recorded before the render pass begins (planned for the whole group)
+    SeDynamicArray<SeVkGraphDescriptorSet>  descriptorSets;             // One per bind command of the pass, handle is VK_NULL_HANDLE if pass has no pipeline
+    size_t                                  lane;
+    uint32_t                                subpass;                    // Index of the pass in its group
+    uint32_t                                numSubpasses;               // Number of passes in the group for the first pass of the group, zero for others
+    size_t                                  firstSecondary;             // Index of the first secondary recording of this pass
+    size_t                                  numSecondaries;             // Zero if pass is recorded directly into the primary command buffer
+    const SeVkGraphSecondaryRecording*      secondaries;                // Set when recording jobs are created
 };
 
-template<typename T>
-struct SeVkGraphWithFrame
+struct SeVkGraphSecondaryRecording
 {
-    T* object;
-    size_t frame;
+    const SeVkGraphPassRecording*           passRecording;
+    SeVkCommandBuffer*                      commandBuffer;
+    size_t                                  firstCommand;               // Offset of the first command in the command stream
+    size_t                                  numCommands;
+    size_t                                  firstBind;                  // Index of the first bind command of the chunk in the pass
+    SeVkGraphDescriptorSet                  boundSets[SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS]; // Sets bound by the preceding commands of the pass
+    const SeVkGraphCommandPushConstants*    pushConstants;              // Pushed by the preceding commands of the pass, nullptr if none
+    const SeVkGraphCommandBindIndexBuffer*  indexBuffer;                // Bound by the preceding commands of the pass, nullptr if none
+    size_t                                  lane;
 };
 
 struct SeVkGraph
@@ -82,12 +118,23 @@ struct SeVkGraph
     SeVkGraphContextType                                    context;
     
     SeDynamicArray<SeVkGraphPass>                             passes;
-
-    SeHashTable<SeVkRenderPassInfo            , SeVkGraphWithFrame<SeVkRenderPass>>   renderPassInfoToRenderPass;
-    SeHashTable<SeVkFramebufferInfo           , SeVkGraphWithFrame<SeVkFramebuffer>>  framebufferInfoToFramebuffer;
-    SeHashTable<SeVkGraphicsPipelineInfo      , SeVkGraphWithFrame<SeVkPipeline>>     graphicsPipelineInfoToGraphicsPipeline;
-    SeHashTable<SeVkComputePipelineInfo       , SeVkGraphWithFrame<SeVkPipeline>>     computePipelineInfoToComputePipeline;
-    SeHashTable<SeVkGraphPipelineWithFrame    , SeVkGraphDescriptorPoolArray>         pipelineToDescriptorPools;
+    SeVkCommandStream                                       commandStream;                  // Commands of all passes of the current frame
+
+    SeVkObjectCache<SeVkRenderPassInfo        , SeVkRenderPass>     renderPassInfoToRenderPass;
+    SeVkObjectCache<SeVkFramebufferInfo       , SeVkFramebuffer>    framebufferInfoToFramebuffer;
+    SeVkObjectCache<SeVkGraphicsPipelineInfo  , SeVkPipeline>       graphicsPipelineInfoToGraphicsPipeline;
+    SeVkObjectCache<SeVkComputePipelineInfo   , SeVkPipeline>       computePipelineInfoToComputePipeline;
+
+    bool                                                    isSubpassMergingEnabled;
+    bool                                                    isDynamicRenderingEnabled;      // Can be set only if device supports dynamic rendering
+    bool                                                    isAsyncComputeEnabled;          // Can be set only if device supports async compute
+    bool                                                    isDescriptorSetCachingEnabled;
+    SeVkDescriptorSetCacheStats                             descriptorSetStats;             // Current frame
+    SeVkDescriptorSetCacheStats                             lastFrameDescriptorSetStats;
+    uint64_t                                                lastFrameDescriptorSetTicks;    // Time spent on getting descriptor sets for bind commands
+    SeVkObjectCacheStats                                    lastFrameObjectCacheStats;      // Sum for all object caches
+    uint64_t                                                lastFrameObjectCacheTicks;      // Time spent on evicting unused objects
+    SeVkTransientHeap                                       transientHeap;
 };
 
 struct SeVkGraphInfo
@@ -103,36 +150,27 @@ void        se_vk_graph_end_frame(SeVkGraph* graph);
 
 SePassDependencies  se_vk_graph_begin_graphics_pass(SeVkGraph* graph, const SeGraphicsPassInfo& info);
 SePassDependencies  se_vk_graph_begin_compute_pass(SeVkGraph* graph, const SeComputePassInfo& info);
+SePassDependencies  se_vk_graph_begin_compiled_pass(SeVkGraph* graph, SeVkCompiledPass* pass, SePassDependencies dependencies);
 void                se_vk_graph_end_pass(SeVkGraph* graph);
 
 void                se_vk_graph_command_bind(SeVkGraph* graph, const SeCommandBindInfo& info);
+void                se_vk_graph_command_push_constants(SeVkGraph* graph, const SeCommandPushConstantsInfo& info);
 void                se_vk_graph_command_draw(SeVkGraph* graph, const SeCommandDrawInfo& info);
 void                se_vk_graph_command_dispatch(SeVkGraph* graph, const SeCommandDispatchInfo& info);
-
-template<>
-void se_hash_value_builder_absorb<SeVkGraphPipelineWithFrame>(SeHashValueBuilder& builder, const SeVkGraphPipelineWithFrame& value)
-{
-    se_hash_value_builder_absorb(builder, *value.pipeline);
-    se_hash_value_builder_absorb(builder, value.frame);
-}
-
-template<>
-SeHashValue se_hash_value_generate<SeVkGraphPipelineWithFrame>(const SeVkGraphPipelineWithFrame& value)
-{
-    SeHashValueBuilder builder = se_hash_value_builder_begin();
-    se_hash_value_builder_absorb(builder, value);
-    return se_hash_value_builder_end(builder);
-}
-
-template<>
-SeString se_string_cast<SeVkGraphWithFrame<SeVkFramebuffer>>(const SeVkGraphWithFrame<SeVkFramebuffer>& value, SeStringLifetime lifetime)
-{
-    SeStringBuilder builder = se_string_builder_begin("[object: ", lifetime);
-    se_string_builder_append(builder, se_string_cast(*value.object));
-    se_string_builder_append(builder, ", frame: ");
-    se_string_builder_append(builder, se_string_cast(value.frame));
-    se_string_builder_append(builder, "]");
-    return se_string_builder_end(builder);
-}
+void                se_vk_graph_command_bind_index_buffer(SeVkGraph* graph, const SeCommandBindIndexBufferInfo& info);
+void                se_vk_graph_command_draw_indexed(SeVkGraph* graph, const SeCommandDrawIndexedInfo& info);
+void                se_vk_graph_command_draw_indirect(SeVkGraph* graph, const SeCommandDrawIndirectInfo& info, bool isIndexed);
+void                se_vk_graph_command_draw_indexed_indirect_count(SeVkGraph* graph, const SeCommandDrawIndirectCountInfo& info);
+void                se_vk_graph_command_dispatch_indirect(SeVkGraph* graph, const SeCommandDispatchIndirectInfo& info);
+
+// Submits pipelines for the pass to the background compiler. Prewarmed objects that aren't used are evicted
+// as usual (after SE_VK_GRAPH_OBJECT_LIFETIME frames), so prewarm shortly before passes are expected to be used
+void                se_vk_graph_prewarm_graphics_pipeline(SeVkGraph* graph, const SeGraphicsPassInfo& info);
+void                se_vk_graph_prewarm_compute_pipeline(SeVkGraph* graph, const SeComputePassInfo& info);
+
+// Used by compiled passes
+SeVkProgramWithConstants    se_vk_graph_program_with_constants(const SeProgramWithConstants& seProgram);
+SeVkRenderPassInfo          se_vk_graph_get_render_pass_info(SeVkGraph* graph, const SeGraphicsPassInfo& info);
+SeVkGraphicsPipelineInfo    se_vk_graph_get_graphics_pipeline_info(SeVkGraph* graph, const SeGraphicsPassInfo& seInfo, const SeProgramWithConstants& fragmentProgram, SeVkRenderPass* pass);
 
 #endif
@@ -11,6 +11,7 @@
 #include "se_vulkan_memory_buffer.hpp"
 #include "se_vulkan_sampler.hpp"
 #include "se_vulkan_command_buffer.hpp"
+#include "se_vulkan_compiled_pass.hpp"
 
 struct SeVkMemoryObjectPools
 {
@@ -22,11 +23,11 @@ struct SeVkMemoryObjectPools
     SeObjectPool<SeVkRenderPass>      renderPassPool;
     SeObjectPool<SeVkSampler>         samplerPool;
     SeObjectPool<SeVkTexture>         texturePool;
+    SeObjectPool<SeVkCompiledPass>    compiledPassPool;
 };
 
 constexpr size_t MEMORY_BLOCK_SIZE_BYTES     = 64ull;
 constexpr size_t DEFAULT_CHUNK_SIZE_BYTES    = 32ull * 1024ull * 1024ull;
-constexpr size_t STAGING_BUFFER_SIZE         = se_megabytes(16);
 
 void* se_vk_memory_manager_alloc(void* pUserData, size_t size, size_t alignment, VkSystemAllocationScope allocationScope)
 {
@@ -169,7 +170,6 @@ void se_vk_memory_manager_construct(SeVkMemoryManager* manager)
         .device                     = nullptr,
         .gpu_chunks                 = se_dynamic_array_create<SeVkGpuMemoryChunk>(allocator, 64),
         .memoryProperties           = nullptr,
-        .stagingBuffer              = nullptr,
     };
     se_object_pool_construct(manager->cpu_objectPools->commandBufferPool);
     se_object_pool_construct(manager->cpu_objectPools->framebufferPool);
@@ -179,6 +179,7 @@ void se_vk_memory_manager_construct(SeVkMemoryManager* manager)
     se_object_pool_construct(manager->cpu_objectPools->renderPassPool);
     se_object_pool_construct(manager->cpu_objectPools->samplerPool);
     se_object_pool_construct(manager->cpu_objectPools->texturePool);
+    se_object_pool_construct(manager->cpu_objectPools->compiledPassPool);
 }
 
 void se_vk_memory_manager_free_gpu_memory(SeVkMemoryManager* manager)
@@ -212,23 +213,13 @@ void se_vk_memory_manager_free_cpu_memory(SeVkMemoryManager* manager)
     se_object_pool_destroy(manager->cpu_objectPools->renderPassPool);
     se_object_pool_destroy(manager->cpu_objectPools->samplerPool);
     se_object_pool_destroy(manager->cpu_objectPools->texturePool);
+    se_object_pool_destroy(manager->cpu_objectPools->compiledPassPool);
 }
 
 void se_vk_memory_manager_set_device(SeVkMemoryManager* manager, SeVkDevice* device)
 {
     manager->device = device;
     manager->memoryProperties = se_vk_device_get_memory_properties(device);
-
-    manager->stagingBuffer = se_object_pool_take(manager->cpu_objectPools->memoryBufferPool);
-    SeVkMemoryBufferInfo stagingBufferInfo
-    {
-        .device     = manager->device,
-        .size       = STAGING_BUFFER_SIZE,
-        .usage      = VK_BUFFER_USAGE_TRANSFER_DST_BIT   | 
-                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT   ,
-        .visibility = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-    };
-    se_vk_memory_buffer_construct(manager->stagingBuffer, &stagingBufferInfo);
 }
 
 bool se_vk_memory_manager_is_valid_memory(SeVkMemory memory)
@@ -350,6 +341,7 @@ SeObjectPool<T>& se_vk_memory_manager_get_pool(SeVkMemoryManager* manager)
     else if constexpr (std::is_same<SeVkRenderPass, T>::value)      return manager->cpu_objectPools->renderPassPool;
     else if constexpr (std::is_same<SeVkSampler, T>::value)         return manager->cpu_objectPools->samplerPool;
     else if constexpr (std::is_same<SeVkTexture, T>::value)         return manager->cpu_objectPools->texturePool;
+    else if constexpr (std::is_same<SeVkCompiledPass, T>::value)    return manager->cpu_objectPools->compiledPassPool;
     else
     {
         static_assert(false, "Invalid code path");
@@ -361,8 +353,3 @@ const VkAllocationCallbacks* se_vk_memory_manager_get_callbacks(const SeVkMemory
 {
     return &manager->cpu_allocationCallbacks;
 }
-
-SeVkMemoryBuffer* se_vk_memory_manager_get_staging_buffer(SeVkMemoryManager* manager)
-{
-    return manager->stagingBuffer;
-}
@@ -48,8 +48,6 @@ struct SeVkMemoryManager
     SeVkDevice*                         device;
     SeDynamicArray<SeVkGpuMemoryChunk>    gpu_chunks;
     VkPhysicalDeviceMemoryProperties*   memoryProperties;
-
-    SeVkMemoryBuffer*                   stagingBuffer;
 };
 
 void            se_vk_memory_manager_construct(SeVkMemoryManager* manager);
@@ -63,6 +61,5 @@ void            se_vk_memory_manager_deallocate(SeVkMemoryManager* manager, SeVk
 
 template<typename T> SeObjectPool<T>& se_vk_memory_manager_get_pool(SeVkMemoryManager* manager);
 const VkAllocationCallbacks*        se_vk_memory_manager_get_callbacks(const SeVkMemoryManager* manager);
-SeVkMemoryBuffer*                   se_vk_memory_manager_get_staging_buffer(SeVkMemoryManager* manager);
 
 #endif
@@ -6,50 +6,69 @@
 
 size_t g_memoryBufferIndex = 0;
 
-void se_vk_memory_buffer_construct(SeVkMemoryBuffer* buffer, SeVkMemoryBufferInfo* info)
+void se_vk_memory_buffer_create_handle(SeVkMemoryBuffer* buffer)
 {
-    SeVkDevice* const device = (SeVkDevice*)info->device;
-    SeVkMemoryManager* const memoryManager = &device->memoryManager;
-    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(memoryManager);
-    const VkDevice logicalHandle = se_vk_device_get_logical_handle(device);
-    //
-    // Initial setup
-    //
-    *buffer =
-    {
-        .object = { SeVkObject::Type::MEMORY_BUFFER, 0, g_memoryBufferIndex++ },
-        .device = device,
-        .handle = VK_NULL_HANDLE,
-        .memory = { },
-    };
-    //
-    // Create buffer handle
-    //
+    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&buffer->device->memoryManager);
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(buffer->device);
     uint32_t queueFamilyIndices[SeVkConfig::MAX_UNIQUE_COMMAND_QUEUES];
     VkBufferCreateInfo bufferCreateInfo
     {
         .sType                  = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         .pNext                  = nullptr,
         .flags                  = 0,
-        .size                   = info->size,
-        .usage                  = info->usage,
+        .size                   = buffer->size,
+        .usage                  = buffer->usage,
         .queueFamilyIndexCount  = 0,
         .pQueueFamilyIndices    = queueFamilyIndices,
     };
     se_vk_device_fill_sharing_mode
     (
-        device,
+        buffer->device,
         SE_VK_CMD_QUEUE_GRAPHICS | SE_VK_CMD_QUEUE_TRANSFER | SE_VK_CMD_QUEUE_COMPUTE,
         &bufferCreateInfo.queueFamilyIndexCount,
         queueFamilyIndices,
         &bufferCreateInfo.sharingMode
     );
     se_vk_check(vkCreateBuffer(logicalHandle, &bufferCreateInfo, callbacks, &buffer->handle));
+}
+
+void se_vk_memory_buffer_construct(SeVkMemoryBuffer* buffer, SeVkMemoryBufferInfo* info)
+{
+    SeVkDevice* const device = (SeVkDevice*)info->device;
+    SeVkMemoryManager* const memoryManager = &device->memoryManager;
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(device);
+    //
+    // Initial setup
+    //
+    *buffer =
+    {
+        .object             = { SeVkObject::Type::MEMORY_BUFFER, 0, g_memoryBufferIndex++ },
+        .device             = device,
+        .handle             = VK_NULL_HANDLE,
+        .memory             = { },
+        .barrierState       = { },
+        .bindlessIndex      = SE_BINDLESS_INVALID_INDEX,
+        .size               = info->size,
+        .usage              = info->usage,
+        .flags              = info->isTransient ? SE_VK_MEMORY_BUFFER_ALIASED : 0,
+        .memoryRequirements = { },
+    };
+    //
+    // Create buffer handle
     //
-    // Allocate memory
+    se_vk_memory_buffer_create_handle(buffer);
+    //
+    // Allocate memory. Transient buffers are placed by the transient heap every frame
     //
     VkMemoryRequirements requirements = { };
     vkGetBufferMemoryRequirements(logicalHandle, buffer->handle, &requirements);
+    if (info->isTransient)
+    {
+        se_assert_msg(info->visibility == VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, "Transient buffers must be device local");
+        buffer->memoryRequirements = requirements;
+        buffer->memory = { VK_NULL_HANDLE, 0, info->size, nullptr };
+        return;
+    }
     SeVkGpuAllocationRequest allocationRequest
     {
         .size           = requirements.size,
@@ -62,6 +81,13 @@ void se_vk_memory_buffer_construct(SeVkMemoryBuffer* buffer, SeVkMemoryBufferInf
     // Bind memory
     //
     vkBindBufferMemory(logicalHandle, buffer->handle, buffer->memory.memory, buffer->memory.offset);
+    //
+    // Add to bindless heap
+    //
+    if (info->usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+    {
+        buffer->bindlessIndex = se_vk_bindless_heap_add_buffer(&device->bindlessHeap, buffer);
+    }
 }
 
 void se_vk_memory_buffer_destroy(SeVkMemoryBuffer* buffer)
@@ -70,6 +96,19 @@ void se_vk_memory_buffer_destroy(SeVkMemoryBuffer* buffer)
     const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(memoryManager);
     const VkDevice logicalHandle = se_vk_device_get_logical_handle(buffer->device);
 
+    // @NOTE : buffers are destroyed only after gpu stopped using them, so the index can be reused right away
+    se_vk_bindless_heap_remove(&buffer->device->bindlessHeap, SE_VK_BINDLESS_BUFFER, buffer->bindlessIndex);
     vkDestroyBuffer(logicalHandle, buffer->handle, callbacks);
-    se_vk_memory_manager_deallocate(memoryManager, buffer->memory);
+    // @NOTE : memory of aliased buffers belongs to the transient heap
+    if (!(buffer->flags & SE_VK_MEMORY_BUFFER_ALIASED)) se_vk_memory_manager_deallocate(memoryManager, buffer->memory);
+}
+
+void se_vk_memory_buffer_bind_aliased_memory(SeVkMemoryBuffer* buffer, VkDeviceMemory memory, VkDeviceSize offset)
+{
+    se_assert(buffer->flags & SE_VK_MEMORY_BUFFER_ALIASED);
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(buffer->device);
+    se_vk_memory_buffer_create_handle(buffer);
+    vkBindBufferMemory(logicalHandle, buffer->handle, memory, offset);
+    buffer->object.uniqueIndex = g_memoryBufferIndex++;
+    buffer->memory = { memory, offset, buffer->size, nullptr };
 }
@@ -3,13 +3,25 @@
 
 #include "se_vulkan_base.hpp"
 #include "se_vulkan_memory.hpp"
+#include "se_vulkan_barrier_planner.hpp"
+
+enum SeVkMemoryBufferFlags
+{
+    SE_VK_MEMORY_BUFFER_ALIASED = 0x00000001, // Transient buffer, memory is owned by the transient heap and handle is recreated when buffer is moved
+};
 
 struct SeVkMemoryBuffer
 {
-    SeVkObject          object;
-    SeVkDevice*         device;
-    VkBuffer            handle;
-    SeVkMemory          memory;
+    SeVkObject                  object;
+    SeVkDevice*                 device;
+    VkBuffer                    handle;
+    SeVkMemory                  memory;
+    SeVkBarrierResourceState    barrierState;
+    uint32_t                    bindlessIndex;  // SE_BINDLESS_INVALID_INDEX if buffer isn't in the bindless heap
+    size_t                      size;
+    VkBufferUsageFlags          usage;
+    uint64_t                    flags;
+    VkMemoryRequirements        memoryRequirements; // Aliased buffers only
 };
 
 struct SeVkMemoryBufferInfo
@@ -18,11 +30,16 @@ struct SeVkMemoryBufferInfo
     size_t                  size;
     VkBufferUsageFlags      usage;
     VkMemoryPropertyFlags   visibility;
+    bool                    isTransient;    // Memory is placed by the transient heap every frame (see se_vulkan_transient_heap.hpp)
 };
 
 void se_vk_memory_buffer_construct(SeVkMemoryBuffer* buffer, SeVkMemoryBufferInfo* info);
 void se_vk_memory_buffer_destroy(SeVkMemoryBuffer* buffer);
 
+// Aliased buffers only. Creates a new buffer handle bound to the given memory, previous handle must be retired by the caller.
+// Buffer gets a new unique index, so cached descriptor sets aren't reused
+void se_vk_memory_buffer_bind_aliased_memory(SeVkMemoryBuffer* buffer, VkDeviceMemory memory, VkDeviceSize offset);
+
 template<>
 void se_vk_destroy<SeVkMemoryBuffer>(SeVkMemoryBuffer* res)
 {
@@ -0,0 +1,170 @@
+#ifndef _SE_VULKAN_OBJECT_CACHE_H_
+#define _SE_VULKAN_OBJECT_CACHE_H_
+
+#include "se_vulkan_base.hpp"
+
+//
+// Cache of objects that render graph creates on demand (render passes, framebuffers and pipelines), looked up by their infos.
+//
+// Objects that weren't used for a number of frames are evicted. Entries are kept in a doubly linked list ordered by the
+// frame of the last use (least recently used first) : the first use of an entry in a frame moves it to the end of the list.
+// So expired entries are always at the beginning of the list and eviction looks only at the entries that actually expire
+// (plus the first one that doesn't). Per-frame cost depends on the number of used and evicted objects, not on the cache size.
+//
+// Entries are stored in an array and linked by indices, because hash table moves its values when it grows or removes keys.
+// Every entry has a copy of its key, so it can be removed from the hash table. Indices of removed entries are reused.
+//
+
+constexpr size_t SE_VK_OBJECT_CACHE_INVALID_ENTRY = SIZE_MAX;
+
+template<typename Key, typename Value>
+struct SeVkObjectCacheEntry
+{
+    Key     key;
+    Value*  object;
+    size_t  frame;      // Last frame the object was used in
+    size_t  previous;   // Entry used before this one
+    size_t  next;       // Entry used after this one
+};
+
+template<typename Key, typename Value>
+struct SeVkObjectCache
+{
+    SeHashTable<Key, size_t>                            keyToEntry;
+    SeDynamicArray<SeVkObjectCacheEntry<Key, Value>>    entries;
+    SeDynamicArray<size_t>                              freeEntries;
+    size_t                                              oldest;     // Least recently used entry
+    size_t                                              newest;     // Most recently used entry
+};
+
+struct SeVkObjectCacheStats
+{
+    size_t numExamined;     // Entries checked for expiration
+    size_t numEvicted;
+};
+
+template<typename Key, typename Value>
+void se_vk_object_cache_construct(SeVkObjectCache<Key, Value>& cache, SeAllocatorBindings allocator, size_t capacity)
+{
+    cache =
+    {
+        .keyToEntry     = { },
+        .entries        = { },
+        .freeEntries    = { },
+        .oldest         = SE_VK_OBJECT_CACHE_INVALID_ENTRY,
+        .newest         = SE_VK_OBJECT_CACHE_INVALID_ENTRY,
+    };
+    se_hash_table_construct(cache.keyToEntry, allocator, capacity);
+    se_dynamic_array_construct(cache.entries, allocator, capacity);
+    se_dynamic_array_construct(cache.freeEntries, allocator, capacity);
+}
+
+// @NOTE : objects aren't destroyed here, they are owned by the memory manager pools
+template<typename Key, typename Value>
+void se_vk_object_cache_destroy(SeVkObjectCache<Key, Value>& cache)
+{
+    se_hash_table_destroy(cache.keyToEntry);
+    se_dynamic_array_destroy(cache.entries);
+    se_dynamic_array_destroy(cache.freeEntries);
+}
+
+template<typename Key, typename Value>
+inline size_t se_vk_object_cache_size(const SeVkObjectCache<Key, Value>& cache)
+{
+    return se_hash_table_size(cache.keyToEntry);
+}
+
+template<typename Key, typename Value>
+void _se_vk_object_cache_unlink(SeVkObjectCache<Key, Value>& cache, size_t index)
+{
+    SeVkObjectCacheEntry<Key, Value>& entry = cache.entries[index];
+    if (entry.previous != SE_VK_OBJECT_CACHE_INVALID_ENTRY) cache.entries[entry.previous].next = entry.next;
+    else                                                    cache.oldest = entry.next;
+    if (entry.next != SE_VK_OBJECT_CACHE_INVALID_ENTRY)     cache.entries[entry.next].previous = entry.previous;
+    else                                                    cache.newest = entry.previous;
+    entry.previous = SE_VK_OBJECT_CACHE_INVALID_ENTRY;
+    entry.next = SE_VK_OBJECT_CACHE_INVALID_ENTRY;
+}
+
+template<typename Key, typename Value>
+void _se_vk_object_cache_link_newest(SeVkObjectCache<Key, Value>& cache, size_t index)
+{
+    SeVkObjectCacheEntry<Key, Value>& entry = cache.entries[index];
+    entry.previous = cache.newest;
+    entry.next = SE_VK_OBJECT_CACHE_INVALID_ENTRY;
+    if (cache.newest != SE_VK_OBJECT_CACHE_INVALID_ENTRY)   cache.entries[cache.newest].next = index;
+    else                                                    cache.oldest = index;
+    cache.newest = index;
+}
+
+// Returns cached object and marks it as used in the frame, nullptr if there is no object for the key
+template<typename Key, typename Value, typename ProvidedKey>
+Value* se_vk_object_cache_get(SeVkObjectCache<Key, Value>& cache, const ProvidedKey& key, size_t frame)
+{
+    const size_t* const index = se_hash_table_get(cache.keyToEntry, key);
+    if (!index) return nullptr;
+    SeVkObjectCacheEntry<Key, Value>& entry = cache.entries[*index];
+    // @NOTE : entry that was already used in this frame is the newest one or close to it, so it isn't moved again
+    if (entry.frame != frame)
+    {
+        se_assert(entry.frame < frame);
+        entry.frame = frame;
+        _se_vk_object_cache_unlink(cache, *index);
+        _se_vk_object_cache_link_newest(cache, *index);
+    }
+    return entry.object;
+}
+
+template<typename Key, typename Value>
+Value* se_vk_object_cache_add(SeVkObjectCache<Key, Value>& cache, const Key& key, Value* object, size_t frame)
+{
+    se_assert(!se_hash_table_get(cache.keyToEntry, key));
+    const SeVkObjectCacheEntry<Key, Value> entry
+    {
+        .key        = key,
+        .object     = object,
+        .frame      = frame,
+        .previous   = SE_VK_OBJECT_CACHE_INVALID_ENTRY,
+        .next       = SE_VK_OBJECT_CACHE_INVALID_ENTRY,
+    };
+    size_t index;
+    if (const size_t* const freeEntry = se_dynamic_array_last(cache.freeEntries))
+    {
+        index = *freeEntry;
+        se_dynamic_array_remove_idx(cache.freeEntries, se_dynamic_array_size(cache.freeEntries) - 1);
+        cache.entries[index] = entry;
+    }
+    else
+    {
+        index = se_dynamic_array_size(cache.entries);
+        se_dynamic_array_push(cache.entries, entry);
+    }
+    se_hash_table_set(cache.keyToEntry, key, index);
+    _se_vk_object_cache_link_newest(cache, index);
+    return object;
+}
+
+//
+// Removes objects that weren't used for more than lifetime frames and calls destroy for each of them.
+// Stops at the first entry that isn't expired, all entries after it were used later
+//
+template<typename Key, typename Value, typename Destroy>
+void se_vk_object_cache_evict(SeVkObjectCache<Key, Value>& cache, size_t currentFrame, size_t lifetime, const Destroy& destroy, SeVkObjectCacheStats* stats)
+{
+    while (cache.oldest != SE_VK_OBJECT_CACHE_INVALID_ENTRY)
+    {
+        const size_t index = cache.oldest;
+        SeVkObjectCacheEntry<Key, Value>& entry = cache.entries[index];
+        stats->numExamined += 1;
+        if ((currentFrame - entry.frame) <= lifetime) break;
+        se_assert_msg(se_hash_table_get(cache.keyToEntry, entry.key), "Probably hash table key contains pointer to value that was changed after se_hash_table_set");
+        destroy(entry.object);
+        se_hash_table_remove(cache.keyToEntry, entry.key);
+        _se_vk_object_cache_unlink(cache, index);
+        entry.object = nullptr;
+        se_dynamic_array_push(cache.freeEntries, index);
+        stats->numEvicted += 1;
+    }
+}
+
+#endif
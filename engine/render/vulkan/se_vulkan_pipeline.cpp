@@ -27,12 +27,27 @@ bool se_vk_pipeline_has_vertex_input(const SimpleSpirvReflection* reflection)
     return false;
 }
 
-SeVkDescriptorSetLayoutCreateInfos se_vk_pipeline_get_discriptor_set_layout_create_infos(const SeAllocatorBindings& allocator, const SimpleSpirvReflection** programReflections, size_t numProgramReflections)
+//
+// Bindless heap set isn't a part of the regular layouts, its bindings are only validated against the heap layout
+//
+bool se_vk_pipeline_is_bindless_uniform(const SsrUniform* uniform)
+{
+    if (uniform->set != SE_BINDLESS_SET) return false;
+    const bool isValid =
+        (uniform->binding == SE_BINDLESS_BUFFERS_BINDING   && uniform->kind == SSR_UNIFORM_STORAGE_BUFFER) ||
+        (uniform->binding == SE_BINDLESS_TEXTURES_BINDING  && uniform->kind == SSR_UNIFORM_SAMPLED_IMAGE)  ||
+        (uniform->binding == SE_BINDLESS_SAMPLERS_BINDING  && uniform->kind == SSR_UNIFORM_SAMPLER);
+    se_assert_msg(isValid, "Bindless set must contain only storage buffers, textures and samplers at SE_BINDLESS_*_BINDING bindings");
+    return true;
+}
+
+SeVkDescriptorSetLayoutCreateInfos se_vk_pipeline_get_discriptor_set_layout_create_infos(const SeAllocatorBindings& allocator, const VkPhysicalDeviceLimits* limits, const SimpleSpirvReflection** programReflections, size_t numProgramReflections, bool* usesBindlessSet)
 {
     SeVkGeneralBitmask setBindingMasks[SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS] = {0};
     //
     // Fill binding masks
     //
+    *usesBindlessSet = false;
     for (size_t it = 0; it < numProgramReflections; it++)
     {
         const SimpleSpirvReflection* reflection = programReflections[it];
@@ -41,6 +56,11 @@ SeVkDescriptorSetLayoutCreateInfos se_vk_pipeline_get_discriptor_set_layout_crea
             const SsrUniform* uniform = &reflection->uniforms[uniformIt];
             se_assert(uniform->set < SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS);
             se_assert(uniform->binding < SE_VK_GENERAL_BITMASK_WIDTH);
+            if (se_vk_pipeline_is_bindless_uniform(uniform))
+            {
+                *usesBindlessSet = true;
+                continue;
+            }
             setBindingMasks[uniform->set] |= 1 << uniform->binding;
         }
     }
@@ -118,6 +138,7 @@ SeVkDescriptorSetLayoutCreateInfos se_vk_pipeline_get_discriptor_set_layout_crea
         for (size_t uniformIt = 0; uniformIt < reflection->numUniforms; uniformIt++)
         {
             const SsrUniform* const uniform = &reflection->uniforms[uniformIt];
+            if (uniform->set == SE_BINDLESS_SET) continue;
             const VkDescriptorType uniformDescriptorType =
                 uniform->kind == SSR_UNIFORM_SAMPLER                 ? (VkDescriptorType)VK_DESCRIPTOR_TYPE_SAMPLER :
                 uniform->kind == SSR_UNIFORM_SAMPLED_IMAGE           ? (VkDescriptorType)VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE :
@@ -158,6 +179,37 @@ SeVkDescriptorSetLayoutCreateInfos se_vk_pipeline_get_discriptor_set_layout_crea
             }
         }
     }
+    //
+    // Buffers get dynamic descriptor types while they fit into device limits, so bind commands can reuse descriptor
+    // sets with different buffer offsets (see se_vk_graph_get_descriptor_set). Arrays of buffers stay non-dynamic
+    //
+    {
+        uint32_t numDynamicUniformBuffers = 0;
+        uint32_t numDynamicStorageBuffers = 0;
+        for (auto it : layoutCreateInfos)
+        {
+            const VkDescriptorSetLayoutCreateInfo& layoutCreateInfo = se_iterator_value(it);
+            const size_t bindingsArrayInitialOffset = layoutCreateInfo.pBindings - se_dynamic_array_raw(bindings);
+            uint32_t numDynamicBuffersInSet = 0;
+            for (uint32_t bindingIt = 0; bindingIt < layoutCreateInfo.bindingCount; bindingIt++)
+            {
+                VkDescriptorSetLayoutBinding* const binding = &bindings[bindingsArrayInitialOffset + bindingIt];
+                if (binding->descriptorCount != 1 || numDynamicBuffersInSet == SE_MAX_BINDINGS) continue;
+                if (binding->descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER && numDynamicUniformBuffers < limits->maxDescriptorSetUniformBuffersDynamic)
+                {
+                    binding->descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+                    numDynamicUniformBuffers += 1;
+                    numDynamicBuffersInSet += 1;
+                }
+                else if (binding->descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER && numDynamicStorageBuffers < limits->maxDescriptorSetStorageBuffersDynamic)
+                {
+                    binding->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+                    numDynamicStorageBuffers += 1;
+                    numDynamicBuffersInSet += 1;
+                }
+            }
+        }
+    }
     return
     {
         layoutCreateInfos,
@@ -179,10 +231,11 @@ void se_vk_pipeline_create_descriptor_sets_and_layout(SeVkPipeline* pipeline, co
     const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(memoryManager);
     const SeAllocatorBindings frameAllocator = se_allocator_frame();
     //
-    // Descriptor set layouts and pools
+    // Descriptor set layouts, pool infos and update templates
     //
     {
-        SeVkDescriptorSetLayoutCreateInfos layoutCreateInfos = se_vk_pipeline_get_discriptor_set_layout_create_infos(frameAllocator, reflections, numReflections);
+        const VkPhysicalDeviceLimits* const limits = &se_vk_device_get_physical_device_properties(device)->limits;
+        SeVkDescriptorSetLayoutCreateInfos layoutCreateInfos = se_vk_pipeline_get_discriptor_set_layout_create_infos(frameAllocator, limits, reflections, numReflections, &pipeline->usesBindlessSet);
         pipeline->numDescriptorSetLayouts = se_dynamic_array_size(layoutCreateInfos.createInfos);
         for (size_t it = 0; it < pipeline->numDescriptorSetLayouts; it++)
         {
@@ -246,45 +299,140 @@ void se_vk_pipeline_create_descriptor_sets_and_layout(SeVkPipeline* pipeline, co
             {
                 .sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
                 .pNext          = nullptr,
-                .flags          = 0,
+                .flags          = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT, // Cached sets are freed individually
                 .maxSets        = SE_VK_RENDER_PIPELINE_NUMBER_OF_SETS_IN_POOL,
                 .poolSizeCount  = (uint32_t)layout->numPoolSizes, // @TODO : safe cast
                 .pPoolSizes     = layout->poolSizes,
             };
+            VkDescriptorUpdateTemplateEntry templateEntries[SE_VK_GENERAL_BITMASK_WIDTH];
+            for (uint32_t bindingIt = 0; bindingIt < layoutCreateInfo->bindingCount; bindingIt++)
+            {
+                templateEntries[bindingIt] =
+                {
+                    .dstBinding         = bindingIt,
+                    .dstArrayElement    = 0,
+                    .descriptorCount    = 1,
+                    .descriptorType     = layout->bindingInfos[bindingIt].descriptorType,
+                    .offset             = bindingIt * sizeof(SeVkDescriptorInfo),
+                    .stride             = sizeof(SeVkDescriptorInfo),
+                };
+            }
+            const VkDescriptorUpdateTemplateCreateInfo templateCreateInfo
+            {
+                .sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO,
+                .pNext                      = nullptr,
+                .flags                      = 0,
+                .descriptorUpdateEntryCount = layoutCreateInfo->bindingCount,
+                .pDescriptorUpdateEntries   = templateEntries,
+                .templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET,
+                .descriptorSetLayout        = layout->handle,
+                .pipelineBindPoint          = pipeline->bindPoint, // Ignored for descriptor set templates
+                .pipelineLayout             = VK_NULL_HANDLE,
+                .set                        = 0,
+            };
+            se_vk_check(vkCreateDescriptorUpdateTemplate(logicalHandle, &templateCreateInfo, callbacks, &layout->updateTemplate));
         }
         se_vk_pipeline_destroy_descriptor_set_layout_create_infos(&layoutCreateInfos);
+        se_vk_descriptor_set_cache_construct(&pipeline->descriptorSetCache, device);
     }
     //
-    // Pipeline layout
+    // Push constants. Range of each stage covers its block, sizes are rounded up to 4 bytes as required by vulkan
+    //
+    se_assert(numReflections <= SE_VK_PIPELINE_MAX_PUSH_CONSTANT_RANGES);
+    for (size_t it = 0; it < numReflections; it++)
+    {
+        const SimpleSpirvReflection* const reflection = reflections[it];
+        if (!reflection->pushConstantType) continue;
+        const uint32_t size = (uint32_t)((ssr_get_block_size(reflection->pushConstantType) + 3) & ~size_t(3)); // @TODO : safe cast
+        se_assert_msg(size <= SE_MAX_PUSH_CONSTANTS_SIZE, "Push constants block is bigger than SE_MAX_PUSH_CONSTANTS_SIZE");
+        const VkShaderStageFlags stage =
+            reflection->shaderType == SSR_SHADER_TYPE_VERTEX ? VK_SHADER_STAGE_VERTEX_BIT :
+            reflection->shaderType == SSR_SHADER_TYPE_FRAGMENT ? VK_SHADER_STAGE_FRAGMENT_BIT :
+            reflection->shaderType == SSR_SHADER_TYPE_COMPUTE ? VK_SHADER_STAGE_COMPUTE_BIT :
+            0;
+        pipeline->pushConstantStages |= stage;
+        //
+        // Insert the range keeping ranges sorted by size, stages with the same size share a range
+        //
+        size_t rangeIt = 0;
+        while (rangeIt < pipeline->numPushConstantRanges && pipeline->pushConstantRanges[rangeIt].size < size) rangeIt++;
+        VkPushConstantRange* const range = &pipeline->pushConstantRanges[rangeIt];
+        if (rangeIt < pipeline->numPushConstantRanges && range->size == size)
+        {
+            range->stageFlags |= stage;
+            continue;
+        }
+        for (size_t moveIt = pipeline->numPushConstantRanges; moveIt > rangeIt; moveIt--)
+        {
+            pipeline->pushConstantRanges[moveIt] = pipeline->pushConstantRanges[moveIt - 1];
+        }
+        *range = { .stageFlags = stage, .offset = 0, .size = size };
+        pipeline->numPushConstantRanges += 1;
+    }
+    //
+    // Pipeline layout. Bindless heap goes last, sets between regular ones and the heap get empty layouts
     //
     {
         VkDescriptorSetLayout descriptorSetLayoutHandles[SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS] = {0};
+        size_t numSetLayouts = pipeline->numDescriptorSetLayouts;
         for (size_t it = 0; it < pipeline->numDescriptorSetLayouts; it++)
         {
             descriptorSetLayoutHandles[it] = pipeline->descriptorSetLayouts[it].handle;
         }
+        if (pipeline->usesBindlessSet)
+        {
+            const SeVkBindlessHeap* const heap = &device->bindlessHeap;
+            se_assert_msg(se_vk_bindless_heap_is_valid(heap), "Program uses bindless set, but bindless mode isn't supported by the device");
+            for (size_t it = pipeline->numDescriptorSetLayouts; it < SE_BINDLESS_SET; it++)
+            {
+                descriptorSetLayoutHandles[it] = heap->emptyLayout;
+            }
+            descriptorSetLayoutHandles[SE_BINDLESS_SET] = heap->layout;
+            numSetLayouts = SE_BINDLESS_SET + 1;
+        }
         const VkPipelineLayoutCreateInfo pipelineLayoutInfo =
         {
             .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
             .pNext                  = nullptr,
             .flags                  = 0,
-            .setLayoutCount         = (uint32_t)pipeline->numDescriptorSetLayouts, // @TODO : safe cast
+            .setLayoutCount         = (uint32_t)numSetLayouts, // @TODO : safe cast
             .pSetLayouts            = descriptorSetLayoutHandles,
-            .pushConstantRangeCount = 0,
-            .pPushConstantRanges    = nullptr,
+            .pushConstantRangeCount = pipeline->numPushConstantRanges,
+            .pPushConstantRanges    = pipeline->numPushConstantRanges ? pipeline->pushConstantRanges : nullptr,
         };
         se_vk_check(vkCreatePipelineLayout(logicalHandle, &pipelineLayoutInfo, callbacks, &pipeline->layout));
     }
 }
 
+//
+// Same checks as se_vk_render_pass_validate_fragment_program_setup, but for the pipeline without a render pass. Dynamic rendering
+// has no subpasses, so program can't read input attachments and i-th shader output is the i-th color attachment
+//
+void se_vk_pipeline_validate_dynamic_rendering_fragment_program_setup(const SeVkPipelineRenderingFormats* formats, SeVkProgram* program)
+{
+    const SimpleSpirvReflection* const reflection = &program->reflection;
+    se_assert(reflection->shaderType == SSR_SHADER_TYPE_FRAGMENT);
+    for (size_t it = 0; it < reflection->numUniforms; it++)
+    {
+        se_assert_msg(reflection->uniforms[it].kind != SSR_UNIFORM_INPUT_ATTACHMENT, "Input attachments can't be used with dynamic rendering");
+    }
+    SeVkGeneralBitmask shaderColorAttachmentMask = 0;
+    for (size_t it = 0; it < reflection->numOutputs; it++)
+    {
+        const SsrShaderIO* const output = &reflection->outputs[it];
+        if (!output->isBuiltIn)
+        {
+            se_assert(output->location < SE_VK_GENERAL_BITMASK_WIDTH);
+            shaderColorAttachmentMask |= 1 << output->location;
+        }
+    }
+    const SeVkGeneralBitmask colorAttachmentMask = SeVkGeneralBitmask((1ull << formats->numColorFormats) - 1);
+    se_assert_msg(shaderColorAttachmentMask == colorAttachmentMask, "Mismatch between fragment shader outputs and color attachments");
+}
+
 void se_vk_pipeline_graphics_construct(SeVkPipeline* pipeline, SeVkGraphicsPipelineInfo* info)
 {
     SeVkDevice* const device = info->device;
-    const VkDevice logicalHandle = se_vk_device_get_logical_handle(device);
-    SeVkMemoryManager* const memoryManager = &device->memoryManager;
-    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(memoryManager);
-    const SeAllocatorBindings frameAllocator = se_allocator_frame();
-
     SeVkProgram* const vertexProgram = info->vertexProgram.program;
     SeVkProgram* const fragmentProgram = info->fragmentProgram.program;
     *pipeline =
@@ -296,25 +444,45 @@ void se_vk_pipeline_graphics_construct(SeVkPipeline* pipeline, SeVkGraphicsPipel
         .layout                     = VK_NULL_HANDLE,
         .descriptorSetLayouts       = { },
         .numDescriptorSetLayouts    = 0,
+        .usesBindlessSet            = false,
+        .pushConstantStages         = 0,
+        .pushConstantRanges         = { },
+        .numPushConstantRanges      = 0,
+        .descriptorSetCache         = { },
         .dependencies               = { .graphics = { vertexProgram, fragmentProgram, info->pass } },
+        .isCompiled                 = 0,
     };
 
     const SimpleSpirvReflection* const vertexReflection = &vertexProgram->reflection;
     const SimpleSpirvReflection* const fragmentReflection = &fragmentProgram->reflection;
-    const VkBool32 isStencilSupported = se_vk_device_is_stencil_supported(device);
     se_assert(!se_vk_pipeline_has_vertex_input(vertexReflection) && "Vertex shader inputs are not supported");
-    se_assert(!vertexReflection->pushConstantType && "Push constants are not supported");
-    se_assert(!fragmentReflection->pushConstantType && "Push constants are not supported");
-    se_assert((info->subpassIndex < se_vk_render_pass_num_subpasses(info->pass)) && "Incorrect pipeline subpass index");
-    se_vk_render_pass_validate_fragment_program_setup(info->pass, fragmentProgram, info->subpassIndex);
+    if (info->pass)
+    {
+        se_assert((info->subpassIndex < se_vk_render_pass_num_subpasses(info->pass)) && "Incorrect pipeline subpass index");
+        se_vk_render_pass_validate_fragment_program_setup(info->pass, fragmentProgram, info->subpassIndex);
+    }
+    else
+    {
+        se_assert_msg(se_vk_device_is_dynamic_rendering_supported(device), "Pipeline without a render pass requires dynamic rendering");
+        se_assert((info->subpassIndex == 0) && "Dynamic rendering has no subpasses");
+        se_vk_pipeline_validate_dynamic_rendering_fragment_program_setup(&info->renderingFormats, fragmentProgram);
+    }
     
     const SimpleSpirvReflection* reflections[] = { vertexReflection, fragmentReflection };
     se_vk_pipeline_create_descriptor_sets_and_layout(pipeline, reflections, se_array_size(reflections));
-    
+}
+
+void se_vk_pipeline_graphics_compile(SeVkPipeline* pipeline, const SeVkGraphicsPipelineInfo* info)
+{
+    SeVkDevice* const device = info->device;
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(device);
+    const VkBool32 isStencilSupported = se_vk_device_is_stencil_supported(device);
+
+    SeVkProgramSpecialization specializations[2];
     const VkPipelineShaderStageCreateInfo shaderStages[] =
     {
-        se_vk_program_get_shader_stage_create_info(device, &info->vertexProgram, frameAllocator),
-        se_vk_program_get_shader_stage_create_info(device, &info->fragmentProgram, frameAllocator),
+        se_vk_program_get_shader_stage_create_info(device, &info->vertexProgram, &specializations[0]),
+        se_vk_program_get_shader_stage_create_info(device, &info->fragmentProgram, &specializations[1]),
     };
     const VkExtent2D swapChainExtent = se_vk_device_get_swap_chain_extent(device);
     const VkPipelineVertexInputStateCreateInfo vertexInputInfo = se_vk_utils_vertex_input_state_create_info(0, nullptr, 0, nullptr);
@@ -360,13 +528,25 @@ void se_vk_pipeline_graphics_construct(SeVkPipeline* pipeline, SeVkGraphicsPipel
             .colorWriteMask         = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
         };
     }
-    const uint32_t numColorAttachments = se_vk_render_pass_get_num_color_attachments(info->pass, info->subpassIndex);
+    const uint32_t numColorAttachments = info->pass
+        ? se_vk_render_pass_get_num_color_attachments(info->pass, info->subpassIndex)
+        : info->renderingFormats.numColorFormats;
     const VkPipelineColorBlendStateCreateInfo colorBlending = se_vk_utils_color_blending_create_info(colorBlendAttachments, numColorAttachments);
     const VkPipelineDynamicStateCreateInfo dynamicState = se_vk_utils_dynamic_state_default_create_info();
+    const VkPipelineRenderingCreateInfoKHR renderingInfo
+    {
+        .sType                      = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
+        .pNext                      = nullptr,
+        .viewMask                   = 0,
+        .colorAttachmentCount       = info->renderingFormats.numColorFormats,
+        .pColorAttachmentFormats    = info->renderingFormats.colorFormats,
+        .depthAttachmentFormat      = info->renderingFormats.depthFormat,
+        .stencilAttachmentFormat    = info->renderingFormats.stencilFormat,
+    };
     const VkGraphicsPipelineCreateInfo pipelineCreateInfo
     {
         .sType                  = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-        .pNext                  = nullptr,
+        .pNext                  = info->pass ? nullptr : &renderingInfo,
         .flags                  = 0,
         .stageCount             = se_array_size(shaderStages),
         .pStages                = shaderStages,
@@ -380,22 +560,20 @@ void se_vk_pipeline_graphics_construct(SeVkPipeline* pipeline, SeVkGraphicsPipel
         .pColorBlendState       = &colorBlending,
         .pDynamicState          = &dynamicState,
         .layout                 = pipeline->layout,
-        .renderPass             = info->pass->handle,
+        .renderPass             = info->pass ? info->pass->handle : VK_NULL_HANDLE,
         .subpass                = info->subpassIndex, // @TODO : safe cast
         .basePipelineHandle     = VK_NULL_HANDLE,
         .basePipelineIndex      = -1,
     };
-    se_vk_check(vkCreateGraphicsPipelines(logicalHandle, VK_NULL_HANDLE, 1, &pipelineCreateInfo, callbacks, &pipeline->handle));
+    const uint64_t creationBegin = _se_get_perf_counter();
+    se_vk_check(vkCreateGraphicsPipelines(logicalHandle, device->pipelineCache.handle, 1, &pipelineCreateInfo, nullptr, &pipeline->handle));
+    se_vk_pipeline_cache_register_creation(&device->pipelineCache, creationBegin, _se_get_perf_counter());
+    se_platform_atomic_32_bit_store(&pipeline->isCompiled, 1, SE_RELEASE);
 }
 
 void se_vk_pipeline_compute_construct(SeVkPipeline* pipeline, SeVkComputePipelineInfo* info)
 {
     SeVkDevice* const device = info->device;
-    const VkDevice logicalHandle = se_vk_device_get_logical_handle(device);
-    SeVkMemoryManager* const memoryManager = &device->memoryManager;
-    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(memoryManager);
-    const SeAllocatorBindings frameAllocator = se_allocator_frame();
-    
     SeVkProgram* const program = info->program.program;
     *pipeline =
     {
@@ -406,24 +584,39 @@ void se_vk_pipeline_compute_construct(SeVkPipeline* pipeline, SeVkComputePipelin
         .layout                     = VK_NULL_HANDLE,
         .descriptorSetLayouts       = { },
         .numDescriptorSetLayouts    = 0,
+        .usesBindlessSet            = false,
+        .pushConstantStages         = 0,
+        .pushConstantRanges         = { },
+        .numPushConstantRanges      = 0,
+        .descriptorSetCache         = { },
         .dependencies               = { .compute = { program } },
+        .isCompiled                 = 0,
     };
 
     const SimpleSpirvReflection* reflection = &program->reflection;
-    se_assert(!reflection->pushConstantType && "Push constants are not supported");
-    
     se_vk_pipeline_create_descriptor_sets_and_layout(pipeline, &reflection, 1);
+}
+
+void se_vk_pipeline_compute_compile(SeVkPipeline* pipeline, const SeVkComputePipelineInfo* info)
+{
+    SeVkDevice* const device = info->device;
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(device);
+
+    SeVkProgramSpecialization specialization;
     const VkComputePipelineCreateInfo pipelineCreateInfo
     {
         .sType              = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
         .pNext              = nullptr,
         .flags              = 0,
-        .stage              = se_vk_program_get_shader_stage_create_info(device, &info->program, frameAllocator),
+        .stage              = se_vk_program_get_shader_stage_create_info(device, &info->program, &specialization),
         .layout             = pipeline->layout,
         .basePipelineHandle = VK_NULL_HANDLE,
         .basePipelineIndex  = -1,
     };
-    se_vk_check(vkCreateComputePipelines(logicalHandle, VK_NULL_HANDLE, 1, &pipelineCreateInfo, callbacks, &pipeline->handle));
+    const uint64_t creationBegin = _se_get_perf_counter();
+    se_vk_check(vkCreateComputePipelines(logicalHandle, device->pipelineCache.handle, 1, &pipelineCreateInfo, nullptr, &pipeline->handle));
+    se_vk_pipeline_cache_register_creation(&device->pipelineCache, creationBegin, _se_get_perf_counter());
+    se_platform_atomic_32_bit_store(&pipeline->isCompiled, 1, SE_RELEASE);
 }
 
 void se_vk_pipeline_destroy(SeVkPipeline* pipeline)
@@ -435,19 +628,18 @@ void se_vk_pipeline_destroy(SeVkPipeline* pipeline)
     for (size_t layoutIt = 0; layoutIt < pipeline->numDescriptorSetLayouts; layoutIt++)
     {
         SeVkDescriptorSetLayout* const layout = &pipeline->descriptorSetLayouts[layoutIt];
+        vkDestroyDescriptorUpdateTemplate(logicalHandle, layout->updateTemplate, callbacks);
         vkDestroyDescriptorSetLayout(logicalHandle, layout->handle, callbacks);
     }
-    vkDestroyPipeline(logicalHandle, pipeline->handle, callbacks);
+    se_vk_descriptor_set_cache_destroy(&pipeline->descriptorSetCache);
+    // @NOTE : pipeline handles are created without allocation callbacks (see se_vulkan_pipeline.hpp)
+    if (pipeline->handle != VK_NULL_HANDLE) vkDestroyPipeline(logicalHandle, pipeline->handle, nullptr);
     vkDestroyPipelineLayout(logicalHandle, pipeline->layout, callbacks);
 }
 
-VkDescriptorPool se_vk_pipeline_create_descriptor_pool(SeVkPipeline* pipeline, size_t set)
+inline bool se_vk_pipeline_is_compiled(const SeVkPipeline* pipeline)
 {
-    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&pipeline->device->memoryManager);
-    const VkDevice logicalHandle = se_vk_device_get_logical_handle(pipeline->device);
-    VkDescriptorPool pool = VK_NULL_HANDLE;
-    se_vk_check(vkCreateDescriptorPool(logicalHandle, &pipeline->descriptorSetLayouts[set].poolCreateInfo, callbacks, &pool));
-    return pool;
+    return se_platform_atomic_32_bit_load(&pipeline->isCompiled, SE_ACQUIRE) != 0;
 }
 
 size_t se_vk_pipeline_get_biggest_set_index(const SeVkPipeline* pipeline)
@@ -469,3 +661,26 @@ SeVkDescriptorSetBindingInfo se_vk_pipeline_get_binding_info(const SeVkPipeline*
 {
     return pipeline->descriptorSetLayouts[set].bindingInfos[binding];
 }
+
+uint32_t se_vk_pipeline_get_push_constants_size(const SeVkPipeline* pipeline)
+{
+    return pipeline->numPushConstantRanges ? pipeline->pushConstantRanges[pipeline->numPushConstantRanges - 1].size : 0;
+}
+
+void se_vk_pipeline_push_constants(const SeVkPipeline* pipeline, VkCommandBuffer handle, const void* data, uint32_t size)
+{
+    se_assert_msg(size <= se_vk_pipeline_get_push_constants_size(pipeline), "Push constants data is bigger than push constants blocks of pipeline programs");
+    //
+    // Bytes between the ends of two neighbour ranges are covered by the bigger range and by every range after it,
+    // so they are pushed with the stages of those ranges only
+    //
+    uint32_t offset = 0;
+    for (uint32_t rangeIt = 0; rangeIt < pipeline->numPushConstantRanges && offset < size; rangeIt++)
+    {
+        const uint32_t end = se_min(pipeline->pushConstantRanges[rangeIt].size, size);
+        VkShaderStageFlags stages = 0;
+        for (uint32_t it = rangeIt; it < pipeline->numPushConstantRanges; it++) stages |= pipeline->pushConstantRanges[it].stageFlags;
+        vkCmdPushConstants(handle, pipeline->layout, stages, offset, end - offset, ((const uint8_t*)data) + offset);
+        offset = end;
+    }
+}
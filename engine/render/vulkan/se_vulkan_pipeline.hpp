@@ -4,22 +4,16 @@
 #include "se_vulkan_base.hpp"
 #include "se_vulkan_program.hpp"
 #include "se_vulkan_render_pass.hpp"
+#include "se_vulkan_descriptor_set.hpp"
 
-struct SeVkDescriptorSetBindingInfo
-{
-    VkDescriptorType descriptorType;
-};
-
-struct SeVkDescriptorSetLayout
-{
-    SeVkDescriptorSetBindingInfo    bindingInfos[SE_VK_GENERAL_BITMASK_WIDTH];
-    VkDescriptorPoolSize            poolSizes[SE_VK_GENERAL_BITMASK_WIDTH];
-    size_t                          numPoolSizes;
-    size_t                          numBindings;
-    VkDescriptorPoolCreateInfo      poolCreateInfo;
-    VkDescriptorSetLayout           handle;
-};
+constexpr size_t SE_VK_PIPELINE_MAX_PUSH_CONSTANT_RANGES = 2; // Graphics pipelines have two programs, compute pipelines have one
 
+//
+// Push constants. Each stage that declares a push constants block gets a range that starts at zero and covers the
+// block (size comes from reflection, see ssr_get_block_size). Stages with equal block sizes share a range, ranges are
+// sorted by size. Stage flags of vkCmdPushConstants must match every range that overlaps pushed bytes, so data is pushed
+// with se_vk_pipeline_push_constants, which splits it at range ends.
+//
 struct SeVkPipeline
 {
     SeVkObject              object;
@@ -29,6 +23,11 @@ struct SeVkPipeline
     VkPipelineLayout        layout;
     SeVkDescriptorSetLayout descriptorSetLayouts[SeVkConfig::RENDER_PIPELINE_MAX_DESCRIPTOR_SETS];
     size_t                  numDescriptorSetLayouts;
+    bool                    usesBindlessSet;    // Programs declare SE_BINDLESS_SET, heap set is bound together with the pipeline
+    VkShaderStageFlags      pushConstantStages; // Stages that declare push constants, zero if pipeline doesn't use them
+    VkPushConstantRange     pushConstantRanges[SE_VK_PIPELINE_MAX_PUSH_CONSTANT_RANGES];
+    uint32_t                numPushConstantRanges;
+    SeVkDescriptorSetCache  descriptorSetCache;
     union
     {
         struct
@@ -42,12 +41,24 @@ struct SeVkPipeline
             SeVkProgram* program;
         } compute;
     } dependencies;
+    uint32_t                isCompiled; // Atomic, set by the thread that compiled the pipeline
+};
+
+//
+// Attachment formats of a pipeline that is used with dynamic rendering instead of a render pass
+//
+struct SeVkPipelineRenderingFormats
+{
+    VkFormat    colorFormats[SeVkConfig::FRAMEBUFFER_MAX_TEXTURES];
+    uint32_t    numColorFormats;
+    VkFormat    depthFormat;    // VK_FORMAT_UNDEFINED if there is no depth stencil attachment
+    VkFormat    stencilFormat;  // VK_FORMAT_UNDEFINED if there is no depth stencil attachment or stencil isn't supported
 };
 
 struct SeVkGraphicsPipelineInfo
 {
     SeVkDevice*                 device;
-    SeVkRenderPass*             pass;
+    SeVkRenderPass*             pass;               // Null if pipeline is used with dynamic rendering (see renderingFormats)
     SeVkProgramWithConstants    vertexProgram;
     SeVkProgramWithConstants    fragmentProgram;
     uint32_t                    subpassIndex;
@@ -60,6 +71,7 @@ struct SeVkGraphicsPipelineInfo
     VkCullModeFlags             cullMode;
     VkFrontFace                 frontFace;
     VkSampleCountFlagBits       sampling;
+    SeVkPipelineRenderingFormats renderingFormats;  // Used only if pass is null, must be zeroed otherwise
 };
 
 struct SeVkComputePipelineInfo
@@ -68,15 +80,27 @@ struct SeVkComputePipelineInfo
     SeVkProgramWithConstants    program;
 };
 
+//
+// Pipeline creation is split in two steps :
+// 1. Construct - creates descriptor set layouts and pipeline layout. Must be called on the main thread.
+// 2. Compile - creates VkPipeline. Can be called on any thread, so it doesn't use frame allocator or
+//    memory manager allocation callbacks (those aren't thread safe). Pipeline can be used only after
+//    se_vk_pipeline_is_compiled returns true.
+//
 void se_vk_pipeline_graphics_construct(SeVkPipeline* pipeline, SeVkGraphicsPipelineInfo* info);
+void se_vk_pipeline_graphics_compile(SeVkPipeline* pipeline, const SeVkGraphicsPipelineInfo* info);
 void se_vk_pipeline_compute_construct(SeVkPipeline* pipeline, SeVkComputePipelineInfo* info);
+void se_vk_pipeline_compute_compile(SeVkPipeline* pipeline, const SeVkComputePipelineInfo* info);
 void se_vk_pipeline_destroy(SeVkPipeline* pipeline);
 
-VkDescriptorPool                se_vk_pipeline_create_descriptor_pool(SeVkPipeline* pipeline, size_t set);
+bool                            se_vk_pipeline_is_compiled(const SeVkPipeline* pipeline);
+
 size_t                          se_vk_pipeline_get_biggest_set_index(const SeVkPipeline* pipeline);
 size_t                          se_vk_pipeline_get_biggest_binding_index(const SeVkPipeline* pipeline, size_t set);
 VkDescriptorSetLayout           se_vk_pipeline_get_descriptor_set_layout(SeVkPipeline* pipeline, size_t set);
 SeVkDescriptorSetBindingInfo    se_vk_pipeline_get_binding_info(const SeVkPipeline* pipeline, size_t set, size_t binding);
+uint32_t                        se_vk_pipeline_get_push_constants_size(const SeVkPipeline* pipeline);
+void                            se_vk_pipeline_push_constants(const SeVkPipeline* pipeline, VkCommandBuffer handle, const void* data, uint32_t size);
 
 template<>
 void se_vk_destroy<SeVkPipeline>(SeVkPipeline* res)
@@ -87,7 +111,7 @@ void se_vk_destroy<SeVkPipeline>(SeVkPipeline* res)
 template<>
 void se_hash_value_builder_absorb<SeVkGraphicsPipelineInfo>(SeHashValueBuilder& builder, const SeVkGraphicsPipelineInfo& value)
 {
-    se_hash_value_builder_absorb(builder, *value.pass);
+    if (value.pass) se_hash_value_builder_absorb(builder, *value.pass);
     se_hash_value_builder_absorb(builder, value.vertexProgram);
     se_hash_value_builder_absorb(builder, value.fragmentProgram);
     const size_t absorbOffset = (size_t)&(((SeVkGraphicsPipelineInfo*)0)->subpassIndex);
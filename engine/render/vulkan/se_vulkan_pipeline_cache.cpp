@@ -0,0 +1,168 @@
+
+#include "se_vulkan_pipeline_cache.hpp"
+#include "se_vulkan_device.hpp"
+#include "engine/subsystems/se_file_system.hpp"
+
+constexpr uint32_t      SE_VK_PIPELINE_CACHE_FILE_MAGIC     = 0x43505653; // "SVPC"
+constexpr uint32_t      SE_VK_PIPELINE_CACHE_FILE_VERSION   = 1;
+constexpr const char*   SE_VK_PIPELINE_CACHE_FILE_NAME      = "pipeline_cache.bin";
+
+bool se_vk_pipeline_cache_is_data_valid(SeVkDevice* device, const void* fileData, size_t fileDataSize)
+{
+    const VkPhysicalDeviceProperties* const properties = se_vk_device_get_physical_device_properties(device);
+    //
+    // Validate our header
+    //
+    if (fileDataSize < sizeof(SeVkPipelineCacheFileHeader)) return false;
+    SeVkPipelineCacheFileHeader header;
+    memcpy(&header, fileData, sizeof(SeVkPipelineCacheFileHeader));
+    if (header.magic != SE_VK_PIPELINE_CACHE_FILE_MAGIC) return false;
+    if (header.version != SE_VK_PIPELINE_CACHE_FILE_VERSION) return false;
+    if (header.vendorId != properties->vendorID) return false;
+    if (header.deviceId != properties->deviceID) return false;
+    if (header.driverVersion != properties->driverVersion) return false;
+    if (memcmp(header.pipelineCacheUuid, properties->pipelineCacheUUID, VK_UUID_SIZE) != 0) return false;
+    if (header.dataSize != fileDataSize - sizeof(SeVkPipelineCacheFileHeader)) return false;
+    const void* const cacheData = ((const char*)fileData) + sizeof(SeVkPipelineCacheFileHeader);
+    if (!se_hash_value_is_equal(header.dataHash, se_hash_value_generate_raw({ (void*)cacheData, header.dataSize }))) return false;
+    //
+    // Validate driver's header (drivers must check it too, but some of them crash on unexpected data)
+    //
+    if (header.dataSize < sizeof(VkPipelineCacheHeaderVersionOne)) return false;
+    VkPipelineCacheHeaderVersionOne driverHeader;
+    memcpy(&driverHeader, cacheData, sizeof(VkPipelineCacheHeaderVersionOne));
+    if (driverHeader.headerSize < sizeof(VkPipelineCacheHeaderVersionOne)) return false;
+    if (driverHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) return false;
+    if (driverHeader.vendorID != properties->vendorID) return false;
+    if (driverHeader.deviceID != properties->deviceID) return false;
+    if (memcmp(driverHeader.pipelineCacheUUID, properties->pipelineCacheUUID, VK_UUID_SIZE) != 0) return false;
+    return true;
+}
+
+void se_vk_pipeline_cache_construct(SeVkPipelineCache* cache, const SeVkPipelineCacheInfo* info)
+{
+    SeVkDevice* const device = info->device;
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(device);
+    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&device->memoryManager);
+    *cache =
+    {
+        .device                 = device,
+        .handle                 = VK_NULL_HANDLE,
+        .file                   = { },
+        .loadedDataSize         = 0,
+        .lastSaveFrame          = 0,
+        .numCreatedPipelines    = 0,
+        .numPipelinesSinceSave  = 0,
+        .creationTicks          = 0,
+    };
+    //
+    // Load cache data from disk
+    //
+    SeFileContent content = { };
+    if (info->isPersistent)
+    {
+        cache->file = se_fs_file_create(SE_VK_PIPELINE_CACHE_FILE_NAME);
+        content = se_fs_file_read(cache->file, se_allocator_frame());
+    }
+    const bool isDataValid = se_vk_pipeline_cache_is_data_valid(device, content.data, content.dataSize);
+    if (content.dataSize && !isDataValid)
+    {
+        se_message("Pipeline cache file is invalid or was created by a different device/driver, starting with an empty cache");
+    }
+    const VkPipelineCacheCreateInfo createInfo
+    {
+        .sType              = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .pNext              = nullptr,
+        .flags              = 0,
+        .initialDataSize    = isDataValid ? content.dataSize - sizeof(SeVkPipelineCacheFileHeader) : 0,
+        .pInitialData       = isDataValid ? ((const char*)content.data) + sizeof(SeVkPipelineCacheFileHeader) : nullptr,
+    };
+    const VkResult result = vkCreatePipelineCache(logicalHandle, &createInfo, callbacks, &cache->handle);
+    if (result != VK_SUCCESS && isDataValid)
+    {
+        // @NOTE : driver rejected the data, so fallback to the empty cache
+        const VkPipelineCacheCreateInfo emptyCreateInfo
+        {
+            .sType              = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+            .pNext              = nullptr,
+            .flags              = 0,
+            .initialDataSize    = 0,
+            .pInitialData       = nullptr,
+        };
+        se_vk_check(vkCreatePipelineCache(logicalHandle, &emptyCreateInfo, callbacks, &cache->handle));
+    }
+    else
+    {
+        se_vk_check(result);
+        cache->loadedDataSize = createInfo.initialDataSize;
+    }
+    if (content.data) se_fs_file_content_free(content);
+}
+
+void se_vk_pipeline_cache_destroy(SeVkPipelineCache* cache)
+{
+    const double creationTimeMs = double(cache->creationTicks) / double(_se_get_perf_frequency()) * 1000.0;
+    se_message
+    (
+        "Pipeline cache : {} pipelines created in {} ms, {} bytes were loaded from disk",
+        cache->numCreatedPipelines, creationTimeMs, cache->loadedDataSize
+    );
+    if (cache->numPipelinesSinceSave) se_vk_pipeline_cache_save(cache);
+
+    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&cache->device->memoryManager);
+    vkDestroyPipelineCache(se_vk_device_get_logical_handle(cache->device), cache->handle, callbacks);
+}
+
+void se_vk_pipeline_cache_update(SeVkPipelineCache* cache, size_t frameNumber)
+{
+    if (!se_platform_atomic_64_bit_load(&cache->numPipelinesSinceSave, SE_RELAXED)) return;
+    if ((frameNumber - cache->lastSaveFrame) < SeVkConfig::PIPELINE_CACHE_SAVE_PERIOD_FRAMES) return;
+    se_vk_pipeline_cache_save(cache);
+    cache->lastSaveFrame = frameNumber;
+}
+
+void se_vk_pipeline_cache_save(SeVkPipelineCache* cache)
+{
+    // @NOTE : VkPipelineCache is internally synchronized, so it is safe to save it while pipelines are being compiled
+    se_platform_atomic_64_bit_store(&cache->numPipelinesSinceSave, 0, SE_RELAXED);
+    if (!cache->file) return;
+
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(cache->device);
+    const VkPhysicalDeviceProperties* const properties = se_vk_device_get_physical_device_properties(cache->device);
+    const SeAllocatorBindings frameAllocator = se_allocator_frame();
+
+    size_t dataSize = 0;
+    se_vk_check(vkGetPipelineCacheData(logicalHandle, cache->handle, &dataSize, nullptr));
+    if (!dataSize) return;
+
+    const size_t fileDataSize = sizeof(SeVkPipelineCacheFileHeader) + dataSize;
+    char* const fileData = (char*)se_alloc(frameAllocator, fileDataSize, se_alloc_tag);
+    char* const cacheData = fileData + sizeof(SeVkPipelineCacheFileHeader);
+    se_vk_check(vkGetPipelineCacheData(logicalHandle, cache->handle, &dataSize, cacheData));
+
+    SeVkPipelineCacheFileHeader header
+    {
+        .magic              = SE_VK_PIPELINE_CACHE_FILE_MAGIC,
+        .version            = SE_VK_PIPELINE_CACHE_FILE_VERSION,
+        .vendorId           = properties->vendorID,
+        .deviceId           = properties->deviceID,
+        .driverVersion      = properties->driverVersion,
+        .pipelineCacheUuid  = { },
+        .dataSize           = dataSize,
+        .dataHash           = se_hash_value_generate_raw({ cacheData, dataSize }),
+    };
+    memcpy(header.pipelineCacheUuid, properties->pipelineCacheUUID, VK_UUID_SIZE);
+    memcpy(fileData, &header, sizeof(SeVkPipelineCacheFileHeader));
+
+    se_fs_file_write_begin(cache->file, SeFileWriteOpenMode::CLEAR);
+    se_fs_file_write(cache->file, se_data_provider_from_memory(fileData, fileDataSize));
+    se_fs_file_write_end(cache->file);
+    se_dealloc(frameAllocator, fileData, fileDataSize);
+}
+
+void se_vk_pipeline_cache_register_creation(SeVkPipelineCache* cache, uint64_t beginTicks, uint64_t endTicks)
+{
+    se_platform_atomic_64_bit_increment(&cache->numCreatedPipelines);
+    se_platform_atomic_64_bit_increment(&cache->numPipelinesSinceSave);
+    se_platform_atomic_64_bit_add(&cache->creationTicks, endTicks - beginTicks);
+}
@@ -0,0 +1,58 @@
+#ifndef _SE_VULKAN_PIPELINE_CACHE_H_
+#define _SE_VULKAN_PIPELINE_CACHE_H_
+
+#include "se_vulkan_base.hpp"
+#include "engine/subsystems/file_system/se_file_system_data_types.hpp"
+
+//
+// Pipeline cache wraps VkPipelineCache, which is shared by all pipelines of the device.
+//
+// Cache data is loaded from the user data folder at startup and saved at shutdown and periodically
+// (if new pipelines were created since the last save). Saved file starts with SeVkPipelineCacheFileHeader,
+// which identifies the gpu and driver that produced the data. Data is discarded if header, data hash
+// or driver's own VkPipelineCacheHeaderVersionOne doesn't match the current device, so corrupted or
+// outdated files just result in a cold start.
+//
+// If user data folder is not created, cache lives only in memory.
+//
+
+struct SeVkPipelineCacheFileHeader
+{
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    vendorId;
+    uint32_t    deviceId;
+    uint32_t    driverVersion;
+    uint8_t     pipelineCacheUuid[VK_UUID_SIZE];
+    uint64_t    dataSize;
+    SeHashValue dataHash;
+};
+
+struct SeVkPipelineCache
+{
+    SeVkDevice*     device;
+    VkPipelineCache handle;
+    SeFileHandle    file;
+    size_t          loadedDataSize;
+    size_t          lastSaveFrame;
+    uint64_t        numCreatedPipelines;    // Atomic
+    uint64_t        numPipelinesSinceSave;  // Atomic
+    uint64_t        creationTicks;          // Atomic
+};
+
+struct SeVkPipelineCacheInfo
+{
+    SeVkDevice* device;
+    bool        isPersistent;
+};
+
+void    se_vk_pipeline_cache_construct(SeVkPipelineCache* cache, const SeVkPipelineCacheInfo* info);
+void    se_vk_pipeline_cache_destroy(SeVkPipelineCache* cache);
+void    se_vk_pipeline_cache_update(SeVkPipelineCache* cache, size_t frameNumber);
+void    se_vk_pipeline_cache_save(SeVkPipelineCache* cache);
+
+// Pipeline compile functions report creation time, so cold and warm startups can be compared.
+// Can be called from any thread
+void    se_vk_pipeline_cache_register_creation(SeVkPipelineCache* cache, uint64_t beginTicks, uint64_t endTicks);
+
+#endif
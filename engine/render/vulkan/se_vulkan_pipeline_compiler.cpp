@@ -0,0 +1,127 @@
+
+#include "se_vulkan_pipeline_compiler.hpp"
+#include "se_vulkan_device.hpp"
+
+void se_vk_pipeline_compiler_thread(void* userData)
+{
+    SeVkPipelineCompiler* const compiler = (SeVkPipelineCompiler*)userData;
+    while (true)
+    {
+        se_platform_semaphore_wait(compiler->jobsSemaphore);
+        if (se_platform_atomic_32_bit_load(&compiler->shouldStop, SE_ACQUIRE)) break;
+
+        SeVkPipelineCompileJob job;
+        if (!se_thread_safe_queue_dequeue(compiler->jobs, &job)) continue;
+        if (job.pipeline->bindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS)
+            se_vk_pipeline_graphics_compile(job.pipeline, &job.graphics);
+        else
+            se_vk_pipeline_compute_compile(job.pipeline, &job.compute);
+        se_platform_atomic_64_bit_decrement(&compiler->numPendingJobs);
+    }
+}
+
+void se_vk_pipeline_compiler_construct(SeVkPipelineCompiler* compiler, const SeVkPipelineCompilerInfo* info)
+{
+    // @NOTE : one core is left for the main thread
+    const size_t numCores = se_platform_get_num_logical_cores();
+    const size_t numThreads = se_max(se_min(numCores - 1, SeVkConfig::PIPELINE_COMPILER_MAX_THREADS), size_t(1));
+    *compiler =
+    {
+        .device                 = info->device,
+        .threads                = { },
+        .numThreads             = numThreads,
+        .jobs                   = { },
+        .jobsSemaphore          = se_platform_semaphore_create(uint32_t(SeVkConfig::PIPELINE_COMPILER_QUEUE_CAPACITY + SeVkConfig::PIPELINE_COMPILER_MAX_THREADS)),
+        .numPendingJobs         = 0,
+        .shouldStop             = 0,
+        .frameStallTicks        = 0,
+        .lastFrameStallTicks    = 0,
+        .maxFrameStallTicks     = 0,
+        .numSkippedPasses       = 0,
+        .numFallbackPasses      = 0,
+    };
+    se_thread_safe_queue_construct(compiler->jobs, se_allocator_persistent(), SeVkConfig::PIPELINE_COMPILER_QUEUE_CAPACITY);
+    for (size_t it = 0; it < numThreads; it++)
+    {
+        se_platform_thread_construct(&compiler->threads[it], se_vk_pipeline_compiler_thread, compiler);
+    }
+}
+
+void se_vk_pipeline_compiler_destroy(SeVkPipelineCompiler* compiler)
+{
+    while (se_vk_pipeline_compiler_is_busy(compiler)) se_platform_thread_yield();
+    se_platform_atomic_32_bit_store(&compiler->shouldStop, 1, SE_RELEASE);
+    se_platform_semaphore_signal(compiler->jobsSemaphore, uint32_t(compiler->numThreads));
+    for (size_t it = 0; it < compiler->numThreads; it++)
+    {
+        se_platform_thread_join(&compiler->threads[it]);
+    }
+    se_platform_semaphore_destroy(compiler->jobsSemaphore);
+    se_thread_safe_queue_destroy(compiler->jobs);
+
+    const double counterFrequency = double(_se_get_perf_frequency());
+    se_message
+    (
+        "Pipeline compiler : max frame stall {} ms, {} passes skipped, {} passes used fallback pipeline",
+        double(compiler->maxFrameStallTicks) / counterFrequency * 1000.0, compiler->numSkippedPasses, compiler->numFallbackPasses
+    );
+}
+
+void se_vk_pipeline_compiler_end_frame(SeVkPipelineCompiler* compiler)
+{
+    compiler->lastFrameStallTicks = compiler->frameStallTicks;
+    compiler->maxFrameStallTicks = se_max(compiler->maxFrameStallTicks, compiler->frameStallTicks);
+    compiler->frameStallTicks = 0;
+}
+
+void se_vk_pipeline_compiler_submit(SeVkPipelineCompiler* compiler, const SeVkPipelineCompileJob& job)
+{
+    se_platform_atomic_64_bit_increment(&compiler->numPendingJobs);
+    if (se_thread_safe_queue_enqueue(compiler->jobs, job))
+    {
+        se_platform_semaphore_signal(compiler->jobsSemaphore, 1);
+        return;
+    }
+    //
+    // Queue is full - compile on the main thread
+    //
+    const uint64_t compileBegin = _se_get_perf_counter();
+    if (job.pipeline->bindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS)
+        se_vk_pipeline_graphics_compile(job.pipeline, &job.graphics);
+    else
+        se_vk_pipeline_compute_compile(job.pipeline, &job.compute);
+    se_vk_pipeline_compiler_add_stall(compiler, compileBegin, _se_get_perf_counter());
+    se_platform_atomic_64_bit_decrement(&compiler->numPendingJobs);
+}
+
+void se_vk_pipeline_compiler_submit_graphics(SeVkPipelineCompiler* compiler, SeVkPipeline* pipeline, const SeVkGraphicsPipelineInfo* info)
+{
+    SeVkPipelineCompileJob job = { .pipeline = pipeline };
+    job.graphics = *info;
+    se_vk_pipeline_compiler_submit(compiler, job);
+}
+
+void se_vk_pipeline_compiler_submit_compute(SeVkPipelineCompiler* compiler, SeVkPipeline* pipeline, const SeVkComputePipelineInfo* info)
+{
+    SeVkPipelineCompileJob job = { .pipeline = pipeline };
+    job.compute = *info;
+    se_vk_pipeline_compiler_submit(compiler, job);
+}
+
+inline bool se_vk_pipeline_compiler_is_busy(SeVkPipelineCompiler* compiler)
+{
+    return se_platform_atomic_64_bit_load(&compiler->numPendingJobs, SE_ACQUIRE) != 0;
+}
+
+void se_vk_pipeline_compiler_wait(SeVkPipelineCompiler* compiler, const SeVkPipeline* pipeline)
+{
+    if (se_vk_pipeline_is_compiled(pipeline)) return;
+    const uint64_t waitBegin = _se_get_perf_counter();
+    while (!se_vk_pipeline_is_compiled(pipeline)) se_platform_thread_yield();
+    se_vk_pipeline_compiler_add_stall(compiler, waitBegin, _se_get_perf_counter());
+}
+
+inline void se_vk_pipeline_compiler_add_stall(SeVkPipelineCompiler* compiler, uint64_t beginTicks, uint64_t endTicks)
+{
+    compiler->frameStallTicks += endTicks - beginTicks;
+}
@@ -0,0 +1,62 @@
+#ifndef _SE_VULKAN_PIPELINE_COMPILER_H_
+#define _SE_VULKAN_PIPELINE_COMPILER_H_
+
+#include "se_vulkan_base.hpp"
+#include "se_vulkan_pipeline.hpp"
+
+//
+// Pipeline compiler creates VkPipelines on background threads.
+//
+// Main thread constructs pipeline (layouts) and submits compile job. Pipeline can be used by the graph only after
+// se_vk_pipeline_is_compiled returns true. What graph does with a pass while its pipeline is being compiled
+// is controlled by SePipelineCompilationPolicy.
+//
+// Compiler also tracks how long the main thread was blocked by pipeline compilation (synchronous compiles and waits)
+// during each frame, so the worst-case frame hitch is measurable.
+//
+
+struct SeVkPipelineCompileJob
+{
+    SeVkPipeline* pipeline;
+    union
+    {
+        SeVkGraphicsPipelineInfo    graphics;
+        SeVkComputePipelineInfo     compute;
+    };
+};
+
+struct SeVkPipelineCompiler
+{
+    SeVkDevice*                                 device;
+    SePlatformThread                            threads[SeVkConfig::PIPELINE_COMPILER_MAX_THREADS];
+    size_t                                      numThreads;
+    SeThreadSafeQueue<SeVkPipelineCompileJob>   jobs;
+    SePlatformSemaphore                         jobsSemaphore;
+    uint64_t                                    numPendingJobs; // Atomic
+    uint32_t                                    shouldStop;     // Atomic
+    uint64_t                                    frameStallTicks;
+    uint64_t                                    lastFrameStallTicks;
+    uint64_t                                    maxFrameStallTicks;
+    size_t                                      numSkippedPasses;
+    size_t                                      numFallbackPasses;
+};
+
+struct SeVkPipelineCompilerInfo
+{
+    SeVkDevice* device;
+};
+
+void    se_vk_pipeline_compiler_construct(SeVkPipelineCompiler* compiler, const SeVkPipelineCompilerInfo* info);
+void    se_vk_pipeline_compiler_destroy(SeVkPipelineCompiler* compiler);
+void    se_vk_pipeline_compiler_end_frame(SeVkPipelineCompiler* compiler);
+
+// Pipeline must be constructed (se_vk_pipeline_*_construct) before submission
+void    se_vk_pipeline_compiler_submit_graphics(SeVkPipelineCompiler* compiler, SeVkPipeline* pipeline, const SeVkGraphicsPipelineInfo* info);
+void    se_vk_pipeline_compiler_submit_compute(SeVkPipelineCompiler* compiler, SeVkPipeline* pipeline, const SeVkComputePipelineInfo* info);
+bool    se_vk_pipeline_compiler_is_busy(SeVkPipelineCompiler* compiler);
+
+// Blocks main thread until pipeline is compiled. Blocked time is added to the frame stall
+void    se_vk_pipeline_compiler_wait(SeVkPipelineCompiler* compiler, const SeVkPipeline* pipeline);
+void    se_vk_pipeline_compiler_add_stall(SeVkPipelineCompiler* compiler, uint64_t beginTicks, uint64_t endTicks);
+
+#endif
@@ -78,7 +78,7 @@ void se_vk_program_destroy(SeVkProgram* program)
     se_vk_utils_destroy_shader_module(logicalHandle, program->handle, callbacks);
 }
 
-VkPipelineShaderStageCreateInfo se_vk_program_get_shader_stage_create_info(SeVkDevice* device, SeVkProgramWithConstants* pipelineProgram, const SeAllocatorBindings& allocator)
+VkPipelineShaderStageCreateInfo se_vk_program_get_shader_stage_create_info(SeVkDevice* device, const SeVkProgramWithConstants* pipelineProgram, SeVkProgramSpecialization* specialization)
 {
     const SeVkProgram* program = pipelineProgram->program;
     const SimpleSpirvReflection* reflection = &program->reflection;
@@ -88,27 +88,10 @@ VkPipelineShaderStageCreateInfo se_vk_program_get_shader_stage_create_info(SeVkD
         reflection->shaderType == SSR_SHADER_TYPE_COMPUTE   ? (VkShaderStageFlagBits)VK_SHADER_STAGE_COMPUTE_BIT :
         (VkShaderStageFlagBits)0;
     
-    VkSpecializationMapEntry* specializationEntries = (VkSpecializationMapEntry*)allocator.alloc
-    (
-        allocator.allocator,
-        sizeof(VkSpecializationMapEntry) * pipelineProgram->numSpecializationConstants,
-        se_default_alignment,
-        se_alloc_tag
-    );
-    char* data = (char*)allocator.alloc
-    (
-        allocator.allocator,
-        4 * pipelineProgram->numSpecializationConstants,
-        se_default_alignment,
-        se_alloc_tag
-    );
-    VkSpecializationInfo* specializationInfo = (VkSpecializationInfo*)allocator.alloc
-    (
-        allocator.allocator,
-        sizeof(VkSpecializationInfo),
-        se_default_alignment,
-        se_alloc_tag
-    );
+    se_assert(pipelineProgram->numSpecializationConstants <= SE_MAX_SPECIALIZATION_CONSTANTS);
+    VkSpecializationMapEntry* const specializationEntries = specialization->entries;
+    char* const data = (char*)specialization->data;
+    VkSpecializationInfo* const specializationInfo = &specialization->info;
     *specializationInfo =
     {
         .mapEntryCount  = (uint32_t)pipelineProgram->numSpecializationConstants, // @TODO : safe cast
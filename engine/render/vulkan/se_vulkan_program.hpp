@@ -24,10 +24,19 @@ struct SeVkProgramWithConstants
     size_t                      numSpecializationConstants;
 };
 
+// Storage for the specialization info referenced by VkPipelineShaderStageCreateInfo.
+// It is kept by the caller, so shader stages can be filled on any thread
+struct SeVkProgramSpecialization
+{
+    VkSpecializationMapEntry    entries[SE_MAX_SPECIALIZATION_CONSTANTS];
+    uint32_t                    data[SE_MAX_SPECIALIZATION_CONSTANTS];
+    VkSpecializationInfo        info;
+};
+
 void se_vk_program_construct(SeVkProgram* program, SeVkProgramInfo* info);
 void se_vk_program_destroy(SeVkProgram* program);
 
-VkPipelineShaderStageCreateInfo se_vk_program_get_shader_stage_create_info(SeVkDevice* device, SeVkProgramWithConstants* pipelineProgram, const SeAllocatorBindings& allocator);
+VkPipelineShaderStageCreateInfo se_vk_program_get_shader_stage_create_info(SeVkDevice* device, const SeVkProgramWithConstants* pipelineProgram, SeVkProgramSpecialization* specialization);
 
 template<>
 void se_vk_destroy<SeVkProgram>(SeVkProgram* res)
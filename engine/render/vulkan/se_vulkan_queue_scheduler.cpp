@@ -0,0 +1,162 @@
+
+#include "se_vulkan_queue_scheduler.hpp"
+
+void se_vk_queue_scheduler_construct(SeVkQueueScheduler* scheduler, SeAllocatorBindings allocator, bool isAsyncComputeEnabled)
+{
+    *scheduler =
+    {
+        .groups                 = se_dynamic_array_create<SeVkQueueSchedulerGroup>(allocator),
+        .submissions            = se_dynamic_array_create<SeVkQueueSchedulerSubmission>(allocator),
+        .resources              = se_hash_table_create<const void*, SeVkQueueSchedulerResource>(allocator),
+        .isAsyncComputeEnabled  = isAsyncComputeEnabled,
+    };
+}
+
+void se_vk_queue_scheduler_destroy(SeVkQueueScheduler* scheduler)
+{
+    se_dynamic_array_destroy(scheduler->groups);
+    se_dynamic_array_destroy(scheduler->submissions);
+    se_hash_table_destroy(scheduler->resources);
+}
+
+void se_vk_queue_scheduler_reset(SeVkQueueScheduler* scheduler)
+{
+    se_dynamic_array_reset(scheduler->groups);
+    se_dynamic_array_reset(scheduler->submissions);
+    se_hash_table_reset(scheduler->resources);
+}
+
+SeVkScheduledQueue se_vk_queue_scheduler_add_group(SeVkQueueScheduler* scheduler, bool isAsyncCompute)
+{
+    const size_t numGroups = se_dynamic_array_size(scheduler->groups);
+    se_assert_msg(numGroups < SE_VK_QUEUE_SCHEDULER_MAX_GROUPS, "Queue scheduler supports up to 64 groups per frame");
+    // @NOTE : first group acquires pending uploads, so it is always on the main queue
+    const bool isAsync = isAsyncCompute && numGroups && scheduler->isAsyncComputeEnabled;
+    const SeVkScheduledQueue queue = isAsync ? SE_VK_SCHEDULED_QUEUE_ASYNC_COMPUTE : SE_VK_SCHEDULED_QUEUE_MAIN;
+    se_dynamic_array_push(scheduler->groups,
+    {
+        .queue          = queue,
+        .dependencies   = 0,
+        .submission     = 0,
+    });
+    return queue;
+}
+
+void se_vk_queue_scheduler_add_access(SeVkQueueScheduler* scheduler, const void* resource, bool isWrite)
+{
+    SeVkQueueSchedulerGroup* const group = se_dynamic_array_last(scheduler->groups);
+    se_assert(group && resource);
+    const uint64_t groupBit = uint64_t(1) << (se_dynamic_array_size(scheduler->groups) - 1);
+    SeVkQueueSchedulerResource* state = se_hash_table_get(scheduler->resources, resource);
+    if (!state) state = se_hash_table_set(scheduler->resources, resource, { 0, 0 });
+    if (isWrite)
+    {
+        group->dependencies |= state->lastWrite | state->reads;
+        *state = { groupBit, 0 };
+    }
+    else
+    {
+        group->dependencies |= state->lastWrite;
+        state->reads |= groupBit;
+    }
+    // @NOTE : group can access the same resource more than once
+    group->dependencies &= ~groupBit;
+}
+
+void se_vk_queue_scheduler_add_dependencies(SeVkQueueScheduler* scheduler, uint64_t groups)
+{
+    SeVkQueueSchedulerGroup* const group = se_dynamic_array_last(scheduler->groups);
+    se_assert(group);
+    const uint64_t groupBit = uint64_t(1) << (se_dynamic_array_size(scheduler->groups) - 1);
+    se_assert_msg((groups & ~(groupBit - 1)) == 0, "Group can depend only on the previous groups");
+    group->dependencies |= groups;
+}
+
+void se_vk_queue_scheduler_schedule(SeVkQueueScheduler* scheduler)
+{
+    se_dynamic_array_reset(scheduler->submissions);
+    const size_t numGroups = se_dynamic_array_size(scheduler->groups);
+    //
+    // Latest submission of each queue that the other queue has already waited for. Waiting for an older submission
+    // of the same queue is redundant, because queue executes its submissions in order
+    //
+    size_t waited[2] = { SE_VK_QUEUE_SCHEDULER_NO_WAIT, SE_VK_QUEUE_SCHEDULER_NO_WAIT };
+    const auto addWait = [&](SeVkQueueSchedulerSubmission& submission, size_t otherSubmission)
+    {
+        const SeVkScheduledQueue other = scheduler->submissions[otherSubmission].queue;
+        se_assert(other != submission.queue);
+        if (waited[other] != SE_VK_QUEUE_SCHEDULER_NO_WAIT && waited[other] >= otherSubmission) return;
+        submission.wait = (submission.wait == SE_VK_QUEUE_SCHEDULER_NO_WAIT) ? otherSubmission : se_max(submission.wait, otherSubmission);
+    };
+    for (size_t it = 0; it < numGroups; it++)
+    {
+        SeVkQueueSchedulerGroup& group = scheduler->groups[it];
+        SeVkQueueSchedulerSubmission* submission = se_dynamic_array_last(scheduler->submissions);
+        if (!submission || submission->queue != group.queue)
+        {
+            if (submission && submission->wait != SE_VK_QUEUE_SCHEDULER_NO_WAIT)
+            {
+                const SeVkScheduledQueue other = scheduler->submissions[submission->wait].queue;
+                waited[other] = submission->wait;
+            }
+            submission = &se_dynamic_array_push(scheduler->submissions,
+            {
+                .queue          = group.queue,
+                .firstGroup     = it,
+                .numGroups      = 0,
+                .wait           = SE_VK_QUEUE_SCHEDULER_NO_WAIT,
+                .signalValue    = 0,
+                .waitValue      = 0,
+            });
+            // @NOTE : first async submission waits for the first group (see frame rules in the header)
+            if (group.queue == SE_VK_SCHEDULED_QUEUE_ASYNC_COMPUTE && waited[SE_VK_SCHEDULED_QUEUE_MAIN] == SE_VK_QUEUE_SCHEDULER_NO_WAIT)
+            {
+                addWait(*submission, 0);
+            }
+        }
+        const size_t submissionIndex = se_dynamic_array_size(scheduler->submissions) - 1;
+        for (size_t depIt = 0; depIt < it; depIt++)
+        {
+            if (!(group.dependencies & (uint64_t(1) << depIt))) continue;
+            const SeVkQueueSchedulerGroup& dependency = scheduler->groups[depIt];
+            if (dependency.queue != group.queue) addWait(*submission, dependency.submission);
+        }
+        group.submission = submissionIndex;
+        submission->numGroups += 1;
+    }
+    //
+    // Frame ends on the main queue, after all async work
+    //
+    SeVkQueueSchedulerSubmission* last = se_dynamic_array_last(scheduler->submissions);
+    if (!last || last->queue == SE_VK_SCHEDULED_QUEUE_ASYNC_COMPUTE)
+    {
+        last = &se_dynamic_array_push(scheduler->submissions,
+        {
+            .queue          = SE_VK_SCHEDULED_QUEUE_MAIN,
+            .firstGroup     = numGroups,
+            .numGroups      = 0,
+            .wait           = SE_VK_QUEUE_SCHEDULER_NO_WAIT,
+            .signalValue    = 0,
+            .waitValue      = 0,
+        });
+    }
+    const size_t numSubmissions = se_dynamic_array_size(scheduler->submissions);
+    for (size_t it = numSubmissions; it > 0; it--)
+    {
+        if (scheduler->submissions[it - 1].queue != SE_VK_SCHEDULED_QUEUE_ASYNC_COMPUTE) continue;
+        addWait(*last, it - 1);
+        break;
+    }
+}
+
+void se_vk_queue_scheduler_assign_timeline_values(SeVkQueueScheduler* scheduler, uint64_t* timelineValues)
+{
+    for (auto it : scheduler->submissions)
+    {
+        SeVkQueueSchedulerSubmission& submission = se_iterator_value(it);
+        // @NOTE : wait submission is always earlier, so its value is already assigned
+        submission.waitValue = submission.wait == SE_VK_QUEUE_SCHEDULER_NO_WAIT ? 0 : scheduler->submissions[submission.wait].signalValue;
+        timelineValues[submission.queue] += 1;
+        submission.signalValue = timelineValues[submission.queue];
+    }
+}
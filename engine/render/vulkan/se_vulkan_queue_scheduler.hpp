@@ -0,0 +1,84 @@
+#ifndef _SE_VULKAN_QUEUE_SCHEDULER_H_
+#define _SE_VULKAN_QUEUE_SCHEDULER_H_
+
+#include "se_vulkan_base.hpp"
+
+//
+// Queue scheduler assigns pass groups of a frame to command queues and finds semaphore waits between them.
+//
+// Groups are added in submission order. Every group reports resources it accesses (any unique pointer - render graph uses
+// barrier states) and dependencies are derived from them : read depends on the last write, write depends on the last write
+// and on all reads after it. Explicit dependencies can be added too.
+//
+// Groups that request async compute go to the async compute queue (if scheduler is constructed with async compute enabled),
+// all other groups stay on the main queue. Without async compute the whole frame is a single main queue submission. Consecutive
+// groups of the same queue form a single submission. Queue executes its submissions in order, so a submission waits only for
+// the latest submission of the other queue that has any of its dependencies. Groups of different queues without dependencies
+// between them can overlap. Frame rules :
+// - first group is always on the main queue (it acquires pending uploads and waits for the previous frame), so the first async
+//   submission waits for it
+// - last submission is always on the main queue and waits for the last async submission, so frame is finished when its last
+//   main queue submission is finished. Empty main submission is added if there are no groups or the last group is on
+//   the async queue
+//
+// Each queue has its own timeline semaphore. Every submission signals the next value of its queue timeline and waits for the
+// value signaled by its wait submission (see se_vk_queue_scheduler_assign_timeline_values).
+//
+// Scheduler doesn't use any vulkan objects, so it can be used (and checked) without a device.
+//
+
+constexpr size_t SE_VK_QUEUE_SCHEDULER_NO_WAIT = SIZE_MAX;
+constexpr size_t SE_VK_QUEUE_SCHEDULER_MAX_GROUPS = 64; // Dependencies are bitmasks
+
+enum SeVkScheduledQueue : uint32_t
+{
+    SE_VK_SCHEDULED_QUEUE_MAIN,
+    SE_VK_SCHEDULED_QUEUE_ASYNC_COMPUTE,
+    SE_VK_SCHEDULED_QUEUE_COUNT,
+};
+
+struct SeVkQueueSchedulerGroup
+{
+    SeVkScheduledQueue  queue;
+    uint64_t            dependencies;   // Bit per previous group
+    size_t              submission;     // Valid after se_vk_queue_scheduler_schedule
+};
+
+struct SeVkQueueSchedulerSubmission
+{
+    SeVkScheduledQueue  queue;
+    size_t              firstGroup;
+    size_t              numGroups;
+    size_t              wait;           // Submission of the other queue that must finish first or SE_VK_QUEUE_SCHEDULER_NO_WAIT
+    uint64_t            signalValue;    // Valid after se_vk_queue_scheduler_assign_timeline_values
+    uint64_t            waitValue;      // Value of the other queue timeline, valid if submission waits
+};
+
+struct SeVkQueueSchedulerResource
+{
+    uint64_t lastWrite;     // Bit of the group that wrote resource last
+    uint64_t reads;         // Groups that read resource after the last write
+};
+
+struct SeVkQueueScheduler
+{
+    SeDynamicArray<SeVkQueueSchedulerGroup>                     groups;
+    SeDynamicArray<SeVkQueueSchedulerSubmission>                submissions;    // Valid after se_vk_queue_scheduler_schedule
+    SeHashTable<const void*, SeVkQueueSchedulerResource>        resources;
+    bool                                                        isAsyncComputeEnabled;
+};
+
+void                se_vk_queue_scheduler_construct(SeVkQueueScheduler* scheduler, SeAllocatorBindings allocator, bool isAsyncComputeEnabled);
+void                se_vk_queue_scheduler_destroy(SeVkQueueScheduler* scheduler);
+
+void                se_vk_queue_scheduler_reset(SeVkQueueScheduler* scheduler);
+// Returns queue of the new group. Accesses and dependencies are added to the last added group
+SeVkScheduledQueue  se_vk_queue_scheduler_add_group(SeVkQueueScheduler* scheduler, bool isAsyncCompute);
+void                se_vk_queue_scheduler_add_access(SeVkQueueScheduler* scheduler, const void* resource, bool isWrite);
+void                se_vk_queue_scheduler_add_dependencies(SeVkQueueScheduler* scheduler, uint64_t groups);
+void                se_vk_queue_scheduler_schedule(SeVkQueueScheduler* scheduler);
+// Timeline values hold the last value signaled on each queue timeline (SE_VK_SCHEDULED_QUEUE_COUNT values) and are advanced
+// by the submissions of the frame. Must be called after se_vk_queue_scheduler_schedule
+void                se_vk_queue_scheduler_assign_timeline_values(SeVkQueueScheduler* scheduler, uint64_t* timelineValues);
+
+#endif
@@ -455,7 +455,12 @@ void se_vk_render_pass_validate_fragment_program_setup(SeVkRenderPass* pass, SeV
             shaderSubpassInputAttachmentMask |= 1 << uniform->inputAttachmentIndex;
         }
     }
-    se_assert_msg(shaderSubpassInputAttachmentMask == subpass->inputRefs, "Mismatch between fragment shader subpass inputs and render pass input attachments");
+    //
+    // @NOTE : references are packed in the attachment order, so i-th subpass input (and i-th shader output) is the i-th
+    //         referenced attachment. Shader must use all of them without gaps
+    //
+    const SeVkGeneralBitmask subpassInputAttachmentMask = SeVkGeneralBitmask((1ull << se_vk_render_pass_count_flags(subpass->inputRefs)) - 1);
+    se_assert_msg(shaderSubpassInputAttachmentMask == subpassInputAttachmentMask, "Mismatch between fragment shader subpass inputs and render pass input attachments");
 
     SeVkGeneralBitmask shaderColorAttachmentMask = 0;
     for (size_t it = 0; it < reflection->numOutputs; it++)
@@ -467,7 +472,8 @@ void se_vk_render_pass_validate_fragment_program_setup(SeVkRenderPass* pass, SeV
             shaderColorAttachmentMask |= 1 << output->location;
         }
     }
-    se_assert_msg(shaderColorAttachmentMask == subpass->colorRefs, "Mismatch between fragment shader outputs and render pass color attachments");
+    const SeVkGeneralBitmask subpassColorAttachmentMask = SeVkGeneralBitmask((1ull << se_vk_render_pass_count_flags(subpass->colorRefs)) - 1);
+    se_assert_msg(shaderColorAttachmentMask == subpassColorAttachmentMask, "Mismatch between fragment shader outputs and render pass color attachments");
 }
 
 uint32_t se_vk_render_pass_get_num_color_attachments(SeVkRenderPass* pass, size_t subpassIndex)
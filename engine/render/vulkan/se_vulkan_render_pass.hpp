@@ -23,8 +23,8 @@ struct SeVkResolveRef
 
 struct SeVkRenderPassSubpass
 {
-    SeVkGeneralBitmask  colorRefs;                                  // each value references colorAttachments array
-    SeVkGeneralBitmask  inputRefs;                                  // each value references colorAttachments array
+    SeVkGeneralBitmask  colorRefs;                                  // each value references colorAttachments array, i-th set bit is the shader output at location i
+    SeVkGeneralBitmask  inputRefs;                                  // each value references colorAttachments array, i-th set bit is the input_attachment_index i
     SeVkResolveRef      resolveRefs[SE_VK_GENERAL_BITMASK_WIDTH];   // each value references colorAttachments array
     uint32_t            numResolveRefs;
     bool                depthRead;
@@ -26,9 +26,10 @@ void se_vk_sampler_construct(SeVkSampler* sampler, SeVkSamplerInfo* info)
     const VkDevice logicalHandle = se_vk_device_get_logical_handle(device);
     *sampler =
     {
-        .object = { SeVkObject::Type::SAMPLER, 0, g_samplerIndex++ },
-        .device = device,
-        .handle = VK_NULL_HANDLE,
+        .object         = { SeVkObject::Type::SAMPLER, 0, g_samplerIndex++ },
+        .device         = device,
+        .handle         = VK_NULL_HANDLE,
+        .bindlessIndex  = SE_BINDLESS_INVALID_INDEX,
     };
     const VkPhysicalDeviceFeatures* features = se_vk_device_get_physical_device_features(device);
     const VkPhysicalDeviceProperties* properties = se_vk_device_get_physical_device_properties(device);
@@ -54,10 +55,12 @@ void se_vk_sampler_construct(SeVkSampler* sampler, SeVkSamplerInfo* info)
         .unnormalizedCoordinates    = VK_FALSE,
     };
     se_vk_check(vkCreateSampler(logicalHandle, &samplerCreateInfo, callbacks, &sampler->handle));
+    sampler->bindlessIndex = se_vk_bindless_heap_add_sampler(&device->bindlessHeap, sampler);
 }
 
 void se_vk_sampler_destroy(SeVkSampler* sampler)
 {
     const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&sampler->device->memoryManager);
+    se_vk_bindless_heap_remove(&sampler->device->bindlessHeap, SE_VK_BINDLESS_SAMPLER, sampler->bindlessIndex);
     vkDestroySampler(se_vk_device_get_logical_handle(sampler->device), sampler->handle, callbacks);
 }
@@ -11,6 +11,7 @@ struct SeVkSampler
     SeVkObject  object;
     SeVkDevice* device;
     VkSampler   handle;
+    uint32_t    bindlessIndex;
 };
 
 struct SeVkSamplerInfo
@@ -2,8 +2,10 @@
 #include "se_vulkan_base.hpp"
 #include "se_vulkan_texture.hpp"
 #include "se_vulkan_device.hpp"
-#include "se_vulkan_command_buffer.hpp"
+#include "se_vulkan_transfer_manager.hpp"
 #include "se_vulkan_utils.hpp"
+#include "engine/se_cooked_texture.hpp"
+#include "engine/subsystems/se_file_system.hpp"
 
 constexpr size_t MAX_STBI_ALLOCATIONS = 64;
 struct
@@ -66,22 +68,163 @@ void se_vk_texture_stbi_free(void* ptr)
 
 size_t g_textureIndex = 0;
 
+bool se_vk_texture_is_blit_supported(SeVkDevice* device, VkFormat format)
+{
+    constexpr VkFormatFeatureFlags REQUIRED_FEATURES = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+    VkFormatProperties properties = { };
+    vkGetPhysicalDeviceFormatProperties(device->gpu.physicalHandle, format, &properties);
+    return (properties.optimalTilingFeatures & REQUIRED_FEATURES) == REQUIRED_FEATURES;
+}
+
+bool se_vk_texture_is_linear_blit_supported(SeVkDevice* device, VkFormat format)
+{
+    VkFormatProperties properties = { };
+    vkGetPhysicalDeviceFormatProperties(device->gpu.physicalHandle, format, &properties);
+    return se_vk_texture_is_blit_supported(device, format) && (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT);
+}
+
+uint32_t se_vk_texture_get_num_mips(VkExtent3D extent)
+{
+    uint32_t maxDimension = se_max(se_max(extent.width, extent.height), extent.depth);
+    uint32_t numMips = 1;
+    while (maxDimension > 1)
+    {
+        maxDimension /= 2;
+        numMips += 1;
+    }
+    return numMips;
+}
+
+void se_vk_texture_create_image(SeVkTexture* texture)
+{
+    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&texture->device->memoryManager);
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(texture->device);
+    uint32_t queueFamilyIndices[SeVkConfig::MAX_UNIQUE_COMMAND_QUEUES];
+    VkImageCreateInfo imageCreateInfo =
+    {
+        .sType                  = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .pNext                  = nullptr,
+        .flags                  = 0,
+        .imageType              = texture->extent.depth > 1 ? VK_IMAGE_TYPE_3D : (texture->extent.height > 1 ? VK_IMAGE_TYPE_2D : VK_IMAGE_TYPE_1D),
+        .format                 = texture->format,
+        .extent                 = texture->extent,
+        .mipLevels              = texture->numMips,
+        .arrayLayers            = 1,
+        .samples                = texture->sampling,
+        .tiling                 = VK_IMAGE_TILING_OPTIMAL,
+        .usage                  = texture->usage,
+        .sharingMode            = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount  = 0,
+        .pQueueFamilyIndices    = queueFamilyIndices,
+        .initialLayout          = VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+    //
+    // @NOTE :  transfer queue accesses textures only during the upload and temporary takes ownership of the image
+    //          (see se_vulkan_transfer_manager.cpp), so if graphics and compute queues are from the same family,
+    //          we can use exclusive sharing mode
+    //
+    se_vk_device_fill_sharing_mode
+    (
+        texture->device,
+        SE_VK_CMD_QUEUE_GRAPHICS | SE_VK_CMD_QUEUE_COMPUTE,
+        &imageCreateInfo.queueFamilyIndexCount,
+        queueFamilyIndices,
+        &imageCreateInfo.sharingMode
+    );
+    if (imageCreateInfo.sharingMode == VK_SHARING_MODE_CONCURRENT)
+    {
+        se_vk_device_fill_sharing_mode
+        (
+            texture->device,
+            SE_VK_CMD_QUEUE_GRAPHICS | SE_VK_CMD_QUEUE_TRANSFER | SE_VK_CMD_QUEUE_COMPUTE,
+            &imageCreateInfo.queueFamilyIndexCount,
+            queueFamilyIndices,
+            &imageCreateInfo.sharingMode
+        );
+    }
+    else
+    {
+        texture->flags |= SE_VK_TEXTURE_EXCLUSIVE_SHARING;
+    }
+    se_vk_check(vkCreateImage(logicalHandle, &imageCreateInfo, callbacks, &texture->image));
+}
+
+void se_vk_texture_create_view(SeVkTexture* texture)
+{
+    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&texture->device->memoryManager);
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(texture->device);
+    VkImageViewCreateInfo viewCreateInfo =
+    {
+        .sType              = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        .pNext              = nullptr,
+        .flags              = 0,
+        .image              = texture->image,
+        .viewType           = texture->extent.depth > 1 ? VK_IMAGE_VIEW_TYPE_3D : (texture->extent.height > 1 ? VK_IMAGE_VIEW_TYPE_2D : VK_IMAGE_VIEW_TYPE_1D),
+        .format             = texture->format,
+        .components         =
+        {
+            .r = VK_COMPONENT_SWIZZLE_IDENTITY,
+            .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+            .b = VK_COMPONENT_SWIZZLE_IDENTITY,
+            .a = VK_COMPONENT_SWIZZLE_IDENTITY
+        },
+        .subresourceRange   = texture->fullSubresourceRange,
+    };
+    se_vk_check(vkCreateImageView(logicalHandle, &viewCreateInfo, callbacks, &texture->view));
+    //
+    // Framebuffer attachments and dynamic rendering attachments must be single mip views
+    //
+    constexpr VkImageUsageFlags ATTACHMENT_USAGE =
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+        VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+    if (texture->numMips > 1 && (texture->usage & ATTACHMENT_USAGE))
+    {
+        viewCreateInfo.subresourceRange.baseMipLevel = 0;
+        viewCreateInfo.subresourceRange.levelCount = 1;
+        se_vk_check(vkCreateImageView(logicalHandle, &viewCreateInfo, callbacks, &texture->attachmentView));
+    }
+    else
+    {
+        texture->attachmentView = texture->view;
+    }
+}
+
 void se_vk_texture_construct(SeVkTexture* texture, SeVkTextureInfo* info)
 {
     SeVkMemoryManager* const memoryManager = &info->device->memoryManager;
     const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(memoryManager);
     const VkDevice logicalHandle = se_vk_device_get_logical_handle(info->device);
     //
-    // Read data and process if it is an image file
+    // Read data and process if it is an image file. Files are mapped to memory, so cooked textures
+    // are copied to staging memory directly from the mapping
     //
     VkExtent3D textureExtent = info->extent;
     void* loadedTextureData = nullptr;
     size_t loadedTextureDataSize = 0;
+    SeFileMapping fileMapping = { };
+    const SeCookedTextureHeader* cookedHeader = nullptr;
     if (se_data_provider_is_valid(info->data))
     {
-        auto [sourcePtr, sourceSize] = se_data_provider_get(info->data);
         if (info->data.type == SeDataProvider::FROM_FILE)
         {
+            fileMapping = se_fs_file_map(info->data.file.handle);
+            se_assert(fileMapping.data);
+        }
+        const DataProviderResult source = info->data.type == SeDataProvider::FROM_FILE
+            ? DataProviderResult{ fileMapping.data, fileMapping.dataSize }
+            : se_data_provider_get(info->data);
+        if (info->data.type == SeDataProvider::FROM_FILE && se_cooked_texture_is_valid(source.memory, source.size))
+        {
+            cookedHeader = se_cooked_texture_get_header(source.memory);
+            se_assert_msg(se_vk_utils_to_vk_texture_format(cookedHeader->format) == info->format, "Cooked texture format doesn't match requested format");
+            se_assert_msg(cookedHeader->numLayers == 1, "Cooked texture arrays are not supported");
+            se_assert_msg(!info->generateMips, "Cooked textures contain prebuilt mips");
+            textureExtent = { cookedHeader->width, cookedHeader->height, cookedHeader->depth };
+        }
+        else if (info->data.type == SeDataProvider::FROM_FILE)
+        {
+            se_assert_msg(!se_vk_utils_is_block_compressed_format(info->format), "Block compressed textures can't be loaded from image files");
             const SeVkFormatInfo formatInfo = se_vk_utils_get_format_info(info->format);
             int dimX = 0;
             int dimY = 0;
@@ -89,15 +232,15 @@ void se_vk_texture_construct(SeVkTexture* texture, SeVkTextureInfo* info)
             void* loadedImagePtr = nullptr;
             if (formatInfo.componentsSizeBits == 8 && formatInfo.componentType == SeVkFormatInfo::Type::UINT)
             {
-                loadedImagePtr = stbi_load_from_memory((const stbi_uc*)sourcePtr, (int)sourceSize, &dimX, &dimY, &channels, int(formatInfo.numComponents));
+                loadedImagePtr = stbi_load_from_memory((const stbi_uc*)source.memory, (int)source.size, &dimX, &dimY, &channels, int(formatInfo.numComponents));
             }
             else if (formatInfo.componentsSizeBits == 16 && formatInfo.componentType == SeVkFormatInfo::Type::UINT)
             {
-                loadedImagePtr = stbi_load_16_from_memory((const stbi_uc*)sourcePtr, (int)sourceSize, &dimX, &dimY, &channels, int(formatInfo.numComponents));
+                loadedImagePtr = stbi_load_16_from_memory((const stbi_uc*)source.memory, (int)source.size, &dimX, &dimY, &channels, int(formatInfo.numComponents));
             }
             else if (formatInfo.componentsSizeBits == 32 && formatInfo.componentType == SeVkFormatInfo::Type::FLOAT)
             {
-                loadedImagePtr = stbi_loadf_from_memory((const stbi_uc*)sourcePtr, (int)sourceSize, &dimX, &dimY, &channels, int(formatInfo.numComponents));
+                loadedImagePtr = stbi_loadf_from_memory((const stbi_uc*)source.memory, (int)source.size, &dimX, &dimY, &channels, int(formatInfo.numComponents));
             }
             else
             {
@@ -110,10 +253,15 @@ void se_vk_texture_construct(SeVkTexture* texture, SeVkTextureInfo* info)
         }
         else
         {
-            loadedTextureData = sourcePtr;
-            loadedTextureDataSize = sourceSize;
+            loadedTextureData = source.memory;
+            loadedTextureDataSize = source.size;
         }
     }
+    se_assert_msg
+    (
+        !se_vk_utils_is_block_compressed_format(info->format) || se_vk_device_get_physical_device_features(info->device)->textureCompressionBC,
+        "Block compressed textures are not supported by the device"
+    );
     {
         const bool isDepthFormat = se_vk_utils_is_depth_format(info->format);
         const bool isStencilFormat = se_vk_utils_is_stencil_format(info->format);
@@ -121,6 +269,7 @@ void se_vk_texture_construct(SeVkTexture* texture, SeVkTextureInfo* info)
             (isDepthFormat                          ? VK_IMAGE_ASPECT_DEPTH_BIT     : 0) |
             (isStencilFormat                        ? VK_IMAGE_ASPECT_STENCIL_BIT   : 0) |
             (!(isDepthFormat || isStencilFormat)    ? VK_IMAGE_ASPECT_COLOR_BIT     : 0) ;
+        const uint32_t numMips = cookedHeader ? cookedHeader->numMips : (info->generateMips ? se_vk_texture_get_num_mips(textureExtent) : 1);
         *texture =
         {
             .object                 = { SeVkObject::Type::TEXTURE, 0, g_textureIndex++ },
@@ -131,160 +280,85 @@ void se_vk_texture_construct(SeVkTexture* texture, SeVkTextureInfo* info)
             .image                  = VK_NULL_HANDLE,
             .memory                 = { },
             .view                   = VK_NULL_HANDLE,
+            .attachmentView         = VK_NULL_HANDLE,
             .fullSubresourceRange   = { aspect, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS },
-            .flags                  = 0,
-        };
-        //
-        // Create image
-        //
-        uint32_t queueFamilyIndices[SeVkConfig::MAX_UNIQUE_COMMAND_QUEUES];
-        VkImageCreateInfo imageCreateInfo =
-        {
-            .sType                  = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
-            .pNext                  = nullptr,
-            .flags                  = 0,
-            .imageType              = texture->extent.depth > 1 ? VK_IMAGE_TYPE_3D : (texture->extent.height > 1 ? VK_IMAGE_TYPE_2D : VK_IMAGE_TYPE_1D),
-            .format                 = texture->format,
-            .extent                 = texture->extent,
-            .mipLevels              = 1,
-            .arrayLayers            = 1,
-            .samples                = info->sampling,
-            .tiling                 = VK_IMAGE_TILING_OPTIMAL,
-            .usage                  = info->usage,
-            .sharingMode            = VK_SHARING_MODE_EXCLUSIVE,
-            .queueFamilyIndexCount  = 0,
-            .pQueueFamilyIndices    = queueFamilyIndices,
-            .initialLayout          = texture->currentLayout,
+            .numMips                = numMips,
+            .flags                  = info->isTransient ? SE_VK_TEXTURE_TRANSIENT : 0,
+            .barrierState           = { },
+            .bindlessIndex          = SE_BINDLESS_INVALID_INDEX,
+            .usage                  = info->usage | (numMips > 1 ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT : 0),
+            .sampling               = info->sampling,
+            .memoryRequirements     = { },
         };
-        se_vk_device_fill_sharing_mode
-        (
-            info->device,
-            SE_VK_CMD_QUEUE_GRAPHICS | SE_VK_CMD_QUEUE_TRANSFER | SE_VK_CMD_QUEUE_COMPUTE,
-            &imageCreateInfo.queueFamilyIndexCount,
-            queueFamilyIndices,
-            &imageCreateInfo.sharingMode
-        );
-        se_vk_check(vkCreateImage(logicalHandle, &imageCreateInfo, callbacks, &texture->image));
+        se_assert_msg(!info->isTransient || !(loadedTextureData || cookedHeader), "Transient textures can't have data");
+        se_vk_texture_create_image(texture);
     }
     {
         VkMemoryRequirements memRequirements = { };
         vkGetImageMemoryRequirements(logicalHandle, texture->image, &memRequirements);
+        //
+        // Transient attachments are placed in lazily allocated memory if device has it (on tiled gpus such memory is usually
+        // never committed, because attachment stays in tile memory). Other transient textures are placed by the transient heap
+        // every frame, so memory isn't allocated here
+        //
+        uint32_t lazyMemoryTypeIndex = 0;
+        const VkMemoryPropertyFlags lazyProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+        const bool isLazilyAllocated =
+            (texture->usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) &&
+            se_vk_utils_get_memory_type_index(memoryManager->memoryProperties, memRequirements.memoryTypeBits, lazyProperties, &lazyMemoryTypeIndex);
+        if (info->isTransient && !isLazilyAllocated)
+        {
+            texture->flags |= SE_VK_TEXTURE_ALIASED;
+            texture->memoryRequirements = memRequirements;
+            texture->memory = { VK_NULL_HANDLE, 0, memRequirements.size, nullptr };
+            return;
+        }
         SeVkGpuAllocationRequest request =
         {
             .size               = memRequirements.size,
             .alignment          = memRequirements.alignment,
             .memoryTypeBits     = memRequirements.memoryTypeBits,
-            .properties         = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            .properties         = isLazilyAllocated ? lazyProperties : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
         };
         texture->memory = se_vk_memory_manager_allocate(memoryManager, request);
         vkBindImageMemory(logicalHandle, texture->image, texture->memory.memory, texture->memory.offset);
         //
+        // Create view and add texture to bindless heap. Image descriptors are written before the upload, heap
+        // layout is set by the transfer manager when upload is acquired (see se_vk_transfer_manager_finish_texture)
+        //
+        se_vk_texture_create_view(texture);
+        if ((info->usage & VK_IMAGE_USAGE_SAMPLED_BIT) && info->sampling == VK_SAMPLE_COUNT_1_BIT && !info->isTransient)
+        {
+            texture->bindlessIndex = se_vk_bindless_heap_add_texture(&info->device->bindlessHeap, texture);
+        }
+        //
         // Copy data from provider
         //
-        if (loadedTextureData)
+        if (cookedHeader)
         {
+            SeVkTransferManager* const transferManager = &info->device->transferManager;
+            for (uint32_t mip = 0; mip < cookedHeader->numMips; mip++)
+            {
+                const SeCookedTextureMip& cookedMip = cookedHeader->mips[mip];
+                se_vk_transfer_manager_upload_texture(transferManager, texture, mip, ((const char*)fileMapping.data) + cookedMip.offset, cookedMip.size);
+            }
+            se_vk_transfer_manager_finish_texture(transferManager, texture, false);
+        }
+        else if (loadedTextureData)
+        {
+            SeVkTransferManager* const transferManager = &info->device->transferManager;
+            se_vk_transfer_manager_upload_texture(transferManager, texture, 0, loadedTextureData, loadedTextureDataSize);
             //
-            // Copy to staging memory
+            // Mips are generated on gpu with a blit chain (see se_vk_transfer_manager_record_mip_generation)
             //
-            SeVkMemoryBuffer* stagingBuffer = se_vk_memory_manager_get_staging_buffer(memoryManager);
-            const size_t stagingBufferSize = stagingBuffer->memory.size;
-            void* const stagingMemory = stagingBuffer->memory.mappedMemory;
-            se_assert(stagingBufferSize >= loadedTextureDataSize);
-            memcpy(stagingMemory, loadedTextureData, loadedTextureDataSize);
+            se_assert_msg(texture->numMips == 1 || se_vk_texture_is_blit_supported(info->device, texture->format), "Mips can't be generated for this format, device doesn't support blits");
+            se_vk_transfer_manager_finish_texture(transferManager, texture, texture->numMips > 1);
             if (info->data.type == SeDataProvider::FROM_FILE)
             {
                 stbi_image_free(loadedTextureData);
             }
-            //
-            // Transition image layout and copy buffer
-            //
-            SeObjectPool<SeVkCommandBuffer>& cmdPool = se_vk_memory_manager_get_pool<SeVkCommandBuffer>(memoryManager);
-            SeVkCommandBuffer* cmd = se_object_pool_take(cmdPool);
-            SeVkCommandBufferInfo cmdInfo =
-            {
-                .device = info->device,
-                .usage  = SE_VK_COMMAND_BUFFER_USAGE_TRANSFER,
-            };
-            se_vk_command_buffer_construct(cmd, &cmdInfo);
-            //
-            // Transition
-            //
-            const VkImageLayout newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            VkImageMemoryBarrier imageBarrier
-            {
-                .sType                  = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-                .pNext                  = nullptr,
-                .srcAccessMask          = se_vk_utils_image_layout_to_access_flags(texture->currentLayout),
-                .dstAccessMask          = se_vk_utils_image_layout_to_access_flags(newLayout),
-                .oldLayout              = texture->currentLayout,
-                .newLayout              = newLayout,
-                .srcQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
-                .image                  = texture->image,
-                .subresourceRange       = texture->fullSubresourceRange,
-            };
-            vkCmdPipelineBarrier
-            (
-                cmd->handle,
-                se_vk_utils_image_layout_to_pipeline_stage_flags(texture->currentLayout),
-                se_vk_utils_image_layout_to_pipeline_stage_flags(newLayout),
-                0,
-                0,
-                nullptr,
-                0,
-                nullptr,
-                1,
-                &imageBarrier
-            );
-            texture->currentLayout = newLayout;
-            //
-            // Copy
-            //
-            VkBufferImageCopy copy
-            {
-                .bufferOffset       = 0,
-                .bufferRowLength    = 0,
-                .bufferImageHeight  = 0,
-                .imageSubresource   =
-                {
-                    VK_IMAGE_ASPECT_COLOR_BIT,
-                    0,
-                    0,
-                    1,
-                },
-                .imageOffset        = { 0, 0, 0 },
-                .imageExtent        = texture->extent,
-            };
-            vkCmdCopyBufferToImage(cmd->handle, stagingBuffer->handle, texture->image, texture->currentLayout, 1, &copy);
-            //
-            // Submit
-            //
-            SeVkCommandBufferSubmitInfo submit = { };
-            se_vk_command_buffer_submit(cmd, &submit);
-            vkWaitForFences(logicalHandle, 1, &cmd->fence, VK_TRUE, UINT64_MAX);    
-            se_vk_command_buffer_destroy(cmd);
-            se_object_pool_release(cmdPool, cmd);
         }
-    }
-    {
-        VkImageViewCreateInfo viewCreateInfo =
-        {
-            .sType              = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
-            .pNext              = nullptr,
-            .flags              = 0,
-            .image              = texture->image,
-            .viewType           = texture->extent.depth > 1 ? VK_IMAGE_VIEW_TYPE_3D : (texture->extent.height > 1 ? VK_IMAGE_VIEW_TYPE_2D : VK_IMAGE_VIEW_TYPE_1D),
-            .format             = texture->format,
-            .components         =
-            {
-                .r = VK_COMPONENT_SWIZZLE_IDENTITY,
-                .g = VK_COMPONENT_SWIZZLE_IDENTITY,
-                .b = VK_COMPONENT_SWIZZLE_IDENTITY,
-                .a = VK_COMPONENT_SWIZZLE_IDENTITY
-            },
-            .subresourceRange   = texture->fullSubresourceRange,
-        };
-        se_vk_check(vkCreateImageView(logicalHandle, &viewCreateInfo, callbacks, &texture->view));
+        se_fs_file_unmap(fileMapping);
     }
 }
 
@@ -300,11 +374,30 @@ void se_vk_texture_construct_from_swap_chain(SeVkTexture* texture, SeVkDevice* d
         .image                  = image,
         .memory                 = { },
         .view                   = view,
+        .attachmentView         = view,
         .fullSubresourceRange   = { VK_IMAGE_ASPECT_COLOR_BIT, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS },
+        .numMips                = 1,
         .flags                  = SE_VK_TEXTURE_FROM_SWAP_CHAIN,
+        .barrierState           = { },
+        .bindlessIndex          = SE_BINDLESS_INVALID_INDEX,
+        .usage                  = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+        .sampling               = VK_SAMPLE_COUNT_1_BIT,
+        .memoryRequirements     = { },
     };
 }
 
+void se_vk_texture_bind_aliased_memory(SeVkTexture* texture, VkDeviceMemory memory, VkDeviceSize offset)
+{
+    se_assert(texture->flags & SE_VK_TEXTURE_ALIASED);
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(texture->device);
+    se_vk_texture_create_image(texture);
+    vkBindImageMemory(logicalHandle, texture->image, memory, offset);
+    se_vk_texture_create_view(texture);
+    texture->object.uniqueIndex = g_textureIndex++;
+    texture->memory = { memory, offset, texture->memoryRequirements.size, nullptr };
+    texture->currentLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+}
+
 void se_vk_texture_destroy(SeVkTexture* texture)
 {
     SeVkMemoryManager* const memoryManager = &texture->device->memoryManager;
@@ -312,8 +405,11 @@ void se_vk_texture_destroy(SeVkTexture* texture)
     const VkDevice logicalHandle = se_vk_device_get_logical_handle(texture->device);
     if (!(texture->flags & SE_VK_TEXTURE_FROM_SWAP_CHAIN))
     {
+        se_vk_bindless_heap_remove(&texture->device->bindlessHeap, SE_VK_BINDLESS_TEXTURE, texture->bindlessIndex);
+        if (texture->attachmentView != texture->view) vkDestroyImageView(logicalHandle, texture->attachmentView, callbacks);
         vkDestroyImageView(logicalHandle, texture->view, callbacks);
         vkDestroyImage(logicalHandle, texture->image, callbacks);
-        se_vk_memory_manager_deallocate(memoryManager, texture->memory);
+        // @NOTE : memory of aliased textures belongs to the transient heap
+        if (!(texture->flags & SE_VK_TEXTURE_ALIASED)) se_vk_memory_manager_deallocate(memoryManager, texture->memory);
     }
 }
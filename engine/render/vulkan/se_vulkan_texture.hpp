@@ -3,10 +3,14 @@
 
 #include "se_vulkan_base.hpp"
 #include "se_vulkan_memory.hpp"
+#include "se_vulkan_barrier_planner.hpp"
 
 enum SeVkTextureFlags
 {
-    SE_VK_TEXTURE_FROM_SWAP_CHAIN = 0x00000001,
+    SE_VK_TEXTURE_FROM_SWAP_CHAIN   = 0x00000001,
+    SE_VK_TEXTURE_EXCLUSIVE_SHARING = 0x00000002,
+    SE_VK_TEXTURE_TRANSIENT         = 0x00000004, // Contents don't persist between frames (see se_vulkan_transient_heap.hpp)
+    SE_VK_TEXTURE_ALIASED           = 0x00000008, // Memory is owned by the transient heap, image is recreated when texture is moved. Transient textures without this flag are lazily allocated
 };
 
 struct SeVkTextureInfo
@@ -16,6 +20,8 @@ struct SeVkTextureInfo
     VkExtent3D              extent;
     VkImageUsageFlags       usage;
     VkSampleCountFlagBits   sampling;
+    bool                    generateMips;
+    bool                    isTransient;
     SeDataProvider            data;
 };
 
@@ -29,14 +35,25 @@ struct SeVkTexture
     VkImage                 image;
     SeVkMemory              memory;
     VkImageView             view;
+    VkImageView             attachmentView;     // View of the first mip used by framebuffers and dynamic rendering, same as view if texture has a single mip
     VkImageSubresourceRange fullSubresourceRange;
+    uint32_t                numMips;
     uint64_t                flags;
+    SeVkBarrierResourceState barrierState;
+    uint32_t                bindlessIndex; // SE_BINDLESS_INVALID_INDEX if texture isn't in the bindless heap
+    VkImageUsageFlags       usage;
+    VkSampleCountFlagBits   sampling;
+    VkMemoryRequirements    memoryRequirements; // Aliased textures only
 };
 
 void se_vk_texture_construct(SeVkTexture* texture, SeVkTextureInfo* info);
 void se_vk_texture_construct_from_swap_chain(SeVkTexture* texture, SeVkDevice* device, VkExtent2D* extent, VkImage image, VkImageView view, VkFormat format);
 void se_vk_texture_destroy(SeVkTexture* texture);
 
+// Aliased textures only. Creates a new image (and view) bound to the given memory, previous image and view must be
+// retired by the caller. Texture gets a new unique index, so cached framebuffers and descriptor sets aren't reused
+void se_vk_texture_bind_aliased_memory(SeVkTexture* texture, VkDeviceMemory memory, VkDeviceSize offset);
+
 template<>
 void se_vk_destroy<SeVkTexture>(SeVkTexture* res)
 {
@@ -0,0 +1,582 @@
+
+#include "se_vulkan_transfer_manager.hpp"
+#include "se_vulkan_device.hpp"
+#include "se_vulkan_command_buffer.hpp"
+#include "se_vulkan_texture.hpp"
+#include "se_vulkan_utils.hpp"
+
+#define se_vk_transfer_manager_align(value, alignment) ((((value) + (alignment) - 1) / (alignment)) * (alignment))
+
+constexpr size_t TRANSFER_RING_MIN_ALIGNMENT = 16;
+
+void se_vk_transfer_manager_construct(SeVkTransferManager* manager, const SeVkTransferManagerInfo* info)
+{
+    SeVkDevice* const device = info->device;
+    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&device->memoryManager);
+    auto& memoryBufferPool = se_vk_memory_manager_get_pool<SeVkMemoryBuffer>(&device->memoryManager);
+    const size_t optimalAlignment = device->gpu.deviceProperties_10.limits.optimalBufferCopyOffsetAlignment;
+
+    *manager =
+    {
+        .device                     = device,
+        .ringBuffer                 = se_object_pool_take(memoryBufferPool),
+        .ringHead                   = 0,
+        .ringTail                   = 0,
+        .ringAlignment              = se_max(optimalAlignment, TRANSFER_RING_MIN_ALIGNMENT),
+        .activeBatchRingBegin       = 0,
+        .activeCmd                  = nullptr,
+        .activeSlot                 = 0,
+        .timelineSemaphore          = se_vk_utils_create_timeline_semaphore(se_vk_device_get_logical_handle(device), 0, callbacks),
+        .timelineValue              = 0,
+        .batches                    = se_dynamic_array_create<SeVkTransferBatch>(se_allocator_persistent(), 16),
+        .slots                      = se_dynamic_array_create<SeVkTransferSlot>(se_allocator_persistent(), 16),
+        .freeSlots                  = se_dynamic_array_create<size_t>(se_allocator_persistent(), 16),
+        .pendingTextures            = se_dynamic_array_create<SeVkTransferTexture>(se_allocator_persistent(), 16),
+        .transferQueueFamilyIndex   = se_vk_device_get_command_queue_family_index(device, SE_VK_CMD_QUEUE_TRANSFER),
+        .graphicsQueueFamilyIndex   = se_vk_device_get_command_queue_family_index(device, SE_VK_CMD_QUEUE_GRAPHICS),
+    };
+    SeVkMemoryBufferInfo ringBufferInfo
+    {
+        .device     = device,
+        .size       = SeVkConfig::TRANSFER_RING_BUFFER_SIZE,
+        .usage      = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        .visibility = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        .isTransient = false,
+    };
+    se_vk_memory_buffer_construct(manager->ringBuffer, &ringBufferInfo);
+    se_assert(manager->ringBuffer->memory.mappedMemory);
+}
+
+void se_vk_transfer_manager_destroy(SeVkTransferManager* manager)
+{
+    // @NOTE : ring buffer and command buffers are destroyed together with the rest of the objects in memory manager pools
+    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&manager->device->memoryManager);
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(manager->device);
+    vkDestroySemaphore(logicalHandle, manager->timelineSemaphore, callbacks);
+    for (auto it : manager->slots) vkDestroyCommandPool(logicalHandle, se_iterator_value(it).pool, callbacks);
+    se_dynamic_array_destroy(manager->batches);
+    se_dynamic_array_destroy(manager->slots);
+    se_dynamic_array_destroy(manager->freeSlots);
+    se_dynamic_array_destroy(manager->pendingTextures);
+}
+
+void se_vk_transfer_manager_update_ring_tail(SeVkTransferManager* manager)
+{
+    const uint64_t finishedValue = se_vk_utils_get_timeline_value(se_vk_device_get_logical_handle(manager->device), manager->timelineSemaphore);
+    size_t tail = manager->activeBatchRingBegin;
+    for (auto it : manager->batches)
+    {
+        SeVkTransferBatch& batch = se_iterator_value(it);
+        batch.isFinished = batch.isFinished || batch.timelineValue <= finishedValue;
+        if (!batch.isFinished && batch.ringBegin < tail)
+        {
+            tail = batch.ringBegin;
+        }
+    }
+    manager->ringTail = tail;
+}
+
+void se_vk_transfer_manager_wait_oldest_batch(SeVkTransferManager* manager)
+{
+    SeVkTransferBatch* oldest = nullptr;
+    for (auto it : manager->batches)
+    {
+        SeVkTransferBatch& batch = se_iterator_value(it);
+        if (batch.isFinished) continue;
+        if (!oldest || batch.ringBegin < oldest->ringBegin) oldest = &batch;
+    }
+    se_assert_msg(oldest, "Transfer ring buffer is full, but there are no batches to wait for");
+    se_vk_utils_wait_timeline(se_vk_device_get_logical_handle(manager->device), manager->timelineSemaphore, oldest->timelineValue);
+    oldest->isFinished = true;
+}
+
+size_t se_vk_transfer_manager_alloc(SeVkTransferManager* manager, size_t size)
+{
+    constexpr size_t RING_SIZE = SeVkConfig::TRANSFER_RING_BUFFER_SIZE;
+    se_assert_msg(size <= RING_SIZE, "Transfer size exceeds staging ring buffer size");
+    //
+    // Ring head and tail grow monotonically, actual offset in the buffer is (value % RING_SIZE).
+    // Allocations never wrap around the end of the buffer - instead we skip to the beginning of the next loop
+    //
+    while (true)
+    {
+        size_t begin = se_vk_transfer_manager_align(manager->ringHead, manager->ringAlignment);
+        if ((begin % RING_SIZE) + size > RING_SIZE)
+        {
+            begin = se_vk_transfer_manager_align(begin, RING_SIZE);
+        }
+        if ((begin + size - manager->ringTail) <= RING_SIZE)
+        {
+            manager->ringHead = begin + size;
+            return begin % RING_SIZE;
+        }
+        se_vk_transfer_manager_update_ring_tail(manager);
+        if ((begin + size - manager->ringTail) <= RING_SIZE)
+        {
+            continue;
+        }
+        //
+        // Not enough space - submit active batch and wait for the oldest batch that still holds ring memory
+        //
+        se_vk_transfer_manager_flush(manager);
+        se_vk_transfer_manager_wait_oldest_batch(manager);
+        se_vk_transfer_manager_update_ring_tail(manager);
+    }
+}
+
+SeVkCommandBuffer* se_vk_transfer_manager_get_cmd(SeVkTransferManager* manager)
+{
+    if (manager->activeCmd)
+    {
+        return manager->activeCmd;
+    }
+    //
+    // Reuse a released slot (its pool is already reset) or create a new one if all slots are in flight
+    //
+    const size_t numFreeSlots = se_dynamic_array_size(manager->freeSlots);
+    if (numFreeSlots)
+    {
+        manager->activeSlot = manager->freeSlots[numFreeSlots - 1];
+        se_dynamic_array_remove_idx(manager->freeSlots, numFreeSlots - 1);
+        manager->activeCmd = manager->slots[manager->activeSlot].cmd;
+        se_vk_command_buffer_begin(manager->activeCmd, nullptr);
+    }
+    else
+    {
+        SeVkDevice* const device = manager->device;
+        const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(&device->memoryManager);
+        const VkCommandPoolCreateInfo poolCreateInfo = se_vk_utils_command_pool_create_info(manager->transferQueueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+        SeVkTransferSlot slot { };
+        se_vk_check(vkCreateCommandPool(se_vk_device_get_logical_handle(device), &poolCreateInfo, callbacks, &slot.pool));
+        auto& cmdPool = se_vk_memory_manager_get_pool<SeVkCommandBuffer>(&device->memoryManager);
+        SeVkCommandBufferInfo cmdInfo
+        {
+            .device = device,
+            .usage  = SE_VK_COMMAND_BUFFER_USAGE_TRANSFER,
+            .pool   = slot.pool,
+        };
+        slot.cmd = se_object_pool_take(cmdPool);
+        se_vk_command_buffer_construct(slot.cmd, &cmdInfo);
+        manager->activeSlot = se_dynamic_array_size(manager->slots);
+        manager->activeCmd = slot.cmd;
+        se_dynamic_array_push(manager->slots, slot);
+    }
+    //
+    // Previous batches might have written to the same memory. Submission order alone doesn't guarantee
+    // that copies are finished, so we need an explicit dependency between batches
+    //
+    const VkMemoryBarrier batchBarrier
+    {
+        .sType          = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .pNext          = nullptr,
+        .srcAccessMask  = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask  = VK_ACCESS_TRANSFER_WRITE_BIT,
+    };
+    vkCmdPipelineBarrier
+    (
+        manager->activeCmd->handle,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        1,
+        &batchBarrier,
+        0,
+        nullptr,
+        0,
+        nullptr
+    );
+    return manager->activeCmd;
+}
+
+void se_vk_transfer_manager_flush(SeVkTransferManager* manager)
+{
+    if (!manager->activeCmd)
+    {
+        return;
+    }
+    manager->timelineValue += 1;
+    const SeVkCommandBufferSubmitInfo submit
+    {
+        .commandBuffers     = &manager->activeCmd,
+        .numCommandBuffers  = 1,
+        .wait               = { },
+        .signal             = { { manager->timelineSemaphore, manager->timelineValue, 0 } },
+    };
+    se_vk_command_buffer_submit(&submit);
+    se_dynamic_array_push(manager->batches,
+    {
+        .slot           = manager->activeSlot,
+        .timelineValue  = manager->timelineValue,
+        .ringBegin      = manager->activeBatchRingBegin,
+        .ringEnd        = manager->ringHead,
+        .consumedFrame  = 0,
+        .isConsumed     = false,
+        .isFinished     = false,
+    });
+    manager->activeCmd = nullptr;
+    manager->activeBatchRingBegin = manager->ringHead;
+}
+
+void se_vk_transfer_manager_update(SeVkTransferManager* manager)
+{
+    se_vk_transfer_manager_update_ring_tail(manager);
+    //
+    // Batch slot can be reused only when all frames that waited on it are finished
+    //
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(manager->device);
+    const size_t frameNumber = manager->device->frameManager.frameNumber;
+    for (auto it : manager->batches)
+    {
+        const SeVkTransferBatch& batch = se_iterator_value(it);
+        if (!batch.isFinished || !batch.isConsumed) continue;
+        if ((frameNumber - batch.consumedFrame) < SeVkConfig::NUM_FRAMES_IN_FLIGHT) continue;
+        se_vk_check(vkResetCommandPool(logicalHandle, manager->slots[batch.slot].pool, 0));
+        se_dynamic_array_push(manager->freeSlots, batch.slot);
+        se_iterator_remove(it);
+    }
+}
+
+void se_vk_transfer_manager_upload_buffer(SeVkTransferManager* manager, SeVkMemoryBuffer* buffer, const void* data, size_t size, size_t offset)
+{
+    // @NOTE : big uploads are split in chunks, so they don't require the whole ring buffer to be free at once
+    constexpr size_t MAX_CHUNK_SIZE = SeVkConfig::TRANSFER_RING_BUFFER_SIZE / 2;
+    char* const ringMemory = (char*)manager->ringBuffer->memory.mappedMemory;
+    size_t copied = 0;
+    while (copied < size)
+    {
+        const size_t chunkSize = se_min(size - copied, MAX_CHUNK_SIZE);
+        const size_t ringOffset = se_vk_transfer_manager_alloc(manager, chunkSize);
+        memcpy(ringMemory + ringOffset, ((const char*)data) + copied, chunkSize);
+        const VkBufferCopy copy
+        {
+            .srcOffset  = ringOffset,
+            .dstOffset  = offset + copied,
+            .size       = chunkSize,
+        };
+        vkCmdCopyBuffer(se_vk_transfer_manager_get_cmd(manager)->handle, manager->ringBuffer->handle, buffer->handle, 1, &copy);
+        copied += chunkSize;
+    }
+}
+
+void se_vk_transfer_manager_upload_texture(SeVkTransferManager* manager, SeVkTexture* texture, uint32_t mip, const void* data, size_t size)
+{
+    constexpr size_t MAX_CHUNK_SIZE = SeVkConfig::TRANSFER_RING_BUFFER_SIZE / 2;
+    se_assert(mip < texture->numMips);
+    const SeVkFormatBlockInfo blockInfo = se_vk_utils_get_format_block_info(texture->format);
+    const VkExtent3D mipExtent =
+    {
+        se_max(texture->extent.width  >> mip, 1u),
+        se_max(texture->extent.height >> mip, 1u),
+        se_max(texture->extent.depth  >> mip, 1u),
+    };
+    //
+    // Data is copied by rows of texel blocks (rows of texels for uncompressed formats)
+    //
+    const uint32_t numBlockRows = (mipExtent.height + blockInfo.height - 1) / blockInfo.height;
+    const size_t rowSize = size_t((mipExtent.width + blockInfo.width - 1) / blockInfo.width) * blockInfo.size;
+    const size_t sliceSize = rowSize * numBlockRows;
+    se_assert_msg(size == sliceSize * mipExtent.depth, "Texture data size doesn't match texture extent");
+    //
+    // Big textures are copied in chunks of rows, so they don't need to fit in the ring buffer
+    //
+    const uint32_t maxRowsPerChunk = uint32_t(se_max(MAX_CHUNK_SIZE / rowSize, size_t(1)));
+    char* const ringMemory = (char*)manager->ringBuffer->memory.mappedMemory;
+    for (uint32_t slice = 0; slice < mipExtent.depth; slice++)
+    {
+        uint32_t row = 0;
+        while (row < numBlockRows)
+        {
+            const uint32_t numRows = se_min(numBlockRows - row, maxRowsPerChunk);
+            const size_t chunkSize = rowSize * numRows;
+            const size_t ringOffset = se_vk_transfer_manager_alloc(manager, chunkSize);
+            memcpy(ringMemory + ringOffset, ((const char*)data) + slice * sliceSize + row * rowSize, chunkSize);
+            const VkCommandBuffer cmd = se_vk_transfer_manager_get_cmd(manager)->handle;
+            //
+            // Transition
+            //
+            if (texture->currentLayout != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+            {
+                const VkImageLayout newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                const VkImageMemoryBarrier imageBarrier
+                {
+                    .sType                  = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                    .pNext                  = nullptr,
+                    .srcAccessMask          = se_vk_utils_image_layout_to_access_flags(texture->currentLayout),
+                    .dstAccessMask          = se_vk_utils_image_layout_to_access_flags(newLayout),
+                    .oldLayout              = texture->currentLayout,
+                    .newLayout              = newLayout,
+                    .srcQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
+                    .image                  = texture->image,
+                    .subresourceRange       = texture->fullSubresourceRange,
+                };
+                vkCmdPipelineBarrier
+                (
+                    cmd,
+                    se_vk_utils_image_layout_to_pipeline_stage_flags(texture->currentLayout),
+                    se_vk_utils_image_layout_to_pipeline_stage_flags(newLayout),
+                    0,
+                    0,
+                    nullptr,
+                    0,
+                    nullptr,
+                    1,
+                    &imageBarrier
+                );
+                texture->currentLayout = newLayout;
+            }
+            //
+            // Copy
+            //
+            const VkBufferImageCopy copy
+            {
+                .bufferOffset       = ringOffset,
+                .bufferRowLength    = 0,
+                .bufferImageHeight  = 0,
+                .imageSubresource   =
+                {
+                    VK_IMAGE_ASPECT_COLOR_BIT,
+                    mip,
+                    0,
+                    1,
+                },
+                .imageOffset        = { 0, int32_t(row * blockInfo.height), int32_t(slice) },
+                .imageExtent        = { mipExtent.width, se_min(numRows * blockInfo.height, mipExtent.height - row * blockInfo.height), 1 },
+            };
+            vkCmdCopyBufferToImage(cmd, manager->ringBuffer->handle, texture->image, texture->currentLayout, 1, &copy);
+            row += numRows;
+        }
+    }
+}
+
+void se_vk_transfer_manager_finish_texture(SeVkTransferManager* manager, SeVkTexture* texture, bool isMipGenerationRequired)
+{
+    se_assert(texture->currentLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    const bool isOwnershipTransferRequired =
+        (texture->flags & SE_VK_TEXTURE_EXCLUSIVE_SHARING) &&
+        (manager->transferQueueFamilyIndex != manager->graphicsQueueFamilyIndex);
+    const bool isBindlessTransitionRequired = texture->bindlessIndex != SE_BINDLESS_INVALID_INDEX;
+    //
+    // Release queue family ownership. Matching acquire barrier is recorded by se_vk_transfer_manager_acquire
+    //
+    if (isOwnershipTransferRequired)
+    {
+        const VkImageMemoryBarrier releaseBarrier
+        {
+            .sType                  = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext                  = nullptr,
+            .srcAccessMask          = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask          = 0,
+            .oldLayout              = texture->currentLayout,
+            .newLayout              = texture->currentLayout,
+            .srcQueueFamilyIndex    = manager->transferQueueFamilyIndex,
+            .dstQueueFamilyIndex    = manager->graphicsQueueFamilyIndex,
+            .image                  = texture->image,
+            .subresourceRange       = texture->fullSubresourceRange,
+        };
+        vkCmdPipelineBarrier
+        (
+            se_vk_transfer_manager_get_cmd(manager)->handle,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0,
+            0,
+            nullptr,
+            0,
+            nullptr,
+            1,
+            &releaseBarrier
+        );
+    }
+    if (isOwnershipTransferRequired || isMipGenerationRequired || isBindlessTransitionRequired)
+    {
+        se_dynamic_array_push(manager->pendingTextures,
+        {
+            .texture                        = se_object_pool_to_ref(se_vk_memory_manager_get_pool<SeVkTexture>(&manager->device->memoryManager), texture),
+            .isOwnershipTransferRequired    = isOwnershipTransferRequired,
+            .isMipGenerationRequired        = isMipGenerationRequired,
+            .isBindlessTransitionRequired   = isBindlessTransitionRequired,
+        });
+    }
+}
+
+void se_vk_transfer_manager_record_mip_generation(VkCommandBuffer cmd, SeVkTexture* texture)
+{
+    //
+    // Each mip is blitted from the previous one. When all mips are generated
+    // the whole image ends up in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL layout.
+    // Formats without linear filtering support (e.g. integer formats) are downsampled with nearest filter
+    //
+    se_assert(texture->currentLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    const VkFilter filter = se_vk_texture_is_linear_blit_supported(texture->device, texture->format) ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+    VkImageMemoryBarrier mipBarrier
+    {
+        .sType                  = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .pNext                  = nullptr,
+        .srcAccessMask          = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask          = VK_ACCESS_TRANSFER_READ_BIT,
+        .oldLayout              = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        .newLayout              = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        .srcQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
+        .image                  = texture->image,
+        .subresourceRange       = { texture->fullSubresourceRange.aspectMask, 0, 1, 0, 1 },
+    };
+    int32_t mipWidth = int32_t(texture->extent.width);
+    int32_t mipHeight = int32_t(texture->extent.height);
+    int32_t mipDepth = int32_t(texture->extent.depth);
+    for (uint32_t mip = 0; mip < texture->numMips; mip++)
+    {
+        mipBarrier.subresourceRange.baseMipLevel = mip;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &mipBarrier);
+        if (mip == (texture->numMips - 1))
+        {
+            break;
+        }
+        const int32_t nextMipWidth = se_max(mipWidth / 2, 1);
+        const int32_t nextMipHeight = se_max(mipHeight / 2, 1);
+        const int32_t nextMipDepth = se_max(mipDepth / 2, 1);
+        const VkImageBlit blit
+        {
+            .srcSubresource = { texture->fullSubresourceRange.aspectMask, mip, 0, 1 },
+            .srcOffsets     = { { 0, 0, 0 }, { mipWidth, mipHeight, mipDepth } },
+            .dstSubresource = { texture->fullSubresourceRange.aspectMask, mip + 1, 0, 1 },
+            .dstOffsets     = { { 0, 0, 0 }, { nextMipWidth, nextMipHeight, nextMipDepth } },
+        };
+        vkCmdBlitImage(cmd, texture->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, texture->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, filter);
+        mipWidth = nextMipWidth;
+        mipHeight = nextMipHeight;
+        mipDepth = nextMipDepth;
+    }
+    texture->currentLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+}
+
+uint64_t se_vk_transfer_manager_acquire(SeVkTransferManager* manager, SeVkCommandBuffer* cmd)
+{
+    se_vk_transfer_manager_flush(manager);
+    const uint64_t finishedValue = se_vk_utils_get_timeline_value(se_vk_device_get_logical_handle(manager->device), manager->timelineSemaphore);
+    const size_t frameNumber = manager->device->frameManager.frameNumber;
+    uint64_t waitValue = 0;
+    bool hasNewUploads = false;
+    for (auto it : manager->batches)
+    {
+        SeVkTransferBatch& batch = se_iterator_value(it);
+        if (batch.isConsumed) continue;
+        hasNewUploads = true;
+        batch.isConsumed = true;
+        batch.consumedFrame = frameNumber;
+        //
+        // Finished batches don't need semaphore wait. Timeline values grow monotonically, so waiting
+        // for the latest unfinished batch covers all of them
+        //
+        batch.isFinished = batch.isFinished || batch.timelineValue <= finishedValue;
+        if (!batch.isFinished) waitValue = se_max(waitValue, batch.timelineValue);
+    }
+    if (!hasNewUploads)
+    {
+        se_assert(se_dynamic_array_size(manager->pendingTextures) == 0);
+        return 0;
+    }
+    se_assert_msg
+    (
+        se_dynamic_array_size(manager->pendingTextures) == 0 || cmd->queue == se_vk_device_get_command_queue(manager->device, SE_VK_CMD_QUEUE_GRAPHICS),
+        "Uploaded textures must be acquired on the graphics queue"
+    );
+    //
+    // Global memory barrier makes uploaded data visible to all commands submitted after this one
+    //
+    SeDynamicArray<VkImageMemoryBarrier> acquireBarriers = se_dynamic_array_create<VkImageMemoryBarrier>(se_allocator_frame(), se_dynamic_array_size(manager->pendingTextures) + 1);
+    for (auto it : manager->pendingTextures)
+    {
+        const SeVkTransferTexture& pending = se_iterator_value(it);
+        const SeVkTexture* const texture = *pending.texture;
+        if (!texture || !pending.isOwnershipTransferRequired) continue;
+        se_dynamic_array_push(acquireBarriers,
+        {
+            .sType                  = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext                  = nullptr,
+            .srcAccessMask          = 0,
+            .dstAccessMask          = se_vk_utils_image_layout_to_access_flags(texture->currentLayout),
+            .oldLayout              = texture->currentLayout,
+            .newLayout              = texture->currentLayout,
+            .srcQueueFamilyIndex    = manager->transferQueueFamilyIndex,
+            .dstQueueFamilyIndex    = manager->graphicsQueueFamilyIndex,
+            .image                  = texture->image,
+            .subresourceRange       = texture->fullSubresourceRange,
+        });
+    }
+    const VkMemoryBarrier memoryBarrier
+    {
+        .sType          = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .pNext          = nullptr,
+        .srcAccessMask  = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask  = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+    };
+    vkCmdPipelineBarrier
+    (
+        cmd->handle,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        1,
+        &memoryBarrier,
+        0,
+        nullptr,
+        se_dynamic_array_size<uint32_t>(acquireBarriers),
+        se_dynamic_array_raw(acquireBarriers)
+    );
+    //
+    // Generate mips
+    //
+    for (auto it : manager->pendingTextures)
+    {
+        SeVkTransferTexture& pending = se_iterator_value(it);
+        SeVkTexture* const texture = *pending.texture;
+        if (!texture || !pending.isMipGenerationRequired) continue;
+        se_vk_transfer_manager_record_mip_generation(cmd->handle, texture);
+    }
+    //
+    // Move bindless textures to the layout used by heap descriptors. Graph doesn't see heap accesses, so it won't do that
+    //
+    se_dynamic_array_reset(acquireBarriers);
+    for (auto it : manager->pendingTextures)
+    {
+        const SeVkTransferTexture& pending = se_iterator_value(it);
+        SeVkTexture* const texture = *pending.texture;
+        if (!texture || !pending.isBindlessTransitionRequired) continue;
+        const VkImageLayout newLayout = se_vk_bindless_heap_get_image_layout(texture->format);
+        se_dynamic_array_push(acquireBarriers,
+        {
+            .sType                  = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext                  = nullptr,
+            .srcAccessMask          = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask          = VK_ACCESS_SHADER_READ_BIT,
+            .oldLayout              = texture->currentLayout,
+            .newLayout              = newLayout,
+            .srcQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED,
+            .image                  = texture->image,
+            .subresourceRange       = texture->fullSubresourceRange,
+        });
+        texture->currentLayout = newLayout;
+    }
+    if (se_dynamic_array_size(acquireBarriers))
+    {
+        vkCmdPipelineBarrier
+        (
+            cmd->handle,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            0,
+            nullptr,
+            0,
+            nullptr,
+            se_dynamic_array_size<uint32_t>(acquireBarriers),
+            se_dynamic_array_raw(acquireBarriers)
+        );
+    }
+    se_dynamic_array_destroy(acquireBarriers);
+    se_dynamic_array_reset(manager->pendingTextures);
+    return waitValue;
+}
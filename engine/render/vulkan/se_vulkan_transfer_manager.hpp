@@ -0,0 +1,85 @@
+#ifndef _SE_VULKAN_TRANSFER_MANAGER_H_
+#define _SE_VULKAN_TRANSFER_MANAGER_H_
+
+#include "se_vulkan_base.hpp"
+#include "se_vulkan_memory_buffer.hpp"
+
+//
+// Transfer manager uploads data to device local resources using transfer queue.
+//
+// Source data is copied to the host visible staging ring buffer and copy commands are
+// recorded to the currently active batch (single command buffer). Batch is submitted
+// when ring buffer runs out of space or when graph begins recording a frame.
+// Each batch signals the next value of the transfer timeline semaphore and owns a segment of the ring buffer,
+// which is reclaimed when the batch value is reached. First submission of a frame waits for the value of the last
+// submitted batch, first command buffer of a frame acquires queue family ownership of uploaded textures (if needed)
+// and generates texture mips.
+// Batches don't need fences or their own semaphores, so the only per batch objects are command buffers. Each one lives
+// in a slot with its own transient command pool. When batch is released, pool of its slot is reset and the slot is reused
+// by the next batch, so new pools and command buffers are created only when all existing slots are in flight.
+//
+
+struct SeVkTransferSlot
+{
+    VkCommandPool       pool;
+    SeVkCommandBuffer*  cmd;
+};
+
+struct SeVkTransferBatch
+{
+    size_t              slot;
+    uint64_t            timelineValue;
+    size_t              ringBegin;
+    size_t              ringEnd;
+    size_t              consumedFrame;
+    bool                isConsumed;
+    bool                isFinished;
+};
+
+struct SeVkTransferTexture
+{
+    SeObjectPoolEntryRef<SeVkTexture>   texture;
+    bool                                isOwnershipTransferRequired;
+    bool                                isMipGenerationRequired;
+    bool                                isBindlessTransitionRequired;   // Texture is in the bindless heap and must be moved to the heap layout
+};
+
+struct SeVkTransferManager
+{
+    SeVkDevice*                             device;
+    SeVkMemoryBuffer*                       ringBuffer;
+    size_t                                  ringHead;
+    size_t                                  ringTail;
+    size_t                                  ringAlignment;
+    size_t                                  activeBatchRingBegin;
+    SeVkCommandBuffer*                      activeCmd;
+    size_t                                  activeSlot;
+    VkSemaphore                             timelineSemaphore;
+    uint64_t                                timelineValue;  // Value signaled by the last submitted batch
+    SeDynamicArray<SeVkTransferBatch>       batches;
+    SeDynamicArray<SeVkTransferSlot>        slots;
+    SeDynamicArray<size_t>                  freeSlots;
+    SeDynamicArray<SeVkTransferTexture>     pendingTextures;
+    uint32_t                                transferQueueFamilyIndex;
+    uint32_t                                graphicsQueueFamilyIndex;
+};
+
+struct SeVkTransferManagerInfo
+{
+    SeVkDevice* device;
+};
+
+void    se_vk_transfer_manager_construct(SeVkTransferManager* manager, const SeVkTransferManagerInfo* info);
+void    se_vk_transfer_manager_destroy(SeVkTransferManager* manager);
+void    se_vk_transfer_manager_update(SeVkTransferManager* manager);
+void    se_vk_transfer_manager_flush(SeVkTransferManager* manager);
+
+void    se_vk_transfer_manager_upload_buffer(SeVkTransferManager* manager, SeVkMemoryBuffer* buffer, const void* data, size_t size, size_t offset);
+void    se_vk_transfer_manager_upload_texture(SeVkTransferManager* manager, SeVkTexture* texture, uint32_t mip, const void* data, size_t size);
+void    se_vk_transfer_manager_finish_texture(SeVkTransferManager* manager, SeVkTexture* texture, bool isMipGenerationRequired);
+
+// Must be called with the first command buffer of a frame. Returns value of the transfer timeline semaphore
+// that frame submission must wait for or 0 if there are no unfinished uploads
+uint64_t se_vk_transfer_manager_acquire(SeVkTransferManager* manager, SeVkCommandBuffer* cmd);
+
+#endif
@@ -0,0 +1,257 @@
+
+#include "se_vulkan_transient_heap.hpp"
+#include "se_vulkan_device.hpp"
+
+void se_vk_transient_heap_construct(SeVkTransientHeap* heap, const SeVkTransientHeapInfo* info)
+{
+    const SeAllocatorBindings allocator = se_allocator_persistent();
+    *heap =
+    {
+        .device             = info->device,
+        .planner            = { },
+        .resources          = se_dynamic_array_create<SeVkTransientHeapResource>(allocator),
+        .resourceIndices    = se_hash_table_create<SeVkObject*, size_t>(allocator),
+        .blocks             = se_dynamic_array_create<SeVkTransientHeapBlock>(allocator),
+        .retiredObjects     = se_dynamic_array_create<SeVkTransientHeapRetiredObject>(allocator),
+        .lastFrameStats     = { },
+    };
+    se_vk_aliasing_planner_construct(&heap->planner, allocator);
+}
+
+void se_vk_transient_heap_destroy_object(SeVkTransientHeap* heap, const SeVkTransientHeapRetiredObject& object)
+{
+    SeVkMemoryManager* const memoryManager = &heap->device->memoryManager;
+    const VkAllocationCallbacks* const callbacks = se_vk_memory_manager_get_callbacks(memoryManager);
+    const VkDevice logicalHandle = se_vk_device_get_logical_handle(heap->device);
+    vkDestroyImageView(logicalHandle, object.view, callbacks);
+    vkDestroyImage(logicalHandle, object.image, callbacks);
+    vkDestroyBuffer(logicalHandle, object.buffer, callbacks);
+    if (object.memory.memory) se_vk_memory_manager_deallocate(memoryManager, object.memory);
+}
+
+void se_vk_transient_heap_destroy(SeVkTransientHeap* heap)
+{
+    // @NOTE : device is idle at this point and all transient resources are already destroyed
+    for (auto it : heap->retiredObjects) se_vk_transient_heap_destroy_object(heap, se_iterator_value(it));
+    for (auto it : heap->blocks) se_vk_memory_manager_deallocate(&heap->device->memoryManager, se_iterator_value(it).memory);
+    se_vk_aliasing_planner_destroy(&heap->planner);
+    se_dynamic_array_destroy(heap->resources);
+    se_hash_table_destroy(heap->resourceIndices);
+    se_dynamic_array_destroy(heap->blocks);
+    se_dynamic_array_destroy(heap->retiredObjects);
+}
+
+void se_vk_transient_heap_retire(SeVkTransientHeap* heap, VkImage image, VkImageView view, VkBuffer buffer, SeVkMemory memory)
+{
+    se_dynamic_array_push(heap->retiredObjects,
+    {
+        .image          = image,
+        .view           = view,
+        .buffer         = buffer,
+        .memory         = memory,
+        .frameNumber    = heap->device->frameManager.frameNumber,
+    });
+}
+
+void se_vk_transient_heap_begin_frame(SeVkTransientHeap* heap)
+{
+    const SeVkFrameManager* const frameManager = &heap->device->frameManager;
+    for (auto it : heap->retiredObjects)
+    {
+        const SeVkTransientHeapRetiredObject& object = se_iterator_value(it);
+        if (!se_vk_frame_manager_is_frame_finished(frameManager, object.frameNumber)) continue;
+        se_vk_transient_heap_destroy_object(heap, object);
+        se_iterator_remove(it);
+    }
+    se_vk_aliasing_planner_reset(&heap->planner);
+    se_dynamic_array_reset(heap->resources);
+    se_hash_table_reset(heap->resourceIndices);
+}
+
+void se_vk_transient_heap_add_resource_use(SeVkTransientHeap* heap, SeVkObject* object, size_t use, bool isAliased, const VkMemoryRequirements& requirements, bool isLinear)
+{
+    if (const size_t* const index = se_hash_table_get(heap->resourceIndices, object))
+    {
+        const size_t plannerResource = heap->resources[*index].plannerResource;
+        if (plannerResource != SIZE_MAX) se_vk_aliasing_planner_add_use(&heap->planner, plannerResource, use);
+        return;
+    }
+    const size_t plannerResource = isAliased
+        ? se_vk_aliasing_planner_add_resource(&heap->planner,
+        {
+            .size           = requirements.size,
+            .alignment      = requirements.alignment,
+            .memoryTypeBits = requirements.memoryTypeBits,
+            .isLinear       = isLinear,
+            .firstUse       = use,
+            .lastUse        = use,
+        })
+        : SIZE_MAX;
+    se_hash_table_set(heap->resourceIndices, object, se_dynamic_array_size(heap->resources));
+    se_dynamic_array_push(heap->resources, { object, plannerResource });
+}
+
+void se_vk_transient_heap_add_use(SeVkTransientHeap* heap, SeVkTexture* texture, size_t use)
+{
+    if (!(texture->flags & SE_VK_TEXTURE_TRANSIENT)) return;
+    se_vk_transient_heap_add_resource_use(heap, &texture->object, use, texture->flags & SE_VK_TEXTURE_ALIASED, texture->memoryRequirements, false);
+}
+
+void se_vk_transient_heap_add_use(SeVkTransientHeap* heap, SeVkMemoryBuffer* buffer, size_t use)
+{
+    if (!(buffer->flags & SE_VK_MEMORY_BUFFER_ALIASED)) return;
+    se_vk_transient_heap_add_resource_use(heap, &buffer->object, use, true, buffer->memoryRequirements, true);
+}
+
+//
+// Retires the block and unbinds all resources placed in it. Unused resources can't be found through the frame uses,
+// so all textures and buffers are checked (blocks are retired rarely)
+//
+void se_vk_transient_heap_retire_block(SeVkTransientHeap* heap, const SeVkTransientHeapBlock& block)
+{
+    SeVkMemoryManager* const memoryManager = &heap->device->memoryManager;
+    const VkDeviceSize blockBegin = block.memory.offset;
+    const VkDeviceSize blockEnd = block.memory.offset + block.memory.size;
+    const auto isInBlock = [&](const SeVkMemory& memory) -> bool
+    {
+        return memory.memory == block.memory.memory && memory.offset >= blockBegin && memory.offset < blockEnd;
+    };
+    for (auto it : se_vk_memory_manager_get_pool<SeVkTexture>(memoryManager))
+    {
+        SeVkTexture& texture = se_iterator_value(it);
+        if (!(texture.flags & SE_VK_TEXTURE_ALIASED) || !isInBlock(texture.memory)) continue;
+        se_vk_transient_heap_retire(heap, texture.image, texture.view, VK_NULL_HANDLE, { });
+        texture.image = VK_NULL_HANDLE;
+        texture.view = VK_NULL_HANDLE;
+        texture.attachmentView = VK_NULL_HANDLE;
+        texture.memory = { VK_NULL_HANDLE, 0, texture.memoryRequirements.size, nullptr };
+    }
+    for (auto it : se_vk_memory_manager_get_pool<SeVkMemoryBuffer>(memoryManager))
+    {
+        SeVkMemoryBuffer& buffer = se_iterator_value(it);
+        if (!(buffer.flags & SE_VK_MEMORY_BUFFER_ALIASED) || !isInBlock(buffer.memory)) continue;
+        se_vk_transient_heap_retire(heap, VK_NULL_HANDLE, VK_NULL_HANDLE, buffer.handle, { });
+        buffer.handle = VK_NULL_HANDLE;
+        buffer.memory = { VK_NULL_HANDLE, 0, buffer.size, nullptr };
+    }
+    se_vk_transient_heap_retire(heap, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, block.memory);
+}
+
+void se_vk_transient_heap_place(SeVkTransientHeap* heap)
+{
+    SeVkMemoryManager* const memoryManager = &heap->device->memoryManager;
+    const size_t currentFrame = heap->device->frameManager.frameNumber;
+    const SeAllocatorBindings frameAllocator = se_allocator_frame();
+    se_vk_aliasing_planner_plan(&heap->planner);
+    //
+    // Free blocks that weren't used for a while
+    //
+    for (auto it : heap->blocks)
+    {
+        const SeVkTransientHeapBlock& block = se_iterator_value(it);
+        if ((currentFrame - block.lastUsedFrame) <= SeVkConfig::TRANSIENT_HEAP_BLOCK_LIFETIME) continue;
+        se_vk_transient_heap_retire_block(heap, block);
+        se_iterator_remove(it);
+    }
+    //
+    // Find or allocate a block for every planned block. Block that is too small is replaced
+    //
+    const size_t numPlannedBlocks = se_dynamic_array_size(heap->planner.blocks);
+    SeDynamicArray<size_t> blockIndices = se_dynamic_array_create<size_t>(frameAllocator, numPlannedBlocks);
+    for (auto plannedIt : heap->planner.blocks)
+    {
+        const SeVkAliasingBlock& planned = se_iterator_value(plannedIt);
+        size_t blockIndex = se_dynamic_array_size(heap->blocks);
+        for (size_t it = 0; it < se_dynamic_array_size(heap->blocks); it++)
+        {
+            const SeVkTransientHeapBlock& block = heap->blocks[it];
+            if (block.memoryTypeBits == planned.memoryTypeBits && block.isLinear == planned.isLinear)
+            {
+                blockIndex = it;
+                break;
+            }
+        }
+        const bool isFound = blockIndex != se_dynamic_array_size(heap->blocks);
+        const bool isSuitable = isFound &&
+            heap->blocks[blockIndex].memory.size >= planned.size &&
+            (heap->blocks[blockIndex].memory.offset % planned.alignment) == 0;
+        if (!isSuitable)
+        {
+            if (isFound) se_vk_transient_heap_retire_block(heap, heap->blocks[blockIndex]);
+            const SeVkTransientHeapBlock block
+            {
+                .memory         = se_vk_memory_manager_allocate(memoryManager,
+                {
+                    .size           = planned.size,
+                    .alignment      = planned.alignment,
+                    .memoryTypeBits = planned.memoryTypeBits,
+                    .properties     = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                }),
+                .memoryTypeBits = planned.memoryTypeBits,
+                .isLinear       = planned.isLinear,
+                .lastUsedFrame  = currentFrame,
+            };
+            if (isFound)    heap->blocks[blockIndex] = block;
+            else            se_dynamic_array_push(heap->blocks, block);
+        }
+        heap->blocks[blockIndex].lastUsedFrame = currentFrame;
+        se_dynamic_array_push(blockIndices, blockIndex);
+    }
+    //
+    // Bind resources to the planned locations and reset their states (see comment in se_vulkan_transient_heap.hpp)
+    //
+    SeVkTransientHeapStats stats
+    {
+        .numResources       = se_dynamic_array_size(heap->resources),
+        .numLazilyAllocated = 0,
+        .requiredBytes      = se_vk_aliasing_planner_required_size(&heap->planner),
+        .plannedBytes       = se_vk_aliasing_planner_planned_size(&heap->planner),
+        .heapBytes          = 0,
+        .numRebinds         = 0,
+    };
+    const SeVkBarrierResourceState firstUseState = { VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_WRITE_BIT, 0, 0, 0 };
+    for (auto it : heap->resources)
+    {
+        const SeVkTransientHeapResource& resource = se_iterator_value(it);
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        if (resource.plannerResource != SIZE_MAX)
+        {
+            const SeVkAliasingPlacement& placement = heap->planner.placements[resource.plannerResource];
+            const SeVkTransientHeapBlock& block = heap->blocks[blockIndices[placement.block]];
+            memory = block.memory.memory;
+            offset = block.memory.offset + placement.offset;
+        }
+        else
+        {
+            stats.numLazilyAllocated += 1;
+        }
+        if (resource.object->type == SeVkObject::Type::TEXTURE)
+        {
+            SeVkTexture* const texture = (SeVkTexture*)resource.object;
+            if (memory && (texture->memory.memory != memory || texture->memory.offset != offset))
+            {
+                se_vk_transient_heap_retire(heap, texture->image, texture->view, VK_NULL_HANDLE, { });
+                se_vk_texture_bind_aliased_memory(texture, memory, offset);
+                stats.numRebinds += 1;
+            }
+            texture->barrierState = firstUseState;
+            texture->currentLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        }
+        else
+        {
+            se_assert(resource.object->type == SeVkObject::Type::MEMORY_BUFFER);
+            SeVkMemoryBuffer* const buffer = (SeVkMemoryBuffer*)resource.object;
+            if (buffer->memory.memory != memory || buffer->memory.offset != offset)
+            {
+                se_vk_transient_heap_retire(heap, VK_NULL_HANDLE, VK_NULL_HANDLE, buffer->handle, { });
+                se_vk_memory_buffer_bind_aliased_memory(buffer, memory, offset);
+                stats.numRebinds += 1;
+            }
+            buffer->barrierState = firstUseState;
+        }
+    }
+    for (auto it : heap->blocks) stats.heapBytes += se_iterator_value(it).memory.size;
+    heap->lastFrameStats = stats;
+    se_dynamic_array_destroy(blockIndices);
+}
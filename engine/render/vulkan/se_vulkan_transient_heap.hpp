@@ -0,0 +1,90 @@
+#ifndef _SE_VULKAN_TRANSIENT_HEAP_H_
+#define _SE_VULKAN_TRANSIENT_HEAP_H_
+
+#include "se_vulkan_base.hpp"
+#include "se_vulkan_memory.hpp"
+#include "se_vulkan_texture.hpp"
+#include "se_vulkan_memory_buffer.hpp"
+#include "se_vulkan_aliasing_planner.hpp"
+
+//
+// Transient heap places transient textures and buffers of a frame in shared memory blocks.
+//
+// Render graph reports every use of a transient resource (index of the pass group that uses it), then heap plans the frame
+// with the aliasing planner and binds every aliased resource to its planned location. Vulkan can't rebind memory of an
+// existing image or buffer, so resource that is moved gets a new handle (and view), old ones are destroyed when frames
+// that used them are finished. Plan depends only on the sequence of passes, so in steady state nothing is recreated.
+//
+// Memory of a transient resource is shared with other resources, so contents are undefined at the first use in a frame.
+// Resource state is reset at the first use, so the first barrier waits for all previous commands (including the commands of
+// the previous frames that used the same memory) and transitions the image from the undefined layout.
+//
+// Transient attachments in lazily allocated memory aren't aliased (they usually don't take memory at all), but their state
+// is reset too.
+//
+// Blocks only grow (block that is too small is replaced with a bigger one) and are freed if they aren't used for
+// TRANSIENT_HEAP_BLOCK_LIFETIME frames. Resources that are still bound to a replaced block are unbound, so they are placed
+// again on their next use.
+//
+
+struct SeVkTransientHeapBlock
+{
+    SeVkMemory  memory;
+    uint32_t    memoryTypeBits;
+    bool        isLinear;
+    size_t      lastUsedFrame;
+};
+
+struct SeVkTransientHeapResource
+{
+    SeVkObject* object;             // Texture or memory buffer
+    size_t      plannerResource;    // SIZE_MAX for lazily allocated textures
+};
+
+struct SeVkTransientHeapRetiredObject
+{
+    VkImage     image;
+    VkImageView view;
+    VkBuffer    buffer;
+    SeVkMemory  memory;     // Memory of a retired block
+    size_t      frameNumber;
+};
+
+struct SeVkTransientHeapStats
+{
+    size_t  numResources;
+    size_t  numLazilyAllocated;
+    size_t  requiredBytes;      // Sum of memory requirements of the aliased resources
+    size_t  plannedBytes;       // Sum of the planned block sizes
+    size_t  heapBytes;          // Sum of the allocated block sizes
+    size_t  numRebinds;         // Resources that were moved to a different location
+};
+
+struct SeVkTransientHeap
+{
+    SeVkDevice*                                     device;
+    SeVkAliasingPlanner                             planner;
+    SeDynamicArray<SeVkTransientHeapResource>       resources;          // Transient resources used during the frame
+    SeHashTable<SeVkObject*, size_t>                resourceIndices;    // Object -> index in resources
+    SeDynamicArray<SeVkTransientHeapBlock>          blocks;
+    SeDynamicArray<SeVkTransientHeapRetiredObject>  retiredObjects;
+    SeVkTransientHeapStats                          lastFrameStats;
+};
+
+struct SeVkTransientHeapInfo
+{
+    SeVkDevice* device;
+};
+
+void    se_vk_transient_heap_construct(SeVkTransientHeap* heap, const SeVkTransientHeapInfo* info);
+void    se_vk_transient_heap_destroy(SeVkTransientHeap* heap);
+
+// Destroys retired objects of the finished frames and prepares the heap for the frame uses
+void    se_vk_transient_heap_begin_frame(SeVkTransientHeap* heap);
+// Non-transient resources are ignored
+void    se_vk_transient_heap_add_use(SeVkTransientHeap* heap, SeVkTexture* texture, size_t use);
+void    se_vk_transient_heap_add_use(SeVkTransientHeap* heap, SeVkMemoryBuffer* buffer, size_t use);
+// Places all resources used during the frame and resets their states. Must be called before any of them is accessed in this frame
+void    se_vk_transient_heap_place(SeVkTransientHeap* heap);
+
+#endif
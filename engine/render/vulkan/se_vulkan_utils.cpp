@@ -102,6 +102,47 @@ void se_vk_utils_destroy_command_pool(VkCommandPool pool, VkDevice device, const
     vkDestroyCommandPool(device, pool, callbacks);
 }
 
+VkSemaphore se_vk_utils_create_timeline_semaphore(VkDevice device, uint64_t initialValue, const VkAllocationCallbacks* callbacks)
+{
+    VkSemaphore semaphore;
+    const VkSemaphoreTypeCreateInfo typeInfo
+    {
+        .sType          = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+        .pNext          = nullptr,
+        .semaphoreType  = VK_SEMAPHORE_TYPE_TIMELINE,
+        .initialValue   = initialValue,
+    };
+    const VkSemaphoreCreateInfo semaphoreInfo
+    {
+        .sType          = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext          = &typeInfo,
+        .flags          = 0,
+    };
+    se_vk_check(vkCreateSemaphore(device, &semaphoreInfo, callbacks, &semaphore));
+    return semaphore;
+}
+
+uint64_t se_vk_utils_get_timeline_value(VkDevice device, VkSemaphore semaphore)
+{
+    uint64_t value;
+    se_vk_check(vkGetSemaphoreCounterValue(device, semaphore, &value));
+    return value;
+}
+
+void se_vk_utils_wait_timeline(VkDevice device, VkSemaphore semaphore, uint64_t value)
+{
+    const VkSemaphoreWaitInfo waitInfo
+    {
+        .sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+        .pNext          = nullptr,
+        .flags          = 0,
+        .semaphoreCount = 1,
+        .pSemaphores    = &semaphore,
+        .pValues        = &value,
+    };
+    se_vk_check(vkWaitSemaphores(device, &waitInfo, UINT64_MAX));
+}
+
 SeVkSwapChainSupportDetails se_vk_utils_create_swap_chain_support_details(VkSurfaceKHR surface, VkPhysicalDevice device, const SeAllocatorBindings& allocator)
 {
     SeVkSwapChainSupportDetails result = {0};
@@ -201,6 +242,18 @@ uint32_t se_vk_utils_pick_present_queue(const SeDynamicArray<VkQueueFamilyProper
 
 uint32_t se_vk_utils_pick_transfer_queue(const SeDynamicArray<VkQueueFamilyProperties>& familyProperties)
 {
+    //
+    // @NOTE :  dedicated transfer queue family (without graphics and compute support) is preferred,
+    //          because usually it is backed by the copy engine and can run in parallel with rendering
+    //
+    for (auto it : familyProperties)
+    {
+        const VkQueueFlags flags = se_iterator_value(it).queueFlags;
+        if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+        {
+            return (uint32_t)se_iterator_index(it);
+        }
+    }
     for (auto it : familyProperties)
     {
         if (se_iterator_value(it).queueFlags & VK_QUEUE_TRANSFER_BIT)
@@ -213,6 +266,18 @@ uint32_t se_vk_utils_pick_transfer_queue(const SeDynamicArray<VkQueueFamilyPrope
 
 uint32_t se_vk_utils_pick_compute_queue(const SeDynamicArray<VkQueueFamilyProperties>& familyProperties)
 {
+    //
+    // @NOTE :  dedicated compute queue family (without graphics support) is preferred, because render graph can
+    //          run compute passes on it in parallel with rendering (see se_vulkan_queue_scheduler.hpp)
+    //
+    for (auto it : familyProperties)
+    {
+        const VkQueueFlags flags = se_iterator_value(it).queueFlags;
+        if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT))
+        {
+            return (uint32_t)se_iterator_index(it);
+        }
+    }
     for (auto it : familyProperties)
     {
         if (se_iterator_value(it).queueFlags & VK_QUEUE_COMPUTE_BIT)
@@ -434,6 +499,14 @@ SeTextureFormat se_vk_utils_to_se_texture_format(VkFormat vkFormat)
         case VK_FORMAT_R8_SRGB: return SeTextureFormat::R_8_SRGB;
         case VK_FORMAT_R8G8B8A8_UNORM: return SeTextureFormat::RGBA_8_UNORM;
         case VK_FORMAT_R8G8B8A8_SRGB: return SeTextureFormat::RGBA_8_SRGB;
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK: return SeTextureFormat::BC1_RGBA_UNORM;
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK: return SeTextureFormat::BC1_RGBA_SRGB;
+        case VK_FORMAT_BC3_UNORM_BLOCK: return SeTextureFormat::BC3_UNORM;
+        case VK_FORMAT_BC3_SRGB_BLOCK: return SeTextureFormat::BC3_SRGB;
+        case VK_FORMAT_BC4_UNORM_BLOCK: return SeTextureFormat::BC4_UNORM;
+        case VK_FORMAT_BC5_UNORM_BLOCK: return SeTextureFormat::BC5_UNORM;
+        case VK_FORMAT_BC7_UNORM_BLOCK: return SeTextureFormat::BC7_UNORM;
+        case VK_FORMAT_BC7_SRGB_BLOCK: return SeTextureFormat::BC7_SRGB;
     }
     se_assert(!"Unsupported VkFormat");
     return (SeTextureFormat)0;
@@ -447,6 +520,14 @@ VkFormat se_vk_utils_to_vk_texture_format(SeTextureFormat format)
         case SeTextureFormat::R_8_SRGB: return VK_FORMAT_R8_SRGB;
         case SeTextureFormat::RGBA_8_UNORM: return VK_FORMAT_R8G8B8A8_UNORM;
         case SeTextureFormat::RGBA_8_SRGB: return VK_FORMAT_R8G8B8A8_SRGB;
+        case SeTextureFormat::BC1_RGBA_UNORM: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case SeTextureFormat::BC1_RGBA_SRGB: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+        case SeTextureFormat::BC3_UNORM: return VK_FORMAT_BC3_UNORM_BLOCK;
+        case SeTextureFormat::BC3_SRGB: return VK_FORMAT_BC3_SRGB_BLOCK;
+        case SeTextureFormat::BC4_UNORM: return VK_FORMAT_BC4_UNORM_BLOCK;
+        case SeTextureFormat::BC5_UNORM: return VK_FORMAT_BC5_UNORM_BLOCK;
+        case SeTextureFormat::BC7_UNORM: return VK_FORMAT_BC7_UNORM_BLOCK;
+        case SeTextureFormat::BC7_SRGB: return VK_FORMAT_BC7_SRGB_BLOCK;
     }
     se_assert(!"Unsupported TextureFormat");
     return (VkFormat)0;
@@ -839,3 +920,23 @@ SeVkFormatInfo se_vk_utils_get_format_info(VkFormat format)
     }
     return { };
 }
+
+SeVkFormatBlockInfo se_vk_utils_get_format_block_info(VkFormat format)
+{
+    switch (format)
+    {
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:        return { 4, 4, 8 };
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:         return { 4, 4, 8 };
+        case VK_FORMAT_BC3_UNORM_BLOCK:             return { 4, 4, 16 };
+        case VK_FORMAT_BC3_SRGB_BLOCK:              return { 4, 4, 16 };
+        case VK_FORMAT_BC4_UNORM_BLOCK:             return { 4, 4, 8 };
+        case VK_FORMAT_BC5_UNORM_BLOCK:             return { 4, 4, 16 };
+        case VK_FORMAT_BC7_UNORM_BLOCK:             return { 4, 4, 16 };
+        case VK_FORMAT_BC7_SRGB_BLOCK:              return { 4, 4, 16 };
+        default:
+        {
+            const SeVkFormatInfo formatInfo = se_vk_utils_get_format_info(format);
+            return { 1, 1, uint32_t(formatInfo.numComponents) * formatInfo.componentsSizeBits / 8 };
+        }
+    }
+}
@@ -28,6 +28,16 @@
             (format) == VK_FORMAT_D24_UNORM_S8_UINT     ||  \
             (format) == VK_FORMAT_D32_SFLOAT_S8_UINT    )      
 
+#define se_vk_utils_is_block_compressed_format(format)      \
+            ((format) == VK_FORMAT_BC1_RGBA_UNORM_BLOCK ||  \
+            (format) == VK_FORMAT_BC1_RGBA_SRGB_BLOCK   ||  \
+            (format) == VK_FORMAT_BC3_UNORM_BLOCK       ||  \
+            (format) == VK_FORMAT_BC3_SRGB_BLOCK        ||  \
+            (format) == VK_FORMAT_BC4_UNORM_BLOCK       ||  \
+            (format) == VK_FORMAT_BC5_UNORM_BLOCK       ||  \
+            (format) == VK_FORMAT_BC7_UNORM_BLOCK       ||  \
+            (format) == VK_FORMAT_BC7_SRGB_BLOCK        )
+
 struct SeVkSwapChainSupportDetails
 {
     VkSurfaceCapabilitiesKHR            capabilities;
@@ -55,6 +65,14 @@ struct SeVkFormatInfo
     Type sampledType;
 };
 
+// Texel block of a format. Uncompressed formats have 1x1 blocks
+struct SeVkFormatBlockInfo
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t size;
+};
+
 const char**                            se_vk_utils_get_required_validation_layers(size_t* outNum);
 const char**                            se_vk_utils_get_required_instance_extensions(size_t* outNum);
 const char**                            se_vk_utils_get_required_device_extensions(size_t* outNum);
@@ -65,6 +83,9 @@ VkDebugUtilsMessengerEXT                se_vk_utils_create_debug_messenger(const
 void                                    se_vk_utils_destroy_debug_messenger(VkInstance instance, VkDebugUtilsMessengerEXT messenger, const VkAllocationCallbacks* callbacks);
 VkCommandPool                           se_vk_utils_create_command_pool(VkDevice device, uint32_t queueFamilyIndex, const VkAllocationCallbacks* callbacks, VkCommandPoolCreateFlags flags);
 void                                    se_vk_utils_destroy_command_pool(VkCommandPool pool, VkDevice device, const VkAllocationCallbacks* callbacks);
+VkSemaphore                             se_vk_utils_create_timeline_semaphore(VkDevice device, uint64_t initialValue, const VkAllocationCallbacks* callbacks);
+uint64_t                                se_vk_utils_get_timeline_value(VkDevice device, VkSemaphore semaphore);
+void                                    se_vk_utils_wait_timeline(VkDevice device, VkSemaphore semaphore, uint64_t value);
 SeVkSwapChainSupportDetails             se_vk_utils_create_swap_chain_support_details(VkSurfaceKHR surface, VkPhysicalDevice device, const SeAllocatorBindings& allocator);
 void                                    se_vk_utils_destroy_swap_chain_support_details(SeVkSwapChainSupportDetails& details);
 VkSurfaceFormatKHR                      se_vk_utils_choose_swap_chain_surface_format(const SeDynamicArray<VkSurfaceFormatKHR>& available);
@@ -107,5 +128,6 @@ VkAccessFlags                           se_vk_utils_image_layout_to_access_flags
 VkPipelineStageFlags                    se_vk_utils_image_layout_to_pipeline_stage_flags(VkImageLayout layout);
 VkAttachmentLoadOp                      se_vk_utils_to_vk_load_op(SeRenderTargetLoadOp loadOp);
 SeVkFormatInfo                          se_vk_utils_get_format_info(VkFormat format);
+SeVkFormatBlockInfo                     se_vk_utils_get_format_block_info(VkFormat format);
 
 #endif
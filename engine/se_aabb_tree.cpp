@@ -0,0 +1,682 @@
+
+#include "se_aabb_tree.hpp"
+
+#include <bit>
+
+// @NOTE : incremental trees are kept balanced and sah builder falls back to median splits below SE_AABB_TREE_MAX_SAH_DEPTH,
+//         so the depth of the tree (and the size of the traversal stack) stays far below this value
+constexpr size_t SE_AABB_TREE_MAX_STACK = 256;
+constexpr size_t SE_AABB_TREE_MAX_SAH_DEPTH = 64;
+constexpr size_t SE_AABB_TREE_SAH_BINS = 16;
+constexpr size_t SE_AABB_TREE_BATCH_SIZE = 32;
+
+struct SeAabbTreeStackEntry
+{
+    uint32_t node;
+    uint32_t mask;  // frustum planes or batched queries that still need to be tested
+};
+
+struct SeAabbTreeQueryHit
+{
+    uint32_t query;
+    uint32_t proxy;
+};
+
+struct SeAabbTreeBuildLeaf
+{
+    uint32_t proxy;
+    SeFloat3 centroid;
+};
+
+#define se_aabb_tree_stack_push(stack, stackSize, ...)                                      \
+    do {                                                                                    \
+        se_assert_msg((stackSize) < SE_AABB_TREE_MAX_STACK, "Aabb tree traversal stack overflow"); \
+        (stack)[(stackSize)++] = __VA_ARGS__;                                               \
+    } while (false)
+
+inline bool se_aabb_tree_is_leaf(const SeAabbTreeNode& node)
+{
+    return node.children[0] == SE_AABB_TREE_INVALID;
+}
+
+//
+// Node allocation
+//
+
+uint32_t se_aabb_tree_allocate_node(SeAabbTree* tree)
+{
+    uint32_t index;
+    if (tree->freeList != SE_AABB_TREE_INVALID)
+    {
+        index = tree->freeList;
+        tree->freeList = tree->nodes[index].parent;
+    }
+    else
+    {
+        index = se_dynamic_array_size<uint32_t>(tree->nodes);
+        se_assert_msg(index != SE_AABB_TREE_INVALID, "Too many aabb tree nodes");
+        se_dynamic_array_add(tree->nodes);
+    }
+    tree->nodes[index] =
+    {
+        .aabb       = { },
+        .parent     = SE_AABB_TREE_INVALID,
+        .children   = { SE_AABB_TREE_INVALID, SE_AABB_TREE_INVALID },
+        .height     = 0,
+        .userData   = 0,
+    };
+    return index;
+}
+
+void se_aabb_tree_free_node(SeAabbTree* tree, uint32_t index)
+{
+    SeAabbTreeNode& node = tree->nodes[index];
+    node.parent = tree->freeList;
+    node.height = -1;
+    tree->freeList = index;
+}
+
+//
+// Incremental updates
+//
+
+void se_aabb_tree_replace_child(SeAabbTree* tree, uint32_t parent, uint32_t oldChild, uint32_t newChild)
+{
+    if (parent == SE_AABB_TREE_INVALID)
+    {
+        tree->root = newChild;
+        return;
+    }
+    SeAabbTreeNode& parentNode = tree->nodes[parent];
+    if (parentNode.children[0] == oldChild) parentNode.children[0] = newChild;
+    else                                    parentNode.children[1] = newChild;
+}
+
+//
+// If one child of the node is more than one level higher than the other, the higher child is rotated up and takes
+// place of the node. Returns index of the node that is now at this place.
+// @NOTE : node that goes down can still be unbalanced if the height difference was more than two (leaf inserted next
+//         to a high subtree), so it is balanced recursively. Height of the node is at most the height of the rotated
+//         up child, so recursion depth is bounded by the tree height
+//
+uint32_t se_aabb_tree_balance(SeAabbTree* tree, uint32_t indexA)
+{
+    SeAabbTreeNode* const nodes = se_dynamic_array_raw(tree->nodes);
+    SeAabbTreeNode& a = nodes[indexA];
+    if (se_aabb_tree_is_leaf(a) || a.height < 2) return indexA;
+
+    const uint32_t indexB = a.children[0];
+    const uint32_t indexC = a.children[1];
+    SeAabbTreeNode& b = nodes[indexB];
+    SeAabbTreeNode& c = nodes[indexC];
+    const int32_t balance = c.height - b.height;
+    if (balance > 1)
+    {
+        //
+        // Rotate C up. The higher child of C stays with C, the lower one goes to A
+        //
+        const uint32_t indexF = c.children[0];
+        const uint32_t indexG = c.children[1];
+        SeAabbTreeNode& f = nodes[indexF];
+        SeAabbTreeNode& g = nodes[indexG];
+        c.children[0] = indexA;
+        c.parent = a.parent;
+        a.parent = indexC;
+        se_aabb_tree_replace_child(tree, c.parent, indexA, indexC);
+        const bool isFHigher = f.height > g.height;
+        const uint32_t indexStays = isFHigher ? indexF : indexG;
+        const uint32_t indexMoves = isFHigher ? indexG : indexF;
+        c.children[1] = indexStays;
+        a.children[1] = indexMoves;
+        nodes[indexMoves].parent = indexA;
+        a.aabb = se_aabb_union(b.aabb, nodes[indexMoves].aabb);
+        a.height = 1 + se_max(b.height, nodes[indexMoves].height);
+        const SeAabbTreeNode& down = nodes[se_aabb_tree_balance(tree, indexA)];
+        c.aabb = se_aabb_union(down.aabb, nodes[indexStays].aabb);
+        c.height = 1 + se_max(down.height, nodes[indexStays].height);
+        return indexC;
+    }
+    if (balance < -1)
+    {
+        //
+        // Rotate B up. The higher child of B stays with B, the lower one goes to A
+        //
+        const uint32_t indexD = b.children[0];
+        const uint32_t indexE = b.children[1];
+        SeAabbTreeNode& d = nodes[indexD];
+        SeAabbTreeNode& e = nodes[indexE];
+        b.children[0] = indexA;
+        b.parent = a.parent;
+        a.parent = indexB;
+        se_aabb_tree_replace_child(tree, b.parent, indexA, indexB);
+        const bool isDHigher = d.height > e.height;
+        const uint32_t indexStays = isDHigher ? indexD : indexE;
+        const uint32_t indexMoves = isDHigher ? indexE : indexD;
+        b.children[1] = indexStays;
+        a.children[0] = indexMoves;
+        nodes[indexMoves].parent = indexA;
+        a.aabb = se_aabb_union(c.aabb, nodes[indexMoves].aabb);
+        a.height = 1 + se_max(c.height, nodes[indexMoves].height);
+        const SeAabbTreeNode& down = nodes[se_aabb_tree_balance(tree, indexA)];
+        b.aabb = se_aabb_union(down.aabb, nodes[indexStays].aabb);
+        b.height = 1 + se_max(down.height, nodes[indexStays].height);
+        return indexB;
+    }
+    return indexA;
+}
+
+void se_aabb_tree_refit_ancestors(SeAabbTree* tree, uint32_t index)
+{
+    while (index != SE_AABB_TREE_INVALID)
+    {
+        index = se_aabb_tree_balance(tree, index);
+        SeAabbTreeNode& node = tree->nodes[index];
+        const SeAabbTreeNode& first = tree->nodes[node.children[0]];
+        const SeAabbTreeNode& second = tree->nodes[node.children[1]];
+        node.aabb = se_aabb_union(first.aabb, second.aabb);
+        node.height = 1 + se_max(first.height, second.height);
+        index = node.parent;
+    }
+}
+
+void se_aabb_tree_insert_leaf(SeAabbTree* tree, uint32_t leaf)
+{
+    if (tree->root == SE_AABB_TREE_INVALID)
+    {
+        tree->root = leaf;
+        tree->nodes[leaf].parent = SE_AABB_TREE_INVALID;
+        return;
+    }
+    //
+    // Find the best sibling. Going down to a child costs the area increase of the current node (inherited by
+    // all of its ancestors too), stopping here costs the area of the new parent of the current node and the leaf
+    //
+    const SeAabb leafAabb = tree->nodes[leaf].aabb;
+    uint32_t index = tree->root;
+    while (!se_aabb_tree_is_leaf(tree->nodes[index]))
+    {
+        const SeAabbTreeNode& node = tree->nodes[index];
+        const float area = se_aabb_surface_area(node.aabb);
+        const float combinedArea = se_aabb_surface_area(se_aabb_union(node.aabb, leafAabb));
+        const float cost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+        float childCosts[2];
+        for (size_t it = 0; it < 2; it++)
+        {
+            const SeAabbTreeNode& child = tree->nodes[node.children[it]];
+            const float childCombinedArea = se_aabb_surface_area(se_aabb_union(child.aabb, leafAabb));
+            childCosts[it] = inheritanceCost + (se_aabb_tree_is_leaf(child) ? childCombinedArea : childCombinedArea - se_aabb_surface_area(child.aabb));
+        }
+        if (cost < childCosts[0] && cost < childCosts[1]) break;
+        index = childCosts[0] < childCosts[1] ? node.children[0] : node.children[1];
+    }
+    //
+    // New parent takes place of the sibling
+    //
+    const uint32_t sibling = index;
+    const uint32_t newParent = se_aabb_tree_allocate_node(tree);
+    SeAabbTreeNode& siblingNode = tree->nodes[sibling];
+    SeAabbTreeNode& newParentNode = tree->nodes[newParent];
+    const uint32_t oldParent = siblingNode.parent;
+    newParentNode =
+    {
+        .aabb       = se_aabb_union(leafAabb, siblingNode.aabb),
+        .parent     = oldParent,
+        .children   = { sibling, leaf },
+        .height     = siblingNode.height + 1,
+        .userData   = 0,
+    };
+    se_aabb_tree_replace_child(tree, oldParent, sibling, newParent);
+    siblingNode.parent = newParent;
+    tree->nodes[leaf].parent = newParent;
+    // @NOTE : new parent itself is unbalanced if the sibling is higher than one level
+    se_aabb_tree_refit_ancestors(tree, newParent);
+}
+
+void se_aabb_tree_remove_leaf(SeAabbTree* tree, uint32_t leaf)
+{
+    if (leaf == tree->root)
+    {
+        tree->root = SE_AABB_TREE_INVALID;
+        return;
+    }
+    //
+    // Sibling takes place of the parent
+    //
+    const uint32_t parent = tree->nodes[leaf].parent;
+    const SeAabbTreeNode& parentNode = tree->nodes[parent];
+    const uint32_t grandParent = parentNode.parent;
+    const uint32_t sibling = parentNode.children[0] == leaf ? parentNode.children[1] : parentNode.children[0];
+    se_aabb_tree_replace_child(tree, grandParent, parent, sibling);
+    tree->nodes[sibling].parent = grandParent;
+    se_aabb_tree_free_node(tree, parent);
+    se_aabb_tree_refit_ancestors(tree, grandParent);
+}
+
+//
+// Surface area heuristic rebuild
+//
+
+uint32_t se_aabb_tree_build_sah(SeAabbTree* tree, SeAabbTreeBuildLeaf* leaves, size_t numLeaves, size_t depth)
+{
+    if (numLeaves == 1) return leaves[0].proxy;
+
+    SeAabb centroidBounds = { leaves[0].centroid, leaves[0].centroid };
+    for (size_t it = 1; it < numLeaves; it++)
+    {
+        centroidBounds = se_aabb_union(centroidBounds, { leaves[it].centroid, leaves[it].centroid });
+    }
+    const SeFloat3 centroidExtents = centroidBounds.max - centroidBounds.min;
+    const size_t axis = centroidExtents.x > centroidExtents.y
+        ? (centroidExtents.x > centroidExtents.z ? 0 : 2)
+        : (centroidExtents.y > centroidExtents.z ? 1 : 2);
+    const float axisMin = centroidBounds.min.elements[axis];
+    const float axisExtent = centroidExtents.elements[axis];
+
+    size_t splitIndex = numLeaves / 2;
+    if (axisExtent > 0.0f && depth < SE_AABB_TREE_MAX_SAH_DEPTH)
+    {
+        //
+        // Leaves are binned by centroids along the longest axis, split between bins with the lowest
+        // sum of (surface area * number of leaves) of both sides is chosen
+        //
+        struct Bin
+        {
+            SeAabb aabb;
+            size_t numLeaves;
+        } bins[SE_AABB_TREE_SAH_BINS] = { };
+        const float binScale = float(SE_AABB_TREE_SAH_BINS) / axisExtent;
+        auto get_bin = [&](const SeAabbTreeBuildLeaf& leaf) -> size_t
+        {
+            const size_t bin = size_t((leaf.centroid.elements[axis] - axisMin) * binScale);
+            return se_min(bin, SE_AABB_TREE_SAH_BINS - 1);
+        };
+        for (size_t it = 0; it < numLeaves; it++)
+        {
+            Bin& bin = bins[get_bin(leaves[it])];
+            const SeAabb& leafAabb = tree->nodes[leaves[it].proxy].aabb;
+            bin.aabb = bin.numLeaves ? se_aabb_union(bin.aabb, leafAabb) : leafAabb;
+            bin.numLeaves += 1;
+        }
+        float rightCosts[SE_AABB_TREE_SAH_BINS] = { };
+        SeAabb accumulated = { };
+        size_t numAccumulated = 0;
+        for (size_t it = SE_AABB_TREE_SAH_BINS - 1; it > 0; it--)
+        {
+            if (bins[it].numLeaves)
+            {
+                accumulated = numAccumulated ? se_aabb_union(accumulated, bins[it].aabb) : bins[it].aabb;
+                numAccumulated += bins[it].numLeaves;
+            }
+            rightCosts[it] = numAccumulated ? se_aabb_surface_area(accumulated) * float(numAccumulated) : 0.0f;
+        }
+        float bestCost = SE_MAX_FLOAT;
+        size_t bestSplit = 0;
+        numAccumulated = 0;
+        for (size_t it = 0; it < SE_AABB_TREE_SAH_BINS - 1; it++)
+        {
+            if (bins[it].numLeaves)
+            {
+                accumulated = numAccumulated ? se_aabb_union(accumulated, bins[it].aabb) : bins[it].aabb;
+                numAccumulated += bins[it].numLeaves;
+            }
+            if (!numAccumulated || numAccumulated == numLeaves) continue;
+            const float cost = se_aabb_surface_area(accumulated) * float(numAccumulated) + rightCosts[it + 1];
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestSplit = it + 1;
+            }
+        }
+        if (bestSplit)
+        {
+            size_t left = 0;
+            size_t right = numLeaves;
+            while (left < right)
+            {
+                if (get_bin(leaves[left]) < bestSplit)
+                {
+                    left += 1;
+                }
+                else
+                {
+                    right -= 1;
+                    const SeAabbTreeBuildLeaf tmp = leaves[left];
+                    leaves[left] = leaves[right];
+                    leaves[right] = tmp;
+                }
+            }
+            splitIndex = left;
+        }
+    }
+    se_assert(splitIndex > 0 && splitIndex < numLeaves);
+
+    const uint32_t first = se_aabb_tree_build_sah(tree, leaves, splitIndex, depth + 1);
+    const uint32_t second = se_aabb_tree_build_sah(tree, leaves + splitIndex, numLeaves - splitIndex, depth + 1);
+    const uint32_t index = se_aabb_tree_allocate_node(tree);
+    SeAabbTreeNode& node = tree->nodes[index];
+    SeAabbTreeNode& firstNode = tree->nodes[first];
+    SeAabbTreeNode& secondNode = tree->nodes[second];
+    node.aabb = se_aabb_union(firstNode.aabb, secondNode.aabb);
+    node.children[0] = first;
+    node.children[1] = second;
+    node.height = 1 + se_max(firstNode.height, secondNode.height);
+    firstNode.parent = index;
+    secondNode.parent = index;
+    return index;
+}
+
+//
+// Query helpers
+//
+
+// Returns false if the box is outside of the frustum. Clears bits of the planes the box is completely in front of,
+// children of the box don't need to be tested against them
+inline bool se_aabb_tree_frustum_test(const SeFloat4 planes[6], const SeAabb& aabb, uint32_t& planeMask)
+{
+    const SeFloat3 center = (aabb.min + aabb.max) * 0.5f;
+    const SeFloat3 extents = (aabb.max - aabb.min) * 0.5f;
+    for (uint32_t it = 0; it < 6; it++)
+    {
+        if (!(planeMask & (1u << it))) continue;
+        const SeFloat4& plane = planes[it];
+        const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+        const float radius = fabsf(plane.x) * extents.x + fabsf(plane.y) * extents.y + fabsf(plane.z) * extents.z;
+        if ((distance + radius) < 0.0f) return false;
+        if ((distance - radius) >= 0.0f) planeMask &= ~(1u << it);
+    }
+    return true;
+}
+
+inline bool se_aabb_tree_ray_test(const SeFloat3& origin, const SeFloat3& invDirection, float maxDistance, const SeAabb& aabb)
+{
+    const float tx0 = (aabb.min.x - origin.x) * invDirection.x;
+    const float tx1 = (aabb.max.x - origin.x) * invDirection.x;
+    const float ty0 = (aabb.min.y - origin.y) * invDirection.y;
+    const float ty1 = (aabb.max.y - origin.y) * invDirection.y;
+    const float tz0 = (aabb.min.z - origin.z) * invDirection.z;
+    const float tz1 = (aabb.max.z - origin.z) * invDirection.z;
+    const float tEnter = se_max(se_max(se_min(tx0, tx1), se_min(ty0, ty1)), se_max(se_min(tz0, tz1), 0.0f));
+    const float tExit = se_min(se_min(se_max(tx0, tx1), se_max(ty0, ty1)), se_min(se_max(tz0, tz1), maxDistance));
+    return tEnter <= tExit;
+}
+
+inline SeFloat3 se_aabb_tree_inverse_direction(const SeFloat3& direction)
+{
+    // @NOTE : zero components give infinities, slab test handles them
+    return { 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+}
+
+void se_aabb_tree_gather_leaves(const SeAabbTree* tree, uint32_t subtree, SeDynamicArray<uint32_t>& result)
+{
+    uint32_t stack[SE_AABB_TREE_MAX_STACK];
+    size_t stackSize = 0;
+    se_aabb_tree_stack_push(stack, stackSize, subtree);
+    while (stackSize)
+    {
+        const uint32_t index = stack[--stackSize];
+        const SeAabbTreeNode& node = tree->nodes[index];
+        if (se_aabb_tree_is_leaf(node))
+        {
+            se_dynamic_array_push(result, index);
+            continue;
+        }
+        se_aabb_tree_stack_push(stack, stackSize, node.children[1]);
+        se_aabb_tree_stack_push(stack, stackSize, node.children[0]);
+    }
+}
+
+template<typename Test>
+void se_aabb_tree_query(const SeAabbTree* tree, const Test& test, SeDynamicArray<uint32_t>& result)
+{
+    if (tree->root == SE_AABB_TREE_INVALID) return;
+    uint32_t stack[SE_AABB_TREE_MAX_STACK];
+    size_t stackSize = 0;
+    se_aabb_tree_stack_push(stack, stackSize, tree->root);
+    while (stackSize)
+    {
+        const uint32_t index = stack[--stackSize];
+        const SeAabbTreeNode& node = tree->nodes[index];
+        if (!test(node.aabb)) continue;
+        if (se_aabb_tree_is_leaf(node))
+        {
+            se_dynamic_array_push(result, index);
+            continue;
+        }
+        se_aabb_tree_stack_push(stack, stackSize, node.children[1]);
+        se_aabb_tree_stack_push(stack, stackSize, node.children[0]);
+    }
+}
+
+//
+// Every node is fetched once for a batch of queries and tested only against the queries that passed its parent.
+// Hits are collected as (query, proxy) pairs and then sorted by query with a counting sort
+//
+template<typename Test>
+void se_aabb_tree_query_batched(const SeAabbTree* tree, size_t numQueries, const Test& test, SeDynamicArray<uint32_t>& result, SeAabbTreeQueryRange* ranges)
+{
+    const size_t firstResult = se_dynamic_array_size(result);
+    for (size_t it = 0; it < numQueries; it++) ranges[it] = { firstResult, 0 };
+    if (tree->root == SE_AABB_TREE_INVALID || !numQueries) return;
+
+    SeDynamicArray<SeAabbTreeQueryHit> hits = se_dynamic_array_create<SeAabbTreeQueryHit>(se_dynamic_array_allocator(result), 256);
+    SeAabbTreeStackEntry stack[SE_AABB_TREE_MAX_STACK];
+    for (size_t batchIt = 0; batchIt < numQueries; batchIt += SE_AABB_TREE_BATCH_SIZE)
+    {
+        const size_t batchSize = se_min(SE_AABB_TREE_BATCH_SIZE, numQueries - batchIt);
+        const uint32_t batchMask = batchSize == 32 ? UINT32_MAX : (1u << batchSize) - 1;
+        size_t stackSize = 0;
+        se_aabb_tree_stack_push(stack, stackSize, { tree->root, batchMask });
+        while (stackSize)
+        {
+            const SeAabbTreeStackEntry entry = stack[--stackSize];
+            const SeAabbTreeNode& node = tree->nodes[entry.node];
+            uint32_t passed = 0;
+            for (uint32_t queries = entry.mask; queries; queries &= queries - 1)
+            {
+                const uint32_t queryIt = uint32_t(std::countr_zero(queries));
+                if (test(batchIt + queryIt, node.aabb)) passed |= 1u << queryIt;
+            }
+            if (!passed) continue;
+            if (se_aabb_tree_is_leaf(node))
+            {
+                for (uint32_t queries = passed; queries; queries &= queries - 1)
+                {
+                    const size_t query = batchIt + std::countr_zero(queries);
+                    se_dynamic_array_push(hits, { uint32_t(query), entry.node });
+                    ranges[query].count += 1;
+                }
+                continue;
+            }
+            se_aabb_tree_stack_push(stack, stackSize, { node.children[1], passed });
+            se_aabb_tree_stack_push(stack, stackSize, { node.children[0], passed });
+        }
+    }
+
+    size_t first = firstResult;
+    for (size_t it = 0; it < numQueries; it++)
+    {
+        ranges[it].first = first;
+        first += ranges[it].count;
+        ranges[it].count = 0;
+    }
+    se_dynamic_array_force_set_size(result, first);
+    const size_t numHits = se_dynamic_array_size(hits);
+    for (size_t it = 0; it < numHits; it++)
+    {
+        const SeAabbTreeQueryHit& hit = hits[it];
+        SeAabbTreeQueryRange& range = ranges[hit.query];
+        result[range.first + range.count] = hit.proxy;
+        range.count += 1;
+    }
+    se_dynamic_array_destroy(hits);
+}
+
+//
+// Public api
+//
+
+void se_aabb_tree_construct(SeAabbTree* tree, const SeAabbTreeInfo& info)
+{
+    *tree =
+    {
+        .nodes      = se_dynamic_array_create<SeAabbTreeNode>(info.allocator, info.capacity ? info.capacity * 2 : 16),
+        .root       = SE_AABB_TREE_INVALID,
+        .freeList   = SE_AABB_TREE_INVALID,
+        .numProxies = 0,
+        .fatMargin  = info.fatMargin,
+    };
+}
+
+void se_aabb_tree_destroy(SeAabbTree* tree)
+{
+    se_dynamic_array_destroy(tree->nodes);
+}
+
+uint32_t se_aabb_tree_insert(SeAabbTree* tree, const SeAabb& aabb, uint64_t userData)
+{
+    const uint32_t proxy = se_aabb_tree_allocate_node(tree);
+    SeAabbTreeNode& node = tree->nodes[proxy];
+    node.aabb = se_aabb_expanded(aabb, tree->fatMargin);
+    node.userData = userData;
+    se_aabb_tree_insert_leaf(tree, proxy);
+    tree->numProxies += 1;
+    return proxy;
+}
+
+void se_aabb_tree_remove(SeAabbTree* tree, uint32_t proxy)
+{
+    se_assert_msg(tree->nodes[proxy].height == 0, "Aabb tree proxy is invalid");
+    se_aabb_tree_remove_leaf(tree, proxy);
+    se_aabb_tree_free_node(tree, proxy);
+    tree->numProxies -= 1;
+}
+
+bool se_aabb_tree_update(SeAabbTree* tree, uint32_t proxy, const SeAabb& aabb)
+{
+    se_assert_msg(tree->nodes[proxy].height == 0, "Aabb tree proxy is invalid");
+    //
+    // Proxy is reinserted if the object left its fattened box or became much smaller than it
+    //
+    const SeAabb& fatAabb = tree->nodes[proxy].aabb;
+    if (se_aabb_contains(fatAabb, aabb) && se_aabb_contains(se_aabb_expanded(aabb, tree->fatMargin * 4.0f), fatAabb)) return false;
+    se_aabb_tree_remove_leaf(tree, proxy);
+    tree->nodes[proxy].aabb = se_aabb_expanded(aabb, tree->fatMargin);
+    se_aabb_tree_insert_leaf(tree, proxy);
+    return true;
+}
+
+void se_aabb_tree_rebuild_sah(SeAabbTree* tree)
+{
+    if (tree->numProxies < 2) return;
+    //
+    // Leaves keep their indices (so proxy ids stay the same), internal nodes are freed and allocated again by the builder
+    //
+    const SeAllocatorBindings& allocator = se_dynamic_array_allocator(tree->nodes);
+    SeAabbTreeBuildLeaf* const leaves = (SeAabbTreeBuildLeaf*)se_alloc(allocator, sizeof(SeAabbTreeBuildLeaf) * tree->numProxies, se_alloc_tag);
+    size_t numLeaves = 0;
+    const uint32_t numNodes = se_dynamic_array_size<uint32_t>(tree->nodes);
+    for (uint32_t it = 0; it < numNodes; it++)
+    {
+        const SeAabbTreeNode& node = tree->nodes[it];
+        if (node.height < 0) continue;
+        if (se_aabb_tree_is_leaf(node))
+        {
+            se_assert(numLeaves < tree->numProxies);
+            leaves[numLeaves++] = { it, (node.aabb.min + node.aabb.max) * 0.5f };
+        }
+        else
+        {
+            se_aabb_tree_free_node(tree, it);
+        }
+    }
+    se_assert(numLeaves == tree->numProxies);
+    tree->root = se_aabb_tree_build_sah(tree, leaves, numLeaves, 0);
+    tree->nodes[tree->root].parent = SE_AABB_TREE_INVALID;
+    se_dealloc(allocator, leaves, sizeof(SeAabbTreeBuildLeaf) * tree->numProxies);
+}
+
+uint32_t se_aabb_tree_height(const SeAabbTree* tree)
+{
+    return tree->root == SE_AABB_TREE_INVALID ? 0 : uint32_t(tree->nodes[tree->root].height);
+}
+
+float se_aabb_tree_area_ratio(const SeAabbTree* tree)
+{
+    if (tree->root == SE_AABB_TREE_INVALID) return 0.0f;
+    const float rootArea = se_aabb_surface_area(tree->nodes[tree->root].aabb);
+    if (rootArea <= 0.0f) return 0.0f;
+    float totalArea = 0.0f;
+    const size_t numNodes = se_dynamic_array_size(tree->nodes);
+    for (size_t it = 0; it < numNodes; it++)
+    {
+        const SeAabbTreeNode& node = tree->nodes[it];
+        if (node.height > 0) totalArea += se_aabb_surface_area(node.aabb);
+    }
+    return totalArea / rootArea;
+}
+
+void se_aabb_tree_query_frustum(const SeAabbTree* tree, const SeAabbTreeFrustum& frustum, SeDynamicArray<uint32_t>& result)
+{
+    if (tree->root == SE_AABB_TREE_INVALID) return;
+    SeAabbTreeStackEntry stack[SE_AABB_TREE_MAX_STACK];
+    size_t stackSize = 0;
+    se_aabb_tree_stack_push(stack, stackSize, { tree->root, 0x3F });
+    while (stackSize)
+    {
+        const SeAabbTreeStackEntry entry = stack[--stackSize];
+        const SeAabbTreeNode& node = tree->nodes[entry.node];
+        uint32_t planeMask = entry.mask;
+        if (!se_aabb_tree_frustum_test(frustum.planes, node.aabb, planeMask)) continue;
+        if (se_aabb_tree_is_leaf(node))
+        {
+            se_dynamic_array_push(result, entry.node);
+        }
+        else if (!planeMask)
+        {
+            // @NOTE : node is completely inside of the frustum, so all of its leaves are visible
+            se_aabb_tree_gather_leaves(tree, entry.node, result);
+        }
+        else
+        {
+            se_aabb_tree_stack_push(stack, stackSize, { node.children[1], planeMask });
+            se_aabb_tree_stack_push(stack, stackSize, { node.children[0], planeMask });
+        }
+    }
+}
+
+void se_aabb_tree_query_ray(const SeAabbTree* tree, const SeAabbTreeRay& ray, SeDynamicArray<uint32_t>& result)
+{
+    const SeFloat3 invDirection = se_aabb_tree_inverse_direction(ray.direction);
+    se_aabb_tree_query(tree, [&](const SeAabb& aabb) { return se_aabb_tree_ray_test(ray.origin, invDirection, ray.maxDistance, aabb); }, result);
+}
+
+void se_aabb_tree_query_overlap(const SeAabbTree* tree, const SeAabb& aabb, SeDynamicArray<uint32_t>& result)
+{
+    se_aabb_tree_query(tree, [&](const SeAabb& nodeAabb) { return se_aabb_overlaps(nodeAabb, aabb); }, result);
+}
+
+void se_aabb_tree_query_frustums(const SeAabbTree* tree, const SeAabbTreeFrustum* frustums, size_t numQueries, SeDynamicArray<uint32_t>& result, SeAabbTreeQueryRange* ranges)
+{
+    se_aabb_tree_query_batched(tree, numQueries, [&](size_t query, const SeAabb& aabb)
+    {
+        uint32_t planeMask = 0x3F;
+        return se_aabb_tree_frustum_test(frustums[query].planes, aabb, planeMask);
+    }, result, ranges);
+}
+
+void se_aabb_tree_query_rays(const SeAabbTree* tree, const SeAabbTreeRay* rays, size_t numQueries, SeDynamicArray<uint32_t>& result, SeAabbTreeQueryRange* ranges)
+{
+    SeDynamicArray<SeFloat3> invDirections = se_dynamic_array_create<SeFloat3>(se_dynamic_array_allocator(result), numQueries ? numQueries : 1);
+    for (size_t it = 0; it < numQueries; it++) se_dynamic_array_push(invDirections, se_aabb_tree_inverse_direction(rays[it].direction));
+    se_aabb_tree_query_batched(tree, numQueries, [&](size_t query, const SeAabb& aabb)
+    {
+        return se_aabb_tree_ray_test(rays[query].origin, invDirections[query], rays[query].maxDistance, aabb);
+    }, result, ranges);
+    se_dynamic_array_destroy(invDirections);
+}
+
+void se_aabb_tree_query_overlaps(const SeAabbTree* tree, const SeAabb* aabbs, size_t numQueries, SeDynamicArray<uint32_t>& result, SeAabbTreeQueryRange* ranges)
+{
+    se_aabb_tree_query_batched(tree, numQueries, [&](size_t query, const SeAabb& aabb) { return se_aabb_overlaps(aabb, aabbs[query]); }, result, ranges);
+}
@@ -0,0 +1,101 @@
+#ifndef _SE_AABB_TREE_HPP_
+#define _SE_AABB_TREE_HPP_
+
+#include "engine/se_common_includes.hpp"
+#include "engine/se_allocator_bindings.hpp"
+#include "engine/se_math.hpp"
+#include "engine/se_containers.hpp"
+
+//
+// Dynamic bounding volume hierarchy (aabb tree) for visibility, picking and proximity queries.
+//
+// Every object is a leaf (proxy) that stores a bounding box fattened by SeAabbTreeInfo::fatMargin and 64 bits of user data.
+// Leaves are inserted next to the sibling with the lowest surface area cost and the tree is kept balanced with rotations
+// on the way back to the root, so insert, remove and update are O(log n). Update reinserts a leaf only when the new box
+// leaves the fattened one, so objects that move a little don't touch the tree at all.
+//
+// Proxy ids are indices of leaf nodes, they stay valid until the proxy is removed (rebuild doesn't change them).
+// Trees of static content can be rebuilt with the binned surface area heuristic, which gives cheaper queries than
+// incremental inserts.
+//
+// Queries append ids of proxies with fattened boxes that pass the test to the result array (order is unspecified).
+// Batched versions traverse the tree once for up to 32 queries at a time and return the range of the result array
+// for every query.
+//
+
+constexpr uint32_t SE_AABB_TREE_INVALID = UINT32_MAX;
+
+struct SeAabbTreeNode
+{
+    SeAabb      aabb;
+    uint32_t    parent;         // next node of the free list for free nodes
+    uint32_t    children[2];    // SE_AABB_TREE_INVALID for leaves
+    int32_t     height;         // 0 for leaves, -1 for free nodes
+    uint64_t    userData;
+};
+
+struct SeAabbTree
+{
+    SeDynamicArray<SeAabbTreeNode>  nodes;
+    uint32_t                        root;
+    uint32_t                        freeList;
+    size_t                          numProxies;
+    float                           fatMargin;
+};
+
+struct SeAabbTreeInfo
+{
+    SeAllocatorBindings allocator;
+    size_t              capacity;   // expected number of proxies
+    float               fatMargin;
+};
+
+struct SeAabbTreeRay
+{
+    SeFloat3    origin;
+    SeFloat3    direction;  // doesn't need to be normalized, maxDistance is measured in direction lengths
+    float       maxDistance;
+};
+
+struct SeAabbTreeFrustum
+{
+    SeFloat4 planes[6];     // see se_float4x4_get_frustum_planes
+};
+
+struct SeAabbTreeQueryRange
+{
+    size_t first;
+    size_t count;
+};
+
+void        se_aabb_tree_construct(SeAabbTree* tree, const SeAabbTreeInfo& info);
+void        se_aabb_tree_destroy(SeAabbTree* tree);
+
+uint32_t    se_aabb_tree_insert(SeAabbTree* tree, const SeAabb& aabb, uint64_t userData);
+void        se_aabb_tree_remove(SeAabbTree* tree, uint32_t proxy);
+// Returns true if the proxy was reinserted
+bool        se_aabb_tree_update(SeAabbTree* tree, uint32_t proxy, const SeAabb& aabb);
+void        se_aabb_tree_rebuild_sah(SeAabbTree* tree);
+
+uint32_t    se_aabb_tree_height(const SeAabbTree* tree);
+float       se_aabb_tree_area_ratio(const SeAabbTree* tree);
+
+void        se_aabb_tree_query_frustum(const SeAabbTree* tree, const SeAabbTreeFrustum& frustum, SeDynamicArray<uint32_t>& result);
+void        se_aabb_tree_query_ray(const SeAabbTree* tree, const SeAabbTreeRay& ray, SeDynamicArray<uint32_t>& result);
+void        se_aabb_tree_query_overlap(const SeAabbTree* tree, const SeAabb& aabb, SeDynamicArray<uint32_t>& result);
+
+void        se_aabb_tree_query_frustums(const SeAabbTree* tree, const SeAabbTreeFrustum* frustums, size_t numQueries, SeDynamicArray<uint32_t>& result, SeAabbTreeQueryRange* ranges);
+void        se_aabb_tree_query_rays(const SeAabbTree* tree, const SeAabbTreeRay* rays, size_t numQueries, SeDynamicArray<uint32_t>& result, SeAabbTreeQueryRange* ranges);
+void        se_aabb_tree_query_overlaps(const SeAabbTree* tree, const SeAabb* aabbs, size_t numQueries, SeDynamicArray<uint32_t>& result, SeAabbTreeQueryRange* ranges);
+
+inline const SeAabb& se_aabb_tree_fat_aabb(const SeAabbTree* tree, uint32_t proxy)
+{
+    return tree->nodes[proxy].aabb;
+}
+
+inline uint64_t se_aabb_tree_user_data(const SeAabbTree* tree, uint32_t proxy)
+{
+    return tree->nodes[proxy].userData;
+}
+
+#endif
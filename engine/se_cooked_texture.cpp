@@ -0,0 +1,192 @@
+
+#include "se_cooked_texture.hpp"
+#include "se_texture_compression.hpp"
+#include "engine/se_math.hpp"
+#include "engine/subsystems/se_debug.hpp"
+
+#define se_cooked_texture_align(value) ((((value) + SE_COOKED_TEXTURE_DATA_ALIGNMENT - 1) / SE_COOKED_TEXTURE_DATA_ALIGNMENT) * SE_COOKED_TEXTURE_DATA_ALIGNMENT)
+
+bool se_cooked_texture_is_supported_format(SeTextureFormat format)
+{
+    switch (format)
+    {
+        case SeTextureFormat::R_8_UNORM:
+        case SeTextureFormat::R_8_SRGB:
+        case SeTextureFormat::RGBA_8_UNORM:
+        case SeTextureFormat::RGBA_8_SRGB:
+            return true;
+        default:
+            return se_texture_compression_is_compressed(format);
+    }
+}
+
+size_t se_cooked_texture_get_mip_size(SeTextureFormat format, uint32_t width, uint32_t height)
+{
+    switch (format)
+    {
+        case SeTextureFormat::R_8_UNORM:
+        case SeTextureFormat::R_8_SRGB:
+            return size_t(width) * height;
+        case SeTextureFormat::RGBA_8_UNORM:
+        case SeTextureFormat::RGBA_8_SRGB:
+            return size_t(width) * height * 4;
+        default:
+            se_assert_msg(se_texture_compression_is_compressed(format), "Unsupported cooked texture format");
+            return se_texture_compression_get_size(format, width, height);
+    }
+}
+
+void se_cooked_texture_downsample(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight)
+{
+    for (uint32_t y = 0; y < dstHeight; y++)
+        for (uint32_t x = 0; x < dstWidth; x++)
+        {
+            const uint32_t srcX0 = se_min(x * 2, srcWidth - 1);
+            const uint32_t srcX1 = se_min(x * 2 + 1, srcWidth - 1);
+            const uint32_t srcY0 = se_min(y * 2, srcHeight - 1);
+            const uint32_t srcY1 = se_min(y * 2 + 1, srcHeight - 1);
+            for (size_t channel = 0; channel < 4; channel++)
+            {
+                const uint32_t sum =
+                    src[(srcY0 * srcWidth + srcX0) * 4 + channel] +
+                    src[(srcY0 * srcWidth + srcX1) * 4 + channel] +
+                    src[(srcY1 * srcWidth + srcX0) * 4 + channel] +
+                    src[(srcY1 * srcWidth + srcX1) * 4 + channel];
+                dst[(y * dstWidth + x) * 4 + channel] = uint8_t((sum + 2) / 4);
+            }
+        }
+}
+
+void se_cooked_texture_write_mip(SeTextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* result)
+{
+    switch (format)
+    {
+        case SeTextureFormat::R_8_UNORM:
+        case SeTextureFormat::R_8_SRGB:
+        {
+            for (size_t it = 0; it < size_t(width) * height; it++) result[it] = rgba[it * 4];
+        } break;
+        case SeTextureFormat::RGBA_8_UNORM:
+        case SeTextureFormat::RGBA_8_SRGB:
+        {
+            memcpy(result, rgba, size_t(width) * height * 4);
+        } break;
+        default:
+        {
+            se_texture_compression_encode(format, rgba, width, height, result);
+        } break;
+    }
+}
+
+bool se_cooked_texture_is_valid(const void* data, size_t dataSize)
+{
+    if (!data || dataSize < sizeof(SeCookedTextureHeader)) return false;
+    const SeCookedTextureHeader* const header = (const SeCookedTextureHeader*)data;
+    if (header->magic != SE_COOKED_TEXTURE_MAGIC) return false;
+    if (header->version != SE_COOKED_TEXTURE_VERSION) return false;
+    if (!se_cooked_texture_is_supported_format(header->format)) return false;
+    if (header->width == 0 || header->height == 0 || header->numLayers == 0 || header->depth == 0) return false;
+    //
+    // Mip chain can't be longer than the full chain of the top level extent
+    //
+    uint32_t maxNumMips = 1;
+    for (uint32_t dim = se_max(se_max(header->width, header->height), header->depth); dim > 1; dim /= 2) maxNumMips++;
+    if (header->numMips == 0 || header->numMips > se_min(maxNumMips, uint32_t(SE_COOKED_TEXTURE_MAX_MIPS))) return false;
+    //
+    // Every mip must have the extent of a regular mip chain and exactly as many bytes as its format requires
+    // (block compressed mips are rounded up to whole blocks). Mip regions must lie after the header and inside the file
+    //
+    for (uint32_t it = 0; it < header->numMips; it++)
+    {
+        const SeCookedTextureMip& mip = header->mips[it];
+        const uint32_t mipWidth = se_max(header->width >> it, 1u);
+        const uint32_t mipHeight = se_max(header->height >> it, 1u);
+        const uint32_t mipDepth = se_max(header->depth >> it, 1u);
+        if (mip.width != mipWidth || mip.height != mipHeight) return false;
+        const size_t expectedSize = se_cooked_texture_get_mip_size(header->format, mipWidth, mipHeight) * mipDepth * header->numLayers;
+        if (mip.size != expectedSize) return false;
+        if ((mip.offset % SE_COOKED_TEXTURE_DATA_ALIGNMENT) != 0) return false;
+        if (mip.offset < sizeof(SeCookedTextureHeader)) return false;
+        if (mip.offset > dataSize || mip.size > dataSize - mip.offset) return false;
+    }
+    return true;
+}
+
+const SeCookedTextureHeader* se_cooked_texture_get_header(const void* data)
+{
+    return (const SeCookedTextureHeader*)data;
+}
+
+SeCookedTexture se_cooked_texture_cook(const SeCookedTextureInfo& info, const SeAllocatorBindings& bindings)
+{
+    se_assert(info.rgba && info.width > 0 && info.height > 0);
+    //
+    // Calculate mip chain layout
+    //
+    SeCookedTextureHeader header
+    {
+        .magic      = SE_COOKED_TEXTURE_MAGIC,
+        .version    = SE_COOKED_TEXTURE_VERSION,
+        .format     = info.format,
+        .width      = info.width,
+        .height     = info.height,
+        .depth      = 1,
+        .numLayers  = 1,
+        .numMips    = 0,
+        .mips       = { },
+    };
+    size_t dataSize = se_cooked_texture_align(sizeof(SeCookedTextureHeader));
+    {
+        uint32_t mipWidth = info.width;
+        uint32_t mipHeight = info.height;
+        while (true)
+        {
+            se_assert(header.numMips < SE_COOKED_TEXTURE_MAX_MIPS);
+            const size_t mipSize = se_cooked_texture_get_mip_size(info.format, mipWidth, mipHeight);
+            header.mips[header.numMips++] = { dataSize, mipSize, mipWidth, mipHeight };
+            dataSize += se_cooked_texture_align(mipSize);
+            if (!info.generateMips || (mipWidth == 1 && mipHeight == 1)) break;
+            mipWidth = se_max(mipWidth / 2, 1u);
+            mipHeight = se_max(mipHeight / 2, 1u);
+        }
+    }
+    uint8_t* const data = (uint8_t*)se_alloc(bindings, dataSize, se_alloc_tag);
+    memset(data, 0, dataSize);
+    memcpy(data, &header, sizeof(SeCookedTextureHeader));
+    //
+    // Generate and encode mips. Every mip is downsampled from the previous one
+    //
+    const uint8_t* source = info.rgba;
+    uint8_t* sourceAllocation = nullptr;
+    size_t sourceAllocationSize = 0;
+    for (uint32_t it = 0; it < header.numMips; it++)
+    {
+        const SeCookedTextureMip& mip = header.mips[it];
+        if (it > 0)
+        {
+            const SeCookedTextureMip& prevMip = header.mips[it - 1];
+            const size_t downsampledSize = size_t(mip.width) * mip.height * 4;
+            uint8_t* const downsampled = (uint8_t*)se_alloc(bindings, downsampledSize, se_alloc_tag);
+            se_cooked_texture_downsample(source, prevMip.width, prevMip.height, downsampled, mip.width, mip.height);
+            if (sourceAllocation) se_dealloc(bindings, sourceAllocation, sourceAllocationSize);
+            sourceAllocation = downsampled;
+            sourceAllocationSize = downsampledSize;
+            source = downsampled;
+        }
+        se_cooked_texture_write_mip(info.format, source, mip.width, mip.height, data + mip.offset);
+    }
+    if (sourceAllocation) se_dealloc(bindings, sourceAllocation, sourceAllocationSize);
+    return
+    {
+        bindings,
+        data,
+        dataSize,
+    };
+}
+
+void se_cooked_texture_free(SeCookedTexture& texture)
+{
+    if (!texture.data) return;
+    se_dealloc(texture.bindings, texture.data, texture.dataSize);
+    texture = { };
+}
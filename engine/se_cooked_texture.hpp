@@ -0,0 +1,65 @@
+#ifndef _SE_COOKED_TEXTURE_HPP_
+#define _SE_COOKED_TEXTURE_HPP_
+
+#include "engine/se_common_includes.hpp"
+#include "engine/se_allocator_bindings.hpp"
+#include "engine/render/se_render.hpp"
+
+//
+// Cooked texture is a ready-to-upload texture file.
+//
+// File starts with SeCookedTextureHeader, followed by data of every mip (starting from the biggest one).
+// Mip data is already in the final gpu format (block compressed or not), so runtime loading is just
+// "map file -> copy mip regions to staging memory". Each mip region stores all array layers one after another.
+// Mip regions are aligned to SE_COOKED_TEXTURE_DATA_ALIGNMENT bytes.
+//
+
+constexpr uint32_t  SE_COOKED_TEXTURE_MAGIC             = 0x58544553; // "SETX"
+constexpr uint32_t  SE_COOKED_TEXTURE_VERSION           = 1;
+constexpr size_t    SE_COOKED_TEXTURE_MAX_MIPS          = 16;
+constexpr size_t    SE_COOKED_TEXTURE_DATA_ALIGNMENT    = 16;
+
+struct SeCookedTextureMip
+{
+    uint64_t offset; // From the beginning of the file
+    uint64_t size;
+    uint32_t width;
+    uint32_t height;
+};
+
+struct SeCookedTextureHeader
+{
+    uint32_t            magic;
+    uint32_t            version;
+    SeTextureFormat     format;
+    uint32_t            width;
+    uint32_t            height;
+    uint32_t            depth;
+    uint32_t            numLayers;
+    uint32_t            numMips;
+    SeCookedTextureMip  mips[SE_COOKED_TEXTURE_MAX_MIPS];
+};
+
+struct SeCookedTextureInfo
+{
+    SeTextureFormat format;         // Uncompressed RGBA formats or any block compressed format
+    const uint8_t*  rgba;           // Tightly packed RGBA8 source texels
+    uint32_t        width;
+    uint32_t        height;
+    bool            generateMips;   // Full mip chain is generated with 2x2 box filter
+};
+
+struct SeCookedTexture
+{
+    SeAllocatorBindings bindings;
+    void*               data;
+    size_t              dataSize;
+};
+
+bool                            se_cooked_texture_is_valid(const void* data, size_t dataSize);
+const SeCookedTextureHeader*    se_cooked_texture_get_header(const void* data);
+
+SeCookedTexture                 se_cooked_texture_cook(const SeCookedTextureInfo& info, const SeAllocatorBindings& bindings);
+void                            se_cooked_texture_free(SeCookedTexture& texture);
+
+#endif
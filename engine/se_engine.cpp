@@ -90,3 +90,7 @@ void se_engine_stop()
 #include "engine/subsystems/se_ui.cpp"
 
 #include "engine/se_data_providers.cpp"
+#include "engine/se_texture_compression.cpp"
+#include "engine/se_cooked_texture.cpp"
+#include "engine/se_frustum_culling.cpp"
+#include "engine/se_aabb_tree.cpp"
@@ -9,6 +9,10 @@
 #include "engine/se_containers.hpp"
 #include "engine/se_data_providers.hpp"
 #include "engine/se_unicode.hpp"
+#include "engine/se_texture_compression.hpp"
+#include "engine/se_cooked_texture.hpp"
+#include "engine/se_frustum_culling.hpp"
+#include "engine/se_aabb_tree.hpp"
 
 #include "engine/render/se_render.hpp"
 #include "engine/subsystems/se_platform.hpp"
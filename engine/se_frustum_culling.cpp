@@ -0,0 +1,131 @@
+
+#include "se_frustum_culling.hpp"
+
+#include <math.h>
+#include <xmmintrin.h>
+
+//
+// Box is tested as center and extents. For every transform :
+//   center in the transform's destination space : row_i(trf) * (center, 1)
+//   extents in the transform's destination space : |row_i(trf).xyz| * extents
+//   box is outside of the plane if dot(plane.xyz, center) + plane.w + dot(|plane.xyz|, extents) < 0
+// Both paths evaluate these expressions in the same order
+//
+
+#define se_frustum_transform_at(transforms, stride, index) ((const SeFloat4x4*)((const uint8_t*)(transforms) + (stride) * (index)))
+
+size_t se_frustum_cull_scalar(const SeFloat4 planes[6], const SeAabb& aabb, const void* transforms, size_t stride, size_t numTransforms, uint32_t* visibleIndices)
+{
+    const SeFloat3 center = (aabb.min + aabb.max) * 0.5f;
+    const SeFloat3 extents = (aabb.max - aabb.min) * 0.5f;
+    size_t numVisible = 0;
+    for (size_t trfIt = 0; trfIt < numTransforms; trfIt++)
+    {
+        const SeFloat4x4& trf = *se_frustum_transform_at(transforms, stride, trfIt);
+        float trfCenter[3];
+        float trfExtents[3];
+        for (size_t it = 0; it < 3; it++)
+        {
+            const float* const row = trf.m[it];
+            trfCenter[it] = row[0] * center.x + row[1] * center.y + row[2] * center.z + row[3];
+            trfExtents[it] = fabsf(row[0]) * extents.x + fabsf(row[1]) * extents.y + fabsf(row[2]) * extents.z;
+        }
+        bool isVisible = true;
+        for (size_t planeIt = 0; planeIt < 6; planeIt++)
+        {
+            const SeFloat4& plane = planes[planeIt];
+            const float distance = plane.x * trfCenter[0] + plane.y * trfCenter[1] + plane.z * trfCenter[2] + plane.w;
+            const float radius = fabsf(plane.x) * trfExtents[0] + fabsf(plane.y) * trfExtents[1] + fabsf(plane.z) * trfExtents[2];
+            if ((distance + radius) < 0.0f) isVisible = false;
+        }
+        if (isVisible) visibleIndices[numVisible++] = uint32_t(trfIt);
+    }
+    return numVisible;
+}
+
+size_t se_frustum_cull(const SeFloat4 planes[6], const SeAabb& aabb, const void* transforms, size_t stride, size_t numTransforms, uint32_t* visibleIndices)
+{
+    const SeFloat3 center = (aabb.min + aabb.max) * 0.5f;
+    const SeFloat3 extents = (aabb.max - aabb.min) * 0.5f;
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 centerX = _mm_set1_ps(center.x);
+    const __m128 centerY = _mm_set1_ps(center.y);
+    const __m128 centerZ = _mm_set1_ps(center.z);
+    const __m128 extentsX = _mm_set1_ps(extents.x);
+    const __m128 extentsY = _mm_set1_ps(extents.y);
+    const __m128 extentsZ = _mm_set1_ps(extents.z);
+    //
+    // Planes and their absolute values are splatted once, they are the same for every batch
+    //
+    __m128 planeX[6];
+    __m128 planeY[6];
+    __m128 planeZ[6];
+    __m128 planeW[6];
+    __m128 absPlaneX[6];
+    __m128 absPlaneY[6];
+    __m128 absPlaneZ[6];
+    for (size_t planeIt = 0; planeIt < 6; planeIt++)
+    {
+        planeX[planeIt] = _mm_set1_ps(planes[planeIt].x);
+        planeY[planeIt] = _mm_set1_ps(planes[planeIt].y);
+        planeZ[planeIt] = _mm_set1_ps(planes[planeIt].z);
+        planeW[planeIt] = _mm_set1_ps(planes[planeIt].w);
+        absPlaneX[planeIt] = _mm_andnot_ps(signMask, planeX[planeIt]);
+        absPlaneY[planeIt] = _mm_andnot_ps(signMask, planeY[planeIt]);
+        absPlaneZ[planeIt] = _mm_andnot_ps(signMask, planeZ[planeIt]);
+    }
+    size_t numVisible = 0;
+    const size_t numBatched = numTransforms & ~size_t(3);
+    for (size_t trfIt = 0; trfIt < numBatched; trfIt += 4)
+    {
+        const SeFloat4x4* const trf0 = se_frustum_transform_at(transforms, stride, trfIt + 0);
+        const SeFloat4x4* const trf1 = se_frustum_transform_at(transforms, stride, trfIt + 1);
+        const SeFloat4x4* const trf2 = se_frustum_transform_at(transforms, stride, trfIt + 2);
+        const SeFloat4x4* const trf3 = se_frustum_transform_at(transforms, stride, trfIt + 3);
+        //
+        // After the transpose m<row><column> holds element of the row and column for four transforms
+        //
+        __m128 trfCenter[3];
+        __m128 trfExtents[3];
+        for (size_t rowIt = 0; rowIt < 3; rowIt++)
+        {
+            __m128 m0 = _mm_loadu_ps(trf0->m[rowIt]);
+            __m128 m1 = _mm_loadu_ps(trf1->m[rowIt]);
+            __m128 m2 = _mm_loadu_ps(trf2->m[rowIt]);
+            __m128 m3 = _mm_loadu_ps(trf3->m[rowIt]);
+            _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+            trfCenter[rowIt] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, centerX), _mm_mul_ps(m1, centerY)), _mm_mul_ps(m2, centerZ)), m3);
+            trfExtents[rowIt] = _mm_add_ps
+            (
+                _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, m0), extentsX), _mm_mul_ps(_mm_andnot_ps(signMask, m1), extentsY)),
+                _mm_mul_ps(_mm_andnot_ps(signMask, m2), extentsZ)
+            );
+        }
+        __m128 isOutside = zero;
+        for (size_t planeIt = 0; planeIt < 6; planeIt++)
+        {
+            const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[planeIt], trfCenter[0]), _mm_mul_ps(planeY[planeIt], trfCenter[1])), _mm_mul_ps(planeZ[planeIt], trfCenter[2])), planeW[planeIt]);
+            const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absPlaneX[planeIt], trfExtents[0]), _mm_mul_ps(absPlaneY[planeIt], trfExtents[1])), _mm_mul_ps(absPlaneZ[planeIt], trfExtents[2]));
+            isOutside = _mm_or_ps(isOutside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+        }
+        const int visibleMask = ~_mm_movemask_ps(isOutside) & 0xF;
+        // @NOTE : branchless compaction, index is always written but counter advances only for visible transforms
+        visibleIndices[numVisible] = uint32_t(trfIt + 0); numVisible += (visibleMask >> 0) & 1;
+        visibleIndices[numVisible] = uint32_t(trfIt + 1); numVisible += (visibleMask >> 1) & 1;
+        visibleIndices[numVisible] = uint32_t(trfIt + 2); numVisible += (visibleMask >> 2) & 1;
+        visibleIndices[numVisible] = uint32_t(trfIt + 3); numVisible += (visibleMask >> 3) & 1;
+    }
+    //
+    // Remaining transforms
+    //
+    const size_t numRemaining = numTransforms - numBatched;
+    if (numRemaining)
+    {
+        const void* const remaining = se_frustum_transform_at(transforms, stride, numBatched);
+        const size_t numRemainingVisible = se_frustum_cull_scalar(planes, aabb, remaining, stride, numRemaining, visibleIndices + numVisible);
+        for (size_t it = 0; it < numRemainingVisible; it++) visibleIndices[numVisible + it] += uint32_t(numBatched);
+        numVisible += numRemainingVisible;
+    }
+    return numVisible;
+}
@@ -0,0 +1,24 @@
+#ifndef _SE_FRUSTUM_CULLING_HPP_
+#define _SE_FRUSTUM_CULLING_HPP_
+
+#include "engine/se_common_includes.hpp"
+#include "engine/se_math.hpp"
+
+//
+// Cpu frustum culling of instanced bounding boxes.
+//
+// Every function tests a single box (in the space the transforms map from) transformed by each of the transforms against
+// frustum planes (see se_float4x4_get_frustum_planes) and writes indices of visible transforms to visibleIndices, which
+// must have space for numTransforms indices. Number of visible transforms is returned.
+//
+// Transforms are affine matrices (the last row is ignored) stored with the given stride, so arrays of structures
+// that begin with a transform (like SeMeshInstanceData) can be culled in place.
+//
+// Default path is SSE (four transforms at a time, structure of arrays layout is built with a transpose of the matrix rows),
+// scalar path produces exactly the same results and is kept for reference and benchmarking.
+//
+
+size_t se_frustum_cull(const SeFloat4 planes[6], const SeAabb& aabb, const void* transforms, size_t stride, size_t numTransforms, uint32_t* visibleIndices);
+size_t se_frustum_cull_scalar(const SeFloat4 planes[6], const SeAabb& aabb, const void* transforms, size_t stride, size_t numTransforms, uint32_t* visibleIndices);
+
+#endif
@@ -162,6 +162,12 @@ const SeFloat4x4 SE_F4X4_IDENTITY =
     0, 0, 0, 1
 };
 
+struct SeAabb
+{
+    SeFloat3 min;
+    SeFloat3 max;
+};
+
 inline float    se_float2_dot(SeFloat2 first, SeFloat2 second)  { return first.x * second.x + first.y * second.y; }
 inline SeFloat2 se_float2_add(SeFloat2 first, SeFloat2 second)  { return { first.x + second.x, first.y + second.y }; }
 inline SeFloat2 se_float2_sub(SeFloat2 first, SeFloat2 second)  { return { first.x - second.x, first.y - second.y }; }
@@ -747,6 +753,73 @@ SeFloat4x4 se_float4x4_look_at(const SeFloat3& from, const SeFloat3& to, const S
     return rotation;
 }
 
+//
+// Axis aligned bounding box of the box transformed by the affine matrix (extents are transformed by the absolute matrix)
+//
+inline SeAabb se_aabb_transformed(const SeAabb& aabb, const SeFloat4x4& trf)
+{
+    const SeFloat3 center = (aabb.min + aabb.max) * 0.5f;
+    const SeFloat3 extents = (aabb.max - aabb.min) * 0.5f;
+    SeFloat3 resultCenter;
+    SeFloat3 resultExtents;
+    for (size_t it = 0; it < 3; it++)
+    {
+        const float* const row = trf.m[it];
+        resultCenter.elements[it] = row[0] * center.x + row[1] * center.y + row[2] * center.z + row[3];
+        resultExtents.elements[it] = fabsf(row[0]) * extents.x + fabsf(row[1]) * extents.y + fabsf(row[2]) * extents.z;
+    }
+    return { resultCenter - resultExtents, resultCenter + resultExtents };
+}
+
+inline SeAabb se_aabb_union(const SeAabb& first, const SeAabb& second)
+{
+    return
+    {
+        { se_min(first.min.x, second.min.x), se_min(first.min.y, second.min.y), se_min(first.min.z, second.min.z) },
+        { se_max(first.max.x, second.max.x), se_max(first.max.y, second.max.y), se_max(first.max.z, second.max.z) },
+    };
+}
+
+inline SeAabb se_aabb_expanded(const SeAabb& aabb, float value)
+{
+    return { aabb.min - SeFloat3{ value, value, value }, aabb.max + SeFloat3{ value, value, value } };
+}
+
+inline float se_aabb_surface_area(const SeAabb& aabb)
+{
+    const SeFloat3 size = aabb.max - aabb.min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+inline bool se_aabb_contains(const SeAabb& outer, const SeAabb& inner)
+{
+    return
+        outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+        outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+inline bool se_aabb_overlaps(const SeAabb& first, const SeAabb& second)
+{
+    return
+        first.min.x <= second.max.x && first.min.y <= second.max.y && first.min.z <= second.max.z &&
+        first.max.x >= second.min.x && first.max.y >= second.min.y && first.max.z >= second.min.z;
+}
+
+//
+// Extracts frustum planes from the view projection matrix (xyz - normal, w - distance). Normals point inside the frustum
+// and aren't normalized. Expects [0, 1] clip space depth range, so works both for regular and reverse depth
+//
+inline void se_float4x4_get_frustum_planes(const SeFloat4x4& viewProjection, SeFloat4 planes[6])
+{
+    const SeFloat4* const rows = viewProjection.rows;
+    planes[0] = se_float4_add(rows[3], rows[0]);
+    planes[1] = se_float4_sub(rows[3], rows[0]);
+    planes[2] = se_float4_add(rows[3], rows[1]);
+    planes[3] = se_float4_sub(rows[3], rows[1]);
+    planes[4] = rows[2];
+    planes[5] = se_float4_sub(rows[3], rows[2]);
+}
+
 inline SeFloat4x4   operator * (const SeFloat4x4& first, const SeFloat4x4& second)  { return se_float4x4_mul(first, second); }
 inline SeFloat4x4   operator * (const SeFloat4x4& mat, float value)                 { return se_float4x4_mul(mat, value); }
 inline SeFloat4     operator * (const SeFloat4x4& mat, const SeFloat4& value)       { return se_float4x4_mul(mat, value); }
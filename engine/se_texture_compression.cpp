@@ -0,0 +1,912 @@
+
+#include "se_texture_compression.hpp"
+#include "engine/se_math.hpp"
+#include "engine/subsystems/se_debug.hpp"
+
+#include <math.h>
+#include <emmintrin.h>
+
+//
+// All encoders work in the same way:
+// 1. Find the principal axis of the block texels
+// 2. Project texels on the axis to get initial endpoints
+// 3. Quantize endpoints, assign indices and refine endpoints with least squares fit
+//
+// Index assignment is done with SSE (four texels at a time)
+//
+
+constexpr size_t SE_TEXTURE_COMPRESSION_BLOCK_DIM = 4;
+constexpr size_t SE_TEXTURE_COMPRESSION_BLOCK_TEXELS = 16;
+constexpr size_t SE_TEXTURE_COMPRESSION_REFINE_ITERATIONS = 2;
+constexpr size_t SE_TEXTURE_COMPRESSION_POWER_ITERATIONS = 8;
+
+struct SeTextureCompressionBlock
+{
+    // Selected channels of texels in 0..255 range. Unused channels are zero
+    float texels[SE_TEXTURE_COMPRESSION_BLOCK_TEXELS][4];
+};
+
+struct SeTextureCompressionBits
+{
+    uint8_t*    data;
+    size_t      position;
+};
+
+inline void se_texture_compression_bits_write(SeTextureCompressionBits& bits, uint32_t value, size_t numBits)
+{
+    for (size_t it = 0; it < numBits; it++)
+    {
+        bits.data[bits.position >> 3] |= uint8_t(((value >> it) & 1) << (bits.position & 7));
+        bits.position += 1;
+    }
+}
+
+inline uint32_t se_texture_compression_bits_read(SeTextureCompressionBits& bits, size_t numBits)
+{
+    uint32_t value = 0;
+    for (size_t it = 0; it < numBits; it++)
+    {
+        value |= uint32_t((bits.data[bits.position >> 3] >> (bits.position & 7)) & 1) << it;
+        bits.position += 1;
+    }
+    return value;
+}
+
+inline float se_texture_compression_clamp(float value, float min, float max)
+{
+    return value < min ? min : (value > max ? max : value);
+}
+
+void se_texture_compression_load_block(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, size_t firstChannel, size_t numChannels, SeTextureCompressionBlock* block)
+{
+    //
+    // Texels outside of the image are replaced with the closest edge texels
+    //
+    *block = { };
+    for (size_t y = 0; y < SE_TEXTURE_COMPRESSION_BLOCK_DIM; y++)
+        for (size_t x = 0; x < SE_TEXTURE_COMPRESSION_BLOCK_DIM; x++)
+        {
+            const size_t texelX = se_min(blockX * SE_TEXTURE_COMPRESSION_BLOCK_DIM + x, size_t(width - 1));
+            const size_t texelY = se_min(blockY * SE_TEXTURE_COMPRESSION_BLOCK_DIM + y, size_t(height - 1));
+            const uint8_t* const texel = rgba + (texelY * width + texelX) * 4;
+            for (size_t channel = 0; channel < numChannels; channel++)
+            {
+                block->texels[y * SE_TEXTURE_COMPRESSION_BLOCK_DIM + x][channel] = float(texel[firstChannel + channel]);
+            }
+        }
+}
+
+void se_texture_compression_store_block(const uint8_t decoded[SE_TEXTURE_COMPRESSION_BLOCK_TEXELS][4], uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t* rgba)
+{
+    for (size_t y = 0; y < SE_TEXTURE_COMPRESSION_BLOCK_DIM; y++)
+        for (size_t x = 0; x < SE_TEXTURE_COMPRESSION_BLOCK_DIM; x++)
+        {
+            const size_t texelX = blockX * SE_TEXTURE_COMPRESSION_BLOCK_DIM + x;
+            const size_t texelY = blockY * SE_TEXTURE_COMPRESSION_BLOCK_DIM + y;
+            if (texelX >= width || texelY >= height) continue;
+            memcpy(rgba + (texelY * width + texelX) * 4, decoded[y * SE_TEXTURE_COMPRESSION_BLOCK_DIM + x], 4);
+        }
+}
+
+void se_texture_compression_fit_line(const SeTextureCompressionBlock& block, size_t numChannels, float* endpoint0, float* endpoint1)
+{
+    float mean[4] = { };
+    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+        for (size_t channel = 0; channel < numChannels; channel++)
+            mean[channel] += block.texels[it][channel] / float(SE_TEXTURE_COMPRESSION_BLOCK_TEXELS);
+    //
+    // Covariance matrix and principal axis (power iteration)
+    //
+    float covariance[4][4] = { };
+    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+        for (size_t row = 0; row < numChannels; row++)
+            for (size_t column = 0; column < numChannels; column++)
+                covariance[row][column] += (block.texels[it][row] - mean[row]) * (block.texels[it][column] - mean[column]);
+    //
+    // Iteration starts from the covariance row of the channel with the largest variance. Fixed start vector can be
+    // orthogonal to the principal axis (red-blue blocks for (1, 1, 1)), which collapses both endpoints to the mean
+    //
+    size_t maxVarianceChannel = 0;
+    for (size_t channel = 1; channel < numChannels; channel++)
+        if (covariance[channel][channel] > covariance[maxVarianceChannel][maxVarianceChannel]) maxVarianceChannel = channel;
+    const bool isFlat = covariance[maxVarianceChannel][maxVarianceChannel] < 1e-6f;
+    float axis[4] = { };
+    for (size_t channel = 0; channel < numChannels; channel++) axis[channel] = isFlat ? 1.0f : covariance[maxVarianceChannel][channel];
+    for (size_t iteration = 0; iteration < SE_TEXTURE_COMPRESSION_POWER_ITERATIONS; iteration++)
+    {
+        float next[4] = { };
+        float maxComponent = 0.0f;
+        for (size_t row = 0; row < numChannels; row++)
+        {
+            for (size_t column = 0; column < numChannels; column++) next[row] += covariance[row][column] * axis[column];
+            maxComponent = se_max(maxComponent, fabsf(next[row]));
+        }
+        // Flat block - any axis works
+        if (maxComponent < 1e-6f) break;
+        for (size_t channel = 0; channel < numChannels; channel++) axis[channel] = next[channel] / maxComponent;
+    }
+    float axisLengthSq = 0.0f;
+    for (size_t channel = 0; channel < numChannels; channel++) axisLengthSq += axis[channel] * axis[channel];
+    //
+    // Project texels on the axis
+    //
+    float minProjection = 0.0f;
+    float maxProjection = 0.0f;
+    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+    {
+        float projection = 0.0f;
+        for (size_t channel = 0; channel < numChannels; channel++) projection += (block.texels[it][channel] - mean[channel]) * axis[channel];
+        projection /= axisLengthSq;
+        minProjection = se_min(minProjection, projection);
+        maxProjection = se_max(maxProjection, projection);
+    }
+    for (size_t channel = 0; channel < 4; channel++)
+    {
+        endpoint0[channel] = channel < numChannels ? se_texture_compression_clamp(mean[channel] + axis[channel] * minProjection, 0.0f, 255.0f) : 0.0f;
+        endpoint1[channel] = channel < numChannels ? se_texture_compression_clamp(mean[channel] + axis[channel] * maxProjection, 0.0f, 255.0f) : 0.0f;
+    }
+}
+
+void se_texture_compression_fit_steps(const SeTextureCompressionBlock& block, const float* endpoint0, const float* endpoint1, uint32_t numSteps, uint8_t* steps)
+{
+    //
+    // Each texel is projected on the endpoint0-endpoint1 line and snapped to one of the numSteps uniformly distributed points.
+    // Step 0 is endpoint0, step (numSteps - 1) is endpoint1
+    //
+    const __m128 start = _mm_loadu_ps(endpoint0);
+    const __m128 direction = _mm_sub_ps(_mm_loadu_ps(endpoint1), start);
+    float directionArray[4];
+    float startArray[4];
+    _mm_storeu_ps(directionArray, direction);
+    _mm_storeu_ps(startArray, start);
+    const float lengthSq =
+        directionArray[0] * directionArray[0] + directionArray[1] * directionArray[1] +
+        directionArray[2] * directionArray[2] + directionArray[3] * directionArray[3];
+    if (lengthSq < 1e-6f)
+    {
+        memset(steps, 0, SE_TEXTURE_COMPRESSION_BLOCK_TEXELS);
+        return;
+    }
+    const __m128 scale = _mm_set1_ps(float(numSteps - 1) / lengthSq);
+    const __m128 maxStep = _mm_set1_ps(float(numSteps - 1));
+    const __m128 directionR = _mm_set1_ps(directionArray[0]);
+    const __m128 directionG = _mm_set1_ps(directionArray[1]);
+    const __m128 directionB = _mm_set1_ps(directionArray[2]);
+    const __m128 directionA = _mm_set1_ps(directionArray[3]);
+    const __m128 startR = _mm_set1_ps(startArray[0]);
+    const __m128 startG = _mm_set1_ps(startArray[1]);
+    const __m128 startB = _mm_set1_ps(startArray[2]);
+    const __m128 startA = _mm_set1_ps(startArray[3]);
+    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it += 4)
+    {
+        __m128 r = _mm_loadu_ps(block.texels[it + 0]);
+        __m128 g = _mm_loadu_ps(block.texels[it + 1]);
+        __m128 b = _mm_loadu_ps(block.texels[it + 2]);
+        __m128 a = _mm_loadu_ps(block.texels[it + 3]);
+        _MM_TRANSPOSE4_PS(r, g, b, a);
+        const __m128 projection = _mm_add_ps
+        (
+            _mm_add_ps(_mm_mul_ps(_mm_sub_ps(r, startR), directionR), _mm_mul_ps(_mm_sub_ps(g, startG), directionG)),
+            _mm_add_ps(_mm_mul_ps(_mm_sub_ps(b, startB), directionB), _mm_mul_ps(_mm_sub_ps(a, startA), directionA))
+        );
+        const __m128 step = _mm_min_ps(_mm_max_ps(_mm_mul_ps(projection, scale), _mm_setzero_ps()), maxStep);
+        int32_t stepArray[4];
+        _mm_storeu_si128((__m128i*)stepArray, _mm_cvtps_epi32(step));
+        for (size_t texel = 0; texel < 4; texel++) steps[it + texel] = uint8_t(stepArray[texel]);
+    }
+}
+
+void se_texture_compression_refine_endpoints(const SeTextureCompressionBlock& block, const uint8_t* steps, uint32_t numSteps, size_t numChannels, float* endpoint0, float* endpoint1)
+{
+    //
+    // Least squares fit of endpoints for the given steps
+    //
+    float aa = 0.0f;
+    float bb = 0.0f;
+    float ab = 0.0f;
+    float ax[4] = { };
+    float bx[4] = { };
+    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+    {
+        const float b = float(steps[it]) / float(numSteps - 1);
+        const float a = 1.0f - b;
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        for (size_t channel = 0; channel < numChannels; channel++)
+        {
+            ax[channel] += a * block.texels[it][channel];
+            bx[channel] += b * block.texels[it][channel];
+        }
+    }
+    const float determinant = aa * bb - ab * ab;
+    if (fabsf(determinant) < 1e-6f) return;
+    for (size_t channel = 0; channel < numChannels; channel++)
+    {
+        endpoint0[channel] = se_texture_compression_clamp((ax[channel] * bb - bx[channel] * ab) / determinant, 0.0f, 255.0f);
+        endpoint1[channel] = se_texture_compression_clamp((bx[channel] * aa - ax[channel] * ab) / determinant, 0.0f, 255.0f);
+    }
+}
+
+// =======================================================================
+//
+// BC1 / BC3 color block
+//
+// =======================================================================
+
+inline uint16_t se_texture_compression_quantize_565(const float* color)
+{
+    const uint16_t r = uint16_t(color[0] * 31.0f / 255.0f + 0.5f);
+    const uint16_t g = uint16_t(color[1] * 63.0f / 255.0f + 0.5f);
+    const uint16_t b = uint16_t(color[2] * 31.0f / 255.0f + 0.5f);
+    return uint16_t((r << 11) | (g << 5) | b);
+}
+
+inline void se_texture_compression_dequantize_565(uint16_t color, uint8_t* result)
+{
+    const uint8_t r = uint8_t((color >> 11) & 31);
+    const uint8_t g = uint8_t((color >> 5) & 63);
+    const uint8_t b = uint8_t(color & 31);
+    result[0] = uint8_t((r << 3) | (r >> 2));
+    result[1] = uint8_t((g << 2) | (g >> 4));
+    result[2] = uint8_t((b << 3) | (b >> 2));
+}
+
+void se_texture_compression_encode_color_block(const SeTextureCompressionBlock& block, const bool* isTransparent, uint8_t* result)
+{
+    //
+    // If isTransparent is not null, transparent texels are encoded with 3 color mode.
+    // Otherwise block is encoded with 4 color mode (BC3 color blocks are always decoded with 4 color mode)
+    //
+    bool hasTransparentTexels = false;
+    if (isTransparent)
+        for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+            hasTransparentTexels |= isTransparent[it];
+    const uint32_t numSteps = hasTransparentTexels ? 3 : 4;
+    float endpoint0[4];
+    float endpoint1[4];
+    se_texture_compression_fit_line(block, 3, endpoint0, endpoint1);
+    uint16_t color0 = 0;
+    uint16_t color1 = 0;
+    uint8_t steps[SE_TEXTURE_COMPRESSION_BLOCK_TEXELS];
+    for (size_t iteration = 0; iteration <= SE_TEXTURE_COMPRESSION_REFINE_ITERATIONS; iteration++)
+    {
+        color0 = se_texture_compression_quantize_565(endpoint0);
+        color1 = se_texture_compression_quantize_565(endpoint1);
+        uint8_t quantized0[3];
+        uint8_t quantized1[3];
+        se_texture_compression_dequantize_565(color0, quantized0);
+        se_texture_compression_dequantize_565(color1, quantized1);
+        const float quantizedEndpoint0[4] = { float(quantized0[0]), float(quantized0[1]), float(quantized0[2]), 0.0f };
+        const float quantizedEndpoint1[4] = { float(quantized1[0]), float(quantized1[1]), float(quantized1[2]), 0.0f };
+        se_texture_compression_fit_steps(block, quantizedEndpoint0, quantizedEndpoint1, numSteps, steps);
+        if (iteration != SE_TEXTURE_COMPRESSION_REFINE_ITERATIONS)
+        {
+            se_texture_compression_refine_endpoints(block, steps, numSteps, 3, endpoint0, endpoint1);
+        }
+    }
+    //
+    // 4 color mode requires color0 > color1, 3 color mode requires color0 <= color1
+    //
+    const bool isSwapRequired = hasTransparentTexels ? (color0 > color1) : (color0 < color1);
+    if (isSwapRequired)
+    {
+        const uint16_t tmp = color0;
+        color0 = color1;
+        color1 = tmp;
+        for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++) steps[it] = uint8_t(numSteps - 1 - steps[it]);
+    }
+    static const uint8_t FOUR_COLOR_STEP_TO_INDEX[] = { 0, 2, 3, 1 };
+    static const uint8_t THREE_COLOR_STEP_TO_INDEX[] = { 0, 2, 1 };
+    uint32_t indices = 0;
+    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+    {
+        uint32_t index = 0;
+        if (color0 == color1 && !hasTransparentTexels) index = 0;
+        else if (hasTransparentTexels) index = isTransparent[it] ? 3 : THREE_COLOR_STEP_TO_INDEX[steps[it]];
+        else index = FOUR_COLOR_STEP_TO_INDEX[steps[it]];
+        indices |= index << (it * 2);
+    }
+    memcpy(result + 0, &color0, sizeof(color0));
+    memcpy(result + 2, &color1, sizeof(color1));
+    memcpy(result + 4, &indices, sizeof(indices));
+}
+
+void se_texture_compression_decode_color_block(const uint8_t* block, bool isFourColorModeForced, uint8_t decoded[SE_TEXTURE_COMPRESSION_BLOCK_TEXELS][4])
+{
+    uint16_t color0;
+    uint16_t color1;
+    uint32_t indices;
+    memcpy(&color0, block + 0, sizeof(color0));
+    memcpy(&color1, block + 2, sizeof(color1));
+    memcpy(&indices, block + 4, sizeof(indices));
+    uint8_t palette[4][4] = { };
+    se_texture_compression_dequantize_565(color0, palette[0]);
+    se_texture_compression_dequantize_565(color1, palette[1]);
+    palette[0][3] = 255;
+    palette[1][3] = 255;
+    if (isFourColorModeForced || color0 > color1)
+    {
+        for (size_t channel = 0; channel < 3; channel++)
+        {
+            palette[2][channel] = uint8_t((2 * palette[0][channel] + palette[1][channel] + 1) / 3);
+            palette[3][channel] = uint8_t((palette[0][channel] + 2 * palette[1][channel] + 1) / 3);
+        }
+        palette[2][3] = 255;
+        palette[3][3] = 255;
+    }
+    else
+    {
+        for (size_t channel = 0; channel < 3; channel++)
+        {
+            palette[2][channel] = uint8_t((palette[0][channel] + palette[1][channel] + 1) / 2);
+        }
+        palette[2][3] = 255;
+        // palette[3] is transparent black
+    }
+    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+    {
+        memcpy(decoded[it], palette[(indices >> (it * 2)) & 3], 4);
+    }
+}
+
+// =======================================================================
+//
+// BC4 / BC5 / BC3 alpha block
+//
+// =======================================================================
+
+void se_texture_compression_encode_single_channel_block(const SeTextureCompressionBlock& block, uint8_t* result)
+{
+    //
+    // Always uses 8 value mode (value0 > value1) with block min and max as endpoints
+    //
+    float minValue = 255.0f;
+    float maxValue = 0.0f;
+    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+    {
+        minValue = se_min(minValue, block.texels[it][0]);
+        maxValue = se_max(maxValue, block.texels[it][0]);
+    }
+    const uint8_t value0 = uint8_t(maxValue + 0.5f);
+    const uint8_t value1 = uint8_t(minValue + 0.5f);
+    uint8_t steps[SE_TEXTURE_COMPRESSION_BLOCK_TEXELS];
+    const float endpoint0[4] = { float(value0), 0.0f, 0.0f, 0.0f };
+    const float endpoint1[4] = { float(value1), 0.0f, 0.0f, 0.0f };
+    se_texture_compression_fit_steps(block, endpoint0, endpoint1, 8, steps);
+    uint64_t indices = 0;
+    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+    {
+        const uint64_t step = steps[it];
+        const uint64_t index = step == 0 ? 0 : (step == 7 ? 1 : step + 1);
+        indices |= index << (it * 3);
+    }
+    result[0] = value0;
+    result[1] = value1;
+    for (size_t it = 0; it < 6; it++) result[2 + it] = uint8_t(indices >> (it * 8));
+}
+
+void se_texture_compression_decode_single_channel_block(const uint8_t* block, size_t channel, uint8_t decoded[SE_TEXTURE_COMPRESSION_BLOCK_TEXELS][4])
+{
+    const uint32_t value0 = block[0];
+    const uint32_t value1 = block[1];
+    uint8_t palette[8];
+    palette[0] = uint8_t(value0);
+    palette[1] = uint8_t(value1);
+    if (value0 > value1)
+    {
+        for (uint32_t it = 1; it < 7; it++) palette[it + 1] = uint8_t(((7 - it) * value0 + it * value1 + 3) / 7);
+    }
+    else
+    {
+        for (uint32_t it = 1; it < 5; it++) palette[it + 1] = uint8_t(((5 - it) * value0 + it * value1 + 2) / 5);
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    uint64_t indices = 0;
+    for (size_t it = 0; it < 6; it++) indices |= uint64_t(block[2 + it]) << (it * 8);
+    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+    {
+        decoded[it][channel] = palette[(indices >> (it * 3)) & 7];
+    }
+}
+
+// =======================================================================
+//
+// BC7. Encoder produces only mode 6 blocks, decoder supports all modes
+//
+// =======================================================================
+
+struct SeTextureCompressionBc7Mode
+{
+    uint8_t numSubsets;
+    uint8_t partitionBits;
+    uint8_t rotationBits;
+    uint8_t indexSelectionBits;
+    uint8_t colorBits;
+    uint8_t alphaBits;              // Zero if mode has no alpha (alpha is 255)
+    uint8_t endpointPBits;          // P-bit per endpoint
+    uint8_t sharedPBits;            // P-bit per subset
+    uint8_t indexBits;
+    uint8_t secondaryIndexBits;     // Modes 4 and 5 store separate color and alpha indices
+};
+
+static const SeTextureCompressionBc7Mode SE_TEXTURE_COMPRESSION_BC7_MODES[] =
+{
+    { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+    { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+    { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+    { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+    { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+    { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+    { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+    { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+};
+
+// Two subset partitions, bit per texel is set if texel belongs to the second subset
+static const uint16_t SE_TEXTURE_COMPRESSION_BC7_PARTITIONS_2[64] =
+{
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+static const uint8_t SE_TEXTURE_COMPRESSION_BC7_PARTITIONS_3[64][16] =
+{
+    { 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 1, 2, 2, 2, 2 }, { 0, 0, 0, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 2, 0, 0, 1, 2, 2, 1, 1, 2, 2, 1, 1 }, { 0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 1, 0, 1, 1, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2 }, { 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1 }, { 0, 0, 1, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2 }, { 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2 }, { 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2 },
+    { 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2 }, { 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2 },
+    { 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2, 1, 2, 2, 2 }, { 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0, 2, 2, 2, 0 },
+    { 0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2 }, { 0, 1, 1, 1, 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0 },
+    { 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2 }, { 0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1 },
+    { 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2, 0, 2, 2, 2 }, { 0, 0, 0, 1, 0, 0, 0, 1, 2, 2, 2, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2 }, { 0, 0, 0, 0, 1, 1, 0, 0, 2, 2, 1, 0, 2, 2, 1, 0 },
+    { 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1, 0, 0, 0, 0 }, { 0, 0, 1, 2, 0, 0, 1, 2, 1, 1, 2, 2, 2, 2, 2, 2 },
+    { 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1, 0, 1, 1, 0 }, { 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1 },
+    { 0, 0, 2, 2, 1, 1, 0, 2, 1, 1, 0, 2, 0, 0, 2, 2 }, { 0, 1, 1, 0, 0, 1, 1, 0, 2, 0, 0, 2, 2, 2, 2, 2 },
+    { 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1 }, { 0, 0, 0, 0, 2, 0, 0, 0, 2, 2, 1, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 2, 2, 2 }, { 0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 2, 0, 0, 1, 1 },
+    { 0, 0, 1, 1, 0, 0, 1, 2, 0, 0, 2, 2, 0, 2, 2, 2 }, { 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0 },
+    { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0 }, { 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0 },
+    { 0, 1, 2, 0, 2, 0, 1, 2, 1, 2, 0, 1, 0, 1, 2, 0 }, { 0, 0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 0, 0, 1, 1 },
+    { 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0, 1, 1 }, { 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1 }, { 0, 0, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2, 1, 1, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 1, 1 }, { 0, 2, 2, 0, 1, 2, 2, 1, 0, 2, 2, 0, 1, 2, 2, 1 },
+    { 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 0, 1, 0, 1 }, { 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1 },
+    { 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2 }, { 0, 2, 2, 2, 0, 1, 1, 1, 0, 2, 2, 2, 0, 1, 1, 1 },
+    { 0, 0, 0, 2, 1, 1, 1, 2, 0, 0, 0, 2, 1, 1, 1, 2 }, { 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2 },
+    { 0, 2, 2, 2, 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2 }, { 0, 0, 0, 2, 1, 1, 1, 2, 1, 1, 1, 2, 0, 0, 0, 2 },
+    { 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2 }, { 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2 },
+    { 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2 }, { 0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2 },
+    { 0, 0, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2 },
+    { 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1 }, { 0, 2, 2, 2, 1, 2, 2, 2, 0, 2, 2, 2, 1, 2, 2, 2 },
+    { 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 }, { 0, 1, 1, 1, 2, 0, 1, 1, 2, 2, 0, 1, 2, 2, 2, 0 },
+};
+
+//
+// Anchor texels store their indices with one bit less (most significant bit is implicitly zero). Anchor of the first
+// subset is always the first texel
+//
+static const uint8_t SE_TEXTURE_COMPRESSION_BC7_ANCHORS_2[64] =
+{
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+
+static const uint8_t SE_TEXTURE_COMPRESSION_BC7_ANCHORS_3[2][64] =
+{
+    {
+         3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+         3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+         8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+         3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+    },
+    {
+        15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+        15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+        15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+        15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+    },
+};
+
+static const uint32_t SE_TEXTURE_COMPRESSION_BC7_WEIGHTS_2[] = { 0, 21, 43, 64 };
+static const uint32_t SE_TEXTURE_COMPRESSION_BC7_WEIGHTS_3[] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+static const uint32_t SE_TEXTURE_COMPRESSION_BC7_WEIGHTS_4[] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+inline uint8_t se_texture_compression_bc7_quantize_endpoint(const float* endpoint, uint8_t* quantized)
+{
+    //
+    // Mode 6 endpoints are 7 bits per channel plus shared p-bit. Returns best p-bit
+    //
+    float bestError = 0.0f;
+    uint8_t bestPBit = 0;
+    for (uint8_t pBit = 0; pBit < 2; pBit++)
+    {
+        float error = 0.0f;
+        uint8_t candidate[4];
+        for (size_t channel = 0; channel < 4; channel++)
+        {
+            const float value = se_texture_compression_clamp((endpoint[channel] - float(pBit)) / 2.0f + 0.5f, 0.0f, 127.0f);
+            candidate[channel] = uint8_t(value);
+            const float reconstructed = float((candidate[channel] << 1) | pBit);
+            error += (reconstructed - endpoint[channel]) * (reconstructed - endpoint[channel]);
+        }
+        if (pBit == 0 || error < bestError)
+        {
+            bestError = error;
+            bestPBit = pBit;
+            memcpy(quantized, candidate, 4);
+        }
+    }
+    return bestPBit;
+}
+
+void se_texture_compression_encode_bc7_block(const SeTextureCompressionBlock& block, uint8_t* result)
+{
+    constexpr uint32_t NUM_STEPS = 16;
+    float endpoint0[4];
+    float endpoint1[4];
+    se_texture_compression_fit_line(block, 4, endpoint0, endpoint1);
+    uint8_t quantized0[4];
+    uint8_t quantized1[4];
+    uint8_t pBit0 = 0;
+    uint8_t pBit1 = 0;
+    uint8_t steps[SE_TEXTURE_COMPRESSION_BLOCK_TEXELS];
+    for (size_t iteration = 0; iteration <= SE_TEXTURE_COMPRESSION_REFINE_ITERATIONS; iteration++)
+    {
+        pBit0 = se_texture_compression_bc7_quantize_endpoint(endpoint0, quantized0);
+        pBit1 = se_texture_compression_bc7_quantize_endpoint(endpoint1, quantized1);
+        float quantizedEndpoint0[4];
+        float quantizedEndpoint1[4];
+        for (size_t channel = 0; channel < 4; channel++)
+        {
+            quantizedEndpoint0[channel] = float((quantized0[channel] << 1) | pBit0);
+            quantizedEndpoint1[channel] = float((quantized1[channel] << 1) | pBit1);
+        }
+        se_texture_compression_fit_steps(block, quantizedEndpoint0, quantizedEndpoint1, NUM_STEPS, steps);
+        if (iteration != SE_TEXTURE_COMPRESSION_REFINE_ITERATIONS)
+        {
+            se_texture_compression_refine_endpoints(block, steps, NUM_STEPS, 4, endpoint0, endpoint1);
+        }
+    }
+    //
+    // Most significant bit of the anchor (first) index is implicitly zero
+    //
+    if (steps[0] >= (NUM_STEPS / 2))
+    {
+        uint8_t tmp[4];
+        memcpy(tmp, quantized0, 4);
+        memcpy(quantized0, quantized1, 4);
+        memcpy(quantized1, tmp, 4);
+        const uint8_t tmpPBit = pBit0;
+        pBit0 = pBit1;
+        pBit1 = tmpPBit;
+        for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++) steps[it] = uint8_t(NUM_STEPS - 1 - steps[it]);
+    }
+    memset(result, 0, 16);
+    SeTextureCompressionBits bits = { result, 0 };
+    se_texture_compression_bits_write(bits, 1 << 6, 7);
+    for (size_t channel = 0; channel < 4; channel++)
+    {
+        se_texture_compression_bits_write(bits, quantized0[channel], 7);
+        se_texture_compression_bits_write(bits, quantized1[channel], 7);
+    }
+    se_texture_compression_bits_write(bits, pBit0, 1);
+    se_texture_compression_bits_write(bits, pBit1, 1);
+    se_texture_compression_bits_write(bits, steps[0], 3);
+    for (size_t it = 1; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+    {
+        se_texture_compression_bits_write(bits, steps[it], 4);
+    }
+    se_assert(bits.position == 128);
+}
+
+inline uint32_t se_texture_compression_bc7_subset(const SeTextureCompressionBc7Mode& mode, uint32_t partition, size_t texel)
+{
+    if (mode.numSubsets == 1) return 0;
+    if (mode.numSubsets == 2) return (SE_TEXTURE_COMPRESSION_BC7_PARTITIONS_2[partition] >> texel) & 1;
+    return SE_TEXTURE_COMPRESSION_BC7_PARTITIONS_3[partition][texel];
+}
+
+inline bool se_texture_compression_bc7_is_anchor(const SeTextureCompressionBc7Mode& mode, uint32_t partition, size_t texel)
+{
+    if (texel == 0) return true;
+    if (mode.numSubsets == 2) return texel == SE_TEXTURE_COMPRESSION_BC7_ANCHORS_2[partition];
+    if (mode.numSubsets == 3) return texel == SE_TEXTURE_COMPRESSION_BC7_ANCHORS_3[0][partition] || texel == SE_TEXTURE_COMPRESSION_BC7_ANCHORS_3[1][partition];
+    return false;
+}
+
+inline uint32_t se_texture_compression_bc7_weight(uint32_t numBits, uint32_t index)
+{
+    switch (numBits)
+    {
+        case 2: return SE_TEXTURE_COMPRESSION_BC7_WEIGHTS_2[index];
+        case 3: return SE_TEXTURE_COMPRESSION_BC7_WEIGHTS_3[index];
+        default: return SE_TEXTURE_COMPRESSION_BC7_WEIGHTS_4[index];
+    }
+}
+
+void se_texture_compression_decode_bc7_block(const uint8_t* block, uint8_t decoded[SE_TEXTURE_COMPRESSION_BLOCK_TEXELS][4])
+{
+    //
+    // Mode is the number of zero bits before the first set bit. Blocks without a set bit in the first byte are reserved
+    // and decoded as transparent black
+    //
+    uint32_t modeIndex = 0;
+    while (modeIndex < 8 && !(block[0] & (1 << modeIndex))) modeIndex += 1;
+    if (modeIndex == 8)
+    {
+        memset(decoded, 0, SE_TEXTURE_COMPRESSION_BLOCK_TEXELS * 4);
+        return;
+    }
+    const SeTextureCompressionBc7Mode& mode = SE_TEXTURE_COMPRESSION_BC7_MODES[modeIndex];
+    SeTextureCompressionBits bits = { (uint8_t*)block, modeIndex + 1 };
+    const uint32_t partition = se_texture_compression_bits_read(bits, mode.partitionBits);
+    const uint32_t rotation = se_texture_compression_bits_read(bits, mode.rotationBits);
+    const uint32_t indexSelection = se_texture_compression_bits_read(bits, mode.indexSelectionBits);
+    //
+    // Endpoints are stored channel by channel (all colors, then all alphas), then p-bits
+    //
+    uint32_t endpoints[3][2][4] = { };
+    for (size_t channel = 0; channel < 3; channel++)
+        for (size_t subset = 0; subset < mode.numSubsets; subset++)
+            for (size_t endpoint = 0; endpoint < 2; endpoint++)
+                endpoints[subset][endpoint][channel] = se_texture_compression_bits_read(bits, mode.colorBits);
+    if (mode.alphaBits)
+    {
+        for (size_t subset = 0; subset < mode.numSubsets; subset++)
+            for (size_t endpoint = 0; endpoint < 2; endpoint++)
+                endpoints[subset][endpoint][3] = se_texture_compression_bits_read(bits, mode.alphaBits);
+    }
+    const bool hasPBits = mode.endpointPBits || mode.sharedPBits;
+    if (hasPBits)
+    {
+        for (size_t subset = 0; subset < mode.numSubsets; subset++)
+        {
+            const uint32_t sharedPBit = mode.sharedPBits ? se_texture_compression_bits_read(bits, 1) : 0;
+            for (size_t endpoint = 0; endpoint < 2; endpoint++)
+            {
+                const uint32_t pBit = mode.endpointPBits ? se_texture_compression_bits_read(bits, 1) : sharedPBit;
+                for (size_t channel = 0; channel < 4; channel++) endpoints[subset][endpoint][channel] = (endpoints[subset][endpoint][channel] << 1) | pBit;
+            }
+        }
+    }
+    //
+    // Expand endpoints to 8 bits by replicating the most significant bits
+    //
+    const uint32_t colorBits = mode.colorBits + (hasPBits ? 1 : 0);
+    const uint32_t alphaBits = mode.alphaBits ? mode.alphaBits + (hasPBits ? 1 : 0) : 0;
+    for (size_t subset = 0; subset < mode.numSubsets; subset++)
+        for (size_t endpoint = 0; endpoint < 2; endpoint++)
+            for (size_t channel = 0; channel < 4; channel++)
+            {
+                uint32_t& value = endpoints[subset][endpoint][channel];
+                const uint32_t numBits = channel == 3 ? alphaBits : colorBits;
+                value = numBits ? ((value << (8 - numBits)) | (value >> (2 * numBits - 8))) : 255;
+            }
+    //
+    // Indices. Modes 4 and 5 have secondary indices, index selection bit of mode 4 tells which of them are used for alpha
+    //
+    uint32_t indices[SE_TEXTURE_COMPRESSION_BLOCK_TEXELS];
+    uint32_t secondaryIndices[SE_TEXTURE_COMPRESSION_BLOCK_TEXELS] = { };
+    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+    {
+        const bool isAnchor = se_texture_compression_bc7_is_anchor(mode, partition, it);
+        indices[it] = se_texture_compression_bits_read(bits, mode.indexBits - (isAnchor ? 1 : 0));
+    }
+    if (mode.secondaryIndexBits)
+    {
+        for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+        {
+            secondaryIndices[it] = se_texture_compression_bits_read(bits, mode.secondaryIndexBits - (it == 0 ? 1 : 0));
+        }
+    }
+    se_assert(bits.position == 128);
+    const bool isSwapped = indexSelection != 0;
+    const uint32_t colorIndexBits = isSwapped ? mode.secondaryIndexBits : mode.indexBits;
+    const uint32_t alphaIndexBits = (mode.secondaryIndexBits && !isSwapped) ? mode.secondaryIndexBits : mode.indexBits;
+    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++)
+    {
+        const uint32_t subset = se_texture_compression_bc7_subset(mode, partition, it);
+        const uint32_t colorIndex = isSwapped ? secondaryIndices[it] : indices[it];
+        const uint32_t alphaIndex = (mode.secondaryIndexBits && !isSwapped) ? secondaryIndices[it] : indices[it];
+        const uint32_t colorWeight = se_texture_compression_bc7_weight(colorIndexBits, colorIndex);
+        const uint32_t alphaWeight = se_texture_compression_bc7_weight(alphaIndexBits, alphaIndex);
+        for (size_t channel = 0; channel < 4; channel++)
+        {
+            const uint32_t weight = channel == 3 ? alphaWeight : colorWeight;
+            decoded[it][channel] = uint8_t(((64 - weight) * endpoints[subset][0][channel] + weight * endpoints[subset][1][channel] + 32) >> 6);
+        }
+        //
+        // Rotation swaps alpha with one of the color channels
+        //
+        if (rotation)
+        {
+            const uint8_t tmp = decoded[it][3];
+            decoded[it][3] = decoded[it][rotation - 1];
+            decoded[it][rotation - 1] = tmp;
+        }
+    }
+}
+
+// =======================================================================
+//
+// Public interface
+//
+// =======================================================================
+
+bool se_texture_compression_is_compressed(SeTextureFormat format)
+{
+    switch (format)
+    {
+        case SeTextureFormat::BC1_RGBA_UNORM:
+        case SeTextureFormat::BC1_RGBA_SRGB:
+        case SeTextureFormat::BC3_UNORM:
+        case SeTextureFormat::BC3_SRGB:
+        case SeTextureFormat::BC4_UNORM:
+        case SeTextureFormat::BC5_UNORM:
+        case SeTextureFormat::BC7_UNORM:
+        case SeTextureFormat::BC7_SRGB:
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t se_texture_compression_get_block_size(SeTextureFormat format)
+{
+    switch (format)
+    {
+        case SeTextureFormat::BC1_RGBA_UNORM:
+        case SeTextureFormat::BC1_RGBA_SRGB:
+        case SeTextureFormat::BC4_UNORM:
+            return 8;
+        case SeTextureFormat::BC3_UNORM:
+        case SeTextureFormat::BC3_SRGB:
+        case SeTextureFormat::BC5_UNORM:
+        case SeTextureFormat::BC7_UNORM:
+        case SeTextureFormat::BC7_SRGB:
+            return 16;
+        default:
+            se_assert_msg(false, "Format is not block compressed");
+            return 0;
+    }
+}
+
+size_t se_texture_compression_get_size(SeTextureFormat format, uint32_t width, uint32_t height)
+{
+    const size_t numBlocksX = (width + SE_TEXTURE_COMPRESSION_BLOCK_DIM - 1) / SE_TEXTURE_COMPRESSION_BLOCK_DIM;
+    const size_t numBlocksY = (height + SE_TEXTURE_COMPRESSION_BLOCK_DIM - 1) / SE_TEXTURE_COMPRESSION_BLOCK_DIM;
+    return numBlocksX * numBlocksY * se_texture_compression_get_block_size(format);
+}
+
+void se_texture_compression_encode(SeTextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, void* result)
+{
+    se_assert(width > 0 && height > 0);
+    const size_t blockSize = se_texture_compression_get_block_size(format);
+    const uint32_t numBlocksX = (width + SE_TEXTURE_COMPRESSION_BLOCK_DIM - 1) / SE_TEXTURE_COMPRESSION_BLOCK_DIM;
+    const uint32_t numBlocksY = (height + SE_TEXTURE_COMPRESSION_BLOCK_DIM - 1) / SE_TEXTURE_COMPRESSION_BLOCK_DIM;
+    uint8_t* output = (uint8_t*)result;
+    SeTextureCompressionBlock block;
+    for (uint32_t blockY = 0; blockY < numBlocksY; blockY++)
+        for (uint32_t blockX = 0; blockX < numBlocksX; blockX++)
+        {
+            switch (format)
+            {
+                case SeTextureFormat::BC1_RGBA_UNORM:
+                case SeTextureFormat::BC1_RGBA_SRGB:
+                {
+                    SeTextureCompressionBlock alphaBlock;
+                    se_texture_compression_load_block(rgba, width, height, blockX, blockY, 3, 1, &alphaBlock);
+                    bool isTransparent[SE_TEXTURE_COMPRESSION_BLOCK_TEXELS];
+                    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++) isTransparent[it] = alphaBlock.texels[it][0] < 128.0f;
+                    se_texture_compression_load_block(rgba, width, height, blockX, blockY, 0, 3, &block);
+                    se_texture_compression_encode_color_block(block, isTransparent, output);
+                } break;
+                case SeTextureFormat::BC3_UNORM:
+                case SeTextureFormat::BC3_SRGB:
+                {
+                    se_texture_compression_load_block(rgba, width, height, blockX, blockY, 3, 1, &block);
+                    se_texture_compression_encode_single_channel_block(block, output);
+                    se_texture_compression_load_block(rgba, width, height, blockX, blockY, 0, 3, &block);
+                    se_texture_compression_encode_color_block(block, nullptr, output + 8);
+                } break;
+                case SeTextureFormat::BC4_UNORM:
+                {
+                    se_texture_compression_load_block(rgba, width, height, blockX, blockY, 0, 1, &block);
+                    se_texture_compression_encode_single_channel_block(block, output);
+                } break;
+                case SeTextureFormat::BC5_UNORM:
+                {
+                    se_texture_compression_load_block(rgba, width, height, blockX, blockY, 0, 1, &block);
+                    se_texture_compression_encode_single_channel_block(block, output);
+                    se_texture_compression_load_block(rgba, width, height, blockX, blockY, 1, 1, &block);
+                    se_texture_compression_encode_single_channel_block(block, output + 8);
+                } break;
+                case SeTextureFormat::BC7_UNORM:
+                case SeTextureFormat::BC7_SRGB:
+                {
+                    se_texture_compression_load_block(rgba, width, height, blockX, blockY, 0, 4, &block);
+                    se_texture_compression_encode_bc7_block(block, output);
+                } break;
+                default: break;
+            }
+            output += blockSize;
+        }
+}
+
+void se_texture_compression_decode(SeTextureFormat format, const void* blocks, uint32_t width, uint32_t height, uint8_t* rgba)
+{
+    se_assert(width > 0 && height > 0);
+    const size_t blockSize = se_texture_compression_get_block_size(format);
+    const uint32_t numBlocksX = (width + SE_TEXTURE_COMPRESSION_BLOCK_DIM - 1) / SE_TEXTURE_COMPRESSION_BLOCK_DIM;
+    const uint32_t numBlocksY = (height + SE_TEXTURE_COMPRESSION_BLOCK_DIM - 1) / SE_TEXTURE_COMPRESSION_BLOCK_DIM;
+    const uint8_t* input = (const uint8_t*)blocks;
+    uint8_t decoded[SE_TEXTURE_COMPRESSION_BLOCK_TEXELS][4];
+    for (uint32_t blockY = 0; blockY < numBlocksY; blockY++)
+        for (uint32_t blockX = 0; blockX < numBlocksX; blockX++)
+        {
+            switch (format)
+            {
+                case SeTextureFormat::BC1_RGBA_UNORM:
+                case SeTextureFormat::BC1_RGBA_SRGB:
+                {
+                    se_texture_compression_decode_color_block(input, false, decoded);
+                } break;
+                case SeTextureFormat::BC3_UNORM:
+                case SeTextureFormat::BC3_SRGB:
+                {
+                    se_texture_compression_decode_color_block(input + 8, true, decoded);
+                    se_texture_compression_decode_single_channel_block(input, 3, decoded);
+                } break;
+                case SeTextureFormat::BC4_UNORM:
+                {
+                    memset(decoded, 0, sizeof(decoded));
+                    se_texture_compression_decode_single_channel_block(input, 0, decoded);
+                    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++) decoded[it][3] = 255;
+                } break;
+                case SeTextureFormat::BC5_UNORM:
+                {
+                    memset(decoded, 0, sizeof(decoded));
+                    se_texture_compression_decode_single_channel_block(input, 0, decoded);
+                    se_texture_compression_decode_single_channel_block(input + 8, 1, decoded);
+                    for (size_t it = 0; it < SE_TEXTURE_COMPRESSION_BLOCK_TEXELS; it++) decoded[it][3] = 255;
+                } break;
+                case SeTextureFormat::BC7_UNORM:
+                case SeTextureFormat::BC7_SRGB:
+                {
+                    se_texture_compression_decode_bc7_block(input, decoded);
+                } break;
+                default: break;
+            }
+            se_texture_compression_store_block(decoded, width, height, blockX, blockY, rgba);
+            input += blockSize;
+        }
+}
+
+float se_texture_compression_psnr(const uint8_t* first, const uint8_t* second, uint32_t width, uint32_t height, size_t numChannels)
+{
+    se_assert(numChannels > 0 && numChannels <= 4);
+    double squaredErrorSum = 0.0;
+    const size_t numTexels = size_t(width) * height;
+    for (size_t texel = 0; texel < numTexels; texel++)
+        for (size_t channel = 0; channel < numChannels; channel++)
+        {
+            const double difference = double(first[texel * 4 + channel]) - double(second[texel * 4 + channel]);
+            squaredErrorSum += difference * difference;
+        }
+    const double meanSquaredError = squaredErrorSum / double(numTexels * numChannels);
+    if (meanSquaredError == 0.0) return INFINITY;
+    return float(10.0 * log10((255.0 * 255.0) / meanSquaredError));
+}
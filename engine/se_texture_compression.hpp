@@ -0,0 +1,29 @@
+#ifndef _SE_TEXTURE_COMPRESSION_HPP_
+#define _SE_TEXTURE_COMPRESSION_HPP_
+
+#include "engine/se_common_includes.hpp"
+#include "engine/render/se_render.hpp"
+
+//
+// Cpu block compression (BC1, BC3, BC4, BC5 and BC7).
+//
+// Encoder input and decoder output are always tightly packed RGBA8 texels.
+// BC4 uses only red channel and BC5 uses red and green channels.
+// BC7 encoder produces only mode 6 blocks (single subset, rgba endpoints, 4 bit indices).
+// BC7 decoder supports all modes, so it can read blocks produced by other encoders.
+//
+// Library doesn't depend on engine subsystems (except for asserts), so it can be used
+// by offline tools as well as at runtime.
+//
+
+bool    se_texture_compression_is_compressed(SeTextureFormat format);
+size_t  se_texture_compression_get_block_size(SeTextureFormat format);
+size_t  se_texture_compression_get_size(SeTextureFormat format, uint32_t width, uint32_t height);
+
+void    se_texture_compression_encode(SeTextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, void* result);
+void    se_texture_compression_decode(SeTextureFormat format, const void* blocks, uint32_t width, uint32_t height, uint8_t* rgba);
+
+// Peak signal-to-noise ratio of the first numChannels channels of two RGBA8 images
+float   se_texture_compression_psnr(const uint8_t* first, const uint8_t* second, uint32_t width, uint32_t height, size_t numChannels);
+
+#endif
@@ -495,6 +495,19 @@ void* SeMeshAsset::load(const Info& info, const Intermediate& intermediateData)
                     case cgltf_attribute_type_tangent:  { se_assert(!seGeometry.tangentBuffer);   seGeometry.tangentBuffer  = renderBuffer; } break;
                     case cgltf_attribute_type_texcoord: { se_assert(!seGeometry.uvBuffer);        seGeometry.uvBuffer       = renderBuffer; } break;
                 }
+                //
+                // Bounds. glTF requires min and max values for position accessors, so they don't need to be computed
+                //
+                if (attribute.type == cgltf_attribute_type_position)
+                {
+                    const cgltf_accessor* const accessor = attribute.data;
+                    se_assert_msg(accessor->has_min && accessor->has_max, "Position accessor doesn't have min and max values");
+                    seGeometry.aabb =
+                    {
+                        .min = { accessor->min[0], accessor->min[1], accessor->min[2] },
+                        .max = { accessor->max[0], accessor->max[1], accessor->max[2] },
+                    };
+                }
             }
             //
             // Load indices
@@ -554,6 +567,23 @@ void* SeMeshAsset::load(const Info& info, const Intermediate& intermediateData)
         }
     }
 
+    //
+    // Bounds of nodes and the whole mesh
+    //
+    for (size_t nodeIt = 0; nodeIt < meshAsset->numNodes; nodeIt++)
+    {
+        SeMeshNode& node = meshAsset->nodes[nodeIt];
+        bool hasBounds = false;
+        for (size_t geometryIt = 0; geometryIt < meshAsset->numGeometries; geometryIt++)
+        {
+            if (!se_bm_get(node.geometryMask, geometryIt)) continue;
+            const SeAabb geometryAabb = se_aabb_transformed(meshAsset->geometries[geometryIt].aabb, node.modelTrf);
+            node.aabb = hasBounds ? se_aabb_union(node.aabb, geometryAabb) : geometryAabb;
+            hasBounds = true;
+        }
+        meshAsset->aabb = nodeIt ? se_aabb_union(meshAsset->aabb, node.aabb) : node.aabb;
+    }
+
     return meshAsset;
 }
 
@@ -605,10 +635,13 @@ bool SeMeshIteratorInstance::operator != (const SeMeshIteratorInstance& other) c
 
 SeMeshIteratorValue SeMeshIteratorInstance::operator *  ()
 {
+    static_assert(offsetof(SeMeshInstanceData, transformWs) == 0, "Instances are culled in place, transform must be the first member");
     se_dynamic_array_reset(transforms);
 
     se_assert(index < mesh->numGeometries);
     const SeMeshGeometry& geometry = mesh->geometries[index];
+    const SeMeshInstanceData* const instancesRaw = se_dynamic_array_raw(instances);
+    const size_t numInstances = se_dynamic_array_size(instances);
 
     for (size_t nodeIt = 0; nodeIt < SE_MESH_MAX_NODES; nodeIt++)
     {
@@ -617,9 +650,11 @@ SeMeshIteratorValue SeMeshIteratorInstance::operator *  ()
         se_assert(nodeIt < mesh->numNodes);
         const SeMeshNode& node = mesh->nodes[nodeIt];
 
-        for (auto instanceIt : instances)
+        const SeAabb aabbMs = se_aabb_transformed(geometry.aabb, node.modelTrf);
+        const size_t numVisible = se_frustum_cull(frustumPlanes, aabbMs, instancesRaw, sizeof(SeMeshInstanceData), numInstances, visibleInstances);
+        for (size_t visibleIt = 0; visibleIt < numVisible; visibleIt++)
         {
-            const SeMeshInstanceData& instance = se_iterator_value(instanceIt);
+            const SeMeshInstanceData& instance = instancesRaw[visibleInstances[visibleIt]];
             const SeFloat4x4& trf = instance.transformWs;
             const SeFloat4x4 transformWs = se_float4x4_mul(trf, node.modelTrf);
             const SeFloat4x4 mvp = se_float4x4_mul(viewProjectionMatrix, transformWs);
@@ -639,14 +674,19 @@ SeMeshIteratorInstance& SeMeshIteratorInstance::operator ++ ()
 SeMeshIteratorInstance begin(const SeMeshIterator& iterator)
 {
     se_assert(iterator.mesh);
-    return
+    const size_t numInstances = se_dynamic_array_size(iterator.instances);
+    SeMeshIteratorInstance result
     {
         .mesh = iterator.mesh,
         .instances = iterator.instances,
         .viewProjectionMatrix = iterator.viewProjectionMatrix,
         .index = 0,
-        .transforms = se_dynamic_array_create<SeFloat4x4>(se_allocator_frame(), se_dynamic_array_size(iterator.instances) * 4),
+        .transforms = se_dynamic_array_create<SeFloat4x4>(se_allocator_frame(), numInstances * 4),
+        .frustumPlanes = { },
+        .visibleInstances = (uint32_t*)se_alloc(se_allocator_frame(), sizeof(uint32_t) * (numInstances ? numInstances : 1), se_alloc_tag),
     };
+    se_float4x4_get_frustum_planes(iterator.viewProjectionMatrix, result.frustumPlanes);
+    return result;
 }
 
 SeMeshIteratorInstance end(const SeMeshIterator& iterator)
@@ -659,5 +699,7 @@ SeMeshIteratorInstance end(const SeMeshIterator& iterator)
         .viewProjectionMatrix = iterator.viewProjectionMatrix,
         .index = iterator.mesh->numGeometries,
         .transforms = {},
+        .frustumPlanes = { },
+        .visibleInstances = nullptr,
     };
 }
@@ -12,6 +12,7 @@
 #include "engine/se_common_includes.hpp"
 #include "engine/se_data_providers.hpp"
 #include "engine/se_math.hpp"
+#include "engine/se_frustum_culling.hpp"
 #include "engine/se_utils.hpp"
 #include "engine/render/se_render.hpp"
 #include "engine/subsystems/se_string.hpp"
@@ -39,6 +40,9 @@ struct SeMeshNode
     SeMeshGeometryMask  geometryMask;
     SeMeshNodeMask      childNodesMask;
 
+    // @NOTE : Bounds of all node geometries in model space (modelTrf is applied)
+    SeAabb              aabb;
+
     SeString            name;
 };
 
@@ -56,6 +60,9 @@ struct SeMeshGeometry
     uint32_t        numVertices;
     uint32_t        numIndices;
 
+    // @NOTE : Bounds in geometry space, node transforms are not applied
+    SeAabb          aabb;
+
     size_t          textureSetIndex;
 };
 
@@ -75,6 +82,9 @@ struct SeMeshAssetValue
     size_t              numTextureSets;
 
     SeMeshNodeMask      rootNodes;
+
+    // @NOTE : Bounds of all nodes in model space
+    SeAabb              aabb;
 };
 
 struct SeMeshAssetIntermediateData
@@ -109,6 +119,12 @@ struct SeMeshInstanceData
     SeFloat4x4 transformWs;
 };
 
+// World space bounds of the mesh instance, can be used as a bounding box of an aabb tree proxy (see se_aabb_tree.hpp)
+inline SeAabb se_mesh_instance_aabb(const SeMeshAssetValue* mesh, const SeMeshInstanceData& instance)
+{
+    return se_aabb_transformed(mesh->aabb, instance.transformWs);
+}
+
 struct SeMeshIterator
 {
     const SeMeshAssetValue* mesh;
@@ -122,6 +138,11 @@ struct SeMeshIteratorValue
     const SeDynamicArray<SeFloat4x4> transformsWs;
 };
 
+//
+// Iterates over mesh geometries and returns transposed mvp matrices of visible (node, instance) pairs for each geometry.
+// Bounds of every node geometry are frustum culled for all instances at once (see se_frustum_culling.hpp) before any
+// mvp matrix is computed
+//
 struct SeMeshIteratorInstance
 {
     const SeMeshAssetValue*                 mesh;
@@ -130,6 +151,8 @@ struct SeMeshIteratorInstance
 
     size_t                                  index;
     SeDynamicArray<SeFloat4x4>                transforms;
+    SeFloat4                                frustumPlanes[6];
+    uint32_t*                               visibleInstances;
 
     bool                    operator != (const SeMeshIteratorInstance& other) const;
     SeMeshIteratorValue     operator *  ();
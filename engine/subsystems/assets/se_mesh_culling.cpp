@@ -0,0 +1,159 @@
+
+#include "se_mesh_culling.hpp"
+#include "engine/se_engine.hpp"
+
+// @NOTE : transforms of different geometries are bound with offsets, so every range starts at a multiple of 256 bytes
+//         (the biggest minStorageBufferOffsetAlignment allowed by the vulkan spec)
+constexpr size_t SE_MESH_CULLING_TRANSFORMS_ALIGNMENT = 256 / sizeof(SeFloat4x4);
+
+// Matches CullNode in mesh_cull.comp
+struct SeMeshCullNode
+{
+    SeFloat4x4  modelTrf;
+    SeFloat4    aabbMin;
+    SeFloat4    aabbMax;
+    uint32_t    geometryIndex;
+    uint32_t    firstTransform;
+    uint32_t    _pad[2];
+};
+
+// Matches FrameData in mesh_cull.comp
+struct SeMeshCullFrameData
+{
+    SeFloat4x4  viewProjection;
+    SeFloat4    frustumPlanes[6];
+    uint32_t    numInstances;
+    uint32_t    numCullNodes;
+    uint32_t    _pad[2];
+};
+
+void se_mesh_culler_construct(SeMeshCuller* culler, const SeMeshCullerInfo& info)
+{
+    se_assert(info.mesh);
+    se_assert(info.maxInstances);
+    const SeMeshAssetValue* const mesh = info.mesh;
+    *culler =
+    {
+        .mesh               = mesh,
+        .maxInstances       = info.maxInstances,
+        .numCullNodes       = 0,
+        .cullProgram        = se_render_program({ se_data_provider_from_file("mesh_cull.comp.spv") }),
+        .cullNodesBuffer    = { },
+        .transformsBuffer   = { },
+        .drawArgsBuffer     = { },
+        .firstTransforms    = { },
+        .maxTransforms      = { },
+    };
+    //
+    // Every (node, geometry) pair gets its own cull node. Pairs of the same geometry share the range of transforms,
+    // so visible instances of all nodes are drawn with a single indirect draw
+    //
+    SeDynamicArray<SeMeshCullNode> cullNodes = se_dynamic_array_create<SeMeshCullNode>(se_allocator_frame(), mesh->numGeometries);
+    size_t numTransforms = 0;
+    for (size_t geometryIt = 0; geometryIt < mesh->numGeometries; geometryIt++)
+    {
+        const SeMeshGeometry& geometry = mesh->geometries[geometryIt];
+        size_t numGeometryNodes = 0;
+        for (size_t nodeIt = 0; nodeIt < mesh->numNodes; nodeIt++)
+        {
+            if (!se_bm_get(geometry.nodes, nodeIt)) continue;
+            se_dynamic_array_push(cullNodes,
+            {
+                .modelTrf       = mesh->nodes[nodeIt].modelTrf,
+                .aabbMin        = { geometry.aabb.min.x, geometry.aabb.min.y, geometry.aabb.min.z, 1.0f },
+                .aabbMax        = { geometry.aabb.max.x, geometry.aabb.max.y, geometry.aabb.max.z, 1.0f },
+                .geometryIndex  = uint32_t(geometryIt),
+                .firstTransform = uint32_t(numTransforms),
+                ._pad           = { },
+            });
+            numGeometryNodes += 1;
+        }
+        if (!numGeometryNodes) continue;
+        culler->firstTransforms[geometryIt] = numTransforms;
+        culler->maxTransforms[geometryIt] = numGeometryNodes * info.maxInstances;
+        numTransforms += ((culler->maxTransforms[geometryIt] + SE_MESH_CULLING_TRANSFORMS_ALIGNMENT - 1) / SE_MESH_CULLING_TRANSFORMS_ALIGNMENT) * SE_MESH_CULLING_TRANSFORMS_ALIGNMENT;
+        se_assert_msg(numTransforms <= UINT32_MAX, "Too many instances for the mesh culler");
+    }
+    culler->numCullNodes = se_dynamic_array_size<uint32_t>(cullNodes);
+    se_assert_msg(culler->numCullNodes, "Mesh doesn't have any geometry referenced by nodes");
+
+    culler->cullNodesBuffer = se_render_memory_buffer({ se_data_provider_from_memory(se_dynamic_array_raw(cullNodes), se_dynamic_array_raw_size(cullNodes)) });
+    culler->transformsBuffer = se_render_memory_buffer({ se_data_provider_from_memory(nullptr, sizeof(SeFloat4x4) * numTransforms) });
+}
+
+void se_mesh_culler_destroy(SeMeshCuller* culler)
+{
+    se_render_destroy(culler->cullProgram);
+    se_render_destroy(culler->cullNodesBuffer);
+    se_render_destroy(culler->transformsBuffer);
+}
+
+SePassDependencies se_mesh_culler_cull(SeMeshCuller* culler, const SeMeshCullInfo& info)
+{
+    se_assert_msg(info.numInstances <= culler->maxInstances, "Number of instances exceeds SeMeshCullerInfo::maxInstances");
+    const SeMeshAssetValue* const mesh = culler->mesh;
+    //
+    // Instance counts are filled by the culling pass
+    //
+    SeDrawIndirectArgs drawArgs[SE_MESH_MAX_GEOMETRIES];
+    for (size_t it = 0; it < mesh->numGeometries; it++)
+    {
+        drawArgs[it] =
+        {
+            .numVertices    = mesh->geometries[it].numIndices,
+            .numInstances   = 0,
+            .firstVertex    = 0,
+            .firstInstance  = 0,
+        };
+    }
+    culler->drawArgsBuffer = se_render_scratch_memory_buffer({ se_data_provider_from_memory(drawArgs, sizeof(SeDrawIndirectArgs) * mesh->numGeometries) });
+    if (!info.numInstances) return info.dependencies;
+
+    SeMeshCullFrameData frameData
+    {
+        .viewProjection = info.viewProjectionMatrix,
+        .frustumPlanes  = { },
+        .numInstances   = info.numInstances,
+        .numCullNodes   = culler->numCullNodes,
+        ._pad           = { },
+    };
+    se_float4x4_get_frustum_planes(info.viewProjectionMatrix, frameData.frustumPlanes);
+    const SeBufferRef frameDataBuffer = se_render_scratch_memory_buffer({ se_data_provider_from_memory(frameData) });
+
+    const SePassDependencies dependencies = se_render_begin_compute_pass({ .dependencies = info.dependencies, .program = { culler->cullProgram } });
+    se_render_bind
+    ({
+        .set = 0,
+        .bindings =
+        {
+            { .binding = 0, .type = SeBinding::BUFFER, .buffer = { frameDataBuffer } },
+            { .binding = 1, .type = SeBinding::BUFFER, .buffer = { info.instances } },
+            { .binding = 2, .type = SeBinding::BUFFER, .buffer = { culler->cullNodesBuffer } },
+            { .binding = 3, .type = SeBinding::BUFFER, .buffer = { culler->transformsBuffer } },
+            { .binding = 4, .type = SeBinding::BUFFER, .buffer = { culler->drawArgsBuffer } },
+        }
+    });
+    const SeComputeWorkgroupSize workgroupSize = se_render_workgroup_size(culler->cullProgram);
+    se_render_dispatch({ 1 + ((info.numInstances - 1) / workgroupSize.x), culler->numCullNodes, 1 });
+    se_render_end_pass();
+    return dependencies;
+}
+
+SeMeshCulledGeometry se_mesh_culler_get_geometry(const SeMeshCuller* culler, size_t geometryIndex)
+{
+    se_assert(geometryIndex < culler->mesh->numGeometries);
+    se_assert_msg(culler->drawArgsBuffer, "se_mesh_culler_cull must be called before se_mesh_culler_get_geometry");
+    return
+    {
+        .geometry           = &culler->mesh->geometries[geometryIndex],
+        .transformsBuffer   = culler->transformsBuffer,
+        .transformsOffset   = sizeof(SeFloat4x4) * culler->firstTransforms[geometryIndex],
+        .transformsSize     = sizeof(SeFloat4x4) * culler->maxTransforms[geometryIndex],
+        .draw               =
+        {
+            .argsBuffer     = culler->drawArgsBuffer,
+            .argsOffset     = sizeof(SeDrawIndirectArgs) * geometryIndex,
+            .numDraws       = 1,
+        },
+    };
+}
@@ -0,0 +1,74 @@
+#ifndef _SE_MESH_CULLING_HPP_
+#define _SE_MESH_CULLING_HPP_
+
+/*
+    Gpu-driven culling of mesh instances.
+
+    Culler is created for a single mesh and does all per-instance work on the gpu :
+        - compute pass tests bounds of every (node, instance) pair against the view frustum
+        - visible pairs are compacted per geometry : workgroup computes prefix sum of visibility flags in shared memory
+          and reserves space for all of its visible pairs with a single atomic add to the instance count of the geometry's
+          indirect draw arguments
+        - mvp matrices of visible pairs are written to the transforms buffer, geometry draws them with a single indirect draw
+    Cpu only writes frustum planes and draw arguments (one per geometry), so its cost doesn't depend on the number of instances.
+    Instances are read from a buffer provided by the user, which can be filled once and reused across frames.
+
+    Usage :
+        const SePassDependencies cullDeps = se_mesh_culler_cull(&culler, { instancesBuffer, numInstances, viewProjection, 0 });
+        se_render_begin_graphics_pass({ .dependencies = cullDeps, ... });
+        for (size_t it = 0; it < mesh->numGeometries; it++)
+        {
+            const SeMeshCulledGeometry culled = se_mesh_culler_get_geometry(&culler, it);
+            // bind culled transforms range the same way as instance transforms of SeMeshIterator, then
+            se_render_draw_indirect(culled.draw);
+        }
+
+    Implementation notes:
+        - transforms are laid out exactly as SeMeshIterator's (transposed mvp matrices), so the same shaders can be used
+        - draw arguments live in the scratch memory, so geometries must be drawn in the same frame as the culling pass
+*/
+
+#include "se_mesh_asset.hpp"
+
+struct SeMeshCullerInfo
+{
+    const SeMeshAssetValue* mesh;
+    uint32_t                maxInstances;
+};
+
+struct SeMeshCullInfo
+{
+    SeBufferRef         instances;      // Array of SeMeshInstanceData
+    uint32_t            numInstances;
+    SeFloat4x4          viewProjectionMatrix;
+    SePassDependencies  dependencies;
+};
+
+struct SeMeshCulledGeometry
+{
+    const SeMeshGeometry*       geometry;
+    SeBufferRef                 transformsBuffer;   // Bind with transformsOffset and transformsSize
+    size_t                      transformsOffset;
+    size_t                      transformsSize;
+    SeCommandDrawIndirectInfo   draw;
+};
+
+struct SeMeshCuller
+{
+    const SeMeshAssetValue* mesh;
+    uint32_t                maxInstances;
+    uint32_t                numCullNodes;       // Number of (node, geometry) pairs
+    SeProgramRef            cullProgram;
+    SeBufferRef             cullNodesBuffer;
+    SeBufferRef             transformsBuffer;
+    SeBufferRef             drawArgsBuffer;     // Scratch buffer, valid only during the frame of the last se_mesh_culler_cull
+    size_t                  firstTransforms[SE_MESH_MAX_GEOMETRIES];
+    size_t                  maxTransforms[SE_MESH_MAX_GEOMETRIES];
+};
+
+void                    se_mesh_culler_construct(SeMeshCuller* culler, const SeMeshCullerInfo& info);
+void                    se_mesh_culler_destroy(SeMeshCuller* culler);
+SePassDependencies      se_mesh_culler_cull(SeMeshCuller* culler, const SeMeshCullInfo& info);
+SeMeshCulledGeometry    se_mesh_culler_get_geometry(const SeMeshCuller* culler, size_t geometryIndex);
+
+#endif
@@ -28,6 +28,15 @@ struct SeFileContent
     size_t dataSize;
 };
 
+// Read-only view of the whole file. Handles are windows HANDLEs
+struct SeFileMapping
+{
+    void*   data;
+    size_t  dataSize;
+    void*   fileHandle;
+    void*   mappingHandle;
+};
+
 enum struct SeFileWriteOpenMode
 {
     CLEAR,
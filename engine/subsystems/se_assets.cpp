@@ -257,3 +257,4 @@ void _se_asset_terminate()
 }
 
 #include "assets/se_mesh_asset.cpp"
+#include "assets/se_mesh_culling.cpp"
@@ -7,6 +7,7 @@
 
 #include "assets/se_asset_category.hpp"
 #include "assets/se_mesh_asset.hpp"
+#include "assets/se_mesh_culling.hpp"
 
 using SeAssetHandle = uint64_t;
 
@@ -398,6 +398,60 @@ void se_fs_file_content_free(SeFileContent& content)
     content = {};
 }
 
+SeFileMapping se_fs_file_map(SeFileHandle handle)
+{
+    const SeFileSystemFile& file = _se_fs_from_handle(handle);
+    se_assert_msg(file.ioState != SeFileSystemFile::IOState::OPEN_FOR_WRITE, "Can't map file with path {}. It's already open for write", file.fullPath);
+
+    const HANDLE winHandle = CreateFileW
+    (
+        se_stringw_cstr(file.fullPathW),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    se_assert_msg(winHandle != INVALID_HANDLE_VALUE, "Can't map file with path {}. Error code is {}", file.fullPath, GetLastError());
+
+    uint64_t fileSize = 0;
+    {
+        LARGE_INTEGER size = { };
+        const BOOL result = GetFileSizeEx(winHandle, &size);
+        se_assert(result);
+        fileSize = size.QuadPart;
+    }
+    // @NOTE : empty files can't be mapped
+    if (fileSize == 0)
+    {
+        CloseHandle(winHandle);
+        return { };
+    }
+
+    const HANDLE mappingHandle = CreateFileMappingW(winHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    se_assert_msg(mappingHandle, "Can't create file mapping for file with path {}. Error code is {}", file.fullPath, GetLastError());
+    void* const view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    se_assert_msg(view, "Can't map view of file with path {}. Error code is {}", file.fullPath, GetLastError());
+
+    return
+    {
+        view,
+        fileSize,
+        winHandle,
+        mappingHandle,
+    };
+}
+
+void se_fs_file_unmap(SeFileMapping& mapping)
+{
+    if (!mapping.data) return;
+    UnmapViewOfFile(mapping.data);
+    CloseHandle((HANDLE)mapping.mappingHandle);
+    CloseHandle((HANDLE)mapping.fileHandle);
+    mapping = {};
+}
+
 void se_fs_file_write_begin(SeFileHandle handle, SeFileWriteOpenMode openMode)
 {
     SeFileSystemFile& file = _se_fs_from_handle(handle);
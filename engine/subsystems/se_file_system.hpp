@@ -34,6 +34,9 @@ SeFolderHandle  se_fs_file_get_folder(SeFileHandle handle);
 SeFileContent   se_fs_file_read(SeFileHandle handle, const SeAllocatorBindings& bindings);
 void            se_fs_file_content_free(SeFileContent& content);
 
+SeFileMapping   se_fs_file_map(SeFileHandle handle);
+void            se_fs_file_unmap(SeFileMapping& mapping);
+
 void            se_fs_file_write_begin(SeFileHandle handle, SeFileWriteOpenMode openMode);
 void            se_fs_file_write(SeFileHandle handle, SeDataProvider data);
 void            se_fs_file_write_end(SeFileHandle handle);
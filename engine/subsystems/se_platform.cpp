@@ -134,6 +134,67 @@ inline bool se_platform_atomic_32_bit_cas(uint32_t* atomic, uint32_t* expected,
     return val == *expected;
 }
 
+inline size_t se_platform_get_num_logical_cores()
+{
+    SYSTEM_INFO sysInfo;
+    GetSystemInfo(&sysInfo);
+    return sysInfo.dwNumberOfProcessors;
+}
+
+DWORD WINAPI se_platform_thread_proc(LPVOID userData)
+{
+    const SePlatformThread* const thread = (const SePlatformThread*)userData;
+    thread->pfn(thread->userData);
+    return 0;
+}
+
+// @NOTE : thread object must stay alive (and must not be moved) until se_platform_thread_join is called
+inline void se_platform_thread_construct(SePlatformThread* thread, SePlatformThreadPfn pfn, void* userData)
+{
+    *thread =
+    {
+        .handle     = nullptr,
+        .pfn        = pfn,
+        .userData   = userData,
+    };
+    thread->handle = CreateThread(nullptr, 0, se_platform_thread_proc, thread, 0, nullptr);
+    se_assert_msg(thread->handle, "Unable to create thread. Error code is : {}", GetLastError());
+}
+
+inline void se_platform_thread_join(SePlatformThread* thread)
+{
+    WaitForSingleObject((HANDLE)thread->handle, INFINITE);
+    CloseHandle((HANDLE)thread->handle);
+    *thread = { };
+}
+
+inline void se_platform_thread_yield()
+{
+    SwitchToThread();
+}
+
+inline SePlatformSemaphore se_platform_semaphore_create(uint32_t maxCount)
+{
+    const HANDLE handle = CreateSemaphoreW(nullptr, 0, LONG(maxCount), nullptr);
+    se_assert_msg(handle, "Unable to create semaphore. Error code is : {}", GetLastError());
+    return { handle };
+}
+
+inline void se_platform_semaphore_destroy(SePlatformSemaphore semaphore)
+{
+    CloseHandle((HANDLE)semaphore.handle);
+}
+
+inline void se_platform_semaphore_signal(SePlatformSemaphore semaphore, uint32_t count)
+{
+    ReleaseSemaphore((HANDLE)semaphore.handle, LONG(count), nullptr);
+}
+
+inline void se_platform_semaphore_wait(SePlatformSemaphore semaphore)
+{
+    WaitForSingleObject((HANDLE)semaphore.handle, INFINITE);
+}
+
 inline size_t se_platform_wchar_to_utf8_required_length(const wchar_t* source, size_t sourceLength)
 {
     const int requiredLength = WideCharToMultiByte(CP_UTF8, 0, source, int(sourceLength), NULL, 0, NULL, NULL);
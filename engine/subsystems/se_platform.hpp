@@ -13,6 +13,20 @@ enum SeMemoryOrder
     SE_SEQUENTIALLY_CONSISTENT,
 };
 
+using SePlatformThreadPfn = void (*)(void* userData);
+
+struct SePlatformThread
+{
+    void*               handle;
+    SePlatformThreadPfn pfn;
+    void*               userData;
+};
+
+struct SePlatformSemaphore
+{
+    void* handle;
+};
+
 size_t          se_platform_get_mem_page_size       ();
 void*           se_platform_mem_reserve             (size_t size);
 void*           se_platform_mem_commit              (void* ptr, size_t size);
@@ -30,6 +44,14 @@ uint32_t        se_platform_atomic_32_bit_load      (const uint32_t* val, SeMemo
 uint32_t        se_platform_atomic_32_bit_store     (uint32_t* val, uint32_t newValue, SeMemoryOrder memoryOrder);
 bool            se_platform_atomic_32_bit_cas       (uint32_t* atomic, uint32_t* expected, uint32_t newValue, SeMemoryOrder memoryOrder);
 
+size_t              se_platform_get_num_logical_cores   ();
+void                se_platform_thread_construct        (SePlatformThread* thread, SePlatformThreadPfn pfn, void* userData);
+void                se_platform_thread_join             (SePlatformThread* thread);
+void                se_platform_thread_yield            ();
+SePlatformSemaphore se_platform_semaphore_create        (uint32_t maxCount);
+void                se_platform_semaphore_destroy       (SePlatformSemaphore semaphore);
+void                se_platform_semaphore_signal        (SePlatformSemaphore semaphore, uint32_t count);
+void                se_platform_semaphore_wait          (SePlatformSemaphore semaphore);
 
 size_t          se_platform_wchar_to_utf8_required_length   (const wchar_t* source, size_t sourceLength);
 void            se_platform_wchar_to_utf8                   (const wchar_t* source, size_t sourceLength, char* target, size_t targetLength);
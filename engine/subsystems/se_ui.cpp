@@ -938,10 +938,10 @@ struct SeUiRenderColorsUnpacked
     float           _pad[3];
 };
 
+// Push constants
 struct SeUiRenderDrawData
 {
     uint32_t    firstVertexIndex;
-    float       _pad[3];
 };
 
 struct SeUiDrawCall
@@ -1579,10 +1579,6 @@ SePassDependencies se_ui_end(SePassDependencies dependencies)
             se_float4x4_transposed(se_render_orthographic(0, se_win_get_width<float>(), 0, se_win_get_height<float>(), 0, 2))
         )
     });
-    const SeBufferRef drawDatasBuffer = se_render_scratch_memory_buffer
-    ({
-        se_data_provider_from_memory(se_dynamic_array_raw(g_uiCtx.frameDrawDatas), se_dynamic_array_raw_size(g_uiCtx.frameDrawDatas))
-    });
     const SeBufferRef verticesBuffer = se_render_scratch_memory_buffer
     ({
         se_data_provider_from_memory(se_dynamic_array_raw(g_uiCtx.frameVertices), se_dynamic_array_raw_size(g_uiCtx.frameVertices))
@@ -1602,7 +1598,7 @@ SePassDependencies se_ui_end(SePassDependencies dependencies)
         }
     });
     //
-    // Process draw calls
+    // Process draw calls. Per draw data goes to push constants, so draws with the same texture reuse the cached set
     //
     se_assert(se_dynamic_array_size(g_uiCtx.frameDrawCalls) == se_dynamic_array_size(g_uiCtx.frameDrawDatas));
     const size_t numDrawCalls = se_dynamic_array_size(g_uiCtx.frameDrawCalls);
@@ -1616,13 +1612,9 @@ SePassDependencies se_ui_end(SePassDependencies dependencies)
             .bindings =
             {
                 { .binding = 0, .type = SeBinding::TEXTURE, .texture = { drawCall.texture, g_uiCtx.sampler } },
-                { .binding = 1, .type = SeBinding::BUFFER, .buffer = {
-                    .buffer = drawDatasBuffer,
-                    .offset = drawCallIndex * sizeof(SeUiRenderDrawData),
-                    .size   = sizeof(SeUiRenderDrawData),
-                } },
             },
         });
+        se_render_push_constants({ se_data_provider_from_memory(g_uiCtx.frameDrawDatas[drawCallIndex]) });
         const uint32_t firstVertexIndex = g_uiCtx.frameDrawDatas[se_iterator_index(it)].firstVertexIndex;
         const uint32_t lastVertexIndex = drawCallIndex == (numDrawCalls - 1)
             ? se_dynamic_array_size<uint32_t>(g_uiCtx.frameVertices) - 1
@@ -0,0 +1,14 @@
+#version 450
+
+layout(push_constant) uniform BackgroundData { float time; };
+
+layout(location = 0) in vec2 inUv;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    vec2 p = inUv * 6.0;
+    float wave = sin(p.x * 0.7 + time * 0.3) * cos(p.y * 0.5 - time * 0.2);
+    outColor = vec4(0.05 + 0.05 * wave, 0.08 + 0.04 * wave, 0.15 + 0.1 * inUv.y, 1.0);
+}
@@ -0,0 +1,25 @@
+#version 450
+
+struct Particle
+{
+    vec2 position;
+    vec2 velocity;
+};
+
+layout (set = 0, binding = 0) readonly buffer Particles
+{
+    Particle particles[];
+};
+
+layout(location = 0) out vec3 outColor;
+
+const vec2 CORNERS[6] = vec2[](vec2(-1, -1), vec2(1, -1), vec2(1, 1), vec2(-1, -1), vec2(1, 1), vec2(-1, 1));
+const float PARTICLE_SIZE = 0.006;
+
+void main()
+{
+    Particle particle = particles[gl_InstanceIndex];
+    float speed = clamp(length(particle.velocity), 0.0, 1.0);
+    outColor = mix(vec3(0.3, 0.6, 1.0), vec3(1.0, 0.5, 0.2), speed);
+    gl_Position = vec4(particle.position + CORNERS[gl_VertexIndex] * PARTICLE_SIZE, 0.0, 1.0);
+}
@@ -0,0 +1,238 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+
+//
+// Async compute example. Particle simulation is a compute pass that requests the async compute queue, background is
+// rendered by graphics passes that don't depend on it, so both can run at the same time. Particles are drawn over the
+// background after the simulation is finished. Space toggles async compute (if device has an async compute queue),
+// ui shows how many passes ran on the async compute queue and how many semaphore waits were needed between queues.
+//
+// Queue scheduler itself is checked without a device in checks/queue_scheduler.
+//
+
+constexpr uint32_t NUM_PARTICLES = 4096;
+constexpr uint32_t PARTICLE_VERTICES = 6; // Every particle is a quad
+
+struct Particle
+{
+    float position[2];
+    float velocity[2];
+};
+
+SeDataProvider g_fontDataEnglish;
+SeProgramRef g_fullscreenVs;
+SeProgramRef g_backgroundFs;
+SeProgramRef g_compositeFs;
+SeProgramRef g_simulateCs;
+SeProgramRef g_particleVs;
+SeProgramRef g_particleFs;
+SeSamplerRef g_sampler;
+SeBufferRef g_particlesBuffer;
+SeTextureRef g_backgroundTexture;
+float g_time = 0.0f;
+bool g_isAsyncComputeSupported;
+bool g_isAsyncComputeEnabled;
+
+//
+// Rendering
+//
+
+void create_background_texture(uint32_t width, uint32_t height)
+{
+    // @NOTE : transient textures always stay on the graphics queue, this one is persistent only to keep example simple
+    g_backgroundTexture = se_render_texture
+    ({
+        .format     = SeTextureFormat::RGBA_8_UNORM,
+        .width      = width,
+        .height     = height,
+    });
+}
+
+void init()
+{
+    g_fontDataEnglish = se_data_provider_from_file("shahd serif.ttf");
+    g_fullscreenVs = se_render_program({ se_data_provider_from_file("fullscreen.vert.spv") });
+    g_backgroundFs = se_render_program({ se_data_provider_from_file("background.frag.spv") });
+    g_compositeFs = se_render_program({ se_data_provider_from_file("composite.frag.spv") });
+    g_simulateCs = se_render_program({ se_data_provider_from_file("simulate.comp.spv") });
+    g_particleVs = se_render_program({ se_data_provider_from_file("particle.vert.spv") });
+    g_particleFs = se_render_program({ se_data_provider_from_file("particle.frag.spv") });
+    g_sampler = se_render_sampler
+    ({
+        .magFilter          = SeSamplerFilter::LINEAR,
+        .minFilter          = SeSamplerFilter::LINEAR,
+        .addressModeU       = SeSamplerAddressMode::CLAMP_TO_EDGE,
+        .addressModeV       = SeSamplerAddressMode::CLAMP_TO_EDGE,
+        .addressModeW       = SeSamplerAddressMode::CLAMP_TO_EDGE,
+        .mipmapMode         = SeSamplerMipmapMode::NEAREST,
+        .mipLodBias         = 0.0f,
+        .minLod             = 0.0f,
+        .maxLod             = 0.0f,
+        .anisotropyEnable   = false,
+        .maxAnisotropy      = 0.0f,
+        .compareEnabled     = false,
+        .compareOp          = SeCompareOp::ALWAYS,
+    });
+    //
+    // Particles start at random positions with random velocities in normalized device coordinates
+    //
+    Particle* const particles = (Particle*)se_alloc(se_allocator_frame(), sizeof(Particle) * NUM_PARTICLES, se_alloc_tag);
+    uint32_t seed = 12345;
+    const auto next = [&seed]() -> float
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return float(seed >> 8) / float(1 << 24) * 2.0f - 1.0f;
+    };
+    for (uint32_t it = 0; it < NUM_PARTICLES; it++)
+    {
+        particles[it] =
+        {
+            .position = { next(), next() },
+            .velocity = { next() * 0.5f, next() * 0.5f },
+        };
+    }
+    g_particlesBuffer = se_render_memory_buffer({ se_data_provider_from_memory(particles, sizeof(Particle) * NUM_PARTICLES) });
+    create_background_texture(se_win_get_width(), se_win_get_height());
+
+    g_isAsyncComputeSupported = se_render_is_async_compute_supported();
+    g_isAsyncComputeEnabled = g_isAsyncComputeSupported;
+}
+
+void terminate()
+{
+
+}
+
+SeGraphicsPassInfo graphics_pass_info(SeProgramRef vertexProgram, SeProgramRef fragmentProgram, SePassDependencies dependencies)
+{
+    return
+    {
+        .dependencies           = dependencies,
+        .vertexProgram          = { .program = vertexProgram, },
+        .fragmentProgram        = { .program = fragmentProgram, },
+        .frontStencilOpState    = { .isEnabled = false, },
+        .backStencilOpState     = { .isEnabled = false, },
+        .depthState             = { .isTestEnabled = false, .isWriteEnabled = false, },
+        .polygonMode            = SePipelinePolygonMode::FILL,
+        .cullMode               = SePipelineCullMode::NONE,
+        .frontFace              = SePipelineFrontFace::CLOCKWISE,
+        .samplingType           = SeSamplingType::_1,
+        .renderTargets          = { },
+        .depthStencilTarget     = { },
+    };
+}
+
+void update(const SeUpdateInfo& info)
+{
+    if (se_win_is_close_button_pressed() || se_win_is_keyboard_button_pressed(SeKeyboard::ESCAPE)) se_engine_stop();
+    if (g_isAsyncComputeSupported && se_win_is_keyboard_button_just_pressed(SeKeyboard::SPACE))
+    {
+        g_isAsyncComputeEnabled = !g_isAsyncComputeEnabled;
+        se_render_set_async_compute(g_isAsyncComputeEnabled);
+    }
+    g_time += info.dt;
+
+    if (se_render_begin_frame())
+    {
+        const SeTextureSize swapChainSize = se_render_texture_size(se_render_swap_chain_texture());
+        if (!se_compare(se_render_texture_size(g_backgroundTexture), swapChainSize))
+        {
+            se_render_destroy(g_backgroundTexture);
+            create_background_texture(uint32_t(swapChainSize.width), uint32_t(swapChainSize.height));
+        }
+        //
+        // Background pass is the first group of the frame, so it always runs on the graphics queue
+        //
+        SeGraphicsPassInfo backgroundPassInfo = graphics_pass_info(g_fullscreenVs, g_backgroundFs, 0);
+        backgroundPassInfo.renderTargets[0] = { g_backgroundTexture, SeRenderTargetLoadOp::DONT_CARE };
+        const SePassDependencies backgroundPass = se_render_begin_graphics_pass(backgroundPassInfo);
+        se_render_push_constants({ se_data_provider_from_memory(&g_time, sizeof(g_time)) });
+        se_render_draw({ .numVertices = 3, .numInstances = 1 });
+        se_render_end_pass();
+        //
+        // Simulation doesn't depend on the background, so it can overlap with the composite pass
+        //
+        const float dt = se_min(info.dt, 0.1f);
+        const SePassDependencies simulationPass = se_render_begin_compute_pass
+        ({
+            .dependencies       = 0,
+            .program            = { .program = g_simulateCs, },
+            .compilationPolicy  = SePipelineCompilationPolicy::WAIT,
+            .isAsyncCompute     = true,
+        });
+        se_render_push_constants({ se_data_provider_from_memory(&dt, sizeof(dt)) });
+        se_render_bind({ .set = 0, .bindings = { { .binding = 0, .type = SeBinding::BUFFER, .buffer = { g_particlesBuffer } } } });
+        se_render_dispatch({ .groupCountX = NUM_PARTICLES / 64, .groupCountY = 1, .groupCountZ = 1 });
+        se_render_end_pass();
+
+        SeGraphicsPassInfo compositePassInfo = graphics_pass_info(g_fullscreenVs, g_compositeFs, backgroundPass);
+        compositePassInfo.renderTargets[0] = { se_render_swap_chain_texture(), SeRenderTargetLoadOp::CLEAR };
+        const SePassDependencies compositePass = se_render_begin_graphics_pass(compositePassInfo);
+        se_render_bind({ .set = 0, .bindings = { { .binding = 0, .type = SeBinding::TEXTURE, .texture = { g_backgroundTexture, g_sampler } } } });
+        se_render_draw({ .numVertices = 3, .numInstances = 1 });
+        se_render_end_pass();
+
+        SeGraphicsPassInfo particlesPassInfo = graphics_pass_info(g_particleVs, g_particleFs, compositePass | simulationPass);
+        particlesPassInfo.renderTargets[0] = { se_render_swap_chain_texture(), SeRenderTargetLoadOp::LOAD };
+        const SePassDependencies particlesPass = se_render_begin_graphics_pass(particlesPassInfo);
+        se_render_bind({ .set = 0, .bindings = { { .binding = 0, .type = SeBinding::BUFFER, .buffer = { g_particlesBuffer } } } });
+        se_render_draw({ .numVertices = PARTICLE_VERTICES, .numInstances = NUM_PARTICLES });
+        se_render_end_pass();
+
+        if (se_ui_begin({ se_render_swap_chain_texture(), SeRenderTargetLoadOp::LOAD }))
+        {
+            se_ui_set_font_group({ g_fontDataEnglish });
+
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_X, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_Y, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_X, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_Y, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::FONT_HEIGHT, { .dim = 20.0f });
+            se_ui_set_param(SeUiParam::FONT_LINE_GAP, { .dim = 2.0f });
+
+            if (se_ui_begin_window
+            ({
+                .uid    = "Stats",
+                .width  = se_win_get_width<float>(),
+                .height = 60.0f,
+                .flags  = 0,
+            }))
+            {
+                const SeCommandRecordingStats stats = se_render_command_recording_stats();
+                const SeString mode = se_string_create_fmt
+                (
+                    SeStringLifetime::TEMPORARY,
+                    "Async compute : {}",
+                    g_isAsyncComputeEnabled ? "enabled (space to disable)" : (g_isAsyncComputeSupported ? "disabled (space to enable)" : "not supported")
+                );
+                const SeString queues = se_string_create_fmt
+                (
+                    SeStringLifetime::TEMPORARY,
+                    "{} async compute passes, {} cross queue waits",
+                    stats.numAsyncComputePasses, stats.numCrossQueueWaits
+                );
+                se_ui_text({ .utf8text = se_string_cstr(mode) });
+                se_ui_text({ .utf8text = se_string_cstr(queues) });
+                se_ui_end_window();
+            }
+
+            se_ui_end(particlesPass);
+        }
+        se_render_end_frame();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const SeSettings settings
+    {
+        .applicationName        = "Sabrina engine - async compute example",
+        .isFullscreenWindow     = false,
+        .isResizableWindow      = true,
+        .windowWidth            = 800,
+        .windowHeight           = 480,
+        .createUserDataFolder   = false,
+    };
+    se_engine_run(settings, init, update, terminate);
+    return 0;
+}
@@ -0,0 +1,18 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec2 inUv;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) flat in uint inTexture;
+layout(location = 3) flat in uint inSampler;
+
+layout(location = 0) out vec4 outColor;
+
+// Bindless heap (SE_BINDLESS_SET, SE_BINDLESS_TEXTURES_BINDING and SE_BINDLESS_SAMPLERS_BINDING)
+layout(set = 7, binding = 1) uniform texture2D se_textures[];
+layout(set = 7, binding = 2) uniform sampler se_samplers[];
+
+void main()
+{
+    outColor = inColor * texture(sampler2D(se_textures[nonuniformEXT(inTexture)], se_samplers[nonuniformEXT(inSampler)]), inUv);
+}
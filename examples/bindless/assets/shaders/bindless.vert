@@ -0,0 +1,54 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+struct InputVertex
+{
+    vec3 positionLS;
+    vec2 uv;
+    vec4 color;
+};
+
+struct DrawData
+{
+    uint transformBuffer;
+    uint texture;
+    uint sampler;
+    uint pad;
+};
+
+layout (set = 0, binding = 0) uniform FrameData
+{
+    mat4x4 viewProjection;
+} se_frameData;
+
+layout(std140, set = 1, binding = 0) readonly buffer InputGeometry
+{
+    InputVertex vertices[];
+} se_inputGeometry;
+
+layout(std430, set = 1, binding = 1) readonly buffer InputDraws
+{
+    DrawData draws[];
+} se_inputDraws;
+
+// Bindless heap (SE_BINDLESS_SET, SE_BINDLESS_BUFFERS_BINDING)
+layout(std140, set = 7, binding = 0) readonly buffer InputTransform
+{
+    mat4x4 transformWS;
+} se_transforms[];
+
+layout (location = 0) out vec2 outUv;
+layout (location = 1) out vec4 outColor;
+layout (location = 2) flat out uint outTexture;
+layout (location = 3) flat out uint outSampler;
+
+void main()
+{
+    DrawData draw = se_inputDraws.draws[gl_InstanceIndex];
+    InputVertex vert = se_inputGeometry.vertices[gl_VertexIndex];
+    gl_Position = se_frameData.viewProjection * se_transforms[nonuniformEXT(draw.transformBuffer)].transformWS * vec4(vert.positionLS, 1);
+    outUv = vert.uv;
+    outColor = vert.color;
+    outTexture = draw.texture;
+    outSampler = draw.sampler;
+}
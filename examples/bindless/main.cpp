@@ -0,0 +1,236 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+
+//
+// Bindless example. Every instance has its own transform buffer, texture and sampler, but all of them are drawn with
+// a single draw call and two bind commands per frame : per-instance resources are accessed through the bindless heap
+// by indices stored in the draw data buffer.
+//
+
+struct FrameData
+{
+    SeFloat4x4 viewProjection;
+};
+
+struct InputVertex
+{
+    SeFloat3    positionLS;
+    float       pad1;
+    SeFloat2    uv;
+    float       pad2[2];
+    SeFloat4    color;
+};
+
+struct InputTransform
+{
+    SeFloat4x4 trfWS;
+};
+
+struct DrawData
+{
+    uint32_t transformBuffer;
+    uint32_t texture;
+    uint32_t sampler;
+    uint32_t pad;
+};
+
+constexpr size_t GRID_SIZE = 16;
+constexpr size_t NUM_INSTANCES = GRID_SIZE * GRID_SIZE;
+constexpr size_t NUM_TEXTURES = 8;
+constexpr size_t TEXTURE_SIZE = 4;
+
+SeDataProvider g_fontDataEnglish;
+SeDataProvider g_vertexProgramData;
+SeDataProvider g_fragmentProgramData;
+
+void init()
+{
+    g_fontDataEnglish = se_data_provider_from_file("shahd serif.ttf");
+    g_vertexProgramData = se_data_provider_from_file("bindless.vert.spv");
+    g_fragmentProgramData = se_data_provider_from_file("bindless.frag.spv");
+}
+
+void terminate()
+{
+
+}
+
+SeSamplerRef create_sampler(SeSamplerFilter filter)
+{
+    return se_render_sampler
+    ({
+        .magFilter          = filter,
+        .minFilter          = filter,
+        .addressModeU       = SeSamplerAddressMode::REPEAT,
+        .addressModeV       = SeSamplerAddressMode::REPEAT,
+        .addressModeW       = SeSamplerAddressMode::REPEAT,
+        .mipmapMode         = SeSamplerMipmapMode::NEAREST,
+        .mipLodBias         = 0.0f,
+        .minLod             = 0.0f,
+        .maxLod             = 0.0f,
+        .anisotropyEnable   = false,
+        .maxAnisotropy      = 0.0f,
+        .compareEnabled     = false,
+        .compareOp          = SeCompareOp::ALWAYS,
+    });
+}
+
+SeTextureRef create_checker_texture(size_t index)
+{
+    uint32_t pixels[TEXTURE_SIZE * TEXTURE_SIZE];
+    const uint32_t color = 0xFF000000 | (uint32_t(((index >> 0) & 1) * 0xFF) << 0) | (uint32_t(((index >> 1) & 1) * 0xFF) << 8) | (uint32_t(((index >> 2) & 1) * 0xFF) << 16);
+    for (size_t y = 0; y < TEXTURE_SIZE; y++)
+        for (size_t x = 0; x < TEXTURE_SIZE; x++)
+        {
+            pixels[y * TEXTURE_SIZE + x] = ((x + y) & 1) ? color : 0xFF404040;
+        }
+    // @NOTE : texture data is copied to the upload buffer right away, so it can live on the stack
+    return se_render_texture
+    ({
+        .format         = SeTextureFormat::RGBA_8_UNORM,
+        .width          = TEXTURE_SIZE,
+        .height         = TEXTURE_SIZE,
+        .data           = se_data_provider_from_memory(pixels, sizeof(pixels)),
+        .generateMips   = false,
+    });
+}
+
+SePassDependencies draw_instances()
+{
+    static const InputVertex vertices[] =
+    {
+        { .positionLS = { -0.04f, -0.04f, 3 }, .uv = { 0, 0 }, .color = { 1.0f, 1.0f, 1.0f, 1.0f, } },
+        { .positionLS = {  0.04f, -0.04f, 3 }, .uv = { 1, 0 }, .color = { 1.0f, 1.0f, 1.0f, 1.0f, } },
+        { .positionLS = { -0.04f,  0.04f, 3 }, .uv = { 0, 1 }, .color = { 1.0f, 1.0f, 1.0f, 1.0f, } },
+        { .positionLS = {  0.04f, -0.04f, 3 }, .uv = { 1, 0 }, .color = { 1.0f, 1.0f, 1.0f, 1.0f, } },
+        { .positionLS = {  0.04f,  0.04f, 3 }, .uv = { 1, 1 }, .color = { 1.0f, 1.0f, 1.0f, 1.0f, } },
+        { .positionLS = { -0.04f,  0.04f, 3 }, .uv = { 0, 1 }, .color = { 1.0f, 1.0f, 1.0f, 1.0f, } },
+    };
+    static const float aspect = ((float)se_win_get_width()) / ((float)se_win_get_height());
+    static const FrameData frameData
+    {
+        .viewProjection = se_float4x4_transposed
+        (
+            se_float4x4_mul
+            (
+                se_render_perspective(60, aspect, 0.1f, 100.0f),
+                se_float4x4_inverted(se_float4x4_look_at({ 0, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 }))
+            )
+        ),
+    };
+    static const SeProgramRef vertexProgram = se_render_program({ g_vertexProgramData });
+    static const SeProgramRef fragmentProgram = se_render_program({ g_fragmentProgramData });
+    static const SeBufferRef frameDataBuffer = se_render_memory_buffer({ se_data_provider_from_memory(&frameData, sizeof(frameData)) });
+    static const SeBufferRef verticesBuffer = se_render_memory_buffer({ se_data_provider_from_memory(vertices, sizeof(vertices)) });
+    static SeBufferRef drawDataBuffer = { };
+    if (!drawDataBuffer)
+    {
+        //
+        // Resources are never bound directly, only their bindless indices are stored in the draw data
+        //
+        const SeSamplerRef samplers[] = { create_sampler(SeSamplerFilter::NEAREST), create_sampler(SeSamplerFilter::LINEAR) };
+        SeTextureRef textures[NUM_TEXTURES];
+        for (size_t it = 0; it < NUM_TEXTURES; it++) textures[it] = create_checker_texture(it);
+        DrawData draws[NUM_INSTANCES];
+        for (size_t it = 0; it < NUM_INSTANCES; it++)
+        {
+            const float x = (float(it % GRID_SIZE) - float(GRID_SIZE - 1) * 0.5f) * 0.1f;
+            const float y = (float(it / GRID_SIZE) - float(GRID_SIZE - 1) * 0.5f) * 0.1f;
+            const InputTransform transform { .trfWS = se_float4x4_transposed(se_float4x4_from_position({ x, y, 0.0f })) };
+            const SeBufferRef transformBuffer = se_render_memory_buffer({ se_data_provider_from_memory(&transform, sizeof(transform)) });
+            draws[it] =
+            {
+                .transformBuffer    = se_render_bindless_index(transformBuffer),
+                .texture            = se_render_bindless_index(textures[(it + it / GRID_SIZE) % NUM_TEXTURES]),
+                .sampler            = se_render_bindless_index(samplers[(it / GRID_SIZE) % se_array_size(samplers)]),
+                .pad                = 0,
+            };
+        }
+        drawDataBuffer = se_render_memory_buffer({ se_data_provider_from_memory(draws, sizeof(draws)) });
+    }
+
+    const SePassDependencies pass = se_render_begin_graphics_pass
+    ({
+        .dependencies           = 0,
+        .vertexProgram          = { .program = vertexProgram, },
+        .fragmentProgram        = { .program = fragmentProgram, },
+        .frontStencilOpState    = { .isEnabled = false, },
+        .backStencilOpState     = { .isEnabled = false, },
+        .depthState             = { .isTestEnabled = false, .isWriteEnabled = false, },
+        .polygonMode            = SePipelinePolygonMode::FILL,
+        .cullMode               = SePipelineCullMode::NONE,
+        .frontFace              = SePipelineFrontFace::CLOCKWISE,
+        .samplingType           = SeSamplingType::_1,
+        .renderTargets          = { { se_render_swap_chain_texture(), SeRenderTargetLoadOp::CLEAR } },
+        .depthStencilTarget     = { },
+    });
+    se_render_bind({ .set = 0, .bindings = { { .binding = 0, .type = SeBinding::BUFFER, .buffer = { frameDataBuffer } } } });
+    se_render_bind({ .set = 1, .bindings =
+    {
+        { .binding = 0, .type = SeBinding::BUFFER, .buffer = { verticesBuffer } },
+        { .binding = 1, .type = SeBinding::BUFFER, .buffer = { drawDataBuffer } }
+    } });
+    se_render_draw({ .numVertices = se_array_size(vertices), .numInstances = NUM_INSTANCES });
+    se_render_end_pass();
+    return pass;
+}
+
+void update(const SeUpdateInfo& info)
+{
+    if (se_win_is_close_button_pressed() || se_win_is_keyboard_button_pressed(SeKeyboard::ESCAPE)) se_engine_stop();
+
+    if (se_render_begin_frame())
+    {
+        const bool isBindlessSupported = se_render_is_bindless_supported();
+        const SePassDependencies pass = isBindlessSupported ? draw_instances() : 0;
+        if (se_ui_begin({ se_render_swap_chain_texture(), isBindlessSupported ? SeRenderTargetLoadOp::LOAD : SeRenderTargetLoadOp::CLEAR }))
+        {
+            se_ui_set_font_group({ g_fontDataEnglish });
+
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_X, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_Y, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_X, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_Y, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::FONT_HEIGHT, { .dim = 20.0f });
+            se_ui_set_param(SeUiParam::FONT_LINE_GAP, { .dim = 2.0f });
+
+            if (se_ui_begin_window
+            ({
+                .uid    = "Info",
+                .width  = se_win_get_width<float>(),
+                .height = 40.0f,
+                .flags  = 0,
+            }))
+            {
+                if (isBindlessSupported)
+                {
+                    const SeString text = se_string_create_fmt(SeStringLifetime::TEMPORARY, "{} instances, 1 draw, {} bind commands", NUM_INSTANCES, se_render_descriptor_set_stats().numBinds);
+                    se_ui_text({ .utf8text = se_string_cstr(text) });
+                }
+                else
+                {
+                    se_ui_text({ .utf8text = "Bindless mode is not supported by the device" });
+                }
+                se_ui_end_window();
+            }
+
+            se_ui_end(pass);
+        }
+        se_render_end_frame();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const SeSettings settings
+    {
+        .applicationName        = "Sabrina engine - bindless example",
+        .isFullscreenWindow     = false,
+        .isResizableWindow      = false,
+        .windowWidth            = 800,
+        .windowHeight           = 480,
+        .createUserDataFolder   = false,
+    };
+    se_engine_run(settings, init, update, terminate);
+    return 0;
+}
@@ -0,0 +1,338 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+
+//
+// Aabb tree benchmark. For every object count the tree is filled with randomly placed instances (object density
+// stays the same), then for a number of frames a part of instances moves and the tree is updated and queried with
+// the camera frustum, batches of rays and batches of overlap boxes. After that the tree is rebuilt with the surface
+// area heuristic and the same queries are measured again for the static tree. Brute force frustum culling of all
+// instances (see se_frustum_culling.hpp) is measured for comparison. Every result line also has tree height and
+// the ratio of the total node area to the root area, which shows how much rebuilding improves the tree.
+// Visible counts are only printed here, tree invariants and query results are verified by checks/aabb_tree.
+//
+// Proxy user data is the index of the instance, so visible proxies are turned back into SeMeshInstanceData
+// that can be passed to SeMeshIterator.
+//
+
+constexpr size_t OBJECT_COUNTS[] = { 10000, 100000, 1000000 };
+constexpr size_t FRAMES_PER_MEASUREMENT = 30;
+constexpr size_t MOVING_OBJECTS_RATIO = 10; // every 10th object moves every frame
+constexpr size_t NUM_RAYS = 64;
+constexpr size_t NUM_OVERLAPS = 64;
+constexpr float OBJECT_SPACING = 10.0f;
+constexpr float FAT_MARGIN = 0.5f;
+
+enum struct BenchmarkStage
+{
+    FILL,
+    DYNAMIC,
+    STATIC,
+    FINISHED,
+};
+
+struct Timings
+{
+    double updateMs;
+    double frustumMs;
+    double bruteForceMs;
+    double raysMs;
+    double overlapsMs;
+    size_t numReinserted;
+    size_t numVisible;
+    size_t numBruteForceVisible;
+    size_t numRayHits;
+    size_t numOverlapHits;
+};
+
+SeDataProvider g_fontDataEnglish;
+
+BenchmarkStage g_stage = BenchmarkStage::FILL;
+size_t g_countIndex;
+size_t g_numMeasuredFrames;
+SeAabbTree g_tree;
+SeDynamicArray<SeMeshInstanceData> g_instances;
+SeDynamicArray<uint32_t> g_proxies;
+double g_fillMs;
+double g_rebuildMs;
+Timings g_timings;
+SeString g_resultStrings[se_array_size(OBJECT_COUNTS) * 2];
+
+uint32_t g_seed = 0x12345678;
+
+float random01()
+{
+    g_seed ^= g_seed << 13;
+    g_seed ^= g_seed >> 17;
+    g_seed ^= g_seed << 5;
+    return float(g_seed & 0xFFFFFF) / float(0xFFFFFF);
+}
+
+double ms_since(uint64_t begin)
+{
+    return double(_se_get_perf_counter() - begin) * 1000.0 / double(_se_get_perf_frequency());
+}
+
+float world_size(size_t numObjects)
+{
+    return cbrtf(float(numObjects)) * OBJECT_SPACING;
+}
+
+SeAabb instance_aabb(const SeMeshInstanceData& instance)
+{
+    static const SeAabb UNIT_BOX = { { -1, -1, -1 }, { 1, 1, 1 } };
+    return se_aabb_transformed(UNIT_BOX, instance.transformWs);
+}
+
+void init()
+{
+    g_fontDataEnglish = se_data_provider_from_file("shahd serif.ttf");
+}
+
+void terminate()
+{
+    if (g_stage != BenchmarkStage::FILL && g_stage != BenchmarkStage::FINISHED)
+    {
+        se_aabb_tree_destroy(&g_tree);
+        se_dynamic_array_destroy(g_instances);
+        se_dynamic_array_destroy(g_proxies);
+    }
+    for (size_t it = 0; it < se_array_size(g_resultStrings); it++)
+    {
+        if (g_resultStrings[it].memory) se_string_destroy(g_resultStrings[it]);
+    }
+}
+
+void fill(size_t numObjects)
+{
+    const SeAllocatorBindings allocator = se_allocator_persistent();
+    const float worldSize = world_size(numObjects);
+    g_instances = se_dynamic_array_create<SeMeshInstanceData>(allocator, numObjects);
+    g_proxies = se_dynamic_array_create<uint32_t>(allocator, numObjects);
+    for (size_t it = 0; it < numObjects; it++)
+    {
+        const SeFloat3 position = { (random01() - 0.5f) * worldSize, (random01() - 0.5f) * worldSize, (random01() - 0.5f) * worldSize };
+        const SeFloat3 rotation = { random01() * 360.0f, random01() * 360.0f, random01() * 360.0f };
+        se_dynamic_array_push(g_instances, { se_float4x4_mul(se_float4x4_from_position(position), se_float4x4_from_rotation(rotation)) });
+    }
+
+    const uint64_t begin = _se_get_perf_counter();
+    se_aabb_tree_construct(&g_tree, { .allocator = allocator, .capacity = numObjects, .fatMargin = FAT_MARGIN });
+    for (size_t it = 0; it < numObjects; it++)
+    {
+        se_dynamic_array_push(g_proxies, se_aabb_tree_insert(&g_tree, instance_aabb(g_instances[it]), it));
+    }
+    g_fillMs = ms_since(begin);
+}
+
+void move_and_update(size_t frame)
+{
+    const size_t numObjects = se_dynamic_array_size(g_instances);
+    for (size_t it = frame % MOVING_OBJECTS_RATIO; it < numObjects; it += MOVING_OBJECTS_RATIO)
+    {
+        SeFloat4x4& trf = g_instances[it].transformWs;
+        trf.m[0][3] += random01() - 0.5f;
+        trf.m[1][3] += random01() - 0.5f;
+        trf.m[2][3] += random01() - 0.5f;
+    }
+    const uint64_t begin = _se_get_perf_counter();
+    for (size_t it = frame % MOVING_OBJECTS_RATIO; it < numObjects; it += MOVING_OBJECTS_RATIO)
+    {
+        g_timings.numReinserted += se_aabb_tree_update(&g_tree, g_proxies[it], instance_aabb(g_instances[it])) ? 1 : 0;
+    }
+    g_timings.updateMs += ms_since(begin);
+}
+
+void query(size_t frame)
+{
+    const size_t numObjects = se_dynamic_array_size(g_instances);
+    const float worldSize = world_size(numObjects);
+    const SeAllocatorBindings allocator = se_allocator_frame();
+    //
+    // Frustum : visible proxies are gathered back to instance data, the same as brute force culling does
+    //
+    const float aspect = se_win_get_width<float>() / se_win_get_height<float>();
+    const float angle = float(frame) * 0.05f;
+    const SeFloat4x4 view = se_float4x4_look_at({ 0, 0, 0 }, { sinf(angle), 0, cosf(angle) }, { 0, 1, 0 });
+    const SeFloat4x4 viewProjection = se_render_perspective(60, aspect, 0.1f, worldSize * 0.5f) * se_float4x4_inverted(view);
+    SeAabbTreeFrustum frustum;
+    se_float4x4_get_frustum_planes(viewProjection, frustum.planes);
+    {
+        SeDynamicArray<uint32_t> visible = se_dynamic_array_create<uint32_t>(allocator, numObjects);
+        SeDynamicArray<SeMeshInstanceData> visibleInstances = se_dynamic_array_create<SeMeshInstanceData>(allocator, numObjects);
+        const uint64_t begin = _se_get_perf_counter();
+        se_aabb_tree_query_frustum(&g_tree, frustum, visible);
+        const size_t numVisible = se_dynamic_array_size(visible);
+        for (size_t it = 0; it < numVisible; it++)
+        {
+            se_dynamic_array_push(visibleInstances, g_instances[se_aabb_tree_user_data(&g_tree, visible[it])]);
+        }
+        g_timings.frustumMs += ms_since(begin);
+        g_timings.numVisible = se_dynamic_array_size(visibleInstances);
+    }
+    {
+        uint32_t* const visible = (uint32_t*)se_alloc(allocator, sizeof(uint32_t) * numObjects, se_alloc_tag);
+        SeDynamicArray<SeMeshInstanceData> visibleInstances = se_dynamic_array_create<SeMeshInstanceData>(allocator, numObjects);
+        const SeAabb unitBox = { { -1, -1, -1 }, { 1, 1, 1 } };
+        const uint64_t begin = _se_get_perf_counter();
+        const size_t numVisible = se_frustum_cull(frustum.planes, unitBox, se_dynamic_array_raw(g_instances), sizeof(SeMeshInstanceData), numObjects, visible);
+        for (size_t it = 0; it < numVisible; it++)
+        {
+            se_dynamic_array_push(visibleInstances, g_instances[visible[it]]);
+        }
+        g_timings.bruteForceMs += ms_since(begin);
+        g_timings.numBruteForceVisible = numVisible;
+    }
+    //
+    // Rays go through the whole world from random points on one side to random points on the other side
+    //
+    {
+        SeAabbTreeRay rays[NUM_RAYS];
+        SeAabbTreeQueryRange ranges[NUM_RAYS];
+        for (size_t it = 0; it < NUM_RAYS; it++)
+        {
+            const SeFloat3 from = { (random01() - 0.5f) * worldSize, (random01() - 0.5f) * worldSize, -worldSize };
+            const SeFloat3 to = { (random01() - 0.5f) * worldSize, (random01() - 0.5f) * worldSize, worldSize };
+            rays[it] = { .origin = from, .direction = to - from, .maxDistance = 1.0f };
+        }
+        SeDynamicArray<uint32_t> hits = se_dynamic_array_create<uint32_t>(allocator, 1024);
+        const uint64_t begin = _se_get_perf_counter();
+        se_aabb_tree_query_rays(&g_tree, rays, NUM_RAYS, hits, ranges);
+        g_timings.raysMs += ms_since(begin);
+        g_timings.numRayHits = se_dynamic_array_size(hits);
+    }
+    {
+        SeAabb boxes[NUM_OVERLAPS];
+        SeAabbTreeQueryRange ranges[NUM_OVERLAPS];
+        for (size_t it = 0; it < NUM_OVERLAPS; it++)
+        {
+            const SeFloat3 center = { (random01() - 0.5f) * worldSize, (random01() - 0.5f) * worldSize, (random01() - 0.5f) * worldSize };
+            const float halfSize = OBJECT_SPACING * 2.0f;
+            boxes[it] = { center - SeFloat3{ halfSize, halfSize, halfSize }, center + SeFloat3{ halfSize, halfSize, halfSize } };
+        }
+        SeDynamicArray<uint32_t> hits = se_dynamic_array_create<uint32_t>(allocator, 1024);
+        const uint64_t begin = _se_get_perf_counter();
+        se_aabb_tree_query_overlaps(&g_tree, boxes, NUM_OVERLAPS, hits, ranges);
+        g_timings.overlapsMs += ms_since(begin);
+        g_timings.numOverlapHits = se_dynamic_array_size(hits);
+    }
+}
+
+void store_result(bool isStatic)
+{
+    const double numFrames = double(g_numMeasuredFrames);
+    const size_t numObjects = se_dynamic_array_size(g_instances);
+    SeString& result = g_resultStrings[g_countIndex * 2 + (isStatic ? 1 : 0)];
+    result = se_string_create_fmt
+    (
+        SeStringLifetime::PERSISTENT,
+        "{} objects, {} : {} {} ms, update {} ms ({} reinserted), frustum {} ms ({} visible), brute force {} ms ({} visible), "
+        "{} rays {} ms ({} hits), {} overlaps {} ms ({} hits), height {}, area ratio {}",
+        numObjects, isStatic ? "sah" : "dynamic", isStatic ? "rebuild" : "fill", float(isStatic ? g_rebuildMs : g_fillMs),
+        float(g_timings.updateMs / numFrames), g_timings.numReinserted / g_numMeasuredFrames,
+        float(g_timings.frustumMs / numFrames), g_timings.numVisible,
+        float(g_timings.bruteForceMs / numFrames), g_timings.numBruteForceVisible,
+        NUM_RAYS, float(g_timings.raysMs / numFrames), g_timings.numRayHits,
+        NUM_OVERLAPS, float(g_timings.overlapsMs / numFrames), g_timings.numOverlapHits,
+        se_aabb_tree_height(&g_tree), se_aabb_tree_area_ratio(&g_tree)
+    );
+    se_dbg_message("{}", result);
+    g_timings = { };
+    g_numMeasuredFrames = 0;
+}
+
+void run_benchmark(const SeUpdateInfo& info)
+{
+    switch (g_stage)
+    {
+        case BenchmarkStage::FILL:
+        {
+            fill(OBJECT_COUNTS[g_countIndex]);
+            g_stage = BenchmarkStage::DYNAMIC;
+        } break;
+        case BenchmarkStage::DYNAMIC:
+        {
+            move_and_update(info.frame);
+            query(info.frame);
+            g_numMeasuredFrames += 1;
+            if (g_numMeasuredFrames < FRAMES_PER_MEASUREMENT) break;
+            store_result(false);
+
+            const uint64_t begin = _se_get_perf_counter();
+            se_aabb_tree_rebuild_sah(&g_tree);
+            g_rebuildMs = ms_since(begin);
+            g_stage = BenchmarkStage::STATIC;
+        } break;
+        case BenchmarkStage::STATIC:
+        {
+            query(info.frame);
+            g_numMeasuredFrames += 1;
+            if (g_numMeasuredFrames < FRAMES_PER_MEASUREMENT) break;
+            store_result(true);
+
+            se_aabb_tree_destroy(&g_tree);
+            se_dynamic_array_destroy(g_instances);
+            se_dynamic_array_destroy(g_proxies);
+            g_countIndex += 1;
+            g_stage = g_countIndex < se_array_size(OBJECT_COUNTS) ? BenchmarkStage::FILL : BenchmarkStage::FINISHED;
+        } break;
+        case BenchmarkStage::FINISHED:
+        {
+        } break;
+    }
+}
+
+void update(const SeUpdateInfo& info)
+{
+    if (se_win_is_close_button_pressed() || se_win_is_keyboard_button_pressed(SeKeyboard::ESCAPE)) se_engine_stop();
+
+    run_benchmark(info);
+
+    if (se_render_begin_frame())
+    {
+        if (se_ui_begin({ se_render_swap_chain_texture(), SeRenderTargetLoadOp::CLEAR }))
+        {
+            se_ui_set_font_group({ g_fontDataEnglish });
+
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_X, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_Y, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_X, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_Y, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::FONT_HEIGHT, { .dim = 16.0f });
+            se_ui_set_param(SeUiParam::FONT_LINE_GAP, { .dim = 2.0f });
+
+            if (se_ui_begin_window
+            ({
+                .uid    = "Results",
+                .width  = se_win_get_width<float>(),
+                .height = se_win_get_height<float>(),
+                .flags  = 0,
+            }))
+            {
+                se_ui_text({ .utf8text = g_stage == BenchmarkStage::FINISHED ? "Finished" : "Measuring..." });
+                for (size_t it = 0; it < se_array_size(g_resultStrings); it++)
+                {
+                    if (g_resultStrings[it].memory) se_ui_text({ .utf8text = se_string_cstr(g_resultStrings[it]) });
+                }
+                se_ui_end_window();
+            }
+
+            se_ui_end(0);
+        }
+        se_render_end_frame();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const SeSettings settings
+    {
+        .applicationName        = "Sabrina engine - aabb tree benchmark",
+        .isFullscreenWindow     = false,
+        .isResizableWindow      = false,
+        .windowWidth            = 1280,
+        .windowHeight           = 720,
+        .createUserDataFolder   = false,
+    };
+    se_engine_run(settings, init, update, terminate);
+    return 0;
+}
@@ -0,0 +1,279 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+
+//
+// Command stream benchmark. Encodes frames of render graph commands into SeVkCommandStream (see se_vulkan_command_stream.hpp)
+// and decodes them back the same way the render graph does, without a device. Every draw of a pass binds a material
+// (material changes every few draws), pushes per-draw constants, binds the index buffer of the pass and draws, so most binds
+// are redundant and are elided by the encoder. Draw count per pass grows from phase to phase, number of draws per frame stays
+// the same, so results show how per-command cost and stream size depend on pass length rather than on the amount of work.
+// Stream size is compared with the fixed size commands the graph used before. Decoded commands are checked against the encoded ones.
+//
+
+constexpr size_t DRAWS_PER_PASS[] = { 16, 256, 4096 };
+constexpr size_t DRAWS_PER_FRAME = 65536;
+constexpr size_t MATERIAL_RUN = 8;          // Draws that share the same material
+constexpr size_t INPUT_COMMANDS_PER_DRAW = 4;
+constexpr size_t FRAMES_PER_MEASUREMENT = 30;
+constexpr size_t WARMUP_FRAMES = 2;         // Stream memory grows during the first frame
+// Fixed size command of the previous graph command storage : type and union of the command infos (SeCommandBindInfo is the largest)
+constexpr size_t FIXED_COMMAND_SIZE = sizeof(uint64_t) + sizeof(SeCommandBindInfo);
+
+struct PushConstants
+{
+    uint32_t    draw;
+    uint32_t    pass;
+    float       scale[2];
+};
+
+struct Timings
+{
+    double encodeMs;
+    double decodeMs;
+};
+
+SeDataProvider g_fontDataEnglish;
+
+size_t g_phase;
+size_t g_phaseFrame;
+SeVkCommandStream g_stream;
+SeDynamicArray<SeVkCommandStreamRange> g_passes;
+Timings g_timings;
+bool g_isFinished;
+SeString g_resultStrings[se_array_size(DRAWS_PER_PASS)];
+
+double ms_since(uint64_t begin)
+{
+    return double(_se_get_perf_counter() - begin) * 1000.0 / double(_se_get_perf_frequency());
+}
+
+void init()
+{
+    g_fontDataEnglish = se_data_provider_from_file("shahd serif.ttf");
+    g_stream = { };
+    se_vk_command_stream_construct(&g_stream, se_allocator_persistent(), 0);
+    g_passes = se_dynamic_array_create<SeVkCommandStreamRange>(se_allocator_persistent(), DRAWS_PER_FRAME / DRAWS_PER_PASS[0]);
+}
+
+void terminate()
+{
+    se_vk_command_stream_destroy(&g_stream);
+    se_dynamic_array_destroy(g_passes);
+    for (size_t it = 0; it < se_array_size(g_resultStrings); it++)
+    {
+        if (g_resultStrings[it].memory) se_string_destroy(g_resultStrings[it]);
+    }
+}
+
+//
+// Returns checksum of the encoded values. Elided commands repeat the recorded ones, so they aren't counted
+//
+uint64_t encode_frame(size_t drawsPerPass)
+{
+    se_vk_command_stream_reset(&g_stream);
+    se_dynamic_array_reset(g_passes);
+    uint64_t checksum = 0;
+    const size_t numPasses = DRAWS_PER_FRAME / drawsPerPass;
+    for (size_t passIt = 0; passIt < numPasses; passIt++)
+    {
+        se_vk_command_stream_begin_pass(&g_stream);
+        const SeVkGraphBufferRange indices = { nullptr, passIt * 1024 };
+        for (size_t drawIt = 0; drawIt < drawsPerPass; drawIt++)
+        {
+            const uint32_t material = uint32_t(drawIt / MATERIAL_RUN) + 1;
+            const SeBinding bindings[] =
+            {
+                { .binding = 0, .type = SeBinding::TEXTURE, .texture = { { material, 1, 0 }, { 1, 1 } } },
+                { .binding = 1, .type = SeBinding::BUFFER, .buffer = { { material, 1, 0 }, 0, 256 } },
+            };
+            se_vk_command_stream_bind(&g_stream, 0, bindings, uint32_t(se_array_size(bindings)));
+            if ((drawIt % MATERIAL_RUN) == 0) checksum += material * 2;
+
+            const PushConstants constants = { uint32_t(drawIt), uint32_t(passIt), { 1.0f, 1.0f } };
+            se_vk_command_stream_push_constants(&g_stream, &constants, sizeof(constants));
+            checksum += constants.draw + constants.pass;
+
+            se_vk_command_stream_bind_index_buffer(&g_stream, indices, VK_INDEX_TYPE_UINT32);
+            if (drawIt == 0) checksum += indices.offset;
+
+            const SeCommandDrawIndexedInfo draw = { .numIndices = uint32_t(36 + drawIt), .numInstances = 1, .firstIndex = 0, .vertexOffset = 0 };
+            se_vk_command_stream_draw_indexed(&g_stream, draw);
+            checksum += draw.numIndices;
+        }
+        se_dynamic_array_push(g_passes, se_vk_command_stream_end_pass(&g_stream));
+    }
+    return checksum;
+}
+
+uint64_t decode_frame()
+{
+    uint64_t checksum = 0;
+    for (auto it : g_passes)
+    {
+        se_vk_command_stream_for_each(&g_stream, se_iterator_value(it), [&checksum](const SeVkGraphCommand* command)
+        {
+            switch (command->type)
+            {
+                case SE_VK_GRAPH_COMMAND_TYPE_BIND:
+                {
+                    const SeVkGraphCommandBind* const bind = (const SeVkGraphCommandBind*)command;
+                    const SeBinding* const bindings = se_vk_graph_command_bindings(bind);
+                    for (uint32_t bindingIt = 0; bindingIt < bind->numBindings; bindingIt++)
+                    {
+                        checksum += bindings[bindingIt].type == SeBinding::TEXTURE ? bindings[bindingIt].texture.texture.index : bindings[bindingIt].buffer.buffer.index;
+                    }
+                } break;
+                case SE_VK_GRAPH_COMMAND_TYPE_PUSH_CONSTANTS:
+                {
+                    const PushConstants* const constants = (const PushConstants*)se_vk_graph_command_push_constants_data((const SeVkGraphCommandPushConstants*)command);
+                    checksum += constants->draw + constants->pass;
+                } break;
+                case SE_VK_GRAPH_COMMAND_TYPE_BIND_INDEX_BUFFER:
+                {
+                    checksum += ((const SeVkGraphCommandBindIndexBuffer*)command)->indices.offset;
+                } break;
+                case SE_VK_GRAPH_COMMAND_TYPE_DRAW_INDEXED:
+                {
+                    checksum += ((const SeVkGraphCommandDrawIndexed*)command)->info.numIndices;
+                } break;
+                default: { se_assert_msg(false, "Unexpected command type"); } break;
+            }
+        });
+    }
+    return checksum;
+}
+
+void check_frame(size_t drawsPerPass, uint64_t encodedChecksum, uint64_t decodedChecksum)
+{
+    se_assert_msg(encodedChecksum == decodedChecksum, "Decoded commands don't match the encoded ones");
+    const size_t numPasses = DRAWS_PER_FRAME / drawsPerPass;
+    const size_t numBinds = (drawsPerPass + MATERIAL_RUN - 1) / MATERIAL_RUN;
+    const size_t numPassCommands = numBinds + drawsPerPass * 2 + 1;
+    se_assert(se_dynamic_array_size(g_passes) == numPasses);
+    for (auto it : g_passes)
+    {
+        const SeVkCommandStreamRange& pass = se_iterator_value(it);
+        se_assert(pass.numCommands == numPassCommands);
+        se_assert(pass.numBinds == numBinds);
+    }
+    se_assert(g_stream.numCommands == numPasses * numPassCommands);
+    se_assert(g_stream.numCommands + g_stream.numElidedCommands == DRAWS_PER_FRAME * INPUT_COMMANDS_PER_DRAW);
+    se_assert(se_dynamic_array_last(g_passes)->end == se_vk_command_stream_size(&g_stream));
+}
+
+void store_result()
+{
+    const size_t drawsPerPass = DRAWS_PER_PASS[g_phase];
+    const double numFrames = double(FRAMES_PER_MEASUREMENT - WARMUP_FRAMES);
+    const double encodeMs = g_timings.encodeMs / numFrames;
+    const double decodeMs = g_timings.decodeMs / numFrames;
+    const size_t numInputCommands = DRAWS_PER_FRAME * INPUT_COMMANDS_PER_DRAW;
+    const size_t streamSize = se_vk_command_stream_size(&g_stream);
+    SeString& result = g_resultStrings[g_phase];
+    result = se_string_create_fmt
+    (
+        SeStringLifetime::PERSISTENT,
+        "{} draws per pass : encode {} ns per command, decode {} ns per command ({} MB/s), {} of {} commands recorded, "
+        "{} KB per frame ({} bytes per input command, fixed size commands take {} KB)",
+        drawsPerPass,
+        float(encodeMs * 1000000.0 / double(numInputCommands)), float(decodeMs * 1000000.0 / double(g_stream.numCommands)),
+        float(double(streamSize) / (1024.0 * 1024.0) / (decodeMs / 1000.0)),
+        g_stream.numCommands, numInputCommands,
+        streamSize / 1024, float(double(streamSize) / double(numInputCommands)), (g_stream.numCommands * FIXED_COMMAND_SIZE) / 1024
+    );
+    se_dbg_message("{}", result);
+    g_timings = { };
+}
+
+void run_benchmark()
+{
+    if (g_isFinished) return;
+
+    const size_t drawsPerPass = DRAWS_PER_PASS[g_phase];
+    const uint64_t encodeBegin = _se_get_perf_counter();
+    const uint64_t encodedChecksum = encode_frame(drawsPerPass);
+    const double encodeMs = ms_since(encodeBegin);
+    const uint64_t decodeBegin = _se_get_perf_counter();
+    const uint64_t decodedChecksum = decode_frame();
+    const double decodeMs = ms_since(decodeBegin);
+    check_frame(drawsPerPass, encodedChecksum, decodedChecksum);
+    if (g_phaseFrame >= WARMUP_FRAMES)
+    {
+        g_timings.encodeMs += encodeMs;
+        g_timings.decodeMs += decodeMs;
+    }
+
+    g_phaseFrame += 1;
+    if (g_phaseFrame < FRAMES_PER_MEASUREMENT) return;
+    store_result();
+    g_phaseFrame = 0;
+    g_phase += 1;
+    g_isFinished = g_phase == se_array_size(DRAWS_PER_PASS);
+}
+
+void update(const SeUpdateInfo& info)
+{
+    if (se_win_is_close_button_pressed() || se_win_is_keyboard_button_pressed(SeKeyboard::ESCAPE)) se_engine_stop();
+
+    run_benchmark();
+
+    if (se_render_begin_frame())
+    {
+        if (se_ui_begin({ se_render_swap_chain_texture(), SeRenderTargetLoadOp::CLEAR }))
+        {
+            se_ui_set_font_group({ g_fontDataEnglish });
+
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_X, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_Y, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_X, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_Y, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::FONT_HEIGHT, { .dim = 16.0f });
+            se_ui_set_param(SeUiParam::FONT_LINE_GAP, { .dim = 2.0f });
+
+            if (se_ui_begin_window
+            ({
+                .uid    = "Results",
+                .width  = se_win_get_width<float>(),
+                .height = se_win_get_height<float>(),
+                .flags  = 0,
+            }))
+            {
+                //
+                // Render graph of this frame is recorded into the engine command stream too
+                //
+                const SeCommandRecordingStats stats = se_render_command_recording_stats();
+                const SeString header = se_string_create_fmt
+                (
+                    SeStringLifetime::TEMPORARY,
+                    "{}, engine command stream : {} commands ({} elided), {} bytes",
+                    g_isFinished ? "Finished" : "Measuring...",
+                    stats.numRecordedCommands, stats.numElidedCommands, stats.commandStreamBytes
+                );
+                se_ui_text({ .utf8text = se_string_cstr(header) });
+                for (size_t it = 0; it < se_array_size(g_resultStrings); it++)
+                {
+                    if (g_resultStrings[it].memory) se_ui_text({ .utf8text = se_string_cstr(g_resultStrings[it]) });
+                }
+                se_ui_end_window();
+            }
+
+            se_ui_end(0);
+        }
+        se_render_end_frame();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const SeSettings settings
+    {
+        .applicationName        = "Sabrina engine - command stream benchmark",
+        .isFullscreenWindow     = false,
+        .isResizableWindow      = false,
+        .windowWidth            = 1024,
+        .windowHeight           = 480,
+        .createUserDataFolder   = false,
+    };
+    se_engine_run(settings, init, update, terminate);
+    return 0;
+}
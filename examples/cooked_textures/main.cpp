@@ -0,0 +1,168 @@
+
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+
+//
+// Cooks sample images into ready-to-upload texture files (stored in the user data folder) and compares
+// texture load time of the source images (png decode + mip generation) with the cooked files (map file + copy mips).
+//
+// @NOTE : measured time is the cpu time of se_render_texture call. Gpu mip generation of the source image path
+//         is recorded to the frame command buffers and isn't included.
+//
+
+struct CookMode
+{
+    SeTextureFormat format;
+    const char*     name;
+};
+
+const CookMode COOK_MODES[] =
+{
+    { SeTextureFormat::RGBA_8_UNORM,    "RGBA8" },
+    { SeTextureFormat::BC1_RGBA_UNORM,  "BC1" },
+    { SeTextureFormat::BC7_UNORM,       "BC7" },
+};
+
+const char* const SAMPLE_IMAGES[] =
+{
+    "grass.png",
+    "rocks.png",
+};
+
+constexpr size_t NUM_LOAD_ITERATIONS = 8;
+constexpr size_t NUM_RESULTS = se_array_size(SAMPLE_IMAGES) * (se_array_size(COOK_MODES) + 1);
+
+SeDataProvider g_fontDataEnglish;
+SeString g_results[NUM_RESULTS];
+
+float load_texture_ms(SeTextureFormat format, SeDataProvider data, bool generateMips)
+{
+    const double counterFrequency = double(_se_get_perf_frequency());
+    double totalTimeMs = 0.0;
+    for (size_t it = 0; it < NUM_LOAD_ITERATIONS; it++)
+    {
+        const uint64_t loadBegin = _se_get_perf_counter();
+        const SeTextureRef texture = se_render_texture
+        ({
+            .format         = format,
+            .width          = 0,
+            .height         = 0,
+            .data           = data,
+            .generateMips   = generateMips,
+        });
+        const uint64_t loadEnd = _se_get_perf_counter();
+        totalTimeMs += double(loadEnd - loadBegin) / counterFrequency * 1000.0;
+        se_render_destroy(texture);
+    }
+    return float(totalTimeMs / double(NUM_LOAD_ITERATIONS));
+}
+
+SeFileHandle cook_texture(const char* imageName, const CookMode& mode)
+{
+    const SeDataProvider imageData = se_data_provider_from_file(imageName);
+    const auto [sourcePtr, sourceSize] = se_data_provider_get(imageData);
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    uint8_t* const rgba = stbi_load_from_memory((const stbi_uc*)sourcePtr, int(sourceSize), &width, &height, &channels, 4);
+    se_assert(rgba);
+
+    SeCookedTexture cooked = se_cooked_texture_cook
+    ({
+        .format         = mode.format,
+        .rgba           = rgba,
+        .width          = uint32_t(width),
+        .height         = uint32_t(height),
+        .generateMips   = true,
+    }, se_allocator_persistent());
+    stbi_image_free(rgba);
+
+    const SeFileHandle file = se_fs_file_create(se_string_cstr(se_string_create_fmt(SeStringLifetime::TEMPORARY, "{}.{}.setex", imageName, mode.name)));
+    se_fs_file_write_begin(file, SeFileWriteOpenMode::CLEAR);
+    se_fs_file_write(file, se_data_provider_from_memory(cooked.data, cooked.dataSize));
+    se_fs_file_write_end(file);
+    se_cooked_texture_free(cooked);
+    return file;
+}
+
+void init()
+{
+    g_fontDataEnglish = se_data_provider_from_file("shahd serif.ttf");
+
+    size_t resultIndex = 0;
+    for (const char* imageName : SAMPLE_IMAGES)
+    {
+        const float sourceLoadMs = load_texture_ms(SeTextureFormat::RGBA_8_UNORM, se_data_provider_from_file(imageName), true);
+        g_results[resultIndex] = se_string_create_fmt(SeStringLifetime::PERSISTENT, "{} source : {} ms", imageName, sourceLoadMs);
+        se_dbg_message("{}", g_results[resultIndex]);
+        resultIndex += 1;
+        for (const CookMode& mode : COOK_MODES)
+        {
+            const SeFileHandle cookedFile = cook_texture(imageName, mode);
+            const float cookedLoadMs = load_texture_ms(mode.format, se_data_provider_from_file(cookedFile), false);
+            g_results[resultIndex] = se_string_create_fmt(SeStringLifetime::PERSISTENT, "{} cooked {} : {} ms", imageName, mode.name, cookedLoadMs);
+            se_dbg_message("{}", g_results[resultIndex]);
+            resultIndex += 1;
+        }
+    }
+}
+
+void terminate()
+{
+    for (size_t it = 0; it < NUM_RESULTS; it++)
+    {
+        se_string_destroy(g_results[it]);
+    }
+}
+
+void update(const SeUpdateInfo& info)
+{
+    if (se_win_is_close_button_pressed()) se_engine_stop();
+    if (se_render_begin_frame())
+    {
+        if (se_ui_begin({ se_render_swap_chain_texture(), SeRenderTargetLoadOp::CLEAR, { 0.0f, 0.0f, 0.0f, 1.0f } }))
+        {
+            se_ui_set_font_group({ g_fontDataEnglish });
+
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_X, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_Y, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_X, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_Y, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::FONT_HEIGHT, { .dim = 20.0f });
+            se_ui_set_param(SeUiParam::FONT_LINE_GAP, { .dim = 2.0f });
+
+            if (se_ui_begin_window
+            ({
+                .uid    = "Results",
+                .width  = se_win_get_width<float>(),
+                .height = se_win_get_height<float>(),
+                .flags  = 0,
+            }))
+            {
+                for (size_t it = 0; it < NUM_RESULTS; it++)
+                {
+                    se_ui_text({ .utf8text = se_string_cstr(g_results[it]) });
+                }
+                se_ui_end_window();
+            }
+
+            se_ui_end(0);
+        }
+        se_render_end_frame();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const SeSettings settings
+    {
+        .applicationName        = "Sabrina engine - cooked textures",
+        .isFullscreenWindow     = false,
+        .isResizableWindow      = true,
+        .windowWidth            = 800,
+        .windowHeight           = 480,
+        .createUserDataFolder   = true,
+    };
+    se_engine_run(settings, init, update, terminate);
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+
+//
+// Cpu frustum culling benchmark. Culls a million randomly placed instances of a single box every frame with the scalar
+// and the SSE paths of se_frustum_cull. Camera rotates, so the number of visible instances changes over time.
+// Result line has average time of both paths and the speedup of the SSE path. Equivalence of both paths is verified
+// by checks/frustum_culling.
+//
+
+constexpr size_t NUM_INSTANCES = 1000000;
+constexpr size_t FRAMES_PER_MEASUREMENT = 60;
+constexpr float WORLD_SIZE = 1000.0f;
+
+SeDataProvider g_fontDataEnglish;
+
+SeMeshInstanceData* g_instances;
+uint32_t* g_scalarVisible;
+uint32_t* g_simdVisible;
+
+size_t g_numMeasuredFrames;
+double g_scalarMs;
+double g_simdMs;
+size_t g_numVisible;
+SeString g_resultString;
+
+void init()
+{
+    g_fontDataEnglish = se_data_provider_from_file("shahd serif.ttf");
+
+    const SeAllocatorBindings allocator = se_allocator_persistent();
+    g_instances = (SeMeshInstanceData*)se_alloc(allocator, sizeof(SeMeshInstanceData) * NUM_INSTANCES, se_alloc_tag);
+    g_scalarVisible = (uint32_t*)se_alloc(allocator, sizeof(uint32_t) * NUM_INSTANCES, se_alloc_tag);
+    g_simdVisible = (uint32_t*)se_alloc(allocator, sizeof(uint32_t) * NUM_INSTANCES, se_alloc_tag);
+    //
+    // Simple xorshift, so results are the same on every run
+    //
+    uint32_t seed = 0x12345678;
+    auto random01 = [&seed]() -> float
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return float(seed & 0xFFFFFF) / float(0xFFFFFF);
+    };
+    for (size_t it = 0; it < NUM_INSTANCES; it++)
+    {
+        const SeFloat3 position = { (random01() - 0.5f) * WORLD_SIZE, (random01() - 0.5f) * WORLD_SIZE * 0.1f, (random01() - 0.5f) * WORLD_SIZE };
+        const SeFloat3 rotation = { random01() * 360.0f, random01() * 360.0f, random01() * 360.0f };
+        g_instances[it] = { se_float4x4_mul(se_float4x4_from_position(position), se_float4x4_from_rotation(rotation)) };
+    }
+}
+
+void terminate()
+{
+    const SeAllocatorBindings allocator = se_allocator_persistent();
+    se_dealloc(allocator, g_instances, sizeof(SeMeshInstanceData) * NUM_INSTANCES);
+    se_dealloc(allocator, g_scalarVisible, sizeof(uint32_t) * NUM_INSTANCES);
+    se_dealloc(allocator, g_simdVisible, sizeof(uint32_t) * NUM_INSTANCES);
+    if (g_resultString.memory) se_string_destroy(g_resultString);
+}
+
+void run_benchmark(const SeUpdateInfo& info)
+{
+    const float aspect = se_win_get_width<float>() / se_win_get_height<float>();
+    const SeFloat4x4 view = se_float4x4_look_at({ 0, 0, 0 }, { sinf(float(info.frame) * 0.01f), 0, cosf(float(info.frame) * 0.01f) }, { 0, 1, 0 });
+    const SeFloat4x4 viewProjection = se_render_perspective(60, aspect, 0.1f, WORLD_SIZE * 0.5f) * se_float4x4_inverted(view);
+    SeFloat4 planes[6];
+    se_float4x4_get_frustum_planes(viewProjection, planes);
+    const SeAabb aabb = { { -1, -1, -1 }, { 1, 1, 1 } };
+
+    const double frequency = double(_se_get_perf_frequency());
+    const uint64_t scalarBegin = _se_get_perf_counter();
+    se_frustum_cull_scalar(planes, aabb, g_instances, sizeof(SeMeshInstanceData), NUM_INSTANCES, g_scalarVisible);
+    const uint64_t simdBegin = _se_get_perf_counter();
+    const size_t numSimdVisible = se_frustum_cull(planes, aabb, g_instances, sizeof(SeMeshInstanceData), NUM_INSTANCES, g_simdVisible);
+    const uint64_t simdEnd = _se_get_perf_counter();
+
+    g_scalarMs += double(simdBegin - scalarBegin) * 1000.0 / frequency;
+    g_simdMs += double(simdEnd - simdBegin) * 1000.0 / frequency;
+    g_numVisible = numSimdVisible;
+    g_numMeasuredFrames += 1;
+    if (g_numMeasuredFrames < FRAMES_PER_MEASUREMENT) return;
+
+    if (g_resultString.memory) se_string_destroy(g_resultString);
+    const double scalarMs = g_scalarMs / double(g_numMeasuredFrames);
+    const double simdMs = g_simdMs / double(g_numMeasuredFrames);
+    g_resultString = se_string_create_fmt
+    (
+        SeStringLifetime::PERSISTENT,
+        "{} instances, {} visible : scalar {} ms, sse {} ms, x{}",
+        NUM_INSTANCES, g_numVisible, float(scalarMs), float(simdMs), float(scalarMs / simdMs)
+    );
+    se_dbg_message("{}", g_resultString);
+    g_scalarMs = 0.0;
+    g_simdMs = 0.0;
+    g_numMeasuredFrames = 0;
+}
+
+void update(const SeUpdateInfo& info)
+{
+    if (se_win_is_close_button_pressed() || se_win_is_keyboard_button_pressed(SeKeyboard::ESCAPE)) se_engine_stop();
+
+    run_benchmark(info);
+
+    if (se_render_begin_frame())
+    {
+        if (se_ui_begin({ se_render_swap_chain_texture(), SeRenderTargetLoadOp::CLEAR }))
+        {
+            se_ui_set_font_group({ g_fontDataEnglish });
+
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_X, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_Y, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_X, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_Y, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::FONT_HEIGHT, { .dim = 20.0f });
+            se_ui_set_param(SeUiParam::FONT_LINE_GAP, { .dim = 2.0f });
+
+            if (se_ui_begin_window
+            ({
+                .uid    = "Results",
+                .width  = se_win_get_width<float>(),
+                .height = 40.0f,
+                .flags  = 0,
+            }))
+            {
+                se_ui_text({ .utf8text = g_resultString.memory ? se_string_cstr(g_resultString) : "Measuring..." });
+                se_ui_end_window();
+            }
+
+            se_ui_end(0);
+        }
+        se_render_end_frame();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const SeSettings settings
+    {
+        .applicationName        = "Sabrina engine - culling benchmark",
+        .isFullscreenWindow     = false,
+        .isResizableWindow      = false,
+        .windowWidth            = 800,
+        .windowHeight           = 480,
+        .createUserDataFolder   = false,
+    };
+    se_engine_run(settings, init, update, terminate);
+    return 0;
+}
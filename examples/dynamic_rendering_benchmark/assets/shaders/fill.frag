@@ -0,0 +1,12 @@
+#version 450
+
+layout(push_constant) uniform FillData { vec4 color; };
+
+layout(location = 0) in vec2 inUv;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    outColor = vec4(color.rgb * vec3(inUv, 1.0), color.a);
+}
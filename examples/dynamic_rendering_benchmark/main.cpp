@@ -0,0 +1,182 @@
+
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+
+//
+// Dynamic rendering benchmark. Records a lot of small passes every frame and alternates between dynamic rendering and
+// render pass objects. Subpass merging is disabled, so every pass is a separate render pass on the render pass path.
+// Setup time (render pass, framebuffer and pipeline lookups) is measured separately from command recording, because
+// that's where dynamic rendering saves most of the work. If dynamic rendering isn't supported only render passes are measured.
+//
+
+constexpr size_t NUM_PASSES = SE_MAX_PASS_DEPENDENCIES - 1; // One pass is left for ui
+constexpr size_t NUM_TARGETS = 8;
+constexpr uint32_t TARGET_SIZE = 64;
+constexpr size_t FRAMES_PER_MEASUREMENT = 120;
+
+SeDataProvider g_fontDataEnglish;
+SeProgramRef g_fullscreenVs;
+SeProgramRef g_fillFs;
+SeTextureRef g_targets[NUM_TARGETS];
+
+bool g_isDynamicRenderingSupported;
+bool g_isDynamicRenderingEnabled;
+size_t g_numMeasuredFrames;
+bool g_isWarmupFrame = true;
+float g_accumulatedSetupMs;
+float g_accumulatedRecordingMs;
+SeString g_resultStrings[2]; // Indexed by g_isDynamicRenderingEnabled
+
+void init()
+{
+    g_fontDataEnglish = se_data_provider_from_file("shahd serif.ttf");
+    g_fullscreenVs = se_render_program({ se_data_provider_from_file("fullscreen.vert.spv") });
+    g_fillFs = se_render_program({ se_data_provider_from_file("fill.frag.spv") });
+    for (size_t it = 0; it < NUM_TARGETS; it++)
+    {
+        g_targets[it] = se_render_texture
+        ({
+            .format = SeTextureFormat::RGBA_8_UNORM,
+            .width  = TARGET_SIZE,
+            .height = TARGET_SIZE,
+        });
+    }
+    se_render_set_subpass_merging(false);
+    g_isDynamicRenderingSupported = se_render_is_dynamic_rendering_supported();
+    g_isDynamicRenderingEnabled = false;
+    se_render_set_dynamic_rendering(g_isDynamicRenderingEnabled);
+}
+
+void terminate()
+{
+    for (size_t it = 0; it < se_array_size(g_resultStrings); it++)
+    {
+        if (g_resultStrings[it].memory) se_string_destroy(g_resultStrings[it]);
+    }
+}
+
+void update_measurements()
+{
+    //
+    // Stats are for the previous frame, so the first frame after the path change is skipped
+    //
+    if (g_isWarmupFrame)
+    {
+        g_isWarmupFrame = false;
+        return;
+    }
+    const SeCommandRecordingStats stats = se_render_command_recording_stats();
+    // Benchmark passes are never merged and don't read input attachments, so all of them use the selected path
+    se_assert(g_isDynamicRenderingEnabled ? stats.numDynamicPasses >= NUM_PASSES : stats.numDynamicPasses == 0);
+    se_assert(stats.numMergedPasses == 0);
+    g_accumulatedSetupMs += stats.lastFrameSetupMs;
+    g_accumulatedRecordingMs += stats.lastFrameRecordingMs;
+    g_numMeasuredFrames += 1;
+    if (g_numMeasuredFrames < FRAMES_PER_MEASUREMENT) return;
+
+    SeString& result = g_resultStrings[g_isDynamicRenderingEnabled];
+    if (result.memory) se_string_destroy(result);
+    result = se_string_create_fmt
+    (
+        SeStringLifetime::PERSISTENT,
+        "{} : setup {} ms, recording {} ms, {} primary buffers",
+        g_isDynamicRenderingEnabled ? "Dynamic rendering" : "Render pass objects",
+        g_accumulatedSetupMs / float(g_numMeasuredFrames), g_accumulatedRecordingMs / float(g_numMeasuredFrames), stats.numPrimaryBuffers
+    );
+    se_dbg_message("{}", result);
+
+    g_isDynamicRenderingEnabled = g_isDynamicRenderingSupported && !g_isDynamicRenderingEnabled;
+    se_render_set_dynamic_rendering(g_isDynamicRenderingEnabled);
+    g_accumulatedSetupMs = 0.0f;
+    g_accumulatedRecordingMs = 0.0f;
+    g_numMeasuredFrames = 0;
+    g_isWarmupFrame = true;
+}
+
+void update(const SeUpdateInfo& info)
+{
+    if (se_win_is_close_button_pressed() || se_win_is_keyboard_button_pressed(SeKeyboard::ESCAPE)) se_engine_stop();
+
+    if (se_render_begin_frame())
+    {
+        update_measurements();
+
+        SePassDependencies previousPasses = 0;
+        for (size_t passIt = 0; passIt < NUM_PASSES; passIt++)
+        {
+            const float t = float(passIt) / float(NUM_PASSES);
+            const SeFloat4 color = { t, 1.0f - t, 0.5f, 1.0f };
+            previousPasses |= se_render_begin_graphics_pass
+            ({
+                .dependencies           = 0,
+                .vertexProgram          = { .program = g_fullscreenVs, },
+                .fragmentProgram        = { .program = g_fillFs, },
+                .frontStencilOpState    = { .isEnabled = false, },
+                .backStencilOpState     = { .isEnabled = false, },
+                .depthState             = { .isTestEnabled = false, .isWriteEnabled = false, },
+                .polygonMode            = SePipelinePolygonMode::FILL,
+                .cullMode               = SePipelineCullMode::NONE,
+                .frontFace              = SePipelineFrontFace::CLOCKWISE,
+                .samplingType           = SeSamplingType::_1,
+                .renderTargets          = { { g_targets[passIt % NUM_TARGETS], SeRenderTargetLoadOp::CLEAR } },
+                .depthStencilTarget     = { },
+            });
+            se_render_push_constants({ se_data_provider_from_memory(&color, sizeof(color)) });
+            se_render_draw({ .numVertices = 3, .numInstances = 1 });
+            se_render_end_pass();
+        }
+
+        if (se_ui_begin({ se_render_swap_chain_texture(), SeRenderTargetLoadOp::CLEAR }))
+        {
+            se_ui_set_font_group({ g_fontDataEnglish });
+
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_X, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_Y, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_X, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_Y, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::FONT_HEIGHT, { .dim = 20.0f });
+            se_ui_set_param(SeUiParam::FONT_LINE_GAP, { .dim = 2.0f });
+
+            if (se_ui_begin_window
+            ({
+                .uid    = "Results",
+                .width  = se_win_get_width<float>(),
+                .height = se_win_get_height<float>(),
+                .flags  = 0,
+            }))
+            {
+                const SeString header = se_string_create_fmt
+                (
+                    SeStringLifetime::TEMPORARY,
+                    "{} passes, measuring {}",
+                    NUM_PASSES,
+                    g_isDynamicRenderingEnabled ? "dynamic rendering" : (g_isDynamicRenderingSupported ? "render pass objects" : "render pass objects (dynamic rendering isn't supported)")
+                );
+                se_ui_text({ .utf8text = se_string_cstr(header) });
+                for (size_t it = 0; it < se_array_size(g_resultStrings); it++)
+                {
+                    if (g_resultStrings[it].memory) se_ui_text({ .utf8text = se_string_cstr(g_resultStrings[it]) });
+                }
+                se_ui_end_window();
+            }
+
+            se_ui_end(previousPasses);
+        }
+        se_render_end_frame();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const SeSettings settings
+    {
+        .applicationName        = "Sabrina engine - dynamic rendering benchmark",
+        .isFullscreenWindow     = false,
+        .isResizableWindow      = false,
+        .windowWidth            = 800,
+        .windowHeight           = 480,
+        .createUserDataFolder   = false,
+    };
+    se_engine_run(settings, init, update, terminate);
+    return 0;
+}
@@ -36,6 +36,7 @@ SeBufferRef     g_edgeTableBuffer;
 SeBufferRef     g_triangleTableBuffer;
 SeBufferRef     g_gridValuesBuffer;
 SeBufferRef     g_geometryBuffer;
+SeBufferRef     g_drawArgsBuffer;   // Written by clear_chunk and triangulate_chunk, consumed by the indirect draw
 
 SeSamplerRef    g_sampler;
 
@@ -51,13 +52,15 @@ void init()
 
     g_grassTexture = se_render_texture
     ({
-        .format = SeTextureFormat::RGBA_8_SRGB,
-        .data   = se_data_provider_from_file("grass.png"),
+        .format         = SeTextureFormat::RGBA_8_SRGB,
+        .data           = se_data_provider_from_file("grass.png"),
+        .generateMips   = true,
     });
     g_rockTexture = se_render_texture
     ({
-        .format = SeTextureFormat::RGBA_8_SRGB,
-        .data   = se_data_provider_from_file("rocks.png"),
+        .format         = SeTextureFormat::RGBA_8_SRGB,
+        .data           = se_data_provider_from_file("rocks.png"),
+        .generateMips   = true,
     });
     g_depthTexture = se_render_texture
     ({
@@ -70,6 +73,7 @@ void init()
     g_triangleTableBuffer   = se_render_memory_buffer({ se_data_provider_from_memory(TRIANGLE_TABLE, sizeof(TRIANGLE_TABLE)) });
     g_gridValuesBuffer      = se_render_memory_buffer({ se_data_provider_from_memory(nullptr, sizeof(float) * CHUNK_DIM * CHUNK_DIM * CHUNK_DIM) });
     g_geometryBuffer        = se_render_memory_buffer({ se_data_provider_from_memory(nullptr, sizeof(Vertex) * NUM_VERTS) });
+    g_drawArgsBuffer        = se_render_memory_buffer({ se_data_provider_from_memory(nullptr, sizeof(SeDrawIndirectArgs)) });
 
     g_sampler = se_render_sampler
     ({
@@ -81,7 +85,7 @@ void init()
         .mipmapMode         = SeSamplerMipmapMode::LINEAR,
         .mipLodBias         = 0.0f,
         .minLod             = 0.0f,
-        .maxLod             = 0.0f,
+        .maxLod             = SE_SAMPLER_LOD_CLAMP_NONE,
         .anisotropyEnable   = false,
         .maxAnisotropy      = 0.0f,
         .compareEnabled     = false,
@@ -109,7 +113,14 @@ SePassDependencies execute_compute(SeBufferRef frameDataBuffer, SeProgramRef pro
         },
         .numSpecializationConstants = 3,
     };
-    const SePassDependencies resultDeps = se_render_begin_compute_pass({ .dependencies = deps, .program = computeProgramInfo });
+    // @NOTE : passes run on the async compute queue if device has one, otherwise on the graphics queue
+    const SePassDependencies resultDeps = se_render_begin_compute_pass
+    ({
+        .dependencies       = deps,
+        .program            = computeProgramInfo,
+        .compilationPolicy  = SePipelineCompilationPolicy::WAIT,
+        .isAsyncCompute     = true,
+    });
     se_render_bind
     ({
         .set = 0,
@@ -126,7 +137,8 @@ SePassDependencies execute_compute(SeBufferRef frameDataBuffer, SeProgramRef pro
             { .binding = 0, .type = SeBinding::BUFFER, .buffer = { g_gridValuesBuffer } },
             { .binding = 1, .type = SeBinding::BUFFER, .buffer = { g_geometryBuffer } },
             { .binding = 2, .type = SeBinding::BUFFER, .buffer = { g_edgeTableBuffer } },
-            { .binding = 3, .type = SeBinding::BUFFER, .buffer = { g_triangleTableBuffer } }
+            { .binding = 3, .type = SeBinding::BUFFER, .buffer = { g_triangleTableBuffer } },
+            { .binding = 4, .type = SeBinding::BUFFER, .buffer = { g_drawArgsBuffer } }
         }
     });
     const SeComputeWorkgroupSize workgroupSize = se_render_workgroup_size(program);
@@ -228,7 +240,8 @@ void update(const SeUpdateInfo& updateInfo)
                     { .binding = 1, .type = SeBinding::TEXTURE, .texture = { g_rockTexture, g_sampler } }
                 }
             });
-            se_render_draw({ .numVertices = NUM_VERTS, .numInstances = 1 });
+            // @NOTE : number of vertices is known only to the gpu, so only the triangulated geometry is drawn instead of NUM_VERTS
+            se_render_draw_indirect({ .argsBuffer = g_drawArgsBuffer, .argsOffset = 0, .numDraws = 1 });
         }
         se_render_end_pass();
         se_render_end_frame();
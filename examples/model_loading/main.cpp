@@ -3,6 +3,15 @@
 #include "engine/se_engine.cpp"
 #include "debug_camera.hpp"
 
+//
+// Meshes are culled and drawn by the gpu (see se_mesh_culling.hpp). Instance buffers are filled once, so cpu cost
+// of a frame doesn't depend on the number of instances
+//
+
+constexpr uint32_t DUCKS_GRID_SIZE = 64;
+constexpr uint32_t NUM_DUCKS = DUCKS_GRID_SIZE * DUCKS_GRID_SIZE;
+constexpr uint32_t NUM_CAMERAS = 3;
+
 DebugCamera g_camera;
 
 SeAssetHandle g_duckMesh;
@@ -13,6 +22,12 @@ SeProgramRef g_drawFs;
 SeTextureRef g_depthTexture;
 SeSamplerRef g_sampler;
 
+SeBufferRef g_duckInstances;
+SeBufferRef g_cameraInstances;
+SeMeshCuller g_duckCuller;
+SeMeshCuller g_cameraCuller;
+bool g_areCullersConstructed = false;
+
 void init()
 {
     g_duckMesh = se_asset_add<SeMeshAsset>({ se_data_provider_from_file("duck.gltf") });
@@ -42,18 +57,39 @@ void init()
         .compareOp          = SeCompareOp::ALWAYS,
     });
 
+
+    const SeMeshInstanceData cameraInstances[NUM_CAMERAS] =
+    {
+        { SE_F4X4_IDENTITY },
+        { se_float4x4_from_position({ 4, 0, 0 }) },
+        { se_float4x4_from_position({ -4, 0, 0 }) },
+    };
+    g_cameraInstances = se_render_memory_buffer({ se_data_provider_from_memory(cameraInstances, sizeof(cameraInstances)) });
+
+    SeMeshInstanceData* const duckInstances = (SeMeshInstanceData*)se_alloc(se_allocator_frame(), sizeof(SeMeshInstanceData) * NUM_DUCKS, se_alloc_tag);
+    for (uint32_t it = 0; it < NUM_DUCKS; it++)
+    {
+        const float x = (float(it % DUCKS_GRID_SIZE) - float(DUCKS_GRID_SIZE - 1) * 0.5f) * 4.0f;
+        const float z = float(it / DUCKS_GRID_SIZE) * 4.0f - 2.0f;
+        duckInstances[it] = { se_float4x4_from_position({ x, 0, -z }) };
+    }
+    g_duckInstances = se_render_memory_buffer({ se_data_provider_from_memory(duckInstances, sizeof(SeMeshInstanceData) * NUM_DUCKS) });
+
     debug_camera_construct(&g_camera, { 0, 0, -10 });
 }
 
 void terminate()
 {
-    
+    if (g_areCullersConstructed)
+    {
+        se_mesh_culler_destroy(&g_duckCuller);
+        se_mesh_culler_destroy(&g_cameraCuller);
+    }
 }
 
-void draw(const SeMeshAssetValue* mesh, const SeMeshGeometry* geometry, const SeDynamicArray<SeFloat4x4>& transforms)
+void draw(const SeMeshAssetValue* mesh, const SeMeshCulledGeometry& culled)
 {
-    const SeDataProvider data = se_data_provider_from_memory(se_dynamic_array_raw(transforms), se_dynamic_array_raw_size(transforms));
-    const SeBufferRef instancesBuffer = se_render_scratch_memory_buffer({ data });
+    const SeMeshGeometry* const geometry = culled.geometry;
     const SeTextureRef colorTexture = mesh->textureSets[geometry->textureSetIndex].colorTexture;
     se_render_bind
     ({
@@ -63,11 +99,11 @@ void draw(const SeMeshAssetValue* mesh, const SeMeshGeometry* geometry, const Se
             { .binding = 0, .type = SeBinding::BUFFER, .buffer = geometry->positionBuffer },
             { .binding = 1, .type = SeBinding::BUFFER, .buffer = geometry->uvBuffer },
             { .binding = 2, .type = SeBinding::BUFFER, .buffer = geometry->indicesBuffer },
-            { .binding = 3, .type = SeBinding::BUFFER, .buffer = instancesBuffer },
+            { .binding = 3, .type = SeBinding::BUFFER, .buffer = { culled.transformsBuffer, culled.transformsOffset, culled.transformsSize } },
             { .binding = 4, .type = SeBinding::TEXTURE, .texture = { colorTexture, g_sampler } },
         }
     });
-    se_render_draw({ geometry->numIndices, se_dynamic_array_size<uint32_t>(transforms) });
+    se_render_draw_indirect(culled.draw);
 }
 
 void update(const SeUpdateInfo& info)
@@ -90,10 +126,26 @@ void update(const SeUpdateInfo& info)
                 .height = uint32_t(swapChainSize.height),
             });
         }
-        
+
+        const SeMeshAsset::Value* const cameraMesh = se_asset_access<SeMeshAsset>(g_cameraMesh);
+        const SeMeshAsset::Value* const duckMesh = se_asset_access<SeMeshAsset>(g_duckMesh);
+        if (!g_areCullersConstructed)
+        {
+            se_mesh_culler_construct(&g_cameraCuller, { cameraMesh, NUM_CAMERAS });
+            se_mesh_culler_construct(&g_duckCuller, { duckMesh, NUM_DUCKS });
+            g_areCullersConstructed = true;
+        }
+
+        const float aspect = se_win_get_width<float>() / se_win_get_height<float>();
+        const SeFloat4x4 projection = se_render_perspective(60, aspect, 0.1f, 100.0f);
+        const SeFloat4x4 viewProjection = projection * se_float4x4_inverted(g_camera.trf);
+        const SePassDependencies cullDependencies =
+            se_mesh_culler_cull(&g_cameraCuller, { g_cameraInstances, NUM_CAMERAS, viewProjection, 0 }) |
+            se_mesh_culler_cull(&g_duckCuller, { g_duckInstances, NUM_DUCKS, viewProjection, 0 });
+
         se_render_begin_graphics_pass
         ({
-            .dependencies           = 0,
+            .dependencies           = cullDependencies,
             .vertexProgram          = { g_drawVs },
             .fragmentProgram        = { g_drawFs },
             .frontStencilOpState    = { .isEnabled = false },
@@ -107,32 +159,13 @@ void update(const SeUpdateInfo& info)
             .depthStencilTarget     = { g_depthTexture, SeRenderTargetLoadOp::CLEAR },
         });
 
-        const float aspect = se_win_get_width<float>() / se_win_get_height<float>();
-        const SeFloat4x4 projection = se_render_perspective(60, aspect, 0.1f, 100.0f);
-        const SeFloat4x4 viewProjection = projection * se_float4x4_inverted(g_camera.trf);
-
-        const SeMeshAsset::Value* const cameraMesh = se_asset_access<SeMeshAsset>(g_cameraMesh);
-        const auto cameraInstances = se_dynamic_array_create<SeMeshInstanceData>(se_allocator_frame(),
-        {
-            { SE_F4X4_IDENTITY },
-            { se_float4x4_from_position({ 4, 0, 0 }) },
-            { se_float4x4_from_position({ -4, 0, 0 }) },
-        });
-        for (auto it : SeMeshIterator{ cameraMesh, cameraInstances, viewProjection })
+        for (size_t it = 0; it < cameraMesh->numGeometries; it++)
         {
-            draw(cameraMesh, it.geometry, it.transformsWs);
+            draw(cameraMesh, se_mesh_culler_get_geometry(&g_cameraCuller, it));
         }
-
-        const SeMeshAsset::Value* const duckMesh = se_asset_access<SeMeshAsset>(g_duckMesh);
-        const auto duckInstances = se_dynamic_array_create<SeMeshInstanceData>(se_allocator_frame(),
-        {
-            { se_float4x4_from_position({ 0, 0, -2 }) },
-            { se_float4x4_from_position({ 4, 0, -2 }) },
-            { se_float4x4_from_position({ -4, 0, -2 }) },
-        });
-        for (auto it : SeMeshIterator{ duckMesh, duckInstances, viewProjection })
+        for (size_t it = 0; it < duckMesh->numGeometries; it++)
         {
-            draw(duckMesh, it.geometry, it.transformsWs);
+            draw(duckMesh, se_mesh_culler_get_geometry(&g_duckCuller, it));
         }
 
         se_render_end_pass();
@@ -0,0 +1,207 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+
+//
+// Object cache benchmark. Keeps thousands of compute pipelines (variants of the same program with different specialization
+// constants) in the render graph caches and measures cpu time spent on eviction of unused objects. All variants are
+// prewarmed again every few frames, so they stay cached, but only a few of them are dispatched. Cache size grows from phase
+// to phase, while the eviction time and the number of objects examined per frame should stay the same, because only
+// the oldest entries of the lru lists are looked at.
+//
+
+constexpr size_t CACHE_SIZES[] = { 256, 1024, 4096, 8192 };
+constexpr size_t NUM_OBJECT_CACHES = 4;     // Render passes, framebuffers, graphics pipelines and compute pipelines
+constexpr size_t NUM_ACTIVE_VARIANTS = 4;   // Dispatched every frame
+constexpr size_t PREWARM_BATCH_SIZE = 256;
+constexpr size_t REFRESH_FRAMES = 10;       // Must be less than the object lifetime of the render graph (20 frames)
+constexpr size_t PHASE_FRAMES = 240;
+constexpr size_t WARMUP_FRAMES = 40;        // Objects of the previous phase are evicted during these frames
+constexpr uint32_t NUM_VALUES = 64;
+
+SeDataProvider g_fontDataEnglish;
+SeProgramRef g_writeVariantCs;
+SeBufferRef g_valuesBuffer;
+
+size_t g_phase;
+size_t g_phaseFrame;
+uint32_t g_phaseFirstVariant;
+uint32_t g_nextVariant;
+size_t g_numMeasuredFrames;
+float g_accumulatedEvictionMs;
+size_t g_accumulatedExamined;
+size_t g_maxExamined;
+SeString g_resultStrings[se_array_size(CACHE_SIZES)];
+
+SeProgramWithConstants variant_program(uint32_t variant)
+{
+    return
+    {
+        .program = g_writeVariantCs,
+        .specializationConstants = { { .constantId = 0, .asUint = variant, } },
+        .numSpecializationConstants = 1,
+    };
+}
+
+void init()
+{
+    g_fontDataEnglish = se_data_provider_from_file("shahd serif.ttf");
+    g_writeVariantCs = se_render_program({ se_data_provider_from_file("write_variant.comp.spv") });
+    g_valuesBuffer = se_render_memory_buffer({ se_data_provider_from_memory(nullptr, sizeof(uint32_t) * NUM_VALUES) });
+}
+
+void terminate()
+{
+    for (size_t it = 0; it < se_array_size(g_resultStrings); it++)
+    {
+        if (g_resultStrings[it].memory) se_string_destroy(g_resultStrings[it]);
+    }
+}
+
+void prewarm_phase_variants()
+{
+    const size_t cacheSize = CACHE_SIZES[g_phase];
+    SeComputePassInfo infos[PREWARM_BATCH_SIZE];
+    for (size_t batchIt = 0; batchIt < cacheSize; batchIt += PREWARM_BATCH_SIZE)
+    {
+        const size_t numInfos = se_min(PREWARM_BATCH_SIZE, cacheSize - batchIt);
+        for (size_t it = 0; it < numInfos; it++)
+        {
+            infos[it] =
+            {
+                .dependencies       = 0,
+                .program            = variant_program(g_phaseFirstVariant + uint32_t(batchIt + it)),
+                .compilationPolicy  = SePipelineCompilationPolicy::WAIT,
+            };
+        }
+        se_render_prewarm_compute_pipelines(infos, numInfos);
+    }
+}
+
+void update_measurements()
+{
+    const SeObjectCacheStats stats = se_render_object_cache_stats();
+    // Eviction stops at the first object of every cache that isn't expired
+    se_assert(stats.numExaminedObjects <= stats.numEvictedObjects + NUM_OBJECT_CACHES);
+    //
+    // Frames with pending pipelines are skipped, pipelines aren't evicted while compiler is busy
+    //
+    if (g_phaseFrame < WARMUP_FRAMES) return;
+    if (se_render_pipeline_compilation_stats().numPendingPipelines) return;
+    se_assert(stats.numCachedObjects >= CACHE_SIZES[g_phase]);
+    g_accumulatedEvictionMs += stats.lastFrameEvictionMs;
+    g_accumulatedExamined += stats.numExaminedObjects;
+    g_maxExamined = se_max(g_maxExamined, stats.numExaminedObjects);
+    g_numMeasuredFrames += 1;
+}
+
+void finish_phase()
+{
+    SeString& result = g_resultStrings[g_phase];
+    if (result.memory) se_string_destroy(result);
+    const size_t numFrames = se_max(g_numMeasuredFrames, size_t(1));
+    result = se_string_create_fmt
+    (
+        SeStringLifetime::PERSISTENT,
+        "{} cached pipelines : eviction {} ms, {} examined objects per frame (max {}), {} measured frames",
+        CACHE_SIZES[g_phase],
+        g_accumulatedEvictionMs / float(numFrames), float(g_accumulatedExamined) / float(numFrames), g_maxExamined, g_numMeasuredFrames
+    );
+    se_dbg_message("{}", result);
+
+    g_phase = (g_phase + 1) % se_array_size(CACHE_SIZES);
+    g_phaseFrame = 0;
+    g_numMeasuredFrames = 0;
+    g_accumulatedEvictionMs = 0.0f;
+    g_accumulatedExamined = 0;
+    g_maxExamined = 0;
+}
+
+void update(const SeUpdateInfo& info)
+{
+    if (se_win_is_close_button_pressed() || se_win_is_keyboard_button_pressed(SeKeyboard::ESCAPE)) se_engine_stop();
+
+    if (se_render_begin_frame())
+    {
+        //
+        // Every phase uses new variants, so previous ones expire and the cache holds only the variants of the current phase
+        //
+        if (g_phaseFrame == 0)
+        {
+            g_phaseFirstVariant = g_nextVariant;
+            g_nextVariant += uint32_t(CACHE_SIZES[g_phase]);
+        }
+        if ((g_phaseFrame % REFRESH_FRAMES) == 0) prewarm_phase_variants();
+        update_measurements();
+
+        SePassDependencies previousPass = 0;
+        for (size_t it = 0; it < NUM_ACTIVE_VARIANTS; it++)
+        {
+            previousPass = se_render_begin_compute_pass
+            ({
+                .dependencies       = previousPass,
+                .program            = variant_program(g_phaseFirstVariant + uint32_t(it)),
+                .compilationPolicy  = SePipelineCompilationPolicy::WAIT,
+            });
+            se_render_bind({ .set = 0, .bindings = { { .binding = 0, .type = SeBinding::BUFFER, .buffer = { g_valuesBuffer } } } });
+            se_render_dispatch({ .groupCountX = 1, .groupCountY = 1, .groupCountZ = 1 });
+            se_render_end_pass();
+        }
+
+        if (se_ui_begin({ se_render_swap_chain_texture(), SeRenderTargetLoadOp::CLEAR }))
+        {
+            se_ui_set_font_group({ g_fontDataEnglish });
+
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_X, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_Y, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_X, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_Y, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::FONT_HEIGHT, { .dim = 20.0f });
+            se_ui_set_param(SeUiParam::FONT_LINE_GAP, { .dim = 2.0f });
+
+            if (se_ui_begin_window
+            ({
+                .uid    = "Results",
+                .width  = se_win_get_width<float>(),
+                .height = se_win_get_height<float>(),
+                .flags  = 0,
+            }))
+            {
+                const SeObjectCacheStats stats = se_render_object_cache_stats();
+                const SeString header = se_string_create_fmt
+                (
+                    SeStringLifetime::TEMPORARY,
+                    "Measuring {} cached pipelines, {} objects in cache",
+                    CACHE_SIZES[g_phase],
+                    stats.numCachedObjects
+                );
+                se_ui_text({ .utf8text = se_string_cstr(header) });
+                for (size_t it = 0; it < se_array_size(g_resultStrings); it++)
+                {
+                    if (g_resultStrings[it].memory) se_ui_text({ .utf8text = se_string_cstr(g_resultStrings[it]) });
+                }
+                se_ui_end_window();
+            }
+
+            se_ui_end(previousPass);
+        }
+        se_render_end_frame();
+
+        g_phaseFrame += 1;
+        if (g_phaseFrame == PHASE_FRAMES) finish_phase();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const SeSettings settings
+    {
+        .applicationName        = "Sabrina engine - object cache benchmark",
+        .isFullscreenWindow     = false,
+        .isResizableWindow      = false,
+        .windowWidth            = 800,
+        .windowHeight           = 480,
+        .createUserDataFolder   = false,
+    };
+    se_engine_run(settings, init, update, terminate);
+    return 0;
+}
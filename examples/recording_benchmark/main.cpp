@@ -0,0 +1,284 @@
+
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+
+//
+// Command recording benchmark. Records a lot of passes with a lot of draws every frame and cycles the number of recording threads,
+// passes with more than SeVkConfig::GRAPH_SECONDARY_BUFFER_MIN_COMMANDS commands are split into secondary command buffers.
+// Each line of results is one thread count : recording time, speedup over a single thread and the number of command
+// buffers, submits and reused objects.
+//
+// All bind commands reference the same static buffers, so with descriptor set caching steady state frames shouldn't
+// allocate or write any descriptor sets. Space toggles caching and restarts measurements, last line shows time spent on
+// getting descriptor sets together with allocations and writes.
+//
+
+struct FrameData
+{
+    SeFloat4x4 viewProjection;
+};
+
+struct InputVertex
+{
+    SeFloat3    positionLS;
+    float       pad1;
+    SeFloat2    uv;
+    float       pad2[2];
+    SeFloat4    color;
+};
+
+struct InputInstanceData
+{
+    SeFloat4x4 trfWS;
+};
+
+constexpr size_t NUM_PASSES = 16;
+constexpr size_t NUM_DRAWS_PER_PASS = 2048;
+constexpr size_t NUM_DRAWS_PER_BIND = 64;
+constexpr size_t NUM_INSTANCE_BUFFERS = 32;
+constexpr size_t FRAMES_PER_MEASUREMENT = 120;
+constexpr size_t MAX_THREADS = 64;
+constexpr size_t WARMUP_FRAMES = 16;
+
+SeDataProvider g_fontDataEnglish;
+SeDataProvider g_vertexProgramData;
+SeDataProvider g_fragmentProgramData;
+
+size_t g_maxThreads;
+size_t g_numThreads;
+size_t g_numMeasuredFrames;
+size_t g_numWarmupFrames = WARMUP_FRAMES;
+bool g_isCachingEnabled = true;
+float g_accumulatedMs;
+float g_accumulatedDescriptorMs;
+float g_results[MAX_THREADS];
+SeString g_resultStrings[MAX_THREADS];
+SeString g_descriptorResultString;
+
+void init()
+{
+    g_fontDataEnglish = se_data_provider_from_file("shahd serif.ttf");
+    g_vertexProgramData = se_data_provider_from_file("flat_color.vert.spv");
+    g_fragmentProgramData = se_data_provider_from_file("flat_color.frag.spv");
+    //
+    // Recording thread count is clamped by the renderer, so this is the max available thread count
+    //
+    se_render_set_num_recording_threads(MAX_THREADS);
+    g_maxThreads = se_min(se_render_command_recording_stats().numThreads, MAX_THREADS);
+    g_numThreads = 1;
+    se_render_set_num_recording_threads(g_numThreads);
+    se_render_set_descriptor_set_caching(g_isCachingEnabled);
+}
+
+void destroy_results()
+{
+    for (size_t it = 0; it < MAX_THREADS; it++)
+    {
+        if (g_resultStrings[it].memory) se_string_destroy(g_resultStrings[it]);
+        g_resultStrings[it] = { };
+    }
+    if (g_descriptorResultString.memory) se_string_destroy(g_descriptorResultString);
+    g_descriptorResultString = { };
+}
+
+void terminate()
+{
+    destroy_results();
+}
+
+void restart_measurements(size_t numThreads)
+{
+    g_numThreads = numThreads;
+    se_render_set_num_recording_threads(g_numThreads);
+    g_accumulatedMs = 0.0f;
+    g_accumulatedDescriptorMs = 0.0f;
+    g_numMeasuredFrames = 0;
+    g_numWarmupFrames = WARMUP_FRAMES;
+}
+
+void toggle_descriptor_set_caching()
+{
+    //
+    // Results with and without caching aren't comparable, so thread counts are measured again from the single thread
+    //
+    g_isCachingEnabled = !g_isCachingEnabled;
+    se_render_set_descriptor_set_caching(g_isCachingEnabled);
+    destroy_results();
+    restart_measurements(1);
+}
+
+void update_measurements()
+{
+    //
+    // Stats are for the previous frame. Frames right after a change are skipped, because thread count change applies
+    // to the next frame and the descriptor set cache is still being filled (or uncached sets are still being freed)
+    //
+    if (g_numWarmupFrames)
+    {
+        g_numWarmupFrames -= 1;
+        return;
+    }
+    const SeCommandRecordingStats stats = se_render_command_recording_stats();
+    const SeDescriptorSetStats descriptorStats = se_render_descriptor_set_stats();
+    g_accumulatedMs += stats.lastFrameRecordingMs;
+    g_accumulatedDescriptorMs += descriptorStats.lastFrameMs;
+    g_numMeasuredFrames += 1;
+    if (g_numMeasuredFrames < FRAMES_PER_MEASUREMENT) return;
+
+    const size_t resultIndex = g_numThreads - 1;
+    g_results[resultIndex] = g_accumulatedMs / float(g_numMeasuredFrames);
+    if (g_resultStrings[resultIndex].memory) se_string_destroy(g_resultStrings[resultIndex]);
+    g_resultStrings[resultIndex] = se_string_create_fmt
+    (
+        SeStringLifetime::PERSISTENT,
+        "{} threads : {} ms ({}x), {} primary, {} secondary buffers, {} submits, {} created, {} reused",
+        g_numThreads, g_results[resultIndex], g_results[0] / g_results[resultIndex], stats.numPrimaryBuffers, stats.numSecondaryBuffers, stats.numQueueSubmits,
+        stats.numCreatedObjects, stats.numReusedBuffers
+    );
+    se_dbg_message("{}", g_resultStrings[resultIndex]);
+
+    if (g_descriptorResultString.memory) se_string_destroy(g_descriptorResultString);
+    g_descriptorResultString = se_string_create_fmt
+    (
+        SeStringLifetime::PERSISTENT,
+        "Descriptor sets : {} ms, {} binds, {} hits, {} allocations, {} template writes, {} fallback writes, {} freed",
+        g_accumulatedDescriptorMs / float(g_numMeasuredFrames), descriptorStats.numBinds, descriptorStats.numCacheHits,
+        descriptorStats.numAllocations, descriptorStats.numTemplateWrites, descriptorStats.numFallbackWrites, descriptorStats.numFreedSets
+    );
+    se_dbg_message("{}", g_descriptorResultString);
+
+    restart_measurements((g_numThreads % g_maxThreads) + 1);
+}
+
+void update(const SeUpdateInfo& info)
+{
+    if (se_win_is_close_button_pressed() || se_win_is_keyboard_button_pressed(SeKeyboard::ESCAPE)) se_engine_stop();
+    if (se_win_is_keyboard_button_just_pressed(SeKeyboard::SPACE)) toggle_descriptor_set_caching();
+
+    static const InputVertex vertices[] =
+    {
+        { .positionLS = { -0.05f, -0.05f, 3 }, .uv = { 0, 0 }, .color = { 0.7f, 0.5f, 0.5f, 1.0f, } },
+        { .positionLS = {  0.05f, -0.05f, 3 }, .uv = { 1, 1 }, .color = { 0.5f, 0.7f, 0.5f, 1.0f, } },
+        { .positionLS = {  0.0f,   0.05f, 3 }, .uv = { 1, 0 }, .color = { 0.5f, 0.5f, 0.7f, 1.0f, } },
+    };
+    static const float aspect = ((float)se_win_get_width()) / ((float)se_win_get_height());
+    static const FrameData frameData
+    {
+        .viewProjection = se_float4x4_transposed
+        (
+            se_float4x4_mul
+            (
+                se_render_perspective(60, aspect, 0.1f, 100.0f),
+                se_float4x4_inverted(se_float4x4_look_at({ 0, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 }))
+            )
+        ),
+    };
+    if (se_render_begin_frame())
+    {
+        update_measurements();
+
+        static const SeProgramRef vertexProgram = se_render_program({ g_vertexProgramData });
+        static const SeProgramRef fragmentProgram = se_render_program({ g_fragmentProgramData });
+        static const SeBufferRef frameDataBuffer = se_render_memory_buffer({ se_data_provider_from_memory(&frameData, sizeof(frameData)) });
+        static const SeBufferRef verticesBuffer = se_render_memory_buffer({ se_data_provider_from_memory(vertices, sizeof(vertices)) });
+        static SeBufferRef instanceBuffers[NUM_INSTANCE_BUFFERS] = { };
+        if (!instanceBuffers[0])
+        {
+            for (size_t it = 0; it < NUM_INSTANCE_BUFFERS; it++)
+            {
+                const float x = (float(it % 8) - 3.5f) * 0.4f;
+                const float y = (float(it / 8) - 1.5f) * 0.4f;
+                const InputInstanceData instance { .trfWS = se_float4x4_transposed(se_float4x4_from_position({ x, y, 0.0f })) };
+                instanceBuffers[it] = se_render_memory_buffer({ se_data_provider_from_memory(&instance, sizeof(instance)) });
+            }
+        }
+
+        SePassDependencies previousPass = 0;
+        for (size_t passIt = 0; passIt < NUM_PASSES; passIt++)
+        {
+            previousPass = se_render_begin_graphics_pass
+            ({
+                .dependencies           = previousPass,
+                .vertexProgram          = { .program = vertexProgram, },
+                .fragmentProgram        = { .program = fragmentProgram, },
+                .frontStencilOpState    = { .isEnabled = false, },
+                .backStencilOpState     = { .isEnabled = false, },
+                .depthState             = { .isTestEnabled = false, .isWriteEnabled = false, },
+                .polygonMode            = SePipelinePolygonMode::FILL,
+                .cullMode               = SePipelineCullMode::NONE,
+                .frontFace              = SePipelineFrontFace::CLOCKWISE,
+                .samplingType           = SeSamplingType::_1,
+                .renderTargets          = { { se_render_swap_chain_texture(), passIt == 0 ? SeRenderTargetLoadOp::CLEAR : SeRenderTargetLoadOp::LOAD } },
+                .depthStencilTarget     = { },
+            });
+            se_render_bind({ .set = 0, .bindings = { { .binding = 0, .type = SeBinding::BUFFER, .buffer = { frameDataBuffer } } } });
+            for (size_t drawIt = 0; drawIt < NUM_DRAWS_PER_PASS; drawIt++)
+            {
+                if ((drawIt % NUM_DRAWS_PER_BIND) == 0)
+                {
+                    const SeBufferRef instanceBuffer = instanceBuffers[(passIt + drawIt / NUM_DRAWS_PER_BIND) % NUM_INSTANCE_BUFFERS];
+                    se_render_bind({ .set = 1, .bindings =
+                    {
+                        { .binding = 0, .type = SeBinding::BUFFER, .buffer = { verticesBuffer } },
+                        { .binding = 1, .type = SeBinding::BUFFER, .buffer = { instanceBuffer } }
+                    } });
+                }
+                se_render_draw({ .numVertices = se_array_size(vertices), .numInstances = 1 });
+            }
+            se_render_end_pass();
+        }
+
+        if (se_ui_begin({ se_render_swap_chain_texture(), SeRenderTargetLoadOp::LOAD }))
+        {
+            se_ui_set_font_group({ g_fontDataEnglish });
+
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_X, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_Y, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_X, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_Y, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::FONT_HEIGHT, { .dim = 20.0f });
+            se_ui_set_param(SeUiParam::FONT_LINE_GAP, { .dim = 2.0f });
+
+            if (se_ui_begin_window
+            ({
+                .uid    = "Results",
+                .width  = se_win_get_width<float>(),
+                .height = se_win_get_height<float>(),
+                .flags  = 0,
+            }))
+            {
+                const SeString header = se_string_create_fmt
+                (
+                    SeStringLifetime::TEMPORARY,
+                    "Recording with {} threads, descriptor set caching is {}",
+                    g_numThreads, g_isCachingEnabled ? "on" : "off"
+                );
+                se_ui_text({ .utf8text = se_string_cstr(header) });
+                for (size_t it = 0; it < g_maxThreads; it++)
+                {
+                    if (g_resultStrings[it].memory) se_ui_text({ .utf8text = se_string_cstr(g_resultStrings[it]) });
+                }
+                if (g_descriptorResultString.memory) se_ui_text({ .utf8text = se_string_cstr(g_descriptorResultString) });
+                se_ui_end_window();
+            }
+
+            se_ui_end(previousPass);
+        }
+        se_render_end_frame();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const SeSettings settings
+    {
+        .applicationName        = "Sabrina engine - command recording benchmark",
+        .isFullscreenWindow     = false,
+        .isResizableWindow      = false,
+        .windowWidth            = 800,
+        .windowHeight           = 480,
+        .createUserDataFolder   = false,
+    };
+    se_engine_run(settings, init, update, terminate);
+    return 0;
+}
@@ -0,0 +1,17 @@
+#version 450
+
+// Render target of the pattern pass (SeGraphicsPassInfo::inputAttachments[0])
+layout(input_attachment_index = 0, set = 0, binding = 0) uniform subpassInput inPattern;
+
+layout(location = 0) in vec2 inUv;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    vec3 color = subpassLoad(inPattern).rgb;
+    float luminance = dot(color, vec3(0.299, 0.587, 0.114));
+    vec2 fromCenter = inUv - 0.5;
+    float vignette = 1.0 - dot(fromCenter, fromCenter) * 1.5;
+    outColor = vec4(mix(vec3(luminance), color, 0.6) * vignette, 1.0);
+}
@@ -0,0 +1,14 @@
+#version 450
+
+layout(push_constant) uniform PatternData { float time; };
+
+layout(location = 0) in vec2 inUv;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    vec2 p = inUv * 12.0;
+    float wave = sin(p.x + time) * cos(p.y - time * 0.7);
+    outColor = vec4(0.5 + 0.5 * wave, 0.5 + 0.5 * sin(time + inUv.x * 3.0), inUv.y, 1.0);
+}
@@ -0,0 +1,147 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+
+//
+// Subpass merging example. Pattern pass renders to an offscreen texture, composite pass reads it as an input attachment
+// and writes to the swap chain, then ui is drawn on top. With subpass merging all three passes become subpasses of
+// a single render pass (one primary command buffer), so the offscreen texture is read from tile memory on tiled gpus.
+// Press SPACE to toggle merging and compare recording stats.
+//
+
+SeDataProvider g_fontDataEnglish;
+SeProgramRef g_fullscreenVs;
+SeProgramRef g_patternFs;
+SeProgramRef g_compositeFs;
+SeTextureRef g_patternTexture;
+bool g_isMergingEnabled = true;
+float g_time = 0.0f;
+
+void init()
+{
+    g_fontDataEnglish = se_data_provider_from_file("shahd serif.ttf");
+    g_fullscreenVs = se_render_program({ se_data_provider_from_file("fullscreen.vert.spv") });
+    g_patternFs = se_render_program({ se_data_provider_from_file("pattern.frag.spv") });
+    g_compositeFs = se_render_program({ se_data_provider_from_file("composite.frag.spv") });
+    g_patternTexture = se_render_texture
+    ({
+        .format = SeTextureFormat::RGBA_8_UNORM,
+        .width  = se_win_get_width(),
+        .height = se_win_get_height(),
+    });
+}
+
+void terminate()
+{
+
+}
+
+SeGraphicsPassInfo fullscreen_pass_info(SeProgramRef fragmentProgram, SePassDependencies dependencies)
+{
+    return
+    {
+        .dependencies           = dependencies,
+        .vertexProgram          = { .program = g_fullscreenVs, },
+        .fragmentProgram        = { .program = fragmentProgram, },
+        .frontStencilOpState    = { .isEnabled = false, },
+        .backStencilOpState     = { .isEnabled = false, },
+        .depthState             = { .isTestEnabled = false, .isWriteEnabled = false, },
+        .polygonMode            = SePipelinePolygonMode::FILL,
+        .cullMode               = SePipelineCullMode::NONE,
+        .frontFace              = SePipelineFrontFace::CLOCKWISE,
+        .samplingType           = SeSamplingType::_1,
+        .renderTargets          = { },
+        .depthStencilTarget     = { },
+    };
+}
+
+void update(const SeUpdateInfo& info)
+{
+    if (se_win_is_close_button_pressed() || se_win_is_keyboard_button_pressed(SeKeyboard::ESCAPE)) se_engine_stop();
+    if (se_win_is_keyboard_button_just_pressed(SeKeyboard::SPACE))
+    {
+        g_isMergingEnabled = !g_isMergingEnabled;
+        se_render_set_subpass_merging(g_isMergingEnabled);
+    }
+    g_time += info.dt;
+
+    if (se_render_begin_frame())
+    {
+        const SeTextureSize swapChainSize = se_render_texture_size(se_render_swap_chain_texture());
+        if (!se_compare(se_render_texture_size(g_patternTexture), swapChainSize))
+        {
+            se_render_destroy(g_patternTexture);
+            g_patternTexture = se_render_texture
+            ({
+                .format = SeTextureFormat::RGBA_8_UNORM,
+                .width  = uint32_t(swapChainSize.width),
+                .height = uint32_t(swapChainSize.height),
+            });
+        }
+
+        SeGraphicsPassInfo patternPassInfo = fullscreen_pass_info(g_patternFs, 0);
+        patternPassInfo.renderTargets[0] = { g_patternTexture, SeRenderTargetLoadOp::CLEAR };
+        const SePassDependencies patternPass = se_render_begin_graphics_pass(patternPassInfo);
+        se_render_push_constants({ se_data_provider_from_memory(&g_time, sizeof(g_time)) });
+        se_render_draw({ .numVertices = 3, .numInstances = 1 });
+        se_render_end_pass();
+
+        SeGraphicsPassInfo compositePassInfo = fullscreen_pass_info(g_compositeFs, patternPass);
+        compositePassInfo.renderTargets[0] = { se_render_swap_chain_texture(), SeRenderTargetLoadOp::CLEAR };
+        compositePassInfo.inputAttachments[0] = g_patternTexture;
+        const SePassDependencies compositePass = se_render_begin_graphics_pass(compositePassInfo);
+        se_render_bind({ .set = 0, .bindings = { { .binding = 0, .type = SeBinding::TEXTURE, .texture = { g_patternTexture } } } });
+        se_render_draw({ .numVertices = 3, .numInstances = 1 });
+        se_render_end_pass();
+
+        if (se_ui_begin({ se_render_swap_chain_texture(), SeRenderTargetLoadOp::LOAD }))
+        {
+            se_ui_set_font_group({ g_fontDataEnglish });
+
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_X, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_Y, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_X, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_Y, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::FONT_HEIGHT, { .dim = 20.0f });
+            se_ui_set_param(SeUiParam::FONT_LINE_GAP, { .dim = 2.0f });
+
+            if (se_ui_begin_window
+            ({
+                .uid    = "Stats",
+                .width  = se_win_get_width<float>(),
+                .height = 60.0f,
+                .flags  = 0,
+            }))
+            {
+                const SeCommandRecordingStats stats = se_render_command_recording_stats();
+                const SeString header = se_string_create_fmt(SeStringLifetime::TEMPORARY, "Subpass merging is {} (press SPACE to toggle)", g_isMergingEnabled ? "enabled" : "disabled");
+                const SeString text = se_string_create_fmt
+                (
+                    SeStringLifetime::TEMPORARY,
+                    "{} primary buffers, {} merged passes, recording {} ms",
+                    stats.numPrimaryBuffers, stats.numMergedPasses, stats.lastFrameRecordingMs
+                );
+                se_ui_text({ .utf8text = se_string_cstr(header) });
+                se_ui_text({ .utf8text = se_string_cstr(text) });
+                se_ui_end_window();
+            }
+
+            se_ui_end(compositePass);
+        }
+        se_render_end_frame();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const SeSettings settings
+    {
+        .applicationName        = "Sabrina engine - subpass merging example",
+        .isFullscreenWindow     = false,
+        .isResizableWindow      = true,
+        .windowWidth            = 800,
+        .windowHeight           = 480,
+        .createUserDataFolder   = false,
+    };
+    se_engine_run(settings, init, update, terminate);
+    return 0;
+}
@@ -0,0 +1,146 @@
+
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+
+//
+// Encodes sample images with every supported block compression format and reports
+// quality (PSNR of the decoded image) and encoding time. Encoded data is also uploaded to gpu textures.
+//
+
+struct CompressionMode
+{
+    SeTextureFormat format;
+    const char*     name;
+    size_t          numChannels;
+};
+
+const CompressionMode COMPRESSION_MODES[] =
+{
+    { SeTextureFormat::BC1_RGBA_UNORM,  "BC1", 3 },
+    { SeTextureFormat::BC3_UNORM,       "BC3", 4 },
+    { SeTextureFormat::BC4_UNORM,       "BC4", 1 },
+    { SeTextureFormat::BC5_UNORM,       "BC5", 2 },
+    { SeTextureFormat::BC7_UNORM,       "BC7", 4 },
+};
+
+const char* const SAMPLE_IMAGES[] =
+{
+    "grass.png",
+    "rocks.png",
+};
+
+constexpr size_t NUM_RESULTS = se_array_size(COMPRESSION_MODES) * se_array_size(SAMPLE_IMAGES);
+
+SeDataProvider g_fontDataEnglish;
+SeString g_results[NUM_RESULTS];
+SeTextureRef g_textures[NUM_RESULTS];
+
+void init()
+{
+    g_fontDataEnglish = se_data_provider_from_file("shahd serif.ttf");
+
+    const SeAllocatorBindings allocator = se_allocator_persistent();
+    const double counterFrequency = double(_se_get_perf_frequency());
+    size_t resultIndex = 0;
+    for (const char* imageName : SAMPLE_IMAGES)
+    {
+        const SeDataProvider imageData = se_data_provider_from_file(imageName);
+        const auto [sourcePtr, sourceSize] = se_data_provider_get(imageData);
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        uint8_t* const rgba = stbi_load_from_memory((const stbi_uc*)sourcePtr, int(sourceSize), &width, &height, &channels, 4);
+        se_assert(rgba);
+
+        const size_t decodedSize = size_t(width) * height * 4;
+        uint8_t* const decoded = (uint8_t*)se_alloc(allocator, decodedSize, se_alloc_tag);
+        for (const CompressionMode& mode : COMPRESSION_MODES)
+        {
+            const size_t encodedSize = se_texture_compression_get_size(mode.format, uint32_t(width), uint32_t(height));
+            void* const encoded = se_alloc(allocator, encodedSize, se_alloc_tag);
+
+            const uint64_t encodeBegin = _se_get_perf_counter();
+            se_texture_compression_encode(mode.format, rgba, uint32_t(width), uint32_t(height), encoded);
+            const uint64_t encodeEnd = _se_get_perf_counter();
+            se_texture_compression_decode(mode.format, encoded, uint32_t(width), uint32_t(height), decoded);
+
+            const float psnr = se_texture_compression_psnr(rgba, decoded, uint32_t(width), uint32_t(height), mode.numChannels);
+            const float encodeTimeMs = float(double(encodeEnd - encodeBegin) / counterFrequency * 1000.0);
+            g_results[resultIndex] = se_string_create_fmt(SeStringLifetime::PERSISTENT, "{} {}x{} {} : PSNR {} dB, encode {} ms", imageName, width, height, mode.name, psnr, encodeTimeMs);
+            se_dbg_message("{}", g_results[resultIndex]);
+
+            g_textures[resultIndex] = se_render_texture
+            ({
+                .format = mode.format,
+                .width  = uint32_t(width),
+                .height = uint32_t(height),
+                .data   = se_data_provider_from_memory(encoded, encodedSize),
+            });
+            resultIndex += 1;
+            se_dealloc(allocator, encoded, encodedSize);
+        }
+        se_dealloc(allocator, decoded, decodedSize);
+        stbi_image_free(rgba);
+    }
+}
+
+void terminate()
+{
+    for (size_t it = 0; it < NUM_RESULTS; it++)
+    {
+        se_string_destroy(g_results[it]);
+        se_render_destroy(g_textures[it]);
+    }
+}
+
+void update(const SeUpdateInfo& info)
+{
+    if (se_win_is_close_button_pressed()) se_engine_stop();
+    if (se_render_begin_frame())
+    {
+        if (se_ui_begin({ se_render_swap_chain_texture(), SeRenderTargetLoadOp::CLEAR, { 0.0f, 0.0f, 0.0f, 1.0f } }))
+        {
+            se_ui_set_font_group({ g_fontDataEnglish });
+
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_X, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_Y, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_X, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_Y, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::FONT_HEIGHT, { .dim = 20.0f });
+            se_ui_set_param(SeUiParam::FONT_LINE_GAP, { .dim = 2.0f });
+
+            if (se_ui_begin_window
+            ({
+                .uid    = "Results",
+                .width  = se_win_get_width<float>(),
+                .height = se_win_get_height<float>(),
+                .flags  = 0,
+            }))
+            {
+                for (size_t it = 0; it < NUM_RESULTS; it++)
+                {
+                    se_ui_text({ .utf8text = se_string_cstr(g_results[it]) });
+                }
+                se_ui_end_window();
+            }
+
+            se_ui_end(0);
+        }
+        se_render_end_frame();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const SeSettings settings
+    {
+        .applicationName        = "Sabrina engine - texture compression",
+        .isFullscreenWindow     = false,
+        .isResizableWindow      = true,
+        .windowWidth            = 800,
+        .windowHeight           = 480,
+        .createUserDataFolder   = false,
+    };
+    se_engine_run(settings, init, update, terminate);
+    return 0;
+}
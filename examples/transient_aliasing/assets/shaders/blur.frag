@@ -0,0 +1,22 @@
+#version 450
+
+layout(set = 0, binding = 0) uniform sampler2D inSource;
+
+layout(push_constant) uniform BlurData { vec2 direction; };
+
+layout(location = 0) in vec2 inUv;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    // 9 tap gaussian blur along the direction (direction is in uv units per tap)
+    const float weights[5] = float[](0.227027, 0.1945946, 0.1216216, 0.054054, 0.016216);
+    vec3 color = texture(inSource, inUv).rgb * weights[0];
+    for (int it = 1; it < 5; it++)
+    {
+        color += texture(inSource, inUv + direction * float(it)).rgb * weights[it];
+        color += texture(inSource, inUv - direction * float(it)).rgb * weights[it];
+    }
+    outColor = vec4(color, 1.0);
+}
@@ -0,0 +1,15 @@
+#version 450
+
+layout(set = 0, binding = 0) uniform sampler2D inSharp;
+layout(set = 0, binding = 1) uniform sampler2D inBlurred;
+
+layout(location = 0) in vec2 inUv;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    // Blurred image on the left, sharp one on the right
+    vec3 color = inUv.x < 0.5 ? texture(inBlurred, inUv).rgb : texture(inSharp, inUv).rgb;
+    outColor = vec4(color, 1.0);
+}
@@ -0,0 +1,14 @@
+#version 450
+
+// Transient attachment written by the pattern subpass (SeGraphicsPassInfo::inputAttachments[0])
+layout(input_attachment_index = 0, set = 0, binding = 0) uniform subpassInput inPattern;
+
+layout(location = 0) in vec2 inUv;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    vec3 color = subpassLoad(inPattern).rgb;
+    outColor = vec4(color / (color + 0.25) * 1.25, 1.0);
+}
@@ -0,0 +1,240 @@
+#include "engine/se_engine.hpp"
+#include "engine/se_engine.cpp"
+
+//
+// Transient aliasing example. Pattern is rendered to a transient attachment and tonemapped in a merged subpass, then
+// result goes through a chain of blur passes and is composited to the swap chain. Every intermediate render target is
+// transient, so targets that aren't used by the same passes share memory. Ui shows how much memory render targets
+// would take without aliasing and how much they actually take.
+//
+// Aliasing planner itself is checked without a device in checks/aliasing_planner.
+//
+
+#define NUM_BLUR_PASSES 4
+
+SeDataProvider g_fontDataEnglish;
+SeProgramRef g_fullscreenVs;
+SeProgramRef g_patternFs;
+SeProgramRef g_tonemapFs;
+SeProgramRef g_blurFs;
+SeProgramRef g_compositeFs;
+SeSamplerRef g_sampler;
+SeTextureRef g_patternTexture;                      // Transient attachment, never leaves the render pass
+SeTextureRef g_tonemappedTexture;                   // Transient, read by the first blur pass and by the composite pass
+SeTextureRef g_blurTextures[NUM_BLUR_PASSES];       // Transient, each one is read only by the next pass
+float g_time = 0.0f;
+
+//
+// Rendering
+//
+
+void create_render_targets(uint32_t width, uint32_t height)
+{
+    g_patternTexture = se_render_texture
+    ({
+        .format     = SeTextureFormat::RGBA_8_UNORM,
+        .width      = width,
+        .height     = height,
+        .lifetime   = SeTextureLifetime::TRANSIENT_ATTACHMENT,
+    });
+    g_tonemappedTexture = se_render_texture
+    ({
+        .format     = SeTextureFormat::RGBA_8_UNORM,
+        .width      = width,
+        .height     = height,
+        .lifetime   = SeTextureLifetime::TRANSIENT,
+    });
+    for (size_t it = 0; it < NUM_BLUR_PASSES; it++)
+    {
+        g_blurTextures[it] = se_render_texture
+        ({
+            .format     = SeTextureFormat::RGBA_8_UNORM,
+            .width      = width,
+            .height     = height,
+            .lifetime   = SeTextureLifetime::TRANSIENT,
+        });
+    }
+}
+
+void destroy_render_targets()
+{
+    se_render_destroy(g_patternTexture);
+    se_render_destroy(g_tonemappedTexture);
+    for (size_t it = 0; it < NUM_BLUR_PASSES; it++) se_render_destroy(g_blurTextures[it]);
+}
+
+void init()
+{
+    g_fontDataEnglish = se_data_provider_from_file("shahd serif.ttf");
+    g_fullscreenVs = se_render_program({ se_data_provider_from_file("fullscreen.vert.spv") });
+    g_patternFs = se_render_program({ se_data_provider_from_file("pattern.frag.spv") });
+    g_tonemapFs = se_render_program({ se_data_provider_from_file("tonemap.frag.spv") });
+    g_blurFs = se_render_program({ se_data_provider_from_file("blur.frag.spv") });
+    g_compositeFs = se_render_program({ se_data_provider_from_file("composite.frag.spv") });
+    g_sampler = se_render_sampler
+    ({
+        .magFilter          = SeSamplerFilter::LINEAR,
+        .minFilter          = SeSamplerFilter::LINEAR,
+        .addressModeU       = SeSamplerAddressMode::CLAMP_TO_EDGE,
+        .addressModeV       = SeSamplerAddressMode::CLAMP_TO_EDGE,
+        .addressModeW       = SeSamplerAddressMode::CLAMP_TO_EDGE,
+        .mipmapMode         = SeSamplerMipmapMode::NEAREST,
+        .mipLodBias         = 0.0f,
+        .minLod             = 0.0f,
+        .maxLod             = 0.0f,
+        .anisotropyEnable   = false,
+        .maxAnisotropy      = 0.0f,
+        .compareEnabled     = false,
+        .compareOp          = SeCompareOp::ALWAYS,
+    });
+    create_render_targets(se_win_get_width(), se_win_get_height());
+}
+
+void terminate()
+{
+
+}
+
+SeGraphicsPassInfo fullscreen_pass_info(SeProgramRef fragmentProgram, SePassDependencies dependencies)
+{
+    return
+    {
+        .dependencies           = dependencies,
+        .vertexProgram          = { .program = g_fullscreenVs, },
+        .fragmentProgram        = { .program = fragmentProgram, },
+        .frontStencilOpState    = { .isEnabled = false, },
+        .backStencilOpState     = { .isEnabled = false, },
+        .depthState             = { .isTestEnabled = false, .isWriteEnabled = false, },
+        .polygonMode            = SePipelinePolygonMode::FILL,
+        .cullMode               = SePipelineCullMode::NONE,
+        .frontFace              = SePipelineFrontFace::CLOCKWISE,
+        .samplingType           = SeSamplingType::_1,
+        .renderTargets          = { },
+        .depthStencilTarget     = { },
+    };
+}
+
+void update(const SeUpdateInfo& info)
+{
+    if (se_win_is_close_button_pressed() || se_win_is_keyboard_button_pressed(SeKeyboard::ESCAPE)) se_engine_stop();
+    g_time += info.dt;
+
+    if (se_render_begin_frame())
+    {
+        const SeTextureSize swapChainSize = se_render_texture_size(se_render_swap_chain_texture());
+        if (!se_compare(se_render_texture_size(g_tonemappedTexture), swapChainSize))
+        {
+            destroy_render_targets();
+            create_render_targets(uint32_t(swapChainSize.width), uint32_t(swapChainSize.height));
+        }
+        //
+        // Pattern and tonemap passes are merged, so the pattern texture is read from tile memory and is never stored
+        //
+        SeGraphicsPassInfo patternPassInfo = fullscreen_pass_info(g_patternFs, 0);
+        patternPassInfo.renderTargets[0] = { g_patternTexture, SeRenderTargetLoadOp::CLEAR };
+        const SePassDependencies patternPass = se_render_begin_graphics_pass(patternPassInfo);
+        se_render_push_constants({ se_data_provider_from_memory(&g_time, sizeof(g_time)) });
+        se_render_draw({ .numVertices = 3, .numInstances = 1 });
+        se_render_end_pass();
+
+        SeGraphicsPassInfo tonemapPassInfo = fullscreen_pass_info(g_tonemapFs, patternPass);
+        tonemapPassInfo.renderTargets[0] = { g_tonemappedTexture, SeRenderTargetLoadOp::CLEAR };
+        tonemapPassInfo.inputAttachments[0] = g_patternTexture;
+        SePassDependencies lastPass = se_render_begin_graphics_pass(tonemapPassInfo);
+        se_render_bind({ .set = 0, .bindings = { { .binding = 0, .type = SeBinding::TEXTURE, .texture = { g_patternTexture } } } });
+        se_render_draw({ .numVertices = 3, .numInstances = 1 });
+        se_render_end_pass();
+        //
+        // Blur chain. Every target is alive only while the previous and the next passes are executed
+        //
+        SeTextureRef source = g_tonemappedTexture;
+        for (size_t it = 0; it < NUM_BLUR_PASSES; it++)
+        {
+            const bool isHorizontal = (it % 2) == 0;
+            const float direction[2] =
+            {
+                isHorizontal ? 1.5f / float(swapChainSize.width) : 0.0f,
+                isHorizontal ? 0.0f : 1.5f / float(swapChainSize.height),
+            };
+            SeGraphicsPassInfo blurPassInfo = fullscreen_pass_info(g_blurFs, lastPass);
+            blurPassInfo.renderTargets[0] = { g_blurTextures[it], SeRenderTargetLoadOp::DONT_CARE };
+            lastPass = se_render_begin_graphics_pass(blurPassInfo);
+            se_render_push_constants({ se_data_provider_from_memory(direction, sizeof(direction)) });
+            se_render_bind({ .set = 0, .bindings = { { .binding = 0, .type = SeBinding::TEXTURE, .texture = { source, g_sampler } } } });
+            se_render_draw({ .numVertices = 3, .numInstances = 1 });
+            se_render_end_pass();
+            source = g_blurTextures[it];
+        }
+
+        SeGraphicsPassInfo compositePassInfo = fullscreen_pass_info(g_compositeFs, lastPass);
+        compositePassInfo.renderTargets[0] = { se_render_swap_chain_texture(), SeRenderTargetLoadOp::CLEAR };
+        const SePassDependencies compositePass = se_render_begin_graphics_pass(compositePassInfo);
+        se_render_bind
+        ({
+            .set = 0,
+            .bindings =
+            {
+                { .binding = 0, .type = SeBinding::TEXTURE, .texture = { g_tonemappedTexture, g_sampler } },
+                { .binding = 1, .type = SeBinding::TEXTURE, .texture = { source, g_sampler } },
+            }
+        });
+        se_render_draw({ .numVertices = 3, .numInstances = 1 });
+        se_render_end_pass();
+
+        if (se_ui_begin({ se_render_swap_chain_texture(), SeRenderTargetLoadOp::LOAD }))
+        {
+            se_ui_set_font_group({ g_fontDataEnglish });
+
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_X, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_TYPE_Y, { .enumeration = SeUiPivotType::BOTTOM_LEFT });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_X, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::PIVOT_POSITION_Y, { .dim = 0.0f });
+            se_ui_set_param(SeUiParam::FONT_HEIGHT, { .dim = 20.0f });
+            se_ui_set_param(SeUiParam::FONT_LINE_GAP, { .dim = 2.0f });
+
+            if (se_ui_begin_window
+            ({
+                .uid    = "Stats",
+                .width  = se_win_get_width<float>(),
+                .height = 60.0f,
+                .flags  = 0,
+            }))
+            {
+                const SeTransientMemoryStats stats = se_render_transient_memory_stats();
+                const SeString resources = se_string_create_fmt
+                (
+                    SeStringLifetime::TEMPORARY,
+                    "{} transient resources ({} lazily allocated), {} rebinds",
+                    stats.numResources, stats.numLazilyAllocated, stats.numRebinds
+                );
+                const SeString memory = se_string_create_fmt
+                (
+                    SeStringLifetime::TEMPORARY,
+                    "Required {} kb, aliased {} kb, heap {} kb",
+                    stats.requiredBytes / 1024, stats.aliasedBytes / 1024, stats.heapBytes / 1024
+                );
+                se_ui_text({ .utf8text = se_string_cstr(resources) });
+                se_ui_text({ .utf8text = se_string_cstr(memory) });
+                se_ui_end_window();
+            }
+
+            se_ui_end(compositePass);
+        }
+        se_render_end_frame();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const SeSettings settings
+    {
+        .applicationName        = "Sabrina engine - transient aliasing example",
+        .isFullscreenWindow     = false,
+        .isResizableWindow      = true,
+        .windowWidth            = 800,
+        .windowHeight           = 480,
+        .createUserDataFolder   = false,
+    };
+    se_engine_run(settings, init, update, terminate);
+    return 0;
+}
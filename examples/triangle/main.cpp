@@ -68,7 +68,8 @@ void update(const SeUpdateInfo& info)
         static const SeBufferRef frameDataBuffer = se_render_memory_buffer({ se_data_provider_from_memory(&frameData, sizeof(frameData)) });
         static const SeBufferRef instancesBuffer = se_render_memory_buffer({ se_data_provider_from_memory(instances, sizeof(instances)) });
         static const SeBufferRef verticesBuffer = se_render_memory_buffer({ se_data_provider_from_memory(vertices, sizeof(vertices)) });
-        se_render_begin_graphics_pass
+        // @NOTE : pass is compiled once, render pass, framebuffers and pipeline aren't looked up every frame
+        static const SePassRef pass = se_render_graphics_pass
         ({
             .dependencies           = 0,
             .vertexProgram          = { .program = vertexProgram, },
@@ -83,6 +84,7 @@ void update(const SeUpdateInfo& info)
             .renderTargets          = { { se_render_swap_chain_texture(), SeRenderTargetLoadOp::CLEAR } },
             .depthStencilTarget     = { },
         });
+        se_render_begin_pass(pass, 0);
         {
             se_render_bind({ .set = 0, .bindings =
             {
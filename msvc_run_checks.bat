@@ -0,0 +1,58 @@
+@echo off
+
+call :get_csi
+
+@REM Checks are built in release, so they can't rely on se_assert (it is compiled out there)
+set buildFolderDir=%cd%\builds\checks_win32_release\
+set numFailedChecks=0
+
+call :message "[MESSAGE] Build and run check exes"
+for /r %cd%\checks %%f in (*.cpp) do (
+    if %%~nf == main (
+        call :build_and_run %%f %buildFolderDir%
+    )
+)
+
+if %numFailedChecks% NEQ 0 (
+    call :error "[MESSAGE] %numFailedChecks% check exes failed"
+    EXIT /B 1
+)
+call :message "[MESSAGE] All checks passed"
+EXIT /B 0
+
+:build_and_run
+    set projectName=%~p1
+    set projectName=%projectName:~0, -1%
+    for %%g in ("%projectName%") do set projectName=%%~nxg
+
+    set sourceFolderDir=%~p1
+    set buildFolderDir=%~2\%projectName%
+    set engineInclude="."
+
+    call :message " -------------------------------------------- %projectName% --------------------------------------------"
+    call engine_builder\win_builder "%projectName%" "%sourceFolderDir%" "%buildFolderDir%" "%engineInclude%" msvc release
+
+    pushd %buildFolderDir%
+    %projectName%.exe
+    if %ERRORLEVEL% NEQ 0 (
+        call :error "[MESSAGE] %projectName% failed with exit code %ERRORLEVEL%"
+        set /a numFailedChecks+=1
+    )
+    popd
+Goto :Eof
+
+@REM :get_csi, :message and :error are taken from https://stackoverflow.com/questions/57736435/batch-file-to-change-color-of-text-depending-on-output-string-from-log-file
+:get_csi
+    echo 1B 5B>CSI.hex
+    Del CSI.bin >NUL 2>&1
+    certutil -decodehex CSI.hex CSI.bin >NUL 2>&1
+    Set /P CSI=<CSI.bin
+Goto :Eof
+
+:message
+    Echo(%CSI%32m%~1%CSI%0m
+Goto :Eof
+
+:error
+    Echo(%CSI%31m%~1%CSI%0m
+Goto :Eof